@@ -4,14 +4,14 @@
  * Generated with a --default-max-qty of 3
  */
 
-#ifndef EDHOC_ENCODE_TH2_H__
-#define EDHOC_ENCODE_TH2_H__
+#ifndef OSCORE_GROUP_AAD_ARRAY_H__
+#define OSCORE_GROUP_AAD_ARRAY_H__
 
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <string.h>
-#include "cbor/edhoc_encode_th2_types.h"
+#include "cbor/oscore_group_aad_array_types.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,9 +22,9 @@ extern "C" {
 #endif
 
 
-int cbor_encode_th2(
+int cbor_encode_group_aad_array(
 		uint8_t *payload, size_t payload_len,
-		struct th2 *input,
+		struct group_aad_array *input,
 		size_t *payload_len_out);
 
 
@@ -32,4 +32,4 @@ int cbor_encode_th2(
 }
 #endif
 
-#endif /* EDHOC_ENCODE_TH2_H__ */
+#endif /* OSCORE_GROUP_AAD_ARRAY_H__ */
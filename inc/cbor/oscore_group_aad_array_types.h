@@ -0,0 +1,45 @@
+/*
+ * Generated using zcbor version 0.8.99
+ * https://github.com/NordicSemiconductor/zcbor
+ * Generated with a --default-max-qty of 3
+ */
+
+#ifndef OSCORE_GROUP_AAD_ARRAY_TYPES_H__
+#define OSCORE_GROUP_AAD_ARRAY_TYPES_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <zcbor_common.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Which value for --default-max-qty this file was created with.
+ *
+ *  The define is used in the other generated file to do a build-time
+ *  compatibility check.
+ *
+ *  See `zcbor --help` for more information about --default-max-qty
+ */
+#define DEFAULT_MAX_QTY 3
+
+struct group_aad_array {
+	uint32_t group_aad_array_oscore_version;
+	int32_t group_aad_array_algorithms_alg_group_enc;
+	int32_t group_aad_array_algorithms_alg_sign;
+	int32_t group_aad_array_algorithms_alg_pairwise_key_agreement;
+	struct zcbor_string group_aad_array_request_kid_context;
+	struct zcbor_string group_aad_array_request_kid;
+	struct zcbor_string group_aad_array_request_piv;
+	struct zcbor_string group_aad_array_options;
+	struct zcbor_string group_aad_array_sender_cred;
+	struct zcbor_string group_aad_array_gm_cred;
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSCORE_GROUP_AAD_ARRAY_TYPES_H__ */
@@ -89,7 +89,14 @@ enum err byte_array_cpy(struct byte_array *dest, const struct byte_array *src,
  *          If Variable Length Array (VLA) is NOT used, before the creation of 
  *          the buffer it is checked if the size of the buffer (BUF_SIZE) will 
  *          be sufficient for the size of the byte_array (SIZE). 
+ *          If WORKSPACE is used the buffer is taken from the workspace of the
+ *          calling thread and released when NAME goes out of scope, see 
+ *          common/workspace.h.
 */
+#if defined(VLA) && defined(WORKSPACE)
+#error "VLA and WORKSPACE cannot be used together"
+#endif
+
 #ifdef VLA
 #define BYTE_ARRAY_NEW(NAME, BUF_SIZE, SIZE)                                   \
 	if (SIZE < 0 || SIZE > BUF_SIZE) {                                     \
@@ -104,6 +111,15 @@ enum err byte_array_cpy(struct byte_array *dest, const struct byte_array *src,
 		NAME.len = SIZE;                                               \
 	};
 
+#elif defined(WORKSPACE)
+#include "workspace.h"
+#define BYTE_ARRAY_NEW(NAME, BUF_SIZE, SIZE)                                   \
+	TRY(check_buffer_size(BUF_SIZE, SIZE));                                \
+	uint32_t NAME##_mark WORKSPACE_RELEASE_AT_SCOPE_EXIT =                 \
+		workspace_mark();                                              \
+	struct byte_array NAME;                                                \
+	TRY(workspace_alloc(SIZE, &NAME));
+
 #else
 #define BYTE_ARRAY_NEW(NAME, BUF_SIZE, SIZE)                                   \
 	TRY(check_buffer_size(BUF_SIZE, SIZE));                                \
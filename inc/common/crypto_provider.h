@@ -0,0 +1,305 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifndef CRYPTO_PROVIDER_H
+#define CRYPTO_PROVIDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/byte_array.h"
+#include "common/crypto_wrapper.h"
+#include "common/oscore_edhoc_error.h"
+
+/*
+ * Crypto providers selected at runtime. The engine compiled into the
+ * library (TINYCRYPT, MBEDTLS, COMPACT25519, CURVE25519_64) is available as
+ * crypto_provider_builtin. Further providers, e.g. a hardware accelerator
+ * that is not present on every device, can be registered per operation and
+ * algorithm. The functions of crypto_wrapper.h (aead(), hash(),
+ * hkdf_extract(), hkdf_expand(), shared_secret_derive(), sign(), verify(),
+ * sign_hash(), verify_hash() and ephemeral_dh_key_gen()) call the provider
+ * registered for the algorithm and fall back to the built-in engine if
+ * there is none. EDHOC signs and verifies ES256 with sign_hash() and
+ * verify_hash(), and with sign() and verify() if the registered provider
+ * has no sign_hash or verify_hash. The
+ * hashes computed in several steps (hash_ctx) and the HMACs built on them
+ * (hmac_ctx) never use a registered provider, since their state is specific
+ * to the engine. The transcript hashes of EDHOC are such hashes. EDHOC-KDF
+ * uses a prepared HMAC, unless an HKDF provider is registered for the hash
+ * algorithm when the PRK is prepared, then it uses hkdf_expand() and thereby
+ * the provider, see okm.h.
+ *
+ * aead() has no algorithm parameter. The algorithm whose provider it uses
+ * is derived from the key and tag lengths, which distinguishes only the
+ * algorithms of enum aead_alg (AES-CCM-16-64-128 and AES-CCM-16-128-128).
+ * A provider of another AEAD algorithm is used through crypto_key_import()
+ * and aead_with_key(), which take the algorithm.
+ *
+ * Several providers can be registered for the same algorithm. The last one
+ * is used until crypto_provider_select() or crypto_provider_benchmark()
+ * picks another. Registration is not synchronized and is meant to be done
+ * at startup before any handshake or OSCORE message is processed.
+ */
+
+/* Maximal number of registrations of all operations and algorithms */
+#ifndef CRYPTO_PROVIDER_MAX_REGISTRATIONS
+#define CRYPTO_PROVIDER_MAX_REGISTRATIONS 16
+#endif
+
+/* Maximal size of a symmetric key kept in a crypto_key */
+#ifndef CRYPTO_KEY_MAX_SIZE
+#define CRYPTO_KEY_MAX_SIZE 16
+#endif
+
+/* Size of the state a provider can keep in a crypto_key, e.g. the round keys
+ * of AES-128 */
+#ifndef CRYPTO_KEY_STATE_SIZE
+#define CRYPTO_KEY_STATE_SIZE 176
+#endif
+
+enum crypto_op {
+	/*alg is an enum aead_alg*/
+	CRYPTO_OP_AEAD,
+	/*alg is an enum hash_alg*/
+	CRYPTO_OP_HASH,
+	/*hkdf_extract() and hkdf_expand(), alg is an enum hash_alg*/
+	CRYPTO_OP_HKDF,
+	/*alg is an enum ecdh_alg*/
+	CRYPTO_OP_ECDH,
+	/*alg is an enum sign_alg*/
+	CRYPTO_OP_SIGN,
+	/*alg is an enum sign_alg*/
+	CRYPTO_OP_VERIFY,
+	/*ephemeral_dh_key_gen(), alg is an enum ecdh_alg*/
+	CRYPTO_OP_KEYGEN,
+};
+
+struct crypto_provider;
+
+/*
+ * A symmetric key prepared once for many AEAD operations, e.g. an OSCORE
+ * sender key. The provider may keep an expanded key schedule in state or a
+ * key imported into a key store in handle.
+ */
+struct crypto_key {
+	const struct crypto_provider *provider;
+	enum aead_alg alg;
+	uint8_t key[CRYPTO_KEY_MAX_SIZE];
+	uint32_t key_len;
+	void *handle;
+	union {
+		uint64_t align;
+		uint8_t buf[CRYPTO_KEY_STATE_SIZE];
+	} state;
+};
+
+/*
+ * The functions of a provider. The signatures are the ones of the
+ * corresponding functions in crypto_wrapper.h. Functions a provider does
+ * not implement are NULL. key_import, key_release and aead_key are
+ * optional also for providers that implement aead.
+ */
+struct crypto_provider {
+	const char *name;
+	enum err (*aead)(enum aes_operation op, const struct byte_array *in,
+			 const struct byte_array *key, struct byte_array *nonce,
+			 const struct byte_array *aad, struct byte_array *out,
+			 struct byte_array *tag);
+	enum err (*hash)(enum hash_alg alg, const struct byte_array *in,
+			 struct byte_array *out);
+	enum err (*hkdf_extract)(enum hash_alg alg,
+				 const struct byte_array *salt,
+				 struct byte_array *ikm, uint8_t *out);
+	enum err (*hkdf_expand)(enum hash_alg alg,
+				const struct byte_array *prk,
+				const struct byte_array *info,
+				struct byte_array *out);
+	enum err (*ecdh)(enum ecdh_alg alg, const struct byte_array *sk,
+			 const struct byte_array *pk, uint8_t *shared_secret);
+	enum err (*sign)(enum sign_alg alg, const struct byte_array *sk,
+			 const struct byte_array *pk,
+			 const struct byte_array *msg, uint8_t *out);
+	enum err (*verify)(enum sign_alg alg, const struct byte_array *pk,
+			   struct const_byte_array *msg,
+			   struct const_byte_array *sgn, bool *result);
+	/*optional, without them sign_hash() and verify_hash() return
+	crypto_operation_not_implemented and EDHOC uses sign() and verify()*/
+	enum err (*sign_hash)(enum sign_alg alg, const struct byte_array *sk,
+			      const struct byte_array *pk,
+			      const struct byte_array *msg_hash, uint8_t *out);
+	enum err (*verify_hash)(enum sign_alg alg, const struct byte_array *pk,
+				const struct byte_array *msg_hash,
+				struct const_byte_array *sgn, bool *result);
+	enum err (*keygen)(enum ecdh_alg alg, uint32_t seed,
+			   struct byte_array *sk, struct byte_array *pk);
+	/*sets up key->state or key->handle, key->key and key->key_len are
+	already set*/
+	enum err (*key_import)(struct crypto_key *key);
+	/*releases key->handle*/
+	void (*key_release)(struct crypto_key *key);
+	enum err (*aead_key)(enum aes_operation op,
+			     const struct crypto_key *key,
+			     const struct byte_array *in,
+			     struct byte_array *nonce,
+			     const struct byte_array *aad,
+			     struct byte_array *out, struct byte_array *tag);
+};
+
+/* The crypto engine selected at compile time */
+extern const struct crypto_provider crypto_provider_builtin;
+
+#ifdef AES_CCM_HW
+/* AES-CCM with the AES instructions of the CPU (AES-NI, ARMv8 Crypto
+ * Extensions). aead() uses it without registration if the CPU supports it
+ * and the key is an AES-128 key. */
+extern const struct crypto_provider crypto_provider_aes_ccm_hw;
+
+/**
+ * @brief	Checks if the CPU supports crypto_provider_aes_ccm_hw.
+ *
+ * @return	true if AES instructions are available.
+ */
+bool aes_ccm_hw_available(void);
+#endif
+
+#ifdef SHA256_HW
+/* SHA-256, HKDF-Extract and HKDF-Expand with the SHA instructions of the CPU
+ * (SHA-NI, ARMv8 SHA2). hash(), hkdf_extract(), hkdf_expand() and the hashes
+ * computed in several steps use it without registration if the CPU supports
+ * it. */
+extern const struct crypto_provider crypto_provider_sha256_hw;
+
+/**
+ * @brief	Checks if the CPU supports crypto_provider_sha256_hw.
+ *
+ * @return	true if SHA-256 instructions are available.
+ */
+bool sha256_hw_available(void);
+#endif
+
+/**
+ * @brief	Registers a provider for an operation and algorithm and uses
+ *		it for that algorithm from now on.
+ *
+ * @param op	The operation.
+ * @param alg	The algorithm, e.g. AES_CCM_16_64_128 or X25519.
+ * @param[in] provider The provider, must stay valid while registered.
+ * @return	Ok, wrong_parameter if the provider does not implement the
+ *		operation or crypto_provider_table_full.
+ */
+enum err crypto_provider_register(enum crypto_op op, int32_t alg,
+				  const struct crypto_provider *provider);
+
+/**
+ * @brief	Uses one of the registered providers for an operation and
+ *		algorithm.
+ *
+ * @param op	The operation.
+ * @param alg	The algorithm.
+ * @param[in] provider The provider.
+ * @return	Ok or wrong_parameter if the provider is not registered for
+ *		the algorithm.
+ */
+enum err crypto_provider_select(enum crypto_op op, int32_t alg,
+				const struct crypto_provider *provider);
+
+/**
+ * @brief	Returns the provider used for an operation and algorithm.
+ *
+ * @param op	The operation.
+ * @param alg	The algorithm.
+ * @return	The provider or NULL if none is registered, i.e. the
+ *		built-in engine is used.
+ */
+const struct crypto_provider *crypto_provider_get(enum crypto_op op,
+						  int32_t alg);
+
+/**
+ * @brief	Removes all registrations. Keys imported before must be
+ *		released before.
+ */
+void crypto_provider_unregister_all(void);
+
+/**
+ * @brief	Measures all providers registered for an operation and
+ *		algorithm and selects the fastest one. Each provider processes
+ *		a fixed input iterations times. For AEAD, hash, HKDF and ECDH
+ *		the results of all providers are compared and a provider
+ *		computing a different result than the built-in engine (or,
+ *		if it is not registered, the first provider) is not selected.
+ *		Signatures are checked with verify(), a provider whose
+ *		verify() does not accept a valid signature is not selected.
+ *
+ * @param op	The operation.
+ * @param alg	The algorithm.
+ * @param iterations Number of runs per provider, at least 1.
+ * @param now	Returns the current time in any unit, e.g. microseconds.
+ * @param[out] selected The selected provider, may be NULL.
+ * @return	Ok, wrong_parameter if no provider is registered or
+ *		crypto_provider_mismatch if no provider computed a correct
+ *		result.
+ */
+enum err crypto_provider_benchmark(enum crypto_op op, int32_t alg,
+				   uint32_t iterations, uint32_t (*now)(void),
+				   const struct crypto_provider **selected);
+
+/**
+ * @brief	Runs crypto_provider_benchmark() for every operation and
+ *		algorithm with more than one registered provider.
+ *
+ * @param iterations Number of runs per provider.
+ * @param now	Returns the current time.
+ * @return	Ok or the first error.
+ */
+enum err crypto_provider_benchmark_all(uint32_t iterations,
+				       uint32_t (*now)(void));
+
+/**
+ * @brief	Prepares a symmetric key for aead_with_key() with the
+ *		provider currently used for the algorithm (without a
+ *		registration crypto_provider_aes_ccm_hw if it is available,
+ *		otherwise the built-in engine).
+ *
+ * @param alg	The AEAD algorithm.
+ * @param[in] key The key.
+ * @param[out] out The prepared key.
+ * @return	Ok or error code.
+ */
+enum err crypto_key_import(enum aead_alg alg, const struct byte_array *key,
+			   struct crypto_key *out);
+
+/**
+ * @brief	Releases a prepared key and wipes it.
+ *
+ * @param[in,out] key The prepared key.
+ */
+void crypto_key_release(struct crypto_key *key);
+
+/**
+ * @brief	Calculates AEAD encryption or decryption with a prepared key,
+ *		see aead().
+ *
+ * @param op	ENCRYPT or DECRYPT.
+ * @param[in] key The prepared key.
+ * @param[in] in Input message.
+ * @param[in] nonce The nonce.
+ * @param[in] aad Additional authenticated data.
+ * @param[out] out The output.
+ * @param[in,out] tag The authentication tag.
+ * @return	Ok or error code.
+ */
+enum err aead_with_key(enum aes_operation op, const struct crypto_key *key,
+		       const struct byte_array *in, struct byte_array *nonce,
+		       const struct byte_array *aad, struct byte_array *out,
+		       struct byte_array *tag);
+
+#endif
@@ -15,6 +15,7 @@
 #include "oscore_edhoc_error.h"
 
 #include "edhoc/suites.h"
+#include "edhoc/buffer_sizes.h"
 
 /*Indicates what kind of operation a symmetric cipher will execute*/
 enum aes_operation {
@@ -39,12 +40,43 @@ enum err aead(enum aes_operation op, const struct byte_array *in,
 	      const struct byte_array *aad, struct byte_array *out,
 	      struct byte_array *tag);
 
+/* One computation of aead_multi(), the parameters of aead() */
+struct aead_job {
+	enum aes_operation op;
+	const struct byte_array *in;
+	const struct byte_array *key;
+	struct byte_array *nonce;
+	const struct byte_array *aad;
+	struct byte_array *out;
+	struct byte_array *tag;
+	/*set to the result of aead()*/
+	enum err result;
+};
+
+/**
+ * @brief			Calculates several independent AEAD 
+ *				encryptions or decryptions, e.g. of OSCORE 
+ *				messages to different peers. With AES_CCM_HW 
+ *				on a CPU with AES instructions the AES-128 
+ *				computations are interleaved, up to 
+ *				AES_CCM_HW_LANES at a time. A failed job does 
+ *				not stop the others.
+ * 
+ * @param[in,out] jobs		The computations, each one gets its result.
+ * @param n			Number of computations.
+ * @return 			Ok if all computations succeeded, otherwise 
+ *				the result of the first failed one.
+ */
+enum err aead_multi(struct aead_job *jobs, uint32_t n);
+
 /**
  * @brief			Derives ECDH shared secret.
  * 
  * @param alg			The ECDH algorithm to be used.
  * @param[in] sk 		Private key.
- * @param[in] pk 		Public key.
+ * @param[in] pk 		Public key. A P-256 key given in uncompressed 
+ *				form (0x04 | x | y) is used without a point 
+ *				decompression.
  * @param[out] shared_secret 	The result.
  * @return 			Ok or error code.
  */
@@ -52,6 +84,21 @@ enum err shared_secret_derive(enum ecdh_alg alg, const struct byte_array *sk,
 			      const struct byte_array *pk,
 			      uint8_t *shared_secret);
 
+/**
+ * @brief			Brings a P-256 public key into the uncompressed
+ *				form 0x04 | x | y.
+ *
+ * @param[in] in		The key, uncompressed with or without the 0x04
+ *				prefix, compressed or the x-coordinate only.
+ *				For the latter two any of the two points is
+ *				returned, which gives the same ECDH result.
+ * @param[out] out		The uncompressed key. May be the same buffer
+ *				as in.
+ * @return			Ok or error code.
+ */
+enum err p256_pk_uncompress(const struct byte_array *in,
+			    struct byte_array *out);
+
 /**
  * @brief			HKDF extract function, see rfc5869.
  * 
@@ -87,6 +134,138 @@ enum err hkdf_expand(enum hash_alg alg, const struct byte_array *prk,
 enum err hash(enum hash_alg alg, const struct byte_array *in,
 	      struct byte_array *out);
 
+/* Size of the state of the crypto library kept in a hash_ctx. It must be at
+ * least the size of psa_hash_operation_t or tc_sha256_state_struct. */
+#ifndef HASH_CTX_STATE_SIZE
+#define HASH_CTX_STATE_SIZE 320
+#endif
+
+/* A hash computed from several pieces with hash_init(), hash_update() and
+ * hash_final() */
+struct hash_ctx {
+	enum hash_alg alg;
+	union {
+		uint64_t align;
+		uint8_t buf[HASH_CTX_STATE_SIZE];
+	} state;
+};
+
+/**
+ * @brief			Starts a hash computed in several steps.
+ * 
+ * @param alg 			The hash algorithm to be used.
+ * @param[out] ctx 		The hash context.
+ * @return 			Ok or error code.
+ */
+enum err hash_init(enum hash_alg alg, struct hash_ctx *ctx);
+
+/**
+ * @brief			Adds a piece of the input to a hash.
+ * 
+ * @param[in,out] ctx 		The hash context.
+ * @param[in] in 		The piece of the input.
+ * @return 			Ok or error code.
+ */
+enum err hash_update(struct hash_ctx *ctx, const struct byte_array *in);
+
+/**
+ * @brief			Finishes a hash. The context can not be used
+ *				afterwards.
+ * 
+ * @param[in,out] ctx 		The hash context.
+ * @param[out] out 		The hash.
+ * @return 			Ok or error code.
+ */
+enum err hash_final(struct hash_ctx *ctx, struct byte_array *out);
+
+/**
+ * @brief			Copies a hash context, e.g. to continue a 
+ *				common prefix with different inputs.
+ * 
+ * @param[in] src 		The context to be copied.
+ * @param[out] dst 		The copy.
+ * @return 			Ok or error code.
+ */
+enum err hash_clone(const struct hash_ctx *src, struct hash_ctx *dst);
+
+/**
+ * @brief			Releases a hash context that is not finished
+ *				and wipes its state. A context that is all 
+ *				zero or already finished can be passed too.
+ * 
+ * @param[in,out] ctx 		The hash context.
+ */
+void hash_abort(struct hash_ctx *ctx);
+
+/* An HMAC (RFC 2104) computed from several pieces with hmac_init(),
+ * hmac_update() and hmac_final(). It is built on hash_ctx, so the key and the
+ * message are never copied into a common buffer. */
+struct hmac_ctx {
+	struct hash_ctx inner;
+	struct hash_ctx outer;
+};
+
+/**
+ * @brief			Starts an HMAC computed in several steps.
+ * 
+ * @param alg 			The hash algorithm to be used.
+ * @param[in] key 		The key.
+ * @param[out] ctx 		The HMAC context.
+ * @return 			Ok or error code.
+ */
+enum err hmac_init(enum hash_alg alg, const struct byte_array *key,
+		   struct hmac_ctx *ctx);
+
+/**
+ * @brief			Adds a piece of the message to an HMAC.
+ * 
+ * @param[in,out] ctx 		The HMAC context.
+ * @param[in] in 		The piece of the message.
+ * @return 			Ok or error code.
+ */
+enum err hmac_update(struct hmac_ctx *ctx, const struct byte_array *in);
+
+/**
+ * @brief			Finishes an HMAC. The context can not be used
+ *				afterwards.
+ * 
+ * @param[in,out] ctx 		The HMAC context.
+ * @param[out] out 		The HMAC, at least as long as the hash.
+ * @return 			Ok or error code.
+ */
+enum err hmac_final(struct hmac_ctx *ctx, struct byte_array *out);
+
+/**
+ * @brief			Copies an HMAC context. Copying a context
+ *				right after hmac_init() reuses the key setup.
+ * 
+ * @param[in] src 		The context to be copied.
+ * @param[out] dst 		The copy.
+ * @return 			Ok or error code.
+ */
+enum err hmac_clone(const struct hmac_ctx *src, struct hmac_ctx *dst);
+
+/**
+ * @brief			Releases an HMAC context and wipes the key
+ *				dependent state, see hash_abort().
+ * 
+ * @param[in,out] ctx 		The HMAC context.
+ */
+void hmac_abort(struct hmac_ctx *ctx);
+
+#ifdef UNIT_TEST
+/**
+ * @brief			Returns the number of HMAC key setups
+ *				(hmac_init() calls) done so far. It is only 
+ *				compiled into unit test builds to measure the 
+ *				cost of key derivations and is not 
+ *				synchronized between threads.
+ * 
+ * @return 			The number of key setups.
+ */
+uint32_t hmac_key_setup_count(void);
+#endif
+
 /**
  * @brief			Verifies an asymmetric signature.
  * @param alg			Signature algorithm to be used.
@@ -114,6 +293,97 @@ enum err verify(enum sign_alg alg, const struct byte_array *pk,
 		struct const_byte_array *msg, struct const_byte_array *sgn,
 		bool *result);
 
+/**
+ * @brief			Creates an asymmetric signature of a message
+ *				that is already hashed. Only ES256 is
+ *				supported, since EdDSA signs the message
+ *				itself. EDHOC signs with ES256 through this
+ *				function and calls sign() with the whole
+ *				message only if it returns
+ *				crypto_operation_not_implemented, e.g. for
+ *				a provider without sign_hash. An integration
+ *				that replaces sign() for ES256, e.g. to use a
+ *				key in a secure element, must replace this
+ *				function too.
+ * @param alg			Signature algorithm to be used.
+ * @param[in] sk 		Secret key.
+ * @param[in] pk 		Public key.
+ * @param[in] msg_hash 		The SHA-256 hash of the message.
+ * @param[out] out 		Signature.
+ * @return 			Ok or error code.
+ */
+enum err sign_hash(enum sign_alg alg, const struct byte_array *sk,
+		   const struct byte_array *pk,
+		   const struct byte_array *msg_hash, uint8_t *out);
+
+/**
+ * @brief			Verifies an asymmetric signature of a message
+ *				that is already hashed. Only ES256 is
+ *				supported. As sign_hash(), EDHOC falls back
+ *				to verify() if it returns
+ *				crypto_operation_not_implemented.
+ * 
+ * @param alg 			Signature algorithm to be used.
+ * @param[in] pk 		Public key.
+ * @param[in] msg_hash 		The SHA-256 hash of the signed message.
+ * @param[in] sgn 		Signature.
+ * @param[out] result 		True if the verification is successfully.
+ * @return 			Ok or error code.
+ */
+enum err verify_hash(enum sign_alg alg, const struct byte_array *pk,
+		     const struct byte_array *msg_hash,
+		     struct const_byte_array *sgn, bool *result);
+
+/*
+ * A public key prepared once for many signature verifications, e.g. the key
+ * of a CA. ES256 keys are stored uncompressed (0x04 | x | y). When MBEDTLS is
+ * used the key is additionally imported into PSA, so that no import is
+ * needed per verification.
+ */
+struct prepared_pk {
+	enum sign_alg alg;
+	uint8_t pk[PK_SIZE];
+	uint32_t pk_len;
+	/*identifier of the imported PSA key or 0*/
+	uint32_t key_id;
+};
+
+/**
+ * @brief			Prepares a public key for verify_prepared().
+ *
+ * @param alg			Signature algorithm the key is used with.
+ * @param[in] pk		The public key. ES256 keys can be given
+ *				uncompressed with or without the 0x04 prefix.
+ * @param[out] out		The prepared key.
+ * @return			Ok or error code.
+ */
+enum err pk_prepare(enum sign_alg alg, const struct byte_array *pk,
+		    struct prepared_pk *out);
+
+/**
+ * @brief			Releases the resources held by a prepared key.
+ *
+ * @param[in,out] k		The prepared key.
+ */
+void pk_release(struct prepared_pk *k);
+
+/**
+ * @brief			Verifies an asymmetric signature with a
+ *				prepared key.
+ *
+ * @param[in] k			The prepared public key.
+ * @param alg			Signature algorithm of the signature. If it
+ *				differs from the algorithm of the key
+ *				verify() is used.
+ * @param[in] msg		The signed message.
+ * @param[in] sgn		Signature.
+ * @param[out] result		True if the verification is successfully.
+ * @return			Ok or error code.
+ */
+enum err verify_prepared(const struct prepared_pk *k, enum sign_alg alg,
+			 struct const_byte_array *msg,
+			 struct const_byte_array *sgn, bool *result);
+
 /**
  * @brief			HKDF function used for the derivation of the 
  *				Common IV, Recipient/Sender keys.
@@ -129,6 +399,26 @@ enum err hkdf_sha_256(struct byte_array *master_secret,
 		      struct byte_array *master_salt, struct byte_array *info,
 		      struct byte_array *out);
 
+/* One derivation of hkdf_sha_256_multi(), the parameters of hkdf_sha_256() */
+struct hkdf_sha_256_job {
+	struct byte_array *master_secret;
+	struct byte_array *master_salt;
+	struct byte_array *info;
+	struct byte_array *out;
+};
+
+/**
+ * @brief			Runs several independent hkdf_sha_256() 
+ *				derivations, e.g. of the keys of many OSCORE
+ *				contexts. With SHA256_HW on a CPU with AVX2 
+ *				the derivations are computed in parallel.
+ *
+ * @param[in] jobs		The derivations.
+ * @param n			Number of derivations.
+ * @return 			Ok or error code.
+ */
+enum err hkdf_sha_256_multi(const struct hkdf_sha_256_job *jobs, uint32_t n);
+
 #ifdef EDHOC_MOCK_CRYPTO_WRAPPER
 /*
  * Elliptic curve based signature algorithms generate signatures that are not 
@@ -41,4 +41,15 @@ enum err check_buffer_size(uint32_t is_size, uint32_t required_size);
 enum err _memcpy_s(uint8_t *dest, uint32_t dest_len, const uint8_t *source,
 		   uint32_t source_len);
 
+/**
+ * @brief			Overwrites a buffer containing secret data with 
+ * 				zeros. Other than memset the call cannot be 
+ * 				removed by the compiler if the buffer is not 
+ * 				used afterwards.
+ * 
+ * @param[out] dest 		The buffer.
+ * @param dest_len 		Length of the buffer.
+ */
+void secure_erase(uint8_t *dest, uint32_t dest_len);
+
 #endif
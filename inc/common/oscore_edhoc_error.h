@@ -27,6 +27,10 @@ enum err {
 	transport_deinitialized = 7,
 	not_implemented = 8,
 	vla_insufficient_size = 9,
+	workspace_not_selected = 10,
+	workspace_exhausted = 11,
+	crypto_provider_table_full = 12,
+	crypto_provider_mismatch = 13,
 
 
 	/*EDHOC specific errors*/
@@ -53,6 +57,19 @@ enum err {
 	suites_i_list_to_long = 121,
 	xor_error = 122,
         suites_i_list_empty = 123,
+	edhoc_session_invalid_state = 124,
+	edhoc_session_table_full = 125,
+	edhoc_session_not_found = 126,
+	ephemeral_key_pool_no_space = 127,
+	cred_index_too_small = 128,
+	trust_anchor_store_too_small = 129,
+	resumption_not_found = 130,
+	resumption_peer_mismatch = 131,
+	admission_malformed_message = 132,
+	admission_rate_limited = 133,
+	admission_busy = 134,
+	admission_challenge_sent = 135,
+	ephemeral_key_unavailable = 136,
 
 	/*OSCORE specific errors*/
 	not_oscore_pkt = 200,
@@ -79,6 +96,11 @@ enum err {
 	oscore_interaction_duplicated_token = 221,
 	oscore_interaction_not_found = 222,
 	oscore_wrong_uri_path = 223,
+	oscore_group_member_not_found = 224,
+	oscore_group_member_table_full = 225,
+	oscore_group_signature_invalid = 226,
+	oscore_group_gid_mismatch = 227,
+	oscore_no_edhoc_option = 228,
 };
 
 /*This macro checks if a function returns an error and if so it propagates 
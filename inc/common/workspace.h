@@ -0,0 +1,105 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include <stdint.h>
+
+#include "oscore_edhoc_error.h"
+
+struct byte_array;
+
+/*
+ * A workspace is a caller-supplied scratch region. When the library is built
+ * with WORKSPACE defined, all temporary buffers created with BYTE_ARRAY_NEW
+ * are taken from the workspace selected for the calling thread instead of
+ * from the stack. The buffers are released in reverse order when they go
+ * out of scope, so functions that are not active at the same time share
+ * the same memory. The worst case size for a given configuration is
+ * EDHOC_WORKSPACE_SIZE (edhoc/buffer_sizes.h) and OSCORE_WORKSPACE_SIZE
+ * (oscore.h).
+ */
+
+/* Alignment of every buffer taken from a workspace */
+#ifndef WORKSPACE_ALIGN
+#define WORKSPACE_ALIGN 4
+#endif
+
+/* Storage class of the selected workspace. It must be thread local if the
+ * library is used from more than one thread. On single threaded targets
+ * without TLS support it can be defined empty. */
+#ifndef WORKSPACE_THREAD_LOCAL
+#define WORKSPACE_THREAD_LOCAL _Thread_local
+#endif
+
+struct workspace {
+	uint8_t *buf;
+	uint32_t size;
+	uint32_t used;
+	/*high-water mark, can be used to tune the size of buf*/
+	uint32_t peak;
+};
+
+/**
+ * @brief	Initializes a workspace.
+ *
+ * @param ws	The workspace.
+ * @param buf	Memory provided by the caller.
+ * @param size	Size of buf.
+ */
+void workspace_init(struct workspace *ws, uint8_t *buf, uint32_t size);
+
+/**
+ * @brief	Selects the workspace used by the calling thread. A workspace
+ *		must not be selected by more than one thread at a time.
+ *
+ * @param ws	The workspace or NULL to deselect the current one.
+ */
+void workspace_select(struct workspace *ws);
+
+/**
+ * @brief	Returns the workspace selected by the calling thread.
+ */
+struct workspace *workspace_selected(void);
+
+/**
+ * @brief	Takes a buffer from the selected workspace. A size of 0
+ *		results in a NULL_ARRAY.
+ *
+ * @param size	The required size in bytes.
+ * @param out	The buffer.
+ * @return	ok, workspace_not_selected or workspace_exhausted
+ */
+enum err workspace_alloc(uint32_t size, struct byte_array *out);
+
+/**
+ * @brief	Returns the current fill level of the selected workspace. All
+ *		buffers taken after this call are released by
+ *		workspace_release().
+ */
+uint32_t workspace_mark(void);
+
+/**
+ * @brief	Releases all buffers taken from the selected workspace after
+ *		the mark was created.
+ *
+ * @param mark	Pointer to a value returned by workspace_mark(). A pointer
+ *		is used so that the function can be used as cleanup
+ *		attribute.
+ */
+void workspace_release(const uint32_t *mark);
+
+/* Releases the buffers taken after the mark when the mark goes out of
+ * scope. Requires GCC or Clang. */
+#define WORKSPACE_RELEASE_AT_SCOPE_EXIT __attribute__((cleanup(workspace_release)))
+
+#endif
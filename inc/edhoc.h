@@ -38,9 +38,18 @@ struct other_party_cred {
 	struct byte_array ca_pk; /*use only when certificates are used*/
 };
 
+struct cred_index;
+struct trust_anchor_store;
+
 struct cred_array {
 	uint32_t len;
 	struct other_party_cred *ptr;
+	/*optional hash index over ptr, see edhoc/cred_index.h. If NULL the 
+	array is searched linearly*/
+	const struct cred_index *index;
+	/*optional store of the pre-parsed CAs, see edhoc/trust_anchor_store.h.
+	If NULL the CA certificates are parsed per verification*/
+	const struct trust_anchor_store *anchors;
 };
 
 struct edhoc_responder_context {
@@ -137,6 +146,36 @@ enum err edhoc_initiator_run_extended(
 	enum err (*rx)(void *sock, struct byte_array *data),
 	enum err (*ead_process)(void *params, struct byte_array *ead24));
 
+/**
+ * @brief 			Executes EDHOC on the initiator side with a 
+ * 				known responder. If the responder rejects the 
+ * 				selected suite, message 1 is sent again with a 
+ * 				suite it supports. With a registered suite 
+ * 				cache (see edhoc/suite_cache.h) that suite is 
+ * 				selected directly in later handshakes with the 
+ * 				responder.
+ * 
+ * @param[in] c 		Initialization parameters.
+ * @param[in] peer_id 		Identifier of the responder, e.g. its address,
+ * 				or NULL.
+ * @param[in] cred_r_array 	Trust anchors for authenticating the responder.
+ * @param[out] err_msg 		A buffer for an error message.
+ * @param[out] c_r_bytes 	Connection identifier of requester.
+ * @param[out] prk_out 		The derived shared secret.
+ * @param tx			A callback function for sending messages.
+ * @param rx			A callback function for receiving messages.
+ * @param ead_process		A callback function for processing EAD.
+ * @return 			Ok or error code.
+ */
+enum err edhoc_initiator_run_peer(
+	const struct edhoc_initiator_context *c,
+	const struct byte_array *peer_id, struct cred_array *cred_r_array,
+	struct byte_array *err_msg, struct byte_array *c_r_bytes,
+	struct byte_array *prk_out,
+	enum err (*tx)(void *sock, struct byte_array *data),
+	enum err (*rx)(void *sock, struct byte_array *data),
+	enum err (*ead_process)(void *params, struct byte_array *ead24));
+
 /**
  * @brief			Executes EDHOC on the responder side.
  * 
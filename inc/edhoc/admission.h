@@ -0,0 +1,193 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "edhoc.h"
+#include "edhoc/buffer_sizes.h"
+#include "edhoc/responder_session_table.h"
+
+#include "common/byte_array.h"
+#include "common/oscore_edhoc_error.h"
+
+/*
+ * Admission control of a responder. edhoc_admission_msg1() is called for
+ * every received message_1 before it is passed to the session table. Only
+ * cheap checks are done, in this order:
+ *
+ * 1. Rate limit: every source (e.g. the IP address and port of the
+ *    initiator) has a token bucket holding at most burst tokens, one token
+ *    is added every period. A message_1 takes one token. The buckets are
+ *    kept in a fixed-size array, if it is full the buckets are replaced in
+ *    turn.
+ * 2. Syntax: message_1 is decoded and the method, the length of G_X for
+ *    the selected suite, C_I and EAD_1 are checked. A selected suite that
+ *    the responder does not support is accepted, the handshake then answers
+ *    with an error message with SUITES_R without public key operation.
+ * 3. Budget: at most max_in_progress handshakes may be in progress in the
+ *    session table.
+ * 4. Return routability (optional): if at least challenge_threshold
+ *    handshakes are in progress, the initiator must prove that it receives
+ *    messages sent to its source. Otherwise the responder sends an EDHOC
+ *    error message with ERR_CODE EDHOC_ADMISSION_ERR_CODE and a cookie as
+ *    ERR_INFO. The initiator sends message_1 again with the cookie in an EAD
+ *    item with label EDHOC_ADMISSION_EAD_LABEL, see
+ *    edhoc_admission_challenge_answer(). The cookie is a MAC of the source
+ *    and the current time window, so the responder keeps no state. The EAD
+ *    item is up to EDHOC_ADMISSION_CHALLENGE_SIZE (18) bytes long, so
+ *    EAD_SIZE must be at least 18 on both sides, otherwise no answer is
+ *    admitted.
+ *
+ * Messages that are shed are counted in the metrics of the admission.
+ */
+
+/* Maximal length of a source identifier */
+#ifndef EDHOC_ADMISSION_SOURCE_MAX_SIZE
+#define EDHOC_ADMISSION_SOURCE_MAX_SIZE 18
+#endif
+
+/* ERR_CODE of the challenge and EAD label of the answer. The values must be
+ * agreed with the initiators. The defaults are the first values beyond the
+ * 16 bit range, far from the ERR_CODEs and EAD labels registered for
+ * RFC9528, and are meant for private use within a deployment. They can be
+ * defined by the user, e.g. once values are registered. The label is
+ * positive, i.e. the EAD item is not critical, so initiators and responders
+ * without admission control ignore it. */
+#ifndef EDHOC_ADMISSION_ERR_CODE
+#define EDHOC_ADMISSION_ERR_CODE -65536
+#endif
+#ifndef EDHOC_ADMISSION_EAD_LABEL
+#define EDHOC_ADMISSION_EAD_LABEL 65536
+#endif
+
+#define EDHOC_ADMISSION_COOKIE_SIZE 8
+#define EDHOC_ADMISSION_KEY_SIZE 16
+/* Size of an error message or an EAD item containing a cookie */
+#define EDHOC_ADMISSION_CHALLENGE_SIZE (2 * 5 + EDHOC_ADMISSION_COOKIE_SIZE)
+
+struct edhoc_admission_bucket {
+	uint8_t source[EDHOC_ADMISSION_SOURCE_MAX_SIZE];
+	uint32_t source_len;
+	uint32_t tokens;
+	/*time the last token was added*/
+	uint32_t last;
+	bool valid;
+};
+
+/* Number of received messages_1 by outcome */
+struct edhoc_admission_metrics {
+	uint32_t admitted;
+	uint32_t rate_limited;
+	uint32_t malformed;
+	uint32_t busy;
+	uint32_t challenged;
+};
+
+struct edhoc_admission {
+	const struct edhoc_responder_context *c;
+	/*table whose handshakes count for the budget, optional*/
+	const struct edhoc_responder_session_table *t;
+	uint32_t max_in_progress;
+	struct edhoc_admission_bucket *buckets;
+	uint32_t buckets_len;
+	/*time in which one token is added to a bucket*/
+	uint32_t period;
+	/*maximal number of tokens of a bucket*/
+	uint32_t burst;
+	/*number of handshakes in progress from which a challenge is sent*/
+	uint32_t challenge_threshold;
+	/*time a cookie is valid, 0 disables the challenge*/
+	uint32_t cookie_lifetime;
+	uint8_t cookie_key[EDHOC_ADMISSION_KEY_SIZE];
+	/*optional, needed if messages are received in more than one thread. 
+	The session table may be used by another thread meanwhile.*/
+	void (*lock)(void *lock_ctx);
+	void (*unlock)(void *lock_ctx);
+	void *lock_ctx;
+	/*bucket replaced next if the array is full*/
+	uint32_t next;
+	struct edhoc_admission_metrics metrics;
+};
+
+/**
+ * @brief	Initializes an admission without challenge. The budget is the
+ *		size of the session table. The fields max_in_progress, lock,
+ *		unlock and lock_ctx can be set afterwards.
+ *
+ * @param a	The admission.
+ * @param c	The responder context, its suites are accepted.
+ * @param t	The session table or NULL.
+ * @param buckets Memory for the token buckets.
+ * @param buckets_len Number of buckets.
+ * @param period Time in which one token is added to a bucket.
+ * @param burst	Maximal number of messages_1 of a source at once.
+ */
+void edhoc_admission_init(struct edhoc_admission *a,
+			  const struct edhoc_responder_context *c,
+			  const struct edhoc_responder_session_table *t,
+			  struct edhoc_admission_bucket *buckets,
+			  uint32_t buckets_len, uint32_t period,
+			  uint32_t burst);
+
+/**
+ * @brief	Enables the return routability challenge.
+ *
+ * @param a	The admission.
+ * @param[in] key A random key of EDHOC_ADMISSION_KEY_SIZE bytes for the
+ *		cookies.
+ * @param threshold Number of handshakes in progress from which a
+ *		challenge is sent, 0 to challenge every initiator.
+ * @param lifetime Time a cookie is valid, a cookie is accepted for up to
+ *		twice this time.
+ * @return	ok or wrong_parameter.
+ */
+enum err edhoc_admission_challenge_enable(struct edhoc_admission *a,
+					  const struct byte_array *key,
+					  uint32_t threshold,
+					  uint32_t lifetime);
+
+/**
+ * @brief	Decides if a received message_1 is processed.
+ *
+ * @param a	The admission.
+ * @param[in] source The source of the message, e.g. address and port.
+ * @param now	The current time.
+ * @param[in] msg1 The message.
+ * @param[out] err_msg Buffer of at least EDHOC_ADMISSION_CHALLENGE_SIZE
+ *		bytes. If admission_challenge_sent is returned it contains the
+ *		error message to be sent to the source.
+ * @return	ok if the message shall be passed to
+ *		edhoc_responder_session_table_msg1(),
+ *		admission_rate_limited, admission_malformed_message,
+ *		admission_busy or admission_challenge_sent.
+ */
+enum err edhoc_admission_msg1(struct edhoc_admission *a,
+			      const struct byte_array *source, uint32_t now,
+			      const struct byte_array *msg1,
+			      struct byte_array *err_msg);
+
+/**
+ * @brief	Builds the answer of an initiator to a challenge: the EAD item
+ *		with the cookie, to be sent in EAD_1 of the next message_1.
+ *
+ * @param[in] err_msg The received error message.
+ * @param[out] ead_1 Buffer of at least EDHOC_ADMISSION_CHALLENGE_SIZE
+ *		bytes for the EAD item.
+ * @return	ok or wrong_parameter if the error message is no challenge.
+ */
+enum err edhoc_admission_challenge_answer(const struct byte_array *err_msg,
+					  struct byte_array *ead_1);
+
+#endif
@@ -26,4 +26,62 @@ enum err encode_bstr(const struct byte_array *in, struct byte_array *out);
  */
 enum err decode_bstr(const struct byte_array *in, struct byte_array *out);
 
+/* CBOR major types used with encode_cbor_head() */
+#define CBOR_MAJOR_TYPE_UINT 0
+#define CBOR_MAJOR_TYPE_NINT 1
+#define CBOR_MAJOR_TYPE_BSTR 2
+#define CBOR_MAJOR_TYPE_TSTR 3
+#define CBOR_MAJOR_TYPE_ARRAY 4
+#define CBOR_MAJOR_TYPE_SIMPLE 7
+
+/* Simple values, the argument of a head of CBOR_MAJOR_TYPE_SIMPLE */
+#define CBOR_SIMPLE_FALSE 20
+#define CBOR_SIMPLE_TRUE 21
+
+/* Maximal length of the head of a CBOR data item with a 32 bit argument */
+#define CBOR_HEAD_MAX_SIZE 5
+
+/**
+ * @brief                       Encodes the head of a CBOR data item, e.g. 
+ *                              an unsigned integer or the length of a byte 
+ *                              string whose content follows in another 
+ *                              buffer.
+ * 
+ * @param major_type            The CBOR major type.
+ * @param arg                   The argument, i.e. the value or the length.
+ * @param[out] out              The head. The buffer must hold at least 
+ *                              CBOR_HEAD_MAX_SIZE bytes.
+ * @retval                      Ok or error code.
+ */
+enum err encode_cbor_head(uint8_t major_type, uint32_t arg,
+			  struct byte_array *out);
+
+/**
+ * @brief                       Appends the head of a CBOR data item to a 
+ *                              buffer, e.g. to the info of a KDF, to a 
+ *                              message or to the piece of a hash input 
+ *                              that precedes data in another buffer.
+ * 
+ * @param[in,out] out           The buffer, its length is the used part.
+ * @param size                  Size of the buffer.
+ * @param major_type            The CBOR major type.
+ * @param arg                   The argument, i.e. the value or the length.
+ * @retval                      Ok or error code.
+ */
+enum err cbor_head_append(struct byte_array *out, uint32_t size,
+			  uint8_t major_type, uint32_t arg);
+
+/**
+ * @brief                       Decodes the head of a CBOR data item with an 
+ *                              argument of at most 32 bit.
+ * 
+ * @param[in] in                The encoded data item.
+ * @param[out] major_type       The CBOR major type.
+ * @param[out] arg              The argument, i.e. the value or the length.
+ * @param[out] head_len         The length of the head.
+ * @retval                      Ok or cbor_decoding_error.
+ */
+enum err decode_cbor_head(const struct byte_array *in, uint8_t *major_type,
+			  uint32_t *arg, uint32_t *head_len);
+
 #endif
\ No newline at end of file
@@ -7,6 +7,8 @@
 #ifndef BUFFER_SIZES_H
 #define BUFFER_SIZES_H
 
+#include "common/workspace.h"
+
 #ifndef EAD_SIZE
 #define EAD_SIZE 0
 #endif
@@ -116,9 +118,34 @@
 
 #define INFO_MAX_SIZE CONTEXT_MAC_SIZE + 2 * CBOR_ENCODED_UINT
 
-#define TH34_INPUT_SIZE                                                        \
-	(AS_BSTR_SIZE(HASH_SIZE) + PLAINTEXT23_MAX_SIZE + CRED_MAX_SIZE)
-
-#define TH2_INPUT_SIZE (AS_BSTR_SIZE(G_Y_SIZE) + AS_BSTR_SIZE(HASH_SIZE))
+/*
+ * Worst case size of the workspace (see common/workspace.h) needed by EDHOC. 
+ * It is the sum of the buffers of the largest message function (msg2_gen, 
+ * msg2_process, msg3_process) and of the deepest chain of helpers called 
+ * from it (signature_or_mac or ciphertext_gen). Each buffer may be padded 
+ * for alignment.
+ */
+#define EDHOC_WORKSPACE_MAX_BUFFERS 32
+
+#define EDHOC_WORKSPACE_MSG_BUFFERS                                            \
+	(G_Y_CIPHERTEXT_2 + MAX(CIPHERTEXT2_SIZE, CIPHERTEXT3_SIZE) +          \
+	 PLAINTEXT23_MAX_SIZE + ID_CRED_MAX_SIZE + CRED_MAX_SIZE +             \
+	 SIG_OR_MAC_SIZE + PK_SIZE + G_R_SIZE + G_Y_SIZE + ECDH_SECRET_SIZE +  \
+	 HASH_SIZE + 2 * PRK_SIZE + SUITES_I_SIZE + C_I_SIZE + C_R_SIZE)
+
+#define EDHOC_WORKSPACE_SIGNATURE_OR_MAC_BUFFERS                               \
+	(SIG_STRUCT_SIZE + HASH_SIZE + AS_BSTR_SIZE(HASH_SIZE) +              \
+	 AS_BSTR_SIZE(C_R_SIZE) + HASH_SIZE + HASH_SIZE + SIGNATURE_SIZE)
+
+#define EDHOC_WORKSPACE_CIPHERTEXT_BUFFERS                                     \
+	(AS_BSTR_SIZE(SIG_OR_MAC_SIZE) + AS_BSTR_SIZE(C_I_SIZE) + KID_SIZE +  \
+	 CIPHERTEXT2_SIZE + AEAD_IV_SIZE + AAD_SIZE + MAC_SIZE +               \
+	 HASH_SIZE + HASH_SIZE)
+
+#define EDHOC_WORKSPACE_SIZE                                                   \
+	(EDHOC_WORKSPACE_MSG_BUFFERS +                                         \
+	 MAX(EDHOC_WORKSPACE_SIGNATURE_OR_MAC_BUFFERS,                         \
+	     EDHOC_WORKSPACE_CIPHERTEXT_BUFFERS) +                             \
+	 EDHOC_WORKSPACE_MAX_BUFFERS * (WORKSPACE_ALIGN - 1))
 
 #endif
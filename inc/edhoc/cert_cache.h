@@ -0,0 +1,114 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifndef CERT_CACHE_H
+#define CERT_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "edhoc.h"
+#include "edhoc/buffer_sizes.h"
+#include "edhoc/ttl_cache.h"
+
+#include "common/byte_array.h"
+
+/*
+ * Cache of verified certificates. When a cache is registered, retrieve_cred()
+ * looks up a certificate received in ID_CRED_x (x5chain, x5bag, c5c, c5b) by
+ * its SHA-256 digest before verifying it. On a hit the public key (or static
+ * DH key) stored for the certificate is returned, so parsing the certificate
+ * and checking the signature of the CA are skipped. Only successfully
+ * verified certificates are stored.
+ *
+ * An entry is valid only for the cred_array (CA set) it was verified with.
+ * It expires after the TTL of the cache. When the CA set changes,
+ * cert_cache_invalidate() must be called.
+ */
+
+struct cert_cache_entry {
+	struct ttl_cache_slot slot;
+	uint8_t digest[HASH_SIZE];
+	const struct cred_array *ca_set;
+	bool static_dh;
+	uint8_t key[PK_SIZE];
+	uint32_t key_len;
+};
+
+/* A TTL cache (see edhoc/ttl_cache.h) of struct cert_cache_entry */
+struct cert_cache {
+	struct ttl_cache base;
+};
+
+/* The digest of a certificate, computed once per verification */
+struct cert_cache_key {
+	uint8_t digest[HASH_SIZE];
+	bool valid;
+};
+
+/**
+ * @brief	Initializes a cache. The fields now, lock, unlock and lock_ctx
+ *		of the base can be set afterwards.
+ *
+ * @param cache	The cache.
+ * @param entries Memory for the entries.
+ * @param entries_len Number of entries.
+ * @param ttl	Time an entry is valid.
+ */
+void cert_cache_init(struct cert_cache *cache,
+		     struct cert_cache_entry *entries, uint32_t entries_len,
+		     uint32_t ttl);
+
+/**
+ * @brief	Makes a cache available to retrieve_cred().
+ *
+ * @param cache	The cache or NULL to stop caching.
+ */
+void cert_cache_register(struct cert_cache *cache);
+
+/**
+ * @brief	Removes all entries, e.g. after the CA set has changed.
+ *
+ * @param cache	The cache.
+ */
+void cert_cache_invalidate(struct cert_cache *cache);
+
+/**
+ * @brief	Looks up a certificate in the registered cache.
+ *
+ * @param[in] cert The certificate.
+ * @param[in] ca_set The CAs used for the verification.
+ * @param static_dh True if the certificate contains a static DH key.
+ * @param[out] k The digest of the certificate, to be passed to
+ *		cert_cache_put() after the verification.
+ * @param[out] key The public key contained in the certificate.
+ * @return	true on a hit.
+ */
+bool cert_cache_get(const struct const_byte_array *cert,
+		    const struct cred_array *ca_set, bool static_dh,
+		    struct cert_cache_key *k, struct byte_array *key);
+
+/**
+ * @brief	Stores a successfully verified certificate in the registered
+ *		cache. An entry of the same certificate is replaced. If the
+ *		cache is full an expired entry or, if there is none, the
+ *		entries in turn are replaced.
+ *
+ * @param[in] k	The digest returned by cert_cache_get().
+ * @param[in] ca_set The CAs used for the verification.
+ * @param static_dh True if the certificate contains a static DH key.
+ * @param[in] key The public key contained in the certificate.
+ */
+void cert_cache_put(const struct cert_cache_key *k,
+		    const struct cred_array *ca_set, bool static_dh,
+		    const struct byte_array *key);
+
+#endif
@@ -11,6 +11,9 @@
 
 #ifndef CIPHERTEXT_H
 #define CIPHERTEXT_H
+
+#include "edhoc/okm.h"
+
 enum ciphertext { CIPHERTEXT2, CIPHERTEXT3, CIPHERTEXT4 };
 
 /**
@@ -21,7 +24,7 @@ enum ciphertext { CIPHERTEXT2, CIPHERTEXT3, CIPHERTEXT4 };
  * @param[in] id_cred 		Id of the credential.
  * @param[in] signature_or_mac 	Signature or a mac byte_array.
  * @param[in] ead 		External authorization data.
- * @param[in] prk 		Pseudo random key.
+ * @param[in] prk 		Pseudo random key, prepared for EDHOC-KDF.
  * @param[in] th 		Transcript hash.
  * @param[out] ciphertext 	The ciphertext.
  * @param[out] plaintext 	The plaintext. 
@@ -31,8 +34,9 @@ enum err ciphertext_gen(enum ciphertext ctxt, struct suite *suite,
 			const struct byte_array *c_r,
                         const struct byte_array *id_cred,
 			struct byte_array *signature_or_mac,
-			const struct byte_array *ead, struct byte_array *prk,
-			struct byte_array *th, struct byte_array *ciphertext,
+			const struct byte_array *ead,
+			const struct prk_handle *prk, struct byte_array *th,
+			struct byte_array *ciphertext,
 			struct byte_array *plaintext);
 
 /**
@@ -47,7 +51,7 @@ enum err ciphertext_gen(enum ciphertext ctxt, struct suite *suite,
  * @param[out] id_cred 		Id of the credential.
  * @param[out] signature_or_mac Signature or a mac byte_array.
  * @param[out] ead 		External authorization data.
- * @param[in] prk 		Pseudo random key.
+ * @param[in] prk 		Pseudo random key, prepared for EDHOC-KDF.
  * @param[in] th 		Transcript hash.
  * @param[in] ciphertext 	The input.
  * @param[out] plaintext 	The plaintext.
@@ -56,7 +60,8 @@ enum err ciphertext_gen(enum ciphertext ctxt, struct suite *suite,
 enum err ciphertext_decrypt_split(
 	enum ciphertext ctxt, struct suite *suite, struct byte_array *c_r,
 	struct byte_array *id_cred, struct byte_array *sig_or_mac,
-	struct byte_array *ead, struct byte_array *prk, struct byte_array *th,
-	struct byte_array *ciphertext, struct byte_array *plaintext);
+	struct byte_array *ead, const struct prk_handle *prk,
+	struct byte_array *th, struct byte_array *ciphertext,
+	struct byte_array *plaintext);
 
 #endif
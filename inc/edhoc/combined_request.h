@@ -0,0 +1,116 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifndef COMBINED_REQUEST_H
+#define COMBINED_REQUEST_H
+
+#include <stdint.h>
+
+#include "edhoc_internal.h"
+#include "edhoc/responder_session_table.h"
+#include "oscore.h"
+#include "oscore/oscore_coap.h"
+
+#include "common/byte_array.h"
+#include "common/oscore_edhoc_error.h"
+
+/*
+ * EDHOC + OSCORE request, see RFC 9668. The initiator derives the OSCORE
+ * context as soon as message_3 is created and sends message_3 together with
+ * its first OSCORE request in one CoAP request carrying the EDHOC option.
+ * The responder processes message_3, derives the same context and decrypts
+ * the request, so one round trip is saved.
+ *
+ * The OSCORE Sender ID of the initiator is C_R and its Recipient ID is C_I.
+ * The context uses the application AEAD and hash algorithms of the
+ * negotiated suite. OSCORE supports AES-CCM-16-64-128 and SHA-256, the
+ * application algorithms of suites 0 to 3. The combined request can
+ * not be used with MESSAGE_4, since the initiator would have to wait for
+ * message_4 before it can use the context.
+ */
+
+/* Maximal length of an OSCORE request */
+#ifndef OSCORE_REQUEST_MAX_LEN
+#define OSCORE_REQUEST_MAX_LEN                                                 \
+	(HEADER_LEN + MAX_TOKEN_LEN + MAX_COAP_OPTIONS_LEN + 1 +               \
+	 MAX_CIPHERTEXT_LEN)
+#endif
+
+/**
+ * @brief Derives an OSCORE context from PRK_out of a completed handshake
+ *        with the application AEAD and hash algorithms of its suite.
+ *
+ * @param[in] suite the suite of the handshake
+ * @param[in] prk_out PRK_out of the handshake
+ * @param[in] sender_id own OSCORE Sender ID, i.e. the connection identifier
+ *            chosen by the other party
+ * @param[in] recipient_id own OSCORE Recipient ID, i.e. the own connection
+ *            identifier
+ * @param[out] c the OSCORE context
+ * @return ok or error code
+ */
+enum err edhoc_oscore_context_derive(const struct suite *suite,
+				     struct byte_array *prk_out,
+				     const struct byte_array *sender_id,
+				     const struct byte_array *recipient_id,
+				     struct context *c);
+
+/**
+ * @brief Processes message 2, creates message 3, derives the OSCORE context
+ *        and protects a CoAP request with it. The result is the EDHOC +
+ *        OSCORE request to be sent. After a successful call the session is
+ *        DONE.
+ *
+ * @param s the initiator session, waiting for message 2
+ * @param[in] msg2 the received message 2
+ * @param[in] coap_req the first CoAP request of the initiator
+ * @param coap_req_len length of the CoAP request
+ * @param[out] oscore_c the OSCORE context, used for the response and later
+ *             requests
+ * @param[out] buf_out the combined request
+ * @param[in,out] buf_out_len in: size of buf_out, out: length of the request
+ * @return ok or error code
+ */
+enum err edhoc_initiator_combined_request(struct edhoc_initiator_session *s,
+					  const struct byte_array *msg2,
+					  uint8_t *coap_req,
+					  uint32_t coap_req_len,
+					  struct context *oscore_c,
+					  uint8_t *buf_out,
+					  uint32_t *buf_out_len);
+
+/**
+ * @brief Processes an EDHOC + OSCORE request: message_3 is processed by the
+ *        handshake with the C_R of the request, the OSCORE context is
+ *        derived and the OSCORE request is decrypted. After a successful
+ *        call the session is DONE and stays in the table until it is
+ *        released, see edhoc_responder_session_table_msg3().
+ *
+ * @param t the session table
+ * @param[in] buf_in the received request
+ * @param buf_in_len length of the request
+ * @param[out] oscore_c the OSCORE context, used for the response and later
+ *             requests
+ * @param[out] coap_out the decrypted CoAP request
+ * @param[in,out] coap_out_len in: size of coap_out, out: length of the
+ *                request
+ * @param[out] s the session
+ * @return ok, oscore_no_edhoc_option if the request is not combined,
+ *         edhoc_session_not_found or the error of the processing
+ */
+enum err
+edhoc_responder_combined_request(struct edhoc_responder_session_table *t,
+				 uint8_t *buf_in, uint32_t buf_in_len,
+				 struct context *oscore_c, uint8_t *coap_out,
+				 uint32_t *coap_out_len,
+				 struct edhoc_responder_session **s);
+
+#endif
@@ -0,0 +1,74 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifndef CRED_INDEX_H
+#define CRED_INDEX_H
+
+#include <stdint.h>
+
+#include "edhoc.h"
+
+#include "common/byte_array.h"
+#include "common/oscore_edhoc_error.h"
+
+/*
+ * A hash index over the ID_CRED_x of the credentials in a cred_array. When a
+ * cred_array has an index retrieve_cred() finds a locally stored credential
+ * (kid, x5t, x5u, c5t, c5u) with a single hash lookup instead of comparing
+ * ID_CRED_x with every entry. Since a kid is looked up with the ID_CRED_x map
+ * reconstructed from the compact encoding, kid values are covered by the
+ * same index.
+ *
+ * The index is built once, e.g. when the credentials are loaded. It is not
+ * changed by lookups, so one index can be used by several threads at the
+ * same time. To change the credentials a new index should be built and
+ * assigned to the cred_array while no handshake uses it.
+ */
+
+struct cred_index {
+	const struct cred_array *creds;
+	/*open addressing table, an entry is the position in creds + 1 or 0 if
+	the entry is free*/
+	uint32_t *table;
+	/*number of entries in table, a power of two*/
+	uint32_t table_len;
+};
+
+/**
+ * @brief	Builds an index over the credentials of a cred_array and
+ *		assigns it to creds->index. If an ID_CRED_x is contained more
+ *		than once the first credential is found, as with the linear
+ *		search.
+ *
+ * @param idx	The index.
+ * @param creds	The credentials. Must not be changed while the index is used.
+ * @param table	Memory for the table of the index.
+ * @param table_len Number of entries in table. Must be a power of two and
+ *		larger than creds->len. For short lookups it should be at
+ *		least 2 * creds->len.
+ * @return	ok, wrong_parameter or cred_index_too_small
+ */
+enum err cred_index_build(struct cred_index *idx, struct cred_array *creds,
+			  uint32_t *table, uint32_t table_len);
+
+/**
+ * @brief	Looks up a credential by its ID_CRED_x.
+ *
+ * @param idx	The index.
+ * @param id_cred ID_CRED_x.
+ * @param[out] cred The credential.
+ * @return	ok or credential_not_found
+ */
+enum err cred_index_find(const struct cred_index *idx,
+			 const struct byte_array *id_cred,
+			 const struct other_party_cred **cred);
+
+#endif
@@ -0,0 +1,150 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifndef EPHEMERAL_KEY_POOL_H
+#define EPHEMERAL_KEY_POOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "edhoc/buffer_sizes.h"
+#include "edhoc/runtime_context.h"
+#include "edhoc/suites.h"
+
+#include "common/byte_array.h"
+#include "common/oscore_edhoc_error.h"
+
+/*
+ * With EPHEMERAL_KEY_POOL defined msg1_gen() and msg2_gen() take the
+ * ephemeral DH key pair from a pool that is kept filled in advance, e.g. by
+ * a low priority thread, instead of using the keys in the initiator/responder
+ * context. This moves the key generation out of the handshake. If the pool
+ * of the negotiated algorithm is empty the keys of the context are used.
+ *
+ * Each pool is a single producer / single consumer ring: one thread calls
+ * ephemeral_key_pool_fill() while the thread running the handshakes takes
+ * the keys. Every key pair is handed out only once and erased from the pool
+ * when it is taken. The copy used by the handshake is erased as soon as it
+ * is not needed anymore.
+ *
+ * The table of registered pools is not synchronized. Pools are registered
+ * and unregistered at startup and shutdown, while no handshake runs and no
+ * thread fills a pool.
+ */
+
+/* Number of key pairs held by a pool */
+#ifndef EPHEMERAL_KEY_POOL_SIZE
+#define EPHEMERAL_KEY_POOL_SIZE 4
+#endif
+
+/* Number of pools (one per ECDH algorithm) that can be registered */
+#ifndef EPHEMERAL_KEY_POOL_ALGS
+#define EPHEMERAL_KEY_POOL_ALGS 2
+#endif
+
+struct ephemeral_key_pair {
+	uint8_t sk[P_256_PRIV_KEY_SIZE];
+	uint32_t sk_len;
+	uint8_t pk[G_X_SIZE];
+	uint32_t pk_len;
+};
+
+struct ephemeral_key_pool {
+	enum ecdh_alg alg;
+	struct ephemeral_key_pair pairs[EPHEMERAL_KEY_POOL_SIZE];
+	/*number of pairs ever added, written only by the producer*/
+	uint32_t head;
+	/*number of pairs ever taken, written only by the consumer*/
+	uint32_t tail;
+};
+
+/**
+ * @brief	Initializes an empty pool.
+ *
+ * @param pool	The pool.
+ * @param alg	The ECDH algorithm of the keys in the pool.
+ */
+void ephemeral_key_pool_init(struct ephemeral_key_pool *pool,
+			     enum ecdh_alg alg);
+
+/**
+ * @brief	Makes a pool available to msg1_gen() and msg2_gen(). Only one
+ *		pool per algorithm can be registered. Must not be called
+ *		while handshakes run, see above.
+ *
+ * @param pool	The pool.
+ * @return	ok or ephemeral_key_pool_no_space
+ */
+enum err ephemeral_key_pool_register(struct ephemeral_key_pool *pool);
+
+/**
+ * @brief	Removes a pool from the registered pools. Must not be called
+ *		while handshakes run, see above.
+ *
+ * @param pool	The pool.
+ */
+void ephemeral_key_pool_unregister(struct ephemeral_key_pool *pool);
+
+/**
+ * @brief	Generates one key pair with ephemeral_dh_key_gen() and adds it
+ *		to the pool. Called by the producer, e.g. in a loop of a low
+ *		priority thread which sleeps while the pool is full.
+ *
+ * @param pool	The pool.
+ * @param seed	A random seed, see ephemeral_dh_key_gen().
+ * @param[out] full True if the pool is full (no key was generated).
+ * @return	ok or error code of the key generation.
+ */
+enum err ephemeral_key_pool_fill(struct ephemeral_key_pool *pool,
+				 uint32_t seed, bool *full);
+
+/**
+ * @brief	Returns the number of key pairs in a pool.
+ */
+uint32_t ephemeral_key_pool_count(const struct ephemeral_key_pool *pool);
+
+/**
+ * @brief	Takes a key pair out of the registered pool of an algorithm.
+ *		The pair is erased from the pool.
+ *
+ * @param alg	The ECDH algorithm.
+ * @param[out] pair The key pair.
+ * @return	true if a pair was available.
+ */
+bool ephemeral_key_pool_take(enum ecdh_alg alg,
+			     struct ephemeral_key_pair *pair);
+
+/**
+ * @brief	Selects the own ephemeral key pair of a handshake: a pair taken
+ *		from the pool if available, otherwise the keys of the
+ *		context. The result is stored in rc->eph_sk and rc->eph_pk.
+ *
+ * @param rc	The runtime context.
+ * @param alg	The negotiated ECDH algorithm.
+ * @param sk	The private key in the context or NULL if the keys of the
+ *		context are not usable with alg.
+ * @param pk	The public key in the context or NULL.
+ * @return	false if no key pair was selected, also if the pool is empty
+ *		and the keys of the context are empty.
+ */
+bool ephemeral_key_select(struct runtime_context *rc, enum ecdh_alg alg,
+			  const struct byte_array *sk,
+			  const struct byte_array *pk);
+
+/**
+ * @brief	Erases a private key taken from the pool once it is not needed
+ *		anymore. Keys of the context are left untouched.
+ *
+ * @param rc	The runtime context.
+ */
+void ephemeral_key_erase(struct runtime_context *rc);
+
+#endif
@@ -29,6 +29,10 @@ struct msg_2 {
 	struct byte_array ciphertext;
 };
 
+/* ERR_CODE of an error message if the selected cipher suite is not supported,
+ * ERR_INFO is SUITES_R (RFC 9528 Section 6.3) */
+#define ERR_CODE_WRONG_SELECTED_CIPHER_SUITE 2
+
 struct error_msg {
 	struct byte_array c_x;
 	struct byte_array diag_msg;
@@ -11,13 +11,42 @@
 #ifndef OKM_H
 #define OKM_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "hkdf_info.h"
 #include "suites.h"
 
+#include "common/byte_array.h"
+#include "common/crypto_wrapper.h"
 #include "common/oscore_edhoc_error.h"
 
+/*
+ * A PRK (PRK_2e, PRK_3e2m, PRK_4e3m, PRK_out) prepared for EDHOC-KDF. The 
+ * HMAC key setup (hashing K XOR ipad and K XOR opad) is done once by 
+ * prk_handle_init(). Every block of every expansion under the PRK starts 
+ * from a copy of the keyed state. A handle holds key material and must be 
+ * wiped with prk_handle_wipe() when the PRK is not needed anymore.
+ *
+ * The prepared HMAC is built on hmac_init(), hmac_update() and hmac_final(),
+ * which can be overridden like the other functions of crypto_wrapper.h. 
+ * With EDHOC_KDF_HKDF_EXPAND, or if an HKDF provider is registered (see 
+ * crypto_provider.h) when the handle is prepared, the handle keeps the PRK 
+ * instead and every EDHOC-KDF is computed by hkdf_expand(), e.g. to use the 
+ * HKDF of the PSA backend or an overridden hkdf_expand().
+ */
+struct prk_handle {
+	struct hmac_ctx keyed;
+	enum hash_alg alg;
+	/*the PRK is passed to hkdf_expand()*/
+	bool expand;
+	uint8_t prk[HASH_SIZE];
+	uint32_t prk_len;
+};
+
+/* Indices of the PRKs of a handshake in an array of handles */
+enum prk_handle_index { PRK_2E_H, PRK_3E2M_H, PRK_4E3M_H, PRK_HANDLES };
+
 /**
  * @brief                       Derives output keying material.
  * 
@@ -32,4 +61,68 @@ enum err edhoc_kdf(enum hash_alg hash_alg, const struct byte_array *prk,
 		   uint8_t label, struct byte_array *context,
 		   struct byte_array *okm);
 
+/**
+ * @brief                       Derives output keying material. The context 
+ *                              is given as pieces which are fed one after 
+ *                              another into the HMAC of HKDF-Expand, so no 
+ *                              buffer with the context or the info is built.
+ * 
+ * @param hash_alg              HASH algorithm. 
+ * @param[in] prk               Pseudorandom key.
+ * @param[in] label             Predefined integer value.
+ * @param[in] context           The pieces of the context. Their 
+ *                              concatenation is the context.
+ * @param context_pieces        Number of pieces.
+ * @param[out] okm              The result.
+ * @retval                      Ok or error code.
+ */
+enum err edhoc_kdf_pieces(enum hash_alg hash_alg, const struct byte_array *prk,
+			  uint8_t label, const struct byte_array *context,
+			  uint32_t context_pieces, struct byte_array *okm);
+
+
+/**
+ * @brief                       Prepares a PRK for edhoc_kdf_handle().
+ * 
+ * @param hash_alg              HASH algorithm. 
+ * @param[in] prk               Pseudorandom key.
+ * @param[out] h                The handle.
+ * @retval                      Ok or error code.
+ */
+enum err prk_handle_init(enum hash_alg hash_alg, const struct byte_array *prk,
+			 struct prk_handle *h);
+
+/**
+ * @brief                       Copies a handle, e.g. when PRK_3e2m equals 
+ *                              PRK_2e. No key setup is needed.
+ * 
+ * @param[in] src               The handle to be copied.
+ * @param[out] dst              The copy.
+ * @retval                      Ok or error code.
+ */
+enum err prk_handle_copy(const struct prk_handle *src, struct prk_handle *dst);
+
+/**
+ * @brief                       Wipes a handle. A handle set to zero can be 
+ *                              passed too.
+ * 
+ * @param[in,out] h             The handle.
+ */
+void prk_handle_wipe(struct prk_handle *h);
+
+/**
+ * @brief                       Derives output keying material under a 
+ *                              prepared PRK, see edhoc_kdf_pieces().
+ * 
+ * @param[in] h                 The prepared PRK.
+ * @param[in] label             Predefined integer value.
+ * @param[in] context           The pieces of the context.
+ * @param context_pieces        Number of pieces.
+ * @param[out] okm              The result.
+ * @retval                      Ok or error code.
+ */
+enum err edhoc_kdf_handle(const struct prk_handle *h, uint8_t label,
+			  const struct byte_array *context,
+			  uint32_t context_pieces, struct byte_array *okm);
+
 #endif
@@ -15,6 +15,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "edhoc/okm.h"
+
 #include "common/byte_array.h"
 #include "common/oscore_edhoc_error.h"
 
@@ -27,14 +29,19 @@
  * @param label                 EDHOC-KDF label. 
  * @param[in] context           EDHOC-KDF context.
  * @param[in] prk_in            Input prk.
+ * @param[in] prk_in_h          Input prk prepared for EDHOC-KDF.
  * @param[in] stat_pk           Static public DH key. 
  * @param[in] stat_sk           Static secret DH key. 
  * @param[out] prk_out          The result.
+ * @param[out] prk_out_h        The result prepared for EDHOC-KDF. Without 
+ *                              static DH keys it is a copy of prk_in_h.
  * @retval                      Ok or error code.
  */
 enum err prk_derive(bool static_dh_auth, struct suite suite, uint8_t label,
 		    struct byte_array *context, const struct byte_array *prk_in,
+		    const struct prk_handle *prk_in_h,
 		    const struct byte_array *stat_pk,
-		    const struct byte_array *stat_sk, uint8_t *prk_out);
+		    const struct byte_array *stat_sk, uint8_t *prk_out,
+		    struct prk_handle *prk_out_h);
 
 #endif
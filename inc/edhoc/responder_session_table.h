@@ -0,0 +1,169 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifndef RESPONDER_SESSION_TABLE_H
+#define RESPONDER_SESSION_TABLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "edhoc_internal.h"
+
+#include "common/byte_array.h"
+#include "common/oscore_edhoc_error.h"
+
+/*
+ * A responder serving many initiators keeps every handshake in progress in a
+ * slot of a fixed-size table. The connection identifier C_R of a handshake
+ * is chosen by the table and encodes the index of the slot, so that a
+ * message_3 (which is prefixed with C_R by the transport, see RFC9528
+ * Appendix A.2) is mapped to its handshake without searching. Handshakes that
+ * are not completed within a timeout are removed by
+ * edhoc_responder_session_table_expire().
+ */
+
+/* Maximal number of handshakes handled at the same time */
+#ifndef EDHOC_SESSION_TABLE_SIZE
+#define EDHOC_SESSION_TABLE_SIZE 4
+#endif
+
+/* Length of the C_R values allocated by the table */
+#if EDHOC_SESSION_TABLE_SIZE <= 256
+#define EDHOC_SESSION_TABLE_C_R_LEN 1
+#elif EDHOC_SESSION_TABLE_SIZE <= 65536
+#define EDHOC_SESSION_TABLE_C_R_LEN 2
+#else
+#error "EDHOC_SESSION_TABLE_SIZE must not be larger than 65536"
+#endif
+
+#if C_R_SIZE < EDHOC_SESSION_TABLE_C_R_LEN
+#error "C_R_SIZE is too small for EDHOC_SESSION_TABLE_SIZE"
+#endif
+
+struct edhoc_responder_session_slot {
+	struct edhoc_responder_session s;
+	/*copy of the responder context of the table with the C_R of the slot*/
+	struct edhoc_responder_context c;
+	uint8_t c_r_buf[EDHOC_SESSION_TABLE_C_R_LEN];
+	/*time after which a not completed handshake is expired*/
+	uint32_t deadline;
+	bool in_use;
+};
+
+struct edhoc_responder_session_table {
+	const struct edhoc_responder_context *c;
+	struct cred_array *cred_i_array;
+	uint32_t timeout;
+	/*indexes of the free slots*/
+	uint16_t free_slots[EDHOC_SESSION_TABLE_SIZE];
+	uint32_t free_cnt;
+	struct edhoc_responder_session_slot slots[EDHOC_SESSION_TABLE_SIZE];
+};
+
+/**
+ * @brief Initializes a session table. The C_R of the responder context is
+ *        replaced by the C_R allocated for each handshake.
+ *
+ * @param t the table
+ * @param c responder context, must be valid for the lifetime of the table
+ * @param cred_i_array trust anchors for authenticating the initiators
+ * @param timeout time within which a handshake must be completed, in the
+ *        same unit as the now parameter of the other functions
+ */
+void edhoc_responder_session_table_init(
+	struct edhoc_responder_session_table *t,
+	const struct edhoc_responder_context *c,
+	struct cred_array *cred_i_array, uint32_t timeout);
+
+/**
+ * @brief Starts a new handshake: allocates a slot and a C_R, processes
+ *        message 1 and creates message 2.
+ *
+ * @param t the table
+ * @param now the current time
+ * @param msg1 the received message 1
+ * @param msg2 points to message 2 which must be sent
+ * @param s the new session
+ * @return ok, edhoc_session_table_full or the error of the message
+ *         processing. After an error no slot is occupied.
+ */
+enum err edhoc_responder_session_table_msg1(
+	struct edhoc_responder_session_table *t, uint32_t now,
+	const struct byte_array *msg1, struct byte_array *msg2,
+	struct edhoc_responder_session **s);
+
+/**
+ * @brief Returns the handshake in progress with a given C_R.
+ *
+ * @param t the table
+ * @param c_r the connection identifier
+ * @param s the session
+ * @return ok or edhoc_session_not_found
+ */
+enum err edhoc_responder_session_table_get(
+	struct edhoc_responder_session_table *t, const struct byte_array *c_r,
+	struct edhoc_responder_session **s);
+
+/**
+ * @brief Looks up the handshake with a given C_R and processes message 3.
+ *        After a successful call the session is DONE and stays in the table
+ *        until it is released, so that the caller can use s->prk_out. After
+ *        an error the session is released.
+ *
+ * @param t the table
+ * @param c_r the connection identifier received with message 3
+ * @param msg3 the received message 3
+ * @param msg4 points to message 4 if MESSAGE_4 is enabled, otherwise its
+ *        length is 0
+ * @param s the session
+ * @return ok, edhoc_session_not_found or the error of the message
+ *         processing
+ */
+enum err edhoc_responder_session_table_msg3(
+	struct edhoc_responder_session_table *t, const struct byte_array *c_r,
+	const struct byte_array *msg3, struct byte_array *msg4,
+	struct edhoc_responder_session **s);
+
+/**
+ * @brief Frees the slot of a session, its C_R can be allocated again.
+ *
+ * @param t the table
+ * @param s the session
+ */
+void edhoc_responder_session_table_release(
+	struct edhoc_responder_session_table *t,
+	struct edhoc_responder_session *s);
+
+/**
+ * @brief Releases all not completed handshakes whose timeout has elapsed.
+ *        Should be called periodically, e.g. from a timer.
+ *
+ * @param t the table
+ * @param now the current time
+ * @return the number of released handshakes
+ */
+uint32_t
+edhoc_responder_session_table_expire(struct edhoc_responder_session_table *t,
+				     uint32_t now);
+
+/**
+ * @brief Returns the number of handshakes in the table. Unlike the other 
+ *        functions it may be called while another thread uses the table, 
+ *        e.g. by the admission control of a receive thread. The result is 
+ *        then a snapshot.
+ *
+ * @param t the table
+ * @return the number of occupied slots
+ */
+uint32_t edhoc_responder_session_table_in_progress(
+	const struct edhoc_responder_session_table *t);
+
+#endif
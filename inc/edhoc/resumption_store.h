@@ -0,0 +1,268 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifndef RESUMPTION_STORE_H
+#define RESUMPTION_STORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "edhoc.h"
+#include "edhoc/buffer_sizes.h"
+#include "edhoc/suites.h"
+#include "edhoc/ttl_cache.h"
+
+#include "common/byte_array.h"
+#include "common/oscore_edhoc_error.h"
+
+/*
+ * Store of PRK_out of finished handshakes, used to resume a connection
+ * without a new EDHOC run. Initiator and responder each keep an entry
+ * per connection. The responder looks entries up by the connection
+ * identifier C_R, which it chose to be unique. The initiator looks them up
+ * by the identity of the responder and C_R, since different responders
+ * may choose the same C_R.
+ *
+ * To resume, the initiator sends C_R and a nonce N_I, the responder answers
+ * with a nonce N_R (resumption_request_gen(), resumption_request_process(),
+ * resumption_response_process()). Both export a new OSCORE master secret
+ * and salt from prk_out_update(PRK_out, N_I | N_R). A resumption therefore
+ * costs only HKDFs and one round trip.
+ *
+ * The request is not authenticated and the response may be lost, so both
+ * keep PRK_out and the pending nonces until the new OSCORE context is
+ * shown to work, e.g. the first OSCORE message protected with it is
+ * verified. Then resumption_store_confirm() replaces PRK_out, with the
+ * nonces of the request and response from which that context was derived.
+ * Until then a lost response is recovered by sending the request again:
+ * the initiator sends the same N_I and the responder answers with the same
+ * N_R. A forged request only replaces the pending nonces of the responder;
+ * the initiator then receives another N_R and still derives the same keys.
+ * Since the confirmation takes the nonces of the exchange that worked, and
+ * not the pending ones, a forged request received after the real one does
+ * not make the two sides update PRK_out differently.
+ *
+ * resumption_store_resume() does a resumption with known nonces in one
+ * step and replaces PRK_out right away.
+ *
+ * An entry expires after the TTL of the store counted from the full
+ * handshake, resumptions do not extend it. Replaced, expired and removed
+ * entries are securely erased.
+ */
+
+#ifndef RESUMPTION_ID_MAX_SIZE
+#define RESUMPTION_ID_MAX_SIZE C_R_SIZE
+#endif
+
+#ifndef RESUMPTION_NONCE_MAX_SIZE
+#define RESUMPTION_NONCE_MAX_SIZE 16
+#endif
+
+/* Maximal size of a resumption request, C_R and N_I as CBOR byte strings */
+#define RESUMPTION_REQUEST_SIZE                                                \
+	(RESUMPTION_ID_MAX_SIZE + RESUMPTION_NONCE_MAX_SIZE + 4)
+
+/* Maximal size of a resumption response, N_R as CBOR byte string */
+#define RESUMPTION_RESPONSE_SIZE (RESUMPTION_NONCE_MAX_SIZE + 2)
+
+enum resumption_role { RESUMPTION_INITIATOR, RESUMPTION_RESPONDER };
+
+struct resumption_entry {
+	struct ttl_cache_slot slot;
+	/*C_R of the connection*/
+	uint8_t id[RESUMPTION_ID_MAX_SIZE];
+	uint32_t id_len;
+	/*SHA-256 of the identity of the peer, e.g. of its ID_CRED*/
+	uint8_t peer[HASH_SIZE];
+	enum suite_label suite;
+	uint8_t prk_out[PRK_SIZE];
+	/*nonces of a resumption not confirmed yet, a length of 0 if none*/
+	uint8_t nonce_i[RESUMPTION_NONCE_MAX_SIZE];
+	uint32_t nonce_i_len;
+	uint8_t nonce_r[RESUMPTION_NONCE_MAX_SIZE];
+	uint32_t nonce_r_len;
+};
+
+/* A TTL cache (see edhoc/ttl_cache.h) of struct resumption_entry */
+struct resumption_store {
+	struct ttl_cache base;
+	enum resumption_role role;
+};
+
+/**
+ * @brief	Initializes a store. The fields now, lock, unlock and lock_ctx
+ *		of the base can be set afterwards.
+ *
+ * @param store	The store.
+ * @param entries Memory for the entries.
+ * @param entries_len Number of entries.
+ * @param ttl	Time an entry is valid.
+ * @param role	The role of the device in the handshakes kept.
+ */
+void resumption_store_init(struct resumption_store *store,
+			   struct resumption_entry *entries,
+			   uint32_t entries_len, uint32_t ttl,
+			   enum resumption_role role);
+
+/**
+ * @brief	Keeps PRK_out of a finished handshake. An entry of the same
+ *		connection (at the responder with the same C_R, at the
+ *		initiator with the same C_R and peer) is replaced. If the
+ *		store is full an expired entry or, if there is none, the
+ *		entries in turn are replaced.
+ *
+ * @param store	The store.
+ * @param[in] id The connection identifier C_R.
+ * @param[in] peer_id The identity of the peer, e.g. its ID_CRED. The
+ *		responder may pass NULL.
+ * @param suite	The cipher suite of the handshake.
+ * @param[in] prk_out PRK_out of the handshake.
+ * @return	ok or wrong_parameter if a parameter is too long for an
+ *		entry or the initiator passes no peer identity.
+ */
+enum err resumption_store_put(struct resumption_store *store,
+			      const struct byte_array *id,
+			      const struct byte_array *peer_id,
+			      enum suite_label suite,
+			      const struct byte_array *prk_out);
+
+/**
+ * @brief	Resumes a connection. PRK_out of the entry is replaced by
+ *		prk_out_update(PRK_out, N_I | N_R) and a new OSCORE master
+ *		secret and salt are exported from it.
+ *
+ * @param store	The store.
+ * @param[in] id The connection identifier C_R.
+ * @param[in] peer_id The identity of the peer. The responder may pass NULL
+ *		to skip the check.
+ * @param[in] nonce_i The nonce N_I of the initiator.
+ * @param[in] nonce_r The nonce N_R of the responder.
+ * @param[out] master_secret The OSCORE master secret, its length is the
+ *		requested length.
+ * @param[out] master_salt The OSCORE master salt, its length is the
+ *		requested length.
+ * @return	ok, resumption_not_found if there is no valid entry,
+ *		resumption_peer_mismatch or an error of the key derivation.
+ */
+enum err resumption_store_resume(struct resumption_store *store,
+				 const struct byte_array *id,
+				 const struct byte_array *peer_id,
+				 const struct byte_array *nonce_i,
+				 const struct byte_array *nonce_r,
+				 struct byte_array *master_secret,
+				 struct byte_array *master_salt);
+
+/**
+ * @brief	Starts a resumption at the initiator. If a request for the
+ *		connection is pending, i.e. not confirmed yet, it is sent
+ *		again with its nonce.
+ *
+ * @param store	The store.
+ * @param[in] id The connection identifier C_R.
+ * @param[in] peer_id The identity of the responder.
+ * @param[in] nonce_i A fresh random nonce N_I.
+ * @param[out] request The request: C_R and N_I as CBOR byte strings, at
+ *		most RESUMPTION_REQUEST_SIZE bytes.
+ * @return	ok, resumption_not_found or an error code.
+ */
+enum err resumption_request_gen(struct resumption_store *store,
+				const struct byte_array *id,
+				const struct byte_array *peer_id,
+				const struct byte_array *nonce_i,
+				struct byte_array *request);
+
+/**
+ * @brief	Answers a resumption request at the responder and exports the
+ *		new OSCORE master secret and salt. A request with the pending
+ *		N_I, i.e. a retransmission, is answered with the same N_R.
+ *
+ * @param store	The store.
+ * @param[in] request The request.
+ * @param[in] nonce_r A fresh random nonce N_R.
+ * @param[out] response The response: N_R as CBOR byte string, at most
+ *		RESUMPTION_RESPONSE_SIZE bytes.
+ * @param[out] id The connection identifier C_R of the request, at least
+ *		RESUMPTION_ID_MAX_SIZE bytes.
+ * @param[out] master_secret The OSCORE master secret.
+ * @param[out] master_salt The OSCORE master salt.
+ * @return	ok, resumption_not_found, cbor_decoding_error or an error of
+ *		the key derivation.
+ */
+enum err resumption_request_process(struct resumption_store *store,
+				    const struct byte_array *request,
+				    const struct byte_array *nonce_r,
+				    struct byte_array *response,
+				    struct byte_array *id,
+				    struct byte_array *master_secret,
+				    struct byte_array *master_salt);
+
+/**
+ * @brief	Processes the response of the responder at the initiator and
+ *		exports the new OSCORE master secret and salt.
+ *
+ * @param store	The store.
+ * @param[in] id The connection identifier C_R.
+ * @param[in] peer_id The identity of the responder.
+ * @param[in] response The response.
+ * @param[out] master_secret The OSCORE master secret.
+ * @param[out] master_salt The OSCORE master salt.
+ * @return	ok, resumption_not_found if no request is pending,
+ *		cbor_decoding_error or an error of the key derivation.
+ */
+enum err resumption_response_process(struct resumption_store *store,
+				     const struct byte_array *id,
+				     const struct byte_array *peer_id,
+				     const struct byte_array *response,
+				     struct byte_array *master_secret,
+				     struct byte_array *master_salt);
+
+/**
+ * @brief	Completes a resumption once the new OSCORE context works:
+ *		PRK_out is replaced by prk_out_update(PRK_out, N_I | N_R) of
+ *		the nonces of the given request and response, so the old
+ *		PRK_out is not used again. The pending nonces are dropped.
+ *
+ * @param store	The store.
+ * @param[in] id The connection identifier C_R.
+ * @param[in] peer_id The identity of the peer, NULL at the responder.
+ * @param[in] request The request from which the working context was
+ *		derived, as sent or received.
+ * @param[in] response The response to it, as sent or received.
+ * @return	ok, resumption_not_found if no resumption is pending,
+ *		wrong_parameter if the request is for another C_R,
+ *		cbor_decoding_error or an error of the key derivation.
+ */
+enum err resumption_store_confirm(struct resumption_store *store,
+				  const struct byte_array *id,
+				  const struct byte_array *peer_id,
+				  const struct byte_array *request,
+				  const struct byte_array *response);
+
+/**
+ * @brief	Removes and erases the entry of a connection, e.g. when the
+ *		peer is not trusted anymore.
+ *
+ * @param store	The store.
+ * @param[in] id The connection identifier C_R.
+ * @param[in] peer_id The identity of the peer, NULL at the responder.
+ */
+void resumption_store_remove(struct resumption_store *store,
+			     const struct byte_array *id,
+			     const struct byte_array *peer_id);
+
+/**
+ * @brief	Removes and erases all entries.
+ *
+ * @param store	The store.
+ */
+void resumption_store_clear(struct resumption_store *store);
+
+#endif
@@ -27,8 +27,20 @@ struct runtime_context {
 	struct suite suite;
 	uint8_t msg1_hash_buf[HASH_SIZE];
 	struct byte_array msg1_hash;
+	/*own ephemeral DH keys, see edhoc/ephemeral_key_pool.h*/
+	struct byte_array eph_sk;
+	struct byte_array eph_pk;
+#ifdef EPHEMERAL_KEY_POOL
+	uint8_t eph_sk_buf[P_256_PRIV_KEY_SIZE];
+	uint8_t eph_pk_buf[G_X_SIZE];
+#endif
 
 	/*initiator specific*/
+	/*identifier of the responder, key of the suite cache*/
+	struct byte_array peer_id;
+	/*number of suites of the context sent in SUITES_I after the responder
+	rejected the selected suite, 0 before*/
+	uint32_t suites_i_len;
 	uint8_t th4_buf[HASH_SIZE];
 	struct byte_array th4;
 	uint8_t prk_4e3m_buf[PRK_SIZE];
@@ -13,6 +13,7 @@
 
 #include <stdbool.h>
 
+#include "okm.h"
 #include "suites.h"
 
 #include "common/oscore_edhoc_error.h"
@@ -27,7 +28,8 @@ enum sgn_or_mac_op { VERIFY, GENERATE };
  * @param suite                  The cipher suite.
  * @param[in] sk                 Secret key.
  * @param[in] pk                 Public key. 
- * @param[in] prk                Pseudo random key used in key/iv generation. 
+ * @param[in] prk                Pseudo random key used for the mac, prepared
+ *                               for EDHOC-KDF.
  * @param[in] th                 Transcript hash.
  * @param[in] id_cred            ID_CRED of the calling party.
  * @param[in] cred               CRED of the calling party.
@@ -39,7 +41,7 @@ enum sgn_or_mac_op { VERIFY, GENERATE };
 enum err
 signature_or_mac(enum sgn_or_mac_op op, bool static_dh, struct suite *suite,
 		 const struct byte_array *sk, const struct byte_array *pk,
-		 const struct byte_array *prk, const struct byte_array *c_r,
+		 const struct prk_handle *prk, const struct byte_array *c_r,
 		 const struct byte_array *th, const struct byte_array *id_cred,
 		 const struct byte_array *cred, const struct byte_array *ead,
 		 enum info_label mac_label, struct byte_array *sig_or_mac);
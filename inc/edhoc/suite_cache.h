@@ -0,0 +1,105 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifndef SUITE_CACHE_H
+#define SUITE_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "edhoc/buffer_sizes.h"
+#include "edhoc/ttl_cache.h"
+
+#include "common/byte_array.h"
+
+/*
+ * Cache of the cipher suites selected for responders. If a responder does
+ * not support the suite selected by the initiator (the last of suites_i), it
+ * answers message 1 with an error message containing SUITES_R. The
+ * initiator then selects the first suite of suites_i that is contained in
+ * SUITES_R and sends a new message 1 with suites_i truncated after that
+ * suite. This is done inside edhoc_initiator_run_peer() and
+ * edhoc_initiator_session_step(), at most once per handshake.
+ *
+ * When a cache is registered, the selected suite is stored under the
+ * identifier of the responder (e.g. its address) passed to
+ * edhoc_initiator_run_peer() or edhoc_initiator_session_peer_set(). Since
+ * the error message is not authenticated, this is done only after
+ * message 2 is verified, whose TH_2 covers the truncated SUITES_I.
+ * msg1_gen() looks the identifier up, so later handshakes with the same
+ * responder select the suite right away and the error round trip is needed
+ * at most once per responder and TTL. Only the SHA-256 digest of the
+ * identifier is stored.
+ *
+ * The ephemeral key in the initiator context belongs to the last suite of
+ * suites_i. If a suite with another ECDH curve is selected, the ephemeral
+ * key is taken from the pool of that curve (see edhoc/ephemeral_key_pool.h).
+ */
+
+struct suite_cache_entry {
+	struct ttl_cache_slot slot;
+	uint8_t peer[HASH_SIZE];
+	uint8_t suite;
+};
+
+/* A TTL cache (see edhoc/ttl_cache.h) of struct suite_cache_entry */
+struct suite_cache {
+	struct ttl_cache base;
+};
+
+/**
+ * @brief	Initializes a cache. The fields now, lock, unlock and lock_ctx
+ *		of the base can be set afterwards.
+ *
+ * @param cache	The cache.
+ * @param entries Memory for the entries.
+ * @param entries_len Number of entries.
+ * @param ttl	Time an entry is valid.
+ */
+void suite_cache_init(struct suite_cache *cache,
+		      struct suite_cache_entry *entries, uint32_t entries_len,
+		      uint32_t ttl);
+
+/**
+ * @brief	Makes a cache available to the initiator.
+ *
+ * @param cache	The cache or NULL to stop caching.
+ */
+void suite_cache_register(struct suite_cache *cache);
+
+/**
+ * @brief	Removes all entries.
+ *
+ * @param cache	The cache.
+ */
+void suite_cache_invalidate(struct suite_cache *cache);
+
+/**
+ * @brief	Looks up the suite selected for a responder in the registered
+ *		cache.
+ *
+ * @param[in] peer_id The identifier of the responder.
+ * @param[out] suite The suite.
+ * @return	true on a hit.
+ */
+bool suite_cache_get(const struct byte_array *peer_id, uint8_t *suite);
+
+/**
+ * @brief	Stores the suite selected for a responder in the registered
+ *		cache. If the cache is full an expired entry or, if there is
+ *		none, the entries in turn are replaced.
+ *
+ * @param[in] peer_id The identifier of the responder.
+ * @param suite	The suite.
+ */
+void suite_cache_put(const struct byte_array *peer_id, uint8_t suite);
+
+#endif
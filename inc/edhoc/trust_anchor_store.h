@@ -0,0 +1,91 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifndef TRUST_ANCHOR_STORE_H
+#define TRUST_ANCHOR_STORE_H
+
+#include <stdint.h>
+
+#include "edhoc.h"
+
+#include "common/byte_array.h"
+#include "common/crypto_wrapper.h"
+#include "common/oscore_edhoc_error.h"
+
+/*
+ * A store of the CAs contained in a cred_array. The CA certificates are
+ * parsed once when the store is built. For every CA the common name of the
+ * subject and the public key, prepared for verify_prepared(), are kept in an
+ * array sorted by the name. When a cred_array has a store, cert_x509_verify()
+ * and cert_c509_verify() find the CA of a certificate with a binary search
+ * and check the signature of the certificate with the prepared key.
+ *
+ * A CA without certificate (only ca_pk is given) or, when the library is
+ * built without MBEDTLS, any CA has an empty name. Such a CA is used for a
+ * certificate of any issuer if it is the only CA of the store, as without
+ * store. Without MBEDTLS the issuer of X.509 certificates is not extracted,
+ * so every CA of the store is tried.
+ *
+ * The store is not changed by lookups and can be used by several threads at
+ * the same time.
+ */
+
+struct trust_anchor {
+	/*common name of the subject of the CA certificate, points into the
+	certificate*/
+	const uint8_t *name;
+	uint32_t name_len;
+	struct prepared_pk pk;
+};
+
+struct trust_anchor_store {
+	struct trust_anchor *anchors;
+	uint32_t len;
+};
+
+/**
+ * @brief	Builds a store from the CAs (ca, ca_pk) of the credentials
+ *		in a cred_array and assigns it to creds->anchors. Credentials
+ *		without ca_pk are skipped.
+ *
+ * @param store	The store.
+ * @param creds	The credentials. The CA certificates must not be changed while
+ *		the store is used.
+ * @param anchors Memory for the CAs.
+ * @param anchors_len Number of elements in anchors.
+ * @return	ok, trust_anchor_store_too_small or an error of the parser or
+ *		the crypto library.
+ */
+enum err trust_anchor_store_build(struct trust_anchor_store *store,
+				  struct cred_array *creds,
+				  struct trust_anchor *anchors,
+				  uint32_t anchors_len);
+
+/**
+ * @brief	Releases the prepared keys of a store.
+ *
+ * @param store	The store.
+ */
+void trust_anchor_store_free(struct trust_anchor_store *store);
+
+/**
+ * @brief	Looks up the CA that issued a certificate.
+ *
+ * @param store	The store.
+ * @param[in] issuer The common name of the issuer or NULL if unknown.
+ * @param issuer_len The length of the name.
+ * @return	The CA or NULL.
+ */
+const struct trust_anchor *
+trust_anchor_find(const struct trust_anchor_store *store,
+		  const uint8_t *issuer, uint32_t issuer_len);
+
+#endif
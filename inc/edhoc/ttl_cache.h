@@ -0,0 +1,146 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifndef TTL_CACHE_H
+#define TTL_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Bounded cache with entries that expire after a TTL, the common part of
+ * the certificate cache (edhoc/cert_cache.h), the suite cache
+ * (edhoc/suite_cache.h) and the resumption store
+ * (edhoc/resumption_store.h). The entries are provided by the user of the
+ * cache, each one starts with a struct ttl_cache_slot. If the cache is full
+ * an expired entry or, if there is none, the entries in turn are replaced.
+ * Replaced, expired and removed entries are securely erased.
+ */
+
+struct ttl_cache_slot {
+	uint32_t expiry;
+	bool valid;
+};
+
+struct ttl_cache {
+	/*entries_len entries of entry_size bytes*/
+	void *entries;
+	uint32_t entry_size;
+	uint32_t entries_len;
+	/*time an entry is valid in the unit of now()*/
+	uint32_t ttl;
+	/*returns the current time. If NULL the entries do not expire*/
+	uint32_t (*now)(void);
+	/*optional, needed if the cache is used by more than one thread*/
+	void (*lock)(void *lock_ctx);
+	void (*unlock)(void *lock_ctx);
+	void *lock_ctx;
+	/*entry replaced next if the cache is full*/
+	uint32_t next;
+};
+
+/* Caches the library uses when they are registered */
+enum ttl_cache_user {
+	TTL_CACHE_CERT,
+	TTL_CACHE_SUITE,
+	TTL_CACHE_USERS,
+};
+
+/**
+ * @brief	Initializes a cache without entries in use. The fields now,
+ *		lock, unlock and lock_ctx can be set afterwards.
+ *
+ * @param cache	The cache.
+ * @param entries Memory for the entries.
+ * @param entry_size Size of an entry.
+ * @param entries_len Number of entries.
+ * @param ttl	Time an entry is valid.
+ */
+void ttl_cache_init(struct ttl_cache *cache, void *entries,
+		    uint32_t entry_size, uint32_t entries_len, uint32_t ttl);
+
+/**
+ * @brief	Makes a cache available to the library.
+ *
+ * @param user	The use of the cache.
+ * @param cache	The cache or NULL to stop caching.
+ */
+void ttl_cache_register(enum ttl_cache_user user, struct ttl_cache *cache);
+
+/**
+ * @brief	Returns the registered cache or NULL.
+ *
+ * @param user	The use of the cache.
+ */
+struct ttl_cache *ttl_cache_registered(enum ttl_cache_user user);
+
+/**
+ * @brief	Locks a cache with its lock function, if any.
+ */
+void ttl_cache_lock(struct ttl_cache *cache);
+
+/**
+ * @brief	Unlocks a cache with its unlock function, if any.
+ */
+void ttl_cache_unlock(struct ttl_cache *cache);
+
+/**
+ * @brief	Returns the current time, 0 if the entries do not expire.
+ */
+uint32_t ttl_cache_now(const struct ttl_cache *cache);
+
+/**
+ * @brief	Finds the valid entry matching a key. An expired entry is
+ *		erased. Must be called with the cache locked.
+ *
+ * @param cache	The cache.
+ * @param match	Checks if an entry matches the key.
+ * @param[in] key The key.
+ * @param now	The current time.
+ * @return	The entry or NULL.
+ */
+void *ttl_cache_find(struct ttl_cache *cache,
+		     bool (*match)(const void *entry, const void *key),
+		     const void *key, uint32_t now);
+
+/**
+ * @brief	Takes the entry for a key: the entry matching the key, a free
+ *		or expired entry or, if there is none, the next entry in
+ *		turn. The entry is erased and valid until now + TTL, the
+ *		caller fills in the rest. Must be called with the cache
+ *		locked.
+ *
+ * @param cache	The cache.
+ * @param match	Checks if an entry matches the key.
+ * @param[in] key The key.
+ * @param now	The current time.
+ * @return	The entry or NULL if the cache has no entries.
+ */
+void *ttl_cache_put(struct ttl_cache *cache,
+		    bool (*match)(const void *entry, const void *key),
+		    const void *key, uint32_t now);
+
+/**
+ * @brief	Removes an entry. Must be called with the cache locked.
+ *
+ * @param cache	The cache.
+ * @param entry	The entry.
+ */
+void ttl_cache_erase(const struct ttl_cache *cache, void *entry);
+
+/**
+ * @brief	Removes all entries.
+ *
+ * @param cache	The cache.
+ */
+void ttl_cache_clear(struct ttl_cache *cache);
+
+#endif
@@ -44,6 +44,31 @@ void runtime_context_init(struct runtime_context *c);
 enum err msg1_gen(const struct edhoc_initiator_context *c,
 		  struct runtime_context *rc);
 
+/**
+ * @brief 			Checks if a message received instead of 
+ * 				message 2 is an error message.
+ * 
+ * @param[in] msg 		The received message.
+ * @retval			True if msg is an error message.
+ */
+bool msg_is_error(const struct byte_array *msg);
+
+/**
+ * @brief 			Processes an error message received as answer 
+ * 				to message 1. If the responder rejected the 
+ * 				selected suite and supports another suite of 
+ * 				the initiator, that suite is selected for the 
+ * 				next message 1. It is stored in the suite 
+ * 				cache once message 2 is verified.
+ * 
+ * @param[in] c 		Initiator context.
+ * @param[in,out] rc 		Runtime context, rc->msg is the error message.
+ * @retval			Ok if message 1 can be sent again, otherwise
+ * 				error_message_received or another error code.
+ */
+enum err msg1_error_process(const struct edhoc_initiator_context *c,
+			    struct runtime_context *rc);
+
 /**
  * @brief Generates message 3. This function should by used by on the 
  *        initiator side.
@@ -74,6 +99,16 @@ enum err msg3_gen(const struct edhoc_initiator_context *c,
  */
 enum err msg4_process(struct runtime_context *rc);
 
+/**
+ * @brief 		Decodes only the connection identifier C_I of message 1, 
+ * 				without any cryptographic operation.
+ * 
+ * @param[in] 	msg1 message 1
+ * @param[out] 	c_i connection identifier C_I
+ * @return 		error code
+ */
+enum err msg1_c_i_get(const struct byte_array *msg1, struct byte_array *c_i);
+
 /**
  * @brief 		Generates message 2. This function should by used by on the 
  * 				responder side.
@@ -118,4 +153,143 @@ enum err msg3_process(struct edhoc_responder_context *c,
  */
 enum err msg4_gen(struct edhoc_responder_context *c,
 		  struct runtime_context *rc);
+
+/*
+ * Step-wise (non-blocking) API. Instead of running the whole handshake 
+ * inside edhoc_initiator_run() / edhoc_responder_run() and blocking in the 
+ * rx callback, the caller feeds every received message to a step function 
+ * and gets back the message to be sent. All the state of a handshake is kept 
+ * in a session object owned by the caller, so a single thread (e.g. an event 
+ * loop) can drive many handshakes at the same time.
+ */
+
+/* Result of a step */
+enum edhoc_step_status {
+	/* out contains a message that must be sent, then the next message of 
+	 * the other party is expected */
+	EDHOC_STEP_SEND,
+	/* no input was provided, the next message of the other party is 
+	 * expected */
+	EDHOC_STEP_NEED_MORE,
+	/* the handshake is completed. If out->len is not 0 out contains a 
+	 * last message that must be sent */
+	EDHOC_STEP_DONE,
+};
+
+enum edhoc_session_state {
+	EDHOC_SESSION_START,
+	EDHOC_SESSION_WAIT_MSG1,
+	EDHOC_SESSION_WAIT_MSG2,
+	EDHOC_SESSION_WAIT_MSG3,
+	EDHOC_SESSION_WAIT_MSG4,
+	EDHOC_SESSION_DONE,
+	EDHOC_SESSION_FAILED,
+};
+
+struct edhoc_initiator_session {
+	const struct edhoc_initiator_context *c;
+	struct cred_array *cred_r_array;
+	enum edhoc_session_state state;
+	struct runtime_context rc;
+	/*connection identifier of the responder, available after message 2*/
+	uint8_t c_r_buf[C_R_SIZE];
+	struct byte_array c_r;
+	/*the result of the handshake, available when done*/
+	uint8_t prk_out_buf[PRK_SIZE];
+	struct byte_array prk_out;
+};
+
+struct edhoc_responder_session {
+	struct edhoc_responder_context *c;
+	struct cred_array *cred_i_array;
+	enum edhoc_session_state state;
+	struct runtime_context rc;
+	/*connection identifier of the initiator, available after message 1*/
+	uint8_t c_i_buf[C_I_SIZE];
+	struct byte_array c_i;
+	/*the result of the handshake, available when done*/
+	uint8_t prk_out_buf[PRK_SIZE];
+	struct byte_array prk_out;
+	/*public key of the initiator, available when done*/
+	uint8_t initiator_pk_buf[PK_SIZE];
+	struct byte_array initiator_pk;
+};
+
+/**
+ * @brief Initializes an initiator session. The contexts must be valid for 
+ *        the lifetime of the session.
+ * 
+ * @param s the session
+ * @param c initiator context
+ * @param cred_r_array trust anchors for authenticating the responder
+ */
+void edhoc_initiator_session_init(struct edhoc_initiator_session *s,
+				  const struct edhoc_initiator_context *c,
+				  struct cred_array *cred_r_array);
+
+/**
+ * @brief Advances an initiator session by one step. The first step creates 
+ *        message 1 and needs no input. The following steps process message 2 
+ *        (creating message 3) and, with MESSAGE_4, message 4. The EAD of 
+ *        the processed message is available in s->rc.ead after the step. 
+ *        If the responder answers message 1 with an error message rejecting 
+ *        the selected suite, the step creates message 1 again with a suite 
+ *        the responder supports (at most once per handshake).
+ * 
+ * @param s the session
+ * @param in the received message or NULL if no message was received
+ * @param out points to the message to be sent. It is valid until the next 
+ *        step.
+ * @param status what the caller has to do next
+ * @return ok or error code. After an error the session is FAILED.
+ */
+enum err edhoc_initiator_session_step(struct edhoc_initiator_session *s,
+				      const struct byte_array *in,
+				      struct byte_array *out,
+				      enum edhoc_step_status *status);
+
+/**
+ * @brief Sets the identifier of the responder, e.g. its address, used as 
+ *        key of the suite cache (see edhoc/suite_cache.h). Must be called 
+ *        before the first step. The identifier must be valid for the 
+ *        lifetime of the session.
+ * 
+ * @param s the session
+ * @param peer_id identifier of the responder
+ */
+void edhoc_initiator_session_peer_set(struct edhoc_initiator_session *s,
+				      const struct byte_array *peer_id);
+
+/**
+ * @brief Initializes a responder session. The contexts must be valid for 
+ *        the lifetime of the session.
+ * 
+ * @param s the session
+ * @param c responder context
+ * @param cred_i_array trust anchors for authenticating the initiator
+ */
+void edhoc_responder_session_init(struct edhoc_responder_session *s,
+				  struct edhoc_responder_context *c,
+				  struct cred_array *cred_i_array);
+
+/**
+ * @brief Advances a responder session by one step. The first step processes 
+ *        message 1 and creates message 2, the second step processes 
+ *        message 3 and, with MESSAGE_4, creates message 4. The EAD of the 
+ *        processed message is available in s->rc.ead after the step. 
+ *        If the selected suite of message 1 is not supported the step 
+ *        returns error_message_sent, out then contains an error message 
+ *        with SUITES_R that must be sent.
+ * 
+ * @param s the session
+ * @param in the received message or NULL if no message was received
+ * @param out points to the message to be sent. It is valid until the next 
+ *        step.
+ * @param status what the caller has to do next
+ * @return ok or error code. After an error the session is FAILED.
+ */
+enum err edhoc_responder_session_step(struct edhoc_responder_session *s,
+				      const struct byte_array *in,
+				      struct byte_array *out,
+				      enum edhoc_step_status *status);
 #endif
@@ -16,12 +16,14 @@
 #include <stdint.h>
 
 #include "oscore/security_context.h"
+#include "oscore/group_context.h"
 #include "oscore/supported_algorithm.h"
 #include "oscore/nvm.h"
 
 #include "common/byte_array.h"
 #include "common/oscore_edhoc_error.h"
 #include "common/print_util.h"
+#include "common/workspace.h"
 
 /*
  * When OSCORE is used with fixed keys, i.e., no re-keying with EDHOC 
@@ -38,6 +40,16 @@
 #define F_NVM_MAX_WRITE_FAILURE 10
 #endif
 
+/* Number of contexts whose keys oscore_contexts_init() derives together */
+#ifndef OSCORE_CONTEXT_INIT_BATCH
+#define OSCORE_CONTEXT_INIT_BATCH 8
+#endif
+
+/* Number of messages coap2oscore_batch() encrypts together */
+#ifndef OSCORE_PROTECT_BATCH
+#define OSCORE_PROTECT_BATCH 8
+#endif
+
 #ifndef OSCORE_MAX_PLAINTEXT_LEN
 #define OSCORE_E_OPTIONS_LEN 40
 #define OSCORE_COAP_PAYLOAD_LEN 1024
@@ -48,6 +60,15 @@
 
 #define MAX_PLAINTEXT_LEN OSCORE_MAX_PLAINTEXT_LEN
 #define MAX_CIPHERTEXT_LEN (MAX_PLAINTEXT_LEN + AUTH_TAG_LEN)
+
+/* Size of the buffer in which coap2oscore_batch() stages the plaintexts 
+ * and tags of the messages it encrypts together. A group is encrypted 
+ * early when the next plaintext does not fit, so large messages are 
+ * encrypted in smaller groups. It must hold at least MAX_CIPHERTEXT_LEN 
+ * bytes. */
+#ifndef OSCORE_PROTECT_BATCH_BUF_LEN
+#define OSCORE_PROTECT_BATCH_BUF_LEN (2 * MAX_CIPHERTEXT_LEN)
+#endif
 #ifndef E_OPTIONS_BUFF_MAX_LEN
 #define E_OPTIONS_BUFF_MAX_LEN                                                 \
 	255 /* Maximal length of buffer with all encrypted CoAP options. */
@@ -61,6 +82,48 @@
 		 E_OPTIONS_BUFF_MAX_LEN :                                      \
 		 I_OPTIONS_BUFF_MAX_LEN)
 
+/*
+ * Worst case size of the workspace (see common/workspace.h) needed by 
+ * coap2oscore(), oscore2coap(), oscore_reprotect() and the Group OSCORE 
+ * functions. The largest case is coap2oscore_group() that holds the 
+ * plaintext, the ciphertext with the signature, the group AAD and the 
+ * countersign structure at the same time. Each buffer may be padded for 
+ * alignment.
+ */
+#define OSCORE_WORKSPACE_MAX_BUFFERS 16
+#define OSCORE_MESSAGE_WORKSPACE_SIZE                                          \
+	(MAX_PLAINTEXT_LEN + MAX_CIPHERTEXT_LEN +                              \
+	 2 * OSCORE_GROUP_SIGNATURE_LEN + OSCORE_GROUP_MAX_AAD_LEN +           \
+	 OSCORE_GROUP_COUNTERSIGN_STRUCTURE_LEN + MAX_COAP_OPTIONS_LEN +       \
+	 OSCORE_MAX_URI_PATH_LEN + MAX_INFO_LEN + MAX_PIV_LEN + NONCE_LEN +    \
+	 32 /*PRK of HKDF*/ +                                                  \
+	 OSCORE_WORKSPACE_MAX_BUFFERS * (WORKSPACE_ALIGN - 1))
+
+/* coap2oscore_batch() holds the staged plaintexts and the enc_structures 
+ * of a batch and the URI path of one message */
+#define OSCORE_BATCH_WORKSPACE_SIZE                                            \
+	(OSCORE_PROTECT_BATCH_BUF_LEN +                                        \
+	 OSCORE_PROTECT_BATCH * (MAX_AAD_LEN + 16 /*enc_structure*/) +         \
+	 OSCORE_MAX_URI_PATH_LEN + 3 * (WORKSPACE_ALIGN - 1))
+
+/* oscore_contexts_init() holds the HKDF infos of a batch and one PRK */
+#define OSCORE_CONTEXT_INIT_WORKSPACE_SIZE                                     \
+	(3 * OSCORE_CONTEXT_INIT_BATCH * MAX_INFO_LEN + 32 /*PRK of HKDF*/ +   \
+	 2 * (WORKSPACE_ALIGN - 1))
+
+/* Applications that call neither coap2oscore_batch() nor 
+ * oscore_contexts_init() can use OSCORE_MESSAGE_WORKSPACE_SIZE instead */
+#define OSCORE_WORKSPACE_SIZE                                                  \
+	((OSCORE_MESSAGE_WORKSPACE_SIZE > OSCORE_BATCH_WORKSPACE_SIZE) ?       \
+		 ((OSCORE_MESSAGE_WORKSPACE_SIZE >                             \
+		   OSCORE_CONTEXT_INIT_WORKSPACE_SIZE) ?                       \
+			  OSCORE_MESSAGE_WORKSPACE_SIZE :                      \
+			  OSCORE_CONTEXT_INIT_WORKSPACE_SIZE) :                \
+		 ((OSCORE_BATCH_WORKSPACE_SIZE >                               \
+		   OSCORE_CONTEXT_INIT_WORKSPACE_SIZE) ?                       \
+			  OSCORE_BATCH_WORKSPACE_SIZE :                        \
+			  OSCORE_CONTEXT_INIT_WORKSPACE_SIZE))
+
 /**
  * Each endpoint derives the parameters in the security context from a
  * small set of input parameters.
@@ -87,6 +150,35 @@ struct oscore_init_params {
 	const bool fresh_master_secret_salt;
 };
 
+/**
+ * Input parameters of a Group OSCORE group context. They are typically 
+ * provided by the Group Manager when joining the group.
+ */
+struct oscore_group_init_params {
+	/*master_secret must be provided. Currently 16 byte secrets are supported*/
+	const struct byte_array master_secret;
+	/*master_salt is optional (default empty byte string)*/
+	const struct byte_array master_salt;
+	/*the Group Identifier (Gid) must be provided. It is used as ID Context*/
+	struct byte_array gid;
+	/*sender_id must be provided*/
+	const struct byte_array sender_id;
+	/*aead_alg is optional (default AES-CCM-16-64-128). It is used as 
+	Group Encryption Algorithm as well as AEAD Algorithm (pairwise mode)*/
+	const enum AEAD_algorithm aead_alg;
+	/*kdf is optional (default HKDF-SHA-256)*/
+	const enum hkdf hkdf;
+	/*Signature Algorithm used in group mode, EdDSA or ES256*/
+	const enum sign_alg sign_alg;
+	/*Pairwise Key Agreement Algorithm used in pairwise mode*/
+	const enum ecdh_alg ecdh_alg;
+	/*own authentication credential (public key) and private key*/
+	const struct byte_array sender_auth_cred;
+	const struct byte_array sender_sk;
+	/*authentication credential of the Group Manager, optional*/
+	const struct byte_array gm_cred;
+};
+
 /**
  * @brief Initialize security context of OSCORE, including common context, 
  * recipient context and sender context.
@@ -98,6 +190,20 @@ struct oscore_init_params {
 enum err oscore_context_init(struct oscore_init_params *params,
 			     struct context *c);
 
+/**
+ * @brief Initializes several security contexts, e.g. of all peers of a 
+ * gateway at startup. The result is the one of oscore_context_init() for 
+ * each context, but the key derivations of up to OSCORE_CONTEXT_INIT_BATCH 
+ * contexts are computed together with hkdf_sha_256_multi().
+ * 
+ * @param 	params the initialization parameters, one per context
+ * @param	c the contexts
+ * @param	n number of contexts
+ * @return  err
+ */
+enum err oscore_contexts_init(struct oscore_init_params *params,
+			      struct context *c, uint32_t n);
+
 /**
  * @brief  	Checks if the packet in buf_in is a OSCORE packet.
  * 		If so it converts it to a CoAP packet and sets the oscore_pkg to
@@ -116,6 +222,28 @@ enum err oscore_context_init(struct oscore_init_params *params,
 enum err oscore2coap(uint8_t *buf_in, uint32_t buf_in_len, uint8_t *buf_out,
 		     uint32_t *buf_out_len, struct context *c);
 
+/**
+ * @brief	Cheap checks of an incoming packet before oscore2coap() is 
+ *		called. Only the header and the options are walked over, 
+ *		nothing is copied or decrypted. A server can use it to drop 
+ *		junk, replayed or foreign packets (e.g. during a flood) or to 
+ *		find the context a packet belongs to. A packet that passes can 
+ *		still be rejected by oscore2coap().
+ *
+ *		Requests: the PIV must be present, the KID must match the 
+ *		Recipient ID and the PIV must pass the replay window.
+ *		Responses: a request with the same token must have been sent 
+ *		and notifications must pass the replay check of their 
+ *		observation.
+ * 
+ * @param 	buf_in a buffer containing an incoming packet
+ * @param 	buf_in_len length of the data in the buf_in
+ * @param 	c pointer to a security context
+ * @return	ok if the packet should be passed to oscore2coap()
+ */
+enum err oscore_prefilter(uint8_t *buf_in, uint32_t buf_in_len,
+			  struct context *c);
+
 /**
  *@brief 	Converts a CoAP packet to OSCORE packet
  *
@@ -130,4 +258,172 @@ enum err coap2oscore(uint8_t *buf_o_coap, uint32_t buf_o_coap_len,
 		     uint8_t *buf_oscore, uint32_t *buf_oscore_len,
 		     struct context *c);
 
+/* A message of coap2oscore_batch(), the parameters of coap2oscore() */
+struct coap2oscore_job {
+	uint8_t *buf_o_coap;
+	uint32_t buf_o_coap_len;
+	uint8_t *buf_oscore;
+	uint32_t *buf_oscore_len;
+	struct context *c;
+	/*set to the result of coap2oscore()*/
+	enum err result;
+};
+
+/**
+ *@brief 	Converts several CoAP packets to OSCORE packets, e.g. the 
+ *		messages a gateway sends to many peers in one poll cycle. The 
+ *		result of each message is the one of coap2oscore(), but up to 
+ *		OSCORE_PROTECT_BATCH messages to different contexts are 
+ *		encrypted together with aead_multi(), as many as fit into 
+ *		OSCORE_PROTECT_BATCH_BUF_LEN. Messages with the same 
+ *		context are protected in the order of jobs. A failed message 
+ *		does not stop the others, its output is wiped.
+ *
+ *@param	jobs the messages, each one gets its result
+ *@param	n number of messages
+ *@return	ok if all messages were protected, otherwise the result of 
+ *		the first failed one
+ */
+enum err coap2oscore_batch(struct coap2oscore_job *jobs, uint32_t n);
+
+/**
+ *@brief 	Re-protects an OSCORE packet received on one leg for forwarding 
+ *		on another leg, e.g., in an OSCORE-to-OSCORE proxy. The packet 
+ *		is verified and decrypted with c_in and the same plaintext is 
+ *		encrypted with c_out. The outer (Class U) options are carried 
+ *		over without being re-encoded and the inner plaintext is not 
+ *		rebuilt. If the inner options need to be changed use 
+ *		oscore2coap() and coap2oscore() instead.
+ *@note		Requests are re-protected with (client leg, server leg), the 
+ *		corresponding responses with (server leg, client leg).
+ *
+ *@param	buf_in a buffer containing the received OSCORE packet
+ *@param	buf_in_len length of the data in buf_in
+ *@param	buf_out a buffer where the re-protected OSCORE packet will be 
+ *		written. Must not overlap with buf_in.
+ *@param	buf_out_len in: size of buf_out, out: length of the packet
+ *@param	c_in the context of the leg the packet was received on
+ *@param	c_out the context of the leg the packet will be forwarded on
+ *@return	err
+ */
+enum err oscore_reprotect(uint8_t *buf_in, uint32_t buf_in_len,
+			  uint8_t *buf_out, uint32_t *buf_out_len,
+			  struct context *c_in, struct context *c_out);
+
+/**
+ *@brief 	Builds an EDHOC + OSCORE request, see RFC 9668. The EDHOC 
+ *		option is added to an OSCORE request and message_3 is put in 
+ *		front of its payload, so that message_3 and the first protected 
+ *		request are sent in one message.
+ *
+ *@param	buf_oscore a buffer containing the OSCORE request, protected 
+ *		with the context derived from the handshake
+ *@param	buf_oscore_len length of the OSCORE request
+ *@param	msg3 EDHOC message_3
+ *@param	buf_out a buffer where the combined request will be written. 
+ *		Must not overlap with buf_oscore.
+ *@param	buf_out_len in: size of buf_out, out: length of the request
+ *@return	err
+ */
+enum err oscore_edhoc_request_combine(uint8_t *buf_oscore,
+				      uint32_t buf_oscore_len,
+				      const struct byte_array *msg3,
+				      uint8_t *buf_out, uint32_t *buf_out_len);
+
+/**
+ *@brief 	Splits an EDHOC + OSCORE request, see RFC 9668, into message_3 
+ *		and the OSCORE request without EDHOC option, which can be 
+ *		passed to oscore2coap() once the context is derived.
+ *
+ *@param	buf_in a buffer containing the received request
+ *@param	buf_in_len length of the data in buf_in
+ *@param	msg3 out: EDHOC message_3, points into buf_in
+ *@param	c_r out: the KID of the request, i.e. C_R of the handshake, 
+ *		points into buf_in
+ *@param	buf_oscore a buffer where the OSCORE request will be written. 
+ *		Must not overlap with buf_in.
+ *@param	buf_oscore_len in: size of buf_oscore, out: length of the 
+ *		request
+ *@return	ok, oscore_no_edhoc_option if the request is not combined or 
+ *		err
+ */
+enum err oscore_edhoc_request_split(uint8_t *buf_in, uint32_t buf_in_len,
+				    struct byte_array *msg3,
+				    struct byte_array *c_r, uint8_t *buf_oscore,
+				    uint32_t *buf_oscore_len);
+
+/**
+ * @brief Initialize a Group OSCORE group context, including the common 
+ * context and the sender context. Recipient contexts are added with 
+ * oscore_group_member_add().
+ * @note The Group Manager renews the keying material when members join or 
+ * leave the group, so the sender sequence number starts at 0 and is not 
+ * stored in NVM.
+ * 
+ * @param 	params a struct containing the initialization parameters
+ * @param	c the group context
+ * @return  err
+ */
+enum err oscore_group_context_init(struct oscore_group_init_params *params,
+				   struct group_context *c);
+
+/**
+ * @brief Adds (or updates) the recipient context of a group member. If the 
+ * algorithms of the group allow it the pairwise keys are derived as well.
+ * 
+ * @param	c the group context
+ * @param	recipient_id the Sender ID of the member
+ * @param	auth_cred the authentication credential (public key) of the member
+ * @return  err
+ */
+enum err oscore_group_member_add(struct group_context *c,
+				 const struct byte_array *recipient_id,
+				 const struct byte_array *auth_cred);
+
+/**
+ * @brief Removes the recipient context of a group member and erases its keys.
+ * 
+ * @param	c the group context
+ * @param	recipient_id the Sender ID of the member
+ * @return  err
+ */
+enum err oscore_group_member_remove(struct group_context *c,
+				    const struct byte_array *recipient_id);
+
+/**
+ *@brief 	Converts a CoAP packet to a Group OSCORE packet. In group mode 
+ *		the result can be sent to all members at once (e.g. over 
+ *		multicast).
+ *
+ *@param	buf_o_coap a buffer containing a CoAP packet
+ *@param	buf_o_coap_len length of the CoAP buffer
+ *@param	buf_oscore a buffer where the OSCORE packet will be written
+ *@param	buf_oscore_len length of the OSCORE packet
+ *@param	c the group context
+ *@param	mode OSCORE_GROUP_MODE or OSCORE_PAIRWISE_MODE
+ *@param	recipient_id in pairwise mode requests the Sender ID of the 
+ *		addressed member, otherwise NULL
+ *@return	err
+ */
+enum err coap2oscore_group(uint8_t *buf_o_coap, uint32_t buf_o_coap_len,
+			   uint8_t *buf_oscore, uint32_t *buf_oscore_len,
+			   struct group_context *c, enum oscore_group_mode mode,
+			   const struct byte_array *recipient_id);
+
+/**
+ * @brief  	Verifies and decrypts a Group OSCORE packet, protected either 
+ * 		in group mode or in pairwise mode, and converts it to a CoAP 
+ * 		packet.
+ * 
+ * @param 	buf_in a buffer containing the Group OSCORE packet
+ * @param 	buf_in_len length of the data in the buf_in
+ * @param 	buf_out the resulting CoAP packet
+ * @param 	buf_out_len length of the CoAP packet
+ * @param 	c the group context
+ * @return	err
+ */
+enum err oscore2coap_group(uint8_t *buf_in, uint32_t buf_in_len,
+			   uint8_t *buf_out, uint32_t *buf_out_len,
+			   struct group_context *c);
+
 #endif
@@ -14,6 +14,7 @@
 
 #include "option.h"
 #include "supported_algorithm.h"
+#include "group_context.h"
 
 #include "common/byte_array.h"
 #include "common/oscore_edhoc_error.h"
@@ -35,4 +36,20 @@ enum err create_aad(struct o_coap_option *options, uint16_t opt_num,
 		    struct byte_array *request_kid,
 		    struct byte_array *request_piv, struct byte_array *out);
 
+/**
+ * @brief   Serialize given parameters into the external_aad structure of 
+ *          Group OSCORE.
+ * @param   c the group context
+ * @param   request_kid in the request
+ * @param   request_piv in the request
+ * @param   sender_cred the authentication credential of the sender of 
+ *          the message
+ * @param   out out-array
+ * @return err
+ */
+enum err create_group_aad(struct group_context *c,
+			  struct byte_array *request_kid,
+			  struct byte_array *request_piv,
+			  struct byte_array *sender_cred, struct byte_array *out);
+
 #endif
@@ -0,0 +1,133 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifndef GROUP_CONTEXT_H
+#define GROUP_CONTEXT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "oscore/security_context.h"
+#include "oscore/supported_algorithm.h"
+
+#include "edhoc/suites.h"
+
+#include "common/byte_array.h"
+#include "common/oscore_edhoc_error.h"
+
+/* Maximal number of other group members a group context can hold a
+ * recipient context for. It can be defined by the user here or outside of
+ * this file, e.g. to some hundreds for a large group. The members are
+ * looked up by binary search, so the size affects only the memory. */
+#ifndef OSCORE_GROUP_MAX_MEMBERS
+#define OSCORE_GROUP_MAX_MEMBERS 8
+#endif
+
+#if OSCORE_GROUP_MAX_MEMBERS > 65536
+#error "OSCORE_GROUP_MAX_MEMBERS must not be larger than 65536"
+#endif
+
+/* Maximal length of an authentication credential. Currently the
+ * authentication credentials are the raw public keys of the members, in the
+ * format expected by the crypto_wrapper. */
+#ifndef OSCORE_GROUP_AUTH_CRED_MAX_LEN
+#define OSCORE_GROUP_AUTH_CRED_MAX_LEN 65
+#endif
+
+#define OSCORE_GROUP_SK_MAX_LEN 32
+#define OSCORE_GROUP_SIGNATURE_LEN 64
+#define OSCORE_GROUP_SHARED_SECRET_LEN 32
+
+/* Group flag in the first byte of the OSCORE option. If set the message is
+ * protected in group mode, otherwise in pairwise mode. */
+#define COMP_OSCORE_OPT_GROUP_FLAG_MASK 0x20
+
+/* external_aad of Group OSCORE: the one of OSCORE plus the ID Context, two
+ * more algorithms and two authentication credentials */
+#define OSCORE_GROUP_MAX_AAD_LEN                                               \
+	(MAX_AAD_LEN + MAX_KID_CONTEXT_LEN + 12 +                              \
+	 2 * (OSCORE_GROUP_AUTH_CRED_MAX_LEN + 2))
+
+/* Countersign_structure = ["CounterSignature0", h'', external_aad, ciphertext] */
+#define OSCORE_GROUP_COUNTERSIGN_STRUCTURE_LEN                                 \
+	(30 + OSCORE_GROUP_MAX_AAD_LEN + MAX_CIPHERTEXT_LEN)
+
+/**
+ * @brief The two modes in which a message can be protected in a group.
+ */
+enum oscore_group_mode {
+	/* protected with the group keys and countersigned, used for
+	 * one-to-many (multicast) messages */
+	OSCORE_GROUP_MODE,
+	/* protected with keys derived from the static-static Diffie-Hellman
+	 * secret of two members, used for one-to-one messages */
+	OSCORE_PAIRWISE_MODE,
+};
+
+/* Recipient Context of one other member of the group */
+struct group_recipient_context {
+	struct recipient_context rc;
+	struct byte_array auth_cred;
+	uint8_t auth_cred_buf[OSCORE_GROUP_AUTH_CRED_MAX_LEN];
+	struct byte_array pairwise_sender_key;
+	uint8_t pairwise_sender_key_buf[SENDER_KEY_LEN_];
+	struct byte_array pairwise_recipient_key;
+	uint8_t pairwise_recipient_key_buf[RECIPIENT_KEY_LEN_];
+	bool is_occupied;
+};
+
+/* Group context: one Sender Context and a table with the Recipient Contexts
+ * of the other group members. The ID Context of the common context is the
+ * Group Identifier (Gid). */
+struct group_context {
+	struct req_resp_context rrc;
+	struct common_context cc;
+	struct sender_context sc;
+	enum sign_alg sign_alg;
+	enum ecdh_alg ecdh_alg;
+	struct byte_array sender_auth_cred;
+	struct byte_array sender_sk;
+	struct byte_array gm_cred; /*optional*/
+	struct byte_array signature_encryption_key;
+	uint8_t signature_encryption_key_buf[SENDER_KEY_LEN_];
+	struct group_recipient_context members[OSCORE_GROUP_MAX_MEMBERS];
+	/*indexes of the occupied members sorted by Recipient ID*/
+	uint16_t member_order[OSCORE_GROUP_MAX_MEMBERS];
+	uint32_t member_cnt;
+	/*indexes of the free members*/
+	uint16_t free_members[OSCORE_GROUP_MAX_MEMBERS];
+	uint32_t free_cnt;
+};
+
+/**
+ * @brief Searches the group context for the Recipient Context of a member.
+ *
+ * @param c the group context
+ * @param recipient_id the Sender ID of the member, i.e., the KID of its
+ *        messages
+ * @param member out: pointer to the Recipient Context of the member
+ * @return ok or oscore_group_member_not_found
+ */
+enum err group_member_get(struct group_context *c,
+			  const struct byte_array *recipient_id,
+			  struct group_recipient_context **member);
+
+/**
+ * @brief Checks if the pairwise mode can be used with the algorithms of
+ *        the group, i.e., if the signature key pair of the members can be
+ *        used with the ECDH algorithm.
+ *
+ * @param c the group context
+ * @retval true if the pairwise mode is supported
+ */
+bool group_pairwise_mode_supported(struct group_context *c);
+
+#endif
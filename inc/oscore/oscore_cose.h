@@ -43,4 +43,27 @@ enum err oscore_cose_encrypt(struct byte_array *in_plaintext,
 			     struct byte_array *nonce,
 			     struct byte_array *sender_aad,
 			     struct byte_array *key);
+
+/* One encryption of oscore_cose_encrypt_multi(), the parameters of
+ * oscore_cose_encrypt() */
+struct oscore_cose_encrypt_job {
+	struct byte_array *in_plaintext;
+	struct byte_array *out_ciphertext;
+	struct byte_array *nonce;
+	struct byte_array *sender_aad;
+	struct byte_array *key;
+	/*set to the result of oscore_cose_encrypt()*/
+	enum err result;
+};
+
+/**
+ * @brief Encrypts several plaintexts of OSCORE (not Group OSCORE) messages 
+ * with aead_multi(). A failed encryption does not stop the others.
+ * @param jobs the encryptions, each one gets its result
+ * @param n number of encryptions
+ * @return ok if all encryptions succeeded, otherwise the result of the 
+ * first failed one
+ */
+enum err oscore_cose_encrypt_multi(struct oscore_cose_encrypt_job *jobs,
+				   uint32_t n);
 #endif
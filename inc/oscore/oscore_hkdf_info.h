@@ -12,6 +12,8 @@
 #ifndef HKDF_INFO_H
 #define HKDF_INFO_H
 
+#include <stdbool.h>
+
 #include "security_context.h"
 #include "supported_algorithm.h"
 
@@ -34,4 +36,20 @@ enum err oscore_create_hkdf_info(struct byte_array *id,
 				 enum AEAD_algorithm aead_alg,
 				 enum derive_type type, struct byte_array *out);
 
+/**
+ * @brief   Encodes the HKDF Info of the keystream that encrypts the 
+ *          countersignature of a Group OSCORE message, see 
+ *          draft-ietf-core-oscore-groupcomm section 4.1
+ * @param   id the Sender ID of the sender of the message
+ * @param   id_context the ID Context (Gid) of the group
+ * @param   request true if the message is a request
+ * @param   len L, the length of the keystream
+ * @param   out out-array. Its length is the size of the buffer.
+ * @return  err
+ */
+enum err oscore_create_keystream_info(const struct byte_array *id,
+				      const struct byte_array *id_context,
+				      bool request, uint32_t len,
+				      struct byte_array *out);
+
 #endif
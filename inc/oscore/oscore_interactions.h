@@ -14,11 +14,13 @@
 
 #include <stdint.h>
 #include "oscore/oscore_coap_defines.h"
+#include "oscore/supported_algorithm.h"
 #include "common/byte_array.h"
 #include "common/oscore_edhoc_error.h"
 
 /**
  * @brief Number of interactions supported at the same time, per one OSCORE context.
+ *        Every active observation occupies one interaction.
  */
 #ifndef OSCORE_INTERACTIONS_COUNT
 #define OSCORE_INTERACTIONS_COUNT 3
@@ -47,6 +49,20 @@ struct oscore_interaction_t {
 	uint8_t request_kid[MAX_KID_LEN];
 	uint8_t request_kid_len;
 
+	/* Highest PIV of the notifications received for this observation (client only).
+	   Every observation has its own counter, since notifications of different observations may be reordered. */
+	uint64_t notification_num;
+	bool notification_num_initialized;
+
+	/* True if a notification without PIV, protected with the request nonce, was received (client only). */
+	bool piv_less_notification_received;
+
+#ifdef OSCORE_OBSERVE_AAD_CACHE
+	/* External AAD shared by all responses to the request, cached when the first notification is processed. */
+	uint8_t aad[MAX_AAD_LEN];
+	uint8_t aad_len;
+#endif
+
 	/* True if given record is occupied (used in interactions array). */
 	bool is_occupied;
 };
@@ -96,6 +112,21 @@ enum err
 oscore_interactions_remove_record(struct oscore_interaction_t *interactions,
 				  uint8_t *token, uint8_t token_len);
 
+/**
+ * @brief Get the external AAD of the responses to the request stored in given record.
+ *        With OSCORE_OBSERVE_AAD_CACHE it is computed with the first call and cached in the record, so that
+ *        protecting and verifying further notifications of the same observation does not need to encode it again.
+ *        Without it, it is encoded into the buffer of aad with every call.
+ * @param record Interaction record, e.g. returned by oscore_interactions_get_record.
+ * @param aead_alg AEAD algorithm of the security context.
+ * @param aad [in/out] Buffer for the AAD. With OSCORE_OBSERVE_AAD_CACHE it points to the AAD cached in the record
+ *            on return.
+ * @return enum err ok, or error if failed.
+ */
+enum err oscore_interactions_get_aad(struct oscore_interaction_t *record,
+				     enum AEAD_algorithm aead_alg,
+				     struct byte_array *aad);
+
 /**
  * @brief Wrapper for handling OSCORE interactions to be executed before main encryption/decryption logic.
  * 
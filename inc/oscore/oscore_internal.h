@@ -0,0 +1,159 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+/*
+ * The functions in this file are the packet level stages shared by 
+ * oscore2coap(), coap2oscore(), oscore_reprotect() and the Group OSCORE 
+ * functions. They operate on already deserialized packets, so that callers 
+ * processing the same message more than once (e.g. a forwarding proxy) parse 
+ * and serialize it only once.
+ */
+
+#ifndef OSCORE_INTERNAL_H
+#define OSCORE_INTERNAL_H
+
+#include <stdint.h>
+
+#include "oscore/oscore_coap.h"
+#include "oscore/security_context.h"
+
+#include "common/byte_array.h"
+#include "common/oscore_edhoc_error.h"
+
+/**
+ * @brief 	Parse all received options to find the OSCORE option and parse 
+ * 		its compressed value into PIV, KID and KID context.
+ * @param opt: input array of options
+ * @param opt_cnt: number of elements in the array
+ * @param out: pointer output compressed OSCORE_option
+ * @return ok or not_oscore_pkt if no OSCORE option is present
+ */
+enum err oscore_option_parser(const struct o_coap_option *opt, uint8_t opt_cnt,
+			      struct compressed_oscore_option *out);
+
+/**
+ * @brief Extract input CoAP options into E(encrypted) and U(unprotected)
+ * @param in_o_coap: input CoAP packet
+ * @param e_options: output pointer to E-options
+ * @param e_options_cnt: count number of output E-options
+ * @param e_options_len: Byte string length of all E-options, which will be used when forming E-options into plaintext
+ * @param U_options: output pointer to U-options
+ * @param U_options_cnt: count number of output U-options
+ * @return err
+ */
+enum err inner_outer_option_split(struct o_coap_packet *in_o_coap,
+				  struct o_coap_option *e_options,
+				  uint8_t *e_options_cnt,
+				  uint16_t *e_options_len,
+				  struct o_coap_option *U_options,
+				  uint8_t *U_options_cnt);
+
+/**
+ * @brief Build up plaintext which should be encrypted and protected
+ * @param in_o_coap: input CoAP packet that will be analyzed
+ * @param E_options: E-options, which should be protected
+ * @param E_options_cnt: count number of E-options
+ * @param plaintext: output plaintext, which will be encrypted
+ * @return err
+ */
+enum err plaintext_setup(struct o_coap_packet *in_o_coap,
+			 struct o_coap_option *E_options, uint8_t E_options_cnt,
+			 struct byte_array *plaintext);
+
+/**
+ * @brief   Generate an OSCORE option.
+ * @param   piv set to the trimmed sender sequence number in requests or NULL
+ *          in responses
+ * @param   kid set to Sender ID in requests or NULL in responses
+ * @param   kid_context set to ID context in request when present. If not
+ *          present or a response set to NULL
+ * @param   oscore_option: output pointer OSCORE option structure
+ * @return  err
+ */
+enum err oscore_option_generate(struct byte_array *piv, struct byte_array *kid,
+				struct byte_array *kid_context,
+				struct oscore_option *oscore_option);
+
+/**
+ * @brief Generate an OSCORE packet with all needed data
+ * @param in_o_coap: input CoAP packet
+ * @param out_oscore: output pointer to OSCORE packet
+ * @param u_options: pointer to array of all unprotected options
+ * @param u_options_cnt: count number of U-options
+ * @param in_ciphertext: input ciphertext, will be set into payload in OSCORE packet
+ * @param oscore_option: The OSCORE option
+ * @return err
+ */
+enum err oscore_pkg_generate(struct o_coap_packet *in_o_coap,
+			     struct o_coap_packet *out_oscore,
+			     struct o_coap_option *u_options,
+			     uint8_t u_options_cnt,
+			     struct byte_array *in_ciphertext,
+			     struct oscore_option *oscore_option);
+
+/**
+ * @brief Generate CoAP packet from OSCORE packet
+ * @param decrypted_payload: decrypted OSCORE payload, which contains code, E-options and original unprotected CoAP payload
+ * @param oscore_pkt:  input OSCORE packet
+ * @param out: pointer to output CoAP packet
+ * @return err
+ */
+enum err o_coap_pkg_generate(struct byte_array *decrypted_payload,
+			     struct o_coap_packet *oscore_pkt,
+			     struct o_coap_packet *out);
+
+/**
+ * @brief Verifies and decrypts a deserialized OSCORE packet, including 
+ *        the replay, ECHO and notification checks of the recipient.
+ * 
+ * @param oscore_packet the deserialized OSCORE packet
+ * @param oscore_option the parsed OSCORE option of oscore_packet
+ * @param plaintext buffer for the decrypted payload. Its length must be 
+ *        the ciphertext length minus AUTH_TAG_LEN.
+ * @param output_coap the resulting CoAP packet. Its options and payload 
+ *        point into plaintext and oscore_packet.
+ * @param c the security context
+ * @return err
+ */
+enum err oscore_packet_unprotect(struct o_coap_packet *oscore_packet,
+				 struct compressed_oscore_option *oscore_option,
+				 struct byte_array *plaintext,
+				 struct o_coap_packet *output_coap,
+				 struct context *c);
+
+/**
+ * @brief Encrypts an already set up plaintext and builds the OSCORE packet.
+ * 
+ * @param o_coap_pkt the (unprotected) CoAP packet the plaintext belongs to
+ * @param e_options the inner options, used for caching the ECHO value
+ * @param e_options_cnt number of entries in e_options
+ * @param u_options the outer options, without the OSCORE option
+ * @param u_options_cnt number of entries in u_options
+ * @param plaintext code + inner options + payload, see RFC8613 5.3
+ * @param ciphertext buffer for the ciphertext, plaintext length plus 
+ *        AUTH_TAG_LEN
+ * @param oscore_option storage for the generated OSCORE option
+ * @param oscore_pkt the resulting OSCORE packet
+ * @param c the security context
+ * @return err
+ */
+enum err oscore_packet_protect(struct o_coap_packet *o_coap_pkt,
+			       struct o_coap_option *e_options,
+			       uint8_t e_options_cnt,
+			       struct o_coap_option *u_options,
+			       uint8_t u_options_cnt,
+			       struct byte_array *plaintext,
+			       struct byte_array *ciphertext,
+			       struct oscore_option *oscore_option,
+			       struct o_coap_packet *oscore_pkt,
+			       struct context *c);
+
+#endif
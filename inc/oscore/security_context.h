@@ -31,6 +31,7 @@
 enum derive_type {
 	KEY,
 	IV,
+	SIGNATURE_ENCRYPTION_KEY, /* Group OSCORE only */
 };
 
 /**
@@ -73,8 +74,7 @@ struct recipient_context {
 	uint8_t recipient_key_buf[RECIPIENT_KEY_LEN_];
 	uint8_t recipient_id_buf[RECIPIENT_ID_BUFF_LEN];
 	struct server_replay_window_t replay_window;
-	uint64_t notification_num;
-	bool notification_num_initialized; /* this is only used to skip the first notification check after the reboot */
+	/* the notification numbers are kept per observation, see struct oscore_interaction_t */
 };
 
 /*request-response context contains parameters that need to persists between
@@ -99,6 +99,18 @@ struct context {
 	struct recipient_context rc;
 };
 
+/**
+ * @brief       Common derive procedure used to derive the Common IV and 
+ *              Sender / Recipient Keys
+ * @param cc    pointer to the common context
+ * @param id    empty array for Common IV, sender / recipient ID for keys
+ * @param type  the type of the derived parameter, see enum derive_type
+ * @param out   out-array. Must be initialized
+ * @return      err
+ */
+enum err derive(struct common_context *cc, struct byte_array *id,
+		enum derive_type type, struct byte_array *out);
+
 /**
  * @brief   Converts the sender sequence number (uint64_t) to 
  *          piv (byte string of maximum 5 byte) 
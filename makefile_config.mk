@@ -55,6 +55,12 @@ OSCORE_NVM_SUPPORT += -DOSCORE_NVM_SUPPORT
 # Please note that: we do not support this feature under Windows with MSVC (lack of support for VLA).
 #FEATURES += -DVLA
 
+# Take all temporary buffers from a scratch region (workspace) provided by the
+# application instead of from the stack, see inc/common/workspace.h. Buffers 
+# of functions that are not active at the same time share the same memory. 
+# Cannot be combined with VLA. Requires GCC or Clang.
+#FEATURES += -DWORKSPACE
+
 ################################################################################
 # RAM optimization EDHOC
 ################################################################################
@@ -86,6 +92,27 @@ FEATURES += -DCRED_I_SIZE=293
 # Number of supported suites by the initiator
 FEATURES += -DSUITES_I_SIZE=1 
 
+# Number of handshakes a responder session table handles at the same time 
+# (see edhoc/responder_session_table.h). With more than 256 the C_R values 
+# are 2 bytes long and C_R_SIZE must be at least 2.
+#FEATURES += -DEDHOC_SESSION_TABLE_SIZE=4
+
+# Maximal length of the source (e.g. address and port) of a message_1 in the 
+# admission control of a responder (see edhoc/admission.h). The cookie of its 
+# return routability challenge is echoed in an EAD item, so EAD_SIZE must be 
+# at least 18 to use it.
+#FEATURES += -DEDHOC_ADMISSION_SOURCE_MAX_SIZE=18
+
+# ERR_CODE of the return routability challenge and EAD label of its answer, 
+# to be agreed with the initiators (see edhoc/admission.h).
+#FEATURES += -DEDHOC_ADMISSION_ERR_CODE=-65536
+#FEATURES += -DEDHOC_ADMISSION_EAD_LABEL=65536
+
+# Take the ephemeral DH keys from a pool filled in advance, e.g. by a low 
+# priority thread, instead of from the initiator/responder context (see 
+# edhoc/ephemeral_key_pool.h). Increases the size of the runtime context.
+#FEATURES += -DEPHEMERAL_KEY_POOL
+
 ################################################################################
 # RAM optimization OSCORE
 ################################################################################
@@ -98,6 +125,11 @@ FEATURES += -DE_OPTIONS_BUFF_MAX_LEN=100
 # Max size of the I options buffer
 FEATURES += -DI_OPTIONS_BUFF_MAX_LEN=100
 
+# Cache the external AAD of an observation in its interaction record, so
+# that it is encoded only once for all its notifications. Adds MAX_AAD_LEN
+# bytes to each of the OSCORE_INTERACTIONS_COUNT records.
+#FEATURES += -DOSCORE_OBSERVE_AAD_CACHE
+
 
 ################################################################################
 # Crypto engine
@@ -155,8 +187,37 @@ FEATURES += -DI_OPTIONS_BUFF_MAX_LEN=100
 # | EDHOC  | 0/1     | 3       | MBEDTLS or (COMPACT25519 with TINYCRYPT)
 # | EDHOC  | 2/3     | 0/1/2/3 | MBEDTLS
 # | EDHOC  | 0/1/2/3 | 0/1/2/3 | MBEDTLS and COMPACT25519
+#
+# CURVE25519_64 can be used instead of COMPACT25519 on 64-bit hosts (e.g.
+# Linux servers). It is an in-tree X25519/Ed25519 implementation with 64-bit
+# limbs (requires unsigned __int128) and precomputed base point tables, it
+# is faster than COMPACT25519 but larger. If both are defined CURVE25519_64
+# is used. The X25519 key generation of both hashes the seed with the SHA-256
+# of TINYCRYPT, MBEDTLS or SHA256_HW, the build fails without one of them.
+#
+# AES_CCM_HW adds an in-tree AES-CCM using the AES instructions of x86
+# (AES-NI) and AArch64 (ARMv8 Crypto Extensions). aead() uses it for AES-128
+# keys if the CPU supports the instructions (detected at runtime) and the
+# engine above otherwise. aead_multi() and coap2oscore_batch() interleave the
+# AES rounds of up to eight independent messages.
+#
+# SHA256_HW adds an in-tree SHA-256 using the SHA instructions of x86 (SHA-NI)
+# and AArch64 (ARMv8 SHA2). hash(), hkdf_extract() and hkdf_expand() use it
+# if the CPU supports the instructions (detected at runtime).
+# hkdf_sha_256_multi() and oscore_contexts_init() derive several keys at
+# once; on x86 CPUs with AVX2 but without SHA-NI they hash eight messages in
+# parallel.
+#
+# EDHOC-KDF is computed with hmac_init(), hmac_update() and hmac_final(), the
+# HMAC key setup is done once per PRK. EDHOC_KDF_HKDF_EXPAND computes it with
+# hkdf_expand() instead, e.g. to use the HKDF of the PSA backend or an
+# application defined hkdf_expand().
 
 
 #CRYPTO_ENGINE += -DTINYCRYPT
 CRYPTO_ENGINE += -DCOMPACT25519
+#CRYPTO_ENGINE += -DCURVE25519_64
+#CRYPTO_ENGINE += -DAES_CCM_HW
+#CRYPTO_ENGINE += -DSHA256_HW
+#CRYPTO_ENGINE += -DEDHOC_KDF_HKDF_EXPAND
 CRYPTO_ENGINE += -DMBEDTLS
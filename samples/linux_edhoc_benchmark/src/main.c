@@ -0,0 +1,789 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "edhoc.h"
+#include "edhoc_internal.h"
+#include "common/workspace.h"
+#include "common/crypto_provider.h"
+#include "edhoc_test_vectors_p256_v16.h"
+#include "edhoc_test_vectors_rfc9529.h"
+
+/*
+ * Runs complete EDHOC handshakes between an initiator and a responder in the
+ * same process. The messages are passed directly between the step-wise
+ * sessions (see edhoc_internal.h), so no sockets and no threads are involved
+ * in the timed runs. For every scenario the handshakes per second, the mean
+ * and minimal latency of every step, the peak stack usage of both parties
+ * and the RAM of the sessions are reported as JSON.
+ *
+ * The crypto engine is selected at compile time (CRYPTO_ENGINE in
+ * makefile_config.mk), run the benchmark once per engine to compare them.
+ *
+ * In addition, AES-CCM-16-64-128 as used by OSCORE is measured for several
+ * payload sizes with every available AEAD provider (the built-in engine and,
+ * with AES_CCM_HW, the AES instructions of the CPU), once with a raw key as
+ * aead() uses it and once with a key prepared by crypto_key_import().
+ */
+
+#define DEFAULT_ITERATIONS 100
+
+/*size of the stacks on which the peak stack usage is measured*/
+#define STACK_SIZE (512 * 1024)
+#define STACK_PAINT 0xA5
+
+/*OSCORE payload sizes of the AEAD runs*/
+static const uint32_t aead_sizes[] = { 16, 64, 256, 1024 };
+#define AEAD_MAX_SIZE 1024
+#define AEAD_TAG_SIZE 8
+
+enum vector_set {
+	RFC9529,
+	V16,
+};
+
+struct scenario {
+	uint8_t suite;
+	enum method_type method;
+	/*type of ID_CRED_x*/
+	const char *cred;
+	enum vector_set set;
+	/*test vectors (numbered from 1) providing the authentication keys of
+	the initiator and of the responder*/
+	int vec_i;
+	int vec_r;
+};
+
+/*
+ * The test vectors contain signature keys (vectors 1 to 4) and static DH
+ * keys (vector 5) for P-256 and signature keys for Ed25519 (RFC 9529).
+ * Methods 1 and 2 combine the keys of two vectors, suite 1 and 3 reuse the
+ * keys of suite 0 and 2.
+ */
+static const struct scenario scenarios[] = {
+	{ 0, INITIATOR_SK_RESPONDER_SK, "x5t", RFC9529, 1, 1 },
+	{ 1, INITIATOR_SK_RESPONDER_SK, "x5t", RFC9529, 1, 1 },
+	{ 2, INITIATOR_SK_RESPONDER_SK, "x5chain", V16, 1, 1 },
+	{ 2, INITIATOR_SK_RESPONDER_SK, "x5t", V16, 2, 2 },
+	{ 2, INITIATOR_SK_RESPONDER_SK, "x5bag", V16, 3, 3 },
+	{ 2, INITIATOR_SK_RESPONDER_SK, "kid", V16, 4, 4 },
+	{ 2, INITIATOR_SK_RESPONDER_SDHK, "kid", V16, 4, 5 },
+	{ 2, INITIATOR_SDHK_RESPONDER_SK, "kid", V16, 5, 4 },
+	{ 2, INITIATOR_SDHK_RESPONDER_SDHK, "kid", V16, 5, 5 },
+	{ 3, INITIATOR_SK_RESPONDER_SK, "x5chain", V16, 1, 1 },
+	{ 3, INITIATOR_SK_RESPONDER_SK, "x5t", V16, 2, 2 },
+	{ 3, INITIATOR_SK_RESPONDER_SK, "x5bag", V16, 3, 3 },
+	{ 3, INITIATOR_SK_RESPONDER_SK, "kid", V16, 4, 4 },
+	{ 3, INITIATOR_SK_RESPONDER_SDHK, "kid", V16, 4, 5 },
+	{ 3, INITIATOR_SDHK_RESPONDER_SK, "kid", V16, 5, 4 },
+	{ 3, INITIATOR_SDHK_RESPONDER_SDHK, "kid", V16, 5, 5 },
+};
+
+/*the steps of a handshake in the order in which they are executed*/
+enum step {
+	STEP_I_MSG1, /*the initiator creates message 1*/
+	STEP_R_MSG2, /*the responder processes message 1, creates message 2*/
+	STEP_I_MSG3, /*the initiator processes message 2, creates message 3*/
+	STEP_R_MSG3, /*the responder processes message 3 (creates message 4)*/
+#ifdef MESSAGE_4
+	STEP_I_MSG4, /*the initiator processes message 4*/
+#endif
+	STEP_CNT,
+};
+
+static const char *const step_names[] = {
+	"i_msg1_gen", "r_msg2_gen", "i_msg3_gen", "r_msg3_process",
+	"i_msg4_process",
+};
+
+struct scenario_ctx {
+	uint8_t suite;
+	struct edhoc_initiator_context c_i;
+	struct edhoc_responder_context c_r;
+	struct other_party_cred cred_i;
+	struct other_party_cred cred_r;
+	struct cred_array cred_i_array;
+	struct cred_array cred_r_array;
+};
+
+struct result {
+	enum err r;
+	bool prk_out_match;
+	uint32_t iterations;
+	uint64_t total_ns;
+	uint64_t step_ns[STEP_CNT];
+	uint64_t step_min_ns[STEP_CNT];
+	uint32_t msg_len[STEP_CNT];
+	uint32_t stack_i;
+	uint32_t stack_r;
+	uint32_t workspace_i;
+	uint32_t workspace_r;
+};
+
+/*a call of a step function, possibly executed on a measured stack*/
+struct step_call {
+	bool initiator;
+	const struct byte_array *in;
+	struct byte_array out;
+	enum edhoc_step_status status;
+	enum err r;
+	struct workspace *ws;
+};
+
+/* the sessions are static since they contain the message buffers */
+static struct edhoc_initiator_session initiator_session;
+static struct edhoc_responder_session responder_session;
+
+#ifdef WORKSPACE
+static uint8_t initiator_workspace_buf[EDHOC_WORKSPACE_SIZE];
+static uint8_t responder_workspace_buf[EDHOC_WORKSPACE_SIZE];
+#endif
+static struct workspace initiator_workspace;
+static struct workspace responder_workspace;
+
+static uint64_t now_ns(void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+
+static void ba_set(struct byte_array *a, const uint8_t *ptr, uint32_t len)
+{
+	a->ptr = (uint8_t *)ptr;
+	a->len = len;
+}
+
+/**
+ * @brief	Sets the contexts of a scenario according to the RFC 9529
+ *		test vector (chapter 2, x5t, Ed25519 / X25519).
+ */
+static void rfc9529_context_set(struct scenario_ctx *x)
+{
+	struct edhoc_initiator_context *c_i = &x->c_i;
+	struct edhoc_responder_context *c_r = &x->c_r;
+
+	c_i->method = (enum method_type)T1_RFC9529__METHOD;
+	ba_set(&c_i->c_i, T1_RFC9529__C_I, T1_RFC9529__C_I_LEN);
+	ba_set(&c_i->id_cred_i, T1_RFC9529__ID_CRED_I,
+	       T1_RFC9529__ID_CRED_I_LEN);
+	ba_set(&c_i->cred_i, T1_RFC9529__CRED_I, T1_RFC9529__CRED_I_LEN);
+	ba_set(&c_i->g_x, T1_RFC9529__G_X, T1_RFC9529__G_X_LEN);
+	ba_set(&c_i->x, T1_RFC9529__X, T1_RFC9529__X_LEN);
+	ba_set(&c_i->sk_i, T1_RFC9529__SK_I, T1_RFC9529__SK_I_LEN);
+	ba_set(&c_i->pk_i, T1_RFC9529__PK_I, T1_RFC9529__PK_I_LEN);
+
+	ba_set(&c_r->c_r, T1_RFC9529__C_R, T1_RFC9529__C_R_LEN);
+	ba_set(&c_r->id_cred_r, T1_RFC9529__ID_CRED_R,
+	       T1_RFC9529__ID_CRED_R_LEN);
+	ba_set(&c_r->cred_r, T1_RFC9529__CRED_R, T1_RFC9529__CRED_R_LEN);
+	ba_set(&c_r->g_y, T1_RFC9529__G_Y, T1_RFC9529__G_Y_LEN);
+	ba_set(&c_r->y, T1_RFC9529__Y, T1_RFC9529__Y_LEN);
+	ba_set(&c_r->sk_r, T1_RFC9529__SK_R, T1_RFC9529__SK_R_LEN);
+	ba_set(&c_r->pk_r, T1_RFC9529__PK_R, T1_RFC9529__PK_R_LEN);
+
+	ba_set(&x->cred_i.id_cred, T1_RFC9529__ID_CRED_I,
+	       T1_RFC9529__ID_CRED_I_LEN);
+	ba_set(&x->cred_i.cred, T1_RFC9529__CRED_I, T1_RFC9529__CRED_I_LEN);
+	ba_set(&x->cred_i.pk, T1_RFC9529__PK_I, T1_RFC9529__PK_I_LEN);
+
+	ba_set(&x->cred_r.id_cred, T1_RFC9529__ID_CRED_R,
+	       T1_RFC9529__ID_CRED_R_LEN);
+	ba_set(&x->cred_r.cred, T1_RFC9529__CRED_R, T1_RFC9529__CRED_R_LEN);
+	ba_set(&x->cred_r.pk, T1_RFC9529__PK_R, T1_RFC9529__PK_R_LEN);
+}
+
+/**
+ * @brief	Sets the contexts of a scenario according to the test vectors
+ *		v16. The connection identifiers, the ephemeral keys and the
+ *		authentication keys of the initiator are taken from vector
+ *		vec_i, the authentication keys of the responder from vector
+ *		vec_r.
+ */
+static void v16_context_set(struct scenario_ctx *x, int vec_i, int vec_r)
+{
+	const struct test_vector *i = &test_vectors[vec_i - 1];
+	const struct test_vector *r = &test_vectors[vec_r - 1];
+	struct edhoc_initiator_context *c_i = &x->c_i;
+	struct edhoc_responder_context *c_r = &x->c_r;
+
+	ba_set(&c_i->c_i, i->c_i, i->c_i_len);
+	ba_set(&c_i->ead_1, i->ead_1, i->ead_1_len);
+	ba_set(&c_i->ead_3, i->ead_3, i->ead_3_len);
+	ba_set(&c_i->id_cred_i, i->id_cred_i, i->id_cred_i_len);
+	ba_set(&c_i->cred_i, i->cred_i, i->cred_i_len);
+	ba_set(&c_i->g_x, i->g_x_raw, i->g_x_raw_len);
+	ba_set(&c_i->x, i->x_raw, i->x_raw_len);
+	ba_set(&c_i->g_i, i->g_i_raw, i->g_i_raw_len);
+	ba_set(&c_i->i, i->i_raw, i->i_raw_len);
+	ba_set(&c_i->sk_i, i->sk_i_raw, i->sk_i_raw_len);
+	ba_set(&c_i->pk_i, i->pk_i_raw, i->pk_i_raw_len);
+
+	ba_set(&c_r->c_r, i->c_r, i->c_r_len);
+	ba_set(&c_r->ead_2, i->ead_2, i->ead_2_len);
+	ba_set(&c_r->ead_4, i->ead_4, i->ead_4_len);
+	ba_set(&c_r->g_y, i->g_y_raw, i->g_y_raw_len);
+	ba_set(&c_r->y, i->y_raw, i->y_raw_len);
+	ba_set(&c_r->id_cred_r, r->id_cred_r, r->id_cred_r_len);
+	ba_set(&c_r->cred_r, r->cred_r, r->cred_r_len);
+	ba_set(&c_r->g_r, r->g_r_raw, r->g_r_raw_len);
+	ba_set(&c_r->r, r->r_raw, r->r_raw_len);
+	ba_set(&c_r->sk_r, r->sk_r_raw, r->sk_r_raw_len);
+	ba_set(&c_r->pk_r, r->pk_r_raw, r->pk_r_raw_len);
+
+	ba_set(&x->cred_i.id_cred, i->id_cred_i, i->id_cred_i_len);
+	ba_set(&x->cred_i.cred, i->cred_i, i->cred_i_len);
+	ba_set(&x->cred_i.g, i->g_i_raw, i->g_i_raw_len);
+	ba_set(&x->cred_i.pk, i->pk_i_raw, i->pk_i_raw_len);
+	ba_set(&x->cred_i.ca, i->ca_i, i->ca_i_len);
+	ba_set(&x->cred_i.ca_pk, i->ca_i_pk, i->ca_i_pk_len);
+
+	ba_set(&x->cred_r.id_cred, r->id_cred_r, r->id_cred_r_len);
+	ba_set(&x->cred_r.cred, r->cred_r, r->cred_r_len);
+	ba_set(&x->cred_r.g, r->g_r_raw, r->g_r_raw_len);
+	ba_set(&x->cred_r.pk, r->pk_r_raw, r->pk_r_raw_len);
+	ba_set(&x->cred_r.ca, r->ca_r, r->ca_r_len);
+	ba_set(&x->cred_r.ca_pk, r->ca_r_pk, r->ca_r_pk_len);
+}
+
+static void scenario_ctx_set(const struct scenario *s, struct scenario_ctx *x)
+{
+	memset(x, 0, sizeof(*x));
+	if (RFC9529 == s->set) {
+		rfc9529_context_set(x);
+	} else {
+		v16_context_set(x, s->vec_i, s->vec_r);
+	}
+
+	x->suite = s->suite;
+	x->c_i.method = s->method;
+	ba_set(&x->c_i.suites_i, &x->suite, 1);
+	ba_set(&x->c_r.suites_r, &x->suite, 1);
+
+	x->cred_i_array.len = 1;
+	x->cred_i_array.ptr = &x->cred_i;
+	x->cred_r_array.len = 1;
+	x->cred_r_array.ptr = &x->cred_r;
+}
+
+static void step_exec(struct step_call *s)
+{
+#ifdef WORKSPACE
+	workspace_select(s->ws);
+#endif
+	if (s->initiator) {
+		s->r = edhoc_initiator_session_step(&initiator_session, s->in,
+						    &s->out, &s->status);
+	} else {
+		s->r = edhoc_responder_session_step(&responder_session, s->in,
+						    &s->out, &s->status);
+	}
+}
+
+static void *step_thread(void *arg)
+{
+	if (NULL != arg) {
+		step_exec((struct step_call *)arg);
+	}
+	return NULL;
+}
+
+/**
+ * @brief	Executes a step in a thread running on the given stack. With
+ *		arg == NULL only the thread is started, which gives the stack
+ *		used by the thread itself.
+ */
+static int step_on_stack(struct step_call *s, uint8_t *stack)
+{
+	pthread_attr_t attr;
+	pthread_t t;
+
+	int r = pthread_attr_init(&attr);
+	if (0 != r) {
+		return r;
+	}
+	r = pthread_attr_setstack(&attr, stack, STACK_SIZE);
+	if (0 == r) {
+		r = pthread_create(&t, &attr, step_thread, s);
+	}
+	if (0 == r) {
+		r = pthread_join(t, NULL);
+	}
+	pthread_attr_destroy(&attr);
+	return r;
+}
+
+static void stack_paint(uint8_t *stack)
+{
+	memset(stack, STACK_PAINT, STACK_SIZE);
+}
+
+/**
+ * @brief	Returns the number of bytes of a painted stack that were
+ *		written, minus base. The stack grows downwards.
+ */
+static uint32_t stack_used(const uint8_t *stack, uint32_t base)
+{
+	uint32_t i = 0;
+	while ((i < STACK_SIZE) && (STACK_PAINT == stack[i])) {
+		i++;
+	}
+	return (STACK_SIZE - i > base) ? STACK_SIZE - i - base : 0;
+}
+
+/**
+ * @brief	Runs one handshake.
+ *
+ * @param x	The contexts.
+ * @param res	The latency of every step is added to res->step_ns.
+ * @param stack_i Stack for the steps of the initiator or NULL to execute
+ *		all steps in the calling thread.
+ * @param stack_r Stack for the steps of the responder.
+ * @return	ok or the error of the failing step.
+ */
+static enum err handshake(struct scenario_ctx *x, struct result *res,
+			  uint8_t *stack_i, uint8_t *stack_r)
+{
+	struct byte_array msg = BYTE_ARRAY_INIT(NULL, 0);
+
+	edhoc_initiator_session_init(&initiator_session, &x->c_i,
+				     &x->cred_r_array);
+	edhoc_responder_session_init(&responder_session, &x->c_r,
+				     &x->cred_i_array);
+
+	for (int k = 0; k < STEP_CNT; k++) {
+		struct step_call s = {
+			.initiator = (0 == (k % 2)),
+			.in = (STEP_I_MSG1 == k) ? NULL : &msg,
+			.r = ok,
+		};
+		s.ws = s.initiator ? &initiator_workspace :
+				     &responder_workspace;
+
+		uint64_t start = now_ns();
+		if (NULL == stack_i) {
+			step_exec(&s);
+		} else if (0 != step_on_stack(&s, s.initiator ? stack_i :
+								 stack_r)) {
+			return unexpected_result_from_ext_lib;
+		}
+		uint64_t d = now_ns() - start;
+
+		TRY(s.r);
+		res->step_ns[k] += d;
+		if ((0 == res->step_min_ns[k]) || (d < res->step_min_ns[k])) {
+			res->step_min_ns[k] = d;
+		}
+		res->msg_len[k] = s.out.len;
+		msg = s.out;
+	}
+
+	res->prk_out_match =
+		(initiator_session.prk_out.len ==
+		 responder_session.prk_out.len) &&
+		(0 == memcmp(initiator_session.prk_out.ptr,
+			     responder_session.prk_out.ptr,
+			     initiator_session.prk_out.len));
+	return ok;
+}
+
+/**
+ * @brief	Runs a scenario: one handshake with measured stacks, then the
+ *		timed handshakes.
+ */
+static void scenario_run(const struct scenario *s, uint32_t iterations,
+			 uint8_t *stack_i, uint8_t *stack_r,
+			 uint32_t stack_base, struct result *res)
+{
+	struct scenario_ctx x;
+	struct result warmup;
+
+	memset(res, 0, sizeof(*res));
+	memset(&warmup, 0, sizeof(warmup));
+	scenario_ctx_set(s, &x);
+#ifdef WORKSPACE
+	workspace_init(&initiator_workspace, initiator_workspace_buf,
+		       sizeof(initiator_workspace_buf));
+	workspace_init(&responder_workspace, responder_workspace_buf,
+		       sizeof(responder_workspace_buf));
+#endif
+
+	stack_paint(stack_i);
+	stack_paint(stack_r);
+	res->r = handshake(&x, &warmup, stack_i, stack_r);
+	if (ok != res->r) {
+		return;
+	}
+	res->stack_i = stack_used(stack_i, stack_base);
+	res->stack_r = stack_used(stack_r, stack_base);
+	res->workspace_i = initiator_workspace.peak;
+	res->workspace_r = responder_workspace.peak;
+
+	uint64_t start = now_ns();
+	for (uint32_t n = 0; n < iterations; n++) {
+		res->r = handshake(&x, res, NULL, NULL);
+		if ((ok != res->r) || !res->prk_out_match) {
+			return;
+		}
+		res->iterations++;
+	}
+	res->total_ns = now_ns() - start;
+}
+
+static void json_header(FILE *f, uint32_t iterations)
+{
+	fprintf(f, "{\n  \"library\": \"uoscore-uedhoc\",\n");
+	fprintf(f, "  \"crypto_engine\": [");
+	const char *sep = "";
+#ifdef TINYCRYPT
+	fprintf(f, "%s\"TINYCRYPT\"", sep);
+	sep = ", ";
+#endif
+#ifdef MBEDTLS
+	fprintf(f, "%s\"MBEDTLS\"", sep);
+	sep = ", ";
+#endif
+#ifdef COMPACT25519
+	fprintf(f, "%s\"COMPACT25519\"", sep);
+	sep = ", ";
+#endif
+#ifdef CURVE25519_64
+	fprintf(f, "%s\"CURVE25519_64\"", sep);
+	sep = ", ";
+#endif
+#ifdef AES_CCM_HW
+	fprintf(f, "%s\"AES_CCM_HW\"", sep);
+	sep = ", ";
+#endif
+#ifdef SHA256_HW
+	fprintf(f, "%s\"SHA256_HW\"", sep);
+	sep = ", ";
+#endif
+	(void)sep;
+	fprintf(f, "],\n");
+
+	bool message_4 = false, vla = false, workspace = false;
+#ifdef MESSAGE_4
+	message_4 = true;
+#endif
+#ifdef VLA
+	vla = true;
+#endif
+#ifdef WORKSPACE
+	workspace = true;
+#endif
+	fprintf(f,
+		"  \"features\": { \"message_4\": %s, \"vla\": %s, "
+		"\"workspace\": %s },\n",
+		message_4 ? "true" : "false", vla ? "true" : "false",
+		workspace ? "true" : "false");
+	fprintf(f, "  \"iterations\": %u,\n", iterations);
+	fprintf(f, "  \"scenarios\": [");
+}
+
+static void json_scenario(FILE *f, const struct scenario *s,
+			  const struct result *res, bool first)
+{
+	fprintf(f, "%s\n    {\n", first ? "" : ",");
+	fprintf(f, "      \"name\": \"suite%u_method%d_%s\",\n", s->suite,
+		(int)s->method, s->cred);
+	fprintf(f,
+		"      \"suite\": %u, \"method\": %d, \"cred\": \"%s\",\n",
+		s->suite, (int)s->method, s->cred);
+
+	if (ok != res->r || !res->prk_out_match) {
+		fprintf(f, "      \"status\": \"%s\", \"error_code\": %d\n",
+			(ok != res->r) ? "error" : "prk_out_mismatch",
+			(int)res->r);
+		fprintf(f, "    }");
+		return;
+	}
+
+	double total_s = (double)res->total_ns / 1e9;
+	fprintf(f, "      \"status\": \"ok\",\n");
+	fprintf(f, "      \"handshakes_per_second\": %.2f,\n",
+		(total_s > 0) ? (double)res->iterations / total_s : 0.0);
+
+	fprintf(f, "      \"latency_us\": {");
+	for (int k = 0; k < STEP_CNT; k++) {
+		fprintf(f,
+			"%s\n        \"%s\": { \"mean\": %.1f, "
+			"\"min\": %.1f }",
+			(0 == k) ? "" : ",", step_names[k],
+			(double)res->step_ns[k] / 1e3 / res->iterations,
+			(double)res->step_min_ns[k] / 1e3);
+	}
+	fprintf(f, "\n      },\n");
+
+	fprintf(f, "      \"message_bytes\": [");
+	for (int k = 0; k < STEP_CNT; k++) {
+		fprintf(f, "%s%u", (0 == k) ? "" : ", ", res->msg_len[k]);
+	}
+	fprintf(f, "],\n");
+
+	fprintf(f,
+		"      \"stack_bytes\": { \"initiator\": %u, "
+		"\"responder\": %u },\n",
+		res->stack_i, res->stack_r);
+	fprintf(f,
+		"      \"ram_bytes\": { \"initiator_session\": %zu, "
+		"\"responder_session\": %zu, \"initiator_workspace\": %u, "
+		"\"responder_workspace\": %u }\n",
+		sizeof(initiator_session), sizeof(responder_session),
+		res->workspace_i, res->workspace_r);
+	fprintf(f, "    }");
+}
+
+struct aead_result {
+	enum err r;
+	uint32_t iterations;
+	uint64_t raw_ns;
+	uint64_t key_ns;
+};
+
+/**
+ * @brief	Encrypts and decrypts a payload iterations times with a
+ *		provider, with a raw key and with a prepared key.
+ */
+static void aead_run(const struct crypto_provider *p, uint32_t size,
+		     uint32_t iterations, struct aead_result *res)
+{
+	static uint8_t pt_buf[AEAD_MAX_SIZE];
+	static uint8_t ct_buf[AEAD_MAX_SIZE + AEAD_TAG_SIZE];
+	static uint8_t dec_buf[AEAD_MAX_SIZE];
+	uint8_t key_buf[16] = { 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+				0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf };
+	uint8_t nonce_buf[AEAD_IV_SIZE] = { 0 };
+	/*AAD of an OSCORE message with a one byte kid and partial IV*/
+	uint8_t aad_buf[] = { 0x83, 0x68, 0x45, 0x6e, 0x63, 0x72, 0x79,
+			      0x70, 0x74, 0x30, 0x40, 0x48, 0x85, 0x01,
+			      0x81, 0x0a, 0x41, 0x00, 0x41, 0x14, 0x40 };
+	struct byte_array key = BYTE_ARRAY_INIT(key_buf, sizeof(key_buf));
+	struct byte_array nonce = BYTE_ARRAY_INIT(nonce_buf, sizeof(nonce_buf));
+	struct byte_array aad = BYTE_ARRAY_INIT(aad_buf, sizeof(aad_buf));
+	struct byte_array pt = BYTE_ARRAY_INIT(pt_buf, size);
+	struct byte_array ct = BYTE_ARRAY_INIT(ct_buf, size);
+	struct byte_array tag = BYTE_ARRAY_INIT(ct_buf + size, AEAD_TAG_SIZE);
+	struct byte_array in = BYTE_ARRAY_INIT(ct_buf, size + AEAD_TAG_SIZE);
+	struct byte_array dec = BYTE_ARRAY_INIT(dec_buf, size);
+	struct crypto_key k;
+
+	memset(res, 0, sizeof(*res));
+	memset(pt_buf, 0x5a, sizeof(pt_buf));
+
+	uint64_t start = now_ns();
+	for (uint32_t n = 0; n < iterations; n++) {
+		nonce_buf[AEAD_IV_SIZE - 1] = (uint8_t)n;
+		res->r = p->aead(ENCRYPT, &pt, &key, &nonce, &aad, &ct, &tag);
+		if (ok != res->r) {
+			return;
+		}
+		res->r = p->aead(DECRYPT, &in, &key, &nonce, &aad, &dec, &tag);
+		if (ok != res->r) {
+			return;
+		}
+	}
+	res->raw_ns = now_ns() - start;
+
+	/*crypto_key_import() uses the provider selected for the algorithm*/
+	crypto_provider_unregister_all();
+	res->r = crypto_provider_register(CRYPTO_OP_AEAD, AES_CCM_16_64_128, p);
+	if (ok != res->r) {
+		return;
+	}
+	res->r = crypto_key_import(AES_CCM_16_64_128, &key, &k);
+	crypto_provider_unregister_all();
+	if (ok != res->r) {
+		return;
+	}
+	start = now_ns();
+	for (uint32_t n = 0; n < iterations; n++) {
+		nonce_buf[AEAD_IV_SIZE - 1] = (uint8_t)n;
+		res->r = aead_with_key(ENCRYPT, &k, &pt, &nonce, &aad, &ct,
+				       &tag);
+		if (ok != res->r) {
+			break;
+		}
+		res->r = aead_with_key(DECRYPT, &k, &in, &nonce, &aad, &dec,
+				       &tag);
+		if (ok != res->r) {
+			break;
+		}
+	}
+	res->key_ns = now_ns() - start;
+	crypto_key_release(&k);
+	if (ok == res->r) {
+		res->iterations = iterations;
+	}
+}
+
+static void json_aead(FILE *f, const char *name,
+		      const struct crypto_provider *p, uint32_t size,
+		      const struct aead_result *res, bool first)
+{
+	fprintf(f, "%s\n    {\n", first ? "" : ",");
+	fprintf(f, "      \"name\": \"%s\",\n", name);
+	fprintf(f,
+		"      \"provider\": \"%s\", \"payload_bytes\": %u,\n",
+		p->name, size);
+	if (ok != res->r) {
+		fprintf(f, "      \"status\": \"error\", \"error_code\": %d\n",
+			(int)res->r);
+		fprintf(f, "    }");
+		return;
+	}
+
+	/*one iteration is an encryption and a decryption*/
+	uint64_t ops = 2 * (uint64_t)res->iterations;
+	double raw = (double)res->raw_ns / (double)ops;
+	double key = (double)res->key_ns / (double)ops;
+	fprintf(f, "      \"status\": \"ok\",\n");
+	fprintf(f,
+		"      \"ns_per_op\": { \"raw_key\": %.1f, "
+		"\"prepared_key\": %.1f },\n",
+		raw, key);
+	fprintf(f,
+		"      \"mb_per_second\": { \"raw_key\": %.1f, "
+		"\"prepared_key\": %.1f }\n",
+		(raw > 0) ? size * 1e3 / raw : 0.0,
+		(key > 0) ? size * 1e3 / key : 0.0);
+	fprintf(f, "    }");
+}
+
+static void usage(const char *name)
+{
+	fprintf(stderr,
+		"usage: %s [-n iterations] [-f name filter] [-o output.json]\n",
+		name);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t iterations = DEFAULT_ITERATIONS;
+	const char *filter = NULL;
+	FILE *out = stdout;
+	int opt;
+
+	while (-1 != (opt = getopt(argc, argv, "n:f:o:h"))) {
+		switch (opt) {
+		case 'n':
+			iterations = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 'f':
+			filter = optarg;
+			break;
+		case 'o':
+			out = fopen(optarg, "w");
+			if (NULL == out) {
+				perror(optarg);
+				return 1;
+			}
+			break;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (0 == iterations) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	void *stack_i = NULL;
+	void *stack_r = NULL;
+	long page = sysconf(_SC_PAGESIZE);
+	if ((0 != posix_memalign(&stack_i, (size_t)page, STACK_SIZE)) ||
+	    (0 != posix_memalign(&stack_r, (size_t)page, STACK_SIZE))) {
+		fprintf(stderr, "cannot allocate the stacks\n");
+		return 1;
+	}
+
+	/*the stack used by a thread that does nothing is not counted*/
+	stack_paint(stack_i);
+	if (0 != step_on_stack(NULL, stack_i)) {
+		fprintf(stderr, "cannot start a thread\n");
+		return 1;
+	}
+	uint32_t stack_base = stack_used(stack_i, 0);
+
+	int failed = 0;
+	bool first = true;
+	json_header(out, iterations);
+	for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+		const struct scenario *s = &scenarios[i];
+		char name[64];
+		snprintf(name, sizeof(name), "suite%u_method%d_%s", s->suite,
+			 (int)s->method, s->cred);
+		if ((NULL != filter) && (NULL == strstr(name, filter))) {
+			continue;
+		}
+
+		struct result res;
+		fprintf(stderr, "%s...\n", name);
+		scenario_run(s, iterations, stack_i, stack_r, stack_base, &res);
+		if ((ok != res.r) || !res.prk_out_match) {
+			failed++;
+		}
+		json_scenario(out, s, &res, first);
+		first = false;
+	}
+	fprintf(out, "\n  ],\n  \"aead\": [");
+
+	const struct crypto_provider *providers[] = {
+		&crypto_provider_builtin,
+#ifdef AES_CCM_HW
+		aes_ccm_hw_available() ? &crypto_provider_aes_ccm_hw : NULL,
+#endif
+	};
+	const size_t sizes_cnt = sizeof(aead_sizes) / sizeof(aead_sizes[0]);
+	first = true;
+	for (size_t i = 0; i < sizeof(providers) / sizeof(providers[0]); i++) {
+		if (NULL == providers[i]) {
+			continue;
+		}
+		for (size_t j = 0; j < sizes_cnt; j++) {
+			char name[64];
+			snprintf(name, sizeof(name), "aead_%s_%u",
+				 providers[i]->name, aead_sizes[j]);
+			if ((NULL != filter) &&
+			    (NULL == strstr(name, filter))) {
+				continue;
+			}
+
+			struct aead_result res;
+			fprintf(stderr, "%s...\n", name);
+			aead_run(providers[i], aead_sizes[j], iterations * 100,
+				 &res);
+			if (ok != res.r) {
+				failed++;
+			}
+			json_aead(out, name, providers[i], aead_sizes[j], &res,
+				  first);
+			first = false;
+		}
+	}
+	fprintf(out, "\n  ]\n}\n");
+
+	if (stdout != out) {
+		fclose(out);
+	}
+	free(stack_i);
+	free(stack_r);
+	return (0 == failed) ? 0 : 2;
+}
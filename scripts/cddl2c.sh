@@ -35,6 +35,8 @@ python3 $ZCBOR code -c $MODELS_PATH/oscore_info.cddl -e -t oscore_info --oc $SRC
 
 python3 $ZCBOR code -c $MODELS_PATH/oscore_enc_structure.cddl -e -t oscore_enc_structure --oc $SRC/oscore_enc_structure.c --include-prefix $INC_PATH_IN_C_FILES --oh $INC/oscore_enc_structure.h
 
+python3 $ZCBOR code -c $MODELS_PATH/oscore_group_aad_array.cddl -e -t group_aad_array --oc $SRC/oscore_group_aad_array.c --include-prefix $INC_PATH_IN_C_FILES --oh $INC/oscore_group_aad_array.h
+
 #
 # EDHOC
 #
@@ -89,9 +91,6 @@ python3 $ZCBOR code -c $MODELS_PATH/edhoc_plaintext.cddl -d -t id_cred_x_map --o
 # decode Native CBOR certificate
 python3 $ZCBOR code -c $MODELS_PATH/edhoc_cert.cddl -d -t cert --oc $SRC/edhoc_decode_cert.c --include-prefix $INC_PATH_IN_C_FILES --oh $INC/edhoc_decode_cert.h
 
-# encode th2
-python3 $ZCBOR code -c $MODELS_PATH/edhoc_th.cddl -e -t th2 --oc $SRC/edhoc_encode_th2.c --include-prefix $INC_PATH_IN_C_FILES --oh $INC/edhoc_encode_th2.h
-
 ### primitive types ###
 #encode byte_string
 python3 $ZCBOR code -c $MODELS_PATH/edhoc_primitive_types.cddl -e -t bstr_type --oc $SRC/edhoc_encode_bstr_type.c --include-prefix $INC_PATH_IN_C_FILES --oh $INC/edhoc_encode_bstr_type.h
@@ -0,0 +1,97 @@
+#!/usr/bin/python3
+
+# This script generates the precomputed tables of the edwards25519 base point
+# used by src/common/crypto_25519.c. The points are computed with affine
+# arithmetic on integers (RFC 8032 Section 5.1) and stored in the radix 2^51
+# representation of the field elements as (y + x, y - x, 2 * d * x * y).
+#
+# usage: python3 gen_25519_tables.py > ../src/common/crypto_25519_tables.h
+
+P = 2**255 - 19
+D = (-121665 * pow(121666, P - 2, P)) % P
+SQRT_M1 = pow(2, (P - 1) // 4, P)
+
+
+def recover_x(y):
+    xx = (y * y - 1) * pow(D * y * y + 1, P - 2, P)
+    x = pow(xx, (P + 3) // 8, P)
+    if (x * x - xx) % P != 0:
+        x = (x * SQRT_M1) % P
+    assert (x * x - xx) % P == 0
+    if x & 1:
+        x = P - x
+    return x
+
+
+def add(a, b):
+    (x1, y1), (x2, y2) = a, b
+    t = D * x1 * x2 * y1 * y2
+    x3 = (x1 * y2 + x2 * y1) * pow(1 + t, P - 2, P)
+    y3 = (y1 * y2 + x1 * x2) * pow(1 - t, P - 2, P)
+    return (x3 % P, y3 % P)
+
+
+def mul(k, a):
+    r = (0, 1)
+    while k:
+        if k & 1:
+            r = add(r, a)
+        a = add(a, a)
+        k >>= 1
+    return r
+
+
+def limbs(v):
+    return [(v >> (51 * i)) & (2**51 - 1) for i in range(5)]
+
+
+def fe(v, indent):
+    l = ["0x%016x" % x for x in limbs(v % P)]
+    return "{ " + ", ".join(l[:3]) + ",\n" + indent + "  " + \
+        ", ".join(l[3:]) + " }"
+
+
+def const(name, v):
+    l = ["0x%016x" % x for x in limbs(v % P)]
+    return "static const fe " + name + " = {\n\t" + ", ".join(l[:3]) + \
+        ",\n\t" + ", ".join(l[3:]) + "\n};\n"
+
+
+def precomp(pt, indent):
+    x, y = pt
+    return "{ " + fe(y + x, indent + "  ") + ",\n" + indent + "  " + \
+        fe(y - x, indent + "  ") + ",\n" + indent + "  " + \
+        fe(2 * D * x * y, indent + "  ") + " }"
+
+
+B_Y = (4 * pow(5, P - 2, P)) % P
+B = (recover_x(B_Y), B_Y)
+
+print("/*This is an automatically generated file!*/")
+print("/*scripts/gen_25519_tables.py*/\n")
+print("#ifndef CRYPTO_25519_TABLES_H")
+print("#define CRYPTO_25519_TABLES_H\n")
+print(const("fe_d", D))
+print(const("fe_d2", 2 * D))
+print(const("fe_sqrtm1", SQRT_M1))
+
+print("/*base[i][j] = (j + 1) * 256^i * B*/")
+print("static const struct ge_precomp base[32][8] = {")
+for i in range(32):
+    bi = mul(256**i, B)
+    pt = bi
+    print("\t{")
+    for j in range(8):
+        sep = "," if j < 7 else ""
+        print("\t\t" + precomp(pt, "\t\t") + sep)
+        pt = add(pt, bi)
+    print("\t}" + ("," if i < 31 else ""))
+print("};\n")
+
+print("/*bi[i] = (2 * i + 1) * B*/")
+print("static const struct ge_precomp bi[8] = {")
+for i in range(8):
+    sep = "," if i < 7 else ""
+    print("\t" + precomp(mul(2 * i + 1, B), "\t") + sep)
+print("};\n")
+print("#endif")
@@ -0,0 +1,59 @@
+/*
+ * Generated using zcbor version 0.8.99
+ * https://github.com/NordicSemiconductor/zcbor
+ * Generated with a --default-max-qty of 3
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "zcbor_encode.h"
+#include "cbor/oscore_group_aad_array.h"
+#include "zcbor_print.h"
+
+#if DEFAULT_MAX_QTY != 3
+#error "The type file was generated with a different default_max_qty than this file"
+#endif
+
+static bool encode_group_aad_array(zcbor_state_t *state, const struct group_aad_array *input);
+
+
+static bool encode_group_aad_array(
+		zcbor_state_t *state, const struct group_aad_array *input)
+{
+	zcbor_log("%s\r\n", __func__);
+
+	bool tmp_result = (((zcbor_list_start_encode(state, 8) && ((((zcbor_uint32_encode(state, (&(*input).group_aad_array_oscore_version))))
+	&& ((zcbor_list_start_encode(state, 3) && ((((zcbor_int32_encode(state, (&(*input).group_aad_array_algorithms_alg_group_enc))))
+	&& ((zcbor_int32_encode(state, (&(*input).group_aad_array_algorithms_alg_sign))))
+	&& ((zcbor_int32_encode(state, (&(*input).group_aad_array_algorithms_alg_pairwise_key_agreement))))) || (zcbor_list_map_end_force_encode(state), false)) && zcbor_list_end_encode(state, 3)))
+	&& ((zcbor_bstr_encode(state, (&(*input).group_aad_array_request_kid_context))))
+	&& ((zcbor_bstr_encode(state, (&(*input).group_aad_array_request_kid))))
+	&& ((zcbor_bstr_encode(state, (&(*input).group_aad_array_request_piv))))
+	&& ((zcbor_bstr_encode(state, (&(*input).group_aad_array_options))))
+	&& ((zcbor_bstr_encode(state, (&(*input).group_aad_array_sender_cred))))
+	&& ((zcbor_bstr_encode(state, (&(*input).group_aad_array_gm_cred))))) || (zcbor_list_map_end_force_encode(state), false)) && zcbor_list_end_encode(state, 8))));
+
+	if (!tmp_result) {
+		zcbor_trace_file(state);
+		zcbor_log("%s error: %s\r\n", __func__, zcbor_error_str(zcbor_peek_error(state)));
+	} else {
+		zcbor_log("%s success\r\n", __func__);
+	}
+
+	return tmp_result;
+}
+
+
+
+int cbor_encode_group_aad_array(
+		uint8_t *payload, size_t payload_len,
+		struct group_aad_array *input,
+		size_t *payload_len_out)
+{
+	zcbor_state_t states[5];
+
+	return zcbor_entry_function(payload, payload_len, (void *)input, payload_len_out, states,
+		(zcbor_decoder_t *)encode_group_aad_array, sizeof(states) / sizeof(zcbor_state_t), 1);
+}
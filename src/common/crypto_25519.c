@@ -0,0 +1,1112 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+/*
+ * The field and group arithmetic follows the public domain ref10 and
+ * curve25519-donna-c64 implementations, the reduction modulo the group
+ * order follows TweetNaCl.
+ */
+
+#include <string.h>
+
+#include "crypto_25519.h"
+
+#include "common/memcpy_s.h"
+
+#ifdef CURVE25519_64
+
+typedef unsigned __int128 uint128_t;
+
+/*field element, value = sum of f[i] * 2^(51 * i)*/
+typedef uint64_t fe[5];
+
+/*points in extended coordinates x = X/Z, y = Y/Z, x * y = T/Z*/
+struct ge_p2 {
+	fe X, Y, Z;
+};
+
+struct ge_p3 {
+	fe X, Y, Z, T;
+};
+
+/*intermediate result x = X/Z, y = Y/T*/
+struct ge_p1p1 {
+	fe X, Y, Z, T;
+};
+
+/*affine points of the base point tables*/
+struct ge_precomp {
+	fe yplusx, yminusx, xy2d;
+};
+
+struct ge_cached {
+	fe YplusX, YminusX, Z, T2d;
+};
+
+#include "crypto_25519_tables.h"
+
+#define MASK51 0x7ffffffffffffULL
+
+/******************************************************************************/
+/* field arithmetic modulo 2^255 - 19                                         */
+/******************************************************************************/
+
+/*
+ * All functions accept limbs < 2^52 and return limbs < 2^52. The output may
+ * alias the inputs.
+ */
+
+static void fe_0(fe h)
+{
+	memset(h, 0, sizeof(fe));
+}
+
+static void fe_1(fe h)
+{
+	fe_0(h);
+	h[0] = 1;
+}
+
+static void fe_copy(fe h, const fe f)
+{
+	memcpy(h, f, sizeof(fe));
+}
+
+static void fe_carry(fe h)
+{
+	uint64_t c;
+	c = h[0] >> 51;
+	h[0] &= MASK51;
+	h[1] += c;
+	c = h[1] >> 51;
+	h[1] &= MASK51;
+	h[2] += c;
+	c = h[2] >> 51;
+	h[2] &= MASK51;
+	h[3] += c;
+	c = h[3] >> 51;
+	h[3] &= MASK51;
+	h[4] += c;
+	c = h[4] >> 51;
+	h[4] &= MASK51;
+	h[0] += 19 * c;
+}
+
+static void fe_add(fe h, const fe f, const fe g)
+{
+	for (uint32_t i = 0; i < 5; i++) {
+		h[i] = f[i] + g[i];
+	}
+	fe_carry(h);
+}
+
+static void fe_sub(fe h, const fe f, const fe g)
+{
+	/*4 * p is added to keep the limbs positive*/
+	h[0] = (f[0] + 0x1fffffffffffb4ULL) - g[0];
+	for (uint32_t i = 1; i < 5; i++) {
+		h[i] = (f[i] + 0x1ffffffffffffcULL) - g[i];
+	}
+	fe_carry(h);
+}
+
+static void fe_neg(fe h, const fe f)
+{
+	fe zero;
+	fe_0(zero);
+	fe_sub(h, zero, f);
+}
+
+/**
+ * @brief	Reduces the 128 bit column sums of a product.
+ */
+static void fe_reduce(fe h, uint128_t r0, uint128_t r1, uint128_t r2,
+		      uint128_t r3, uint128_t r4)
+{
+	uint64_t c;
+	r1 += (uint64_t)(r0 >> 51);
+	h[0] = (uint64_t)r0 & MASK51;
+	r2 += (uint64_t)(r1 >> 51);
+	h[1] = (uint64_t)r1 & MASK51;
+	r3 += (uint64_t)(r2 >> 51);
+	h[2] = (uint64_t)r2 & MASK51;
+	r4 += (uint64_t)(r3 >> 51);
+	h[3] = (uint64_t)r3 & MASK51;
+	c = (uint64_t)(r4 >> 51);
+	h[4] = (uint64_t)r4 & MASK51;
+	h[0] += c * 19;
+	c = h[0] >> 51;
+	h[0] &= MASK51;
+	h[1] += c;
+}
+
+static void fe_mul(fe h, const fe f, const fe g)
+{
+	uint64_t f0 = f[0], f1 = f[1], f2 = f[2], f3 = f[3], f4 = f[4];
+	uint64_t g0 = g[0], g1 = g[1], g2 = g[2], g3 = g[3], g4 = g[4];
+	uint64_t g1_19 = 19 * g1, g2_19 = 19 * g2, g3_19 = 19 * g3,
+		 g4_19 = 19 * g4;
+
+	uint128_t r0 = (uint128_t)f0 * g0 + (uint128_t)f1 * g4_19 +
+		       (uint128_t)f2 * g3_19 + (uint128_t)f3 * g2_19 +
+		       (uint128_t)f4 * g1_19;
+	uint128_t r1 = (uint128_t)f0 * g1 + (uint128_t)f1 * g0 +
+		       (uint128_t)f2 * g4_19 + (uint128_t)f3 * g3_19 +
+		       (uint128_t)f4 * g2_19;
+	uint128_t r2 = (uint128_t)f0 * g2 + (uint128_t)f1 * g1 +
+		       (uint128_t)f2 * g0 + (uint128_t)f3 * g4_19 +
+		       (uint128_t)f4 * g3_19;
+	uint128_t r3 = (uint128_t)f0 * g3 + (uint128_t)f1 * g2 +
+		       (uint128_t)f2 * g1 + (uint128_t)f3 * g0 +
+		       (uint128_t)f4 * g4_19;
+	uint128_t r4 = (uint128_t)f0 * g4 + (uint128_t)f1 * g3 +
+		       (uint128_t)f2 * g2 + (uint128_t)f3 * g1 +
+		       (uint128_t)f4 * g0;
+	fe_reduce(h, r0, r1, r2, r3, r4);
+}
+
+static void fe_sq(fe h, const fe f)
+{
+	uint64_t f0 = f[0], f1 = f[1], f2 = f[2], f3 = f[3], f4 = f[4];
+	uint64_t f0_2 = 2 * f0, f1_2 = 2 * f1, f2_2 = 2 * f2, f3_2 = 2 * f3;
+	uint64_t f3_19 = 19 * f3, f4_19 = 19 * f4;
+
+	uint128_t r0 = (uint128_t)f0 * f0 + (uint128_t)f1_2 * f4_19 +
+		       (uint128_t)f2_2 * f3_19;
+	uint128_t r1 = (uint128_t)f0_2 * f1 + (uint128_t)f2_2 * f4_19 +
+		       (uint128_t)f3 * f3_19;
+	uint128_t r2 = (uint128_t)f0_2 * f2 + (uint128_t)f1 * f1 +
+		       (uint128_t)f3_2 * f4_19;
+	uint128_t r3 = (uint128_t)f0_2 * f3 + (uint128_t)f1_2 * f2 +
+		       (uint128_t)f4 * f4_19;
+	uint128_t r4 = (uint128_t)f0_2 * f4 + (uint128_t)f1_2 * f3 +
+		       (uint128_t)f2 * f2;
+	fe_reduce(h, r0, r1, r2, r3, r4);
+}
+
+/**
+ * @brief	Computes h = f^(2^n).
+ */
+static void fe_sqn(fe h, const fe f, uint32_t n)
+{
+	fe_sq(h, f);
+	for (uint32_t i = 1; i < n; i++) {
+		fe_sq(h, h);
+	}
+}
+
+static void fe_mul_small(fe h, const fe f, uint32_t n)
+{
+	fe_reduce(h, (uint128_t)f[0] * n, (uint128_t)f[1] * n,
+		  (uint128_t)f[2] * n, (uint128_t)f[3] * n,
+		  (uint128_t)f[4] * n);
+}
+
+/**
+ * @brief	Computes h = z^(p - 2) = 1/z.
+ */
+static void fe_invert(fe h, const fe z)
+{
+	fe t0, t1, t2, t3;
+	fe_sq(t0, z);
+	fe_sqn(t1, t0, 2);
+	fe_mul(t1, z, t1);
+	fe_mul(t0, t0, t1);
+	fe_sq(t2, t0);
+	fe_mul(t1, t1, t2); /*z^(2^5 - 1)*/
+	fe_sqn(t2, t1, 5);
+	fe_mul(t1, t2, t1); /*z^(2^10 - 1)*/
+	fe_sqn(t2, t1, 10);
+	fe_mul(t2, t2, t1); /*z^(2^20 - 1)*/
+	fe_sqn(t3, t2, 20);
+	fe_mul(t2, t3, t2); /*z^(2^40 - 1)*/
+	fe_sqn(t2, t2, 10);
+	fe_mul(t1, t2, t1); /*z^(2^50 - 1)*/
+	fe_sqn(t2, t1, 50);
+	fe_mul(t2, t2, t1); /*z^(2^100 - 1)*/
+	fe_sqn(t3, t2, 100);
+	fe_mul(t2, t3, t2); /*z^(2^200 - 1)*/
+	fe_sqn(t2, t2, 50);
+	fe_mul(t1, t2, t1); /*z^(2^250 - 1)*/
+	fe_sqn(t1, t1, 5);
+	fe_mul(h, t1, t0); /*z^(2^255 - 21)*/
+}
+
+/**
+ * @brief	Computes h = z^((p - 5) / 8), used for square roots.
+ */
+static void fe_pow22523(fe h, const fe z)
+{
+	fe t0, t1, t2;
+	fe_sq(t0, z);
+	fe_sqn(t1, t0, 2);
+	fe_mul(t1, z, t1);
+	fe_mul(t0, t0, t1);
+	fe_sq(t0, t0);
+	fe_mul(t0, t1, t0); /*z^(2^5 - 1)*/
+	fe_sqn(t1, t0, 5);
+	fe_mul(t0, t1, t0); /*z^(2^10 - 1)*/
+	fe_sqn(t1, t0, 10);
+	fe_mul(t1, t1, t0); /*z^(2^20 - 1)*/
+	fe_sqn(t2, t1, 20);
+	fe_mul(t1, t2, t1); /*z^(2^40 - 1)*/
+	fe_sqn(t1, t1, 10);
+	fe_mul(t0, t1, t0); /*z^(2^50 - 1)*/
+	fe_sqn(t1, t0, 50);
+	fe_mul(t1, t1, t0); /*z^(2^100 - 1)*/
+	fe_sqn(t2, t1, 100);
+	fe_mul(t1, t2, t1); /*z^(2^200 - 1)*/
+	fe_sqn(t1, t1, 50);
+	fe_mul(t0, t1, t0); /*z^(2^250 - 1)*/
+	fe_sqn(t0, t0, 2);
+	fe_mul(h, t0, z); /*z^(2^252 - 3)*/
+}
+
+static uint64_t load64_le(const uint8_t *s)
+{
+	uint64_t r = 0;
+	for (uint32_t i = 0; i < 8; i++) {
+		r |= (uint64_t)s[i] << (8 * i);
+	}
+	return r;
+}
+
+static void store64_le(uint8_t *s, uint64_t v)
+{
+	for (uint32_t i = 0; i < 8; i++) {
+		s[i] = (uint8_t)(v >> (8 * i));
+	}
+}
+
+/**
+ * @brief	Decodes a field element, the most significant bit is ignored.
+ */
+static void fe_frombytes(fe h, const uint8_t s[32])
+{
+	h[0] = load64_le(s) & MASK51;
+	h[1] = (load64_le(s + 6) >> 3) & MASK51;
+	h[2] = (load64_le(s + 12) >> 6) & MASK51;
+	h[3] = (load64_le(s + 19) >> 1) & MASK51;
+	h[4] = (load64_le(s + 24) >> 12) & MASK51;
+}
+
+/**
+ * @brief	Encodes the unique representative of a field element.
+ */
+static void fe_tobytes(uint8_t s[32], const fe f)
+{
+	fe t;
+	fe_copy(t, f);
+	fe_carry(t);
+	fe_carry(t);
+	/*0 <= t < 2^255, if t >= p then t + 19 >= 2^255*/
+	t[0] += 19;
+	fe_carry(t);
+	/*add 2^255 - 19 and drop 2^255, this subtracts 19 again or p*/
+	t[0] += 0x8000000000000ULL - 19;
+	for (uint32_t i = 1; i < 5; i++) {
+		t[i] += 0x8000000000000ULL - 1;
+	}
+	for (uint32_t i = 0; i < 4; i++) {
+		t[i + 1] += t[i] >> 51;
+		t[i] &= MASK51;
+	}
+	t[4] &= MASK51;
+
+	store64_le(s, t[0] | (t[1] << 51));
+	store64_le(s + 8, (t[1] >> 13) | (t[2] << 38));
+	store64_le(s + 16, (t[2] >> 26) | (t[3] << 25));
+	store64_le(s + 24, (t[3] >> 39) | (t[4] << 12));
+}
+
+static bool fe_isnegative(const fe f)
+{
+	uint8_t s[32];
+	fe_tobytes(s, f);
+	return 1 == (s[0] & 1);
+}
+
+static bool fe_isnonzero(const fe f)
+{
+	uint8_t s[32];
+	uint8_t r = 0;
+	fe_tobytes(s, f);
+	for (uint32_t i = 0; i < sizeof(s); i++) {
+		r |= s[i];
+	}
+	return 0 != r;
+}
+
+/**
+ * @brief	Swaps f and g if b is 1, in constant time.
+ */
+static void fe_cswap(fe f, fe g, uint64_t b)
+{
+	uint64_t mask = 0 - b;
+	for (uint32_t i = 0; i < 5; i++) {
+		uint64_t x = mask & (f[i] ^ g[i]);
+		f[i] ^= x;
+		g[i] ^= x;
+	}
+}
+
+/**
+ * @brief	Sets f = g if b is 1, in constant time.
+ */
+static void fe_cmov(fe f, const fe g, uint64_t b)
+{
+	uint64_t mask = 0 - b;
+	for (uint32_t i = 0; i < 5; i++) {
+		f[i] ^= mask & (f[i] ^ g[i]);
+	}
+}
+
+/******************************************************************************/
+/* edwards25519 group                                                         */
+/******************************************************************************/
+
+static void ge_p3_0(struct ge_p3 *h)
+{
+	fe_0(h->X);
+	fe_1(h->Y);
+	fe_1(h->Z);
+	fe_0(h->T);
+}
+
+static void ge_p2_0(struct ge_p2 *h)
+{
+	fe_0(h->X);
+	fe_1(h->Y);
+	fe_1(h->Z);
+}
+
+static void ge_precomp_0(struct ge_precomp *h)
+{
+	fe_1(h->yplusx);
+	fe_1(h->yminusx);
+	fe_0(h->xy2d);
+}
+
+static void ge_p1p1_to_p2(struct ge_p2 *r, const struct ge_p1p1 *p)
+{
+	fe_mul(r->X, p->X, p->T);
+	fe_mul(r->Y, p->Y, p->Z);
+	fe_mul(r->Z, p->Z, p->T);
+}
+
+static void ge_p1p1_to_p3(struct ge_p3 *r, const struct ge_p1p1 *p)
+{
+	fe_mul(r->X, p->X, p->T);
+	fe_mul(r->Y, p->Y, p->Z);
+	fe_mul(r->Z, p->Z, p->T);
+	fe_mul(r->T, p->X, p->Y);
+}
+
+static void ge_p3_to_cached(struct ge_cached *r, const struct ge_p3 *p)
+{
+	fe_add(r->YplusX, p->Y, p->X);
+	fe_sub(r->YminusX, p->Y, p->X);
+	fe_copy(r->Z, p->Z);
+	fe_mul(r->T2d, p->T, fe_d2);
+}
+
+static void ge_p2_dbl(struct ge_p1p1 *r, const struct ge_p2 *p)
+{
+	fe t0;
+	fe_sq(r->X, p->X);
+	fe_sq(r->Z, p->Y);
+	fe_sq(r->T, p->Z);
+	fe_add(r->T, r->T, r->T);
+	fe_add(r->Y, p->X, p->Y);
+	fe_sq(t0, r->Y);
+	fe_add(r->Y, r->Z, r->X);
+	fe_sub(r->Z, r->Z, r->X);
+	fe_sub(r->X, t0, r->Y);
+	fe_sub(r->T, r->T, r->Z);
+}
+
+static void ge_p3_dbl(struct ge_p1p1 *r, const struct ge_p3 *p)
+{
+	struct ge_p2 q;
+	fe_copy(q.X, p->X);
+	fe_copy(q.Y, p->Y);
+	fe_copy(q.Z, p->Z);
+	ge_p2_dbl(r, &q);
+}
+
+/**
+ * @brief	Computes r = p + q (sub = false) or r = p - q (sub = true).
+ */
+static void ge_madd(struct ge_p1p1 *r, const struct ge_p3 *p,
+		    const struct ge_precomp *q, bool sub)
+{
+	fe t0;
+	fe_add(r->X, p->Y, p->X);
+	fe_sub(r->Y, p->Y, p->X);
+	fe_mul(r->Z, r->X, sub ? q->yminusx : q->yplusx);
+	fe_mul(r->Y, r->Y, sub ? q->yplusx : q->yminusx);
+	fe_mul(r->T, q->xy2d, p->T);
+	fe_add(t0, p->Z, p->Z);
+	fe_sub(r->X, r->Z, r->Y);
+	fe_add(r->Y, r->Z, r->Y);
+	if (sub) {
+		fe_sub(r->Z, t0, r->T);
+		fe_add(r->T, t0, r->T);
+	} else {
+		fe_add(r->Z, t0, r->T);
+		fe_sub(r->T, t0, r->T);
+	}
+}
+
+/**
+ * @brief	Computes r = p + q (sub = false) or r = p - q (sub = true).
+ */
+static void ge_add(struct ge_p1p1 *r, const struct ge_p3 *p,
+		   const struct ge_cached *q, bool sub)
+{
+	fe t0;
+	fe_add(r->X, p->Y, p->X);
+	fe_sub(r->Y, p->Y, p->X);
+	fe_mul(r->Z, r->X, sub ? q->YminusX : q->YplusX);
+	fe_mul(r->Y, r->Y, sub ? q->YplusX : q->YminusX);
+	fe_mul(r->T, q->T2d, p->T);
+	fe_mul(r->X, p->Z, q->Z);
+	fe_add(t0, r->X, r->X);
+	fe_sub(r->X, r->Z, r->Y);
+	fe_add(r->Y, r->Z, r->Y);
+	if (sub) {
+		fe_sub(r->Z, t0, r->T);
+		fe_add(r->T, t0, r->T);
+	} else {
+		fe_add(r->Z, t0, r->T);
+		fe_sub(r->T, t0, r->T);
+	}
+}
+
+static void ge_p2_tobytes(uint8_t s[32], const struct ge_p2 *h)
+{
+	fe recip, x, y;
+	fe_invert(recip, h->Z);
+	fe_mul(x, h->X, recip);
+	fe_mul(y, h->Y, recip);
+	fe_tobytes(s, y);
+	s[31] = (uint8_t)(s[31] ^ ((uint8_t)fe_isnegative(x) << 7));
+}
+
+static void ge_p3_tobytes(uint8_t s[32], const struct ge_p3 *h)
+{
+	struct ge_p2 q;
+	fe_copy(q.X, h->X);
+	fe_copy(q.Y, h->Y);
+	fe_copy(q.Z, h->Z);
+	ge_p2_tobytes(s, &q);
+}
+
+/**
+ * @brief	Decodes a point and negates it. Runs in variable time.
+ *
+ * @return	false if s is not the encoding of a point.
+ */
+static bool ge_frombytes_negate_vartime(struct ge_p3 *h, const uint8_t s[32])
+{
+	fe u, v, v3, vxx, check;
+
+	fe_frombytes(h->Y, s);
+	fe_1(h->Z);
+	fe_sq(u, h->Y);
+	fe_mul(v, u, fe_d);
+	fe_sub(u, u, h->Z); /*u = y^2 - 1*/
+	fe_add(v, v, h->Z); /*v = d * y^2 + 1*/
+
+	fe_sq(v3, v);
+	fe_mul(v3, v3, v); /*v^3*/
+	fe_sq(h->X, v3);
+	fe_mul(h->X, h->X, v);
+	fe_mul(h->X, h->X, u); /*u * v^7*/
+
+	fe_pow22523(h->X, h->X);
+	fe_mul(h->X, h->X, v3);
+	fe_mul(h->X, h->X, u); /*x = u * v^3 * (u * v^7)^((p - 5) / 8)*/
+
+	fe_sq(vxx, h->X);
+	fe_mul(vxx, vxx, v);
+	fe_sub(check, vxx, u);
+	if (fe_isnonzero(check)) {
+		fe_add(check, vxx, u);
+		if (fe_isnonzero(check)) {
+			return false;
+		}
+		fe_mul(h->X, h->X, fe_sqrtm1);
+	}
+
+	if (fe_isnegative(h->X) == (1 == (s[31] >> 7))) {
+		fe_neg(h->X, h->X);
+	}
+	fe_mul(h->T, h->X, h->Y);
+	return true;
+}
+
+static uint64_t ct_equal(uint8_t b, uint8_t c)
+{
+	uint64_t x = (uint64_t)(b ^ c);
+	return (x - 1) >> 63;
+}
+
+/**
+ * @brief	Sets t = b * base[pos] in constant time, -8 <= b <= 8.
+ */
+static void ge_select(struct ge_precomp *t, uint32_t pos, int8_t b)
+{
+	struct ge_precomp minust;
+	uint8_t ub = (uint8_t)b;
+	uint8_t bnegative = (uint8_t)(ub >> 7);
+	uint8_t mask = (uint8_t)(0 - bnegative);
+	uint8_t babs = (uint8_t)((ub ^ mask) - mask);
+
+	ge_precomp_0(t);
+	for (uint8_t j = 0; j < 8; j++) {
+		uint64_t eq = ct_equal(babs, (uint8_t)(j + 1));
+		fe_cmov(t->yplusx, base[pos][j].yplusx, eq);
+		fe_cmov(t->yminusx, base[pos][j].yminusx, eq);
+		fe_cmov(t->xy2d, base[pos][j].xy2d, eq);
+	}
+	fe_copy(minust.yplusx, t->yminusx);
+	fe_copy(minust.yminusx, t->yplusx);
+	fe_neg(minust.xy2d, t->xy2d);
+	fe_cmov(t->yplusx, minust.yplusx, bnegative);
+	fe_cmov(t->yminusx, minust.yminusx, bnegative);
+	fe_cmov(t->xy2d, minust.xy2d, bnegative);
+}
+
+/**
+ * @brief	Computes h = a * B in constant time, a[31] <= 127.
+ */
+static void ge_scalarmult_base(struct ge_p3 *h, const uint8_t a[32])
+{
+	int8_t e[64];
+	int8_t carry = 0;
+	struct ge_p1p1 r;
+	struct ge_p2 s;
+	struct ge_precomp t;
+
+	/*a = sum e[i] * 16^i with -8 <= e[i] <= 8*/
+	for (uint32_t i = 0; i < 32; i++) {
+		e[2 * i] = (int8_t)(a[i] & 15);
+		e[2 * i + 1] = (int8_t)((a[i] >> 4) & 15);
+	}
+	for (uint32_t i = 0; i < 63; i++) {
+		e[i] = (int8_t)(e[i] + carry);
+		carry = (int8_t)((e[i] + 8) >> 4);
+		e[i] = (int8_t)(e[i] - carry * 16);
+	}
+	e[63] = (int8_t)(e[63] + carry);
+
+	ge_p3_0(h);
+	for (uint32_t i = 1; i < 64; i += 2) {
+		ge_select(&t, i / 2, e[i]);
+		ge_madd(&r, h, &t, false);
+		ge_p1p1_to_p3(h, &r);
+	}
+
+	/*multiply by 16*/
+	ge_p3_dbl(&r, h);
+	ge_p1p1_to_p2(&s, &r);
+	ge_p2_dbl(&r, &s);
+	ge_p1p1_to_p2(&s, &r);
+	ge_p2_dbl(&r, &s);
+	ge_p1p1_to_p2(&s, &r);
+	ge_p2_dbl(&r, &s);
+	ge_p1p1_to_p3(h, &r);
+
+	for (uint32_t i = 0; i < 64; i += 2) {
+		ge_select(&t, i / 2, e[i]);
+		ge_madd(&r, h, &t, false);
+		ge_p1p1_to_p3(h, &r);
+	}
+}
+
+/**
+ * @brief	Recodes a scalar into signed odd digits -15..15 with at least
+ *		four zeros between two digits.
+ */
+static void slide(int8_t r[256], const uint8_t a[32])
+{
+	for (uint32_t i = 0; i < 256; i++) {
+		r[i] = (int8_t)(1 & (a[i >> 3] >> (i & 7)));
+	}
+	for (uint32_t i = 0; i < 256; i++) {
+		if (0 == r[i]) {
+			continue;
+		}
+		for (uint32_t b = 1; b <= 6 && i + b < 256; b++) {
+			if (0 == r[i + b]) {
+				continue;
+			}
+			if (r[i] + (r[i + b] << b) <= 15) {
+				r[i] = (int8_t)(r[i] + (r[i + b] << b));
+				r[i + b] = 0;
+			} else if (r[i] - (r[i + b] << b) >= -15) {
+				r[i] = (int8_t)(r[i] - (r[i + b] << b));
+				for (uint32_t k = i + b; k < 256; k++) {
+					if (0 == r[k]) {
+						r[k] = 1;
+						break;
+					}
+					r[k] = 0;
+				}
+			} else {
+				break;
+			}
+		}
+	}
+}
+
+static uint32_t digit_abs(int8_t d)
+{
+	return (uint32_t)(d < 0 ? -d : d);
+}
+
+/**
+ * @brief	Computes r = a * A + b * B. Runs in variable time.
+ */
+static void ge_double_scalarmult_vartime(struct ge_p2 *r, const uint8_t a[32],
+					 const struct ge_p3 *A,
+					 const uint8_t b[32])
+{
+	int8_t aslide[256];
+	int8_t bslide[256];
+	struct ge_cached ai[8]; /*A, 3A, 5A, ..., 15A*/
+	struct ge_p1p1 t;
+	struct ge_p3 u;
+	struct ge_p3 a2;
+	int32_t i;
+
+	slide(aslide, a);
+	slide(bslide, b);
+
+	ge_p3_to_cached(&ai[0], A);
+	ge_p3_dbl(&t, A);
+	ge_p1p1_to_p3(&a2, &t);
+	for (uint32_t j = 1; j < 8; j++) {
+		ge_add(&t, &a2, &ai[j - 1], false);
+		ge_p1p1_to_p3(&u, &t);
+		ge_p3_to_cached(&ai[j], &u);
+	}
+
+	ge_p2_0(r);
+	for (i = 255; i >= 0; i--) {
+		if ((0 != aslide[i]) || (0 != bslide[i])) {
+			break;
+		}
+	}
+
+	for (; i >= 0; i--) {
+		ge_p2_dbl(&t, r);
+		if (0 != aslide[i]) {
+			ge_p1p1_to_p3(&u, &t);
+			ge_add(&t, &u, &ai[digit_abs(aslide[i]) / 2],
+			       aslide[i] < 0);
+		}
+		if (0 != bslide[i]) {
+			ge_p1p1_to_p3(&u, &t);
+			ge_madd(&t, &u, &bi[digit_abs(bslide[i]) / 2],
+				bslide[i] < 0);
+		}
+		ge_p1p1_to_p2(r, &t);
+	}
+}
+
+/******************************************************************************/
+/* scalars modulo the group order L                                          */
+/******************************************************************************/
+
+static const int64_t L[32] = { 0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+			       0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+			       0,    0,	   0,	 0,    0,    0,	   0,	 0,
+			       0,    0,	   0,	 0,    0,    0,	   0,	 0x10 };
+
+/**
+ * @brief	Computes r = x mod L, x[i] are signed 64 bit digits of radix
+ *		2^8. Relies on the arithmetic right shift of signed values.
+ */
+static void sc_mod_l(uint8_t r[32], int64_t x[64])
+{
+	int64_t carry;
+	uint32_t j;
+
+	for (uint32_t i = 63; i >= 32; i--) {
+		carry = 0;
+		for (j = i - 32; j < i - 12; j++) {
+			x[j] += carry - 16 * x[i] * L[j - (i - 32)];
+			carry = (x[j] + 128) >> 8;
+			x[j] -= carry * 256;
+		}
+		x[j] += carry;
+		x[i] = 0;
+	}
+	carry = 0;
+	for (j = 0; j < 32; j++) {
+		x[j] += carry - (x[31] >> 4) * L[j];
+		carry = x[j] >> 8;
+		x[j] &= 255;
+	}
+	for (j = 0; j < 32; j++) {
+		x[j] -= carry * L[j];
+	}
+	for (j = 0; j < 32; j++) {
+		x[j + 1] += x[j] >> 8;
+		r[j] = (uint8_t)(x[j] & 255);
+	}
+}
+
+/**
+ * @brief	Computes r = s mod L for a 64 byte s.
+ */
+static void sc_reduce(uint8_t r[32], const uint8_t s[64])
+{
+	int64_t x[64];
+	for (uint32_t i = 0; i < 64; i++) {
+		x[i] = s[i];
+	}
+	sc_mod_l(r, x);
+}
+
+/**
+ * @brief	Computes s = (a * b + c) mod L.
+ */
+static void sc_muladd(uint8_t s[32], const uint8_t a[32], const uint8_t b[32],
+		      const uint8_t c[32])
+{
+	int64_t x[64];
+	memset(x, 0, sizeof(x));
+	for (uint32_t i = 0; i < 32; i++) {
+		x[i] = c[i];
+	}
+	for (uint32_t i = 0; i < 32; i++) {
+		for (uint32_t j = 0; j < 32; j++) {
+			x[i + j] += (int64_t)a[i] * b[j];
+		}
+	}
+	sc_mod_l(s, x);
+	secure_erase((uint8_t *)x, sizeof(x));
+}
+
+/**
+ * @brief	Checks that s < L.
+ */
+static bool sc_is_canonical(const uint8_t s[32])
+{
+	for (uint32_t i = 32; i > 0; i--) {
+		if (s[i - 1] != L[i - 1]) {
+			return s[i - 1] < L[i - 1];
+		}
+	}
+	return false;
+}
+
+/******************************************************************************/
+/* SHA-512 (FIPS 180-4), needed by Ed25519 only                               */
+/******************************************************************************/
+
+struct sha512_ctx {
+	uint64_t h[8];
+	uint8_t buf[128];
+	uint32_t fill;
+	uint64_t len;
+};
+
+static const uint64_t sha512_k[80] = {
+	0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
+	0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+	0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL,
+	0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+	0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
+	0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+	0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL, 0x2de92c6f592b0275ULL,
+	0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+	0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL,
+	0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+	0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL,
+	0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+	0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL,
+	0x92722c851482353bULL, 0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+	0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
+	0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+	0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL,
+	0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+	0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL,
+	0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+	0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL,
+	0xc67178f2e372532bULL, 0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+	0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL,
+	0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+	0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
+	0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+	0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+static uint64_t ror64(uint64_t x, uint32_t n)
+{
+	return (x >> n) | (x << (64 - n));
+}
+
+static uint64_t load64_be(const uint8_t *s)
+{
+	uint64_t r = 0;
+	for (uint32_t i = 0; i < 8; i++) {
+		r = (r << 8) | s[i];
+	}
+	return r;
+}
+
+static void sha512_block(struct sha512_ctx *c, const uint8_t *block)
+{
+	uint64_t w[80];
+	uint64_t s[8];
+
+	for (uint32_t i = 0; i < 16; i++) {
+		w[i] = load64_be(block + 8 * i);
+	}
+	for (uint32_t i = 16; i < 80; i++) {
+		uint64_t s0 = ror64(w[i - 15], 1) ^ ror64(w[i - 15], 8) ^
+			      (w[i - 15] >> 7);
+		uint64_t s1 = ror64(w[i - 2], 19) ^ ror64(w[i - 2], 61) ^
+			      (w[i - 2] >> 6);
+		w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+	}
+
+	memcpy(s, c->h, sizeof(s));
+	for (uint32_t i = 0; i < 80; i++) {
+		uint64_t S1 = ror64(s[4], 14) ^ ror64(s[4], 18) ^
+			      ror64(s[4], 41);
+		uint64_t ch = (s[4] & s[5]) ^ (~s[4] & s[6]);
+		uint64_t t1 = s[7] + S1 + ch + sha512_k[i] + w[i];
+		uint64_t S0 = ror64(s[0], 28) ^ ror64(s[0], 34) ^
+			      ror64(s[0], 39);
+		uint64_t maj = (s[0] & s[1]) ^ (s[0] & s[2]) ^ (s[1] & s[2]);
+		uint64_t t2 = S0 + maj;
+		s[7] = s[6];
+		s[6] = s[5];
+		s[5] = s[4];
+		s[4] = s[3] + t1;
+		s[3] = s[2];
+		s[2] = s[1];
+		s[1] = s[0];
+		s[0] = t1 + t2;
+	}
+	for (uint32_t i = 0; i < 8; i++) {
+		c->h[i] += s[i];
+	}
+}
+
+static void sha512_init(struct sha512_ctx *c)
+{
+	static const uint64_t iv[8] = {
+		0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
+		0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+		0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+		0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+	};
+	memcpy(c->h, iv, sizeof(iv));
+	c->fill = 0;
+	c->len = 0;
+}
+
+static void sha512_update(struct sha512_ctx *c, const uint8_t *in,
+			  uint32_t len)
+{
+	c->len += len;
+	while (len > 0) {
+		uint32_t n = sizeof(c->buf) - c->fill;
+		n = (n < len) ? n : len;
+		memcpy(c->buf + c->fill, in, n);
+		c->fill += n;
+		in += n;
+		len -= n;
+		if (sizeof(c->buf) == c->fill) {
+			sha512_block(c, c->buf);
+			c->fill = 0;
+		}
+	}
+}
+
+static void sha512_final(struct sha512_ctx *c, uint8_t out[64])
+{
+	uint64_t bits = c->len * 8;
+
+	c->buf[c->fill++] = 0x80;
+	if (c->fill > sizeof(c->buf) - 16) {
+		memset(c->buf + c->fill, 0, sizeof(c->buf) - c->fill);
+		sha512_block(c, c->buf);
+		c->fill = 0;
+	}
+	/*the upper 64 bits of the 128 bit length are 0*/
+	memset(c->buf + c->fill, 0, sizeof(c->buf) - 8 - c->fill);
+	for (uint32_t i = 0; i < 8; i++) {
+		c->buf[sizeof(c->buf) - 1 - i] = (uint8_t)(bits >> (8 * i));
+	}
+	sha512_block(c, c->buf);
+
+	for (uint32_t i = 0; i < 8; i++) {
+		for (uint32_t j = 0; j < 8; j++) {
+			out[8 * i + j] = (uint8_t)(c->h[i] >> (56 - 8 * j));
+		}
+	}
+	secure_erase((uint8_t *)c, sizeof(*c));
+}
+
+/******************************************************************************/
+/* X25519 and Ed25519                                                         */
+/******************************************************************************/
+
+static void x25519_clamp(uint8_t k[32])
+{
+	k[0] &= 248;
+	k[31] &= 127;
+	k[31] |= 64;
+}
+
+void crypto_x25519_keygen(uint8_t sk[32], uint8_t pk[32],
+			  const uint8_t seed[32])
+{
+	struct ge_p3 A;
+	fe zplusy, zminusy, u;
+
+	memcpy(sk, seed, 32);
+	x25519_clamp(sk);
+
+	/*the u-coordinate of sk * 9 is (1 + y) / (1 - y) of sk * B*/
+	ge_scalarmult_base(&A, sk);
+	fe_add(zplusy, A.Z, A.Y);
+	fe_sub(zminusy, A.Z, A.Y);
+	fe_invert(zminusy, zminusy);
+	fe_mul(u, zplusy, zminusy);
+	fe_tobytes(pk, u);
+}
+
+void crypto_x25519(uint8_t out[32], const uint8_t sk[32],
+		   const uint8_t pk[32])
+{
+	uint8_t k[32];
+	fe x1, x2, z2, x3, z3, a, aa, b, bb, e, c, d;
+	uint64_t swap = 0;
+
+	memcpy(k, sk, sizeof(k));
+	x25519_clamp(k);
+
+	/*Montgomery ladder, RFC 7748 Section 5*/
+	fe_frombytes(x1, pk);
+	fe_1(x2);
+	fe_0(z2);
+	fe_copy(x3, x1);
+	fe_1(z3);
+	for (uint32_t t = 255; t > 0; t--) {
+		uint32_t bit = t - 1;
+		uint64_t k_t = (uint64_t)((k[bit >> 3] >> (bit & 7)) & 1);
+		swap ^= k_t;
+		fe_cswap(x2, x3, swap);
+		fe_cswap(z2, z3, swap);
+		swap = k_t;
+
+		fe_add(a, x2, z2);
+		fe_sq(aa, a);
+		fe_sub(b, x2, z2);
+		fe_sq(bb, b);
+		fe_sub(e, aa, bb);
+		fe_add(c, x3, z3);
+		fe_sub(d, x3, z3);
+		fe_mul(d, d, a); /*DA*/
+		fe_mul(c, c, b); /*CB*/
+		fe_add(x3, d, c);
+		fe_sq(x3, x3);
+		fe_sub(z3, d, c);
+		fe_sq(z3, z3);
+		fe_mul(z3, z3, x1);
+		fe_mul(x2, aa, bb);
+		fe_mul_small(z2, e, 121665);
+		fe_add(z2, z2, aa);
+		fe_mul(z2, z2, e);
+	}
+	fe_cswap(x2, x3, swap);
+	fe_cswap(z2, z3, swap);
+
+	fe_invert(z2, z2);
+	fe_mul(x2, x2, z2);
+	fe_tobytes(out, x2);
+	secure_erase(k, sizeof(k));
+}
+
+void crypto_ed25519_sign(uint8_t sig[64], const uint8_t pk[32],
+			 const uint8_t sk[32], const uint8_t *msg,
+			 uint32_t msg_len)
+{
+	struct sha512_ctx c;
+	uint8_t az[64];
+	uint8_t nonce[64];
+	uint8_t hram[64];
+	struct ge_p3 R;
+
+	/*a = clamped first half of SHA-512(sk), prefix = second half*/
+	sha512_init(&c);
+	sha512_update(&c, sk, 32);
+	sha512_final(&c, az);
+	x25519_clamp(az);
+
+	/*r = SHA-512(prefix | msg) mod L, R = r * B*/
+	sha512_init(&c);
+	sha512_update(&c, az + 32, 32);
+	sha512_update(&c, msg, msg_len);
+	sha512_final(&c, nonce);
+	sc_reduce(nonce, nonce);
+	ge_scalarmult_base(&R, nonce);
+	ge_p3_tobytes(sig, &R);
+
+	/*S = (r + SHA-512(R | A | msg) * a) mod L*/
+	sha512_init(&c);
+	sha512_update(&c, sig, 32);
+	sha512_update(&c, pk, 32);
+	sha512_update(&c, msg, msg_len);
+	sha512_final(&c, hram);
+	sc_reduce(hram, hram);
+	sc_muladd(sig + 32, hram, az, nonce);
+
+	secure_erase(az, sizeof(az));
+	secure_erase(nonce, sizeof(nonce));
+}
+
+bool crypto_ed25519_verify(const uint8_t sig[64], const uint8_t pk[32],
+			   const uint8_t *msg, uint32_t msg_len)
+{
+	struct sha512_ctx c;
+	uint8_t h[64];
+	uint8_t rcheck[32];
+	struct ge_p3 A;
+	struct ge_p2 R;
+
+	if (!sc_is_canonical(sig + 32) ||
+	    !ge_frombytes_negate_vartime(&A, pk)) {
+		return false;
+	}
+
+	sha512_init(&c);
+	sha512_update(&c, sig, 32);
+	sha512_update(&c, pk, 32);
+	sha512_update(&c, msg, msg_len);
+	sha512_final(&c, h);
+	sc_reduce(h, h);
+
+	/*R = S * B - h * A*/
+	ge_double_scalarmult_vartime(&R, h, &A, sig + 32);
+	ge_p2_tobytes(rcheck, &R);
+	return 0 == memcmp(rcheck, sig, sizeof(rcheck));
+}
+
+#endif /* CURVE25519_64 */
@@ -0,0 +1,83 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+/*
+ * X25519 (RFC 7748) and Ed25519 (RFC 8032) for 64-bit hosts, selected with
+ * CURVE25519_64 instead of COMPACT25519. The field elements are stored in
+ * five limbs of 51 bits and multiplied with unsigned __int128. Key
+ * generation and signing use precomputed multiples of the base point, see
+ * scripts/gen_25519_tables.py. Operations on secret values run in constant
+ * time, signature verification handles only public values and runs in
+ * variable time.
+ */
+
+#ifndef CRYPTO_25519_H
+#define CRYPTO_25519_H
+
+#ifdef CURVE25519_64
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef __SIZEOF_INT128__
+#error "CURVE25519_64 requires a compiler with unsigned __int128"
+#endif
+
+#define X25519_KEY_SIZE 32
+
+/**
+ * @brief	Generates an X25519 key pair.
+ *
+ * @param[out] sk The private key, the clamped seed.
+ * @param[out] pk The public key.
+ * @param[in] seed 32 random bytes.
+ */
+void crypto_x25519_keygen(uint8_t sk[32], uint8_t pk[32],
+			  const uint8_t seed[32]);
+
+/**
+ * @brief	Computes the X25519 shared secret.
+ *
+ * @param[out] out The shared secret.
+ * @param[in] sk The own private key.
+ * @param[in] pk The public key of the other party.
+ */
+void crypto_x25519(uint8_t out[32], const uint8_t sk[32],
+		   const uint8_t pk[32]);
+
+/**
+ * @brief	Creates an Ed25519 signature.
+ *
+ * @param[out] sig The signature.
+ * @param[in] pk The public key belonging to sk.
+ * @param[in] sk The private key (the 32 byte seed).
+ * @param[in] msg The message.
+ * @param msg_len Length of the message.
+ */
+void crypto_ed25519_sign(uint8_t sig[64], const uint8_t pk[32],
+			 const uint8_t sk[32], const uint8_t *msg,
+			 uint32_t msg_len);
+
+/**
+ * @brief	Verifies an Ed25519 signature.
+ *
+ * @param[in] sig The signature.
+ * @param[in] pk The public key.
+ * @param[in] msg The message.
+ * @param msg_len Length of the message.
+ * @return	true if the signature is valid.
+ */
+bool crypto_ed25519_verify(const uint8_t sig[64], const uint8_t pk[32],
+			   const uint8_t *msg, uint32_t msg_len);
+
+#endif /* CURVE25519_64 */
+
+#endif /* CRYPTO_25519_H */
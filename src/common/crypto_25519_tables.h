@@ -0,0 +1,1678 @@
+/*This is an automatically generated file!*/
+/*scripts/gen_25519_tables.py*/
+
+#ifndef CRYPTO_25519_TABLES_H
+#define CRYPTO_25519_TABLES_H
+
+static const fe fe_d = {
+	0x00034dca135978a3, 0x0001a8283b156ebd, 0x0005e7a26001c029,
+	0x000739c663a03cbb, 0x00052036cee2b6ff
+};
+
+static const fe fe_d2 = {
+	0x00069b9426b2f159, 0x00035050762add7a, 0x0003cf44c0038052,
+	0x0006738cc7407977, 0x0002406d9dc56dff
+};
+
+static const fe fe_sqrtm1 = {
+	0x00061b274a0ea0b0, 0x0000d5a5fc8f189d, 0x0007ef5e9cbd0c60,
+	0x00078595a6804c9e, 0x0002b8324804fc1d
+};
+
+/*base[i][j] = (j + 1) * 256^i * B*/
+static const struct ge_precomp base[32][8] = {
+	{
+		{ { 0x000493c6f58c3b85, 0x0000df7181c325f7, 0x0000f50b0b3e4cb7,
+		    0x0005329385a44c32, 0x00007cf9d3a33d4b },
+		  { 0x00003905d740913e, 0x0000ba2817d673a2, 0x00023e2827f4e67c,
+		    0x000133d2e0c21a34, 0x00044fd2f9298f81 },
+		  { 0x00011205877aaa68, 0x000479955893d579, 0x00050d66309b67a0,
+		    0x0002d42d0dbee5ee, 0x0006f117b689f0c6 } },
+		{ { 0x0004e7fc933c71d7, 0x0002cf41feb6b244, 0x0007581c0a7d1a76,
+		    0x0007172d534d32f0, 0x000590c063fa87d2 },
+		  { 0x0001a56042b4d5a8, 0x000189cc159ed153, 0x0005b8deaa3cae04,
+		    0x0002aaf04f11b5d8, 0x0006bb595a669c92 },
+		  { 0x0002a8b3a59b7a5f, 0x0003abb359ef087f, 0x0004f5a8c4db05af,
+		    0x0005b9a807d04205, 0x000701af5b13ea50 } },
+		{ { 0x0005b0a84cee9730, 0x00061d10c97155e4, 0x0004059cc8096a10,
+		    0x00047a608da8014f, 0x0007a164e1b9a80f },
+		  { 0x00011fe8a4fcd265, 0x0007bcb8374faacc, 0x00052f5af4ef4d4f,
+		    0x0005314098f98d10, 0x0002ab91587555bd },
+		  { 0x0006933f0dd0d889, 0x00044386bb4c4295, 0x0003cb6d3162508c,
+		    0x00026368b872a2c6, 0x0005a2826af12b9b } },
+		{ { 0x000351b98efc099f, 0x00068fbfa4a7050e, 0x00042a49959d971b,
+		    0x000393e51a469efd, 0x000680e910321e58 },
+		  { 0x0006050a056818bf, 0x00062acc1f5532bf, 0x00028141ccc9fa25,
+		    0x00024d61f471e683, 0x00027933f4c7445a },
+		  { 0x0003fbe9c476ff09, 0x0000af6b982e4b42, 0x0000ad1251ba78e5,
+		    0x000715aeedee7c88, 0x0007f9d0cbf63553 } },
+		{ { 0x0002bc4408a5bb33, 0x000078ebdda05442, 0x0002ffb112354123,
+		    0x000375ee8df5862d, 0x0002945ccf146e20 },
+		  { 0x000182c3a447d6ba, 0x00022964e536eff2, 0x000192821f540053,
+		    0x0002f9f19e788e5c, 0x000154a7e73eb1b5 },
+		  { 0x0003dbf1812a8285, 0x0000fa17ba3f9797, 0x0006f69cb49c3820,
+		    0x00034d5a0db3858d, 0x00043aabe696b3bb } },
+		{ { 0x0004eeeb77157131, 0x0001201915f10741, 0x0001669cda6c9c56,
+		    0x00045ec032db346d, 0x00051e57bb6a2cc3 },
+		  { 0x000006b67b7d8ca4, 0x000084fa44e72933, 0x0001154ee55d6f8a,
+		    0x0004425d842e7390, 0x00038b64c41ae417 },
+		  { 0x0004326702ea4b71, 0x00006834376030b5, 0x0000ef0512f9c380,
+		    0x0000f1a9f2512584, 0x00010b8e91a9f0d6 } },
+		{ { 0x00025cd0944ea3bf, 0x00075673b81a4d63, 0x000150b925d1c0d4,
+		    0x00013f38d9294114, 0x000461bea69283c9 },
+		  { 0x00072c9aaa3221b1, 0x000267774474f74d, 0x000064b0e9b28085,
+		    0x0003f04ef53b27c9, 0x0001d6edd5d2e531 },
+		  { 0x00036dc801b8b3a2, 0x0000e0a7d4935e30, 0x0001deb7cecc0d7d,
+		    0x000053a94e20dd2c, 0x0007a9fbb1c6a0f9 } },
+		{ { 0x0007596604dd3e8f, 0x0006fc510e058b36, 0x0003670c8db2cc0d,
+		    0x000297d899ce332f, 0x0000915e76061bce },
+		  { 0x00075dedf39234d9, 0x00001c36ab1f3c54, 0x0000f08fee58f5da,
+		    0x0000e19613a0d637, 0x0003a9024a1320e0 },
+		  { 0x0001f5d9c9a2911a, 0x0007117994fafcf8, 0x0002d8a8cae28dc5,
+		    0x00074ab1b2090c87, 0x00026907c5c2ecc4 } }
+	},
+	{
+		{ { 0x0004dd0e632f9c1d, 0x0002ced12622a5d9, 0x00018de9614742da,
+		    0x00079ca96fdbb5d4, 0x0006dd37d49a00ee },
+		  { 0x0003635449aa515e, 0x0003e178d0475dab, 0x00050b4712a19712,
+		    0x0002dcc2860ff4ad, 0x00030d76d6f03d31 },
+		  { 0x000444172106e4c7, 0x00001251afed2d88, 0x000534fc9bed4f5a,
+		    0x0005d85a39cf5234, 0x00010c697112e864 } },
+		{ { 0x00062aa08358c805, 0x00046f440848e194, 0x000447b771a8f52b,
+		    0x000377ba3269d31d, 0x00003bf9baf55080 },
+		  { 0x0003c4277dbe5fde, 0x0005a335afd44c92, 0x0000c1164099753e,
+		    0x00070487006fe423, 0x00025e61cabed66f },
+		  { 0x0003e128cc586604, 0x0005968b2e8fc7e2, 0x000049a3d5bd61cf,
+		    0x000116505b1ef6e6, 0x000566d78634586e } },
+		{ { 0x00054285c65a2fd0, 0x00055e62ccf87420, 0x00046bb961b19044,
+		    0x0001153405712039, 0x00014fba5f34793b },
+		  { 0x0007a49f9cc10834, 0x0002b513788a22c6, 0x0005ff4b6ef2395b,
+		    0x0002ec8e5af607bf, 0x00033975bca5ecc3 },
+		  { 0x000746166985f7d4, 0x00009939000ae79a, 0x0005844c7964f97a,
+		    0x00013617e1f95b3d, 0x00014829cea83fc5 } },
+		{ { 0x00070b2f4e71ecb8, 0x000728148efc643c, 0x0000753e03995b76,
+		    0x0005bf5fb2ab6767, 0x00005fc3bc4535d7 },
+		  { 0x00037b8497dd95c2, 0x00061549d6b4ffe8, 0x000217a22db1d138,
+		    0x0000b9cf062eb09e, 0x0002fd9c71e5f758 },
+		  { 0x0000b3ae52afdedd, 0x00019da76619e497, 0x0006fa0654d2558e,
+		    0x00078219d25e41d4, 0x000373767475c651 } },
+		{ { 0x000095cb14246590, 0x000002d82aa6ac68, 0x000442f183bc4851,
+		    0x0006464f1c0a0644, 0x0006bf5905730907 },
+		  { 0x000299fd40d1add9, 0x0005f2de9a04e5f7, 0x0007c0eebacc1c59,
+		    0x0004cca1b1f8290a, 0x0001fbea56c3b18f },
+		  { 0x000778f1e1415b8a, 0x0006f75874efc1f4, 0x00028a694019027f,
+		    0x00052b37a96bdc4d, 0x00002521cf67a635 } },
+		{ { 0x00046720772f5ee4, 0x000632c0f359d622, 0x0002b2092ba3e252,
+		    0x000662257c112680, 0x000001753d9f7cd6 },
+		  { 0x0007ee0b0a9d5294, 0x000381fbeb4cca27, 0x0007841f3a3e639d,
+		    0x000676ea30c3445f, 0x0003fa00a7e71382 },
+		  { 0x0001232d963ddb34, 0x00035692e70b078d, 0x000247ca14777a1f,
+		    0x0006db556be8fcd0, 0x00012b5fe2fa048e } },
+		{ { 0x00037c26ad6f1e92, 0x00046a0971227be5, 0x0004722f0d2d9b4c,
+		    0x0003dc46204ee03a, 0x0006f7e93c20796c },
+		  { 0x0000fbc496fce34d, 0x000575be6b7dae3e, 0x0004a31585cee609,
+		    0x000037e9023930ff, 0x000749b76f96fb12 },
+		  { 0x0002f604aea6ae05, 0x000637dc939323eb, 0x0003fdad9b048d47,
+		    0x0000a8b0d4045af7, 0x0000fcec10f01e02 } },
+		{ { 0x0002d29dc4244e45, 0x0006927b1bc147be, 0x0000308534ac0839,
+		    0x0004853664033f41, 0x000413779166feab },
+		  { 0x000558a649fe1e44, 0x00044635aeefcc89, 0x0001ff434887f2ba,
+		    0x0000f981220e2d44, 0x0004901aa7183c51 },
+		  { 0x0001b7548c1af8f0, 0x0007848c53368116, 0x00001b64e7383de9,
+		    0x000109fbb0587c8f, 0x00041bb887b726d1 } }
+	},
+	{
+		{ { 0x00034c597c6691ae, 0x0007a150b6990fc4, 0x00052beb9d922274,
+		    0x00070eed7164861a, 0x0000a871e070c6a9 },
+		  { 0x00007d44744346be, 0x000282b6a564a81d, 0x0004ed80f875236b,
+		    0x0006fbbe1d450c50, 0x0004eb728c12fcdb },
+		  { 0x0001b5994bbc8989, 0x00074b7ba84c0660, 0x00075678f1cdaeb8,
+		    0x00023206b0d6f10c, 0x0003ee7300f2685d } },
+		{ { 0x00027947841e7518, 0x00032c7388dae87f, 0x000414add3971be9,
+		    0x00001850832f0ef1, 0x0007d47c6a2cfb89 },
+		  { 0x000255e49e7dd6b7, 0x00038c2163d59eba, 0x0003861f2a005845,
+		    0x0002e11e4ccbaec9, 0x0001381576297912 },
+		  { 0x0002d0148ef0d6e0, 0x0003522a8de787fb, 0x0002ee055e74f9d2,
+		    0x00064038f6310813, 0x000148cf58d34c9e } },
+		{ { 0x00072f7d9ae4756d, 0x0007711e690ffc4a, 0x000582a2355b0d16,
+		    0x0000dccfe885b6b4, 0x000278febad4eaea },
+		  { 0x000492f67934f027, 0x0007ded0815528d4, 0x00058461511a6612,
+		    0x0005ea2e50de1544, 0x0003ff2fa1ebd5db },
+		  { 0x0002681f8c933966, 0x0003840521931635, 0x000674f14a308652,
+		    0x0003bd9c88a94890, 0x0004104dd02fe9c6 } },
+		{ { 0x00014e06db096ab8, 0x0001219c89e6b024, 0x000278abd486a2db,
+		    0x000240b292609520, 0x0000165b5a48efca },
+		  { 0x0002bf5e1124422a, 0x000673146756ae56, 0x00014ad99a87e830,
+		    0x0001eaca65b080fd, 0x0002c863b00afaf5 },
+		  { 0x0000a474a0846a76, 0x000099a5ef981e32, 0x0002a8ae3c4bbfe6,
+		    0x00045c34af14832c, 0x000591b67d9bffec } },
+		{ { 0x0001b3719f18b55d, 0x000754318c83d337, 0x00027c17b7919797,
+		    0x000145b084089b61, 0x000489b4f8670301 },
+		  { 0x00070d1c80b49bfa, 0x0003d57e7d914625, 0x0003c0722165e545,
+		    0x0005e5b93819e04f, 0x0003de02ec7ca8f7 },
+		  { 0x0002102d3aeb92ef, 0x00068c22d50c3a46, 0x00042ea89385894e,
+		    0x00075f9ebf55f38c, 0x00049f5fbba496cb } },
+		{ { 0x0005628c1e9c572e, 0x000598b108e822ab, 0x00055d8fae29361a,
+		    0x0000adc8d1a97b28, 0x00006a1a6c288675 },
+		  { 0x00049a108a5bcfd4, 0x0006178c8e7d6612, 0x0001f03473710375,
+		    0x00073a49614a6098, 0x0005604a86dcbfa6 },
+		  { 0x0000d1d47c1764b6, 0x00001c08316a2e51, 0x0002b3db45c95045,
+		    0x0001634f818d300c, 0x00020989e89fe274 } },
+		{ { 0x0004278b85eaec2e, 0x0000ef59657be2ce, 0x00072fd169588770,
+		    0x0002e9b205260b30, 0x000730b9950f7059 },
+		  { 0x000777fd3a2dcc7f, 0x000594a9fb124932, 0x00001f8e80ca15f0,
+		    0x000714d13cec3269, 0x0000403ed1d0ca67 },
+		  { 0x00032d35874ec552, 0x0001f3048df1b929, 0x000300d73b179b23,
+		    0x0006e67be5a37d0b, 0x0005bd7454308303 } },
+		{ { 0x0004932115e7792a, 0x000457b9bbb930b8, 0x00068f5d8b193226,
+		    0x0004164e8f1ed456, 0x0005bb7db123067f },
+		  { 0x0002d19528b24cc2, 0x0004ac66b8302ff3, 0x000701c8d9fdad51,
+		    0x0006c1b35c5b3727, 0x000133a78007380a },
+		  { 0x0001f467c6ca62be, 0x0002c4232a5dc12c, 0x0007551dc013b087,
+		    0x0000690c11b03bcd, 0x000740dca6d58f0e } }
+	},
+	{
+		{ { 0x00028c570478433c, 0x0001d8502873a463, 0x0007641e7eded49c,
+		    0x0001ecedd54cf571, 0x0002c03f5256c2b0 },
+		  { 0x0000ee0752cfce4e, 0x000660dd8116fbe9, 0x00055167130fffeb,
+		    0x0001c682b885955c, 0x000161d25fa963ea },
+		  { 0x000718757b53a47d, 0x000619e18b0f2f21, 0x0005fbdfe4c1ec04,
+		    0x0005d798c81ebb92, 0x000699468bdbd96b } },
+		{ { 0x00053de66aa91948, 0x000045f81a599b1b, 0x0003f7a8bd214193,
+		    0x00071d4da412331a, 0x000293e1c4e6c4a2 },
+		  { 0x00072f46f4dafecf, 0x0002948ffadef7a3, 0x00011ecdfdf3bc04,
+		    0x0003c2e98ffeed25, 0x000525219a473905 },
+		  { 0x0006134b925112e1, 0x0006bb942bb406ed, 0x000070c445c0dde2,
+		    0x000411d822c4d7a3, 0x0005b605c447f032 } },
+		{ { 0x0001fec6f0e7f04c, 0x0003cebc692c477d, 0x000077986a19a95e,
+		    0x0006eaaaa1778b0f, 0x0002f12fef4cc5ab },
+		  { 0x0005805920c47c89, 0x0001924771f9972c, 0x00038bbddf9fc040,
+		    0x0001f7000092b281, 0x00024a76dcea8aeb },
+		  { 0x000522b2dfc0c740, 0x0007e8193480e148, 0x00033fd9a04341b9,
+		    0x0003c863678a20bc, 0x0005e607b2518a43 } },
+		{ { 0x0004431ca596cf14, 0x000015da7c801405, 0x00003c9b6f8f10b5,
+		    0x0000346922934017, 0x000201f33139e457 },
+		  { 0x00031d8f6cdf1818, 0x0001f86c4b144b16, 0x00039875b8d73e9d,
+		    0x0002fbf0d9ffa7b3, 0x0005067acab6ccdd },
+		  { 0x00027f6b08039d51, 0x0004802f8000dfaa, 0x00009692a062c525,
+		    0x0001baea91075817, 0x000397cba8862460 } },
+		{ { 0x0005c3fbc81379e7, 0x00041bbc255e2f02, 0x0006a3f756998650,
+		    0x0001297fd4e07c42, 0x000771b4022c1e1c },
+		  { 0x00013093f05959b2, 0x0001bd352f2ec618, 0x000075789b88ea86,
+		    0x00061d1117ea48b9, 0x0002339d320766e6 },
+		  { 0x0005d986513a2fa7, 0x00063f3a99e11b0f, 0x00028a0ecfd6b26d,
+		    0x00053b6835e18d8f, 0x000331a189219971 } },
+		{ { 0x00012f3a9d7572af, 0x00010d00e953c4ca, 0x000603df116f2f8a,
+		    0x00033dc276e0e088, 0x0001ac9619ff649a },
+		  { 0x00066f45fb4f80c6, 0x0003cc38eeb9fea2, 0x000107647270db1f,
+		    0x000710f1ea740dc8, 0x00031167c6b83bdf },
+		  { 0x00033842524b1068, 0x00077dd39d30fe45, 0x000189432141a0d0,
+		    0x000088fe4eb8c225, 0x000612436341f08b } },
+		{ { 0x000349e31a2d2638, 0x0000137a7fa6b16c, 0x000681ae92777edc,
+		    0x000222bfc5f8dc51, 0x0001522aa3178d90 },
+		  { 0x000541db874e898d, 0x00062d80fb841b33, 0x00003e6ef027fa97,
+		    0x0007a03c9e9633e8, 0x00046ebe2309e5ef },
+		  { 0x00002f5369614938, 0x000356e5ada20587, 0x00011bc89f6bf902,
+		    0x000036746419c8db, 0x00045fe70f505243 } },
+		{ { 0x00024920c8951491, 0x000107ec61944c5e, 0x00072752e017c01f,
+		    0x000122b7dda2e97a, 0x00016619f6db57a2 },
+		  { 0x000075a6960c0b8c, 0x0006dde1c5e41b49, 0x00042e3f516da341,
+		    0x00016a03fda8e79e, 0x000428d1623a0e39 },
+		  { 0x00074a4401a308fd, 0x00006ed4b9558109, 0x000746f1f6a08867,
+		    0x0004636f5c6f2321, 0x0001d81592d60bd3 } }
+	},
+	{
+		{ { 0x0005b69f7b85c5e8, 0x00017a2d175650ec, 0x0004cc3e6dbfc19e,
+		    0x00073e1d3873be0e, 0x0003a5f6d51b0af8 },
+		  { 0x00068756a60dac5f, 0x00055d757b8aec26, 0x0003383df45f80bd,
+		    0x0006783f8c9f96a6, 0x00020234a7789ecd },
+		  { 0x00020db67178b252, 0x00073aa3da2c0eda, 0x00079045c01c70d3,
+		    0x0001b37b15251059, 0x0007cd682353cffe } },
+		{ { 0x0005cd6068acf4f3, 0x0003079afc7a74cc, 0x00058097650b64b4,
+		    0x00047fabac9c4e99, 0x0003ef0253b2b2cd },
+		  { 0x0001a45bd887fab6, 0x00065748076dc17c, 0x0005b98000aa11a8,
+		    0x0004a1ecc9080974, 0x0002838c8863bdc0 },
+		  { 0x0003b0cf4a465030, 0x000022b8aef57a2d, 0x0002ad0677e925ad,
+		    0x0004094167d7457a, 0x00021dcb8a606a82 } },
+		{ { 0x000500fabe7731ba, 0x0007cc53c3113351, 0x0007cf65fe080d81,
+		    0x0003c5d966011ba1, 0x0005d840dbf6c6f6 },
+		  { 0x000004468c9d9fc8, 0x0005da8554796b8c, 0x0003b8be70950025,
+		    0x0006d5892da6a609, 0x0000bc3d08194a31 },
+		  { 0x0006380d309fe18b, 0x0004d73c2cb8ee0d, 0x0006b882adbac0b6,
+		    0x00036eabdddd4cbe, 0x0003a4276232ac19 } },
+		{ { 0x0000c172db447ecb, 0x0003f8c505b7a77f, 0x0006a857f97f3f10,
+		    0x0004fcc0567fe03a, 0x0000770c9e824e1a },
+		  { 0x0002432c8a7084fa, 0x00047bf73ca8a968, 0x0001639176262867,
+		    0x0005e8df4f8010ce, 0x0001ff177cea16de },
+		  { 0x0001d99a45b5b5fd, 0x000523674f2499ec, 0x0000f8fa26182613,
+		    0x00058f7398048c98, 0x00039f264fd41500 } },
+		{ { 0x00034aabfe097be1, 0x00043bfc03253a33, 0x00029bc7fe91b7f3,
+		    0x0000a761e4844a16, 0x00065c621272c35f },
+		  { 0x00053417dbe7e29c, 0x00054573827394f5, 0x000565eea6f650dd,
+		    0x00042050748dc749, 0x0001712d73468889 },
+		  { 0x000389f8ce3193dd, 0x0002d424b8177ce5, 0x000073fa0d3440cd,
+		    0x000139020cd49e97, 0x00022f9800ab19ce } },
+		{ { 0x00029fdd9a6efdac, 0x0007c694a9282840, 0x0006f7cdeee44b3a,
+		    0x00055a3207b25cc3, 0x0004171a4d38598c },
+		  { 0x0002368a3e9ef8cb, 0x000454aa08e2ac0b, 0x000490923f8fa700,
+		    0x000372aa9ea4582f, 0x00013f416cd64762 },
+		  { 0x000758aa99c94c8c, 0x0005f6001700ff44, 0x0007694e488c01bd,
+		    0x0000d5fde948eed6, 0x000508214fa574bd } },
+		{ { 0x000215bb53d003d6, 0x0001179e792ca8c3, 0x0001a0e96ac840a2,
+		    0x00022393e2bb3ab6, 0x0003a7758a4c86cb },
+		  { 0x000269153ed6fe4b, 0x00072a23aef89840, 0x000052be5299699c,
+		    0x0003a5e5ef132316, 0x00022f960ec6faba },
+		  { 0x000111f693ae5076, 0x0003e3bfaa94ca90, 0x000445799476b887,
+		    0x00024a0912464879, 0x0005d9fd15f8de7f } },
+		{ { 0x00044d2aeed7521e, 0x00050865d2c2a7e4, 0x0002705b5238ea40,
+		    0x00046c70b25d3b97, 0x0003bc187fa47eb9 },
+		  { 0x000408d36d63727f, 0x0005faf8f6a66062, 0x0002bb892da8de6b,
+		    0x000769d4f0c7e2e6, 0x000332f35914f8fb },
+		  { 0x00070115ea86c20c, 0x00016d88da24ada8, 0x0001980622662adf,
+		    0x000501ebbc195a9d, 0x000450d81ce906fb } }
+	},
+	{
+		{ { 0x0004d8961cae743f, 0x0006bdc38c7dba0e, 0x0007d3b4a7e1b463,
+		    0x0000844bdee2adf3, 0x0004cbad279663ab },
+		  { 0x0003b6a1a6205275, 0x0002e82791d06dcf, 0x00023d72caa93c87,
+		    0x0005f0b7ab68aaf4, 0x0002de25d4ba6345 },
+		  { 0x00019024a0d71fcd, 0x00015f65115f101a, 0x0004e99067149708,
+		    0x000119d8d1cba5af, 0x0007d7fbcefe2007 } },
+		{ { 0x00045dc5f3c29094, 0x0003455220b579af, 0x000070c1631e068a,
+		    0x00026bc0630e9b21, 0x0004f9cd196dcd8d },
+		  { 0x00071e6a266b2801, 0x00009aae73e2df5d, 0x00040dd8b219b1a3,
+		    0x000546fb4517de0d, 0x0005975435e87b75 },
+		  { 0x000297d86a7b3768, 0x0004835a2f4c6332, 0x000070305f434160,
+		    0x000183dd014e56ae, 0x0007ccdd084387a0 } },
+		{ { 0x000484186760cc93, 0x0007435665533361, 0x00002f686336b801,
+		    0x0005225446f64331, 0x0003593ca848190c },
+		  { 0x0006422c6d260417, 0x000212904817bb94, 0x0005a319deb854f5,
+		    0x0007a9d4e060da7d, 0x000428bd0ed61d0c },
+		  { 0x0003189a5e849aa7, 0x0006acbb1f59b242, 0x0007f6ef4753630c,
+		    0x0001f346292a2da9, 0x00027398308da2d6 } },
+		{ { 0x00010e4c0a702453, 0x0004daafa37bd734, 0x00049f6bdc3e8961,
+		    0x0001feffdcecdae6, 0x000572c2945492c3 },
+		  { 0x00038d28435ed413, 0x0004064f19992858, 0x0007680fbef543cd,
+		    0x0001aadd83d58d3c, 0x000269597aebe8c3 },
+		  { 0x0007c745d6cd30be, 0x00027c7755df78ef, 0x0001776833937fa3,
+		    0x0005405116441855, 0x0007f985498c05bc } },
+		{ { 0x000615520fbf6363, 0x0000b9e9bf74da6a, 0x0004fe8308201169,
+		    0x000173f76127de43, 0x00030f2653cd69b1 },
+		  { 0x0001ce889f0be117, 0x00036f6a94510709, 0x0007f248720016b4,
+		    0x0001821ed1e1cf91, 0x00076c2ec470a31f },
+		  { 0x0000c938aac10c85, 0x00041b64ed797141, 0x0001beb1c1185e6d,
+		    0x0001ed5490600f07, 0x0002f1273f159647 } },
+		{ { 0x00008bd755a70bc0, 0x00049e3a885ce609, 0x00016585881b5ad6,
+		    0x0003c27568d34f5e, 0x00038ac1997edc5f },
+		  { 0x0001fc7c8ae01e11, 0x0002094d5573e8e7, 0x0005ca3cbbf549d2,
+		    0x0004f920ecc54143, 0x0005d9e572ad85b6 },
+		  { 0x0006b517a751b13b, 0x0000cfd370b180cc, 0x0005377925d1f41a,
+		    0x00034e56566008a2, 0x00022dfcd9cbfe9e } },
+		{ { 0x000459b4103be0a1, 0x00059a4b3f2d2add, 0x0007d734c8bb8eeb,
+		    0x0002393cbe594a09, 0x0000fe9877824cde },
+		  { 0x0003d2e0c30d0cd9, 0x0003f597686671bb, 0x0000aa587eb63999,
+		    0x0000e3c7b592c619, 0x0006b2916c05448c },
+		  { 0x000334d10aba913b, 0x000045cdb581cfdb, 0x0005e3e0553a8f36,
+		    0x00050bb3041effb2, 0x0004c303f307ff00 } },
+		{ { 0x000403580dd94500, 0x00048df77d92653f, 0x00038a9fe3b349ea,
+		    0x0000ea89850aafe1, 0x000416b151ab706a },
+		  { 0x00023bd617b28c85, 0x0006e72ee77d5a61, 0x0001a972ff174dde,
+		    0x0003e2636373c60f, 0x0000d61b8f78b2ab },
+		  { 0x0000d7efe9c136b0, 0x0001ab1c89640ad5, 0x00055f82aef41f97,
+		    0x00046957f317ed0d, 0x000191a2af74277e } }
+	},
+	{
+		{ { 0x00062b434f460efb, 0x000294c6c0fad3fc, 0x00068368937b4c0f,
+		    0x0005c9f82910875b, 0x000237e7dbe00545 },
+		  { 0x0006f74bc53c1431, 0x0001c40e5dbbd9c2, 0x0006c8fb9cae5c97,
+		    0x0004845c5ce1b7da, 0x0007e2e0e450b5cc },
+		  { 0x000575ed6701b430, 0x0004d3e17fa20026, 0x000791fc888c4253,
+		    0x0002f1ba99078ac1, 0x00071afa699b1115 } },
+		{ { 0x00023c1c473b50d6, 0x0003e7671de21d48, 0x000326fa5547a1e8,
+		    0x00050e4dc25fafd9, 0x00000731fbc78f89 },
+		  { 0x00066f9b3953b61d, 0x000555f4283cccb9, 0x0007dd67fb1960e7,
+		    0x00014707a1affed4, 0x000021142e9c2b1c },
+		  { 0x0000c71848f81880, 0x00044bd9d8233c86, 0x0006e8578efe5830,
+		    0x0004045b6d7041b5, 0x0004c4d6f3347e15 } },
+		{ { 0x0004ddfc988f1970, 0x0004f6173ea365e1, 0x000645daf9ae4588,
+		    0x0007d43763db623b, 0x00038bf9500a88f9 },
+		  { 0x0007eccfc17d1fc9, 0x0004ca280782831e, 0x0007b8337db1d7d6,
+		    0x0005116def3895fb, 0x000193fddaaa7e47 },
+		  { 0x0002c93c37e8876f, 0x0003431a28c583fa, 0x00049049da8bd879,
+		    0x0004b4a8407ac11c, 0x0006a6fb99ebf0d4 } },
+		{ { 0x000122b5b6e423c6, 0x00021e50dff1ddd6, 0x00073d76324e75c0,
+		    0x000588485495418e, 0x000136fda9f42c5e },
+		  { 0x0006c1bb560855eb, 0x00071f127e13ad48, 0x0005c6b304905aec,
+		    0x0003756b8e889bc7, 0x00075f76914a3189 },
+		  { 0x0004dfb1a305bdd1, 0x0003b3ff05811f29, 0x0006ed62283cd92e,
+		    0x00065d1543ec52e1, 0x000022183510be8d } },
+		{ { 0x0002710143307a7f, 0x0003d88fb48bf3ab, 0x000249eb4ec18f7a,
+		    0x000136115dff295f, 0x0001387c441fd404 },
+		  { 0x000766385ead2d14, 0x0000194f8b06095e, 0x00008478f6823b62,
+		    0x0006018689d37308, 0x0006a071ce17b806 },
+		  { 0x0003c3d187978af8, 0x0007afe1c88276ba, 0x00051df281c8ad68,
+		    0x00064906bda4245d, 0x0003171b26aaf1ed } },
+		{ { 0x0005b7d8b28a47d1, 0x0002c2ee149e34c1, 0x000776f5629afc53,
+		    0x0001f4ea50fc49a9, 0x0006c514a6334424 },
+		  { 0x0007319097564ca8, 0x0001844ebc233525, 0x00021d4543fdeee1,
+		    0x0001ad27aaff1bd2, 0x000221fd4873cf08 },
+		  { 0x0002204f3a156341, 0x000537414065a464, 0x00043c0c3bedcf83,
+		    0x0005557e706ea620, 0x00048daa596fb924 } },
+		{ { 0x00061d5dc84c9793, 0x00047de83040c29e, 0x000189deb26507e7,
+		    0x0004d4e6fadc479a, 0x00058c837fa0e8a7 },
+		  { 0x00028e665ca59cc7, 0x000165c715940dd9, 0x0000785f3aa11c95,
+		    0x00057b98d7e38469, 0x000676dd6fccad84 },
+		  { 0x0001688596fc9058, 0x00066f6ad403619f, 0x0004d759a87772ef,
+		    0x0007856e6173bea4, 0x0001c4f73f2c6a57 } },
+		{ { 0x0006706efc7c3484, 0x0006987839ec366d, 0x0000731f95cf7f26,
+		    0x0003ae758ebce4bc, 0x00070459adb7daf6 },
+		  { 0x00024fbd305fa0bb, 0x00040a98cc75a1cf, 0x00078ce1220a7533,
+		    0x0006217a10e1c197, 0x000795ac80d1bf64 },
+		  { 0x0001db4991b42bb3, 0x000469605b994372, 0x000631e3715c9a58,
+		    0x0007e9cfefcf728f, 0x0005fe162848ce21 } }
+	},
+	{
+		{ { 0x0001852d5d7cb208, 0x00060d0fbe5ce50f, 0x0005a1e246e37b75,
+		    0x00051aee05ffd590, 0x0002b44c043677da },
+		  { 0x0001214fe194961a, 0x0000e1ae39a9e9cb, 0x000543c8b526f9f7,
+		    0x000119498067e91d, 0x0004789d446fc917 },
+		  { 0x000487ab074eb78e, 0x0001d33b5e8ce343, 0x00013e419feb1b46,
+		    0x0002721f565de6a4, 0x00060c52eef2bb9a } },
+		{ { 0x0003c5c27cae6d11, 0x00036a9491956e05, 0x000124bac9131da6,
+		    0x0003b6f7de202b5d, 0x00070d77248d9b66 },
+		  { 0x000589bc3bfd8bf1, 0x0006f93e6aa3416b, 0x0004c0a3d6c1ae48,
+		    0x00055587260b586a, 0x00010bc9c312ccfc },
+		  { 0x0002e84b3ec2a05b, 0x00069da2f03c1551, 0x00023a174661a67b,
+		    0x000209bca289f238, 0x00063755bd3a976f } },
+		{ { 0x0007101897f1acb7, 0x0003d82cb77b07b8, 0x000684083d7769f5,
+		    0x00052b28472dce07, 0x0002763751737c52 },
+		  { 0x0007a03e2ad10853, 0x000213dcc6ad36ab, 0x0001a6e240d5bdd6,
+		    0x0007c24ffcf8fedf, 0x0000d8cc1c48bc16 },
+		  { 0x000402d36eb419a9, 0x0007cef68c14a052, 0x0000f1255bc2d139,
+		    0x000373e7d431186a, 0x00070c2dd8a7ad16 } },
+		{ { 0x0004967db8ed7e13, 0x00015aeed02f523a, 0x0006149591d094bc,
+		    0x000672f204c17006, 0x00032b8613816a53 },
+		  { 0x000194509f6fec0e, 0x000528d8ca31acac, 0x0007826d73b8b9fa,
+		    0x00024acb99e0f9b3, 0x0002e0fac6363948 },
+		  { 0x0007f7bee448cd64, 0x0004e10f10da0f3c, 0x0003936cb9ab20e9,
+		    0x0007a0fc4fea6cd0, 0x0004179215c735a4 } },
+		{ { 0x000633b9286bcd34, 0x0006cab3badb9c95, 0x00074e387edfbdfa,
+		    0x00014313c58a0fd9, 0x00031fa85662241c },
+		  { 0x000094e7d7dced2a, 0x000068fa738e118e, 0x00041b640a5fee2b,
+		    0x0006bb709df019d4, 0x000700344a30cd99 },
+		  { 0x00026c422e3622f4, 0x0000f3066a05b5f0, 0x0004e2448f0480a6,
+		    0x000244cde0dbf095, 0x00024bb2312a9952 } },
+		{ { 0x00000c2af5f85c6b, 0x0000609f4cf2883f, 0x0006e86eb5a1ca13,
+		    0x00068b44a2efccd1, 0x0000d1d2af9ffeb5 },
+		  { 0x0000ed1732de67c3, 0x000308c369291635, 0x00033ef348f2d250,
+		    0x000004475ea1a1bb, 0x0000fee3e871e188 },
+		  { 0x00028aa132621edf, 0x00042b244caf353b, 0x00066b064cc2e08a,
+		    0x0006bb20020cbdd3, 0x00016acd79718531 } },
+		{ { 0x0001c6c57887b6ad, 0x0005abf21fd7592b, 0x00050bd41253867a,
+		    0x0003800b71273151, 0x000164ed34b18161 },
+		  { 0x000772af2d9b1d3d, 0x0006d486448b4e5b, 0x0002ce58dd8d18a8,
+		    0x0001849f67503c8b, 0x000123e0ef6b9302 },
+		  { 0x0006d94c192fe69a, 0x0005475222a2690f, 0x000693789d86b8b3,
+		    0x0001f5c3bdfb69dc, 0x00078da0fc61073f } },
+		{ { 0x000780f1680c3a94, 0x0002a35d3cfcd453, 0x000005e5cdc7ddf8,
+		    0x0006ee888078ac24, 0x000054aa4b316b38 },
+		  { 0x00015d28e52bc66a, 0x00030e1e0351cb7e, 0x00030a2f74b11f8c,
+		    0x00039d120cd7de03, 0x0002d25deeb256b1 },
+		  { 0x0000468d19267cb8, 0x00038cdca9b5fbf9, 0x0001bbb05c2ca1e2,
+		    0x0003b015758e9533, 0x000134610a6ab7da } }
+	},
+	{
+		{ { 0x000265e777d1f515, 0x0000f1f54c1e39a5, 0x0002f01b95522646,
+		    0x0004fdd8db9dde6d, 0x000654878cba97cc },
+		  { 0x00038ec78df6b0fe, 0x00013caebea36a22, 0x0005ebc6e54e5f6a,
+		    0x00032804903d0eb8, 0x0002102fdba2b20d },
+		  { 0x0006e405055ce6a1, 0x0005024a35a532d3, 0x0001f69054daf29d,
+		    0x00015d1d0d7a8bd5, 0x0000ad725db29ecb } },
+		{ { 0x0007bc0c9b056f85, 0x00051cfebffaffd8, 0x00044abbe94df549,
+		    0x0007ecbbd7e33121, 0x0004f675f5302399 },
+		  { 0x000267b1834e2457, 0x0006ae19c378bb88, 0x0007457b5ed9d512,
+		    0x0003280d783d05fb, 0x0004aefcffb71a03 },
+		  { 0x000536360415171e, 0x0002313309077865, 0x000251444334afbc,
+		    0x0002b0c3853756e8, 0x0000bccbb72a2a86 } },
+		{ { 0x00055e4c50fe1296, 0x00005fdd13efc30d, 0x0001c0c6c380e5ee,
+		    0x0003e11de3fb62a8, 0x0006678fd69108f3 },
+		  { 0x0006962feab1a9c8, 0x0006aca28fb9a30b, 0x00056db7ca1b9f98,
+		    0x00039f58497018dd, 0x0004024f0ab59d6b },
+		  { 0x0006fa31636863c2, 0x00010ae5a67e42b0, 0x00027abbf01fda31,
+		    0x000380a7b9e64fbc, 0x0002d42e2108ead4 } },
+		{ { 0x00017b0d0f537593, 0x00016263c0c9842e, 0x0004ab827e4539a4,
+		    0x0006370ddb43d73a, 0x000420bf3a79b423 },
+		  { 0x0005131594dfd29b, 0x0003a627e98d52fe, 0x0001154041855661,
+		    0x00019175d09f8384, 0x000676b2608b8d2d },
+		  { 0x0000ba651c5b2b47, 0x0005862363701027, 0x0000c4d6c219c6db,
+		    0x0000f03dff8658de, 0x000745d2ffa9c0cf } },
+		{ { 0x0006df5721d34e6a, 0x0004f32f767a0c06, 0x0001d5abeac76e20,
+		    0x00041ce9e104e1e4, 0x00006e15be54c1dc },
+		  { 0x00025a1e2bc9c8bd, 0x000104c8f3b037ea, 0x000405576fa96c98,
+		    0x0002e86a88e3876f, 0x0001ae23ceb960cf },
+		  { 0x00025d871932994a, 0x0006b9d63b560b6e, 0x0002df2814c8d472,
+		    0x0000fbbee20aa4ed, 0x00058ded861278ec } },
+		{ { 0x00035ba8b6c2c9a8, 0x0001dea58b3185bf, 0x0004b455cd23bbbe,
+		    0x0005ec19c04883f8, 0x00008ba696b531d5 },
+		  { 0x00073793f266c55c, 0x0000b988a9c93b02, 0x00009b0ea32325db,
+		    0x00037cae71c17c5e, 0x0002ff39de85485f },
+		  { 0x00053eeec3efc57a, 0x0002fa9fe9022efd, 0x000699c72c138154,
+		    0x00072a751ebd1ff8, 0x000120633b4947cf } },
+		{ { 0x000531474912100a, 0x0005afcdf7c0d057, 0x0007a9e71b788ded,
+		    0x0005ef708f3b0c88, 0x00007433be3cb393 },
+		  { 0x0004987891610042, 0x00079d9d7f5d0172, 0x0003c293013b9ec4,
+		    0x0000c2b85f39caca, 0x00035d30a99b4d59 },
+		  { 0x000144c05ce997f4, 0x0004960b8a347fef, 0x0001da11f15d74f7,
+		    0x00054fac19c0fead, 0x0002d873ede7af6d } },
+		{ { 0x000202e14e5df981, 0x0002ea02bc3eb54c, 0x00038875b2883564,
+		    0x0001298c513ae9dd, 0x0000543618a01600 },
+		  { 0x0002316443373409, 0x0005de95503b22af, 0x000699201beae2df,
+		    0x0003db5849ff737a, 0x0002e773654707fa },
+		  { 0x0002bdf4974c23c1, 0x0004b3b9c8d261bd, 0x00026ae8b2a9bc28,
+		    0x0003068210165c51, 0x0004b1443362d079 } }
+	},
+	{
+		{ { 0x000454e91c529ccb, 0x00024c98c6bf72cf, 0x0000486594c3d89a,
+		    0x0007ae13a3d7fa3c, 0x00017038418eaf66 },
+		  { 0x0004b7c7b66e1f7a, 0x0004bea185efd998, 0x0004fabc711055f8,
+		    0x0001fb9f7836fe38, 0x000582f446752da6 },
+		  { 0x00017bd320324ce4, 0x00051489117898c6, 0x0001684d92a0410b,
+		    0x0006e4d90f78c5a7, 0x0000c2a1c4bcda28 } },
+		{ { 0x0004814869bd6945, 0x0007b7c391a45db8, 0x00057316ac35b641,
+		    0x000641e31de9096a, 0x0005a6a9b30a314d },
+		  { 0x0005c7d06f1f0447, 0x0007db70f80b3a49, 0x0006cb4a3ec89a78,
+		    0x00043be8ad81397d, 0x0007c558bd1c6f64 },
+		  { 0x00041524d396463d, 0x0001586b449e1a1d, 0x0002f17e904aed8a,
+		    0x0007e1d2861d3c8e, 0x0000404a5ca0afba } },
+		{ { 0x00049e1b2a416fd1, 0x00051c6a0b316c57, 0x000575a59ed71bdc,
+		    0x00074c021a1fec1e, 0x00039527516e7f8e },
+		  { 0x000740070aa743d6, 0x00016b64cbdd1183, 0x00023f4b7b32eb43,
+		    0x000319aba58235b3, 0x00046395bfdcadd9 },
+		  { 0x0007db2d1a5d9a9c, 0x00079a200b85422f, 0x000355bfaa71dd16,
+		    0x00000b77ea5f78aa, 0x00076579a29e822d } },
+		{ { 0x0004b51352b434f2, 0x0001327bd01c2667, 0x000434d73b60c8a1,
+		    0x0003e0daa89443ba, 0x00002c514bb2a277 },
+		  { 0x00068e7e49c02a17, 0x00045795346fe8b6, 0x000089306c8f3546,
+		    0x0006d89f6b2f88f6, 0x00043a384dc9e05b },
+		  { 0x0003d5da8bf1b645, 0x0007ded6a96a6d09, 0x0006c3494fee2f4d,
+		    0x00002c989c8b6bd4, 0x0001160920961548 } },
+		{ { 0x00005616369b4dcd, 0x0004ecab86ac6f47, 0x0003c60085d700b2,
+		    0x0000213ee10dfcea, 0x0002f637d7491e6e },
+		  { 0x0005166929dacfaa, 0x000190826b31f689, 0x0004f55567694a7d,
+		    0x000705f4f7b1e522, 0x000351e125bc5698 },
+		  { 0x00049b461af67bbe, 0x00075915712c3a96, 0x00069a67ef580c0d,
+		    0x00054d38ef70cffc, 0x0007f182d06e7ce2 } },
+		{ { 0x00054b728e217522, 0x00069a90971b0128, 0x00051a40f2a963a3,
+		    0x00010be9ac12a6bf, 0x00044acc043241c5 },
+		  { 0x00048e64ab0168ec, 0x0002a2bdb8a86f4f, 0x0007343b6b2d6929,
+		    0x0001d804aa8ce9a3, 0x00067d4ac8c343e9 },
+		  { 0x00056bbb4f7a5777, 0x00029230627c238f, 0x0005ad1a122cd7fb,
+		    0x0000dea56e50e364, 0x000556d1c8312ad7 } },
+		{ { 0x00006756b11be821, 0x000462147e7bb03e, 0x00026519743ebfe0,
+		    0x000782fc59682ab5, 0x000097abe38cc8c7 },
+		  { 0x000740e30c8d3982, 0x0007c2b47f4682fd, 0x0005cd91b8c7dc1c,
+		    0x00077fa790f9e583, 0x000746c6c6d1d824 },
+		  { 0x0001c9877ea52da4, 0x0002b37b83a86189, 0x000733af49310da5,
+		    0x00025e81161c04fb, 0x000577e14a34bee8 } },
+		{ { 0x0006cebebd4dd72b, 0x000340c1e442329f, 0x00032347ffd1a93f,
+		    0x00014a89252cbbe0, 0x000705304b8fb009 },
+		  { 0x000268ac61a73b0a, 0x000206f234bebe1c, 0x0005b403a7cbebe8,
+		    0x0007a160f09f4135, 0x00060fa7ee96fd78 },
+		  { 0x00051d354d296ec6, 0x0007cbf5a63b16c7, 0x0002f50bb3cf0c14,
+		    0x0001feb385cac65a, 0x00021398e0ca1635 } }
+	},
+	{
+		{ { 0x0000aaf9b4b75601, 0x00026b91b5ae44f3, 0x0006de808d7ab1c8,
+		    0x0006a769675530b0, 0x0001bbfb284e98f7 },
+		  { 0x0005058a382b33f3, 0x000175a91816913e, 0x0004f6cdb96b8ae8,
+		    0x00017347c9da81d2, 0x0005aa3ed9d95a23 },
+		  { 0x000777e9c7d96561, 0x00028e58f006ccac, 0x000541bbbb2cac49,
+		    0x0003e63282994cec, 0x0004a07e14e5e895 } },
+		{ { 0x000358cdc477a49b, 0x0003cc88fe02e481, 0x000721aab7f4e36b,
+		    0x0000408cc9469953, 0x00050af7aed84afa },
+		  { 0x000412cb980df999, 0x0005e78dd8ee29dc, 0x000171dff68c575d,
+		    0x0002015dd2f6ef49, 0x0003f0bac391d313 },
+		  { 0x0007de0115f65be5, 0x0004242c21364dc9, 0x0006b75b64a66098,
+		    0x0000033c0102c085, 0x0001921a316baebd } },
+		{ { 0x0002ad9ad9f3c18b, 0x0005ec1638339aeb, 0x0005703b6559a83b,
+		    0x0003fa9f4d05d612, 0x0007b049deca062c },
+		  { 0x00022f7edfb870fc, 0x000569eed677b128, 0x00030937dcb0a5af,
+		    0x000758039c78ea1b, 0x0006458df41e273a },
+		  { 0x0003e37a35444483, 0x000661fdb7d27b99, 0x000317761dd621e4,
+		    0x0007323c30026189, 0x0006093dccbc2950 } },
+		{ { 0x0006eebe6084034b, 0x0006cf01f70a8d7b, 0x0000b41a54c6670a,
+		    0x0006c84b99bb55db, 0x0006e3180c98b647 },
+		  { 0x00039a8585e0706d, 0x0003167ce72663fe, 0x00063d14ecdb4297,
+		    0x0004be21dcf970b8, 0x00057d1ea084827a },
+		  { 0x0002b6e7a128b071, 0x0005b27511755dcf, 0x00008584c2930565,
+		    0x00068c7bda6f4159, 0x000363e999ddd97b } },
+		{ { 0x000048dce24baec6, 0x0002b75795ec05e3, 0x0003bfa4c5da6dc9,
+		    0x0001aac8659e371e, 0x000231f979bc6f9b },
+		  { 0x000043c135ee1fc4, 0x0002a11c9919f2d5, 0x0006334cc25dbacd,
+		    0x000295da17b400da, 0x00048ee9b78693a0 },
+		  { 0x0001de4bcc2af3c6, 0x00061fc411a3eb86, 0x00053ed19ac12ec0,
+		    0x000209dbc6b804e0, 0x000079bfa9b08792 } },
+		{ { 0x0001ed80a2d54245, 0x00070efec72a5e79, 0x00042151d42a822d,
+		    0x0001b5ebb6d631e8, 0x0001ef4fb1594706 },
+		  { 0x00003a51da300df4, 0x000467b52b561c72, 0x0004d5920210e590,
+		    0x0000ca769e789685, 0x000038c77f684817 },
+		  { 0x00065ee65b167bec, 0x000052da19b850a9, 0x0000408665656429,
+		    0x0007ab39596f9a4c, 0x000575ee92a4a0bf } },
+		{ { 0x0006bc450aa4d801, 0x0004f4a6773b0ba8, 0x0006241b0b0ebc48,
+		    0x00040d9c4f1d9315, 0x000200a1e7e382f5 },
+		  { 0x000080908a182fcf, 0x0000532913b7ba98, 0x0003dccf78c385c3,
+		    0x00068002dd5eaba9, 0x00043d4e7112cd3f },
+		  { 0x0005b967eaf93ac5, 0x000360acca580a31, 0x0001c65fd5c6f262,
+		    0x00071c7f15c2ecab, 0x000050eca52651e4 } },
+		{ { 0x0004397660e668ea, 0x0007c2a75692f2f5, 0x0003b29e7e6c66ef,
+		    0x00072ba658bcda9a, 0x0006151c09fa131a },
+		  { 0x00031ade453f0c9c, 0x0003dfee07737868, 0x000611ecf7a7d411,
+		    0x0002637e6cbd64f6, 0x0004b0ee6c21c58f },
+		  { 0x00055c0dfdf05d96, 0x000405569dcf475e, 0x00005c5c277498bb,
+		    0x00018588d95dc389, 0x0001fef24fa800f0 } }
+	},
+	{
+		{ { 0x0002aff530976b86, 0x0000d85a48c0845a, 0x000796eb963642e0,
+		    0x00060bee50c4b626, 0x00028005fe6c8340 },
+		  { 0x000653fb1aa73196, 0x000607faec8306fa, 0x0004e85ec83e5254,
+		    0x00009f56900584fd, 0x000544d49292fc86 },
+		  { 0x0007ba9f34528688, 0x000284a20fb42d5d, 0x0003652cd9706ffe,
+		    0x0006fd7baddde6b3, 0x00072e472930f316 } },
+		{ { 0x0003f635d32a7627, 0x0000cbecacde00fe, 0x0003411141eaa936,
+		    0x00021c1e42f3cb94, 0x0001fee7f000fe06 },
+		  { 0x0005208c9781084f, 0x00016468a1dc24d2, 0x0007bf780ac540a8,
+		    0x0001a67eced75301, 0x0005a9d2e8c2733a },
+		  { 0x000305da03dbf7e5, 0x0001228699b7aeca, 0x00012a23b2936bc9,
+		    0x0002a1bda56ae6e9, 0x00000f94051ee040 } },
+		{ { 0x000793bb07af9753, 0x0001e7b6ecd4fafd, 0x00002c7b1560fb43,
+		    0x0002296734cc5fb7, 0x00047b7ffd25dd40 },
+		  { 0x00056b23c3d330b2, 0x00037608e360d1a6, 0x00010ae0f3c8722e,
+		    0x000086d9b618b637, 0x00007d79c7e8beab },
+		  { 0x0003fb9cbc08dd12, 0x00075c3dd85370ff, 0x00047f06fe2819ac,
+		    0x0005db06ab9215ed, 0x0001c3520a35ea64 } },
+		{ { 0x00006f40216bc059, 0x0003a2579b0fd9b5, 0x00071c26407eec8c,
+		    0x00072ada4ab54f0b, 0x00038750c3b66d12 },
+		  { 0x000253a6bccba34a, 0x000427070433701a, 0x00020b8e58f9870e,
+		    0x000337c861db00cc, 0x0001c3d05775d0ee },
+		  { 0x0006f1409422e51a, 0x0007856bbece2d25, 0x00013380a72f031c,
+		    0x00043e1080a7f3ba, 0x0000621e2c7d3304 } },
+		{ { 0x00061796b0dbf0f3, 0x00073c2f9c32d6f5, 0x0006aa8ed1537ebe,
+		    0x00074e92c91838f4, 0x0005d8e589ca1002 },
+		  { 0x000060cc8259838d, 0x000038d3f35b95f3, 0x00056078c243a923,
+		    0x0002de3293241bb2, 0x0000007d6097bd3a },
+		  { 0x00071d950842a94b, 0x00046b11e5c7d817, 0x0005478bbecb4f0d,
+		    0x0007c3054b0a1c5d, 0x0001583d7783c1cb } },
+		{ { 0x00034704cc9d28c7, 0x0003dee598b1f200, 0x00016e1c98746d9e,
+		    0x0004050b7095afdf, 0x0004958064e83c55 },
+		  { 0x0006a2ef5da27ae1, 0x00028aace02e9d9d, 0x00002459e965f0e8,
+		    0x0007b864d3150933, 0x000252a5f2e81ed8 },
+		  { 0x000094265066e80d, 0x0000a60f918d61a5, 0x0000444bf7f30fde,
+		    0x0001c40da9ed3c06, 0x000079c170bd843b } },
+		{ { 0x0006cd50c0d5d056, 0x0005b7606ae779ba, 0x00070fbd226bdda1,
+		    0x0005661e53391ff9, 0x0006768c0d7317b8 },
+		  { 0x0006ece464fa6fff, 0x0003cc40bca460a0, 0x0006e3a90afb8d0c,
+		    0x0005801abca11228, 0x0006dec05e34ac9f },
+		  { 0x000625e5f155c1b3, 0x0004f32f6f723296, 0x0005ac980105efce,
+		    0x00017a61165eee36, 0x00051445e14ddcd5 } },
+		{ { 0x000147ab2bbea455, 0x0001f240f2253126, 0x0000c3de9e314e89,
+		    0x00021ea5a4fca45f, 0x00012e990086e4fd },
+		  { 0x00002b4b3b144951, 0x0005688977966aea, 0x00018e176e399ffd,
+		    0x0002e45c5eb4938b, 0x00013186f31e3929 },
+		  { 0x000496b37fdfbb2e, 0x0003c2439d5f3e21, 0x00016e60fe7e6a4d,
+		    0x0004d7ef889b621d, 0x00077b2e3f05d3e9 } }
+	},
+	{
+		{ { 0x0000639c12ddb0a4, 0x0006180490cd7ab3, 0x0003f3918297467c,
+		    0x00074568be1781ac, 0x00007a195152e095 },
+		  { 0x0007a9c59c2ec4de, 0x0007e9f09e79652d, 0x0006a3e422f22d86,
+		    0x0002ae8e3b836c8b, 0x00063b795fc7ad32 },
+		  { 0x00068f02389e5fc8, 0x000059f1bc877506, 0x000504990e410cec,
+		    0x00009bd7d0feaee2, 0x0003e8fe83d032f0 } },
+		{ { 0x00004c8de8efd13c, 0x0001c67c06e6210e, 0x000183378f7f146a,
+		    0x00064352ceaed289, 0x00022d60899a6258 },
+		  { 0x000315b90570a294, 0x00060ce108a925f1, 0x0006eff61253c909,
+		    0x000003ef0e2d70b0, 0x00075ba3b797fac4 },
+		  { 0x0001dbc070cdd196, 0x00016d8fb1534c47, 0x000500498183fa2a,
+		    0x00072f59c423de75, 0x0000904d07b87779 } },
+		{ { 0x00022d6648f940b9, 0x000197a5a1873e86, 0x000207e4c41a54bc,
+		    0x0005360b3b4bd6d0, 0x0006240aacebaf72 },
+		  { 0x00061fd4ddba919c, 0x0007d8e991b55699, 0x00061b31473cc76c,
+		    0x0007039631e631d6, 0x00043e2143fbc1dd },
+		  { 0x0004749c5ba295a0, 0x00037946fa4b5f06, 0x000724c5ab5a51f1,
+		    0x00065633789dd3f3, 0x00056bdaf238db40 } },
+		{ { 0x0000d36cc19d3bb2, 0x0006ec4470d72262, 0x0006853d7018a9ae,
+		    0x0003aa3e4dc2c8eb, 0x00003aa31507e1e5 },
+		  { 0x0002b9e3f53533eb, 0x0002add727a806c5, 0x00056955c8ce15a3,
+		    0x00018c4f070a290e, 0x0001d24a86d83741 },
+		  { 0x00047648ffd4ce1f, 0x00060a9591839e9d, 0x000424d5f38117ab,
+		    0x00042cc46912c10e, 0x00043b261dc9aeb4 } },
+		{ { 0x00013d8b6c951364, 0x0004c0017e8f632a, 0x00053e559e53f9c4,
+		    0x0004b20146886eea, 0x00002b4d5e242940 },
+		  { 0x00031e1988bb79bb, 0x0007b82f46b3bcab, 0x0000f7a8ce827b41,
+		    0x0005e15816177130, 0x000326055cf5b276 },
+		  { 0x000155cb28d18df2, 0x0000c30d9ca11694, 0x0002090e27ab3119,
+		    0x000208624e7a49b6, 0x00027a6c809ae5d3 } },
+		{ { 0x0004270ac43d6954, 0x0002ed4cd95659a5, 0x00075c0db37528f9,
+		    0x0002ccbcfd2c9234, 0x000221503603d8c2 },
+		  { 0x0006ebcd1f0db188, 0x00074ceb4b7d1174, 0x0007d56168df4f5c,
+		    0x0000bf79176fd18a, 0x0002cb67174ff60a },
+		  { 0x0006cdf9390be1d0, 0x00008e519c7e2b3d, 0x000253c3d2a50881,
+		    0x00021b41448e333d, 0x0007b1df4b73890f } },
+		{ { 0x0006221807f8f58c, 0x0003fa92813a8be5, 0x0006da98c38d5572,
+		    0x00001ed95554468f, 0x00068698245d352e },
+		  { 0x0002f2e0b3b2a224, 0x0000c56aa22c1c92, 0x0005fdec39f1b278,
+		    0x0004c90af5c7f106, 0x00061fcef2658fc5 },
+		  { 0x00015d852a18187a, 0x000270dbb59afb76, 0x0007db120bcf92ab,
+		    0x0000e7a25d714087, 0x00046cf4c473daf0 } },
+		{ { 0x00046ea7f1498140, 0x00070725690a8427, 0x0000a73ae9f079fb,
+		    0x0002dd924461c62b, 0x0001065aae50d8cc },
+		  { 0x000525ed9ec4e5f9, 0x000022d20660684c, 0x0007972b70397b68,
+		    0x0007a03958d3f965, 0x00029387bcd14eb5 },
+		  { 0x00044525df200d57, 0x0002d7f94ce94385, 0x00060d00c170ecb7,
+		    0x00038b0503f3d8f0, 0x00069a198e64f1ce } }
+	},
+	{
+		{ { 0x00014434dcc5caed, 0x0002c7909f667c20, 0x00061a839d1fb576,
+		    0x0004f23800cabb76, 0x00025b2697bd267f },
+		  { 0x0002b2e0d91a78bc, 0x0003990a12ccf20c, 0x000141c2e11f2622,
+		    0x0000dfcefaa53320, 0x0007369e6a92493a },
+		  { 0x00073ffb13986864, 0x0003282bb8f713ac, 0x00049ced78f297ef,
+		    0x0006697027661def, 0x0001420683db54e4 } },
+		{ { 0x0006bb6fc1cc5ad0, 0x000532c8d591669d, 0x0001af794da86c33,
+		    0x0000e0e9d86d24d3, 0x00031e83b4161d08 },
+		  { 0x0000bd1e249dd197, 0x00000bcb1820568f, 0x0002eab1718830d4,
+		    0x000396fd816997e6, 0x00060b63bebf508a },
+		  { 0x0000c7129e062b4f, 0x0001e526415b12fd, 0x000461a0fd27923d,
+		    0x00018badf670a5b7, 0x00055cf1eb62d550 } },
+		{ { 0x0006b5e37df58c52, 0x0003bcf33986c60e, 0x00044fb8835ceae7,
+		    0x000099dec18e71a4, 0x0001a56fbaa62ba0 },
+		  { 0x0001101065c23d58, 0x0005aa1290338b0f, 0x0003157e9e2e7421,
+		    0x0000ea712017d489, 0x000669a656457089 },
+		  { 0x00066b505c9dc9ec, 0x000774ef86e35287, 0x0004d1d944c0955e,
+		    0x00052e4c39d72b20, 0x00013c4836799c58 } },
+		{ { 0x0004fb6a5d8bd080, 0x00058ae34908589b, 0x0003954d977baf13,
+		    0x000413ea597441dc, 0x00050bdc87dc8e5b },
+		  { 0x00025d465ab3e1b9, 0x0000f8fe27ec2847, 0x0002d6e6dbf04f06,
+		    0x0003038cfc1b3276, 0x00066f80c93a637b },
+		  { 0x000537836edfe111, 0x0002be02357b2c0d, 0x0006dcee58c8d4f8,
+		    0x0002d732581d6192, 0x0001dd56444725fd } },
+		{ { 0x0007e60008bac89a, 0x00023d5c387c1852, 0x00079e5df1f533a8,
+		    0x0002e6f9f1c5f0cf, 0x0003a3a450f63a30 },
+		  { 0x00047ff83362127d, 0x00008e39af82b1f4, 0x000488322ef27dab,
+		    0x0001973738a2a1a4, 0x0000e645912219f7 },
+		  { 0x00072f31d8394627, 0x00007bd294a200f1, 0x000665be00e274c6,
+		    0x00043de8f1b6368b, 0x000318c8d9393a9a } },
+		{ { 0x00069e29ab1dd398, 0x00030685b3c76bac, 0x000565cf37f24859,
+		    0x00057b2ac28efef9, 0x000509a41c325950 },
+		  { 0x00045d032afffe19, 0x00012fe49b6cde4e, 0x00021663bc327cf1,
+		    0x00018a5e4c69f1dd, 0x000224c7c679a1d5 },
+		  { 0x00006edca6f925e9, 0x00068c8363e677b8, 0x00060cfa25e4fbcf,
+		    0x0001c4c17609404e, 0x00005bff02328a11 } },
+		{ { 0x0001a0dd0dc512e4, 0x00010894bf5fcd10, 0x00052949013f9c37,
+		    0x0001f50fba4735c7, 0x000576277cdee01a },
+		  { 0x0002137023cae00b, 0x00015a3599eb26c6, 0x0000687221512b3c,
+		    0x000253cb3a0824e9, 0x000780b8cc3fa2a4 },
+		  { 0x00038abc234f305f, 0x0007a280bbc103de, 0x000398a836695dfe,
+		    0x0003d0af41528a1a, 0x0005ff418726271b } },
+		{ { 0x000347e813b69540, 0x00076864c21c3cbb, 0x0001e049dbcd74a8,
+		    0x0005b4d60f93749c, 0x00029d4db8ca0a0c },
+		  { 0x0006080c1789db9d, 0x0004be7cef1ea731, 0x0002f40d769d8080,
+		    0x00035f7d4c44a603, 0x000106a03dc25a96 },
+		  { 0x00050aaf333353d0, 0x0004b59a613cbb35, 0x000223dfc0e19a76,
+		    0x00077d1e2bb2c564, 0x0004ab38a51052cb } }
+	},
+	{
+		{ { 0x0007d1ef5fddc09c, 0x0007beeaebb9dad9, 0x000058d30ba0acfb,
+		    0x0005cd92eab5ae90, 0x0003041c6bb04ed2 },
+		  { 0x00042b256768d593, 0x0002e88459427b4f, 0x00002b3876630701,
+		    0x00034878d405eae5, 0x00029cdd1adc088a },
+		  { 0x0002f2f9d956e148, 0x0006b3e6ad65c1fe, 0x0005b00972b79e5d,
+		    0x00053d8d234c5daf, 0x000104bbd6814049 } },
+		{ { 0x00059a5fd67ff163, 0x0003a998ead0352b, 0x000083c95fa4af9a,
+		    0x0006fadbfc01266f, 0x000204f2a20fb072 },
+		  { 0x0000fd3168f1ed67, 0x0001bb0de7784a3e, 0x00034bcb78b20477,
+		    0x0000a4a26e2e2182, 0x0005be8cc57092a7 },
+		  { 0x00043b3d30ebb079, 0x000357aca5c61902, 0x0005b570c5d62455,
+		    0x00030fb29e1e18c7, 0x0002570fb17c2791 } },
+		{ { 0x0006a9550bb8245a, 0x000511f20a1a2325, 0x00029324d7239bee,
+		    0x0003343cc37516c4, 0x000241c5f91de018 },
+		  { 0x0002367f2cb61575, 0x0006c39ac04d87df, 0x0006d4958bd7e5bd,
+		    0x000566f4638a1532, 0x0003dcb65ea53030 },
+		  { 0x0000172940de6caa, 0x0006045b2e67451b, 0x00056c07463efcb3,
+		    0x0000728b6bfe6e91, 0x00008420edd5fcdf } },
+		{ { 0x0000c34e04f410ce, 0x000344edc0d0a06b, 0x0006e45486d84d6d,
+		    0x00044e2ecb3863f5, 0x00004d654f321db8 },
+		  { 0x000720ab8362fa4a, 0x00029c4347cdd9bf, 0x0000e798ad5f8463,
+		    0x0004fef18bcb0bfe, 0x0000d9a53efbc176 },
+		  { 0x0005c116ddbdb5d5, 0x0006d1b4bba5abcf, 0x0004d28a48a5537a,
+		    0x00056b8e5b040b99, 0x0004a7a4f2618991 } },
+		{ { 0x0003b291af372a4b, 0x00060e3028fe4498, 0x0002267bca4f6a09,
+		    0x000719eec242b243, 0x0004a96314223e0e },
+		  { 0x000718025fb15f95, 0x00068d6b8371fe94, 0x0003804448f7d97c,
+		    0x00042466fe784280, 0x00011b50c4cddd31 },
+		  { 0x0000274408a4ffd6, 0x0007d382aedb34dd, 0x00040acfc9ce385d,
+		    0x000628bb99a45b1e, 0x0004f4bce4dce6bc } },
+		{ { 0x0002616ec49d0b6f, 0x0001f95d8462e61c, 0x0001ad3e9b9159c6,
+		    0x00079ba475a04df9, 0x0003042cee561595 },
+		  { 0x0007ce5ae2242584, 0x0002d25eb153d4e3, 0x0003a8f3d09ba9c9,
+		    0x0000f3690d04eb8e, 0x00073fcdd14b71c0 },
+		  { 0x00067079449bac41, 0x0005b79c4621484f, 0x00061069f2156b8d,
+		    0x0000eb26573b10af, 0x000389e740c9a9ce } },
+		{ { 0x000578f6570eac28, 0x000644f2339c3937, 0x00066e47b7956c2c,
+		    0x00034832fe1f55d0, 0x00025c425e5d6263 },
+		  { 0x0004b3ae34dcb9ce, 0x00047c691a15ac9f, 0x000318e06e5d400c,
+		    0x0003c422d9f83eb1, 0x00061545379465a6 },
+		  { 0x000606a6f1d7de6e, 0x0004f1c0c46107e7, 0x000229b1dcfbe5d8,
+		    0x0003acc60a7b1327, 0x0006539a08915484 } },
+		{ { 0x0004dbd414bb4a19, 0x0007930849f1dbb8, 0x000329c5a466caf0,
+		    0x0006c824544feb9b, 0x0000f65320ef019b },
+		  { 0x00021f74c3d2f773, 0x000024b88d08bd3a, 0x0006e678cf054151,
+		    0x00043631272e747c, 0x00011c5e4aac5cd1 },
+		  { 0x0006d1b1cafde0c6, 0x000462c76a303a90, 0x0003ca4e693cff9b,
+		    0x0003952cd45786fd, 0x0004cabc7bdec330 } }
+	},
+	{
+		{ { 0x0007788f3f78d289, 0x0005942809b3f811, 0x0005973277f8c29c,
+		    0x000010f93bc5fe67, 0x0007ee498165acb2 },
+		  { 0x00069624089c0a2e, 0x0000075fc8e70473, 0x00013e84ab1d2313,
+		    0x0002c10bedf6953b, 0x000639b93f0321c8 },
+		  { 0x000508e39111a1c3, 0x000290120e912f7a, 0x0001cbf464acae43,
+		    0x00015373e9576157, 0x0000edf493c85b60 } },
+		{ { 0x0007c4d284764113, 0x0007fefebf06acec, 0x00039afb7a824100,
+		    0x0001b48e47e7fd65, 0x00004c00c54d1dfa },
+		  { 0x00048158599b5a68, 0x0001fd75bc41d5d9, 0x0002d9fc1fa95d3c,
+		    0x0007da27f20eba11, 0x000403b92e3019d4 },
+		  { 0x00022f818b465cf8, 0x000342901dff09b8, 0x00031f595dc683cd,
+		    0x00037a57745fd682, 0x000355bb12ab2617 } },
+		{ { 0x0001dac75a8c7318, 0x0003b679d5423460, 0x0006b8fcb7b6400e,
+		    0x0006c73783be5f9d, 0x0007518eaf8e052a },
+		  { 0x000664cc7493bbf4, 0x00033d94761874e3, 0x0000179e1796f613,
+		    0x0001890535e2867d, 0x0000f9b8132182ec },
+		  { 0x000059c41b7f6c32, 0x00079e8706531491, 0x0006c747643cb582,
+		    0x0002e20c0ad494e4, 0x00047c3871bbb175 } },
+		{ { 0x00065d50c85066b0, 0x0006167453361f7c, 0x00006ba3818bb312,
+		    0x0006aff29baa7522, 0x00008fea02ce8d48 },
+		  { 0x0004539771ec4f48, 0x0007b9318badca28, 0x00070f19afe016c5,
+		    0x0004ee7bb1608d23, 0x00000b89b8576469 },
+		  { 0x0005dd7668deead0, 0x0004096d0ba47049, 0x0006275997219114,
+		    0x00029bda8a67e6ae, 0x000473829a74f75d } },
+		{ { 0x0001533aad3902c9, 0x0001dde06b11e47b, 0x000784bed1930b77,
+		    0x0001c80a92b9c867, 0x0006c668b4d44e4d },
+		  { 0x0002da754679c418, 0x0003164c31be105a, 0x00011fac2b98ef5f,
+		    0x00035a1aaf779256, 0x0002078684c4833c },
+		  { 0x0000cf217a78820c, 0x00065024e7d2e769, 0x00023bb5efdda82a,
+		    0x00019fd4b632d3c6, 0x0007411a6054f8a4 } },
+		{ { 0x0002e53d18b175b4, 0x00033e7254204af3, 0x0003bcd7d5a1c4c5,
+		    0x0004c7c22af65d0f, 0x0001ec9a872458c3 },
+		  { 0x00059d32b99dc86d, 0x0006ac075e22a9ac, 0x00030b9220113371,
+		    0x00027fd9a638966e, 0x0007c136574fb813 },
+		  { 0x0006a4d400a2509b, 0x000041791056971c, 0x000655d5866e075c,
+		    0x0002302bf3e64df8, 0x0003add88a5c7cd6 } },
+		{ { 0x000298d459393046, 0x00030bfecb3d90b8, 0x0003d9b8ea3df8d6,
+		    0x0003900e96511579, 0x00061ba1131a406a },
+		  { 0x00015770b635dcf2, 0x00059ecd83f79571, 0x0002db461c0b7fbd,
+		    0x00073a42a981345f, 0x000249929fccc879 },
+		  { 0x0000a0f116959029, 0x0005974fd7b1347a, 0x0001e0cc1c08edad,
+		    0x000673bdf8ad1f13, 0x0005620310cbbd8e } },
+		{ { 0x0006b5f477e285d6, 0x0004ed91ec326cc8, 0x0006d6537503a3fd,
+		    0x000626d3763988d5, 0x0007ec846f3658ce },
+		  { 0x000193434934d643, 0x0000d4a2445eaa51, 0x0007d0708ae76fe0,
+		    0x00039847b6c3c7e1, 0x00037676a2a4d9d9 },
+		  { 0x00068f3f1da22ec7, 0x0006ed8039a2736b, 0x0002627ee04c3c75,
+		    0x0006ea90a647e7d1, 0x0006daaf723399b9 } }
+	},
+	{
+		{ { 0x000304bfacad8ea2, 0x000502917d108b07, 0x000043176ca6dd0f,
+		    0x0005d5158f2c1d84, 0x0002b5449e58eb3b },
+		  { 0x00027562eb3dbe47, 0x000291d7b4170be7, 0x0005d1ca67dfa8e1,
+		    0x0002a88061f298a2, 0x0001304e9e71627d },
+		  { 0x000014d26adc9cfe, 0x0007f1691ba16f13, 0x0005e71828f06eac,
+		    0x000349ed07f0fffc, 0x0004468de2d7c2dd } },
+		{ { 0x0002d8c6f86307ce, 0x0006286ba1850973, 0x0005e9dcb08444d4,
+		    0x0001a96a543362b2, 0x0005da6427e63247 },
+		  { 0x0003355e9419469e, 0x0001847bb8ea8a37, 0x0001fe6588cf9b71,
+		    0x0006b1c9d2db6b22, 0x0006cce7c6ffb44b },
+		  { 0x0004c688deac22ca, 0x0006f775c3ff0352, 0x000565603ee419bb,
+		    0x0006544456c61c46, 0x00058f29abfe79f2 } },
+		{ { 0x000264bf710ecdf6, 0x000708c58527896b, 0x00042ceae6c53394,
+		    0x0004381b21e82b6a, 0x0006af93724185b4 },
+		  { 0x0006cfab8de73e68, 0x0003e6efced4bd21, 0x0000056609500dbe,
+		    0x00071b7824ad85df, 0x000577629c4a7f41 },
+		  { 0x0000024509c6a888, 0x0002696ab12e6644, 0x0000cca27f4b80d8,
+		    0x0000c7c1f11b119e, 0x000701f25bb0caec } },
+		{ { 0x0000f6d97cbec113, 0x0004ce97fb7c93a3, 0x000139835a11281b,
+		    0x000728907ada9156, 0x000720a5bc050955 },
+		  { 0x0000b0f8e4616ced, 0x0001d3c4b50fb875, 0x0002f29673dc0198,
+		    0x0005f4b0f1830ffa, 0x0002e0c92bfbdc40 },
+		  { 0x000709439b805a35, 0x0006ec48557f8187, 0x00008a4d1ba13a2c,
+		    0x000076348a0bf9ae, 0x0000e9b9cbb144ef } },
+		{ { 0x00069bd55db1beee, 0x0006e14e47f731bd, 0x0001a35e47270eac,
+		    0x00066f225478df8e, 0x000366d44191cfd3 },
+		  { 0x0002d48ffb5720ad, 0x00057b7f21a1df77, 0x0005550effba0645,
+		    0x0005ec6a4098a931, 0x000221104eb3f337 },
+		  { 0x00041743f2bc8c14, 0x000796b0ad8773c7, 0x00029fee5cbb689b,
+		    0x000122665c178734, 0x0004167a4e6bc593 } },
+		{ { 0x00062665f8ce8fee, 0x00029d101ac59857, 0x0004d93bbba59ffc,
+		    0x00017b7897373f17, 0x00034b33370cb7ed },
+		  { 0x00039d2876f62700, 0x000001cecd1d6c87, 0x0007f01a11747675,
+		    0x0002350da5a18190, 0x0007938bb7e22552 },
+		  { 0x000591ee8681d6cc, 0x00039db0b4ea79b8, 0x000202220f380842,
+		    0x0002f276ba42e0ac, 0x0001176fc6e2dfe6 } },
+		{ { 0x0000e28949770eb8, 0x0005559e88147b72, 0x00035e1e6e63ef30,
+		    0x00035b109aa7ff6f, 0x0001f6a3e54f2690 },
+		  { 0x00076cd05b9c619b, 0x00069654b0901695, 0x0007a53710b77f27,
+		    0x00079a1ea7d28175, 0x00008fc3a4c677d5 },
+		  { 0x0004c199d30734ea, 0x0006c622cb9acc14, 0x0005660a55030216,
+		    0x000068f1199f11fb, 0x0004f2fad0116b90 } },
+		{ { 0x0004d91db73bb638, 0x00055f82538112c5, 0x0006d85a279815de,
+		    0x000740b7b0cd9cf9, 0x0003451995f2944e },
+		  { 0x0006b24194ae4e54, 0x0002230afded8897, 0x00023412617d5071,
+		    0x0003d5d30f35969b, 0x000445484a4972ef },
+		  { 0x0002fcd09fea7d7c, 0x000296126b9ed22a, 0x0004a171012a05b2,
+		    0x0001db92c74d5523, 0x00010b89ca604289 } }
+	},
+	{
+		{ { 0x000141be5a45f06e, 0x0005adb38becaea7, 0x0003fd46db41f2bb,
+		    0x0006d488bbb5ce39, 0x00017d2d1d9ef0d4 },
+		  { 0x000147499718289c, 0x0000a48a67e4c7ab, 0x00030fbc544bafe3,
+		    0x0000c701315fe58a, 0x00020b878d577b75 },
+		  { 0x0002af18073f3e6a, 0x00033aea420d24fe, 0x000298008bf4ff94,
+		    0x0003539171db961e, 0x00072214f63cc65c } },
+		{ { 0x0005b7b9f43b29c9, 0x000149ea31eea3b3, 0x0004be7713581609,
+		    0x0002d87960395e98, 0x0001f24ac855a154 },
+		  { 0x00037f405307a693, 0x0002e5e66cf2b69c, 0x0005d84266ae9c53,
+		    0x0005e4eb7de853b9, 0x0005fdf48c58171c },
+		  { 0x000608328e9505aa, 0x00022182841dc49a, 0x0003ec96891d2307,
+		    0x0002f363fff22e03, 0x00000ba739e2ae39 } },
+		{ { 0x000426f5ea88bb26, 0x00033092e77f75c8, 0x0001a53940d819e7,
+		    0x0001132e4f818613, 0x00072297de7d518d },
+		  { 0x000698de5c8790d6, 0x000268b8545beb25, 0x0006d2648b96fedf,
+		    0x00047988ad1db07c, 0x00003283a3e67ad7 },
+		  { 0x00041dc7be0cb939, 0x0001b16c66100904, 0x0000a24c20cbc66d,
+		    0x0004a2e9efe48681, 0x00005e1296846271 } },
+		{ { 0x0007bbc8242c4550, 0x00059a06103b35b7, 0x0007237e4af32033,
+		    0x000726421ab3537a, 0x00078cf25d38258c },
+		  { 0x0002eeb32d9c495a, 0x00079e25772f9750, 0x0006d747833bbf23,
+		    0x0006cdd816d5d749, 0x00039c00c9c13698 },
+		  { 0x00066b8e31489d68, 0x000573857e10e2b5, 0x00013be816aa1472,
+		    0x00041964d3ad4bf8, 0x000006b52076b3ff } },
+		{ { 0x00037e16b9ce082d, 0x0001882f57853eb9, 0x0007d29eacd01fc5,
+		    0x0002e76a59b5e715, 0x0007de2e9561a9f7 },
+		  { 0x0000cfe19d95781c, 0x000312cc621c453c, 0x000145ace6da077c,
+		    0x0000912bef9ce9b8, 0x0004d57e3443bc76 },
+		  { 0x0000d4f4b6a55ecb, 0x0007ebb0bb733bce, 0x0007ba6a05200549,
+		    0x0004f6ede4e22069, 0x0006b2a90af1a602 } },
+		{ { 0x0003f3245bb2d80a, 0x0000e5f720f36efd, 0x0003b9cccf60c06d,
+		    0x000084e323f37926, 0x000465812c8276c2 },
+		  { 0x0003f4fc9ae61e97, 0x0003bc07ebfa2d24, 0x0003b744b55cd4a0,
+		    0x00072553b25721f3, 0x0005fd8f4e9d12d3 },
+		  { 0x0003beb22a1062d9, 0x0006a7063b82c9a8, 0x0000a5a35dc197ed,
+		    0x0003c80c06a53def, 0x00005b32c2b1cb16 } },
+		{ { 0x0004a42c7ad58195, 0x0005c8667e799eff, 0x00002e5e74c850a1,
+		    0x0003f0db614e869a, 0x00031771a4856730 },
+		  { 0x00005eccd24da8fd, 0x000580bbfdf07918, 0x0007e73586873c6a,
+		    0x00074ceddf77f93e, 0x0003b5556a37b471 },
+		  { 0x0000c524e14dd482, 0x000283457496c656, 0x0000ad6bcfb6cd45,
+		    0x000375d1e8b02414, 0x0004fc079d27a733 } },
+		{ { 0x00048b440c86c50d, 0x000139929cca3b86, 0x0000f8f2e44cdf2f,
+		    0x00068432117ba6b2, 0x000241170c2bae3c },
+		  { 0x000138b089bf2f7f, 0x0004a05bfd34ea39, 0x000203914c925ef5,
+		    0x0007497fffe04e3c, 0x000124567cecaf98 },
+		  { 0x0001ab860ac473b4, 0x0005c0227c86a7ff, 0x00071b12bfc24477,
+		    0x000006a573a83075, 0x0003f8612966c870 } }
+	},
+	{
+		{ { 0x0000fcfa36048d13, 0x00066e7133bbb383, 0x00064b42a8a45676,
+		    0x0004ea6e4f9a85cf, 0x00026f57eee878a1 },
+		  { 0x00020cc9782a0dde, 0x00065d4e3070aab3, 0x0007bc8e31547736,
+		    0x00009ebfb1432d98, 0x000504aa77679736 },
+		  { 0x00032cd55687efb1, 0x0004448f5e2f6195, 0x000568919d460345,
+		    0x000034c2e0ad1a27, 0x0004041943d9dba3 } },
+		{ { 0x00017743a26caadd, 0x00048c9156f9c964, 0x0007ef278d1e9ad0,
+		    0x00000ce58ea7bd01, 0x00012d931429800d },
+		  { 0x0000eeba43ebcc96, 0x000384dd5395f878, 0x0001df331a35d272,
+		    0x000207ecfd4af70e, 0x0001420a1d976843 },
+		  { 0x00067799d337594f, 0x00001647548f6018, 0x00057fce5578f145,
+		    0x000009220c142a71, 0x0001b4f92314359a } },
+		{ { 0x00073030a49866b1, 0x0002442be90b2679, 0x00077bd3d8947dcf,
+		    0x0001fb55c1552028, 0x0005ff191d56f9a2 },
+		  { 0x0004109d89150951, 0x000225bd2d2d47cb, 0x00057cc080e73bea,
+		    0x0006d71075721fcb, 0x000239b572a7f132 },
+		  { 0x0006d433ac2d9068, 0x00072bf930a47033, 0x00064facf4a20ead,
+		    0x000365f7a2b9402a, 0x000020c526a758f3 } },
+		{ { 0x0001ef59f042cc89, 0x0003b1c24976dd26, 0x00031d665cb16272,
+		    0x00028656e470c557, 0x000452cfe0a5602c },
+		  { 0x000034f89ed8dbbc, 0x00073b8f948d8ef3, 0x000786c1d323caab,
+		    0x00043bd4a9266e51, 0x00002aacc4615313 },
+		  { 0x0000f7a0647877df, 0x0004e1cc0f93f0d4, 0x0007ec4726ef1190,
+		    0x0003bdd58bf512f8, 0x0004cfb7d7b304b8 } },
+		{ { 0x000699c29789ef12, 0x00063beae321bc50, 0x000325c340adbb35,
+		    0x000562e1a1e42bf6, 0x0005b1d4cbc434d3 },
+		  { 0x00043d6cb89b75fe, 0x0003338d5b900e56, 0x00038d327d531a53,
+		    0x0001b25c61d51b9f, 0x00014b4622b39075 },
+		  { 0x00032615cc0a9f26, 0x00057711b99cb6df, 0x0005a69c14e93c38,
+		    0x0006e88980a4c599, 0x0002f98f71258592 } },
+		{ { 0x0002ae444f54a701, 0x000615397afbc5c2, 0x00060d7783f3f8fb,
+		    0x0002aa675fc486ba, 0x0001d8062e9e7614 },
+		  { 0x0004a74cb50f9e56, 0x000531d1c2640192, 0x0000c03d9d6c7fd2,
+		    0x00057ccd156610c1, 0x0003a6ae249d806a },
+		  { 0x0002da85a9907c5a, 0x0006b23721ec4caf, 0x0004d2d3a4683aa2,
+		    0x0007f9c6870efdef, 0x000298b8ce8aef25 } },
+		{ { 0x000272ea0a2165de, 0x00068179ef3ed06f, 0x0004e2b9c0feac1e,
+		    0x0003ee290b1b63bb, 0x0006ba6271803a7d },
+		  { 0x00027953eff70cb2, 0x00054f22ae0ec552, 0x00029f3da92e2724,
+		    0x000242ca0c22bd18, 0x00034b8a8404d5ce },
+		  { 0x0006ecb583693335, 0x0003ec76bfdfb84d, 0x0002c895cf56a04f,
+		    0x0006355149d54d52, 0x00071d62bdd465e1 } },
+		{ { 0x0005b5dab1f75ef5, 0x0001e2d60cbeb9a5, 0x000527c2175dfe57,
+		    0x00059e8a2b8ff51f, 0x0001c333621262b2 },
+		  { 0x0003cc28d378df80, 0x00072141f4968ca6, 0x000407696bdb6d0d,
+		    0x0005d271b22ffcfb, 0x00074d5f317f3172 },
+		  { 0x0007e55467d9ca81, 0x0006a5653186f50d, 0x0006b188ece62df1,
+		    0x0004c66d36844971, 0x0004aebcc4547e9d } }
+	},
+	{
+		{ { 0x00008d9e7354b610, 0x00026b750b6dc168, 0x000162881e01acc9,
+		    0x0007966df31d01a5, 0x000173bd9ddc9a1d },
+		  { 0x0000071b276d01c9, 0x0000b0d8918e025e, 0x00075beea79ee2eb,
+		    0x0003c92984094db8, 0x0005d88fbf95a3db },
+		  { 0x00000f1efe5872df, 0x0005da872318256a, 0x00059ceb81635960,
+		    0x00018cf37693c764, 0x00006e1cd13b19ea } },
+		{ { 0x0003af629e5b0353, 0x000204f1a088e8e5, 0x00010efc9ceea82e,
+		    0x000589863c2fa34b, 0x0007f3a6a1a8d837 },
+		  { 0x0000ad516f166f23, 0x000263f56d57c81a, 0x00013422384638ca,
+		    0x0001331ff1af0a50, 0x0003080603526e16 },
+		  { 0x000644395d3d800b, 0x0002b9203dbedefc, 0x0004b18ce656a355,
+		    0x00003f3466bc182c, 0x00030d0fded2e513 } },
+		{ { 0x0004971e68b84750, 0x00052ccc9779f396, 0x0003e904ae8255c8,
+		    0x0004ecae46f39339, 0x0004615084351c58 },
+		  { 0x00014d1af21233b3, 0x0001de1989b39c0b, 0x00052669dc6f6f9e,
+		    0x00043434b28c3fc7, 0x0000a9214202c099 },
+		  { 0x000019c0aeb9a02e, 0x0001a2c06995d792, 0x000664cbb1571c44,
+		    0x0006ff0736fa80b2, 0x0003bca0d2895ca5 } },
+		{ { 0x00008eb69ecc01bf, 0x0005b4c8912df38d, 0x0005ea7f8bc2f20e,
+		    0x000120e516caafaf, 0x0004ea8b4038df28 },
+		  { 0x000031bc3c5d62a4, 0x0007d9fe0f4c081e, 0x00043ed51467f22c,
+		    0x0001e6cc0c1ed109, 0x0005631deddae8f1 },
+		  { 0x0005460af1cad202, 0x0000b4919dd0655d, 0x0007c4697d18c14c,
+		    0x000231c890bba2a4, 0x00024ce0930542ca } },
+		{ { 0x0007a155fdf30b85, 0x0001c6c6e5d487f9, 0x00024be1134bdc5a,
+		    0x0001405970326f32, 0x000549928a7324f4 },
+		  { 0x000090f5fd06c106, 0x0006abb1021e43fd, 0x000232bcfad711a0,
+		    0x0003a5c13c047f37, 0x00041d4e3c28a06d },
+		  { 0x000632a763ee1a2e, 0x0006fa4bffbd5e4d, 0x0005fd35a6ba4792,
+		    0x0007b55e1de99de8, 0x000491b66dec0dcf } },
+		{ { 0x00004a8ed0da64a1, 0x0005ecfc45096ebe, 0x0005edee93b488b2,
+		    0x0005b3c11a51bc8f, 0x0004cf6b8b0b7018 },
+		  { 0x0005b13dc7ea32a7, 0x00018fc2db73131e, 0x0007e3651f8f57e3,
+		    0x00025656055fa965, 0x00008f338d0c85ee },
+		  { 0x0003a821991a73bd, 0x00003be6418f5870, 0x0001ddc18eac9ef0,
+		    0x00054ce09e998dc2, 0x000530d4a82eb078 } },
+		{ { 0x000173456c9abf9e, 0x0007892015100dad, 0x00033ee14095fecb,
+		    0x0006ad95d67a0964, 0x0000db3e7e00cbfb },
+		  { 0x00043630e1f94825, 0x0004d1956a6b4009, 0x000213fe2df8b5e0,
+		    0x00005ce3a41191e6, 0x00065ea753f10177 },
+		  { 0x0006fc3ee2096363, 0x0007ec36b96d67ac, 0x000510ec6a0758b1,
+		    0x0000ed87df022109, 0x00002a4ec1921e1a } },
+		{ { 0x00006162f1cf795f, 0x000324ddcafe5eb9, 0x000018d5e0463218,
+		    0x0007e78b9092428e, 0x00036d12b5dec067 },
+		  { 0x0006259a3b24b8a2, 0x000188b5f4170b9c, 0x000681c0dee15deb,
+		    0x0004dfe665f37445, 0x0003d143c5112780 },
+		  { 0x0005279179154557, 0x00039f8f0741424d, 0x00045e6eb357923d,
+		    0x00042c9b5edb746f, 0x0002ef517885ba82 } }
+	},
+	{
+		{ { 0x0006bffb305b2f51, 0x0005b112b2d712dd, 0x00035774974fe4e2,
+		    0x00004af87a96e3a3, 0x00057968290bb3a0 },
+		  { 0x0007974e8c58aedc, 0x0007757e083488c6, 0x000601c62ae7bc8b,
+		    0x00045370c2ecab74, 0x0002f1b78fab143a },
+		  { 0x0002b8430a20e101, 0x0001a49e1d88fee3, 0x00038bbb47ce4d96,
+		    0x0001f0e7ba84d437, 0x0007dc43e35dc2aa } },
+		{ { 0x00002a5c273e9718, 0x00032bc9dfb28b4f, 0x00048df4f8d5db1a,
+		    0x00054c87976c028f, 0x000044fb81d82d50 },
+		  { 0x00066665887dd9c3, 0x000629760a6ab0b2, 0x000481e6c7243e6c,
+		    0x000097e37046fc77, 0x0007ef72016758cc },
+		  { 0x000718c5a907e3d9, 0x0003b9c98c6b383b, 0x000006ed255eccdc,
+		    0x0006976538229a59, 0x0007f79823f9c30d } },
+		{ { 0x00041ff068f587ba, 0x0001c00a191bcd53, 0x0007b56f9c209e25,
+		    0x0003781e5fccaabe, 0x00064a9b0431c06d },
+		  { 0x0004d239a3b513e8, 0x00029723f51b1066, 0x000642f4cf04d9c3,
+		    0x0004da095aa09b7a, 0x0000a4e0373d784d },
+		  { 0x0003d6a15b7d2919, 0x00041aa75046a5d6, 0x000691751ec2d3da,
+		    0x00023638ab6721c4, 0x000071a7d0ace183 } },
+		{ { 0x0004355220e14431, 0x0000e1362a283981, 0x0002757cd8359654,
+		    0x0002e9cd7ab10d90, 0x0007c69bcf761775 },
+		  { 0x00072daac887ba0b, 0x0000b7f4ac5dda60, 0x0003bdda2c0498a4,
+		    0x00074e67aa180160, 0x0002c3bcc7146ea7 },
+		  { 0x0000d7eb04e8295f, 0x0004a5ea1e6fa0fe, 0x00045e635c436c60,
+		    0x00028ef4a8d4d18b, 0x0006f5a9a7322aca } },
+		{ { 0x0001d4eba3d944be, 0x0000100f15f3dce5, 0x00061a700e367825,
+		    0x0005922292ab3d23, 0x00002ab9680ee8d3 },
+		  { 0x0001000c2f41c6c5, 0x0000219fdf737174, 0x000314727f127de7,
+		    0x0007e5277d23b81e, 0x000494e21a2e147a },
+		  { 0x00048a85dde50d9a, 0x0001c1f734493df4, 0x00047bdb64866889,
+		    0x00059a7d048f8eec, 0x0006b5d76cbea46b } },
+		{ { 0x000141171e782522, 0x0006806d26da7c1f, 0x0003f31d1bc79ab9,
+		    0x00009f20459f5168, 0x00016fb869c03dd3 },
+		  { 0x0007556cec0cd994, 0x0005eb9a03b7510a, 0x00050ad1dd91cb71,
+		    0x0001aa5780b48a47, 0x0000ae333f685277 },
+		  { 0x0006199733b60962, 0x00069b157c266511, 0x00064740f893f1ca,
+		    0x00003aa408fbf684, 0x0003f81e38b8f70d } },
+		{ { 0x00037f355f17c824, 0x00007ae85334815b, 0x0007e3abddd2e48f,
+		    0x00061eeabe1f45e5, 0x0000ad3e2d34cded },
+		  { 0x00010fcc7ed9affe, 0x0004248cb0e96ff2, 0x0004311c115172e2,
+		    0x0004c9d41cbf6925, 0x00050510fc104f50 },
+		  { 0x00040fc5336e249d, 0x0003386639fb2de1, 0x0007bbf871d17b78,
+		    0x00075f796b7e8004, 0x000127c158bf0fa1 } },
+		{ { 0x00028fc4ae51b974, 0x00026e89bfd2dbd4, 0x0004e122a07665cf,
+		    0x0007cab1203405c3, 0x0004ed82479d167d },
+		  { 0x00017c422e9879a2, 0x00028a5946c8fec3, 0x00053ab32e912b77,
+		    0x0007b44da09fe0a5, 0x000354ef87d07ef4 },
+		  { 0x0003b52260c5d975, 0x00079d6836171fdc, 0x0007d994f140d4bb,
+		    0x0001b6c404561854, 0x000302d92d205392 } }
+	},
+	{
+		{ { 0x00046fb6e4e0f177, 0x00053497ad5265b7, 0x0001ebdba01386fc,
+		    0x0000302f0cb36a3c, 0x0000edc5f5eb426d },
+		  { 0x0003c1a2bca4283d, 0x00023430c7bb2f02, 0x0001a3ea1bb58bc2,
+		    0x0007265763de5c61, 0x00010e5d3b76f1ca },
+		  { 0x0003bfd653da8e67, 0x000584953ec82a8a, 0x00055e288fa7707b,
+		    0x0005395fc3931d81, 0x00045b46c51361cb } },
+		{ { 0x00054ddd8a7fe3e4, 0x0002cecc41c619d3, 0x00043a6562ac4d91,
+		    0x0004efa5aca7bdd9, 0x0005c1c0aef32122 },
+		  { 0x00002abf314f7fa1, 0x000391d19e8a1528, 0x0006a2fa13895fc7,
+		    0x00009d8eddeaa591, 0x0002177bfa36dcb7 },
+		  { 0x00001bbcfa79db8f, 0x0003d84beb3666e1, 0x00020c921d812204,
+		    0x0002dd843d3b32ce, 0x0004ae619387d8ab } },
+		{ { 0x00017e44985bfb83, 0x00054e32c626cc22, 0x000096412ff38118,
+		    0x0006b241d61a246a, 0x00075685abe5ba43 },
+		  { 0x0003f6aa5344a32e, 0x00069683680f11bb, 0x00004c3581f623aa,
+		    0x000701af5875cba5, 0x0001a00d91b17bf3 },
+		  { 0x00060933eb61f2b2, 0x0005193fe92a4dd2, 0x0003d995a550f43e,
+		    0x0003556fb93a883d, 0x000135529b623b0e } },
+		{ { 0x000716bce22e83fe, 0x00033d0130b83eb8, 0x0000952abad0afac,
+		    0x000309f64ed31b8a, 0x0005972ea051590a },
+		  { 0x0000dbd7add1d518, 0x000119f823e2231e, 0x000451d66e5e7de2,
+		    0x000500c39970f838, 0x00079b5b81a65ca3 },
+		  { 0x0004ac20dc8f7811, 0x00029589a9f501fa, 0x0004d810d26a6b4a,
+		    0x0005ede00d96b259, 0x0004f7e9c95905f3 } },
+		{ { 0x0000443d355299fe, 0x00039b7d7d5aee39, 0x000692519a2f34ec,
+		    0x0006e4404924cf78, 0x0001942eec4a144a },
+		  { 0x00074bbc5781302e, 0x00073135bb81ec4c, 0x0007ef671b61483c,
+		    0x0007264614ccd729, 0x00031993ad92e638 },
+		  { 0x00045319ae234992, 0x0002219d47d24fb5, 0x0004f04488b06cf6,
+		    0x00053aaa9e724a12, 0x0002a0a65314ef9c } },
+		{ { 0x00061acd3c1c793a, 0x00058b46b78779e6, 0x0003369aacbe7af2,
+		    0x000509b0743074d4, 0x000055dc39b6dea1 },
+		  { 0x0007937ff7f927c2, 0x0000c2fa14c6a5b6, 0x000556bddb6dd07c,
+		    0x0006f6acc179d108, 0x0004cf6e218647c2 },
+		  { 0x0001227cc28d5bb6, 0x00078ee9bff57623, 0x00028cb2241f893a,
+		    0x00025b541e3c6772, 0x000121a307710aa2 } },
+		{ { 0x0001713ec77483c9, 0x0006f70572d5facb, 0x00025ef34e22ff81,
+		    0x00054d944f141188, 0x000527bb94a6ced3 },
+		  { 0x00035d5e9f034a97, 0x000126069785bc9b, 0x0005474ec7854ff0,
+		    0x000296a302a348ca, 0x000333fc76c7a40e },
+		  { 0x0005992a995b482e, 0x00078dc707002ac7, 0x0005936394d01741,
+		    0x0004fba4281aef17, 0x0006b89069b20a7a } },
+		{ { 0x0002fa8cb5c7db77, 0x000718e6982aa810, 0x00039e95f81a1a1b,
+		    0x0005e794f3646cfb, 0x0000473d308a7639 },
+		  { 0x0002a0416270220d, 0x00075f248b69d025, 0x0001cbbc16656a27,
+		    0x0005b9ffd6e26728, 0x00023bc2103aa73e },
+		  { 0x0006792603589e05, 0x000248db9892595d, 0x000006a53cad2d08,
+		    0x00020d0150f7ba73, 0x000102f73bfde043 } }
+	},
+	{
+		{ { 0x0004dae0b5511c9a, 0x0005257fffe0d456, 0x00054108d1eb2180,
+		    0x000096cc0f9baefa, 0x0003f6bd725da4ea },
+		  { 0x0000b9ab7f5745c6, 0x0005caf0f8d21d63, 0x0007debea408ea2b,
+		    0x00009edb93896d16, 0x00036597d25ea5c0 },
+		  { 0x00058d7b106058ac, 0x0003cdf8d20bee69, 0x00000a4cb765015e,
+		    0x00036832337c7cc9, 0x0007b7ecc19da60d } },
+		{ { 0x00064a51a77cfa9b, 0x00029cf470ca0db5, 0x0004b60b6e0898d9,
+		    0x00055d04ddffe6c7, 0x00003bedc661bf5c },
+		  { 0x0002373c695c690d, 0x0004c0c8520dcf18, 0x000384af4b7494b9,
+		    0x0004ab4a8ea22225, 0x0004235ad7601743 },
+		  { 0x0000cb0d078975f5, 0x000292313e530c4b, 0x00038dbb9124a509,
+		    0x000350d0655a11f1, 0x0000e7ce2b0cdf06 } },
+		{ { 0x0006fedfd94b70f9, 0x0002383f9745bfd4, 0x0004beae27c4c301,
+		    0x00075aa4416a3f3f, 0x000615256138aece },
+		  { 0x0004643ac48c85a3, 0x0006878c2735b892, 0x0003a53523f4d877,
+		    0x0003a504ed8bee9d, 0x000666e0a5d8fb46 },
+		  { 0x0003f64e4870cb0d, 0x00061548b16d6557, 0x0007a261773596f3,
+		    0x0007724d5f275d3a, 0x0007f0bc810d514d } },
+		{ { 0x00049dad737213a0, 0x000745dee5d31075, 0x0007b1a55e7fdbe2,
+		    0x0005ba988f176ea1, 0x0001d3a907ddec5a },
+		  { 0x00006ba426f4136f, 0x0003cafc0606b720, 0x000518f0a2359cda,
+		    0x0005fae5e46feca7, 0x0000d1f8dbcf8eed },
+		  { 0x000693313ed081dc, 0x0005b0a366901742, 0x00040c872ca4ca7e,
+		    0x0006f18094009e01, 0x00000011b44a31bf } },
+		{ { 0x00061f696a0aa75c, 0x00038b0a57ad42ca, 0x0001e59ab706fdc9,
+		    0x00001308d46ebfcd, 0x00063d988a2d2851 },
+		  { 0x0007a06c3fc66c0c, 0x0001c9bac1ba47fb, 0x00023935c575038e,
+		    0x0003f0bd71c59c13, 0x0003ac48d916e835 },
+		  { 0x00020753afbd232e, 0x00071fbb1ed06002, 0x00039cae47a4af3a,
+		    0x0000337c0b34d9c2, 0x00033fad52b2368a } },
+		{ { 0x0004c8d0c422cfe8, 0x000760b4275971a5, 0x0003da95bc1cad3d,
+		    0x0000f151ff5b7376, 0x0003cc355ccb90a7 },
+		  { 0x000649c6c5e41e16, 0x00060667eee6aa80, 0x0004179d182be190,
+		    0x000653d9567e6979, 0x00016c0f429a256d },
+		  { 0x00069443903e9131, 0x00016f4ac6f9dd36, 0x0002ea4912e29253,
+		    0x0002b4643e68d25d, 0x000631eaf426bae7 } },
+		{ { 0x000175b9a3700de8, 0x00077c5f00aa48fb, 0x0003917785ca0317,
+		    0x00005aa9b2c79399, 0x000431f2c7f665f8 },
+		  { 0x00010410da66fe9f, 0x00024d82dcb4d67d, 0x0003e6fe0e17752d,
+		    0x0004dade1ecbb08f, 0x0005599648b1ea91 },
+		  { 0x00026344858f7b19, 0x0005f43d4a295ac0, 0x000242a75c52acd4,
+		    0x0005934480220d10, 0x0007b04715f91253 } },
+		{ { 0x0006c280c4e6bac6, 0x0003ada3b361766e, 0x00042fe5125c3b4f,
+		    0x000111d84d4aac22, 0x00048d0acfa57cde },
+		  { 0x0005bd28acf6ae43, 0x00016fab8f56907d, 0x0007acb11218d5f2,
+		    0x00041fe02023b4db, 0x00059b37bf5c2f65 },
+		  { 0x000726e47dabe671, 0x0002ec45e746f6c1, 0x0006580e53c74686,
+		    0x0005eda104673f74, 0x00016234191336d3 } }
+	},
+	{
+		{ { 0x00019cd61ff38640, 0x000060c6c4b41ba9, 0x00075cf70ca7366f,
+		    0x000118a8f16c011e, 0x0004a25707a203b9 },
+		  { 0x000499def6267ff6, 0x00076e858108773c, 0x000693cac5ddcb29,
+		    0x00000311d00a9ff4, 0x0002cdfdfecd5d05 },
+		  { 0x0007668a53f6ed6a, 0x000303ba2e142556, 0x0003880584c10909,
+		    0x0004fe20000a261d, 0x0005721896d248e4 } },
+		{ { 0x00055091a1d0da4e, 0x0004f6bfc7c1050b, 0x00064e4ecd2ea9be,
+		    0x00007eb1f28bbe70, 0x00003c935afc4b03 },
+		  { 0x00065517fd181bae, 0x0003e5772c76816d, 0x000019189640898a,
+		    0x0001ed2a84de7499, 0x000578edd74f63c1 },
+		  { 0x000276c6492b0c3d, 0x00009bfc40bf932e, 0x000588e8f11f330b,
+		    0x0003d16e694dc26e, 0x0003ec2ab590288c } },
+		{ { 0x00013a09ae32d1cb, 0x0003e81eb85ab4e4, 0x00007aaca43cae1f,
+		    0x00062f05d7526374, 0x0000e1bf66c6adba },
+		  { 0x0000d27be4d87bb9, 0x00056c27235db434, 0x00072e6e0ea62d37,
+		    0x0005674cd06ee839, 0x0002dd5c25a200fc },
+		  { 0x0003d5e9792c887e, 0x000319724dabbc55, 0x0002b97c78680800,
+		    0x0007afdfdd34e6dd, 0x000730548b35ae88 } },
+		{ { 0x0003094ba1d6e334, 0x0006e126a7e3300b, 0x000089c0aefcfbc5,
+		    0x0002eea11f836583, 0x000585a2277d8784 },
+		  { 0x000551a3cba8b8ee, 0x0003b6422be2d886, 0x000630e1419689bc,
+		    0x0004653b07a7a955, 0x0003043443b411db },
+		  { 0x00025f8233d48962, 0x0006bd8f04aff431, 0x0004f907fd9a6312,
+		    0x00040fd3c737d29b, 0x0007656278950ef9 } },
+		{ { 0x000073a3ea86cf9d, 0x0006e0e2abfb9c2e, 0x00060e2a38ea33ee,
+		    0x00030b2429f3fe18, 0x00028bbf484b613f },
+		  { 0x0003cf59d51fc8c0, 0x0007a0a0d6de4718, 0x00055c3a3e6fb74b,
+		    0x000353135f884fd5, 0x0003f4160a8c1b84 },
+		  { 0x00012f5c6f136c7c, 0x0000fedba237de4c, 0x000779bccebfab44,
+		    0x0003aea93f4d6909, 0x0001e79cb358188f } },
+		{ { 0x000153d8f5e08181, 0x00008533bbdb2efd, 0x0001149796129431,
+		    0x00017a6e36168643, 0x000478ab52d39d1f },
+		  { 0x000436c3eef7e3f1, 0x0007ffd3c21f0026, 0x0003e77bf20a2da9,
+		    0x000418bffc8472de, 0x00065d7951b3a3b3 },
+		  { 0x0006a4d39252d159, 0x000790e35900ecd4, 0x00030725bf977786,
+		    0x00010a5c1635a053, 0x00016d87a411a212 } },
+		{ { 0x0004d5e2d54e0583, 0x0002e5d7b33f5f74, 0x0003a5de3f887ebf,
+		    0x0006ef24bd6139b7, 0x0001f990b577a5a6 },
+		  { 0x00057e5a42066215, 0x0001a18b44983677, 0x0003e652de1e6f8f,
+		    0x0006532be02ed8eb, 0x00028f87c8165f38 },
+		  { 0x00044ead1be8f7d6, 0x0005759d4f31f466, 0x0000378149f47943,
+		    0x00069f3be32b4f29, 0x00045882fe1534d6 } },
+		{ { 0x00049929943c6fe4, 0x0004347072545b15, 0x0003226bced7e7c5,
+		    0x00003a134ced89df, 0x0007dcf843ce405f },
+		  { 0x0001345d757983d6, 0x000222f54234cccd, 0x0001784a3d8adbb4,
+		    0x00036ebeee8c2bcc, 0x000688fe5b8f626f },
+		  { 0x0000d6484a4732c0, 0x0007b94ac6532d92, 0x0005771b8754850f,
+		    0x00048dd9df1461c8, 0x0006739687e73271 } }
+	},
+	{
+		{ { 0x0005cc9dc80c1ac0, 0x000683671486d4cd, 0x00076f5f1a5e8173,
+		    0x0006d5d3f5f9df4a, 0x0007da0b8f68d7e7 },
+		  { 0x00002014385675a6, 0x0006155fb53d1def, 0x00037ea32e89927c,
+		    0x000059a668f5a82e, 0x00046115aba1d4dc },
+		  { 0x00071953c3b5da76, 0x0006642233d37a81, 0x0002c9658076b1bd,
+		    0x0005a581e63010ff, 0x0005a5f887e83674 } },
+		{ { 0x000628d3a0a643b9, 0x00001cd8640c93d2, 0x0000b7b0cad70f2c,
+		    0x0003864da98144be, 0x00043e37ae2d5d1c },
+		  { 0x000301cf70a13d11, 0x0002a6a1ba1891ec, 0x0002f291fb3f3ae0,
+		    0x00021a7b814bea52, 0x0003669b656e44d1 },
+		  { 0x00063f06eda6e133, 0x000233342758070f, 0x000098e0459cc075,
+		    0x0004df5ead6c7c1b, 0x0006a21e6cd4fd5e } },
+		{ { 0x000129126699b2e3, 0x0000ee11a2603de8, 0x00060ac2f5c74c21,
+		    0x00059b192a196808, 0x00045371b07001e8 },
+		  { 0x0006170a3046e65f, 0x0005401a46a49e38, 0x00020add5561c4a8,
+		    0x0007abb4edde9e46, 0x000586bf9f1a195f },
+		  { 0x0003088d5ef8790b, 0x00038c2126fcb4db, 0x000685bae149e3c3,
+		    0x0000bcd601a4e930, 0x0000eafb03790e52 } },
+		{ { 0x0000805e0f75ae1d, 0x000464cc59860a28, 0x000248e5b7b00bef,
+		    0x0005d99675ef8f75, 0x00044ae3344c5435 },
+		  { 0x000555c13748042f, 0x0004d041754232c0, 0x000521b430866907,
+		    0x0003308e40fb9c39, 0x000309acc675a02c },
+		  { 0x000289b9bba543ee, 0x0003ab592e28539e, 0x00064d82abcdd83a,
+		    0x0003c78ec172e327, 0x00062d5221b7f946 } },
+		{ { 0x0005d4263af77a3c, 0x00023fdd2289aeb0, 0x0007dc64f77eb9ec,
+		    0x00001bd28338402c, 0x00014f29a5383922 },
+		  { 0x0004299c18d0936d, 0x0005914183418a49, 0x00052a18c721aed5,
+		    0x0002b151ba82976d, 0x0005c0efde4bc754 },
+		  { 0x00017edc25b2d7f5, 0x00037336a6081bee, 0x0007b5318887e5c3,
+		    0x00049f6d491a5be1, 0x0005e72365c7bee0 } },
+		{ { 0x000339062f08b33e, 0x0004bbf3e657cfb2, 0x00067af7f56e5967,
+		    0x0004dbd67f9ed68f, 0x00070b20555cb734 },
+		  { 0x0003fc074571217f, 0x0003a0d29b2b6aeb, 0x00006478ccdde59d,
+		    0x00055e4d051bddfa, 0x00077f1104c47b4e },
+		  { 0x000113c555112c4c, 0x0007535103f9b7ca, 0x000140ed1d9a2108,
+		    0x00002522333bc2af, 0x0000e34398f4a064 } },
+		{ { 0x00030b093e4b1928, 0x0001ce7e7ec80312, 0x0004e575bdf78f84,
+		    0x00061f7a190bed39, 0x0006f8aded6ca379 },
+		  { 0x000522d93ecebde8, 0x000024f045e0f6cf, 0x00016db63426cfa1,
+		    0x0001b93a1fd30fd8, 0x0005e5405368a362 },
+		  { 0x0000123dfdb7b29a, 0x0004344356523c68, 0x00079a527921ee5f,
+		    0x00074bfccb3e817e, 0x000780de72ec8d3d } },
+		{ { 0x0007eaf300f42772, 0x0005455188354ce3, 0x0004dcca4a3dcbac,
+		    0x0003d314d0bfebcb, 0x0001defc6ad32b58 },
+		  { 0x00028545089ae7bc, 0x0001e38fe9a0c15c, 0x00012046e0e2377b,
+		    0x0006721c560aa885, 0x0000eb28bf671928 },
+		  { 0x0003be1aef5195a7, 0x0006f22f62bdb5eb, 0x00039768b8523049,
+		    0x00043394c8fbfdbd, 0x000467d201bf8dd2 } }
+	},
+	{
+		{ { 0x0006f4bd567ae7a9, 0x00065ac89317b783, 0x00007d3b20fd8932,
+		    0x000000f208326916, 0x0002ef9c5a5ba384 },
+		  { 0x0006919a74ef4fad, 0x00059ed4611452bf, 0x000691ec04ea09ef,
+		    0x0003cbcb2700e984, 0x00071c43c4f5ba3c },
+		  { 0x00056df6fa9e74cd, 0x00079c95e4cf56df, 0x0007be643bc609e2,
+		    0x000149c12ad9e878, 0x0005a758ca390c5f } },
+		{ { 0x0000918b1d61dc94, 0x0000d350260cd19c, 0x0007a2ab4e37b4d9,
+		    0x00021fea735414d7, 0x0000a738027f639d },
+		  { 0x00072710d9462495, 0x00025aafaa007456, 0x0002d21f28eaa31b,
+		    0x00017671ea005fd0, 0x0002dbae244b3eb7 },
+		  { 0x00074a2f57ffe1cc, 0x0001bc3073087301, 0x0007ec57f4019c34,
+		    0x00034e082e1fa524, 0x0002698ca635126a } },
+		{ { 0x0005702f5e3dd90e, 0x00031c9a4a70c5c7, 0x000136a5aa78fc24,
+		    0x0001992f3b9f7b01, 0x0003c004b0c4afa3 },
+		  { 0x0005318832b0ba78, 0x0006f24b9ff17cec, 0x0000a47f30e060c7,
+		    0x00058384540dc8d0, 0x0001fb43dcc49cae },
+		  { 0x000146ac06f4b82b, 0x0004b500d89e7355, 0x0003351e1c728a12,
+		    0x00010b9f69932fe3, 0x0006b43fd01cd1fd } },
+		{ { 0x000742583e760ef3, 0x00073dc1573216b8, 0x0004ae48fdd7714a,
+		    0x0004f85f8a13e103, 0x00073420b2d6ff0d },
+		  { 0x00075d4b4697c544, 0x00011be1fff7f8f4, 0x000119e16857f7e1,
+		    0x00038a14345cf5d5, 0x0005a68d7105b52f },
+		  { 0x0004f6cb9e851e06, 0x000278c4471895e5, 0x0007efcdce3d64e4,
+		    0x00064f6d455c4b4c, 0x0003db5632fea34b } },
+		{ { 0x000190b1829825d5, 0x0000e7d3513225c9, 0x0001c12be3b7abae,
+		    0x00058777781e9ca6, 0x00059197ea495df2 },
+		  { 0x0006ee2bf75dd9d8, 0x0006c72ceb34be8d, 0x000679c9cc345ec7,
+		    0x0007898df96898a4, 0x00004321adf49d75 },
+		  { 0x00016019e4e55aae, 0x00074fc5f25d209c, 0x0004566a939ded0d,
+		    0x00066063e716e0b7, 0x00045eafdc1f4d70 } },
+		{ { 0x00064624cfccb1ed, 0x000257ab8072b6c1, 0x0000120725676f0a,
+		    0x0004a018d04e8eee, 0x0003f73ceea5d56d },
+		  { 0x000401858045d72b, 0x000459e5e0ca2d30, 0x000488b719308bea,
+		    0x00056f4a0d1b32b5, 0x0005a5eebc80362d },
+		  { 0x0007bfd10a4e8dc6, 0x0007c899366736f4, 0x00055ebbeaf95c01,
+		    0x00046db060903f8a, 0x0002605889126621 } },
+		{ { 0x00018e3cc676e542, 0x00026079d995a990, 0x00004a7c217908b2,
+		    0x0001dc7603e6655a, 0x0000dedfa10b2444 },
+		  { 0x000704a68360ff04, 0x0003cecc3cde8b3e, 0x00021cd5470f64ff,
+		    0x0006abc18d953989, 0x00054ad0c2e4e615 },
+		  { 0x000367d5b82b522a, 0x0000d3f4b83d7dc7, 0x0003067f4cdbc58d,
+		    0x00020452da697937, 0x00062ecb2baa77a9 } },
+		{ { 0x00072836afb62874, 0x0000af3c2094b240, 0x0000c285297f357a,
+		    0x0007cc2d5680d6e3, 0x00061913d5075663 },
+		  { 0x0005795261152b3d, 0x0007a1dbbafa3cbd, 0x0005ad31c52588d5,
+		    0x00045f3a4164685c, 0x0002e59f919a966d },
+		  { 0x00062d361a3231da, 0x00065284004e01b8, 0x000656533be91d60,
+		    0x0006ae016c00a89f, 0x0003ddbc2a131c05 } }
+	},
+	{
+		{ { 0x000257a22796bb14, 0x0006f360fb443e75, 0x000680e47220eaea,
+		    0x0002fcf2a5f10c18, 0x0005ee7fb38d8320 },
+		  { 0x00040ff9ce5ec54b, 0x00057185e261b35b, 0x0003e254540e70a9,
+		    0x0001b5814003e3f8, 0x00078968314ac04b },
+		  { 0x0005fdcb41446a8e, 0x0005286926ff2a71, 0x0000f231e296b3f6,
+		    0x000684a357c84693, 0x00061d0633c9bca0 } },
+		{ { 0x000328bcf8fc73df, 0x0003b4de06ff95b4, 0x00030aa427ba11a5,
+		    0x0005ee31bfda6d9c, 0x0005b23ac2df8067 },
+		  { 0x00044935ffdb2566, 0x00012f016d176c6e, 0x0004fbb00f16f5ae,
+		    0x0003fab78d99402a, 0x0006e965fd847aed },
+		  { 0x0002b953ee80527b, 0x00055f5bcdb1b35a, 0x00043a0b3fa23c66,
+		    0x00076e07388b820a, 0x00079b9bbb9dd95d } },
+		{ { 0x00017dae8e9f7374, 0x000719f76102da33, 0x0005117c2a80ca8b,
+		    0x00041a66b65d0936, 0x0001ba811460accb },
+		  { 0x000355406a3126c2, 0x00050d1918727d76, 0x0006e5ea0b498e0e,
+		    0x0000a3b6063214f2, 0x0005065f158c9fd2 },
+		  { 0x000169fb0c429954, 0x00059aedd9ecee10, 0x00039916eb851802,
+		    0x00057917555cc538, 0x0003981f39e58a4f } },
+		{ { 0x0005dfa56de66fde, 0x0000058809075908, 0x0006d3d8cb854a94,
+		    0x0005b2f4e970b1e3, 0x00030f4452edcbc1 },
+		  { 0x00038a7559230a93, 0x00052c1cde8ba31f, 0x0002a4f2d4745a3d,
+		    0x00007e9d42d4a28a, 0x00038dc083705acd },
+		  { 0x00052782c5759740, 0x00053f3397d990ad, 0x0003a939c7e84d15,
+		    0x000234c4227e39e0, 0x000632d9a1a593f2 } },
+		{ { 0x0001fd11ed0c84a7, 0x000021b3ed2757e1, 0x00073e1de58fc1c6,
+		    0x0005d110c84616ab, 0x0003a5a7df28af64 },
+		  { 0x00036b15b807cba6, 0x0003f78a9e1afed7, 0x0000a59c2c608f1f,
+		    0x00052bdd8ecb81b7, 0x0000b24f48847ed4 },
+		  { 0x0002d4be511beac7, 0x0006bda4d99e5b9b, 0x00017e6996914e01,
+		    0x0007b1f0ce7fcf80, 0x00034fcf74475481 } },
+		{ { 0x00031dab78cfaa98, 0x0004e3216e5e54b7, 0x000249823973b689,
+		    0x0002584984e48885, 0x0000119a3042fb37 },
+		  { 0x0007e04c789767ca, 0x0001671b28cfb832, 0x0007e57ea2e1c537,
+		    0x0001fbaaef444141, 0x0003d3bdc164dfa6 },
+		  { 0x0002d89ce8c2177d, 0x0006cd12ba182cf4, 0x00020a8ac19a7697,
+		    0x000539fab2cc72d9, 0x00056c088f1ede20 } },
+		{ { 0x00035fac24f38f02, 0x0007d75c6197ab03, 0x00033e4bc2a42fa7,
+		    0x0001c7cd10b48145, 0x000038b7ea483590 },
+		  { 0x00053d1110a86e17, 0x0006416eb65f466d, 0x00041ca6235fce20,
+		    0x0005c3fc8a99bb12, 0x00009674c6b99108 },
+		  { 0x0006f82199316ff8, 0x00005d54f1a9f3e9, 0x0003bcc5d0bd274a,
+		    0x0005b284b8d2d5ad, 0x0006e5e31025969e } },
+		{ { 0x0004fb0e63066222, 0x000130f59747e660, 0x000041868fecd41a,
+		    0x0003105e8c923bc6, 0x0003058ad43d1838 },
+		  { 0x000462f587e593fb, 0x0003d94ba7ce362d, 0x000330f9b52667b7,
+		    0x0005d45a48e0f00a, 0x00008f5114789a8d },
+		  { 0x00040ffde57663d0, 0x00071445d4c20647, 0x0002653e68170f7c,
+		    0x00064cdee3c55ed6, 0x00026549fa4efe3d } }
+	},
+	{
+		{ { 0x00068549af3f666e, 0x00009e2941d4bb68, 0x0002e8311f5dff3c,
+		    0x0006429ef91ffbd2, 0x0003a10dfe132ce3 },
+		  { 0x00055a461e6bf9d6, 0x00078eeef4b02e83, 0x0001d34f648c16cf,
+		    0x00007fea2aba5132, 0x0001926e1dc6401e },
+		  { 0x00074e8aea17cea0, 0x0000c743f83fbc0f, 0x0007cb03c4bf5455,
+		    0x00068a8ba9917e98, 0x0001fa1d01d861e5 } },
+		{ { 0x0004ac00d1df94ab, 0x0003ba2101bd271b, 0x0007578988b9c4af,
+		    0x0000f2bf89f49f7e, 0x00073fced18ee9a0 },
+		  { 0x000055947d599832, 0x000346fe2aa41990, 0x0000164c8079195b,
+		    0x000799ccfb7bba27, 0x000773563bc6a75c },
+		  { 0x0001e90863139cb3, 0x0004f8b407d9a0d6, 0x00058e24ca924f69,
+		    0x0007a246bbe76456, 0x0001f426b701b864 } },
+		{ { 0x000635c891a12552, 0x00026aebd38ede2f, 0x00066dc8faddae05,
+		    0x00021c7d41a03786, 0x0000b76bb1b3fa7e },
+		  { 0x0001264c41911c01, 0x000702f44584bdf9, 0x00043c511fc68ede,
+		    0x0000482c3aed35f9, 0x0004e1af5271d31b },
+		  { 0x0000c1f97f92939b, 0x00017a88956dc117, 0x0006ee005ef99dc7,
+		    0x0004aa9172b231cc, 0x0007b6dd61eb772a } },
+		{ { 0x0000abf9ab01d2c7, 0x0003880287630ae6, 0x00032eca045beddb,
+		    0x00057f43365f32d0, 0x00053fa9b659bff6 },
+		  { 0x0005c1e850f33d92, 0x0001ec119ab9f6f5, 0x0007f16f6de663e9,
+		    0x0007a7d6cb16dec6, 0x000703e9bceaf1d2 },
+		  { 0x0004c8e994885455, 0x0004ccb5da9cad82, 0x0003596bc610e975,
+		    0x0007a80c0ddb9f5e, 0x000398d93e5c4c61 } },
+		{ { 0x00077c60d2e7e3f2, 0x0004061051763870, 0x00067bc4e0ecd2aa,
+		    0x0002bb941f1373b9, 0x000699c9c9002c30 },
+		  { 0x0003d16733e248f3, 0x0000e2b7e14be389, 0x00042c0ddaf6784a,
+		    0x000589ea1fc67850, 0x00053b09b5ddf191 },
+		  { 0x0006a7235946f1cc, 0x0006b99cbb2fbe60, 0x0006d3a5d6485c62,
+		    0x0004839466e923c0, 0x00051caf30c6fcdd } },
+		{ { 0x0002f99a18ac54c7, 0x000398a39661ee6f, 0x000384331e40cde3,
+		    0x0004cd15c4de19a6, 0x00012ae29c189f8e },
+		  { 0x0003a7427674e00a, 0x0006142f4f7e74c1, 0x0004cc93318c3a15,
+		    0x0006d51bac2b1ee7, 0x0005504aa292383f },
+		  { 0x0006c0cb1f0d01cf, 0x000187469ef5d533, 0x00027138883747bf,
+		    0x0002f52ae53a90e8, 0x0005fd14fe958eba } },
+		{ { 0x0002fe5ebf93cb8e, 0x000226da8acbe788, 0x00010883a2fb7ea1,
+		    0x000094707842cf44, 0x0007dd73f960725d },
+		  { 0x00042ddf2845ab2c, 0x0006214ffd3276bb, 0x00000b8d181a5246,
+		    0x000268a6d579eb20, 0x000093ff26e58647 },
+		  { 0x000524fe68059829, 0x00065b75e47cb621, 0x00015eb0a5d5cc19,
+		    0x00005209b3929d5a, 0x0002f59bcbc86b47 } },
+		{ { 0x0001d560b691c301, 0x0007f5bafce3ce08, 0x0004cd561614806c,
+		    0x0004588b6170b188, 0x0002aa55e3d01082 },
+		  { 0x00047d429917135f, 0x0003eacfa07af070, 0x0001deab46b46e44,
+		    0x0007a53f3ba46cdf, 0x0005458b42e2e51a },
+		  { 0x000192e60c07444f, 0x0005ae8843a21daa, 0x0006d721910b1538,
+		    0x0003321a95a6417e, 0x00013e9004a8a768 } }
+	},
+	{
+		{ { 0x000600c9193b877f, 0x00021c1b8a0d7765, 0x000379927fb38ea2,
+		    0x00070d7679dbe01b, 0x0005f46040898de9 },
+		  { 0x00058845832fcedb, 0x000135cd7f0c6e73, 0x00053ffbdfe8e35b,
+		    0x00022f195e06e55b, 0x00073937e8814bce },
+		  { 0x00037116297bf48d, 0x00045a9e0d069720, 0x00025af71aa744ec,
+		    0x00041af0cb8aaba3, 0x0002cf8a4e891d5e } },
+		{ { 0x0005487e17d06ba2, 0x0003872a032d6596, 0x00065e28c09348e0,
+		    0x00027b6bb2ce40c2, 0x0007a6f7f2891d6a },
+		  { 0x0003fd8707110f67, 0x00026f8716a92db2, 0x0001cdaa1b753027,
+		    0x000504be58b52661, 0x0002049bd6e58252 },
+		  { 0x0001fd8d6a9aef49, 0x0007cb67b7216fa1, 0x00067aff53c3b982,
+		    0x00020ea610da9628, 0x0006011aadfc5459 } },
+		{ { 0x0006d0c802cbf890, 0x000141bfed554c7b, 0x0006dbb667ef4263,
+		    0x00058f3126857edc, 0x00069ce18b779340 },
+		  { 0x0007926dcf95f83c, 0x00042e25120e2bec, 0x00063de96df1fa15,
+		    0x0004f06b50f3f9cc, 0x0006fc5cc1b0b62f },
+		  { 0x00075528b29879cb, 0x00079a8fd2125a3d, 0x00027c8d4b746ab8,
+		    0x0000f8893f02210c, 0x00015596b3ae5710 } },
+		{ { 0x000731167e5124ca, 0x00017b38e8bbe13f, 0x0003d55b942f9056,
+		    0x00009c1495be913f, 0x0003aa4e241afb6d },
+		  { 0x000739d23f9179a2, 0x000632fadbb9e8c4, 0x0007c8522bfe0c48,
+		    0x0006ed0983ef5aa9, 0x0000d2237687b5f4 },
+		  { 0x000138bf2a3305f5, 0x0001f45d24d86598, 0x0005274bad2160fe,
+		    0x0001b6041d58d12a, 0x00032fcaa6e4687a } },
+		{ { 0x0007a4732787ccdf, 0x00011e427c7f0640, 0x00003659385f8c64,
+		    0x0005f4ead9766bfb, 0x000746f6336c2600 },
+		  { 0x00056e8dc57d9af5, 0x0005b3be17be4f78, 0x0003bf928cf82f4b,
+		    0x00052e55600a6f11, 0x0004627e9cefebd6 },
+		  { 0x0002f345ab6c971c, 0x000653286e63e7e9, 0x00051061b78a23ad,
+		    0x00014999acb54501, 0x0007b4917007ed66 } },
+		{ { 0x00041b28dd53a2dd, 0x00037be85f87ea86, 0x00074be3d2a85e41,
+		    0x0001be87fac96ca6, 0x0001d03620fe08cd },
+		  { 0x0005fb5cab84b064, 0x0002513e778285b0, 0x000457383125e043,
+		    0x0006bda3b56e223d, 0x000122ba376f844f },
+		  { 0x000232cda2b4e554, 0x0000422ba30ff840, 0x000751e7667b43f5,
+		    0x0006261755da5f3e, 0x00002c70bf52b68e } },
+		{ { 0x000532bf458d72e1, 0x00040f96e796b59c, 0x00022ef79d6f9da3,
+		    0x000501ab67beca77, 0x0006b0697e3feb43 },
+		  { 0x0007ec4b5d0b2fbb, 0x000200e910595450, 0x000742057105715e,
+		    0x0002f07022530f60, 0x00026334f0a409ef },
+		  { 0x0000f04adf62a3c0, 0x0005e0edb48bb6d9, 0x0007c34aa4fbc003,
+		    0x0007d74e4e5cac24, 0x0001cc37f43441b2 } },
+		{ { 0x000656f1c9ceaeb9, 0x0007031cacad5aec, 0x0001308cd0716c57,
+		    0x00041c1373941942, 0x0003a346f772f196 },
+		  { 0x0007565a5cc7324f, 0x00001ca0d5244a11, 0x000116b067418713,
+		    0x0000a57d8c55edae, 0x0006c6809c103803 },
+		  { 0x00055112e2da6ac8, 0x0006363d0a3dba5a, 0x000319c98ba6f40c,
+		    0x0002e84b03a36ec7, 0x00005911b9f6ef7c } }
+	},
+	{
+		{ { 0x0001acf3512eeaef, 0x0002639839692a69, 0x000669a234830507,
+		    0x00068b920c0603d4, 0x000555ef9d1c64b2 },
+		  { 0x00039983f5df0ebb, 0x0001ea2589959826, 0x0006ce638703cdd6,
+		    0x0006311678898505, 0x0006b3cecf9aa270 },
+		  { 0x000770ba3b73bd08, 0x00011475f7e186d4, 0x0000251bc9892bbc,
+		    0x00024eab9bffcc5a, 0x000675f4de133817 } },
+		{ { 0x0007f6d93bdab31d, 0x0001f3aca5bfd425, 0x0002fa521c1c9760,
+		    0x00062180ce27f9cd, 0x00060f450b882cd3 },
+		  { 0x000452036b1782fc, 0x00002d95b07681c5, 0x0005901cf99205b2,
+		    0x000290686e5eecb4, 0x00013d99df70164c },
+		  { 0x00035ec321e5c0ca, 0x00013ae337f44029, 0x0004008e813f2da7,
+		    0x000640272f8e0c3a, 0x0001c06de9e55eda } },
+		{ { 0x00052b40ff6d69aa, 0x00031b8809377ffa, 0x000536625cd14c2c,
+		    0x000516af252e17d1, 0x00078096f8e7d32b },
+		  { 0x00077ad6a33ec4e2, 0x000717c5dc11d321, 0x0004a114559823e4,
+		    0x000306ce50a1e2b1, 0x0004cf38a1fec2db },
+		  { 0x0002aa650dfa5ce7, 0x00054916a8f19415, 0x00000dc96fe71278,
+		    0x00055f2784e63eb8, 0x000373cad3a26091 } },
+		{ { 0x0006a8fb89ddbbad, 0x00078c35d5d97e37, 0x00066e3674ef2cb2,
+		    0x00034347ac53dd8f, 0x00021547eda5112a },
+		  { 0x0004634d82c9f57c, 0x0004249268a6d652, 0x0006336d687f2ff7,
+		    0x0004fe4f4e26d9a0, 0x0000040f3d945441 },
+		  { 0x0005e939fd5986d3, 0x00012a2147019bdf, 0x0004c466e7d09cb2,
+		    0x0006fa5b95d203dd, 0x00063550a334a254 } },
+		{ { 0x0002584572547b49, 0x00075c58811c1377, 0x0004d3c637cc171b,
+		    0x00033d30747d34e3, 0x00039a92bafaa7d7 },
+		  { 0x0007d6edb569cf37, 0x00060194a5dc2ca0, 0x0005af59745e10a6,
+		    0x0007a8f53e004875, 0x0003eea62c7daf78 },
+		  { 0x0004c713e693274e, 0x0006ed1b7a6eb3a4, 0x00062ace697d8e15,
+		    0x000266b8292ab075, 0x00068436a0665c9c } },
+		{ { 0x0006d317e820107c, 0x000090815d2ca3ca, 0x00003ff1eb1499a1,
+		    0x00023960f050e319, 0x0005373669c91611 },
+		  { 0x000235e8202f3f27, 0x00044c9f2eb61780, 0x000630905b1d7003,
+		    0x0004fcc8d274ead1, 0x00017b6e7f68ab78 },
+		  { 0x000014ab9a0e5257, 0x00009939567f8ba5, 0x0004b47b2a423c82,
+		    0x000688d7e57ac42d, 0x0001cb4b5a678f87 } },
+		{ { 0x0004aa62a2a007e7, 0x00061e0e38f62d6e, 0x00002f888fcc4782,
+		    0x0007562b83f21c00, 0x0002dc0fd2d82ef6 },
+		  { 0x0004c06b394afc6c, 0x0004931b4bf636cc, 0x00072b60d0322378,
+		    0x00025127c6818b25, 0x000330bca78de743 },
+		  { 0x0006ff841119744e, 0x0002c560e8e49305, 0x0007254fefe5a57a,
+		    0x00067ae2c560a7df, 0x0003c31be1b369f1 } },
+		{ { 0x0000bc93f9cb4272, 0x0003f8f9db73182d, 0x0002b235eabae1c4,
+		    0x0002ddbf8729551a, 0x00041cec1097e7d5 },
+		  { 0x0004864d08948aee, 0x0005d237438df61e, 0x0002b285601f7067,
+		    0x00025dbcbae6d753, 0x000330b61134262d },
+		  { 0x000619d7a26d808a, 0x0003c3b3c2adbef2, 0x0006877c9eec7f52,
+		    0x0003beb9ebe1b66d, 0x00026b44cd91f287 } }
+	},
+	{
+		{ { 0x0007f29362730383, 0x0007fd7951459c36, 0x0007504c512d49e7,
+		    0x000087ed7e3bc55f, 0x0007deb10149c726 },
+		  { 0x000048478f387475, 0x00069397d9678a3e, 0x00067c8156c976f3,
+		    0x0002eb4d5589226c, 0x0002c709e6c1c10a },
+		  { 0x0002af6a8766ee7a, 0x00008aaa79a1d96c, 0x00042f92d59b2fb0,
+		    0x0001752c40009c07, 0x00008e68e9ff62ce } },
+		{ { 0x000509d50ab8f2f9, 0x0001b8ab247be5e5, 0x0005d9b2e6b2e486,
+		    0x0004faa5479a1339, 0x0004cb13bd738f71 },
+		  { 0x0005500a4bc130ad, 0x000127a17a938695, 0x00002a26fa34e36d,
+		    0x000584d12e1ecc28, 0x0002f1f3f87eeba3 },
+		  { 0x00048c75e515b64a, 0x00075b6952071ef0, 0x0005d46d42965406,
+		    0x0007746106989f9f, 0x00019a1e353c0ae2 } },
+		{ { 0x000172cdd596bdbd, 0x0000731ddf881684, 0x00010426d64f8115,
+		    0x00071a4fd8a9a3da, 0x000736bd3990266a },
+		  { 0x00047560bafa05c3, 0x000418dcabcc2fa3, 0x00035991cecf8682,
+		    0x00024371a94b8c60, 0x00041546b11c20c3 },
+		  { 0x00032d509334b3b4, 0x00016c102cae70aa, 0x0001720dd51bf445,
+		    0x0005ae662faf9821, 0x000412295a2b87fa } },
+		{ { 0x00055261e293eac6, 0x00006426759b65cc, 0x00040265ae116a48,
+		    0x0006c02304bae5bc, 0x0000760bb8d195ad },
+		  { 0x00019b88f57ed6e9, 0x0004cdbf1904a339, 0x00042b49cd4e4f2c,
+		    0x00071a2e771909d9, 0x00014e153ebb52d2 },
+		  { 0x00061a17cde6818a, 0x00053dad34108827, 0x00032b32c55c55b6,
+		    0x0002f9165f9347a3, 0x0006b34be9bc33ac } },
+		{ { 0x000469656571f2d3, 0x0000aa61ce6f423f, 0x0003f940d71b27a1,
+		    0x000185f19d73d16a, 0x00001b9c7b62e6dd },
+		  { 0x00072f643a78c0b2, 0x0003de45c04f9e7b, 0x000706d68d30fa5c,
+		    0x000696f63e8e2f24, 0x0002012c18f0922d },
+		  { 0x000355e55ac89d29, 0x0003e8b414ec7101, 0x00039db07c520c90,
+		    0x0006f41e9b77efe1, 0x00008af5b784e4ba } },
+		{ { 0x000314d289cc2c4b, 0x00023450e2f1bc4e, 0x0000cd93392f92f4,
+		    0x0001370c6a946b7d, 0x0006423c1d5afd98 },
+		  { 0x000499dc881f2533, 0x00034ef26476c506, 0x0004d107d2741497,
+		    0x000346c4bd6efdb3, 0x00032b79d71163a1 },
+		  { 0x0005f8d9edfcb36a, 0x0001e6e8dcbf3990, 0x0007974f348af30a,
+		    0x0006e6724ef19c7c, 0x000480a5efbc13e2 } },
+		{ { 0x00014ce442ce221f, 0x00018980a72516cc, 0x000072f80db86677,
+		    0x000703331fda526e, 0x00024b31d47691c8 },
+		  { 0x0001e70b01622071, 0x0001f163b5f8a16a, 0x00056aaf341ad417,
+		    0x0007989635d830f7, 0x00047aa27600cb7b },
+		  { 0x00041eedc015f8c3, 0x0007cf8d27ef854a, 0x000289e3584693f9,
+		    0x00004a7857b309a7, 0x000545b585d14dda } },
+		{ { 0x0004e4d0e3b321e1, 0x0007451fe3d2ac40, 0x000666f678eea98d,
+		    0x000038858667fead, 0x0004d22dc3e64c8d },
+		  { 0x0007275ea0d43a0f, 0x000681137dd7ccf7, 0x0001e79cbab79a38,
+		    0x00022a214489a66a, 0x0000f62f9c332ba5 },
+		  { 0x00046589d63b5f39, 0x0007eaf979ec3f96, 0x0004ebe81572b9a8,
+		    0x00021b7f5d61694a, 0x0001c0fa01a36371 } }
+	},
+	{
+		{ { 0x00002b0e8c936a50, 0x0006b83b58b6cd21, 0x00037ed8d3e72680,
+		    0x0000a037db9f2a62, 0x0004005419b1d2bc },
+		  { 0x000604b622943dff, 0x0001c899f6741a58, 0x00060219e2f232fb,
+		    0x00035fae92a7f9cb, 0x0000fa3614f3b1ca },
+		  { 0x0003febdb9be82f0, 0x0005e74895921400, 0x000553ea38822706,
+		    0x0005a17c24cfc88c, 0x0001fba218aef40a } },
+		{ { 0x000657043e7b0194, 0x0005c11b55efe9e7, 0x0007737bc6a074fb,
+		    0x0000eae41ce355cc, 0x0006c535d13ff776 },
+		  { 0x00049448fac8f53e, 0x00034f74c6e8356a, 0x0000ad780607dba2,
+		    0x0007213a7eb63eb6, 0x000392e3acaa8c86 },
+		  { 0x000534e93e8a35af, 0x00008b10fd02c997, 0x00026ac2acb81e05,
+		    0x00009d8c98ce3b79, 0x00025e17fe4d50ac } },
+		{ { 0x00077ff576f121a7, 0x0004e5f9b0fc722b, 0x00046f949b0d28c8,
+		    0x0004cde65d17ef26, 0x0006bba828f89698 },
+		  { 0x00009bd71e04f676, 0x00025ac841f2a145, 0x0001a47eac823871,
+		    0x0001a8a8c36c581a, 0x000255751442a9fb },
+		  { 0x0001bc6690fe3901, 0x000314132f5abc5a, 0x000611835132d528,
+		    0x0005f24b8eb48a57, 0x000559d504f7f6b7 } },
+		{ { 0x000091e7f6d266fd, 0x00036060ef037389, 0x00018788ec1d1286,
+		    0x000287441c478eb0, 0x000123ea6a3354bd },
+		  { 0x00038378b3eb54d5, 0x0004d4aaa78f94ee, 0x0004a002e875a74d,
+		    0x00010b851367b17c, 0x00001ab12d5807e3 },
+		  { 0x0005189041e32d96, 0x00005b062b090231, 0x0000c91766e7b78f,
+		    0x0000aa0f55a138ec, 0x0004a3961e2c918a } },
+		{ { 0x0007d644f3233f1e, 0x0001c69f9e02c064, 0x00036ae5e5266898,
+		    0x00008fc1dad38b79, 0x00068aceead9bd41 },
+		  { 0x00043be0f8e6bba0, 0x00068fdffc614e3b, 0x0004e91dab5b3be0,
+		    0x0003b1d4c9212ff0, 0x0002cd6bce3fb1db },
+		  { 0x0004c90ef3d7c210, 0x000496f5a0818716, 0x00079cf88cc239b8,
+		    0x0002cb9c306cf8db, 0x000595760d5b508f } },
+		{ { 0x0002cbebfd022790, 0x0000b8822aec1105, 0x0004d1cfd226bccc,
+		    0x000515b2fa4971be, 0x0002cb2c5df54515 },
+		  { 0x0001bfe104aa6397, 0x00011494ff996c25, 0x00064251623e5800,
+		    0x0000d49fc5e044be, 0x000709fa43edcb29 },
+		  { 0x00025d8c63fd2aca, 0x0004c5cd29dffd61, 0x00032ec0eb48af05,
+		    0x00018f9391f9b77c, 0x00070f029ecf0c81 } },
+		{ { 0x0002afaa5e10b0b9, 0x00061de08355254d, 0x0000eb587de3c28d,
+		    0x0004f0bb9f7dbbd5, 0x00044eca5a2a74bd },
+		  { 0x000307b32eed3e33, 0x0006748ab03ce8c2, 0x00057c0d9ab810bc,
+		    0x00042c64a224e98c, 0x0000b7d5d8a6c314 },
+		  { 0x000448327b95d543, 0x0000146681e3a4ba, 0x00038714adc34e0c,
+		    0x0004f26f0e298e30, 0x000272224512c7de } },
+		{ { 0x0003bb8a42a975fc, 0x0006f2d5b46b17ef, 0x0007b6a9223170e5,
+		    0x000053713fe3b7e6, 0x00019735fd7f6bc2 },
+		  { 0x000492af49c5342e, 0x0002365cdf5a0357, 0x00032138a7ffbb60,
+		    0x0002a1f7d14646fe, 0x00011b5df18a44cc },
+		  { 0x000390d042c84266, 0x0001efe32a8fdc75, 0x0006925ee7ae1238,
+		    0x0004af9281d0e832, 0x0000fef911191df8 } }
+	}
+};
+
+/*bi[i] = (2 * i + 1) * B*/
+static const struct ge_precomp bi[8] = {
+	{ { 0x000493c6f58c3b85, 0x0000df7181c325f7, 0x0000f50b0b3e4cb7,
+	    0x0005329385a44c32, 0x00007cf9d3a33d4b },
+	  { 0x00003905d740913e, 0x0000ba2817d673a2, 0x00023e2827f4e67c,
+	    0x000133d2e0c21a34, 0x00044fd2f9298f81 },
+	  { 0x00011205877aaa68, 0x000479955893d579, 0x00050d66309b67a0,
+	    0x0002d42d0dbee5ee, 0x0006f117b689f0c6 } },
+	{ { 0x0005b0a84cee9730, 0x00061d10c97155e4, 0x0004059cc8096a10,
+	    0x00047a608da8014f, 0x0007a164e1b9a80f },
+	  { 0x00011fe8a4fcd265, 0x0007bcb8374faacc, 0x00052f5af4ef4d4f,
+	    0x0005314098f98d10, 0x0002ab91587555bd },
+	  { 0x0006933f0dd0d889, 0x00044386bb4c4295, 0x0003cb6d3162508c,
+	    0x00026368b872a2c6, 0x0005a2826af12b9b } },
+	{ { 0x0002bc4408a5bb33, 0x000078ebdda05442, 0x0002ffb112354123,
+	    0x000375ee8df5862d, 0x0002945ccf146e20 },
+	  { 0x000182c3a447d6ba, 0x00022964e536eff2, 0x000192821f540053,
+	    0x0002f9f19e788e5c, 0x000154a7e73eb1b5 },
+	  { 0x0003dbf1812a8285, 0x0000fa17ba3f9797, 0x0006f69cb49c3820,
+	    0x00034d5a0db3858d, 0x00043aabe696b3bb } },
+	{ { 0x00025cd0944ea3bf, 0x00075673b81a4d63, 0x000150b925d1c0d4,
+	    0x00013f38d9294114, 0x000461bea69283c9 },
+	  { 0x00072c9aaa3221b1, 0x000267774474f74d, 0x000064b0e9b28085,
+	    0x0003f04ef53b27c9, 0x0001d6edd5d2e531 },
+	  { 0x00036dc801b8b3a2, 0x0000e0a7d4935e30, 0x0001deb7cecc0d7d,
+	    0x000053a94e20dd2c, 0x0007a9fbb1c6a0f9 } },
+	{ { 0x0006678aa6a8632f, 0x0005ea3788d8b365, 0x00021bd6d6994279,
+	    0x0007ace75919e4e3, 0x00034b9ed338add7 },
+	  { 0x0006217e039d8064, 0x0006dea408337e6d, 0x00057ac112628206,
+	    0x000647cb65e30473, 0x00049c05a51fadc9 },
+	  { 0x0004e8bf9045af1b, 0x000514e33a45e0d6, 0x0007533c5b8bfe0f,
+	    0x000583557b7e14c9, 0x00073c172021b008 } },
+	{ { 0x000700848a802ade, 0x0001e04605c4e5f7, 0x0005c0d01b9767fb,
+	    0x0007d7889f42388b, 0x0004275aae2546d8 },
+	  { 0x00075b0249864348, 0x00052ee11070262b, 0x000237ae54fb5acd,
+	    0x0003bfd1d03aaab5, 0x00018ab598029d5c },
+	  { 0x00032cc5fd6089e9, 0x000426505c949b05, 0x00046a18880c7ad2,
+	    0x0004a4221888ccda, 0x0003dc65522b53df } },
+	{ { 0x0000c222a2007f6d, 0x000356b79bdb77ee, 0x00041ee81efe12ce,
+	    0x000120a9bd07097d, 0x000234fd7eec346f },
+	  { 0x0007013b327fbf93, 0x0001336eeded6a0d, 0x0002b565a2bbf3af,
+	    0x000253ce89591955, 0x0000267882d17602 },
+	  { 0x0000a119732ea378, 0x00063bf1ba8e2a6c, 0x00069f94cc90df9a,
+	    0x000431d1779bfc48, 0x000497ba6fdaa097 } },
+	{ { 0x0006cc0313cfeaa0, 0x0001a313848da499, 0x0007cb534219230a,
+	    0x00039596dedefd60, 0x00061e22917f12de },
+	  { 0x0003cd86468ccf0b, 0x00048553221ac081, 0x0006c9464b4e0a6e,
+	    0x00075fba84180403, 0x00043b5cd4218d05 },
+	  { 0x0002762f9bd0b516, 0x0001c6e7fbddcbb3, 0x00075909c3ace2bd,
+	    0x00042101972d3ec9, 0x000511d61210ae4d } }
+};
+
+#endif
@@ -0,0 +1,745 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifdef AES_CCM_HW
+
+#include <stddef.h>
+#include <string.h>
+
+#include "crypto_aes_ccm.h"
+
+#include "common/crypto_provider.h"
+#include "common/memcpy_s.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#define AES_CCM_X86
+#define AES_TARGET __attribute__((target("aes,sse2")))
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define AES_CCM_ARM
+#if defined(__clang__)
+#define AES_TARGET __attribute__((target("aes")))
+#else
+#define AES_TARGET __attribute__((target("+crypto")))
+#endif
+#if defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_AES
+#define HWCAP_AES (1 << 3)
+#endif
+#endif
+#endif
+
+#define AES_BLOCK_SIZE 16
+
+/*encrypts the blocks a and b, interleaving their rounds*/
+typedef void (*aes_encrypt2_t)(const uint8_t *rk, uint8_t a[AES_BLOCK_SIZE],
+			       uint8_t b[AES_BLOCK_SIZE]);
+
+/*blocks encrypted together by aes_ccm_hw_multi(), two per computation*/
+#define AES_CCM_HW_MAX_BLOCKS (2 * AES_CCM_HW_LANES)
+
+/*encrypts n blocks in place, block i with the round keys rk[i], interleaving
+their rounds*/
+typedef void (*aes_encrypt_n_t)(const uint8_t *const rk[],
+				uint8_t *const blk[], uint32_t n);
+
+static const uint8_t sbox[256] = {
+	0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67,
+	0x2b, 0xfe, 0xd7, 0xab, 0x76, 0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59,
+	0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0, 0xb7,
+	0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1,
+	0x71, 0xd8, 0x31, 0x15, 0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05,
+	0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75, 0x09, 0x83,
+	0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29,
+	0xe3, 0x2f, 0x84, 0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b,
+	0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf, 0xd0, 0xef, 0xaa,
+	0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c,
+	0x9f, 0xa8, 0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc,
+	0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2, 0xcd, 0x0c, 0x13, 0xec,
+	0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19,
+	0x73, 0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee,
+	0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb, 0xe0, 0x32, 0x3a, 0x0a, 0x49,
+	0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+	0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4,
+	0xea, 0x65, 0x7a, 0xae, 0x08, 0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6,
+	0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a, 0x70,
+	0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9,
+	0x86, 0xc1, 0x1d, 0x9e, 0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e,
+	0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf, 0x8c, 0xa1,
+	0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0,
+	0x54, 0xbb, 0x16
+};
+
+static void aes_128_key_expand_sw(const uint8_t key[AES_128_KEY_SIZE],
+				  uint8_t rk[AES_128_KEY_SCHEDULE_SIZE])
+{
+	static const uint8_t rcon[10] = { 0x01, 0x02, 0x04, 0x08, 0x10,
+					  0x20, 0x40, 0x80, 0x1b, 0x36 };
+	memcpy(rk, key, AES_128_KEY_SIZE);
+	for (uint32_t i = 4; i < 44; i++) {
+		uint8_t t[4];
+		memcpy(t, &rk[4 * (i - 1)], sizeof(t));
+		if (0 == (i % 4)) {
+			/*RotWord, SubWord and Rcon*/
+			uint8_t t0 = t[0];
+			t[0] = (uint8_t)(sbox[t[1]] ^ rcon[i / 4 - 1]);
+			t[1] = sbox[t[2]];
+			t[2] = sbox[t[3]];
+			t[3] = sbox[t0];
+		}
+		for (uint32_t j = 0; j < 4; j++) {
+			rk[4 * i + j] = (uint8_t)(rk[4 * (i - 4) + j] ^ t[j]);
+		}
+	}
+}
+
+#if defined(AES_CCM_X86)
+AES_TARGET static void aesni_encrypt2(const uint8_t *rk,
+				      uint8_t a[AES_BLOCK_SIZE],
+				      uint8_t b[AES_BLOCK_SIZE])
+{
+	__m128i k = _mm_loadu_si128((const __m128i *)rk);
+	__m128i x = _mm_xor_si128(_mm_loadu_si128((const __m128i *)a), k);
+	__m128i y = _mm_xor_si128(_mm_loadu_si128((const __m128i *)b), k);
+	for (uint32_t r = 1; r < 10; r++) {
+		k = _mm_loadu_si128((const __m128i *)(rk + 16 * r));
+		x = _mm_aesenc_si128(x, k);
+		y = _mm_aesenc_si128(y, k);
+	}
+	k = _mm_loadu_si128((const __m128i *)(rk + 160));
+	_mm_storeu_si128((__m128i *)a, _mm_aesenclast_si128(x, k));
+	_mm_storeu_si128((__m128i *)b, _mm_aesenclast_si128(y, k));
+}
+#elif defined(AES_CCM_ARM)
+AES_TARGET static void armce_encrypt2(const uint8_t *rk,
+				      uint8_t a[AES_BLOCK_SIZE],
+				      uint8_t b[AES_BLOCK_SIZE])
+{
+	uint8x16_t x = vld1q_u8(a);
+	uint8x16_t y = vld1q_u8(b);
+	uint8x16_t k;
+	/*AESE adds the round key before SubBytes and ShiftRows*/
+	for (uint32_t r = 0; r < 9; r++) {
+		k = vld1q_u8(rk + 16 * r);
+		x = vaesmcq_u8(vaeseq_u8(x, k));
+		y = vaesmcq_u8(vaeseq_u8(y, k));
+	}
+	k = vld1q_u8(rk + 144);
+	x = vaeseq_u8(x, k);
+	y = vaeseq_u8(y, k);
+	k = vld1q_u8(rk + 160);
+	vst1q_u8(a, veorq_u8(x, k));
+	vst1q_u8(b, veorq_u8(y, k));
+}
+#endif
+
+#if defined(AES_CCM_X86)
+#define AESNI_LOAD(p) _mm_loadu_si128((const __m128i *)(p))
+
+AES_TARGET static void aesni_encrypt_n(const uint8_t *const rk[],
+				       uint8_t *const blk[], uint32_t n)
+{
+	/*four blocks are enough to fill the pipeline*/
+	uint32_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const uint8_t *k0 = rk[i], *k1 = rk[i + 1];
+		const uint8_t *k2 = rk[i + 2], *k3 = rk[i + 3];
+		__m128i x0 = _mm_xor_si128(AESNI_LOAD(blk[i]), AESNI_LOAD(k0));
+		__m128i x1 = _mm_xor_si128(AESNI_LOAD(blk[i + 1]),
+					   AESNI_LOAD(k1));
+		__m128i x2 = _mm_xor_si128(AESNI_LOAD(blk[i + 2]),
+					   AESNI_LOAD(k2));
+		__m128i x3 = _mm_xor_si128(AESNI_LOAD(blk[i + 3]),
+					   AESNI_LOAD(k3));
+		for (uint32_t r = 16; r < 160; r += 16) {
+			x0 = _mm_aesenc_si128(x0, AESNI_LOAD(k0 + r));
+			x1 = _mm_aesenc_si128(x1, AESNI_LOAD(k1 + r));
+			x2 = _mm_aesenc_si128(x2, AESNI_LOAD(k2 + r));
+			x3 = _mm_aesenc_si128(x3, AESNI_LOAD(k3 + r));
+		}
+		x0 = _mm_aesenclast_si128(x0, AESNI_LOAD(k0 + 160));
+		x1 = _mm_aesenclast_si128(x1, AESNI_LOAD(k1 + 160));
+		x2 = _mm_aesenclast_si128(x2, AESNI_LOAD(k2 + 160));
+		x3 = _mm_aesenclast_si128(x3, AESNI_LOAD(k3 + 160));
+		_mm_storeu_si128((__m128i *)blk[i], x0);
+		_mm_storeu_si128((__m128i *)blk[i + 1], x1);
+		_mm_storeu_si128((__m128i *)blk[i + 2], x2);
+		_mm_storeu_si128((__m128i *)blk[i + 3], x3);
+	}
+	for (; i < n; i++) {
+		const uint8_t *k = rk[i];
+		__m128i x = _mm_xor_si128(AESNI_LOAD(blk[i]), AESNI_LOAD(k));
+		for (uint32_t r = 16; r < 160; r += 16) {
+			x = _mm_aesenc_si128(x, AESNI_LOAD(k + r));
+		}
+		x = _mm_aesenclast_si128(x, AESNI_LOAD(k + 160));
+		_mm_storeu_si128((__m128i *)blk[i], x);
+	}
+}
+
+AES_TARGET static __m128i aesni_key_step(__m128i k, __m128i t)
+{
+	/*w[i] ^= w[i - 1] ^ ... ^ w[i - 4], RotWord and SubWord of the last
+	word and Rcon are computed by AESKEYGENASSIST*/
+	k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+	k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+	k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+	return _mm_xor_si128(k, _mm_shuffle_epi32(t, 0xff));
+}
+
+#define AESNI_KEY_STEP(i, rcon)                                                \
+	k = aesni_key_step(k, _mm_aeskeygenassist_si128(k, rcon));             \
+	_mm_storeu_si128((__m128i *)(rk + 16 * i), k)
+
+AES_TARGET static void aesni_key_expand(const uint8_t key[AES_128_KEY_SIZE],
+					uint8_t rk[AES_128_KEY_SCHEDULE_SIZE])
+{
+	__m128i k = AESNI_LOAD(key);
+	_mm_storeu_si128((__m128i *)rk, k);
+	AESNI_KEY_STEP(1, 0x01);
+	AESNI_KEY_STEP(2, 0x02);
+	AESNI_KEY_STEP(3, 0x04);
+	AESNI_KEY_STEP(4, 0x08);
+	AESNI_KEY_STEP(5, 0x10);
+	AESNI_KEY_STEP(6, 0x20);
+	AESNI_KEY_STEP(7, 0x40);
+	AESNI_KEY_STEP(8, 0x80);
+	AESNI_KEY_STEP(9, 0x1b);
+	AESNI_KEY_STEP(10, 0x36);
+}
+#elif defined(AES_CCM_ARM)
+/*one round of AESE and AESMC, AESE adds the round key before SubBytes and
+ShiftRows*/
+#define ARMCE_ROUND(x, k) vaesmcq_u8(vaeseq_u8(x, vld1q_u8(k)))
+#define ARMCE_LAST(x, k)                                                       \
+	veorq_u8(vaeseq_u8(x, vld1q_u8(k)), vld1q_u8((k) + 16))
+
+AES_TARGET static void armce_encrypt_n(const uint8_t *const rk[],
+				       uint8_t *const blk[], uint32_t n)
+{
+	/*four blocks are enough to fill the pipeline*/
+	uint32_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const uint8_t *k0 = rk[i], *k1 = rk[i + 1];
+		const uint8_t *k2 = rk[i + 2], *k3 = rk[i + 3];
+		uint8x16_t x0 = vld1q_u8(blk[i]);
+		uint8x16_t x1 = vld1q_u8(blk[i + 1]);
+		uint8x16_t x2 = vld1q_u8(blk[i + 2]);
+		uint8x16_t x3 = vld1q_u8(blk[i + 3]);
+		for (uint32_t r = 0; r < 144; r += 16) {
+			x0 = ARMCE_ROUND(x0, k0 + r);
+			x1 = ARMCE_ROUND(x1, k1 + r);
+			x2 = ARMCE_ROUND(x2, k2 + r);
+			x3 = ARMCE_ROUND(x3, k3 + r);
+		}
+		vst1q_u8(blk[i], ARMCE_LAST(x0, k0 + 144));
+		vst1q_u8(blk[i + 1], ARMCE_LAST(x1, k1 + 144));
+		vst1q_u8(blk[i + 2], ARMCE_LAST(x2, k2 + 144));
+		vst1q_u8(blk[i + 3], ARMCE_LAST(x3, k3 + 144));
+	}
+	for (; i < n; i++) {
+		const uint8_t *k = rk[i];
+		uint8x16_t x = vld1q_u8(blk[i]);
+		for (uint32_t r = 0; r < 144; r += 16) {
+			x = ARMCE_ROUND(x, k + r);
+		}
+		vst1q_u8(blk[i], ARMCE_LAST(x, k + 144));
+	}
+}
+#endif
+
+/**
+ * @brief	Returns the block function of the CPU or NULL if it has no
+ *		AES instructions.
+ */
+static aes_encrypt2_t aes_encrypt2_get(void)
+{
+#if defined(AES_CCM_X86) && defined(__GNUC__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("aes")) {
+		return aesni_encrypt2;
+	}
+#elif defined(AES_CCM_ARM)
+#if defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO) ||             \
+	defined(__APPLE__)
+	return armce_encrypt2;
+#elif defined(__linux__)
+	if (0 != (getauxval(AT_HWCAP) & HWCAP_AES)) {
+		return armce_encrypt2;
+	}
+#endif
+#endif
+	return NULL;
+}
+
+/*the detected block function, evaluated once*/
+static aes_encrypt2_t encrypt2;
+static bool encrypt2_detected;
+
+static aes_encrypt2_t aes_encrypt2(void)
+{
+	if (!encrypt2_detected) {
+		encrypt2 = aes_encrypt2_get();
+		encrypt2_detected = true;
+	}
+	return encrypt2;
+}
+
+bool aes_ccm_hw_available(void)
+{
+	return NULL != aes_encrypt2();
+}
+
+/**
+ * @brief	Returns the function encrypting blocks with different keys or
+ *		NULL if the CPU has no AES instructions.
+ */
+static aes_encrypt_n_t aes_encrypt_n(void)
+{
+	if (NULL == aes_encrypt2()) {
+		return NULL;
+	}
+#if defined(AES_CCM_X86)
+	return aesni_encrypt_n;
+#elif defined(AES_CCM_ARM)
+	return armce_encrypt_n;
+#else
+	return NULL;
+#endif
+}
+
+void aes_128_key_expand(const uint8_t key[AES_128_KEY_SIZE],
+			uint8_t rk[AES_128_KEY_SCHEDULE_SIZE])
+{
+#if defined(AES_CCM_X86)
+	/*the expansion in software costs about as much as the AES-CCM of a
+	short message*/
+	if (NULL != aes_encrypt2()) {
+		aesni_key_expand(key, rk);
+		return;
+	}
+#endif
+	aes_128_key_expand_sw(key, rk);
+}
+
+/**
+ * @brief	out = a ^ b for len bytes, full blocks are processed in 64-bit
+ *		words. out may be a.
+ */
+static void block_xor3(uint8_t *out, const uint8_t *a, const uint8_t *b,
+		       uint32_t len)
+{
+	if (AES_BLOCK_SIZE == len) {
+		uint64_t x[2], y[2];
+		memcpy(x, a, sizeof(x));
+		memcpy(y, b, sizeof(y));
+		x[0] ^= y[0];
+		x[1] ^= y[1];
+		memcpy(out, x, sizeof(x));
+		return;
+	}
+	for (uint32_t i = 0; i < len; i++) {
+		out[i] = (uint8_t)(a[i] ^ b[i]);
+	}
+}
+
+static void block_xor(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+	block_xor3(dst, dst, src, len);
+}
+
+static uint64_t be64_get(const uint8_t *p)
+{
+	uint64_t v = 0;
+	for (uint32_t i = 0; i < 8; i++) {
+		v = (v << 8) | p[i];
+	}
+	return v;
+}
+
+static void be64_put(uint8_t *p, uint64_t v)
+{
+	for (uint32_t i = 0; i < 8; i++) {
+		p[i] = (uint8_t)(v >> (56 - 8 * i));
+	}
+}
+
+enum ccm_phase {
+	/*B_0 and A_0*/
+	CCM_START,
+	/*the encoded length and the additional authenticated data*/
+	CCM_AAD,
+	/*the CBC-MAC and the key stream of the payload*/
+	CCM_PAYLOAD,
+	/*the CBC-MAC of the last block when decrypting*/
+	CCM_LAST,
+	CCM_DONE,
+};
+
+/*
+ * One AES-CCM computation, advanced in steps. Each step encrypts one or two
+ * blocks: ccm_blocks() returns them and ccm_absorb() processes the result.
+ * The MAC of a payload block is computed together with the key stream of
+ * the block (encryption) or of the next block (decryption). The steps of
+ * independent computations can be interleaved arbitrarily.
+ */
+struct ccm_lane {
+	const uint8_t *rk;
+	enum aes_operation op;
+	const uint8_t *in;
+	uint8_t *out;
+	uint32_t len;
+	const uint8_t *aad;
+	uint32_t aad_len;
+	/*bytes of the AAD and the payload processed*/
+	uint32_t aad_off;
+	uint32_t off;
+	/*size of the length field*/
+	uint32_t q;
+	uint32_t tag_len;
+	enum ccm_phase phase;
+	/*the MAC of the previous block is due (decryption)*/
+	bool pending;
+	uint8_t mac[AES_BLOCK_SIZE];
+	/*A_0 and the last 8 bytes of the current A_i. The counter fits into
+	them (q <= 8) and never overflows its q bytes, so it is incremented
+	as an integer instead of byte by byte, which would stall the
+	following load of the whole block.*/
+	uint8_t ctr[AES_BLOCK_SIZE];
+	uint64_t ctr_low;
+	uint8_t s0[AES_BLOCK_SIZE];
+	uint8_t ks[AES_BLOCK_SIZE];
+};
+
+/**
+ * @brief	Checks the parameters of aes_ccm_hw() and sets up B_0 and A_0.
+ */
+static enum err ccm_init(struct ccm_lane *l, enum aes_operation op,
+			 const uint8_t *rk, const struct byte_array *in,
+			 const struct byte_array *nonce,
+			 const struct byte_array *aad, struct byte_array *out,
+			 const struct byte_array *tag)
+{
+	uint32_t tag_len = tag->len;
+	if ((nonce->len < 7) || (nonce->len > 13) || (tag_len < 4) ||
+	    (tag_len > AES_BLOCK_SIZE) || (0 != (tag_len & 1))) {
+		return wrong_parameter;
+	}
+	uint32_t len = in->len;
+	if (DECRYPT == op) {
+		if (len < tag_len) {
+			return wrong_parameter;
+		}
+		len -= tag_len;
+	}
+	TRY(check_buffer_size(out->len, len));
+	uint32_t q = 15 - nonce->len;
+	if ((q < 4) && (0 != (len >> (8 * q)))) {
+		return wrong_parameter;
+	}
+
+	memset(l, 0, sizeof(*l));
+	l->rk = rk;
+	l->op = op;
+	l->in = in->ptr;
+	l->out = out->ptr;
+	l->len = len;
+	l->aad = aad->ptr;
+	l->aad_len = aad->len;
+	l->q = q;
+	l->tag_len = tag_len;
+	l->phase = CCM_START;
+
+	l->mac[0] = (uint8_t)(((0 != aad->len) ? 0x40 : 0) |
+			      (((tag_len - 2) / 2) << 3) | (q - 1));
+	memcpy(&l->mac[1], nonce->ptr, nonce->len);
+	for (uint32_t i = 0; i < q && i < 4; i++) {
+		l->mac[AES_BLOCK_SIZE - 1 - i] = (uint8_t)(len >> (8 * i));
+	}
+	l->ctr[0] = (uint8_t)(q - 1);
+	memcpy(&l->ctr[1], nonce->ptr, nonce->len);
+	memcpy(l->s0, l->ctr, sizeof(l->s0));
+	l->ctr_low = be64_get(&l->ctr[8]);
+	return ok;
+}
+
+/**
+ * @brief	Returns the length of the current payload block.
+ */
+static uint32_t ccm_block_len(const struct ccm_lane *l)
+{
+	uint32_t n = l->len - l->off;
+	return (n > AES_BLOCK_SIZE) ? AES_BLOCK_SIZE : n;
+}
+
+/**
+ * @brief	Prepares the next step of a computation.
+ *
+ * @param[in,out] l The computation.
+ * @param[out] blk The blocks to encrypt in place.
+ * @return	The number of blocks, 0 if the computation is done.
+ */
+static uint32_t ccm_blocks(struct ccm_lane *l, uint8_t *blk[2])
+{
+	switch (l->phase) {
+	case CCM_START:
+		blk[0] = l->mac;
+		blk[1] = l->s0;
+		return 2;
+	case CCM_AAD: {
+		/*see RFC 3610 Section 2.2*/
+		uint32_t pos = 0;
+		if (0 == l->aad_off) {
+			uint32_t a = l->aad_len;
+			if (a < 0xFF00) {
+				l->mac[0] ^= (uint8_t)(a >> 8);
+				l->mac[1] ^= (uint8_t)a;
+				pos = 2;
+			} else {
+				l->mac[0] ^= 0xFF;
+				l->mac[1] ^= 0xFE;
+				l->mac[2] ^= (uint8_t)(a >> 24);
+				l->mac[3] ^= (uint8_t)(a >> 16);
+				l->mac[4] ^= (uint8_t)(a >> 8);
+				l->mac[5] ^= (uint8_t)a;
+				pos = 6;
+			}
+		}
+		uint32_t n = AES_BLOCK_SIZE - pos;
+		if (n > l->aad_len - l->aad_off) {
+			n = l->aad_len - l->aad_off;
+		}
+		block_xor(&l->mac[pos], &l->aad[l->aad_off], n);
+		l->aad_off += n;
+		blk[0] = l->mac;
+		return 1;
+	}
+	case CCM_PAYLOAD:
+		l->ctr_low++;
+		memcpy(l->ks, l->ctr, 8);
+		be64_put(&l->ks[8], l->ctr_low);
+		if (ENCRYPT == l->op) {
+			block_xor(l->mac, &l->in[l->off], ccm_block_len(l));
+			blk[0] = l->mac;
+			blk[1] = l->ks;
+			return 2;
+		}
+		blk[0] = l->ks;
+		blk[1] = l->mac;
+		return l->pending ? 2 : 1;
+	case CCM_LAST:
+		blk[0] = l->mac;
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @brief	Processes the blocks encrypted in the step prepared by
+ *		ccm_blocks().
+ */
+static void ccm_absorb(struct ccm_lane *l)
+{
+	enum ccm_phase payload = (0 != l->len) ? CCM_PAYLOAD : CCM_DONE;
+	switch (l->phase) {
+	case CCM_START:
+		l->phase = (0 != l->aad_len) ? CCM_AAD : payload;
+		break;
+	case CCM_AAD:
+		if (l->aad_off == l->aad_len) {
+			l->phase = payload;
+		}
+		break;
+	case CCM_PAYLOAD: {
+		uint32_t n = ccm_block_len(l);
+		block_xor3(&l->out[l->off], &l->in[l->off], l->ks, n);
+		if (DECRYPT == l->op) {
+			block_xor(l->mac, &l->out[l->off], n);
+			l->pending = true;
+		}
+		l->off += n;
+		if (l->off == l->len) {
+			l->phase = l->pending ? CCM_LAST : CCM_DONE;
+		}
+		break;
+	}
+	default:
+		l->phase = CCM_DONE;
+		break;
+	}
+}
+
+/**
+ * @brief	Writes or checks the tag of a finished computation and wipes
+ *		its state.
+ */
+static enum err ccm_finish(struct ccm_lane *l, struct byte_array *tag)
+{
+	block_xor(l->mac, l->s0, l->tag_len);
+	enum err r = ok;
+	if (ENCRYPT == l->op) {
+		/*like the other engines, out holds ciphertext | tag and the
+		tag is also returned separately*/
+		memcpy(l->out + l->len, l->mac, l->tag_len);
+		memcpy(tag->ptr, l->mac, l->tag_len);
+	} else {
+		uint8_t diff = 0;
+		for (uint32_t i = 0; i < l->tag_len; i++) {
+			diff |= (uint8_t)(l->mac[i] ^ l->in[l->len + i]);
+		}
+		if (0 != diff) {
+			secure_erase(l->out, l->len);
+			r = unexpected_result_from_ext_lib;
+		}
+	}
+	secure_erase((uint8_t *)l, sizeof(*l));
+	return r;
+}
+
+enum err aes_ccm_hw(enum aes_operation op,
+		    const uint8_t rk[AES_128_KEY_SCHEDULE_SIZE],
+		    const struct byte_array *in, const struct byte_array *nonce,
+		    const struct byte_array *aad, struct byte_array *out,
+		    struct byte_array *tag)
+{
+	aes_encrypt2_t enc2 = aes_encrypt2();
+	if (NULL == enc2) {
+		return not_supported_feature;
+	}
+
+	struct ccm_lane l;
+	TRY(ccm_init(&l, op, rk, in, nonce, aad, out, tag));
+
+	uint8_t scratch[AES_BLOCK_SIZE] = { 0 };
+	uint8_t *blk[2];
+	uint32_t k;
+	while (0 != (k = ccm_blocks(&l, blk))) {
+		enc2(rk, blk[0], (2 == k) ? blk[1] : scratch);
+		ccm_absorb(&l);
+	}
+	secure_erase(scratch, sizeof(scratch));
+	return ccm_finish(&l, tag);
+}
+
+void aes_ccm_hw_multi(struct aes_ccm_hw_job *jobs, uint32_t n)
+{
+	aes_encrypt_n_t enc_n = aes_encrypt_n();
+
+	for (uint32_t i = 0; i < n; i += AES_CCM_HW_LANES) {
+		struct aes_ccm_hw_job *job = &jobs[i];
+		struct ccm_lane lanes[AES_CCM_HW_LANES];
+		uint32_t cnt[AES_CCM_HW_LANES] = { 0 };
+		bool active[AES_CCM_HW_LANES] = { false };
+		uint32_t m = n - i;
+		if (m > AES_CCM_HW_LANES) {
+			m = AES_CCM_HW_LANES;
+		}
+
+		for (uint32_t j = 0; j < m; j++) {
+			if (NULL == enc_n) {
+				job[j].result = not_supported_feature;
+				continue;
+			}
+			job[j].result = ccm_init(&lanes[j], job[j].op,
+						 job[j].rk, job[j].in,
+						 job[j].nonce, job[j].aad,
+						 job[j].out, job[j].tag);
+			active[j] = (ok == job[j].result);
+		}
+
+		/*one step of every active computation per kernel call*/
+		const uint8_t *rk[AES_CCM_HW_MAX_BLOCKS];
+		uint8_t *blk[AES_CCM_HW_MAX_BLOCKS];
+		for (;;) {
+			uint32_t b = 0;
+			for (uint32_t j = 0; j < m; j++) {
+				cnt[j] = 0;
+				if (active[j]) {
+					cnt[j] = ccm_blocks(&lanes[j], &blk[b]);
+				}
+				for (uint32_t k = 0; k < cnt[j]; k++) {
+					rk[b + k] = lanes[j].rk;
+				}
+				b += cnt[j];
+			}
+			if (0 == b) {
+				break;
+			}
+			enc_n(rk, blk, b);
+			for (uint32_t j = 0; j < m; j++) {
+				if (0 != cnt[j]) {
+					ccm_absorb(&lanes[j]);
+				}
+			}
+		}
+
+		for (uint32_t j = 0; j < m; j++) {
+			if (active[j]) {
+				job[j].result = ccm_finish(&lanes[j],
+							   job[j].tag);
+			}
+		}
+	}
+}
+
+static enum err aes_ccm_hw_aead(enum aes_operation op,
+				const struct byte_array *in,
+				const struct byte_array *key,
+				struct byte_array *nonce,
+				const struct byte_array *aad,
+				struct byte_array *out, struct byte_array *tag)
+{
+	if (AES_128_KEY_SIZE != key->len) {
+		return wrong_parameter;
+	}
+	uint8_t rk[AES_128_KEY_SCHEDULE_SIZE];
+	aes_128_key_expand(key->ptr, rk);
+	enum err r = aes_ccm_hw(op, rk, in, nonce, aad, out, tag);
+	secure_erase(rk, sizeof(rk));
+	return r;
+}
+
+#if CRYPTO_KEY_STATE_SIZE < AES_128_KEY_SCHEDULE_SIZE
+#error "CRYPTO_KEY_STATE_SIZE is too small for AES_CCM_HW"
+#endif
+
+static enum err aes_ccm_hw_key_import(struct crypto_key *key)
+{
+	if (AES_128_KEY_SIZE != key->key_len) {
+		return wrong_parameter;
+	}
+	aes_128_key_expand(key->key, key->state.buf);
+	return ok;
+}
+
+static enum err aes_ccm_hw_aead_key(enum aes_operation op,
+				    const struct crypto_key *key,
+				    const struct byte_array *in,
+				    struct byte_array *nonce,
+				    const struct byte_array *aad,
+				    struct byte_array *out,
+				    struct byte_array *tag)
+{
+	return aes_ccm_hw(op, key->state.buf, in, nonce, aad, out, tag);
+}
+
+const struct crypto_provider crypto_provider_aes_ccm_hw = {
+	.name = "aes_ccm_hw",
+	.aead = aes_ccm_hw_aead,
+	.key_import = aes_ccm_hw_key_import,
+	.aead_key = aes_ccm_hw_aead_key,
+};
+
+#endif /* AES_CCM_HW */
@@ -0,0 +1,107 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+/*
+ * AES-128-CCM (RFC 3610) with the AES instructions of x86-64/x86 (AES-NI)
+ * and AArch64 (ARMv8 Crypto Extensions), enabled with AES_CCM_HW. Whether
+ * the CPU supports the instructions is detected at runtime. The CBC-MAC
+ * and the CTR encryption are interleaved, i.e. the block of the MAC and the
+ * key stream block of the same position are encrypted together, which
+ * hides the latency of the CTR block behind the serial CBC-MAC.
+ * aes_ccm_hw_multi() interleaves up to AES_CCM_HW_LANES independent
+ * computations in the same way: in each step the blocks of all of them are
+ * encrypted together, so that the pipelined AES units are not idle while a
+ * single CBC-MAC waits for its previous block.
+ */
+
+#ifndef CRYPTO_AES_CCM_H
+#define CRYPTO_AES_CCM_H
+
+#ifdef AES_CCM_HW
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/byte_array.h"
+#include "common/crypto_wrapper.h"
+#include "common/oscore_edhoc_error.h"
+
+#define AES_128_KEY_SIZE 16
+/*11 round keys of AES-128*/
+#define AES_128_KEY_SCHEDULE_SIZE 176
+
+/* Maximal number of computations aes_ccm_hw_multi() interleaves */
+#ifndef AES_CCM_HW_LANES
+#define AES_CCM_HW_LANES 8
+#endif
+
+/* An AES-128-CCM computation of aes_ccm_hw_multi(), the parameters are the
+ * ones of aes_ccm_hw() */
+struct aes_ccm_hw_job {
+	enum aes_operation op;
+	const uint8_t *rk;
+	const struct byte_array *in;
+	const struct byte_array *nonce;
+	const struct byte_array *aad;
+	struct byte_array *out;
+	struct byte_array *tag;
+	/*set to the result of aes_ccm_hw()*/
+	enum err result;
+};
+
+/**
+ * @brief	Expands an AES-128 key. The round keys are stored in the
+ *		byte order of FIPS 197, which is the one used by the AES
+ *		instructions of both architectures.
+ *
+ * @param[in] key The key.
+ * @param[out] rk The round keys.
+ */
+void aes_128_key_expand(const uint8_t key[AES_128_KEY_SIZE],
+			uint8_t rk[AES_128_KEY_SCHEDULE_SIZE]);
+
+/**
+ * @brief	Calculates AES-128-CCM encryption or decryption with expanded
+ *		round keys, see aead() for the parameters.
+ *
+ * @param op	ENCRYPT or DECRYPT.
+ * @param[in] rk The round keys.
+ * @param[in] in The plaintext or the ciphertext followed by the tag.
+ * @param[in] nonce The nonce, 7 to 13 bytes.
+ * @param[in] aad Additional authenticated data.
+ * @param[out] out The ciphertext or the plaintext. When encrypting the
+ *		tag is also written after the ciphertext, i.e. the buffer
+ *		must have room for out->len + tag->len bytes.
+ * @param[in,out] tag The tag, 4 to 16 bytes. When decrypting only its
+ *		length is used.
+ * @return	Ok, not_supported_feature if the CPU has no AES instructions,
+ *		wrong_parameter or unexpected_result_from_ext_lib if the tag
+ *		is not valid (as the other engines).
+ */
+enum err aes_ccm_hw(enum aes_operation op,
+		    const uint8_t rk[AES_128_KEY_SCHEDULE_SIZE],
+		    const struct byte_array *in, const struct byte_array *nonce,
+		    const struct byte_array *aad, struct byte_array *out,
+		    struct byte_array *tag);
+
+/**
+ * @brief	Calculates independent AES-128-CCM encryptions or decryptions,
+ *		AES_CCM_HW_LANES at a time with interleaved AES rounds. Each
+ *		job has the result of aes_ccm_hw() afterwards.
+ *
+ * @param[in,out] jobs The computations.
+ * @param n	Number of computations.
+ */
+void aes_ccm_hw_multi(struct aes_ccm_hw_job *jobs, uint32_t n);
+
+#endif /* AES_CCM_HW */
+
+#endif /* CRYPTO_AES_CCM_H */
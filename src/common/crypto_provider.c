@@ -0,0 +1,436 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "common/crypto_provider.h"
+#include "common/crypto_wrapper.h"
+#include "common/memcpy_s.h"
+#include "common/oscore_edhoc_error.h"
+
+#include "edhoc/buffer_sizes.h"
+
+struct crypto_registration {
+	const struct crypto_provider *provider;
+	enum crypto_op op;
+	int32_t alg;
+	bool selected;
+};
+
+static struct crypto_registration
+	registrations[CRYPTO_PROVIDER_MAX_REGISTRATIONS];
+static uint32_t registrations_len;
+
+/*largest output of an operation run by the benchmark, an EdDSA signature*/
+#define BENCH_OUT_SIZE 64
+
+/*Ed25519 key pair and signature of the empty message, RFC 8032 test 1*/
+static const uint8_t bench_ed25519_sk[] = {
+	0x9d, 0x61, 0xb1, 0x9d, 0xef, 0xfd, 0x5a, 0x60, 0xba, 0x84, 0x4a,
+	0xf4, 0x92, 0xec, 0x2c, 0xc4, 0x44, 0x49, 0xc5, 0x69, 0x7b, 0x32,
+	0x69, 0x19, 0x70, 0x3b, 0xac, 0x03, 0x1c, 0xae, 0x7f, 0x60
+};
+static const uint8_t bench_ed25519_pk[] = {
+	0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7, 0xd5, 0x4b, 0xfe,
+	0xd3, 0xc9, 0x64, 0x07, 0x3a, 0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6,
+	0x23, 0x25, 0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a
+};
+static const uint8_t bench_ed25519_sig[] = {
+	0xe5, 0x56, 0x43, 0x00, 0xc3, 0x60, 0xac, 0x72, 0x90, 0x86, 0xe2,
+	0xcc, 0x80, 0x6e, 0x82, 0x8a, 0x84, 0x87, 0x7f, 0x1e, 0xb8, 0xe5,
+	0xd9, 0x74, 0xd8, 0x73, 0xe0, 0x65, 0x22, 0x49, 0x01, 0x55, 0x5f,
+	0xb8, 0x82, 0x15, 0x90, 0xa3, 0x3b, 0xac, 0xc6, 0x1e, 0x39, 0x70,
+	0x1c, 0xf9, 0xb4, 0x6b, 0xd2, 0x5b, 0xf5, 0xf0, 0x59, 0x5b, 0xbe,
+	0x24, 0x65, 0x51, 0x41, 0x43, 0x8e, 0x7a, 0x10, 0x0b
+};
+
+/*P-256 key pair with the private key 1, i.e. the public key is the base
+point, and an ECDSA signature of the empty message*/
+static const uint8_t bench_p256_pk[] = {
+	0x04, 0x6b, 0x17, 0xd1, 0xf2, 0xe1, 0x2c, 0x42, 0x47, 0xf8, 0xbc,
+	0xe6, 0xe5, 0x63, 0xa4, 0x40, 0xf2, 0x77, 0x03, 0x7d, 0x81, 0x2d,
+	0xeb, 0x33, 0xa0, 0xf4, 0xa1, 0x39, 0x45, 0xd8, 0x98, 0xc2, 0x96,
+	0x4f, 0xe3, 0x42, 0xe2, 0xfe, 0x1a, 0x7f, 0x9b, 0x8e, 0xe7, 0xeb,
+	0x4a, 0x7c, 0x0f, 0x9e, 0x16, 0x2b, 0xce, 0x33, 0x57, 0x6b, 0x31,
+	0x5e, 0xce, 0xcb, 0xb6, 0x40, 0x68, 0x37, 0xbf, 0x51, 0xf5
+};
+static const uint8_t bench_p256_sig[] = {
+	0x47, 0x1c, 0x3e, 0x75, 0x8c, 0x49, 0x04, 0x28, 0x5b, 0xba, 0x7e,
+	0x53, 0x11, 0x8e, 0xd0, 0xf5, 0x24, 0xad, 0xeb, 0x07, 0x57, 0xd2,
+	0x5b, 0xd2, 0xf8, 0xe7, 0xb0, 0xd7, 0x6d, 0xfa, 0x71, 0x4c, 0xd6,
+	0x6a, 0x6b, 0xaa, 0x98, 0x6e, 0x3b, 0xb6, 0x59, 0xfa, 0x89, 0x34,
+	0x21, 0x5d, 0xbc, 0x28, 0xd2, 0x51, 0xf5, 0x23, 0x6c, 0xd1, 0x5a,
+	0x31, 0x0a, 0x1b, 0x32, 0xab, 0x85, 0xda, 0x0d, 0xec
+};
+
+static bool provider_implements(const struct crypto_provider *p,
+				enum crypto_op op)
+{
+	switch (op) {
+	case CRYPTO_OP_AEAD:
+		return NULL != p->aead;
+	case CRYPTO_OP_HASH:
+		return NULL != p->hash;
+	case CRYPTO_OP_HKDF:
+		return (NULL != p->hkdf_extract) && (NULL != p->hkdf_expand);
+	case CRYPTO_OP_ECDH:
+		return NULL != p->ecdh;
+	case CRYPTO_OP_SIGN:
+		return NULL != p->sign;
+	case CRYPTO_OP_VERIFY:
+		return NULL != p->verify;
+	case CRYPTO_OP_KEYGEN:
+		return NULL != p->keygen;
+	default:
+		return false;
+	}
+}
+
+static bool registration_matches(const struct crypto_registration *r,
+				 enum crypto_op op, int32_t alg)
+{
+	return (r->op == op) && (r->alg == alg);
+}
+
+static void registration_select(enum crypto_op op, int32_t alg,
+				const struct crypto_provider *provider)
+{
+	for (uint32_t i = 0; i < registrations_len; i++) {
+		struct crypto_registration *r = &registrations[i];
+		if (registration_matches(r, op, alg)) {
+			r->selected = (r->provider == provider);
+		}
+	}
+}
+
+enum err crypto_provider_register(enum crypto_op op, int32_t alg,
+				  const struct crypto_provider *provider)
+{
+	if ((NULL == provider) || !provider_implements(provider, op)) {
+		return wrong_parameter;
+	}
+
+	bool registered = false;
+	for (uint32_t i = 0; i < registrations_len; i++) {
+		struct crypto_registration *r = &registrations[i];
+		if (registration_matches(r, op, alg) &&
+		    (r->provider == provider)) {
+			registered = true;
+		}
+	}
+	if (!registered) {
+		if (CRYPTO_PROVIDER_MAX_REGISTRATIONS <= registrations_len) {
+			return crypto_provider_table_full;
+		}
+		struct crypto_registration *r =
+			&registrations[registrations_len++];
+		r->provider = provider;
+		r->op = op;
+		r->alg = alg;
+	}
+	registration_select(op, alg, provider);
+	return ok;
+}
+
+enum err crypto_provider_select(enum crypto_op op, int32_t alg,
+				const struct crypto_provider *provider)
+{
+	for (uint32_t i = 0; i < registrations_len; i++) {
+		struct crypto_registration *r = &registrations[i];
+		if (registration_matches(r, op, alg) &&
+		    (r->provider == provider)) {
+			registration_select(op, alg, provider);
+			return ok;
+		}
+	}
+	return wrong_parameter;
+}
+
+const struct crypto_provider *crypto_provider_get(enum crypto_op op,
+						  int32_t alg)
+{
+	for (uint32_t i = 0; i < registrations_len; i++) {
+		const struct crypto_registration *r = &registrations[i];
+		if (r->selected && registration_matches(r, op, alg)) {
+			return r->provider;
+		}
+	}
+	return NULL;
+}
+
+void crypto_provider_unregister_all(void)
+{
+	memset(registrations, 0, sizeof(registrations));
+	registrations_len = 0;
+}
+
+/**
+ * @brief	Runs an operation once with the fixed input of the benchmark.
+ *
+ * @param[in] p	The provider.
+ * @param op	The operation.
+ * @param alg	The algorithm.
+ * @param[out] out The result if it is the same for all correct providers.
+ * @param[out] out_len The length of the result, 0 if the result differs
+ *		between providers, e.g. for ECDSA signatures.
+ * @return	Ok or error code. An error is returned also if a signature
+ *		is not valid.
+ */
+static enum err bench_run(const struct crypto_provider *p, enum crypto_op op,
+			  int32_t alg, uint8_t out[BENCH_OUT_SIZE],
+			  uint32_t *out_len)
+{
+	uint8_t in[32];
+	uint8_t key[32];
+	uint8_t pk[P_256_PUB_KEY_UNCOMPRESSED_SIZE];
+	uint8_t sgn[SIGNATURE_SIZE];
+	for (uint8_t i = 0; i < sizeof(in); i++) {
+		in[i] = i;
+	}
+	memset(key, 0x11, sizeof(key));
+	memset(out, 0, BENCH_OUT_SIZE);
+	*out_len = 0;
+
+	struct byte_array in_ba = BYTE_ARRAY_INIT(in, sizeof(in));
+	struct byte_array key_ba = BYTE_ARRAY_INIT(key, sizeof(key));
+	struct byte_array out_ba = BYTE_ARRAY_INIT(out, BENCH_OUT_SIZE);
+	bool is_eddsa = (EdDSA == alg) || (X25519 == alg);
+	struct byte_array pk_ba = BYTE_ARRAY_INIT(
+		pk, is_eddsa ? 32 : P_256_PUB_KEY_UNCOMPRESSED_SIZE);
+	memcpy(pk, is_eddsa ? bench_ed25519_pk : bench_p256_pk, pk_ba.len);
+
+	switch (op) {
+	case CRYPTO_OP_AEAD: {
+		uint32_t tag_len = (AES_CCM_16_128_128 == alg) ? 16 : 8;
+		struct byte_array k = BYTE_ARRAY_INIT(key, 16);
+		struct byte_array nonce = BYTE_ARRAY_INIT(key, AEAD_IV_SIZE);
+		struct byte_array aad = BYTE_ARRAY_INIT(in, 8);
+		struct byte_array ct = BYTE_ARRAY_INIT(out, sizeof(in));
+		struct byte_array tag =
+			BYTE_ARRAY_INIT(out + sizeof(in), tag_len);
+		TRY(p->aead(ENCRYPT, &in_ba, &k, &nonce, &aad, &ct, &tag));
+		*out_len = (uint32_t)sizeof(in) + tag_len;
+		return ok;
+	}
+	case CRYPTO_OP_HASH:
+		TRY(p->hash((enum hash_alg)alg, &in_ba, &out_ba));
+		*out_len = HASH_SIZE;
+		return ok;
+	case CRYPTO_OP_HKDF: {
+		uint8_t prk[HASH_SIZE];
+		struct byte_array prk_ba = BYTE_ARRAY_INIT(prk, sizeof(prk));
+		struct byte_array info = BYTE_ARRAY_INIT(in, 16);
+		out_ba.len = 32;
+		TRY(p->hkdf_extract((enum hash_alg)alg, &key_ba, &in_ba, prk));
+		TRY(p->hkdf_expand((enum hash_alg)alg, &prk_ba, &info,
+				   &out_ba));
+		*out_len = out_ba.len;
+		return ok;
+	}
+	case CRYPTO_OP_ECDH:
+		if (X25519 == alg) {
+			/*the base point u = 9*/
+			memset(pk, 0, 32);
+			pk[0] = 9;
+		}
+		TRY(p->ecdh((enum ecdh_alg)alg, &key_ba, &pk_ba, out));
+		*out_len = 32;
+		return ok;
+	case CRYPTO_OP_SIGN:
+	case CRYPTO_OP_VERIFY: {
+		memset(key, 0, sizeof(key));
+		if (EdDSA == alg) {
+			memcpy(key, bench_ed25519_sk, sizeof(key));
+			memcpy(sgn, bench_ed25519_sig, sizeof(sgn));
+		} else {
+			key[sizeof(key) - 1] = 1;
+			memcpy(sgn, bench_p256_sig, sizeof(sgn));
+		}
+		/*the empty message*/
+		struct const_byte_array msg = BYTE_ARRAY_INIT(in, 0);
+		struct const_byte_array sgn_ba = BYTE_ARRAY_INIT(sgn, 64);
+		bool result = false;
+		if (CRYPTO_OP_SIGN == op) {
+			TRY(p->sign((enum sign_alg)alg, &key_ba, &pk_ba,
+				    (const struct byte_array *)&msg, sgn));
+			TRY(verify((enum sign_alg)alg, &pk_ba, &msg, &sgn_ba,
+				   &result));
+			*out_len = (EdDSA == alg) ? 64 : 0;
+			memcpy(out, sgn, *out_len);
+		} else {
+			TRY(p->verify((enum sign_alg)alg, &pk_ba, &msg, &sgn_ba,
+				      &result));
+		}
+		return result ? ok : signature_authentication_failed;
+	}
+	case CRYPTO_OP_KEYGEN: {
+		struct byte_array sk_ba = BYTE_ARRAY_INIT(key, sizeof(key));
+		pk_ba.len = 32;
+		TRY(p->keygen((enum ecdh_alg)alg, 1, &sk_ba, &pk_ba));
+		/*P-256 keys are random*/
+		if (X25519 == alg) {
+			memcpy(out, pk, pk_ba.len);
+			*out_len = pk_ba.len;
+		}
+		return ok;
+	}
+	default:
+		return wrong_parameter;
+	}
+}
+
+enum err crypto_provider_benchmark(enum crypto_op op, int32_t alg,
+				   uint32_t iterations, uint32_t (*now)(void),
+				   const struct crypto_provider **selected)
+{
+	uint8_t ref[BENCH_OUT_SIZE];
+	uint32_t ref_len = 0;
+	bool ref_set = false;
+	uint8_t out[BENCH_OUT_SIZE];
+	uint32_t out_len;
+
+	/*the result of the built-in engine is the reference, if it is
+	registered and works*/
+	for (uint32_t i = 0; i < registrations_len; i++) {
+		const struct crypto_registration *r = &registrations[i];
+		if (registration_matches(r, op, alg) &&
+		    (&crypto_provider_builtin == r->provider) &&
+		    (ok == bench_run(r->provider, op, alg, ref, &ref_len))) {
+			ref_set = true;
+		}
+	}
+
+	bool registered = false;
+	const struct crypto_provider *fastest = NULL;
+	uint32_t fastest_time = 0;
+	for (uint32_t i = 0; i < registrations_len; i++) {
+		const struct crypto_registration *r = &registrations[i];
+		if (!registration_matches(r, op, alg)) {
+			continue;
+		}
+		registered = true;
+
+		if (ok != bench_run(r->provider, op, alg, out, &out_len)) {
+			continue;
+		}
+		if (!ref_set) {
+			memcpy(ref, out, sizeof(ref));
+			ref_len = out_len;
+			ref_set = true;
+		} else if ((ref_len != out_len) ||
+			   (0 != memcmp(ref, out, out_len))) {
+			continue;
+		}
+
+		bool failed = false;
+		uint32_t start = now();
+		for (uint32_t j = 0; (j < iterations) && !failed; j++) {
+			failed = (ok != bench_run(r->provider, op, alg, out,
+						  &out_len));
+		}
+		uint32_t time = now() - start;
+		if (!failed && ((NULL == fastest) || (time < fastest_time))) {
+			fastest = r->provider;
+			fastest_time = time;
+		}
+	}
+
+	if (!registered) {
+		return wrong_parameter;
+	}
+	if (NULL == fastest) {
+		return crypto_provider_mismatch;
+	}
+	registration_select(op, alg, fastest);
+	if (NULL != selected) {
+		*selected = fastest;
+	}
+	return ok;
+}
+
+enum err crypto_provider_benchmark_all(uint32_t iterations,
+				       uint32_t (*now)(void))
+{
+	for (uint32_t i = 0; i < registrations_len; i++) {
+		const struct crypto_registration *r = &registrations[i];
+		uint32_t count = 0;
+		bool first = true;
+		for (uint32_t j = 0; j < registrations_len; j++) {
+			if (registration_matches(&registrations[j], r->op,
+						 r->alg)) {
+				first = first && (i <= j);
+				count++;
+			}
+		}
+		/*each algorithm once, when its first registration is reached*/
+		if (first && (1 < count)) {
+			TRY(crypto_provider_benchmark(r->op, r->alg, iterations,
+						      now, NULL));
+		}
+	}
+	return ok;
+}
+
+enum err crypto_key_import(enum aead_alg alg, const struct byte_array *key,
+			   struct crypto_key *out)
+{
+	TRY(check_buffer_size(CRYPTO_KEY_MAX_SIZE, key->len));
+	memset(out, 0, sizeof(*out));
+	const struct crypto_provider *p =
+		crypto_provider_get(CRYPTO_OP_AEAD, alg);
+	if (NULL == p) {
+		p = &crypto_provider_builtin;
+#ifdef AES_CCM_HW
+		if (aes_ccm_hw_available()) {
+			p = &crypto_provider_aes_ccm_hw;
+		}
+#endif
+	}
+	out->provider = p;
+	out->alg = alg;
+	memcpy(out->key, key->ptr, key->len);
+	out->key_len = key->len;
+
+	if (NULL != out->provider->key_import) {
+		enum err r = out->provider->key_import(out);
+		if (ok != r) {
+			secure_erase((uint8_t *)out, sizeof(*out));
+			return r;
+		}
+	}
+	return ok;
+}
+
+void crypto_key_release(struct crypto_key *key)
+{
+	if ((NULL != key->provider) && (NULL != key->provider->key_release)) {
+		key->provider->key_release(key);
+	}
+	secure_erase((uint8_t *)key, sizeof(*key));
+}
+
+enum err aead_with_key(enum aes_operation op, const struct crypto_key *key,
+		       const struct byte_array *in, struct byte_array *nonce,
+		       const struct byte_array *aad, struct byte_array *out,
+		       struct byte_array *tag)
+{
+	const struct crypto_provider *p = key->provider;
+	if (NULL == p) {
+		return wrong_parameter;
+	}
+	if (NULL != p->aead_key) {
+		return p->aead_key(op, key, in, nonce, aad, out, tag);
+	}
+	struct const_byte_array k = BYTE_ARRAY_INIT(key->key, key->key_len);
+	return p->aead(op, in, (const struct byte_array *)&k, nonce, aad, out,
+		       tag);
+}
@@ -0,0 +1,839 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#ifdef SHA256_HW
+
+#include <stddef.h>
+#include <string.h>
+
+#include "crypto_sha256.h"
+
+#include "common/crypto_provider.h"
+#include "common/crypto_wrapper.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SHA256_X86
+#define SHA_TARGET __attribute__((target("sha,sse4.1")))
+#define MULTI_TARGET __attribute__((target("avx2")))
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define SHA256_ARM
+#if defined(__clang__)
+#define SHA_TARGET __attribute__((target("sha2")))
+#else
+#define SHA_TARGET __attribute__((target("+sha2")))
+#endif
+#if defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2 (1 << 6)
+#endif
+#endif
+#endif
+
+/*compresses n consecutive blocks into h*/
+typedef void (*sha256_compress_t)(uint32_t h[8], const uint8_t *in,
+				  uint32_t n);
+
+static const uint32_t k256[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+	0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+	0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+	0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+	0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+	0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+	0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+	0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+	0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t h256[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372,
+				  0xa54ff53a, 0x510e527f, 0x9b05688c,
+				  0x1f83d9ab, 0x5be0cd19 };
+
+static uint32_t be32_get(const uint8_t *p)
+{
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+	       ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static void be32_put(uint8_t *p, uint32_t v)
+{
+	p[0] = (uint8_t)(v >> 24);
+	p[1] = (uint8_t)(v >> 16);
+	p[2] = (uint8_t)(v >> 8);
+	p[3] = (uint8_t)v;
+}
+
+static uint32_t ror32(uint32_t x, uint32_t n)
+{
+	return (x >> n) | (x << (32 - n));
+}
+
+static void sha256_compress_sw(uint32_t h[8], const uint8_t *in, uint32_t n)
+{
+	uint32_t w[64];
+	for (; n > 0; n--, in += SHA256_BLOCK_SIZE) {
+		for (uint32_t t = 0; t < 16; t++) {
+			w[t] = be32_get(in + 4 * t);
+		}
+		for (uint32_t t = 16; t < 64; t++) {
+			uint32_t s0 = ror32(w[t - 15], 7) ^
+				      ror32(w[t - 15], 18) ^ (w[t - 15] >> 3);
+			uint32_t s1 = ror32(w[t - 2], 17) ^
+				      ror32(w[t - 2], 19) ^ (w[t - 2] >> 10);
+			w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+		}
+		uint32_t a = h[0], b = h[1], c = h[2], d = h[3];
+		uint32_t e = h[4], f = h[5], g = h[6], hh = h[7];
+		for (uint32_t t = 0; t < 64; t++) {
+			uint32_t t1 = hh +
+				      (ror32(e, 6) ^ ror32(e, 11) ^
+				       ror32(e, 25)) +
+				      ((e & f) ^ (~e & g)) + k256[t] + w[t];
+			uint32_t t2 = (ror32(a, 2) ^ ror32(a, 13) ^
+				       ror32(a, 22)) +
+				      ((a & b) ^ (a & c) ^ (b & c));
+			hh = g;
+			g = f;
+			f = e;
+			e = d + t1;
+			d = c;
+			c = b;
+			b = a;
+			a = t1 + t2;
+		}
+		h[0] += a;
+		h[1] += b;
+		h[2] += c;
+		h[3] += d;
+		h[4] += e;
+		h[5] += f;
+		h[6] += g;
+		h[7] += hh;
+	}
+	memset(w, 0, sizeof(w));
+}
+
+#if defined(SHA256_X86)
+/*four rounds with the message words m, which hold W[4g..4g+3]*/
+#define SHANI_ROUNDS(g, m)                                                     \
+	do {                                                                   \
+		__m128i t_ = _mm_add_epi32(                                    \
+			m, _mm_loadu_si128((const __m128i *)&k256[4 * (g)]));  \
+		s1 = _mm_sha256rnds2_epu32(s1, s0, t_);                        \
+		t_ = _mm_shuffle_epi32(t_, 0x0e);                              \
+		s0 = _mm_sha256rnds2_epu32(s0, s1, t_);                        \
+	} while (0)
+
+/*W[4g+16..4g+19] from the message words of the groups g to g+3*/
+#define SHANI_SCHEDULE(m0, m1, m2, m3)                                         \
+	m0 = _mm_sha256msg2_epu32(                                             \
+		_mm_add_epi32(_mm_sha256msg1_epu32(m0, m1),                    \
+			      _mm_alignr_epi8(m3, m2, 4)),                     \
+		m3)
+
+SHA_TARGET static void sha256_compress_shani(uint32_t h[8], const uint8_t *in,
+					     uint32_t n)
+{
+	const __m128i bswap =
+		_mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+	/*the instructions keep the state as ABEF and CDGH*/
+	__m128i t = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&h[0]),
+				      0xb1);
+	__m128i s1 = _mm_shuffle_epi32(
+		_mm_loadu_si128((const __m128i *)&h[4]), 0x1b);
+	__m128i s0 = _mm_alignr_epi8(t, s1, 8);
+	s1 = _mm_blend_epi16(s1, t, 0xf0);
+
+	for (; n > 0; n--, in += SHA256_BLOCK_SIZE) {
+		__m128i abef = s0;
+		__m128i cdgh = s1;
+		__m128i m0 = _mm_shuffle_epi8(
+			_mm_loadu_si128((const __m128i *)(in + 0)), bswap);
+		__m128i m1 = _mm_shuffle_epi8(
+			_mm_loadu_si128((const __m128i *)(in + 16)), bswap);
+		__m128i m2 = _mm_shuffle_epi8(
+			_mm_loadu_si128((const __m128i *)(in + 32)), bswap);
+		__m128i m3 = _mm_shuffle_epi8(
+			_mm_loadu_si128((const __m128i *)(in + 48)), bswap);
+
+		for (uint32_t g = 0; g < 12; g += 4) {
+			SHANI_ROUNDS(g, m0);
+			SHANI_SCHEDULE(m0, m1, m2, m3);
+			SHANI_ROUNDS(g + 1, m1);
+			SHANI_SCHEDULE(m1, m2, m3, m0);
+			SHANI_ROUNDS(g + 2, m2);
+			SHANI_SCHEDULE(m2, m3, m0, m1);
+			SHANI_ROUNDS(g + 3, m3);
+			SHANI_SCHEDULE(m3, m0, m1, m2);
+		}
+		SHANI_ROUNDS(12, m0);
+		SHANI_ROUNDS(13, m1);
+		SHANI_ROUNDS(14, m2);
+		SHANI_ROUNDS(15, m3);
+
+		s0 = _mm_add_epi32(s0, abef);
+		s1 = _mm_add_epi32(s1, cdgh);
+	}
+
+	t = _mm_shuffle_epi32(s0, 0x1b);
+	s1 = _mm_shuffle_epi32(s1, 0xb1);
+	_mm_storeu_si128((__m128i *)&h[0], _mm_blend_epi16(t, s1, 0xf0));
+	_mm_storeu_si128((__m128i *)&h[4], _mm_alignr_epi8(s1, t, 8));
+}
+
+#define ROR8(x, n)                                                             \
+	_mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+/**
+ * @brief	Compresses one block of each of eight messages, the words of
+ *		the eight states are kept in the lanes of the AVX2 registers.
+ */
+MULTI_TARGET static void
+sha256_compress_x8(uint32_t *const h[SHA256_LANES],
+		   const uint8_t *const in[SHA256_LANES])
+{
+	__m256i s[8];
+	__m256i w[16];
+	for (uint32_t j = 0; j < 8; j++) {
+		s[j] = _mm256_set_epi32(
+			(int)h[7][j], (int)h[6][j], (int)h[5][j], (int)h[4][j],
+			(int)h[3][j], (int)h[2][j], (int)h[1][j], (int)h[0][j]);
+	}
+	__m256i a = s[0], b = s[1], c = s[2], d = s[3];
+	__m256i e = s[4], f = s[5], g = s[6], hh = s[7];
+
+	for (uint32_t t = 0; t < 64; t++) {
+		__m256i wt;
+		if (t < 16) {
+			uint32_t v[SHA256_LANES];
+			for (uint32_t l = 0; l < SHA256_LANES; l++) {
+				v[l] = be32_get(in[l] + 4 * t);
+			}
+			wt = _mm256_loadu_si256((const __m256i *)v);
+		} else {
+			__m256i w15 = w[(t - 15) & 15];
+			__m256i w2 = w[(t - 2) & 15];
+			__m256i s0 = _mm256_xor_si256(
+				_mm256_xor_si256(ROR8(w15, 7), ROR8(w15, 18)),
+				_mm256_srli_epi32(w15, 3));
+			__m256i s1 = _mm256_xor_si256(
+				_mm256_xor_si256(ROR8(w2, 17), ROR8(w2, 19)),
+				_mm256_srli_epi32(w2, 10));
+			wt = _mm256_add_epi32(
+				_mm256_add_epi32(w[t & 15], s0),
+				_mm256_add_epi32(w[(t - 7) & 15], s1));
+		}
+		w[t & 15] = wt;
+
+		__m256i s1 = _mm256_xor_si256(
+			_mm256_xor_si256(ROR8(e, 6), ROR8(e, 11)), ROR8(e, 25));
+		__m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f),
+					      _mm256_andnot_si256(e, g));
+		__m256i t1 = _mm256_add_epi32(
+			_mm256_add_epi32(hh, s1),
+			_mm256_add_epi32(
+				ch, _mm256_add_epi32(
+					    wt, _mm256_set1_epi32(
+							(int)k256[t]))));
+		__m256i s0 = _mm256_xor_si256(
+			_mm256_xor_si256(ROR8(a, 2), ROR8(a, 13)), ROR8(a, 22));
+		__m256i maj = _mm256_xor_si256(
+			_mm256_and_si256(a, _mm256_xor_si256(b, c)),
+			_mm256_and_si256(b, c));
+		hh = g;
+		g = f;
+		f = e;
+		e = _mm256_add_epi32(d, t1);
+		d = c;
+		c = b;
+		b = a;
+		a = _mm256_add_epi32(t1, _mm256_add_epi32(s0, maj));
+	}
+
+	s[0] = _mm256_add_epi32(s[0], a);
+	s[1] = _mm256_add_epi32(s[1], b);
+	s[2] = _mm256_add_epi32(s[2], c);
+	s[3] = _mm256_add_epi32(s[3], d);
+	s[4] = _mm256_add_epi32(s[4], e);
+	s[5] = _mm256_add_epi32(s[5], f);
+	s[6] = _mm256_add_epi32(s[6], g);
+	s[7] = _mm256_add_epi32(s[7], hh);
+	for (uint32_t j = 0; j < 8; j++) {
+		uint32_t v[SHA256_LANES];
+		_mm256_storeu_si256((__m256i *)v, s[j]);
+		for (uint32_t l = 0; l < SHA256_LANES; l++) {
+			h[l][j] = v[l];
+		}
+	}
+}
+#elif defined(SHA256_ARM)
+SHA_TARGET static void sha256_compress_armv8(uint32_t h[8], const uint8_t *in,
+					     uint32_t n)
+{
+	uint32x4_t s0 = vld1q_u32(&h[0]);
+	uint32x4_t s1 = vld1q_u32(&h[4]);
+
+	for (; n > 0; n--, in += SHA256_BLOCK_SIZE) {
+		uint32x4_t abcd = s0;
+		uint32x4_t efgh = s1;
+		uint32x4_t m[4];
+		for (uint32_t i = 0; i < 4; i++) {
+			m[i] = vreinterpretq_u32_u8(
+				vrev32q_u8(vld1q_u8(in + 16 * i)));
+		}
+		for (uint32_t g = 0; g < 16; g++) {
+			uint32x4_t t = vaddq_u32(m[g & 3],
+						 vld1q_u32(&k256[4 * g]));
+			uint32x4_t s = s0;
+			s0 = vsha256hq_u32(s0, s1, t);
+			s1 = vsha256h2q_u32(s1, s, t);
+			if (g < 12) {
+				m[g & 3] = vsha256su1q_u32(
+					vsha256su0q_u32(m[g & 3],
+							m[(g + 1) & 3]),
+					m[(g + 2) & 3], m[(g + 3) & 3]);
+			}
+		}
+		s0 = vaddq_u32(s0, abcd);
+		s1 = vaddq_u32(s1, efgh);
+	}
+	vst1q_u32(&h[0], s0);
+	vst1q_u32(&h[4], s1);
+}
+#endif
+
+/**
+ * @brief	Returns the block function using the SHA instructions of the
+ *		CPU or NULL if it has none.
+ */
+static sha256_compress_t sha256_compress_get(void)
+{
+#if defined(SHA256_X86) && defined(__GNUC__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1")) {
+		return sha256_compress_shani;
+	}
+#elif defined(SHA256_ARM)
+#if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO) ||            \
+	defined(__APPLE__)
+	return sha256_compress_armv8;
+#elif defined(__linux__)
+	if (0 != (getauxval(AT_HWCAP) & HWCAP_SHA2)) {
+		return sha256_compress_armv8;
+	}
+#endif
+#endif
+	return NULL;
+}
+
+/*the detected block functions, evaluated once*/
+static sha256_compress_t compress_hw;
+static bool multi;
+static bool detected;
+
+static void detect(void)
+{
+	if (!detected) {
+		compress_hw = sha256_compress_get();
+#if defined(SHA256_X86) && defined(__GNUC__)
+		/*a single message with SHA-NI is faster than a lane of the
+		AVX2 mode*/
+		__builtin_cpu_init();
+		multi = (NULL == compress_hw) &&
+			__builtin_cpu_supports("avx2");
+#endif
+		detected = true;
+	}
+}
+
+bool sha256_hw_available(void)
+{
+	detect();
+	return NULL != compress_hw;
+}
+
+bool sha256_multi_available(void)
+{
+	detect();
+	return multi;
+}
+
+static void compress(uint32_t h[8], const uint8_t *in, uint32_t n)
+{
+	detect();
+	if (NULL != compress_hw) {
+		compress_hw(h, in, n);
+	} else {
+		sha256_compress_sw(h, in, n);
+	}
+}
+
+void sha256_init(struct sha256_state *s)
+{
+	memcpy(s->h, h256, sizeof(s->h));
+	s->len = 0;
+	s->buf_len = 0;
+}
+
+void sha256_update(struct sha256_state *s, const uint8_t *in, uint32_t len)
+{
+	/*empty pieces may have no buffer*/
+	if (0 == len) {
+		return;
+	}
+	s->len += len;
+	if (0 != s->buf_len) {
+		uint32_t fill = SHA256_BLOCK_SIZE - s->buf_len;
+		if (len < fill) {
+			memcpy(s->buf + s->buf_len, in, len);
+			s->buf_len += len;
+			return;
+		}
+		memcpy(s->buf + s->buf_len, in, fill);
+		compress(s->h, s->buf, 1);
+		s->buf_len = 0;
+		in += fill;
+		len -= fill;
+	}
+	uint32_t blocks = len / SHA256_BLOCK_SIZE;
+	if (0 != blocks) {
+		compress(s->h, in, blocks);
+		in += blocks * SHA256_BLOCK_SIZE;
+		len -= blocks * SHA256_BLOCK_SIZE;
+	}
+	if (0 != len) {
+		memcpy(s->buf, in, len);
+		s->buf_len = len;
+	}
+}
+
+/**
+ * @brief	Writes the padding of a message of total_len bytes after its
+ *		last rem bytes, which are already at the start of tail.
+ *
+ * @return	The number of blocks in tail, 1 or 2.
+ */
+static uint32_t pad(uint8_t tail[2 * SHA256_BLOCK_SIZE], uint32_t rem,
+		    uint64_t total_len)
+{
+	uint32_t blocks = (rem < SHA256_BLOCK_SIZE - 8) ? 1 : 2;
+	uint32_t end = blocks * SHA256_BLOCK_SIZE;
+	tail[rem] = 0x80;
+	memset(tail + rem + 1, 0, end - rem - 1);
+	uint64_t bits = total_len * 8;
+	for (uint32_t i = 0; i < 8; i++) {
+		tail[end - 1 - i] = (uint8_t)(bits >> (8 * i));
+	}
+	return blocks;
+}
+
+void sha256_final(struct sha256_state *s, uint8_t out[SHA256_DIGEST_SIZE])
+{
+	uint8_t tail[2 * SHA256_BLOCK_SIZE];
+	memcpy(tail, s->buf, s->buf_len);
+	compress(s->h, tail, pad(tail, s->buf_len, s->len));
+	for (uint32_t i = 0; i < 8; i++) {
+		be32_put(out + 4 * i, s->h[i]);
+	}
+	secure_erase(tail, sizeof(tail));
+	secure_erase((uint8_t *)s, sizeof(*s));
+}
+
+/**
+ * @brief	Computes the states of HMAC after the inner and the outer key
+ *		block (RFC 2104).
+ */
+static void sha256_hmac_keys(const struct byte_array *key,
+			     struct sha256_state *inner,
+			     struct sha256_state *outer)
+{
+	uint8_t k[SHA256_BLOCK_SIZE];
+	memset(k, 0, sizeof(k));
+	if (key->len > SHA256_BLOCK_SIZE) {
+		sha256_init(inner);
+		sha256_update(inner, key->ptr, key->len);
+		sha256_final(inner, k);
+	} else if (0 != key->len) {
+		memcpy(k, key->ptr, key->len);
+	}
+	for (uint32_t i = 0; i < sizeof(k); i++) {
+		k[i] ^= 0x36;
+	}
+	sha256_init(inner);
+	sha256_update(inner, k, sizeof(k));
+	for (uint32_t i = 0; i < sizeof(k); i++) {
+		k[i] ^= 0x36 ^ 0x5c;
+	}
+	sha256_init(outer);
+	sha256_update(outer, k, sizeof(k));
+	secure_erase(k, sizeof(k));
+}
+
+/**
+ * @brief	Finishes an HMAC, the outer state is used up.
+ */
+static void sha256_hmac_final(struct sha256_state *inner,
+			      struct sha256_state *outer,
+			      uint8_t out[SHA256_DIGEST_SIZE])
+{
+	uint8_t ih[SHA256_DIGEST_SIZE];
+	sha256_final(inner, ih);
+	sha256_update(outer, ih, sizeof(ih));
+	sha256_final(outer, out);
+	secure_erase(ih, sizeof(ih));
+}
+
+/*
+ * One message of the multi-buffer mode: the state, the full blocks still to
+ * be compressed and the padded last blocks.
+ */
+struct lane {
+	uint32_t h[8];
+	const uint8_t *data;
+	uint32_t blocks;
+	uint8_t tail[2 * SHA256_BLOCK_SIZE];
+	uint32_t tail_blocks;
+	uint32_t tail_next;
+};
+
+/**
+ * @brief	Prepares a lane that continues after prefix_len bytes (a
+ *		multiple of the block size) with msg and optionally one more
+ *		byte.
+ */
+static void lane_set(struct lane *l, const uint32_t h[8], uint32_t prefix_len,
+		     const struct byte_array *msg, const uint8_t *suffix)
+{
+	memcpy(l->h, h, sizeof(l->h));
+	l->data = msg->ptr;
+	l->blocks = msg->len / SHA256_BLOCK_SIZE;
+	uint32_t rem = msg->len % SHA256_BLOCK_SIZE;
+	if (0 != rem) {
+		memcpy(l->tail, msg->ptr + l->blocks * SHA256_BLOCK_SIZE, rem);
+	}
+	uint64_t total = (uint64_t)prefix_len + msg->len;
+	if (NULL != suffix) {
+		l->tail[rem++] = *suffix;
+		total++;
+	}
+	l->tail_blocks = pad(l->tail, rem, total);
+	l->tail_next = 0;
+}
+
+#if defined(SHA256_X86)
+/**
+ * @brief	Compresses all blocks of up to SHA256_LANES lanes with AVX2,
+ *		one block of every unfinished lane per step.
+ */
+static void lanes_run_x8(struct lane *l, uint32_t n)
+{
+	static const uint8_t zero[SHA256_BLOCK_SIZE];
+	uint32_t scratch[8];
+	uint32_t *h[SHA256_LANES];
+	const uint8_t *in[SHA256_LANES];
+
+	while (true) {
+		uint32_t active = 0;
+		for (uint32_t i = 0; i < n; i++) {
+			struct lane *x = &l[i];
+			if (0 != x->blocks) {
+				in[active] = x->data;
+				x->data += SHA256_BLOCK_SIZE;
+				x->blocks--;
+			} else if (x->tail_next < x->tail_blocks) {
+				in[active] = x->tail +
+					     SHA256_BLOCK_SIZE * x->tail_next++;
+			} else {
+				continue;
+			}
+			h[active++] = x->h;
+		}
+		if (0 == active) {
+			return;
+		}
+		if (1 == active) {
+			compress(h[0], in[0], 1);
+			continue;
+		}
+		/*unused lanes compress a dummy block*/
+		for (uint32_t i = active; i < SHA256_LANES; i++) {
+			h[i] = scratch;
+			in[i] = zero;
+		}
+		sha256_compress_x8(h, in);
+	}
+}
+#endif
+
+/**
+ * @brief	Compresses all blocks of up to SHA256_LANES lanes.
+ */
+static void lanes_run(struct lane *l, uint32_t n)
+{
+#if defined(SHA256_X86)
+	if (sha256_multi_available()) {
+		lanes_run_x8(l, n);
+		return;
+	}
+#endif
+	for (uint32_t i = 0; i < n; i++) {
+		compress(l[i].h, l[i].data, l[i].blocks);
+		compress(l[i].h, l[i].tail, l[i].tail_blocks);
+	}
+}
+
+/**
+ * @brief	Prepares a lane that compresses only one block.
+ */
+static void lane_block_set(struct lane *l, const uint8_t *block)
+{
+	memcpy(l->h, h256, sizeof(l->h));
+	l->data = block;
+	l->blocks = 1;
+	l->tail_blocks = 0;
+	l->tail_next = 0;
+}
+
+/**
+ * @brief	Computes the HMACs of up to SHA256_LANES messages, each
+ *		optionally followed by the byte suffix.
+ */
+static void hmac_lanes(const struct byte_array *const key[],
+		       const struct byte_array *const msg[],
+		       const uint8_t *suffix, uint8_t *const out[], uint32_t n)
+{
+	struct lane l[SHA256_LANES];
+	uint32_t h[SHA256_LANES][8];
+	uint8_t k[SHA256_LANES][SHA256_BLOCK_SIZE];
+	uint8_t ih[SHA256_LANES][SHA256_DIGEST_SIZE];
+
+	/*"K XOR ipad", a key longer than a block is hashed*/
+	for (uint32_t i = 0; i < n; i++) {
+		memset(k[i], 0, sizeof(k[i]));
+		if (key[i]->len > SHA256_BLOCK_SIZE) {
+			struct sha256_state s;
+			sha256_init(&s);
+			sha256_update(&s, key[i]->ptr, key[i]->len);
+			sha256_final(&s, k[i]);
+		} else if (0 != key[i]->len) {
+			memcpy(k[i], key[i]->ptr, key[i]->len);
+		}
+		for (uint32_t j = 0; j < SHA256_BLOCK_SIZE; j++) {
+			k[i][j] ^= 0x36;
+		}
+		lane_block_set(&l[i], k[i]);
+	}
+	lanes_run(l, n);
+
+	/*the inner hashes*/
+	for (uint32_t i = 0; i < n; i++) {
+		memcpy(h[i], l[i].h, sizeof(h[i]));
+		lane_set(&l[i], h[i], SHA256_BLOCK_SIZE, msg[i], suffix);
+	}
+	lanes_run(l, n);
+	for (uint32_t i = 0; i < n; i++) {
+		for (uint32_t j = 0; j < 8; j++) {
+			be32_put(ih[i] + 4 * j, l[i].h[j]);
+		}
+	}
+
+	/*"K XOR opad"*/
+	for (uint32_t i = 0; i < n; i++) {
+		for (uint32_t j = 0; j < SHA256_BLOCK_SIZE; j++) {
+			k[i][j] ^= 0x36 ^ 0x5c;
+		}
+		lane_block_set(&l[i], k[i]);
+	}
+	lanes_run(l, n);
+
+	/*the outer hashes*/
+	for (uint32_t i = 0; i < n; i++) {
+		struct byte_array in =
+			BYTE_ARRAY_INIT(ih[i], SHA256_DIGEST_SIZE);
+		memcpy(h[i], l[i].h, sizeof(h[i]));
+		lane_set(&l[i], h[i], SHA256_BLOCK_SIZE, &in, NULL);
+	}
+	lanes_run(l, n);
+	for (uint32_t i = 0; i < n; i++) {
+		for (uint32_t j = 0; j < 8; j++) {
+			be32_put(out[i] + 4 * j, l[i].h[j]);
+		}
+	}
+
+	secure_erase((uint8_t *)l, sizeof(l));
+	secure_erase((uint8_t *)h, sizeof(h));
+	secure_erase((uint8_t *)k, sizeof(k));
+	secure_erase((uint8_t *)ih, sizeof(ih));
+}
+
+static bool same_bytes(const struct byte_array *a, const struct byte_array *b)
+{
+	return (a->len == b->len) &&
+	       ((0 == a->len) || (0 == memcmp(a->ptr, b->ptr, a->len)));
+}
+
+static enum err sha256_hw_hkdf_expand(enum hash_alg alg,
+				      const struct byte_array *prk,
+				      const struct byte_array *info,
+				      struct byte_array *out);
+
+enum err sha256_hkdf_multi(const struct hkdf_sha_256_job *jobs, uint32_t n)
+{
+	static const uint8_t one = 1;
+	enum err r = ok;
+	uint8_t prk_buf[SHA256_LANES][SHA256_DIGEST_SIZE];
+	uint8_t t_buf[SHA256_LANES][SHA256_DIGEST_SIZE];
+	struct byte_array prk[SHA256_LANES];
+	const struct byte_array *key[SHA256_LANES];
+	const struct byte_array *msg[SHA256_LANES];
+	uint8_t *out[SHA256_LANES];
+	uint32_t idx[SHA256_LANES];
+
+	for (uint32_t c = 0; (c < n) && (ok == r); c += SHA256_LANES) {
+		const struct hkdf_sha_256_job *j = &jobs[c];
+		uint32_t m = ((n - c) < SHA256_LANES) ? (n - c) : SHA256_LANES;
+
+		/*HKDF-Extract, a job with the same input as the previous one
+		uses its PRK*/
+		uint32_t e = 0;
+		for (uint32_t i = 0; i < m; i++) {
+			if ((0 != i) &&
+			    same_bytes(j[i - 1].master_secret,
+				       j[i].master_secret) &&
+			    same_bytes(j[i - 1].master_salt,
+				       j[i].master_salt)) {
+				idx[i] = idx[i - 1];
+				continue;
+			}
+			key[e] = j[i].master_salt;
+			msg[e] = j[i].master_secret;
+			out[e] = prk_buf[e];
+			idx[i] = e++;
+		}
+		hmac_lanes(key, msg, NULL, out, e);
+
+		/*HKDF-Expand, T(1) is the output of up to 32 bytes*/
+		uint32_t x = 0;
+		for (uint32_t i = 0; (i < m) && (ok == r); i++) {
+			prk[i].ptr = prk_buf[idx[i]];
+			prk[i].len = SHA256_DIGEST_SIZE;
+			if (j[i].out->len > SHA256_DIGEST_SIZE) {
+				r = sha256_hw_hkdf_expand(SHA_256, &prk[i],
+							  j[i].info, j[i].out);
+				continue;
+			}
+			key[x] = &prk[i];
+			msg[x] = j[i].info;
+			out[x] = t_buf[x];
+			idx[x++] = i;
+		}
+		if (ok == r) {
+			hmac_lanes(key, msg, &one, out, x);
+			for (uint32_t i = 0; i < x; i++) {
+				struct byte_array *o = j[idx[i]].out;
+				memcpy(o->ptr, t_buf[i], o->len);
+			}
+		}
+	}
+
+	secure_erase((uint8_t *)prk_buf, sizeof(prk_buf));
+	secure_erase((uint8_t *)t_buf, sizeof(t_buf));
+	return r;
+}
+
+static enum err sha256_hw_hash(enum hash_alg alg, const struct byte_array *in,
+			       struct byte_array *out)
+{
+	if (SHA_256 != alg) {
+		return crypto_operation_not_implemented;
+	}
+	struct sha256_state s;
+	sha256_init(&s);
+	sha256_update(&s, in->ptr, in->len);
+	sha256_final(&s, out->ptr);
+	out->len = SHA256_DIGEST_SIZE;
+	return ok;
+}
+
+static enum err sha256_hw_hkdf_extract(enum hash_alg alg,
+				       const struct byte_array *salt,
+				       struct byte_array *ikm, uint8_t *out)
+{
+	if (SHA_256 != alg) {
+		return crypto_operation_not_implemented;
+	}
+	/*an empty salt is the same as a string of zeros as HMAC pads the
+	key with zeros*/
+	struct sha256_state inner;
+	struct sha256_state outer;
+	sha256_hmac_keys(salt, &inner, &outer);
+	sha256_update(&inner, ikm->ptr, ikm->len);
+	sha256_hmac_final(&inner, &outer, out);
+	return ok;
+}
+
+static enum err sha256_hw_hkdf_expand(enum hash_alg alg,
+				      const struct byte_array *prk,
+				      const struct byte_array *info,
+				      struct byte_array *out)
+{
+	if (SHA_256 != alg) {
+		return crypto_operation_not_implemented;
+	}
+	/* "N = ceil(L/HashLen)" */
+	uint32_t iterations =
+		(out->len + SHA256_DIGEST_SIZE - 1) / SHA256_DIGEST_SIZE;
+	/* "L length of output keying material in octets (<= 255*HashLen)"*/
+	if (iterations > 255) {
+		return hkdf_failed;
+	}
+
+	/*the key blocks are compressed once for all iterations*/
+	struct sha256_state inner_key;
+	struct sha256_state outer_key;
+	sha256_hmac_keys(prk, &inner_key, &outer_key);
+
+	uint8_t t[SHA256_DIGEST_SIZE];
+	for (uint32_t i = 1; i <= iterations; i++) {
+		struct sha256_state inner = inner_key;
+		struct sha256_state outer = outer_key;
+		uint8_t n = (uint8_t)i;
+		if (i > 1) {
+			sha256_update(&inner, t, sizeof(t));
+		}
+		sha256_update(&inner, info->ptr, info->len);
+		sha256_update(&inner, &n, 1);
+		sha256_hmac_final(&inner, &outer, t);
+
+		uint32_t offset = (i - 1) * SHA256_DIGEST_SIZE;
+		uint32_t len = out->len - offset;
+		memcpy(out->ptr + offset, t,
+		       (len < SHA256_DIGEST_SIZE) ? len : SHA256_DIGEST_SIZE);
+	}
+	secure_erase(t, sizeof(t));
+	secure_erase((uint8_t *)&inner_key, sizeof(inner_key));
+	secure_erase((uint8_t *)&outer_key, sizeof(outer_key));
+	return ok;
+}
+
+const struct crypto_provider crypto_provider_sha256_hw = {
+	.name = "sha256_hw",
+	.hash = sha256_hw_hash,
+	.hkdf_extract = sha256_hw_hkdf_extract,
+	.hkdf_expand = sha256_hw_hkdf_expand,
+};
+
+#endif /* SHA256_HW */
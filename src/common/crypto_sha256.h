@@ -0,0 +1,93 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+/*
+ * SHA-256 (FIPS 180-4) with the SHA instructions of x86-64/x86 (SHA-NI) and
+ * AArch64 (ARMv8 SHA2), enabled with SHA256_HW. Whether the CPU supports the
+ * instructions is detected at runtime. In addition, independent messages
+ * can be hashed together: on x86 CPUs with AVX2 but without SHA-NI eight
+ * messages are processed in the lanes of the vector registers, one block of
+ * each message per step. With SHA-NI a single message is faster than a lane.
+ */
+
+#ifndef CRYPTO_SHA256_H
+#define CRYPTO_SHA256_H
+
+#ifdef SHA256_HW
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/byte_array.h"
+#include "common/crypto_wrapper.h"
+#include "common/oscore_edhoc_error.h"
+
+#define SHA256_BLOCK_SIZE 64
+#define SHA256_DIGEST_SIZE 32
+
+/* Maximal number of messages hashed together */
+#define SHA256_LANES 8
+
+struct sha256_state {
+	uint32_t h[8];
+	/*number of bytes absorbed*/
+	uint64_t len;
+	uint8_t buf[SHA256_BLOCK_SIZE];
+	uint32_t buf_len;
+};
+
+/**
+ * @brief	Starts a SHA-256 computation.
+ *
+ * @param[out] s The state.
+ */
+void sha256_init(struct sha256_state *s);
+
+/**
+ * @brief	Adds a piece of the message.
+ *
+ * @param[in,out] s The state.
+ * @param[in] in The piece.
+ * @param len	Length of the piece.
+ */
+void sha256_update(struct sha256_state *s, const uint8_t *in, uint32_t len);
+
+/**
+ * @brief	Finishes a SHA-256 computation and wipes the state.
+ *
+ * @param[in,out] s The state.
+ * @param[out] out The hash.
+ */
+void sha256_final(struct sha256_state *s, uint8_t out[SHA256_DIGEST_SIZE]);
+
+/**
+ * @brief	Checks if independent messages are hashed in parallel, i.e. if
+ *		the CPU supports AVX2 but not SHA-NI.
+ *
+ * @return	true if the multi-buffer mode is available.
+ */
+bool sha256_multi_available(void);
+
+/**
+ * @brief	Runs several hkdf_sha_256() derivations. Their HMACs are
+ *		computed in parallel if sha256_multi_available(), one after
+ *		the other otherwise. Jobs with the same secret and salt as
+ *		the previous job share the HKDF-Extract.
+ *
+ * @param[in] jobs The derivations.
+ * @param n	Number of derivations.
+ * @return	Ok or error code.
+ */
+enum err sha256_hkdf_multi(const struct hkdf_sha_256_job *jobs, uint32_t n);
+
+#endif /* SHA256_HW */
+
+#endif /* CRYPTO_SHA256_H */
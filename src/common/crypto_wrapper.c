@@ -13,6 +13,7 @@
 #include "edhoc.h"
 
 #include "common/crypto_wrapper.h"
+#include "common/crypto_provider.h"
 #include "common/byte_array.h"
 #include "common/oscore_edhoc_error.h"
 #include "common/print_util.h"
@@ -44,7 +45,17 @@ modify setting in include/psa/crypto_config.h
 
 #endif
 
-#ifdef COMPACT25519
+#ifdef AES_CCM_HW
+#include "crypto_aes_ccm.h"
+#endif
+
+#ifdef SHA256_HW
+#include "crypto_sha256.h"
+#endif
+
+#if defined(CURVE25519_64)
+#include "crypto_25519.h"
+#elif defined(COMPACT25519)
 #include <c25519.h>
 #include <edsign.h>
 #include <compact_x25519.h>
@@ -170,10 +181,12 @@ aead_mock_args_match_predefined(struct edhoc_mock_aead_in_out *predefined,
 }
 #endif // EDHOC_MOCK_CRYPTO_WRAPPER
 
-enum err WEAK aead(enum aes_operation op, const struct byte_array *in,
-		   const struct byte_array *key, struct byte_array *nonce,
-		   const struct byte_array *aad, struct byte_array *out,
-		   struct byte_array *tag)
+static enum err builtin_aead(enum aes_operation op,
+			     const struct byte_array *in,
+			     const struct byte_array *key,
+			     struct byte_array *nonce,
+			     const struct byte_array *aad,
+			     struct byte_array *out, struct byte_array *tag)
 {
 #ifdef EDHOC_MOCK_CRYPTO_WRAPPER
 	for (uint32_t i = 0; i < edhoc_crypto_mock_cb.aead_in_out_count; i++) {
@@ -272,9 +285,9 @@ sign_mock_args_match_predefined(struct edhoc_mock_sign_in_out *predefined,
 }
 #endif // EDHOC_MOCK_CRYPTO_WRAPPER
 
-enum err WEAK sign(enum sign_alg alg, const struct byte_array *sk,
-		   const struct byte_array *pk, const struct byte_array *msg,
-		   uint8_t *out)
+static enum err builtin_sign(enum sign_alg alg, const struct byte_array *sk,
+			     const struct byte_array *pk,
+			     const struct byte_array *msg, uint8_t *out)
 {
 #ifdef EDHOC_MOCK_CRYPTO_WRAPPER
 	for (uint32_t i = 0; i < edhoc_crypto_mock_cb.sign_in_out_count; i++) {
@@ -291,7 +304,10 @@ enum err WEAK sign(enum sign_alg alg, const struct byte_array *sk,
 #endif // EDHOC_MOCK_CRYPTO_WRAPPER
 
 	if (alg == EdDSA) {
-#if defined(COMPACT25519)
+#if defined(CURVE25519_64)
+		crypto_ed25519_sign(out, pk->ptr, sk->ptr, msg->ptr, msg->len);
+		return ok;
+#elif defined(COMPACT25519)
 		edsign_sign(out, pk->ptr, sk->ptr, msg->ptr, msg->len);
 		return ok;
 #endif
@@ -355,12 +371,17 @@ enum err WEAK sign(enum sign_alg alg, const struct byte_array *sk,
 	return unsupported_ecdh_curve;
 }
 
-enum err WEAK verify(enum sign_alg alg, const struct byte_array *pk,
-		     struct const_byte_array *msg, struct const_byte_array *sgn,
-		     bool *result)
+static enum err builtin_verify(enum sign_alg alg,
+			       const struct byte_array *pk,
+			       struct const_byte_array *msg,
+			       struct const_byte_array *sgn, bool *result)
 {
 	if (alg == EdDSA) {
-#ifdef COMPACT25519
+#if defined(CURVE25519_64)
+		*result = crypto_ed25519_verify(sgn->ptr, pk->ptr, msg->ptr,
+						msg->len);
+		return ok;
+#elif defined(COMPACT25519)
 		int verified =
 			edsign_verify(sgn->ptr, pk->ptr, msg->ptr, msg->len);
 		if (verified) {
@@ -429,8 +450,177 @@ enum err WEAK verify(enum sign_alg alg, const struct byte_array *pk,
 	return crypto_operation_not_implemented;
 }
 
-enum err WEAK hkdf_extract(enum hash_alg alg, const struct byte_array *salt,
-			   struct byte_array *ikm, uint8_t *out)
+static enum err builtin_sign_hash(enum sign_alg alg,
+				  const struct byte_array *sk,
+				  const struct byte_array *pk,
+				  const struct byte_array *msg_hash,
+				  uint8_t *out)
+{
+	if (alg == ES256) {
+#if defined(TINYCRYPT)
+		uECC_Curve p256 = uECC_secp256r1();
+		TRY_EXPECT(uECC_sign(sk->ptr, msg_hash->ptr, msg_hash->len, out,
+				     p256),
+			   TC_CRYPTO_SUCCESS);
+		return ok;
+
+#elif defined(MBEDTLS)
+		psa_algorithm_t psa_alg = PSA_ALG_ECDSA(PSA_ALG_SHA_256);
+		psa_key_id_t key_id = PSA_KEY_ID_NULL;
+
+		TRY_EXPECT_PSA(psa_crypto_init(), PSA_SUCCESS, key_id,
+			       unexpected_result_from_ext_lib);
+
+		psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+		psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_SIGN_HASH);
+		psa_set_key_algorithm(&attributes, psa_alg);
+		psa_set_key_type(&attributes, PSA_KEY_TYPE_ECC_KEY_PAIR(
+						      PSA_ECC_FAMILY_SECP_R1));
+		psa_set_key_bits(&attributes,
+				 PSA_BYTES_TO_BITS((size_t)sk->len));
+		psa_set_key_lifetime(&attributes, PSA_KEY_LIFETIME_VOLATILE);
+
+		TRY_EXPECT_PSA(
+			psa_import_key(&attributes, sk->ptr, sk->len, &key_id),
+			PSA_SUCCESS, key_id, unexpected_result_from_ext_lib);
+
+		size_t signature_length;
+		TRY_EXPECT_PSA(psa_sign_hash(key_id, psa_alg, msg_hash->ptr,
+					     msg_hash->len, out, SIGNATURE_SIZE,
+					     &signature_length),
+			       PSA_SUCCESS, key_id,
+			       unexpected_result_from_ext_lib);
+
+		TRY_EXPECT_PSA(signature_length, SIGNATURE_SIZE, key_id,
+			       sign_failed);
+		TRY_EXPECT(psa_destroy_key(key_id), PSA_SUCCESS);
+		return ok;
+#endif
+	}
+	return crypto_operation_not_implemented;
+}
+
+static enum err builtin_verify_hash(enum sign_alg alg,
+				    const struct byte_array *pk,
+				    const struct byte_array *msg_hash,
+				    struct const_byte_array *sgn, bool *result)
+{
+	if (alg == ES256) {
+#if defined(MBEDTLS)
+		psa_algorithm_t psa_alg = PSA_ALG_ECDSA(PSA_ALG_SHA_256);
+		psa_key_id_t key_id = PSA_KEY_ID_NULL;
+
+		TRY_EXPECT_PSA(psa_crypto_init(), PSA_SUCCESS, key_id,
+			       unexpected_result_from_ext_lib);
+
+		psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+		psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_VERIFY_HASH);
+		psa_set_key_algorithm(&attributes, psa_alg);
+		psa_set_key_type(&attributes, PSA_KEY_TYPE_ECC_PUBLIC_KEY(
+						      PSA_ECC_FAMILY_SECP_R1));
+		psa_set_key_bits(&attributes,
+				 PSA_BYTES_TO_BITS(P_256_PRIV_KEY_SIZE));
+		TRY_EXPECT_PSA(
+			psa_import_key(&attributes, pk->ptr, pk->len, &key_id),
+			PSA_SUCCESS, key_id, unexpected_result_from_ext_lib);
+
+		psa_status_t status =
+			psa_verify_hash(key_id, psa_alg, msg_hash->ptr,
+					msg_hash->len, sgn->ptr, sgn->len);
+		*result = (PSA_SUCCESS == status);
+		TRY_EXPECT(psa_destroy_key(key_id), PSA_SUCCESS);
+		return ok;
+#elif defined(TINYCRYPT)
+		uECC_Curve p256 = uECC_secp256r1();
+		uint8_t *pk_ptr = pk->ptr;
+		if ((P_256_PUB_KEY_UNCOMPRESSED_SIZE == pk->len) &&
+		    (0x04 == *pk->ptr)) {
+			pk_ptr++;
+		}
+		*result = (1 == uECC_verify(pk_ptr, msg_hash->ptr,
+					    msg_hash->len, sgn->ptr, p256));
+		return ok;
+#endif
+	}
+	return crypto_operation_not_implemented;
+}
+
+enum err WEAK pk_prepare(enum sign_alg alg, const struct byte_array *pk,
+			 struct prepared_pk *out)
+{
+	memset(out, 0, sizeof(*out));
+	out->alg = alg;
+
+	if ((ES256 == alg) &&
+	    (P_256_PUB_KEY_UNCOMPRESSED_SIZE - 1 == pk->len)) {
+		/*raw x | y, add the prefix of the uncompressed form*/
+		out->pk[0] = 0x04;
+		memcpy(&out->pk[1], pk->ptr, pk->len);
+		out->pk_len = P_256_PUB_KEY_UNCOMPRESSED_SIZE;
+	} else {
+		TRY(_memcpy_s(out->pk, sizeof(out->pk), pk->ptr, pk->len));
+		out->pk_len = pk->len;
+	}
+
+#if defined(MBEDTLS)
+	if ((ES256 == alg) && (P_256_PUB_KEY_UNCOMPRESSED_SIZE == out->pk_len)) {
+		psa_key_id_t key_id = PSA_KEY_ID_NULL;
+		psa_algorithm_t psa_alg = PSA_ALG_ECDSA(PSA_ALG_SHA_256);
+
+		TRY_EXPECT_PSA(psa_crypto_init(), PSA_SUCCESS, key_id,
+			       unexpected_result_from_ext_lib);
+
+		psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+		psa_set_key_usage_flags(&attributes,
+					PSA_KEY_USAGE_VERIFY_MESSAGE |
+						PSA_KEY_USAGE_VERIFY_HASH);
+		psa_set_key_algorithm(&attributes, psa_alg);
+		psa_set_key_type(&attributes, PSA_KEY_TYPE_ECC_PUBLIC_KEY(
+						      PSA_ECC_FAMILY_SECP_R1));
+		psa_set_key_bits(&attributes,
+				 PSA_BYTES_TO_BITS(P_256_PRIV_KEY_SIZE));
+		TRY_EXPECT_PSA(psa_import_key(&attributes, out->pk,
+					      out->pk_len, &key_id),
+			       PSA_SUCCESS, key_id,
+			       unexpected_result_from_ext_lib);
+		out->key_id = (uint32_t)key_id;
+	}
+#endif
+	return ok;
+}
+
+void WEAK pk_release(struct prepared_pk *k)
+{
+#if defined(MBEDTLS)
+	if (PSA_KEY_ID_NULL != (psa_key_id_t)k->key_id) {
+		psa_destroy_key((psa_key_id_t)k->key_id);
+	}
+#endif
+	k->key_id = 0;
+	k->pk_len = 0;
+}
+
+enum err WEAK verify_prepared(const struct prepared_pk *k, enum sign_alg alg,
+			      struct const_byte_array *msg,
+			      struct const_byte_array *sgn, bool *result)
+{
+#if defined(MBEDTLS)
+	if ((alg == k->alg) &&
+	    (PSA_KEY_ID_NULL != (psa_key_id_t)k->key_id)) {
+		psa_status_t status = psa_verify_message(
+			(psa_key_id_t)k->key_id, PSA_ALG_ECDSA(PSA_ALG_SHA_256),
+			msg->ptr, msg->len, sgn->ptr, sgn->len);
+		*result = (PSA_SUCCESS == status);
+		return ok;
+	}
+#endif
+	struct const_byte_array pk = BYTE_ARRAY_INIT(k->pk, k->pk_len);
+	return verify(alg, (const struct byte_array *)&pk, msg, sgn, result);
+}
+
+static enum err builtin_hkdf_extract(enum hash_alg alg,
+				     const struct byte_array *salt,
+				     struct byte_array *ikm, uint8_t *out)
 {
 	/*"Note that [RFC5869] specifies that if the salt is not provided, 
 	it is set to a string of zeros.  For implementation purposes, 
@@ -489,8 +679,10 @@ enum err WEAK hkdf_extract(enum hash_alg alg, const struct byte_array *salt,
 	return ok;
 }
 
-enum err WEAK hkdf_expand(enum hash_alg alg, const struct byte_array *prk,
-			  const struct byte_array *info, struct byte_array *out)
+static enum err builtin_hkdf_expand(enum hash_alg alg,
+				    const struct byte_array *prk,
+				    const struct byte_array *info,
+				    struct byte_array *out)
 {
 	if (alg != SHA_256) {
 		return crypto_operation_not_implemented;
@@ -582,13 +774,78 @@ enum err WEAK hkdf_sha_256(struct byte_array *master_secret,
 	return ok;
 }
 
-enum err WEAK shared_secret_derive(enum ecdh_alg alg,
-				   const struct byte_array *sk,
-				   const struct byte_array *pk,
-				   uint8_t *shared_secret)
+enum err WEAK hkdf_sha_256_multi(const struct hkdf_sha_256_job *jobs,
+				 uint32_t n)
+{
+#ifdef SHA256_HW
+	if ((NULL == crypto_provider_get(CRYPTO_OP_HKDF, SHA_256)) &&
+	    (sha256_hw_available() || sha256_multi_available())) {
+		return sha256_hkdf_multi(jobs, n);
+	}
+#endif
+	for (uint32_t i = 0; i < n; i++) {
+		TRY(hkdf_sha_256(jobs[i].master_secret, jobs[i].master_salt,
+				 jobs[i].info, jobs[i].out));
+	}
+	return ok;
+}
+
+enum err WEAK p256_pk_uncompress(const struct byte_array *in,
+				 struct byte_array *out)
+{
+	TRY(check_buffer_size(out->len, P_256_PUB_KEY_UNCOMPRESSED_SIZE));
+
+	if ((P_256_PUB_KEY_UNCOMPRESSED_SIZE == in->len) &&
+	    (0x04 == in->ptr[0])) {
+		/*already uncompressed*/
+		if (out->ptr != in->ptr) {
+			memmove(out->ptr, in->ptr, in->len);
+		}
+		out->len = in->len;
+		return ok;
+	}
+	if (2 * P_256_PUB_KEY_X_CORD_SIZE == in->len) {
+		memmove(&out->ptr[1], in->ptr, in->len);
+		out->ptr[0] = 0x04;
+		out->len = P_256_PUB_KEY_UNCOMPRESSED_SIZE;
+		return ok;
+	}
+	if ((P_256_PUB_KEY_COMPRESSED_SIZE != in->len) &&
+	    (P_256_PUB_KEY_X_CORD_SIZE != in->len)) {
+		return wrong_parameter;
+	}
+
+	/*the sign of y is irrelevant for ECDH, the x-coordinate of the shared
+	point is the same for both points with the given x-coordinate*/
+	uint8_t x[P_256_PUB_KEY_X_CORD_SIZE];
+	memcpy(x, &in->ptr[in->len - P_256_PUB_KEY_X_CORD_SIZE], sizeof(x));
+
+#if defined(TINYCRYPT)
+	uECC_decompress(x, &out->ptr[1], uECC_secp256r1());
+	out->ptr[0] = 0x04;
+	out->len = P_256_PUB_KEY_UNCOMPRESSED_SIZE;
+	return ok;
+#elif defined(MBEDTLS) /* TINYCRYPT / MBEDTLS */
+	size_t out_len = 0;
+	TRY_EXPECT(crypto_p256_uncompress_point(x, sizeof(x), out->ptr,
+						&out_len, out->len),
+		   PSA_SUCCESS);
+	out->len = (uint32_t)out_len;
+	return ok;
+#else
+	return crypto_operation_not_implemented;
+#endif
+}
+
+static enum err builtin_ecdh(enum ecdh_alg alg, const struct byte_array *sk,
+			     const struct byte_array *pk,
+			     uint8_t *shared_secret)
 {
 	if (alg == X25519) {
-#ifdef COMPACT25519
+#if defined(CURVE25519_64)
+		crypto_x25519(shared_secret, sk->ptr, pk->ptr);
+		return ok;
+#elif defined(COMPACT25519)
 		uint8_t e[F25519_SIZE];
 		f25519_copy(e, sk->ptr);
 		c25519_prepare(e);
@@ -599,14 +856,17 @@ enum err WEAK shared_secret_derive(enum ecdh_alg alg,
 	if (alg == P256) {
 #if defined(TINYCRYPT)
 		uECC_Curve p256 = uECC_secp256r1();
-		uint8_t pk_decompressed[P_256_PUB_KEY_UNCOMPRESSED_SIZE];
+		BYTE_ARRAY_NEW(pk_decompressed, P_256_PUB_KEY_UNCOMPRESSED_SIZE,
+			       P_256_PUB_KEY_UNCOMPRESSED_SIZE);
 
-		uECC_decompress(pk->ptr, pk_decompressed, p256);
+		/*does not decompress keys that are already uncompressed*/
+		TRY(p256_pk_uncompress(pk, &pk_decompressed));
 
-		PRINT_ARRAY("pk_decompressed", pk_decompressed,
-			    2 * P_256_PUB_KEY_X_CORD_SIZE);
+		PRINT_ARRAY("pk_decompressed", pk_decompressed.ptr,
+			    pk_decompressed.len);
 
-		TRY_EXPECT(uECC_shared_secret(pk_decompressed, sk->ptr,
+		/*TinyCrypt expects x | y without the 0x04 prefix*/
+		TRY_EXPECT(uECC_shared_secret(&pk_decompressed.ptr[1], sk->ptr,
 					      shared_secret, p256),
 			   1);
 
@@ -640,23 +900,24 @@ enum err WEAK shared_secret_derive(enum ecdh_alg alg,
 
 		size_t shared_secret_len = 0;
 
-		size_t pk_decompressed_len;
-		uint8_t pk_decompressed[P_256_PUB_KEY_UNCOMPRESSED_SIZE];
+		uint8_t pk_decompressed_buf[P_256_PUB_KEY_UNCOMPRESSED_SIZE];
+		struct byte_array pk_decompressed =
+			BYTE_ARRAY_INIT(pk_decompressed_buf,
+					sizeof(pk_decompressed_buf));
 
-		if (PSA_SUCCESS !=
-			crypto_p256_uncompress_point(pk->ptr, pk->len, pk_decompressed,
-						     &pk_decompressed_len,
-						     sizeof(pk_decompressed))) {
+		/*does not decompress keys that are already uncompressed*/
+		if (ok != p256_pk_uncompress(pk, &pk_decompressed)) {
 			result = unexpected_result_from_ext_lib;
 			goto cleanup;
 		}
 
-		PRINT_ARRAY("pk_decompressed", pk_decompressed,
-			    (uint32_t)pk_decompressed_len);
+		PRINT_ARRAY("pk_decompressed", pk_decompressed.ptr,
+			    pk_decompressed.len);
 
 		if (PSA_SUCCESS !=
-		    psa_raw_key_agreement(PSA_ALG_ECDH, key_id, pk_decompressed,
-					  pk_decompressed_len, shared_secret,
+		    psa_raw_key_agreement(PSA_ALG_ECDH, key_id,
+					  pk_decompressed.ptr,
+					  pk_decompressed.len, shared_secret,
 					  shared_size, &shared_secret_len)) {
 			result = unexpected_result_from_ext_lib;
 			goto cleanup;
@@ -671,11 +932,11 @@ enum err WEAK shared_secret_derive(enum ecdh_alg alg,
 	return crypto_operation_not_implemented;
 }
 
-enum err WEAK ephemeral_dh_key_gen(enum ecdh_alg alg, uint32_t seed,
-				   struct byte_array *sk, struct byte_array *pk)
+static enum err builtin_keygen(enum ecdh_alg alg, uint32_t seed,
+			       struct byte_array *sk, struct byte_array *pk)
 {
 	if (alg == X25519) {
-#ifdef COMPACT25519
+#if defined(CURVE25519_64) || defined(COMPACT25519)
 		uint8_t extended_seed[32];
 #if defined(TINYCRYPT)
 		struct tc_sha256_state_struct s;
@@ -687,14 +948,25 @@ enum err WEAK ephemeral_dh_key_gen(enum ecdh_alg alg, uint32_t seed,
 #elif defined(MBEDTLS) /* TINYCRYPT / MBEDTLS */
 		size_t length;
 		TRY_EXPECT(psa_hash_compute(PSA_ALG_SHA_256, (uint8_t *)&seed,
-					    sizeof(seed), sk->ptr, HASH_SIZE,
-					    &length),
+					    sizeof(seed), extended_seed,
+					    sizeof(extended_seed), &length),
 			   0);
 		if (length != 32) {
 			return sha_failed;
 		}
+#elif defined(SHA256_HW) /* TINYCRYPT / MBEDTLS / SHA256_HW */
+		struct sha256_state s;
+		sha256_init(&s);
+		sha256_update(&s, (uint8_t *)&seed, sizeof(seed));
+		sha256_final(&s, extended_seed);
+#else
+#error "X25519 key generation needs SHA-256 of TINYCRYPT, MBEDTLS or SHA256_HW"
 #endif
+#if defined(CURVE25519_64)
+		crypto_x25519_keygen(sk->ptr, pk->ptr, extended_seed);
+#else
 		compact_x25519_keygen(sk->ptr, pk->ptr, extended_seed);
+#endif
 		pk->len = X25519_KEY_SIZE;
 		sk->len = X25519_KEY_SIZE;
 #endif
@@ -767,8 +1039,8 @@ enum err WEAK ephemeral_dh_key_gen(enum ecdh_alg alg, uint32_t seed,
 	return ok;
 }
 
-enum err WEAK hash(enum hash_alg alg, const struct byte_array *in,
-		   struct byte_array *out)
+static enum err builtin_hash(enum hash_alg alg, const struct byte_array *in,
+			     struct byte_array *out)
 {
 	if (alg == SHA_256) {
 #ifdef TINYCRYPT
@@ -795,3 +1067,542 @@ enum err WEAK hash(enum hash_alg alg, const struct byte_array *in,
 
 	return crypto_operation_not_implemented;
 }
+
+#ifdef SHA256_HW
+/**
+ * @brief	Checks if a hash context holds the state of the in-tree
+ *		SHA-256, which is used if the CPU has SHA instructions.
+ */
+static bool hash_ctx_sha256(const struct hash_ctx *ctx)
+{
+	return (SHA_256 == ctx->alg) && sha256_hw_available();
+}
+#endif
+
+enum err WEAK hash_init(enum hash_alg alg, struct hash_ctx *ctx)
+{
+	ctx->alg = alg;
+#ifdef SHA256_HW
+	if (hash_ctx_sha256(ctx)) {
+		TRY(check_buffer_size((uint32_t)sizeof(ctx->state.buf),
+				      (uint32_t)sizeof(struct sha256_state)));
+		sha256_init((struct sha256_state *)ctx->state.buf);
+		return ok;
+	}
+#endif
+	if (alg == SHA_256) {
+#ifdef TINYCRYPT
+		struct tc_sha256_state_struct *s =
+			(struct tc_sha256_state_struct *)ctx->state.buf;
+		TRY(check_buffer_size((uint32_t)sizeof(ctx->state.buf),
+				      (uint32_t)sizeof(*s)));
+		TRY_EXPECT(tc_sha256_init(s), 1);
+		return ok;
+#endif
+#ifdef MBEDTLS
+		psa_hash_operation_t *op =
+			(psa_hash_operation_t *)ctx->state.buf;
+		TRY(check_buffer_size((uint32_t)sizeof(ctx->state.buf),
+				      (uint32_t)sizeof(*op)));
+		*op = psa_hash_operation_init();
+		if (PSA_SUCCESS != psa_hash_setup(op, PSA_ALG_SHA_256)) {
+			psa_hash_abort(op);
+			return sha_failed;
+		}
+		return ok;
+#endif
+	}
+
+	return crypto_operation_not_implemented;
+}
+
+enum err WEAK hash_update(struct hash_ctx *ctx, const struct byte_array *in)
+{
+	/*empty pieces may have no buffer*/
+	if (0 == in->len) {
+		return ok;
+	}
+#ifdef SHA256_HW
+	if (hash_ctx_sha256(ctx)) {
+		sha256_update((struct sha256_state *)ctx->state.buf, in->ptr,
+			      in->len);
+		return ok;
+	}
+#endif
+	if (ctx->alg == SHA_256) {
+#ifdef TINYCRYPT
+		TRY_EXPECT(tc_sha256_update((struct tc_sha256_state_struct *)
+						    ctx->state.buf,
+					    in->ptr, in->len),
+			   1);
+		return ok;
+#endif
+#ifdef MBEDTLS
+		psa_hash_operation_t *op =
+			(psa_hash_operation_t *)ctx->state.buf;
+		if (PSA_SUCCESS != psa_hash_update(op, in->ptr, in->len)) {
+			psa_hash_abort(op);
+			return sha_failed;
+		}
+		return ok;
+#endif
+	}
+
+	return crypto_operation_not_implemented;
+}
+
+enum err WEAK hash_final(struct hash_ctx *ctx, struct byte_array *out)
+{
+#ifdef SHA256_HW
+	if (hash_ctx_sha256(ctx)) {
+		TRY(check_buffer_size(out->len, HASH_SIZE));
+		sha256_final((struct sha256_state *)ctx->state.buf, out->ptr);
+		out->len = HASH_SIZE;
+		return ok;
+	}
+#endif
+	if (ctx->alg == SHA_256) {
+#ifdef TINYCRYPT
+		TRY(check_buffer_size(out->len, HASH_SIZE));
+		TRY_EXPECT(tc_sha256_final(out->ptr,
+					   (struct tc_sha256_state_struct *)
+						   ctx->state.buf),
+			   1);
+		out->len = HASH_SIZE;
+		return ok;
+#endif
+#ifdef MBEDTLS
+		psa_hash_operation_t *op =
+			(psa_hash_operation_t *)ctx->state.buf;
+		size_t length = 0;
+		/*the operation is released on every error*/
+		enum err r = check_buffer_size(out->len, HASH_SIZE);
+		if ((ok == r) &&
+		    ((PSA_SUCCESS !=
+		      psa_hash_finish(op, out->ptr, HASH_SIZE, &length)) ||
+		     (length != HASH_SIZE))) {
+			r = sha_failed;
+		}
+		if (ok != r) {
+			psa_hash_abort(op);
+			return r;
+		}
+		out->len = HASH_SIZE;
+		PRINT_ARRAY("hash", out->ptr, out->len);
+		return ok;
+#endif
+	}
+
+	return crypto_operation_not_implemented;
+}
+
+enum err WEAK hash_clone(const struct hash_ctx *src, struct hash_ctx *dst)
+{
+	dst->alg = src->alg;
+#ifdef SHA256_HW
+	if (hash_ctx_sha256(src)) {
+		memcpy(dst->state.buf, src->state.buf,
+		       sizeof(struct sha256_state));
+		return ok;
+	}
+#endif
+	if (src->alg == SHA_256) {
+#ifdef TINYCRYPT
+		memcpy(dst->state.buf, src->state.buf,
+		       sizeof(struct tc_sha256_state_struct));
+		return ok;
+#endif
+#ifdef MBEDTLS
+		psa_hash_operation_t *op =
+			(psa_hash_operation_t *)dst->state.buf;
+		*op = psa_hash_operation_init();
+		if (PSA_SUCCESS !=
+		    psa_hash_clone((const psa_hash_operation_t *)src->state.buf,
+				   op)) {
+			psa_hash_abort(op);
+			return sha_failed;
+		}
+		return ok;
+#endif
+	}
+
+	return crypto_operation_not_implemented;
+}
+
+void WEAK hash_abort(struct hash_ctx *ctx)
+{
+#ifdef SHA256_HW
+	if (hash_ctx_sha256(ctx)) {
+		secure_erase(ctx->state.buf, sizeof(ctx->state.buf));
+		return;
+	}
+#endif
+#ifdef MBEDTLS
+	if (ctx->alg == SHA_256) {
+		psa_hash_abort((psa_hash_operation_t *)ctx->state.buf);
+	}
+#endif
+	secure_erase(ctx->state.buf, sizeof(ctx->state.buf));
+}
+
+/* Block size of SHA-256, the only hash used by the EDHOC suites */
+#define HMAC_BLOCK_SIZE 64
+
+#ifdef UNIT_TEST
+static uint32_t hmac_key_setups;
+
+uint32_t hmac_key_setup_count(void)
+{
+	return hmac_key_setups;
+}
+#endif
+
+enum err WEAK hmac_init(enum hash_alg alg, const struct byte_array *key,
+			struct hmac_ctx *ctx)
+{
+	if (alg != SHA_256) {
+		return crypto_operation_not_implemented;
+	}
+#ifdef UNIT_TEST
+	hmac_key_setups++;
+#endif
+
+	/*a zeroed context can be released by hmac_abort() on any error*/
+	memset(ctx, 0, sizeof(*ctx));
+
+	/*"K XOR ipad" and "K XOR opad", a key longer than a block is hashed*/
+	uint8_t pad[HMAC_BLOCK_SIZE];
+	memset(pad, 0, sizeof(pad));
+	struct byte_array k = BYTE_ARRAY_INIT(pad, HASH_SIZE);
+	enum err r = ok;
+	if (key->len > HMAC_BLOCK_SIZE) {
+		r = hash(alg, key, &k);
+	} else if (0 != key->len) {
+		memcpy(pad, key->ptr, key->len);
+	}
+
+	struct byte_array p = BYTE_ARRAY_INIT(pad, sizeof(pad));
+	for (uint32_t i = 0; i < sizeof(pad); i++) {
+		pad[i] ^= 0x36;
+	}
+	if (ok == r) {
+		r = hash_init(alg, &ctx->inner);
+	}
+	if (ok == r) {
+		r = hash_update(&ctx->inner, &p);
+	}
+	for (uint32_t i = 0; i < sizeof(pad); i++) {
+		pad[i] ^= 0x36 ^ 0x5c;
+	}
+	if (ok == r) {
+		r = hash_init(alg, &ctx->outer);
+	}
+	if (ok == r) {
+		r = hash_update(&ctx->outer, &p);
+	}
+	secure_erase(pad, sizeof(pad));
+	if (ok != r) {
+		hmac_abort(ctx);
+	}
+	return r;
+}
+
+enum err WEAK hmac_update(struct hmac_ctx *ctx, const struct byte_array *in)
+{
+	return hash_update(&ctx->inner, in);
+}
+
+enum err WEAK hmac_final(struct hmac_ctx *ctx, struct byte_array *out)
+{
+	uint8_t inner_buf[HASH_SIZE];
+	struct byte_array inner = BYTE_ARRAY_INIT(inner_buf, sizeof(inner_buf));
+	enum err r = hash_final(&ctx->inner, &inner);
+	if (ok == r) {
+		r = hash_update(&ctx->outer, &inner);
+	}
+	if (ok == r) {
+		r = hash_final(&ctx->outer, out);
+	}
+	secure_erase(inner_buf, sizeof(inner_buf));
+	if (ok != r) {
+		hmac_abort(ctx);
+	}
+	return r;
+}
+
+enum err WEAK hmac_clone(const struct hmac_ctx *src, struct hmac_ctx *dst)
+{
+	TRY(hash_clone(&src->inner, &dst->inner));
+	enum err r = hash_clone(&src->outer, &dst->outer);
+	if (ok != r) {
+		hash_abort(&dst->inner);
+	}
+	return r;
+}
+
+void WEAK hmac_abort(struct hmac_ctx *ctx)
+{
+	hash_abort(&ctx->inner);
+	hash_abort(&ctx->outer);
+}
+
+const struct crypto_provider crypto_provider_builtin = {
+	.name = "builtin",
+	.aead = builtin_aead,
+	.hash = builtin_hash,
+	.hkdf_extract = builtin_hkdf_extract,
+	.hkdf_expand = builtin_hkdf_expand,
+	.ecdh = builtin_ecdh,
+	.sign = builtin_sign,
+	.verify = builtin_verify,
+	.sign_hash = builtin_sign_hash,
+	.verify_hash = builtin_verify_hash,
+	.keygen = builtin_keygen,
+};
+
+/* Returned by aead_alg_of() for calls of no enum aead_alg */
+#define AEAD_ALG_NONE 0
+
+/**
+ * @brief	Returns the algorithm of an aead() call. aead() has no
+ *		algorithm parameter, the algorithm is derived from the key and
+ *		tag lengths, which identifies the two AEAD algorithms of
+ *		enum aead_alg (both AES-CCM with a 13-byte nonce). Providers
+ *		of other algorithms are used with crypto_key_import(), which
+ *		takes the algorithm.
+ *
+ * @param[in] key The key.
+ * @param[in] tag The tag.
+ * @return	The algorithm or AEAD_ALG_NONE, for which no provider is
+ *		registered.
+ */
+static int32_t aead_alg_of(const struct byte_array *key,
+			   const struct byte_array *tag)
+{
+	int32_t alg = AEAD_ALG_NONE;
+	if (get_aead_mac_len(AES_CCM_16_128_128) == tag->len) {
+		alg = AES_CCM_16_128_128;
+	} else if (get_aead_mac_len(AES_CCM_16_64_128) == tag->len) {
+		alg = AES_CCM_16_64_128;
+	}
+	if ((AEAD_ALG_NONE != alg) &&
+	    (get_aead_key_len((enum aead_alg)alg) != key->len)) {
+		alg = AEAD_ALG_NONE;
+	}
+	return alg;
+}
+
+enum err WEAK aead(enum aes_operation op, const struct byte_array *in,
+		   const struct byte_array *key, struct byte_array *nonce,
+		   const struct byte_array *aad, struct byte_array *out,
+		   struct byte_array *tag)
+{
+	const struct crypto_provider *p =
+		crypto_provider_get(CRYPTO_OP_AEAD, aead_alg_of(key, tag));
+	if (NULL != p) {
+		return p->aead(op, in, key, nonce, aad, out, tag);
+	}
+#ifdef AES_CCM_HW
+	if ((AES_128_KEY_SIZE == key->len) && aes_ccm_hw_available()) {
+		return crypto_provider_aes_ccm_hw.aead(op, in, key, nonce, aad,
+						       out, tag);
+	}
+#endif
+	return builtin_aead(op, in, key, nonce, aad, out, tag);
+}
+
+#ifdef AES_CCM_HW
+/**
+ * @brief	Runs the jobs collected by aead_multi() for the AES
+ *		instructions and wipes their round keys.
+ */
+static void aead_multi_hw_run(struct aead_job *jobs[],
+			      struct aes_ccm_hw_job *hw,
+			      uint8_t rk[][AES_128_KEY_SCHEDULE_SIZE],
+			      uint32_t n)
+{
+	aes_ccm_hw_multi(hw, n);
+	for (uint32_t i = 0; i < n; i++) {
+		jobs[i]->result = hw[i].result;
+		secure_erase(rk[i], AES_128_KEY_SCHEDULE_SIZE);
+	}
+}
+#endif
+
+enum err WEAK aead_multi(struct aead_job *jobs, uint32_t n)
+{
+#ifdef AES_CCM_HW
+	struct aead_job *hw_jobs[AES_CCM_HW_LANES];
+	struct aes_ccm_hw_job hw[AES_CCM_HW_LANES];
+	uint8_t rk[AES_CCM_HW_LANES][AES_128_KEY_SCHEDULE_SIZE];
+	uint32_t m = 0;
+#endif
+	for (uint32_t i = 0; i < n; i++) {
+		struct aead_job *j = &jobs[i];
+#ifdef AES_CCM_HW
+		/*the jobs aead() would pass to crypto_provider_aes_ccm_hw*/
+		if ((NULL == crypto_provider_get(
+				     CRYPTO_OP_AEAD,
+				     aead_alg_of(j->key, j->tag))) &&
+		    (AES_128_KEY_SIZE == j->key->len) &&
+		    aes_ccm_hw_available()) {
+			aes_128_key_expand(j->key->ptr, rk[m]);
+			hw[m].op = j->op;
+			hw[m].rk = rk[m];
+			hw[m].in = j->in;
+			hw[m].nonce = j->nonce;
+			hw[m].aad = j->aad;
+			hw[m].out = j->out;
+			hw[m].tag = j->tag;
+			hw_jobs[m++] = j;
+			if (AES_CCM_HW_LANES == m) {
+				aead_multi_hw_run(hw_jobs, hw, rk, m);
+				m = 0;
+			}
+			continue;
+		}
+#endif
+		j->result = aead(j->op, j->in, j->key, j->nonce, j->aad, j->out,
+				 j->tag);
+	}
+#ifdef AES_CCM_HW
+	aead_multi_hw_run(hw_jobs, hw, rk, m);
+#endif
+
+	for (uint32_t i = 0; i < n; i++) {
+		if (ok != jobs[i].result) {
+			return jobs[i].result;
+		}
+	}
+	return ok;
+}
+
+enum err WEAK hash(enum hash_alg alg, const struct byte_array *in,
+		   struct byte_array *out)
+{
+	const struct crypto_provider *p =
+		crypto_provider_get(CRYPTO_OP_HASH, alg);
+	if (NULL != p) {
+		return p->hash(alg, in, out);
+	}
+#ifdef SHA256_HW
+	if ((SHA_256 == alg) && sha256_hw_available()) {
+		return crypto_provider_sha256_hw.hash(alg, in, out);
+	}
+#endif
+	return builtin_hash(alg, in, out);
+}
+
+enum err WEAK hkdf_extract(enum hash_alg alg, const struct byte_array *salt,
+			   struct byte_array *ikm, uint8_t *out)
+{
+	const struct crypto_provider *p =
+		crypto_provider_get(CRYPTO_OP_HKDF, alg);
+	if (NULL != p) {
+		return p->hkdf_extract(alg, salt, ikm, out);
+	}
+#ifdef SHA256_HW
+	if ((SHA_256 == alg) && sha256_hw_available()) {
+		return crypto_provider_sha256_hw.hkdf_extract(alg, salt, ikm,
+							      out);
+	}
+#endif
+	return builtin_hkdf_extract(alg, salt, ikm, out);
+}
+
+enum err WEAK hkdf_expand(enum hash_alg alg, const struct byte_array *prk,
+			  const struct byte_array *info, struct byte_array *out)
+{
+	const struct crypto_provider *p =
+		crypto_provider_get(CRYPTO_OP_HKDF, alg);
+	if (NULL != p) {
+		return p->hkdf_expand(alg, prk, info, out);
+	}
+#ifdef SHA256_HW
+	if ((SHA_256 == alg) && sha256_hw_available()) {
+		return crypto_provider_sha256_hw.hkdf_expand(alg, prk, info,
+							     out);
+	}
+#endif
+	return builtin_hkdf_expand(alg, prk, info, out);
+}
+
+enum err WEAK shared_secret_derive(enum ecdh_alg alg,
+				   const struct byte_array *sk,
+				   const struct byte_array *pk,
+				   uint8_t *shared_secret)
+{
+	const struct crypto_provider *p =
+		crypto_provider_get(CRYPTO_OP_ECDH, alg);
+	if (NULL != p) {
+		return p->ecdh(alg, sk, pk, shared_secret);
+	}
+	return builtin_ecdh(alg, sk, pk, shared_secret);
+}
+
+enum err WEAK ephemeral_dh_key_gen(enum ecdh_alg alg, uint32_t seed,
+				   struct byte_array *sk, struct byte_array *pk)
+{
+	const struct crypto_provider *p =
+		crypto_provider_get(CRYPTO_OP_KEYGEN, alg);
+	if (NULL != p) {
+		return p->keygen(alg, seed, sk, pk);
+	}
+	return builtin_keygen(alg, seed, sk, pk);
+}
+
+enum err WEAK sign(enum sign_alg alg, const struct byte_array *sk,
+		   const struct byte_array *pk, const struct byte_array *msg,
+		   uint8_t *out)
+{
+	const struct crypto_provider *p =
+		crypto_provider_get(CRYPTO_OP_SIGN, alg);
+	if (NULL != p) {
+		return p->sign(alg, sk, pk, msg, out);
+	}
+	return builtin_sign(alg, sk, pk, msg, out);
+}
+
+enum err WEAK verify(enum sign_alg alg, const struct byte_array *pk,
+		     struct const_byte_array *msg, struct const_byte_array *sgn,
+		     bool *result)
+{
+	const struct crypto_provider *p =
+		crypto_provider_get(CRYPTO_OP_VERIFY, alg);
+	if (NULL != p) {
+		return p->verify(alg, pk, msg, sgn, result);
+	}
+	return builtin_verify(alg, pk, msg, sgn, result);
+}
+
+enum err WEAK sign_hash(enum sign_alg alg, const struct byte_array *sk,
+			const struct byte_array *pk,
+			const struct byte_array *msg_hash, uint8_t *out)
+{
+	const struct crypto_provider *p =
+		crypto_provider_get(CRYPTO_OP_SIGN, alg);
+	if (NULL != p) {
+		/*a provider that signs only whole messages gets them through
+		sign()*/
+		if (NULL == p->sign_hash) {
+			return crypto_operation_not_implemented;
+		}
+		return p->sign_hash(alg, sk, pk, msg_hash, out);
+	}
+	return builtin_sign_hash(alg, sk, pk, msg_hash, out);
+}
+
+enum err WEAK verify_hash(enum sign_alg alg, const struct byte_array *pk,
+			  const struct byte_array *msg_hash,
+			  struct const_byte_array *sgn, bool *result)
+{
+	const struct crypto_provider *p =
+		crypto_provider_get(CRYPTO_OP_VERIFY, alg);
+	if (NULL != p) {
+		if (NULL == p->verify_hash) {
+			return crypto_operation_not_implemented;
+		}
+		return p->verify_hash(alg, pk, msg_hash, sgn, result);
+	}
+	return builtin_verify_hash(alg, pk, msg_hash, sgn, result);
+}
@@ -38,3 +38,11 @@ enum err _memcpy_s(uint8_t *dest, uint32_t dest_len, const uint8_t *source,
 	memcpy(dest, source, source_len);
 	return ok;
 }
+
+void secure_erase(uint8_t *dest, uint32_t dest_len)
+{
+	volatile uint8_t *p = dest;
+	while (dest_len--) {
+		*p++ = 0;
+	}
+}
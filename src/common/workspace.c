@@ -0,0 +1,83 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stddef.h>
+
+#include "common/byte_array.h"
+#include "common/oscore_edhoc_error.h"
+#include "common/workspace.h"
+
+static WORKSPACE_THREAD_LOCAL struct workspace *selected_ws;
+
+void workspace_init(struct workspace *ws, uint8_t *buf, uint32_t size)
+{
+	ws->buf = buf;
+	ws->size = size;
+	ws->used = 0;
+	ws->peak = 0;
+}
+
+void workspace_select(struct workspace *ws)
+{
+	selected_ws = ws;
+}
+
+struct workspace *workspace_selected(void)
+{
+	return selected_ws;
+}
+
+enum err workspace_alloc(uint32_t size, struct byte_array *out)
+{
+	if (0 == size) {
+		*out = NULL_ARRAY;
+		return ok;
+	}
+	if (NULL == selected_ws) {
+		return workspace_not_selected;
+	}
+
+	uint32_t start = selected_ws->used;
+	uint32_t misalignment =
+		(uint32_t)((uintptr_t)(selected_ws->buf + start) %
+			   WORKSPACE_ALIGN);
+	if (0 != misalignment) {
+		start += WORKSPACE_ALIGN - misalignment;
+	}
+
+	if ((start > selected_ws->size) ||
+	    (size > selected_ws->size - start)) {
+		return workspace_exhausted;
+	}
+
+	out->ptr = selected_ws->buf + start;
+	out->len = size;
+	selected_ws->used = start + size;
+	if (selected_ws->used > selected_ws->peak) {
+		selected_ws->peak = selected_ws->used;
+	}
+	return ok;
+}
+
+uint32_t workspace_mark(void)
+{
+	if (NULL == selected_ws) {
+		return 0;
+	}
+	return selected_ws->used;
+}
+
+void workspace_release(const uint32_t *mark)
+{
+	if ((NULL != selected_ws) && (*mark < selected_ws->used)) {
+		selected_ws->used = *mark;
+	}
+}
@@ -0,0 +1,406 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "edhoc.h"
+#include "edhoc/admission.h"
+#include "edhoc/bstr_encode_decode.h"
+#include "edhoc/buffer_sizes.h"
+#include "edhoc/suites.h"
+
+#include "common/byte_array.h"
+#include "common/crypto_wrapper.h"
+#include "common/memcpy_s.h"
+#include "common/oscore_edhoc_error.h"
+
+#include "cbor/edhoc_decode_message_1.h"
+
+static void admission_lock(struct edhoc_admission *a)
+{
+	if (NULL != a->lock) {
+		a->lock(a->lock_ctx);
+	}
+}
+
+static void admission_unlock(struct edhoc_admission *a)
+{
+	if (NULL != a->unlock) {
+		a->unlock(a->lock_ctx);
+	}
+}
+
+/**
+ * @brief	Gives the major type and the argument of the head of a CBOR
+ *		integer.
+ */
+static void int_head(int32_t value, uint8_t *major_type, uint32_t *arg)
+{
+	if (value < 0) {
+		*major_type = CBOR_MAJOR_TYPE_NINT;
+		*arg = (uint32_t)(-1 - value);
+	} else {
+		*major_type = CBOR_MAJOR_TYPE_UINT;
+		*arg = (uint32_t)value;
+	}
+}
+
+/**
+ * @brief	Encodes a CBOR integer followed by the cookie as byte string,
+ *		i.e. the challenge or its answer.
+ */
+static enum err cookie_item_encode(int32_t label, const uint8_t *cookie,
+				   struct byte_array *out)
+{
+	uint8_t major_type;
+	uint32_t arg;
+	int_head(label, &major_type, &arg);
+
+	uint32_t size = out->len;
+	out->len = 0;
+	TRY(cbor_head_append(out, size, major_type, arg));
+	TRY(cbor_head_append(out, size, CBOR_MAJOR_TYPE_BSTR,
+			     EDHOC_ADMISSION_COOKIE_SIZE));
+	TRY(_memcpy_s(out->ptr + out->len, size - out->len, cookie,
+		      EDHOC_ADMISSION_COOKIE_SIZE));
+	out->len += EDHOC_ADMISSION_COOKIE_SIZE;
+	return ok;
+}
+
+/**
+ * @brief	Decodes a CBOR integer with a given value followed by a cookie,
+ *		see cookie_item_encode().
+ *
+ * @param[in] in The encoded item.
+ * @param label	The expected integer.
+ * @param[out] cookie The cookie, EDHOC_ADMISSION_COOKIE_SIZE bytes.
+ * @return	true if the item was found.
+ */
+static bool cookie_item_decode(const struct byte_array *in, int32_t label,
+			       uint8_t *cookie)
+{
+	uint8_t expected_type, major_type;
+	uint32_t expected_arg, arg, head_len;
+	int_head(label, &expected_type, &expected_arg);
+
+	if ((ok != decode_cbor_head(in, &major_type, &arg, &head_len)) ||
+	    (expected_type != major_type) || (expected_arg != arg)) {
+		return false;
+	}
+
+	struct byte_array value =
+		BYTE_ARRAY_INIT(in->ptr + head_len, in->len - head_len);
+	if ((ok != decode_cbor_head(&value, &major_type, &arg, &head_len)) ||
+	    (CBOR_MAJOR_TYPE_BSTR != major_type) ||
+	    (EDHOC_ADMISSION_COOKIE_SIZE != arg) ||
+	    (value.len - head_len < EDHOC_ADMISSION_COOKIE_SIZE)) {
+		return false;
+	}
+	memcpy(cookie, value.ptr + head_len, EDHOC_ADMISSION_COOKIE_SIZE);
+	return true;
+}
+
+/**
+ * @brief	Computes the cookie of a source for a time window.
+ */
+static enum err cookie_compute(struct edhoc_admission *a,
+			       const struct byte_array *source, uint32_t window,
+			       uint8_t *cookie)
+{
+	struct hmac_ctx ctx;
+	uint8_t mac_buf[HASH_SIZE];
+	uint8_t window_buf[4] = { (uint8_t)(window >> 24),
+				  (uint8_t)(window >> 16),
+				  (uint8_t)(window >> 8), (uint8_t)window };
+	struct byte_array key =
+		BYTE_ARRAY_INIT(a->cookie_key, sizeof(a->cookie_key));
+	struct byte_array w = BYTE_ARRAY_INIT(window_buf, sizeof(window_buf));
+	struct byte_array mac = BYTE_ARRAY_INIT(mac_buf, sizeof(mac_buf));
+
+	TRY(hmac_init(SHA_256, &key, &ctx));
+	TRY(hmac_update(&ctx, &w));
+	TRY(hmac_update(&ctx, source));
+	TRY(hmac_final(&ctx, &mac));
+	memcpy(cookie, mac_buf, EDHOC_ADMISSION_COOKIE_SIZE);
+	return ok;
+}
+
+/**
+ * @brief	Searches the EAD items of message_1 for a valid cookie of the
+ *		source.
+ */
+static bool cookie_valid(struct edhoc_admission *a,
+			 const struct byte_array *source,
+			 const struct byte_array *ead_1, uint32_t now)
+{
+	uint8_t cookie[EDHOC_ADMISSION_COOKIE_SIZE];
+	uint8_t expected[EDHOC_ADMISSION_COOKIE_SIZE];
+	struct byte_array ead = *ead_1;
+	bool found = false;
+
+	/*EAD_1 is a sequence of labels, each optionally followed by a bstr*/
+	while (0 != ead.len) {
+		uint8_t major_type;
+		uint32_t arg, head_len;
+		found = cookie_item_decode(&ead, EDHOC_ADMISSION_EAD_LABEL,
+					   cookie);
+		if (found) {
+			break;
+		}
+		if ((ok != decode_cbor_head(&ead, &major_type, &arg,
+					    &head_len)) ||
+		    (CBOR_MAJOR_TYPE_NINT < major_type)) {
+			return false;
+		}
+		ead.ptr += head_len;
+		ead.len -= head_len;
+		if ((ok == decode_cbor_head(&ead, &major_type, &arg,
+					    &head_len)) &&
+		    (CBOR_MAJOR_TYPE_BSTR == major_type)) {
+			if (ead.len - head_len < arg) {
+				return false;
+			}
+			ead.ptr += head_len + arg;
+			ead.len -= head_len + arg;
+		}
+	}
+	if (!found) {
+		return false;
+	}
+
+	/*the cookie of the current or the previous window is accepted*/
+	uint32_t window = now / a->cookie_lifetime;
+	for (uint32_t i = 0; i < 2; i++) {
+		if ((ok == cookie_compute(a, source, window - i, expected)) &&
+		    (0 == memcmp(cookie, expected, sizeof(expected)))) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief	Takes a token from the bucket of a source. Must be called with
+ *		the admission locked.
+ * @return	false if the bucket is empty.
+ */
+static bool token_take(struct edhoc_admission *a,
+		       const struct byte_array *source, uint32_t now)
+{
+	if ((0 == a->period) || (0 == a->buckets_len)) {
+		return true;
+	}
+
+	struct edhoc_admission_bucket *b = NULL;
+	struct edhoc_admission_bucket *free_b = NULL;
+	for (uint32_t i = 0; (NULL == b) && (i < a->buckets_len); i++) {
+		struct edhoc_admission_bucket *c = &a->buckets[i];
+		if (!c->valid) {
+			free_b = (NULL == free_b) ? c : free_b;
+		} else if ((c->source_len == source->len) &&
+			   (0 == memcmp(c->source, source->ptr, source->len))) {
+			b = c;
+		}
+	}
+	if (NULL == b) {
+		b = free_b;
+	}
+	if (NULL == b) {
+		b = &a->buckets[a->next];
+		a->next = (a->next + 1) % a->buckets_len;
+		b->valid = false;
+	}
+
+	if (!b->valid) {
+		memcpy(b->source, source->ptr, source->len);
+		b->source_len = source->len;
+		b->tokens = a->burst;
+		b->last = now;
+		b->valid = true;
+	} else {
+		uint32_t added = (now - b->last) / a->period;
+		if (added >= a->burst - b->tokens) {
+			b->tokens = a->burst;
+			b->last = now;
+		} else {
+			b->tokens += added;
+			b->last += added * a->period;
+		}
+	}
+
+	if (0 == b->tokens) {
+		return false;
+	}
+	b->tokens--;
+	return true;
+}
+
+/**
+ * @brief	Checks message_1 without doing any public key operation.
+ *
+ * @param[in] c	The responder context.
+ * @param[in] msg1 The message.
+ * @param[in,out] ead_1 Buffer of EAD_SIZE bytes for EAD_1 of the message.
+ * @return	true if the message can be processed.
+ */
+static bool msg1_valid(const struct edhoc_responder_context *c,
+		       const struct byte_array *msg1, struct byte_array *ead_1)
+{
+	struct message_1 m;
+	size_t decode_len = 0;
+	int32_t selected;
+	struct suite suite;
+
+	if ((0 != cbor_decode_message_1(msg1->ptr, msg1->len, &m,
+					&decode_len)) ||
+	    (decode_len != msg1->len)) {
+		return false;
+	}
+
+	if ((m.message_1_METHOD > INITIATOR_SDHK_RESPONDER_SDHK) ||
+	    (m.message_1_METHOD < INITIATOR_SK_RESPONDER_SK)) {
+		return false;
+	}
+
+	/*the selected suite is the last one of SUITES_I*/
+	const int32_t *suites_i = &m.message_1_SUITES_I_int;
+	uint32_t suites_i_len = 1;
+	if (m.message_1_SUITES_I_choice != message_1_SUITES_I_int_c) {
+		if ((0 == m.SUITES_I_suite_l_suite_count) ||
+		    (m.SUITES_I_suite_l_suite_count > SUITES_I_SIZE)) {
+			return false;
+		}
+		suites_i = m.SUITES_I_suite_l_suite;
+		suites_i_len = (uint32_t)m.SUITES_I_suite_l_suite_count;
+	}
+	selected = suites_i[suites_i_len - 1];
+
+	/*an unsupported selected suite is answered with an error message
+	with SUITES_R, which needs no public key operation, so G_X is only
+	checked against a supported suite*/
+	bool supported = false;
+	for (uint32_t i = 0; i < c->suites_r.len; i++) {
+		supported = supported || (selected == c->suites_r.ptr[i]);
+	}
+	if (supported) {
+		if ((ok != get_suite((enum suite_label)selected, &suite)) ||
+		    (m.message_1_G_X.len !=
+		     get_ecdh_pk_len(suite.edhoc_ecdh))) {
+			return false;
+		}
+	}
+	if ((m.message_1_C_I_choice == message_1_C_I_bstr_c) &&
+	    (m.message_1_C_I_bstr.len > C_I_SIZE)) {
+		return false;
+	}
+
+	if (!m.message_1_ead_1_present) {
+		ead_1->len = 0;
+	} else {
+		if (ok != _memcpy_s(ead_1->ptr, ead_1->len,
+				    m.message_1_ead_1.value,
+				    (uint32_t)m.message_1_ead_1.len)) {
+			return false;
+		}
+		ead_1->len = (uint32_t)m.message_1_ead_1.len;
+	}
+	return true;
+}
+
+void edhoc_admission_init(struct edhoc_admission *a,
+			  const struct edhoc_responder_context *c,
+			  const struct edhoc_responder_session_table *t,
+			  struct edhoc_admission_bucket *buckets,
+			  uint32_t buckets_len, uint32_t period, uint32_t burst)
+{
+	memset(a, 0, sizeof(*a));
+	a->c = c;
+	a->t = t;
+	a->max_in_progress = EDHOC_SESSION_TABLE_SIZE;
+	a->buckets = buckets;
+	a->buckets_len = buckets_len;
+	a->period = period;
+	a->burst = burst;
+	for (uint32_t i = 0; i < buckets_len; i++) {
+		buckets[i].valid = false;
+	}
+}
+
+enum err edhoc_admission_challenge_enable(struct edhoc_admission *a,
+					  const struct byte_array *key,
+					  uint32_t threshold, uint32_t lifetime)
+{
+	if ((0 == lifetime) || (sizeof(a->cookie_key) != key->len)) {
+		return wrong_parameter;
+	}
+	memcpy(a->cookie_key, key->ptr, key->len);
+	a->challenge_threshold = threshold;
+	a->cookie_lifetime = lifetime;
+	return ok;
+}
+
+enum err edhoc_admission_msg1(struct edhoc_admission *a,
+			      const struct byte_array *source, uint32_t now,
+			      const struct byte_array *msg1,
+			      struct byte_array *err_msg)
+{
+	enum err r = ok;
+
+	if (source->len > EDHOC_ADMISSION_SOURCE_MAX_SIZE) {
+		return wrong_parameter;
+	}
+	BYTE_ARRAY_NEW(ead_1, EAD_SIZE, EAD_SIZE);
+
+	/*the table is not protected by the lock of the admission*/
+	uint32_t in_progress =
+		(NULL == a->t) ? 0 :
+				 edhoc_responder_session_table_in_progress(a->t);
+
+	admission_lock(a);
+	if (!token_take(a, source, now)) {
+		a->metrics.rate_limited++;
+		r = admission_rate_limited;
+	} else if (!msg1_valid(a->c, msg1, &ead_1)) {
+		a->metrics.malformed++;
+		r = admission_malformed_message;
+	} else if (in_progress >= a->max_in_progress) {
+		a->metrics.busy++;
+		r = admission_busy;
+	} else if ((0 != a->cookie_lifetime) &&
+		   (in_progress >= a->challenge_threshold) &&
+		   !cookie_valid(a, source, &ead_1, now)) {
+		a->metrics.challenged++;
+		r = admission_challenge_sent;
+	} else {
+		a->metrics.admitted++;
+	}
+	admission_unlock(a);
+
+	if (admission_challenge_sent == r) {
+		uint8_t cookie[EDHOC_ADMISSION_COOKIE_SIZE];
+		TRY(cookie_compute(a, source, now / a->cookie_lifetime,
+				   cookie));
+		TRY(cookie_item_encode(EDHOC_ADMISSION_ERR_CODE, cookie,
+				       err_msg));
+	}
+	return r;
+}
+
+enum err edhoc_admission_challenge_answer(const struct byte_array *err_msg,
+					  struct byte_array *ead_1)
+{
+	uint8_t cookie[EDHOC_ADMISSION_COOKIE_SIZE];
+	if (!cookie_item_decode(err_msg, EDHOC_ADMISSION_ERR_CODE, cookie)) {
+		return wrong_parameter;
+	}
+	return cookie_item_encode(EDHOC_ADMISSION_EAD_LABEL, cookie, ead_1);
+}
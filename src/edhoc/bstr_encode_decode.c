@@ -13,6 +13,8 @@
 #include "common/memcpy_s.h"
 #include "common/byte_array.h"
 
+#include "edhoc/bstr_encode_decode.h"
+
 enum err encode_bstr(const struct byte_array *in, struct byte_array *out)
 {
 	size_t payload_len_out;
@@ -40,3 +42,73 @@ enum err decode_bstr(const struct byte_array *in, struct byte_array *out)
 
 	return ok;
 }
+
+enum err encode_cbor_head(uint8_t major_type, uint32_t arg,
+			  struct byte_array *out)
+{
+	TRY(check_buffer_size(out->len, CBOR_HEAD_MAX_SIZE));
+
+	uint8_t mt = (uint8_t)(major_type << 5);
+	uint32_t len = 0;
+	if (arg < 24) {
+		out->ptr[len++] = (uint8_t)(mt | arg);
+	} else if (arg <= UINT8_MAX) {
+		out->ptr[len++] = (uint8_t)(mt | 24);
+		out->ptr[len++] = (uint8_t)arg;
+	} else if (arg <= UINT16_MAX) {
+		out->ptr[len++] = (uint8_t)(mt | 25);
+		out->ptr[len++] = (uint8_t)(arg >> 8);
+		out->ptr[len++] = (uint8_t)arg;
+	} else {
+		out->ptr[len++] = (uint8_t)(mt | 26);
+		out->ptr[len++] = (uint8_t)(arg >> 24);
+		out->ptr[len++] = (uint8_t)(arg >> 16);
+		out->ptr[len++] = (uint8_t)(arg >> 8);
+		out->ptr[len++] = (uint8_t)arg;
+	}
+	out->len = len;
+	return ok;
+}
+
+enum err cbor_head_append(struct byte_array *out, uint32_t size,
+			  uint8_t major_type, uint32_t arg)
+{
+	uint8_t head_buf[CBOR_HEAD_MAX_SIZE];
+	struct byte_array head = BYTE_ARRAY_INIT(head_buf, sizeof(head_buf));
+	TRY(encode_cbor_head(major_type, arg, &head));
+	TRY(_memcpy_s(out->ptr + out->len, size - out->len, head.ptr,
+		      head.len));
+	out->len += head.len;
+	return ok;
+}
+
+enum err decode_cbor_head(const struct byte_array *in, uint8_t *major_type,
+			  uint32_t *arg, uint32_t *head_len)
+{
+	if (0 == in->len) {
+		return cbor_decoding_error;
+	}
+
+	uint8_t info = in->ptr[0] & 0x1f;
+	*major_type = (uint8_t)(in->ptr[0] >> 5);
+	if (info < 24) {
+		*arg = info;
+		*head_len = 1;
+		return ok;
+	}
+	if (info > 26) {
+		return cbor_decoding_error;
+	}
+
+	/* the argument follows in 1, 2 or 4 bytes */
+	uint32_t n = (uint32_t)1 << (info - 24);
+	if (in->len - 1 < n) {
+		return cbor_decoding_error;
+	}
+	*arg = 0;
+	for (uint32_t i = 0; i < n; i++) {
+		*arg = (*arg << 8) | in->ptr[1 + i];
+	}
+	*head_len = 1 + n;
+	return ok;
+}
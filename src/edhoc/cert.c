@@ -15,6 +15,7 @@
 #include "edhoc/buffer_sizes.h"
 
 #include "edhoc/cert.h"
+#include "edhoc/trust_anchor_store.h"
 
 #include "common/memcpy_s.h"
 #include "common/oscore_edhoc_error.h"
@@ -244,6 +245,38 @@ static enum err ca_pk_get(const struct cred_array *cred_array,
 	return no_such_ca;
 }
 
+/**
+ * @brief verifies the signature of a certificate with the public key of the
+ *	  CA that issued it.
+ *
+ * @param[in] cred_array contains the CAs
+ * @param[in] issuer the issuer name, i.e. the name of the CA
+ * @param issuer_len the length of the issuer name
+ * @param alg the signature algorithm of the certificate
+ * @param[in] m the signed part of the certificate
+ * @param[in] sgn the signature
+ * @param[out] verified true if the signature is valid
+ * @return error code
+ */
+static enum err ca_verify(const struct cred_array *cred_array,
+			  const uint8_t *issuer, uint32_t issuer_len,
+			  enum sign_alg alg, struct const_byte_array *m,
+			  struct const_byte_array *sgn, bool *verified)
+{
+	if (NULL != cred_array->anchors) {
+		const struct trust_anchor *a =
+			trust_anchor_find(cred_array->anchors, issuer, issuer_len);
+		if (NULL == a) {
+			return no_such_ca;
+		}
+		return verify_prepared(&a->pk, alg, m, sgn, verified);
+	}
+
+	struct byte_array root_pk;
+	TRY(ca_pk_get(cred_array, issuer, &root_pk));
+	return verify(alg, &root_pk, m, sgn, verified);
+}
+
 enum err cert_c509_verify(struct const_byte_array *cert,
 			  const struct cred_array *cred_array,
 			  struct byte_array *pk, bool *verified)
@@ -267,18 +300,16 @@ enum err cert_c509_verify(struct const_byte_array *cert,
 	PRINT_ARRAY("Signature", c.cert_signature.value,
 		    (uint32_t)c.cert_signature.len);
 
-	/*get the CA's public key*/
-	struct byte_array root_pk;
-	TRY(ca_pk_get(cred_array, c.cert_issuer.value, &root_pk));
-
-	/*verify the certificates signature*/
+	/*verify the certificates signature with the CA's public key*/
 	struct const_byte_array m = BYTE_ARRAY_INIT(
 		cert->ptr, cert->len - 2 - (uint32_t)c.cert_signature.len);
 	struct const_byte_array sgn = BYTE_ARRAY_INIT(
 		c.cert_signature.value, (uint32_t)c.cert_signature.len);
 
-	TRY(verify((enum sign_alg)c.cert_issuer_signature_algorithm, &root_pk,
-		   &m, &sgn, verified));
+	TRY(ca_verify(cred_array, c.cert_issuer.value,
+		      (uint32_t)c.cert_issuer.len,
+		      (enum sign_alg)c.cert_issuer_signature_algorithm, &m, &sgn,
+		      verified));
 
 	TRY(_memcpy_s(pk->ptr, pk->len, c.cert_pk.value,
 		      (uint32_t)c.cert_pk.len));
@@ -354,10 +385,6 @@ enum err cert_x509_verify(struct const_byte_array *cert,
 
 	BYTE_ARRAY_NEW(sig, SIGNATURE_SIZE, get_signature_len(sign_alg));
 
-	/* get the public key of the CA */
-	struct byte_array root_pk;
-	TRY(ca_pk_get(cred_array, issuer_id->p, &root_pk));
-
 	/* deserialize signature from ASN.1 to raw concatenation of (R, S) */
 	{
 		uint8_t *pp = m_cert.sig.p;
@@ -370,11 +397,11 @@ enum err cert_x509_verify(struct const_byte_array *cert,
 		PRINT_ARRAY("Certificate signature", sig.ptr, sig.len);
 	}
 
-	/*verify the certificates signature*/
+	/*verify the certificates signature with the public key of the CA*/
 	struct const_byte_array m =
 		BYTE_ARRAY_INIT(m_cert.tbs.p, (uint32_t)m_cert.tbs.len);
-	TRY(verify(sign_alg, &root_pk, &m, (struct const_byte_array *)&sig,
-		   verified));
+	TRY(ca_verify(cred_array, issuer_id->p, (uint32_t)issuer_id->len,
+		      sign_alg, &m, (struct const_byte_array *)&sig, verified));
 
 	/* export the public key from certificate */
 	{
@@ -486,6 +513,22 @@ enum err cert_x509_verify(struct const_byte_array *cert,
 	struct const_byte_array m =
 		BYTE_ARRAY_INIT(tbs_start, (uint32_t)(tbs_end - tbs_start));
 
+	if ((ok == rv) && (NULL != cred_array->anchors)) {
+		/* The issuer is not read from the certificate, so every CA of
+		the store is tried. */
+		struct const_byte_array s = { .ptr = sig.ptr, .len = sig.len };
+		const struct trust_anchor_store *store = cred_array->anchors;
+		*verified = false;
+		for (uint32_t iter = 0; iter < store->len && !*verified;
+		     iter++) {
+			if (ok != verify_prepared(&store->anchors[iter].pk,
+						  ES256, &m, &s, verified)) {
+				*verified = false;
+			}
+		}
+		return ok;
+	}
+
 	if (ok == rv) {
 		for (uint32_t iter = 0; iter < cred_array->len; iter++) {
 			/* Issuer will not be read from certificate, so no identification is possible within public keys array. */
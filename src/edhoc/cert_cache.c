@@ -0,0 +1,108 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "edhoc.h"
+#include "edhoc/cert_cache.h"
+
+#include "common/byte_array.h"
+#include "common/crypto_wrapper.h"
+#include "common/memcpy_s.h"
+
+/* The key of an entry, see cert_cache_get() */
+struct entry_key {
+	const uint8_t *digest;
+	const struct cred_array *ca_set;
+	bool static_dh;
+};
+
+static bool entry_match(const void *entry, const void *key)
+{
+	const struct cert_cache_entry *e = entry;
+	const struct entry_key *k = key;
+	return (e->ca_set == k->ca_set) && (e->static_dh == k->static_dh) &&
+	       (0 == memcmp(e->digest, k->digest, sizeof(e->digest)));
+}
+
+void cert_cache_init(struct cert_cache *cache,
+		     struct cert_cache_entry *entries, uint32_t entries_len,
+		     uint32_t ttl)
+{
+	ttl_cache_init(&cache->base, entries, sizeof(*entries), entries_len,
+		       ttl);
+}
+
+void cert_cache_register(struct cert_cache *cache)
+{
+	ttl_cache_register(TTL_CACHE_CERT,
+			   (NULL == cache) ? NULL : &cache->base);
+}
+
+void cert_cache_invalidate(struct cert_cache *cache)
+{
+	ttl_cache_clear(&cache->base);
+}
+
+bool cert_cache_get(const struct const_byte_array *cert,
+		    const struct cred_array *ca_set, bool static_dh,
+		    struct cert_cache_key *k, struct byte_array *key)
+{
+	struct ttl_cache *cache = ttl_cache_registered(TTL_CACHE_CERT);
+	k->valid = false;
+	if (NULL == cache) {
+		return false;
+	}
+
+	struct byte_array digest = BYTE_ARRAY_INIT(k->digest, sizeof(k->digest));
+	if (ok != hash(SHA_256, (const struct byte_array *)cert, &digest)) {
+		return false;
+	}
+	k->valid = true;
+
+	struct entry_key ek = { k->digest, ca_set, static_dh };
+	bool hit = false;
+	uint32_t now = ttl_cache_now(cache);
+	ttl_cache_lock(cache);
+	const struct cert_cache_entry *e =
+		ttl_cache_find(cache, entry_match, &ek, now);
+	if (NULL != e) {
+		hit = (ok == _memcpy_s(key->ptr, key->len, e->key, e->key_len));
+		key->len = hit ? e->key_len : key->len;
+	}
+	ttl_cache_unlock(cache);
+	return hit;
+}
+
+void cert_cache_put(const struct cert_cache_key *k,
+		    const struct cred_array *ca_set, bool static_dh,
+		    const struct byte_array *key)
+{
+	struct ttl_cache *cache = ttl_cache_registered(TTL_CACHE_CERT);
+	if ((NULL == cache) || !k->valid || (key->len > PK_SIZE)) {
+		return;
+	}
+
+	struct entry_key ek = { k->digest, ca_set, static_dh };
+	uint32_t now = ttl_cache_now(cache);
+	ttl_cache_lock(cache);
+	struct cert_cache_entry *e =
+		ttl_cache_put(cache, entry_match, &ek, now);
+	if (NULL != e) {
+		memcpy(e->digest, k->digest, sizeof(e->digest));
+		e->ca_set = ca_set;
+		e->static_dh = static_dh;
+		memcpy(e->key, key->ptr, key->len);
+		e->key_len = key->len;
+	}
+	ttl_cache_unlock(cache);
+}
@@ -78,38 +78,36 @@ static enum err ciphertext_encrypt_decrypt(
  * 				the key and IV for ciphertext 3 and 4. 
  * 
  * @param ctxt 			CIPHERTEXT2, CIPHERTEXT3 or CIPHERTEXT4.
- * @param edhoc_hash 		The EDHOC hash algorithm.
- * @param prk 			Pseudorandom key.
+ * @param prk 			Pseudorandom key, prepared for EDHOC-KDF.
  * @param th 			Transcript hash.
  * @param[out] key 		The generated key/key stream.
  * @param[out] iv 		The generated iv.
  * @return 			Ok or error code. 
  */
-static enum err key_gen(enum ciphertext ctxt, enum hash_alg edhoc_hash,
-			struct byte_array *prk, struct byte_array *th,
-			struct byte_array *key, struct byte_array *iv)
+static enum err key_gen(enum ciphertext ctxt, const struct prk_handle *prk,
+			struct byte_array *th, struct byte_array *key,
+			struct byte_array *iv)
 {
 	switch (ctxt) {
 	case CIPHERTEXT2:
-		TRY(edhoc_kdf(edhoc_hash, prk, KEYSTREAM_2, th, key));
+		TRY(edhoc_kdf_handle(prk, KEYSTREAM_2, th, 1, key));
 		PRINT_ARRAY("KEYSTREAM_2", key->ptr, key->len);
 		break;
 
 	case CIPHERTEXT3:
-		TRY(edhoc_kdf(edhoc_hash, prk, K_3, th, key));
+		TRY(edhoc_kdf_handle(prk, K_3, th, 1, key));
 
 		PRINT_ARRAY("K_3", key->ptr, key->len);
 
-		TRY(edhoc_kdf(edhoc_hash, prk, IV_3, th, iv));
+		TRY(edhoc_kdf_handle(prk, IV_3, th, 1, iv));
 		PRINT_ARRAY("IV_3", iv->ptr, iv->len);
 		break;
 
 	case CIPHERTEXT4:
-		PRINT_ARRAY("PRK_4e3m", prk->ptr, prk->len);
 		PRINT_ARRAY("TH_4", th->ptr, th->len);
-		TRY(edhoc_kdf(edhoc_hash, prk, K_4, th, key));
+		TRY(edhoc_kdf_handle(prk, K_4, th, 1, key));
 		PRINT_ARRAY("K_4", key->ptr, key->len);
-		TRY(edhoc_kdf(edhoc_hash, prk, IV_4, th, iv));
+		TRY(edhoc_kdf_handle(prk, IV_4, th, 1, iv));
 		PRINT_ARRAY("IV_4", iv->ptr, iv->len);
 		break;
 	}
@@ -119,8 +117,9 @@ static enum err key_gen(enum ciphertext ctxt, enum hash_alg edhoc_hash,
 enum err ciphertext_decrypt_split(
 	enum ciphertext ctxt, struct suite *suite, struct byte_array *c_r,
 	struct byte_array *id_cred, struct byte_array *sig_or_mac,
-	struct byte_array *ead, struct byte_array *prk, struct byte_array *th,
-	struct byte_array *ciphertext, struct byte_array *plaintext)
+	struct byte_array *ead, const struct prk_handle *prk,
+	struct byte_array *th, struct byte_array *ciphertext,
+	struct byte_array *plaintext)
 {
 	/*generate key and iv (no iv in for ciphertext 2)*/
 	uint32_t key_len;
@@ -133,7 +132,7 @@ enum err ciphertext_decrypt_split(
 	BYTE_ARRAY_NEW(key, CIPHERTEXT2_SIZE, key_len);
 	BYTE_ARRAY_NEW(iv, AEAD_IV_SIZE, get_aead_iv_len(suite->edhoc_aead));
 
-	TRY(key_gen(ctxt, suite->edhoc_hash, prk, th, &key, &iv));
+	TRY(key_gen(ctxt, prk, th, &key, &iv));
 
 	/*Associated data*/
 	BYTE_ARRAY_NEW(associated_data, AAD_SIZE, AAD_SIZE);
@@ -185,8 +184,9 @@ enum err ciphertext_gen(enum ciphertext ctxt, struct suite *suite,
 			const struct byte_array *c_r,
 			const struct byte_array *id_cred,
 			struct byte_array *signature_or_mac,
-			const struct byte_array *ead, struct byte_array *prk,
-			struct byte_array *th, struct byte_array *ciphertext,
+			const struct byte_array *ead,
+			const struct prk_handle *prk, struct byte_array *th,
+			struct byte_array *ciphertext,
 			struct byte_array *plaintext)
 {
 	BYTE_ARRAY_NEW(signature_or_mac_enc, AS_BSTR_SIZE(SIG_OR_MAC_SIZE),
@@ -246,7 +246,7 @@ enum err ciphertext_gen(enum ciphertext ctxt, struct suite *suite,
 	BYTE_ARRAY_NEW(key, CIPHERTEXT2_SIZE, key_len);
 	BYTE_ARRAY_NEW(iv, AEAD_IV_SIZE, get_aead_iv_len(suite->edhoc_aead));
 
-	TRY(key_gen(ctxt, suite->edhoc_hash, prk, th, &key, &iv));
+	TRY(key_gen(ctxt, prk, th, &key, &iv));
 
 	/*encrypt*/
 	BYTE_ARRAY_NEW(aad, AAD_SIZE, AAD_SIZE);
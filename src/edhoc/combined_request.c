@@ -0,0 +1,177 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "edhoc.h"
+#include "edhoc_internal.h"
+#include "edhoc/combined_request.h"
+#include "edhoc/responder_session_table.h"
+#include "oscore.h"
+
+#include "common/byte_array.h"
+#include "common/memcpy_s.h"
+#include "common/oscore_edhoc_error.h"
+#include "common/print_util.h"
+
+/*the key length of the AEAD algorithms of OSCORE*/
+#define OSCORE_MASTER_SECRET_MAX_LEN 16
+/*the default length of the master salt, see RFC 9528 Appendix A.1*/
+#define OSCORE_MASTER_SALT_LEN 8
+
+/**
+ * @brief Maps the application algorithms of a suite to the algorithms of 
+ *        OSCORE.
+ *
+ * @param[in] suite the negotiated suite
+ * @param[out] aead_alg the OSCORE AEAD algorithm
+ * @param[out] hkdf the OSCORE HKDF algorithm
+ * @return ok or error code
+ */
+static enum err oscore_algorithms_get(const struct suite *suite,
+				      enum AEAD_algorithm *aead_alg,
+				      enum hkdf *hkdf)
+{
+	if (AES_CCM_16_64_128 != suite->app_aead) {
+		return oscore_invalid_algorithm_aead;
+	}
+	if (SHA_256 != suite->app_hash) {
+		return oscore_invalid_algorithm_hkdf;
+	}
+	*aead_alg = OSCORE_AES_CCM_16_64_128;
+	*hkdf = OSCORE_SHA_256;
+	return ok;
+}
+
+enum err edhoc_oscore_context_derive(const struct suite *suite,
+				     struct byte_array *prk_out,
+				     const struct byte_array *sender_id,
+				     const struct byte_array *recipient_id,
+				     struct context *c)
+{
+	enum AEAD_algorithm aead_alg;
+	enum hkdf hkdf;
+	TRY(oscore_algorithms_get(suite, &aead_alg, &hkdf));
+
+	BYTE_ARRAY_NEW(prk_exporter, HASH_SIZE, get_hash_len(suite->app_hash));
+	BYTE_ARRAY_NEW(master_secret, OSCORE_MASTER_SECRET_MAX_LEN,
+		       get_aead_key_len(suite->app_aead));
+	BYTE_ARRAY_NEW(master_salt, OSCORE_MASTER_SALT_LEN,
+		       OSCORE_MASTER_SALT_LEN);
+
+	enum err r = prk_out2exporter(suite->app_hash, prk_out, &prk_exporter);
+	if (ok == r) {
+		r = edhoc_exporter(suite->app_hash, OSCORE_MASTER_SECRET,
+				   &prk_exporter, &master_secret);
+	}
+	if (ok == r) {
+		r = edhoc_exporter(suite->app_hash, OSCORE_MASTER_SALT,
+				   &prk_exporter, &master_salt);
+	}
+	secure_erase(prk_exporter.ptr, prk_exporter.len);
+
+	if (ok == r) {
+		struct oscore_init_params params = {
+			.master_secret = master_secret,
+			.sender_id = *sender_id,
+			.recipient_id = *recipient_id,
+			.id_context = NULL_ARRAY,
+			.master_salt = master_salt,
+			.aead_alg = aead_alg,
+			.hkdf = hkdf,
+			/*the secret and the salt are new in every handshake*/
+			.fresh_master_secret_salt = true,
+		};
+		r = oscore_context_init(&params, c);
+	}
+	secure_erase(master_secret.ptr, master_secret.len);
+	secure_erase(master_salt.ptr, master_salt.len);
+	return r;
+}
+
+enum err edhoc_initiator_combined_request(struct edhoc_initiator_session *s,
+					  const struct byte_array *msg2,
+					  uint8_t *coap_req,
+					  uint32_t coap_req_len,
+					  struct context *oscore_c,
+					  uint8_t *buf_out,
+					  uint32_t *buf_out_len)
+{
+#ifdef MESSAGE_4
+	return not_supported_feature;
+#else
+	struct byte_array msg3;
+	enum edhoc_step_status status;
+
+	if (NULL == msg2) {
+		return wrong_parameter;
+	}
+	TRY(edhoc_initiator_session_step(s, msg2, &msg3, &status));
+	if (EDHOC_STEP_DONE != status) {
+		return edhoc_session_invalid_state;
+	}
+
+	/*the context is derived right after message_3 is created*/
+	TRY(edhoc_oscore_context_derive(&s->rc.suite, &s->prk_out, &s->c_r,
+					&s->c->c_i, oscore_c));
+
+	/*the OSCORE request is smaller than the combined request*/
+	uint32_t oscore_req_len = (*buf_out_len < OSCORE_REQUEST_MAX_LEN) ?
+					  *buf_out_len :
+					  OSCORE_REQUEST_MAX_LEN;
+	BYTE_ARRAY_NEW(oscore_req, OSCORE_REQUEST_MAX_LEN, oscore_req_len);
+	TRY(coap2oscore(coap_req, coap_req_len, oscore_req.ptr,
+			&oscore_req.len, oscore_c));
+
+	return oscore_edhoc_request_combine(oscore_req.ptr, oscore_req.len,
+					    &msg3, buf_out, buf_out_len);
+#endif
+}
+
+enum err
+edhoc_responder_combined_request(struct edhoc_responder_session_table *t,
+				 uint8_t *buf_in, uint32_t buf_in_len,
+				 struct context *oscore_c, uint8_t *coap_out,
+				 uint32_t *coap_out_len,
+				 struct edhoc_responder_session **s)
+{
+#ifdef MESSAGE_4
+	return not_supported_feature;
+#else
+	struct byte_array msg3;
+	struct byte_array msg4;
+	struct byte_array c_r;
+
+	/*without the EDHOC option and message_3 the request is smaller*/
+	uint32_t oscore_req_len = (buf_in_len < OSCORE_REQUEST_MAX_LEN) ?
+					  buf_in_len :
+					  OSCORE_REQUEST_MAX_LEN;
+	BYTE_ARRAY_NEW(oscore_req, OSCORE_REQUEST_MAX_LEN, oscore_req_len);
+	TRY(oscore_edhoc_request_split(buf_in, buf_in_len, &msg3, &c_r,
+				       oscore_req.ptr, &oscore_req.len));
+
+	TRY(edhoc_responder_session_table_msg3(t, &c_r, &msg3, &msg4, s));
+
+	enum err r = edhoc_oscore_context_derive(
+		&(*s)->rc.suite, &(*s)->prk_out, &(*s)->c_i, &c_r, oscore_c);
+	if (ok == r) {
+		r = oscore2coap(oscore_req.ptr, oscore_req.len, coap_out,
+				coap_out_len, oscore_c);
+	}
+	if (ok != r) {
+		/*the handshake is not usable without a valid request*/
+		edhoc_responder_session_table_release(t, *s);
+		*s = NULL;
+	}
+	return r;
+#endif
+}
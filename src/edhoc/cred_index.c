@@ -0,0 +1,98 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "edhoc.h"
+#include "edhoc/cred_index.h"
+
+#include "common/byte_array.h"
+#include "common/oscore_edhoc_error.h"
+
+/**
+ * @brief FNV-1a hash of a byte string.
+ */
+static uint32_t fnv1a(const uint8_t *p, uint32_t len)
+{
+	uint32_t h = 2166136261u;
+	for (uint32_t i = 0; i < len; i++) {
+		h ^= p[i];
+		h *= 16777619u;
+	}
+	return h;
+}
+
+static bool id_cred_equals(const struct byte_array *a,
+			   const struct byte_array *b)
+{
+	return (a->len == b->len) &&
+	       ((0 == a->len) || (0 == memcmp(a->ptr, b->ptr, a->len)));
+}
+
+enum err cred_index_build(struct cred_index *idx, struct cred_array *creds,
+			  uint32_t *table, uint32_t table_len)
+{
+	if ((NULL == idx) || (NULL == creds) || (NULL == table) ||
+	    (0 == table_len) || (0 != (table_len & (table_len - 1)))) {
+		return wrong_parameter;
+	}
+	if (creds->len >= table_len) {
+		return cred_index_too_small;
+	}
+
+	memset(table, 0, table_len * sizeof(uint32_t));
+	uint32_t mask = table_len - 1;
+
+	for (uint32_t i = 0; i < creds->len; i++) {
+		const struct byte_array *id = &creds->ptr[i].id_cred;
+		uint32_t pos = fnv1a(id->ptr, id->len) & mask;
+		bool duplicate = false;
+
+		while (0 != table[pos]) {
+			if (id_cred_equals(&creds->ptr[table[pos] - 1].id_cred,
+					   id)) {
+				duplicate = true;
+				break;
+			}
+			pos = (pos + 1) & mask;
+		}
+		if (!duplicate) {
+			table[pos] = i + 1;
+		}
+	}
+
+	idx->creds = creds;
+	idx->table = table;
+	idx->table_len = table_len;
+	creds->index = idx;
+	return ok;
+}
+
+enum err cred_index_find(const struct cred_index *idx,
+			 const struct byte_array *id_cred,
+			 const struct other_party_cred **cred)
+{
+	uint32_t mask = idx->table_len - 1;
+	uint32_t pos = fnv1a(id_cred->ptr, id_cred->len) & mask;
+
+	/*the table has at least one free entry, so the loop terminates*/
+	while (0 != idx->table[pos]) {
+		const struct other_party_cred *c =
+			&idx->creds->ptr[idx->table[pos] - 1];
+		if (id_cred_equals(&c->id_cred, id_cred)) {
+			*cred = c;
+			return ok;
+		}
+		pos = (pos + 1) & mask;
+	}
+	return credential_not_found;
+}
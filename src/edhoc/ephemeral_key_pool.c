@@ -0,0 +1,157 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "edhoc.h"
+#include "edhoc/ephemeral_key_pool.h"
+#include "edhoc/runtime_context.h"
+
+#include "common/memcpy_s.h"
+#include "common/oscore_edhoc_error.h"
+
+#ifdef EPHEMERAL_KEY_POOL
+
+/*written only at startup and shutdown, see ephemeral_key_pool.h*/
+static struct ephemeral_key_pool *registered[EPHEMERAL_KEY_POOL_ALGS];
+
+void ephemeral_key_pool_init(struct ephemeral_key_pool *pool,
+			     enum ecdh_alg alg)
+{
+	secure_erase((uint8_t *)pool->pairs, sizeof(pool->pairs));
+	pool->alg = alg;
+	pool->head = 0;
+	pool->tail = 0;
+}
+
+enum err ephemeral_key_pool_register(struct ephemeral_key_pool *pool)
+{
+	for (uint32_t i = 0; i < EPHEMERAL_KEY_POOL_ALGS; i++) {
+		if ((NULL == registered[i]) ||
+		    (registered[i]->alg == pool->alg)) {
+			registered[i] = pool;
+			return ok;
+		}
+	}
+	return ephemeral_key_pool_no_space;
+}
+
+void ephemeral_key_pool_unregister(struct ephemeral_key_pool *pool)
+{
+	for (uint32_t i = 0; i < EPHEMERAL_KEY_POOL_ALGS; i++) {
+		if (registered[i] == pool) {
+			registered[i] = NULL;
+		}
+	}
+}
+
+uint32_t ephemeral_key_pool_count(const struct ephemeral_key_pool *pool)
+{
+	return __atomic_load_n(&pool->head, __ATOMIC_ACQUIRE) -
+	       __atomic_load_n(&pool->tail, __ATOMIC_ACQUIRE);
+}
+
+enum err ephemeral_key_pool_fill(struct ephemeral_key_pool *pool,
+				 uint32_t seed, bool *full)
+{
+	uint32_t head = pool->head;
+	uint32_t tail = __atomic_load_n(&pool->tail, __ATOMIC_ACQUIRE);
+	if (head - tail >= EPHEMERAL_KEY_POOL_SIZE) {
+		*full = true;
+		return ok;
+	}
+	*full = false;
+
+	struct ephemeral_key_pair *pair =
+		&pool->pairs[head % EPHEMERAL_KEY_POOL_SIZE];
+	struct byte_array sk = BYTE_ARRAY_INIT(pair->sk, sizeof(pair->sk));
+	struct byte_array pk = BYTE_ARRAY_INIT(pair->pk, sizeof(pair->pk));
+	TRY(ephemeral_dh_key_gen(pool->alg, seed, &sk, &pk));
+	pair->sk_len = sk.len;
+	pair->pk_len = pk.len;
+
+	/*publish the pair after it is completely written*/
+	__atomic_store_n(&pool->head, head + 1, __ATOMIC_RELEASE);
+	return ok;
+}
+
+bool ephemeral_key_pool_take(enum ecdh_alg alg,
+			     struct ephemeral_key_pair *pair)
+{
+	struct ephemeral_key_pool *pool = NULL;
+	for (uint32_t i = 0; i < EPHEMERAL_KEY_POOL_ALGS; i++) {
+		if ((NULL != registered[i]) && (registered[i]->alg == alg)) {
+			pool = registered[i];
+		}
+	}
+	if (NULL == pool) {
+		return false;
+	}
+
+	uint32_t tail = pool->tail;
+	uint32_t head = __atomic_load_n(&pool->head, __ATOMIC_ACQUIRE);
+	if (head == tail) {
+		return false;
+	}
+
+	struct ephemeral_key_pair *p =
+		&pool->pairs[tail % EPHEMERAL_KEY_POOL_SIZE];
+	*pair = *p;
+	secure_erase((uint8_t *)p, sizeof(*p));
+
+	/*the slot can be reused by the producer after this store*/
+	__atomic_store_n(&pool->tail, tail + 1, __ATOMIC_RELEASE);
+	return true;
+}
+
+#endif /* EPHEMERAL_KEY_POOL */
+
+bool ephemeral_key_select(struct runtime_context *rc, enum ecdh_alg alg,
+			  const struct byte_array *sk,
+			  const struct byte_array *pk)
+{
+#ifdef EPHEMERAL_KEY_POOL
+	struct ephemeral_key_pair pair;
+	if (ephemeral_key_pool_take(alg, &pair)) {
+		/*the lengths are bounded by the sizes of the buffers*/
+		memcpy(rc->eph_sk_buf, pair.sk, pair.sk_len);
+		memcpy(rc->eph_pk_buf, pair.pk, pair.pk_len);
+		rc->eph_sk.ptr = rc->eph_sk_buf;
+		rc->eph_sk.len = pair.sk_len;
+		rc->eph_pk.ptr = rc->eph_pk_buf;
+		rc->eph_pk.len = pair.pk_len;
+		secure_erase((uint8_t *)&pair, sizeof(pair));
+		return true;
+	}
+#else
+	(void)alg;
+#endif
+	/*an application using the pool may leave the keys of the context 
+	empty*/
+	if ((NULL == sk) || (NULL == pk) || (0 == sk->len) || (0 == pk->len)) {
+		return false;
+	}
+	rc->eph_sk = *sk;
+	rc->eph_pk = *pk;
+	return true;
+}
+
+void ephemeral_key_erase(struct runtime_context *rc)
+{
+#ifdef EPHEMERAL_KEY_POOL
+	if (rc->eph_sk.ptr == rc->eph_sk_buf) {
+		secure_erase(rc->eph_sk_buf, sizeof(rc->eph_sk_buf));
+	}
+#endif
+	rc->eph_sk.ptr = NULL;
+	rc->eph_sk.len = 0;
+}
@@ -29,9 +29,11 @@
 #include "edhoc/th.h"
 #include "edhoc/txrx_wrapper.h"
 #include "edhoc/ciphertext.h"
+#include "edhoc/ephemeral_key_pool.h"
 #include "edhoc/runtime_context.h"
 #include "edhoc/bstr_encode_decode.h"
 #include "edhoc/int_encode_decode.h"
+#include "edhoc/suite_cache.h"
 
 #include "cbor/edhoc_encode_message_1.h"
 #include "cbor/edhoc_decode_message_2.h"
@@ -65,6 +67,45 @@ static inline enum err msg2_parse(struct byte_array *msg2,
 	return ok;
 }
 
+/**
+ * @brief			Returns the index of a suite in suites_i.
+ * @retval			The index or suites_i->len if not found.
+ */
+static uint32_t suite_index(const struct byte_array *suites_i, uint32_t suite)
+{
+	uint32_t i = 0;
+	while ((i < suites_i->len) && (suites_i->ptr[i] != suite)) {
+		i++;
+	}
+	return i;
+}
+
+/**
+ * @brief			Returns the number of suites of the context 
+ *				sent in SUITES_I: all suites or, if another 
+ *				suite was selected for the responder after an 
+ *				error message, the suites up to that suite.
+ * @param c 			Initiator context.
+ * @param rc 			Runtime context.
+ */
+static uint32_t suites_i_len_get(const struct edhoc_initiator_context *c,
+				 const struct runtime_context *rc)
+{
+	if (0 != rc->suites_i_len) {
+		return rc->suites_i_len;
+	}
+
+	uint8_t suite;
+	if ((NULL != rc->peer_id.ptr) &&
+	    suite_cache_get(&rc->peer_id, &suite)) {
+		uint32_t i = suite_index(&c->suites_i, suite);
+		if (i < c->suites_i.len) {
+			return i + 1;
+		}
+	}
+	return c->suites_i.len;
+}
+
 enum err msg1_gen(const struct edhoc_initiator_context *c,
 		  struct runtime_context *rc)
 {
@@ -74,22 +115,43 @@ enum err msg1_gen(const struct edhoc_initiator_context *c,
 	m1.message_1_METHOD = (int32_t)c->method;
 
 	/*SUITES_I*/
-	if (c->suites_i.len == 1) {
+	if (0 == c->suites_i.len) {
+		return suites_i_list_empty;
+	}
+	uint32_t suites_len = suites_i_len_get(c, rc);
+	if (suites_len > sizeof(m1.SUITES_I_suite_l_suite) /
+				 sizeof(m1.SUITES_I_suite_l_suite[0])) {
+		return suites_i_list_to_long;
+	}
+	if (suites_len == 1) {
 		/* only one suite, encode into int */
 		m1.message_1_SUITES_I_choice = message_1_SUITES_I_int_c;
 		m1.message_1_SUITES_I_int = c->suites_i.ptr[0];
-	} else if (c->suites_i.len > 1) {
+	} else {
 		/* more than one suites, encode into array */
 		m1.message_1_SUITES_I_choice = SUITES_I_suite_l_c;
-		m1.SUITES_I_suite_l_suite_count = c->suites_i.len;
-		for (uint32_t i = 0; i < c->suites_i.len; i++) {
+		m1.SUITES_I_suite_l_suite_count = suites_len;
+		for (uint32_t i = 0; i < suites_len; i++) {
 			m1.SUITES_I_suite_l_suite[i] = c->suites_i.ptr[i];
 		}
 	}
 
-	/* G_X ephemeral public key */
-	m1.message_1_G_X.value = c->g_x.ptr;
-	m1.message_1_G_X.len = c->g_x.len;
+	TRY(get_suite((enum suite_label)c->suites_i.ptr[suites_len - 1],
+		      &rc->suite));
+
+	/* G_X ephemeral public key. The keys of the context belong to the 
+	last suite of the context. */
+	struct suite last;
+	TRY(get_suite((enum suite_label)c->suites_i.ptr[c->suites_i.len - 1],
+		      &last));
+	bool own_keys = (last.edhoc_ecdh == rc->suite.edhoc_ecdh);
+	if (!ephemeral_key_select(rc, rc->suite.edhoc_ecdh,
+				  own_keys ? &c->x : NULL,
+				  own_keys ? &c->g_x : NULL)) {
+		return ephemeral_key_unavailable;
+	}
+	m1.message_1_G_X.value = rc->eph_pk.ptr;
+	m1.message_1_G_X.len = rc->eph_pk.len;
 
 	/* C_I connection ID  of the initiator*/
 	PRINT_ARRAY("C_I", c->c_i.ptr, c->c_i.len);
@@ -119,19 +181,76 @@ enum err msg1_gen(const struct edhoc_initiator_context *c,
 
 	PRINT_ARRAY("message_1 (CBOR Sequence)", rc->msg.ptr, rc->msg.len);
 
-	TRY(get_suite((enum suite_label)c->suites_i.ptr[c->suites_i.len - 1],
-		      &rc->suite));
 	/* Calculate hash of msg1 for TH2. */
 	TRY(hash(rc->suite.edhoc_hash, &rc->msg, &rc->msg1_hash));
 	return ok;
 }
 
+bool msg_is_error(const struct byte_array *msg)
+{
+	/*message 2 is a byte string, an error message starts with ERR_CODE*/
+	uint8_t major_type = (0 == msg->len) ? CBOR_MAJOR_TYPE_BSTR :
+					       (uint8_t)(msg->ptr[0] >> 5);
+	return (CBOR_MAJOR_TYPE_UINT == major_type) ||
+	       (CBOR_MAJOR_TYPE_NINT == major_type);
+}
+
+enum err msg1_error_process(const struct edhoc_initiator_context *c,
+			    struct runtime_context *rc)
+{
+	uint8_t major_type;
+	uint32_t arg, head_len;
+
+	TRY(decode_cbor_head(&rc->msg, &major_type, &arg, &head_len));
+	/*another suite is selected at most once per handshake*/
+	if ((CBOR_MAJOR_TYPE_UINT != major_type) ||
+	    (ERR_CODE_WRONG_SELECTED_CIPHER_SUITE != arg) ||
+	    (0 != rc->suites_i_len)) {
+		return error_message_received;
+	}
+
+	/*ERR_INFO is SUITES_R: [2* suite] / suite*/
+	struct byte_array info = BYTE_ARRAY_INIT(rc->msg.ptr + head_len,
+						 rc->msg.len - head_len);
+	uint32_t cnt = 1;
+	TRY(decode_cbor_head(&info, &major_type, &arg, &head_len));
+	if (CBOR_MAJOR_TYPE_ARRAY == major_type) {
+		cnt = arg;
+		info.ptr += head_len;
+		info.len -= head_len;
+	}
+
+	/*the first suite of the initiator that the responder supports*/
+	uint32_t selected = c->suites_i.len;
+	for (uint32_t n = 0; n < cnt; n++) {
+		TRY(decode_cbor_head(&info, &major_type, &arg, &head_len));
+		if (CBOR_MAJOR_TYPE_UINT == major_type) {
+			uint32_t i = suite_index(&c->suites_i, arg);
+			selected = (i < selected) ? i : selected;
+		} else if (CBOR_MAJOR_TYPE_NINT != major_type) {
+			return cbor_decoding_error;
+		}
+		info.ptr += head_len;
+		info.len -= head_len;
+	}
+
+	if ((selected == c->suites_i.len) ||
+	    (c->suites_i.ptr[selected] == rc->suite.suite_label)) {
+		return error_message_received;
+	}
+	PRINTF("The responder supports suite %d, message 1 is sent again.\n",
+	       c->suites_i.ptr[selected]);
+	rc->suites_i_len = selected + 1;
+	return ok;
+}
+
 static enum err msg2_process(const struct edhoc_initiator_context *c,
 			     struct runtime_context *rc,
 			     struct cred_array *cred_r_array,
 			     struct byte_array *c_r, bool static_dh_i,
 			     bool static_dh_r, struct byte_array *th3,
-			     struct byte_array *PRK_3e2m)
+			     struct byte_array *PRK_3e2m,
+			     struct prk_handle *prk_h)
 {
 	BYTE_ARRAY_NEW(g_y, G_Y_SIZE, get_ecdh_pk_len(rc->suite.edhoc_ecdh));
 	uint32_t ciphertext_len = rc->msg.len - g_y.len;
@@ -146,7 +265,8 @@ static enum err msg2_process(const struct edhoc_initiator_context *c,
 	/*calculate the DH shared secret*/
 	BYTE_ARRAY_NEW(g_xy, ECDH_SECRET_SIZE, ECDH_SECRET_SIZE);
 
-	TRY(shared_secret_derive(rc->suite.edhoc_ecdh, &c->x, &g_y, g_xy.ptr));
+	TRY(shared_secret_derive(rc->suite.edhoc_ecdh, &rc->eph_sk, &g_y,
+				 g_xy.ptr));
 	PRINT_ARRAY("G_XY (ECDH shared secret) ", g_xy.ptr, g_xy.len);
 
 	/*calculate th2*/
@@ -158,6 +278,7 @@ static enum err msg2_process(const struct edhoc_initiator_context *c,
 	BYTE_ARRAY_NEW(PRK_2e, PRK_SIZE, PRK_SIZE);
 	TRY(hkdf_extract(rc->suite.edhoc_hash, &th2, &g_xy, PRK_2e.ptr));
 	PRINT_ARRAY("PRK_2e", PRK_2e.ptr, PRK_2e.len);
+	TRY(prk_handle_init(rc->suite.edhoc_hash, &PRK_2e, &prk_h[PRK_2E_H]));
 
 	BYTE_ARRAY_NEW(sign_or_mac, SIG_OR_MAC_SIZE, SIG_OR_MAC_SIZE);
 	BYTE_ARRAY_NEW(id_cred_r, ID_CRED_R_SIZE, ID_CRED_R_SIZE);
@@ -166,8 +287,8 @@ static enum err msg2_process(const struct edhoc_initiator_context *c,
 	TRY(check_buffer_size(PLAINTEXT2_SIZE, plaintext.len));
 
 	TRY(ciphertext_decrypt_split(CIPHERTEXT2, &rc->suite, c_r, &id_cred_r,
-				     &sign_or_mac, &rc->ead, &PRK_2e, &th2,
-				     &ciphertext, &plaintext));
+				     &sign_or_mac, &rc->ead, &prk_h[PRK_2E_H],
+				     &th2, &ciphertext, &plaintext));
 
 	/*check the authenticity of the responder*/
 	BYTE_ARRAY_NEW(cred_r, CRED_R_SIZE, CRED_R_SIZE);
@@ -180,20 +301,30 @@ static enum err msg2_process(const struct edhoc_initiator_context *c,
 	PRINT_ARRAY("g_r", g_r.ptr, g_r.len);
 
 	/*derive prk_3e2m*/
-	TRY(prk_derive(static_dh_r, rc->suite, SALT_3e2m, &th2, &PRK_2e, &g_r,
-		       &c->x, PRK_3e2m->ptr));
+	TRY(prk_derive(static_dh_r, rc->suite, SALT_3e2m, &th2, &PRK_2e,
+		       &prk_h[PRK_2E_H], &g_r, &rc->eph_sk, PRK_3e2m->ptr,
+		       &prk_h[PRK_3E2M_H]));
 	PRINT_ARRAY("prk_3e2m", PRK_3e2m->ptr, PRK_3e2m->len);
 
 	TRY(signature_or_mac(VERIFY, static_dh_r, &rc->suite, NULL, &pk,
-			     PRK_3e2m, c_r, &th2, &id_cred_r, &cred_r, &rc->ead,
+			     &prk_h[PRK_3E2M_H], c_r, &th2, &id_cred_r, &cred_r,
+			     &rc->ead,
 			     MAC_2, &sign_or_mac));
 
+	/*the error message with SUITES_R is not authenticated, but TH_2 
+	covers message 1 with the truncated SUITES_I. The suite is cached 
+	only now, so a forged error message cannot pin a downgraded suite*/
+	if ((0 != rc->suites_i_len) && (NULL != rc->peer_id.ptr)) {
+		suite_cache_put(&rc->peer_id, rc->suite.suite_label);
+	}
+
 	TRY(th34_calculate(rc->suite.edhoc_hash, &th2, &plaintext, &cred_r,
 			   th3));
 
 	/*derive prk_4e3m*/
-	TRY(prk_derive(static_dh_i, rc->suite, SALT_4e3m, th3, PRK_3e2m, &g_y,
-		       &c->i, rc->prk_4e3m.ptr));
+	TRY(prk_derive(static_dh_i, rc->suite, SALT_4e3m, th3, PRK_3e2m,
+		       &prk_h[PRK_3E2M_H], &g_y, &c->i, rc->prk_4e3m.ptr,
+		       &prk_h[PRK_4E3M_H]));
 	PRINT_ARRAY("prk_4e3m", rc->prk_4e3m.ptr, rc->prk_4e3m.len);
 
 	return ok;
@@ -202,7 +333,7 @@ static enum err msg2_process(const struct edhoc_initiator_context *c,
 static enum err msg3_only_gen(const struct edhoc_initiator_context *c,
 			      struct runtime_context *rc, bool static_dh_i,
 			      struct byte_array *th3,
-			      struct byte_array *PRK_3e2m,
+			      const struct prk_handle *prk_h,
 			      struct byte_array *prk_out)
 {
 	BYTE_ARRAY_NEW(plaintext, PLAINTEXT3_SIZE,
@@ -214,13 +345,13 @@ static enum err msg3_only_gen(const struct edhoc_initiator_context *c,
 	/*calculate Signature_or_MAC_3*/
 	BYTE_ARRAY_NEW(sign_or_mac_3, SIG_OR_MAC_SIZE, SIG_OR_MAC_SIZE);
 	TRY(signature_or_mac(GENERATE, static_dh_i, &rc->suite, &c->sk_i,
-			     &c->pk_i, &rc->prk_4e3m, &NULL_ARRAY, th3,
+			     &c->pk_i, &prk_h[PRK_4E3M_H], &NULL_ARRAY, th3,
 			     &c->id_cred_i, &c->cred_i, &c->ead_3, MAC_3,
 			     &sign_or_mac_3));
 
 	/*create plaintext3 and ciphertext3*/
 	TRY(ciphertext_gen(CIPHERTEXT3, &rc->suite, &NULL_ARRAY, &c->id_cred_i,
-			   &sign_or_mac_3, &c->ead_3, PRK_3e2m, th3,
+			   &sign_or_mac_3, &c->ead_3, &prk_h[PRK_3E2M_H], th3,
 			   &ciphertext, &plaintext));
 
 	/*massage 3 create and send*/
@@ -232,8 +363,8 @@ static enum err msg3_only_gen(const struct edhoc_initiator_context *c,
 			   &rc->th4));
 
 	/*PRK_out*/
-	TRY(edhoc_kdf(rc->suite.edhoc_hash, &rc->prk_4e3m, PRK_out, &rc->th4,
-		      prk_out));
+	TRY(edhoc_kdf_handle(&prk_h[PRK_4E3M_H], PRK_out, &rc->th4, 1,
+			     prk_out));
 	return ok;
 }
 
@@ -246,13 +377,24 @@ enum err msg3_gen(const struct edhoc_initiator_context *c,
 	BYTE_ARRAY_NEW(th3, HASH_SIZE, HASH_SIZE);
 	BYTE_ARRAY_NEW(PRK_3e2m, PRK_SIZE, PRK_SIZE);
 
-	/*process message 2*/
-	TRY(msg2_process(c, rc, cred_r_array, c_r, static_dh_i, static_dh_r,
-			 &th3, &PRK_3e2m));
+	/*PRK_2e, PRK_3e2m and PRK_4e3m prepared for EDHOC-KDF*/
+	struct prk_handle prk_h[PRK_HANDLES];
+	memset(prk_h, 0, sizeof(prk_h));
+
+	/*process message 2, afterwards the ephemeral key is not needed*/
+	enum err r = msg2_process(c, rc, cred_r_array, c_r, static_dh_i,
+				  static_dh_r, &th3, &PRK_3e2m, prk_h);
+	ephemeral_key_erase(rc);
 
 	/*generate message 3*/
-	msg3_only_gen(c, rc, static_dh_i, &th3, &PRK_3e2m, prk_out);
-	return ok;
+	if (ok == r) {
+		r = msg3_only_gen(c, rc, static_dh_i, &th3, prk_h, prk_out);
+	}
+
+	for (uint32_t i = 0; i < PRK_HANDLES; i++) {
+		prk_handle_wipe(&prk_h[i]);
+	}
+	return r;
 }
 
 #ifdef MESSAGE_4
@@ -267,32 +409,74 @@ enum err msg4_process(struct runtime_context *rc)
 	BYTE_ARRAY_NEW(plaintext4,
 		       PLAINTEXT4_SIZE + get_aead_mac_len(rc->suite.edhoc_aead),
 		       ciphertext4.len);
-	TRY(ciphertext_decrypt_split(CIPHERTEXT4, &rc->suite, NULL, &NULL_ARRAY,
-				     &NULL_ARRAY, &rc->ead, &rc->prk_4e3m,
-				     &rc->th4, &ciphertext4, &plaintext4));
-	return ok;
+	struct prk_handle prk_4e3m;
+	TRY(prk_handle_init(rc->suite.edhoc_hash, &rc->prk_4e3m, &prk_4e3m));
+	enum err r = ciphertext_decrypt_split(CIPHERTEXT4, &rc->suite, NULL,
+					      &NULL_ARRAY, &NULL_ARRAY,
+					      &rc->ead, &prk_4e3m, &rc->th4,
+					      &ciphertext4, &plaintext4);
+	prk_handle_wipe(&prk_4e3m);
+	return r;
 }
 #endif // MESSAGE_4
 
-enum err edhoc_initiator_run_extended(
+/**
+ * @brief			Copies a received error message to the buffer of
+ *				the caller if it fits, otherwise err_msg->len
+ *				is set to 0.
+ */
+static void error_msg_copy(const struct byte_array *msg,
+			   struct byte_array *err_msg)
+{
+	if (NULL == err_msg) {
+		return;
+	}
+	if (ok != _memcpy_s(err_msg->ptr, err_msg->len, msg->ptr, msg->len)) {
+		err_msg->len = 0;
+		return;
+	}
+	err_msg->len = msg->len;
+}
+
+enum err edhoc_initiator_run_peer(
 	const struct edhoc_initiator_context *c,
-	struct cred_array *cred_r_array, struct byte_array *err_msg,
-	struct byte_array *c_r_bytes, struct byte_array *prk_out,
+	const struct byte_array *peer_id, struct cred_array *cred_r_array,
+	struct byte_array *err_msg, struct byte_array *c_r_bytes,
+	struct byte_array *prk_out,
 	enum err (*tx)(void *sock, struct byte_array *data),
 	enum err (*rx)(void *sock, struct byte_array *data),
 	enum err (*ead_process)(void *params, struct byte_array *ead24))
 {
 	struct runtime_context rc = { 0 };
 	runtime_context_init(&rc);
+	if (NULL != peer_id) {
+		rc.peer_id = *peer_id;
+	}
 
-	/*create and send message 1*/
-	TRY(msg1_gen(c, &rc));
-	TRY(tx(c->sock, &rc.msg));
-
-	/*receive message 2*/
-	PRINT_MSG("waiting to receive message 2...\n");
-	rc.msg.len = sizeof(rc.msg_buf);
-	TRY(rx(c->sock, &rc.msg));
+	bool retry = true;
+	while (retry) {
+		/*create and send message 1*/
+		rc.msg.len = sizeof(rc.msg_buf);
+		TRY(msg1_gen(c, &rc));
+		TRY(tx(c->sock, &rc.msg));
+
+		/*receive message 2*/
+		PRINT_MSG("waiting to receive message 2...\n");
+		rc.msg.len = sizeof(rc.msg_buf);
+		TRY(rx(c->sock, &rc.msg));
+
+		/*if the responder rejected the selected suite, message 1 is
+		sent again with a suite it supports*/
+		retry = msg_is_error(&rc.msg);
+		if (retry) {
+			ephemeral_key_erase(&rc);
+			enum err r = msg1_error_process(c, &rc);
+			if (ok != r) {
+				error_msg_copy(&rc.msg, err_msg);
+				return r;
+			}
+		}
+	}
 
 	/*create and send message 3*/
 	TRY(msg3_gen(c, &rc, cred_r_array, c_r_bytes, prk_out));
@@ -310,6 +494,19 @@ enum err edhoc_initiator_run_extended(
 	return ok;
 }
 
+enum err edhoc_initiator_run_extended(
+	const struct edhoc_initiator_context *c,
+	struct cred_array *cred_r_array, struct byte_array *err_msg,
+	struct byte_array *c_r_bytes, struct byte_array *prk_out,
+	enum err (*tx)(void *sock, struct byte_array *data),
+	enum err (*rx)(void *sock, struct byte_array *data),
+	enum err (*ead_process)(void *params, struct byte_array *ead24))
+{
+	return edhoc_initiator_run_peer(c, NULL, cred_r_array, err_msg,
+					c_r_bytes, prk_out, tx, rx,
+					ead_process);
+}
+
 enum err edhoc_initiator_run(
 	const struct edhoc_initiator_context *c,
 	struct cred_array *cred_r_array, struct byte_array *err_msg,
@@ -9,27 +9,240 @@
    except according to those terms.
 */
 
+#include <stdbool.h>
+#include <string.h>
+
 #include "edhoc/buffer_sizes.h"
 
-#include "edhoc/hkdf_info.h"
+#include "edhoc/bstr_encode_decode.h"
 #include "edhoc/okm.h"
 
+#include "common/byte_array.h"
+#include "common/crypto_provider.h"
 #include "common/crypto_wrapper.h"
+#include "common/memcpy_s.h"
 #include "common/oscore_edhoc_error.h"
 
 #include "common/print_util.h"
 
-enum err edhoc_kdf(enum hash_alg hash_alg, const struct byte_array *prk,
-		   uint8_t label, struct byte_array *context,
-		   struct byte_array *okm)
+/**
+ * @brief			Checks if the EDHOC-KDF under a PRK is computed
+ *				by hkdf_expand() instead of the prepared HMAC,
+ *				i.e. with EDHOC_KDF_HKDF_EXPAND or if an HKDF 
+ *				provider is registered for the algorithm.
+ *
+ * @param hash_alg		HASH algorithm.
+ * @return			True if hkdf_expand() is used.
+ */
+static bool kdf_uses_hkdf_expand(enum hash_alg hash_alg)
 {
-	PRINTF("INFO_MAX_SIZE: %d\n", INFO_MAX_SIZE);
-	PRINTF("context->len: %d\n", context->len);
-	BYTE_ARRAY_NEW(info, INFO_MAX_SIZE,
-		       AS_BSTR_SIZE(context->len) + (2 * CBOR_ENCODED_UINT));
+#ifdef EDHOC_KDF_HKDF_EXPAND
+	return true;
+#else
+	return NULL != crypto_provider_get(CRYPTO_OP_HKDF, hash_alg);
+#endif
+}
 
-	TRY(create_hkdf_info(label, context, okm->len, &info));
+enum err prk_handle_init(enum hash_alg hash_alg, const struct byte_array *prk,
+			 struct prk_handle *h)
+{
+	memset(h, 0, sizeof(*h));
+	h->alg = hash_alg;
+	if (kdf_uses_hkdf_expand(hash_alg)) {
+		TRY(_memcpy_s(h->prk, sizeof(h->prk), prk->ptr, prk->len));
+		h->prk_len = prk->len;
+		h->expand = true;
+		return ok;
+	}
+	return hmac_init(hash_alg, prk, &h->keyed);
+}
+
+enum err prk_handle_copy(const struct prk_handle *src, struct prk_handle *dst)
+{
+	memset(dst, 0, sizeof(*dst));
+	dst->alg = src->alg;
+	if (src->expand) {
+		memcpy(dst->prk, src->prk, src->prk_len);
+		dst->prk_len = src->prk_len;
+		dst->expand = true;
+		return ok;
+	}
+	return hmac_clone(&src->keyed, &dst->keyed);
+}
 
+void prk_handle_wipe(struct prk_handle *h)
+{
+	hmac_abort(&h->keyed);
+	secure_erase((uint8_t *)h, sizeof(*h));
+}
+
+/**
+ * @brief			Appends a piece to the info of HKDF-Expand.
+ *
+ * @param[in,out] info		The info, its length is the used part.
+ * @param size			Size of the info buffer.
+ * @param[in] piece		The piece.
+ * @return			Ok or error code.
+ */
+static enum err info_append(struct byte_array *info, uint32_t size,
+			    const struct byte_array *piece)
+{
+	TRY(_memcpy_s(info->ptr + info->len, size - info->len, piece->ptr,
+		      piece->len));
+	info->len += piece->len;
+	return ok;
+}
+
+/**
+ * @brief			EDHOC-KDF with hkdf_expand(). The info is 
+ *				assembled from the pieces of the context.
+ */
+static enum err kdf_hkdf_expand(const struct prk_handle *h, uint8_t label,
+				const struct byte_array *context,
+				uint32_t context_pieces, uint32_t context_len,
+				struct byte_array *okm)
+{
+	BYTE_ARRAY_NEW(info, INFO_MAX_SIZE,
+		       AS_BSTR_SIZE(context_len) + (2 * CBOR_ENCODED_UINT));
+	uint32_t size = info.len;
+	info.len = 0;
+
+	TRY(cbor_head_append(&info, size, CBOR_MAJOR_TYPE_UINT, label));
+	TRY(cbor_head_append(&info, size, CBOR_MAJOR_TYPE_BSTR, context_len));
+	for (uint32_t j = 0; j < context_pieces; j++) {
+		TRY(info_append(&info, size, &context[j]));
+	}
+	TRY(cbor_head_append(&info, size, CBOR_MAJOR_TYPE_UINT, okm->len));
 	PRINT_ARRAY("info", info.ptr, info.len);
-	return hkdf_expand(hash_alg, prk, &info, okm);
+
+	uint8_t prk_buf[HASH_SIZE];
+	memcpy(prk_buf, h->prk, h->prk_len);
+	struct byte_array prk = BYTE_ARRAY_INIT(prk_buf, h->prk_len);
+	enum err r = hkdf_expand(h->alg, &prk, &info, okm);
+	secure_erase(prk_buf, sizeof(prk_buf));
+	return r;
+}
+
+/**
+ * @brief			Computes the block T(i) of HKDF-Expand from a 
+ *				copy of the keyed HMAC state. The copy is 
+ *				released on all paths.
+ *
+ * @param[in] h			The prepared PRK.
+ * @param label			The label.
+ * @param[in] context		The pieces of the context.
+ * @param context_pieces	Number of pieces.
+ * @param context_len		Length of the context.
+ * @param okm_len		Length of the output keying material.
+ * @param i			The block index, starting with 1.
+ * @param[in,out] t		T(i-1) in, T(i) out.
+ * @return			Ok or error code.
+ */
+static enum err kdf_block(const struct prk_handle *h, uint8_t label,
+			  const struct byte_array *context,
+			  uint32_t context_pieces, uint32_t context_len,
+			  uint32_t okm_len, uint8_t i, struct byte_array *t)
+{
+	/*the heads of the label and of the context precede the context
+	 *pieces, the head of the length and the counter i follow them*/
+	uint8_t head_buf[2 * CBOR_HEAD_MAX_SIZE];
+	struct byte_array head = BYTE_ARRAY_INIT(head_buf, 0);
+	TRY(cbor_head_append(&head, sizeof(head_buf), CBOR_MAJOR_TYPE_UINT,
+			     label));
+	TRY(cbor_head_append(&head, sizeof(head_buf), CBOR_MAJOR_TYPE_BSTR,
+			     context_len));
+
+	uint8_t tail_buf[CBOR_HEAD_MAX_SIZE + 1];
+	struct byte_array tail = BYTE_ARRAY_INIT(tail_buf, 0);
+	TRY(cbor_head_append(&tail, sizeof(tail_buf), CBOR_MAJOR_TYPE_UINT,
+			     okm_len));
+	tail.ptr[tail.len++] = i;
+
+	struct hmac_ctx ctx;
+	enum err r;
+
+	TRY(hmac_clone(&h->keyed, &ctx));
+	r = (i > 1) ? hmac_update(&ctx, t) : ok;
+	if (ok == r) {
+		r = hmac_update(&ctx, &head);
+	}
+	for (uint32_t j = 0; (ok == r) && (j < context_pieces); j++) {
+		r = hmac_update(&ctx, &context[j]);
+	}
+	if (ok == r) {
+		r = hmac_update(&ctx, &tail);
+	}
+	if (ok == r) {
+		/*releases the context also if it fails*/
+		return hmac_final(&ctx, t);
+	}
+	hmac_abort(&ctx);
+	return r;
+}
+
+enum err edhoc_kdf_handle(const struct prk_handle *h, uint8_t label,
+			  const struct byte_array *context,
+			  uint32_t context_pieces, struct byte_array *okm)
+{
+	uint32_t hash_len = get_hash_len(h->alg);
+	if ((0 == hash_len) || (HASH_SIZE < hash_len)) {
+		return crypto_operation_not_implemented;
+	}
+	/* "N = ceil(L/HashLen)", "L length of output keying material in 
+	 * octets (<= 255*HashLen)"*/
+	uint32_t iterations = (okm->len + hash_len - 1) / hash_len;
+	if (iterations > 255) {
+		return hkdf_failed;
+	}
+
+	uint32_t context_len = 0;
+	for (uint32_t j = 0; j < context_pieces; j++) {
+		context_len += context[j].len;
+	}
+	PRINTF("context len: %d\n", context_len);
+
+	if (h->expand) {
+		return kdf_hkdf_expand(h, label, context, context_pieces,
+				       context_len, okm);
+	}
+
+	/*T(i) = HMAC(PRK, T(i-1) | info | i), where 
+	info = (label: int, context: bstr, length: uint)*/
+	BYTE_ARRAY_NEW(t, HASH_SIZE, hash_len);
+	enum err r = ok;
+	for (uint32_t i = 1; (ok == r) && (i <= iterations); i++) {
+		r = kdf_block(h, label, context, context_pieces, context_len,
+			      okm->len, (uint8_t)i, &t);
+		if (ok == r) {
+			uint32_t offset = (i - 1) * hash_len;
+			uint32_t chunk = okm->len - offset;
+			if (chunk > hash_len) {
+				chunk = hash_len;
+			}
+			memcpy(okm->ptr + offset, t.ptr, chunk);
+		}
+	}
+	secure_erase(t.ptr, t.len);
+	if (ok != r) {
+		secure_erase(okm->ptr, okm->len);
+	}
+	return r;
+}
+
+enum err edhoc_kdf_pieces(enum hash_alg hash_alg, const struct byte_array *prk,
+			  uint8_t label, const struct byte_array *context,
+			  uint32_t context_pieces, struct byte_array *okm)
+{
+	struct prk_handle h;
+	TRY(prk_handle_init(hash_alg, prk, &h));
+	enum err r = edhoc_kdf_handle(&h, label, context, context_pieces, okm);
+	prk_handle_wipe(&h);
+	return r;
+}
+
+enum err edhoc_kdf(enum hash_alg hash_alg, const struct byte_array *prk,
+		   uint8_t label, struct byte_array *context,
+		   struct byte_array *okm)
+{
+	return edhoc_kdf_pieces(hash_alg, prk, label, context, 1, okm);
 }
@@ -24,8 +24,10 @@
 
 enum err prk_derive(bool static_dh_auth, struct suite suite, uint8_t label,
 		    struct byte_array *context, const struct byte_array *prk_in,
+		    const struct prk_handle *prk_in_h,
 		    const struct byte_array *stat_pk,
-		    const struct byte_array *stat_sk, uint8_t *prk_out)
+		    const struct byte_array *stat_sk, uint8_t *prk_out,
+		    struct prk_handle *prk_out_h)
 {
 	if (static_dh_auth) {
 		BYTE_ARRAY_NEW(dh_secret, ECDH_SECRET_SIZE, ECDH_SECRET_SIZE);
@@ -35,13 +37,17 @@ enum err prk_derive(bool static_dh_auth, struct suite suite, uint8_t label,
 		PRINT_ARRAY("dh_secret", dh_secret.ptr, dh_secret.len);
 
 		BYTE_ARRAY_NEW(salt, HASH_SIZE, get_hash_len(suite.edhoc_hash));
-		TRY(edhoc_kdf(suite.edhoc_hash, prk_in, label, context, &salt));
+		TRY(edhoc_kdf_handle(prk_in_h, label, context, 1, &salt));
 		PRINT_ARRAY("SALT_3e2m or SALT4e3m", salt.ptr, salt.len);
 
 		TRY(hkdf_extract(suite.edhoc_hash, &salt, &dh_secret, prk_out));
+
+		struct byte_array out = BYTE_ARRAY_INIT(prk_out, prk_in->len);
+		TRY(prk_handle_init(suite.edhoc_hash, &out, prk_out_h));
 	} else {
 		/*it is save to do that since prks have the same size*/
 		memcpy(prk_out, prk_in->ptr, prk_in->len);
+		TRY(prk_handle_copy(prk_in_h, prk_out_h));
 	}
 	return ok;
 }
@@ -28,6 +28,7 @@
 #include "edhoc/th.h"
 #include "edhoc/txrx_wrapper.h"
 #include "edhoc/ciphertext.h"
+#include "edhoc/ephemeral_key_pool.h"
 #include "edhoc/suites.h"
 #include "edhoc/runtime_context.h"
 #include "edhoc/bstr_encode_decode.h"
@@ -42,6 +43,35 @@
 #define CBOR_BSTR_TYPE_MIN_VALUE (0x40)
 #define CBOR_BSTR_TYPE_MAX_VALUE (0x57)
 
+/**
+ * @brief   			Copies C_I out of a decoded message 1.
+ * @param[in] m 		The decoded message 1.
+ * @param[out] c_i 		Connection identifier of the initiator.
+ * @retval 			Ok or error code.
+ */
+static enum err msg1_c_i(const struct message_1 *m, struct byte_array *c_i)
+{
+	if (m->message_1_C_I_choice == message_1_C_I_int_c) {
+		c_i->ptr[0] = (uint8_t)m->message_1_C_I_int;
+		c_i->len = 1;
+	} else {
+		TRY(_memcpy_s(c_i->ptr, c_i->len, m->message_1_C_I_bstr.value,
+			      (uint32_t)m->message_1_C_I_bstr.len));
+		c_i->len = (uint32_t)m->message_1_C_I_bstr.len;
+	}
+	return ok;
+}
+
+enum err msg1_c_i_get(const struct byte_array *msg1, struct byte_array *c_i)
+{
+	struct message_1 m;
+	size_t decode_len = 0;
+
+	TRY_EXPECT(cbor_decode_message_1(msg1->ptr, msg1->len, &m, &decode_len),
+		   0);
+	return msg1_c_i(&m, c_i);
+}
+
 /**
  * @brief   			Parses message 1.
  * @param[in] msg1 		Message 1.
@@ -101,14 +131,7 @@ msg1_parse(struct byte_array *msg1, enum method_type *method,
 	PRINT_ARRAY("msg1 G_X", g_x->ptr, g_x->len);
 
 	/*C_I*/
-	if (m.message_1_C_I_choice == message_1_C_I_int_c) {
-		c_i->ptr[0] = (uint8_t)m.message_1_C_I_int;
-		c_i->len = 1;
-	} else {
-		TRY(_memcpy_s(c_i->ptr, c_i->len, m.message_1_C_I_bstr.value,
-			      (uint32_t)m.message_1_C_I_bstr.len));
-		c_i->len = (uint32_t)m.message_1_C_I_bstr.len;
-	}
+	TRY(msg1_c_i(&m, c_i));
 	PRINT_ARRAY("msg1 C_I_raw", c_i->ptr, c_i->len);
 
 	/*ead_1*/
@@ -133,14 +156,42 @@ static inline bool selected_suite_is_supported(uint8_t selected,
 					       struct byte_array *suites_r)
 {
 	for (uint32_t i = 0; i < suites_r->len; i++) {
-		if (suites_r->ptr[i] == selected)
+		if (suites_r->ptr[i] == selected) {
 			PRINTF("Suite %d will be used in this EDHOC run.\n",
 			       selected);
-		return true;
+			return true;
+		}
 	}
 	return false;
 }
 
+/**
+ * @brief   			Encodes an error message with ERR_CODE 2 
+ * 				(wrong selected cipher suite) and the supported 
+ * 				suites as SUITES_R, see RFC 9528 Section 6.3.
+ * @param[in] suites_r 		The list of supported cipher suites.
+ * @param[in,out] msg 		The buffer for the error message.
+ * @retval  			Ok or error code.
+ */
+static enum err suites_error_encode(const struct byte_array *suites_r,
+				    struct byte_array *msg)
+{
+	uint32_t size = msg->len;
+	msg->len = 0;
+	TRY(cbor_head_append(msg, size, CBOR_MAJOR_TYPE_UINT,
+			     ERR_CODE_WRONG_SELECTED_CIPHER_SUITE));
+	/*SUITES_R: [2* suite] / suite*/
+	if (1 != suites_r->len) {
+		TRY(cbor_head_append(msg, size, CBOR_MAJOR_TYPE_ARRAY,
+				     suites_r->len));
+	}
+	for (uint32_t i = 0; i < suites_r->len; i++) {
+		TRY(cbor_head_append(msg, size, CBOR_MAJOR_TYPE_UINT,
+				     suites_r->ptr[i]));
+	}
+	return ok;
+}
+
 /**
  * @brief   			Encodes message 2.
  * @param[in] g_y 		Public ephemeral DH key of the responder. 
@@ -167,8 +218,18 @@ static inline enum err msg2_encode(const struct byte_array *g_y,
 	return ok;
 }
 
-enum err msg2_gen(struct edhoc_responder_context *c, struct runtime_context *rc,
-		  struct byte_array *c_i)
+/**
+ * @brief			Processes message 1 and generates message 2.
+ *
+ * @param c			The responder context.
+ * @param rc			The runtime context.
+ * @param[out] c_i		Connection identifier of the initiator.
+ * @param[out] prk_h		PRK_2e and PRK_3e2m prepared for EDHOC-KDF.
+ * @return			Ok or error code.
+ */
+static enum err msg2_only_gen(struct edhoc_responder_context *c,
+			      struct runtime_context *rc,
+			      struct byte_array *c_i, struct prk_handle *prk_h)
 {
 	PRINT_ARRAY("message_1 (CBOR Sequence)", rc->msg.ptr, rc->msg.len);
 
@@ -178,10 +239,16 @@ enum err msg2_gen(struct edhoc_responder_context *c, struct runtime_context *rc,
 
 	TRY(msg1_parse(&rc->msg, &method, &suites_i, &g_x, c_i, &rc->ead));
 
-	// TODO this may be a vulnerability in case suites_i.len is zero
+	if (0 == suites_i.len) {
+		return suites_i_list_empty;
+	}
 	if (!(selected_suite_is_supported(suites_i.ptr[suites_i.len - 1],
 					  &c->suites_r))) {
-		// TODO implement here the sending of an error message
+		/*the initiator may send message 1 again with one of SUITES_R*/
+		rc->msg.ptr = rc->msg_buf;
+		rc->msg.len = sizeof(rc->msg_buf);
+		TRY(suites_error_encode(&c->suites_r, &rc->msg));
+		PRINT_ARRAY("error message", rc->msg.ptr, rc->msg.len);
 		return error_message_sent;
 	}
 
@@ -192,24 +259,32 @@ enum err msg2_gen(struct edhoc_responder_context *c, struct runtime_context *rc,
 	bool static_dh_r;
 	authentication_type_get(method, &rc->static_dh_i, &static_dh_r);
 
+	if (!ephemeral_key_select(rc, rc->suite.edhoc_ecdh, &c->y, &c->g_y)) {
+		return ephemeral_key_unavailable;
+	}
+
 	/******************* create and send message 2*************************/
 	BYTE_ARRAY_NEW(th2, HASH_SIZE, get_hash_len(rc->suite.edhoc_hash));
 	TRY(hash(rc->suite.edhoc_hash, &rc->msg, &rc->msg1_hash));
-	TRY(th2_calculate(rc->suite.edhoc_hash, &rc->msg1_hash, &c->g_y, &th2));
+	TRY(th2_calculate(rc->suite.edhoc_hash, &rc->msg1_hash, &rc->eph_pk,
+			  &th2));
 
 	/*calculate the DH shared secret*/
 	BYTE_ARRAY_NEW(g_xy, ECDH_SECRET_SIZE, ECDH_SECRET_SIZE);
-	TRY(shared_secret_derive(rc->suite.edhoc_ecdh, &c->y, &g_x, g_xy.ptr));
+	TRY(shared_secret_derive(rc->suite.edhoc_ecdh, &rc->eph_sk, &g_x,
+				 g_xy.ptr));
 
 	PRINT_ARRAY("G_XY (ECDH shared secret) ", g_xy.ptr, g_xy.len);
 
 	BYTE_ARRAY_NEW(PRK_2e, PRK_SIZE, PRK_SIZE);
 	TRY(hkdf_extract(rc->suite.edhoc_hash, &th2, &g_xy, PRK_2e.ptr));
 	PRINT_ARRAY("PRK_2e", PRK_2e.ptr, PRK_2e.len);
+	TRY(prk_handle_init(rc->suite.edhoc_hash, &PRK_2e, &prk_h[PRK_2E_H]));
 
 	/*derive prk_3e2m*/
-	TRY(prk_derive(static_dh_r, rc->suite, SALT_3e2m, &th2, &PRK_2e, &g_x,
-		       &c->r, rc->prk_3e2m.ptr));
+	TRY(prk_derive(static_dh_r, rc->suite, SALT_3e2m, &th2, &PRK_2e,
+		       &prk_h[PRK_2E_H], &g_x, &c->r, rc->prk_3e2m.ptr,
+		       &prk_h[PRK_3E2M_H]));
 	PRINT_ARRAY("prk_3e2m", rc->prk_3e2m.ptr, rc->prk_3e2m.len);
 
 	/*compute signature_or_MAC_2*/
@@ -217,7 +292,7 @@ enum err msg2_gen(struct edhoc_responder_context *c, struct runtime_context *rc,
 		       get_signature_len(rc->suite.edhoc_sign));
 
 	TRY(signature_or_mac(GENERATE, static_dh_r, &rc->suite, &c->sk_r,
-			     &c->pk_r, &rc->prk_3e2m, &c->c_r, &th2,
+			     &c->pk_r, &prk_h[PRK_3E2M_H], &c->c_r, &th2,
 			     &c->id_cred_r, &c->cred_r, &c->ead_2, MAC_2,
 			     &sign_or_mac_2));
 
@@ -228,14 +303,14 @@ enum err msg2_gen(struct edhoc_responder_context *c, struct runtime_context *rc,
 	BYTE_ARRAY_NEW(ciphertext_2, CIPHERTEXT2_SIZE, plaintext_2.len);
 
 	TRY(ciphertext_gen(CIPHERTEXT2, &rc->suite, &c->c_r, &c->id_cred_r,
-			   &sign_or_mac_2, &c->ead_2, &PRK_2e, &th2,
+			   &sign_or_mac_2, &c->ead_2, &prk_h[PRK_2E_H], &th2,
 			   &ciphertext_2, &plaintext_2));
 
 	/* Clear the message buffer. */
 	memset(rc->msg.ptr, 0, rc->msg.len);
 	rc->msg.len = sizeof(rc->msg_buf);
 	/*message 2 create*/
-	TRY(msg2_encode(&c->g_y, &c->c_r, &ciphertext_2, &rc->msg));
+	TRY(msg2_encode(&rc->eph_pk, &c->c_r, &ciphertext_2, &rc->msg));
 
 	TRY(th34_calculate(rc->suite.edhoc_hash, &th2, &plaintext_2, &c->cred_r,
 			   &rc->th3));
@@ -243,11 +318,26 @@ enum err msg2_gen(struct edhoc_responder_context *c, struct runtime_context *rc,
 	return ok;
 }
 
-enum err msg3_process(struct edhoc_responder_context *c,
-		      struct runtime_context *rc,
-		      struct cred_array *cred_i_array,
-		      struct byte_array *prk_out,
-		      struct byte_array *initiator_pk)
+enum err msg2_gen(struct edhoc_responder_context *c, struct runtime_context *rc,
+		  struct byte_array *c_i)
+{
+	/*PRK_2e and PRK_3e2m prepared for EDHOC-KDF*/
+	struct prk_handle prk_h[PRK_HANDLES];
+	memset(prk_h, 0, sizeof(prk_h));
+
+	enum err r = msg2_only_gen(c, rc, c_i, prk_h);
+
+	for (uint32_t i = 0; i < PRK_HANDLES; i++) {
+		prk_handle_wipe(&prk_h[i]);
+	}
+	return r;
+}
+
+static enum err msg3_decrypt_verify(struct runtime_context *rc,
+				    struct cred_array *cred_i_array,
+				    struct byte_array *prk_out,
+				    struct byte_array *initiator_pk,
+				    struct prk_handle *prk_h)
 {
 	BYTE_ARRAY_NEW(ctxt3, CIPHERTEXT3_SIZE, rc->msg.len);
 	TRY(decode_bstr(&rc->msg, &ctxt3));
@@ -268,9 +358,13 @@ enum err msg3_process(struct edhoc_responder_context *c,
 		       ctxt3.len);
 #endif
 
+	/*PRK_3e2m is kept since message 2 and prepared again*/
+	TRY(prk_handle_init(rc->suite.edhoc_hash, &rc->prk_3e2m,
+			    &prk_h[PRK_3E2M_H]));
 	TRY(ciphertext_decrypt_split(CIPHERTEXT3, &rc->suite, NULL, &id_cred_i,
-				     &sign_or_mac, &rc->ead, &rc->prk_3e2m,
-				     &rc->th3, &ctxt3, &ptxt3));
+				     &sign_or_mac, &rc->ead,
+				     &prk_h[PRK_3E2M_H], &rc->th3, &ctxt3,
+				     &ptxt3));
 
 	/*check the authenticity of the initiator*/
 	BYTE_ARRAY_NEW(cred_i, CRED_I_SIZE, CRED_I_SIZE);
@@ -291,12 +385,14 @@ enum err msg3_process(struct edhoc_responder_context *c,
 
 	/*derive prk_4e3m*/
 	TRY(prk_derive(rc->static_dh_i, rc->suite, SALT_4e3m, &rc->th3,
-		       &rc->prk_3e2m, &g_i, &c->y, rc->prk_4e3m.ptr));
+		       &rc->prk_3e2m, &prk_h[PRK_3E2M_H], &g_i, &rc->eph_sk,
+		       rc->prk_4e3m.ptr, &prk_h[PRK_4E3M_H]));
 	PRINT_ARRAY("prk_4e3m", rc->prk_4e3m.ptr, rc->prk_4e3m.len);
 
 	TRY(signature_or_mac(VERIFY, rc->static_dh_i, &rc->suite, NULL, &pk,
-			     &rc->prk_4e3m, &NULL_ARRAY, &rc->th3, &id_cred_i,
-			     &cred_i, &rc->ead, MAC_3, &sign_or_mac));
+			     &prk_h[PRK_4E3M_H], &NULL_ARRAY, &rc->th3,
+			     &id_cred_i, &cred_i, &rc->ead, MAC_3,
+			     &sign_or_mac));
 
 	/*TH4*/
 	// ptxt3.len = ptxt3.len - get_aead_mac_len(rc->suite.edhoc_aead);
@@ -304,11 +400,32 @@ enum err msg3_process(struct edhoc_responder_context *c,
 			   &rc->th4));
 
 	/*PRK_out*/
-	TRY(edhoc_kdf(rc->suite.edhoc_hash, &rc->prk_4e3m, PRK_out, &rc->th4,
-		      prk_out));
+	TRY(edhoc_kdf_handle(&prk_h[PRK_4E3M_H], PRK_out, &rc->th4, 1,
+			     prk_out));
 	return ok;
 }
 
+enum err msg3_process(struct edhoc_responder_context *c,
+		      struct runtime_context *rc,
+		      struct cred_array *cred_i_array,
+		      struct byte_array *prk_out,
+		      struct byte_array *initiator_pk)
+{
+	(void)c;
+	/*PRK_3e2m and PRK_4e3m prepared for EDHOC-KDF*/
+	struct prk_handle prk_h[PRK_HANDLES];
+	memset(prk_h, 0, sizeof(prk_h));
+
+	/*after message 3 the ephemeral key is not needed anymore*/
+	enum err r = msg3_decrypt_verify(rc, cred_i_array, prk_out,
+					 initiator_pk, prk_h);
+	ephemeral_key_erase(rc);
+	for (uint32_t i = 0; i < PRK_HANDLES; i++) {
+		prk_handle_wipe(&prk_h[i]);
+	}
+	return r;
+}
+
 #ifdef MESSAGE_4
 enum err msg4_gen(struct edhoc_responder_context *c, struct runtime_context *rc)
 {
@@ -320,9 +437,13 @@ enum err msg4_gen(struct edhoc_responder_context *c, struct runtime_context *rc)
 	struct byte_array ptxt4 = BYTE_ARRAY_INIT(NULL, 0);
 #endif
 
-	TRY(ciphertext_gen(CIPHERTEXT4, &rc->suite, &NULL_ARRAY, &NULL_ARRAY,
-			   &NULL_ARRAY, &c->ead_4, &rc->prk_4e3m, &rc->th4,
-			   &ctxt4, &ptxt4));
+	struct prk_handle prk_4e3m;
+	TRY(prk_handle_init(rc->suite.edhoc_hash, &rc->prk_4e3m, &prk_4e3m));
+	enum err r = ciphertext_gen(CIPHERTEXT4, &rc->suite, &NULL_ARRAY,
+				    &NULL_ARRAY, &NULL_ARRAY, &c->ead_4,
+				    &prk_4e3m, &rc->th4, &ctxt4, &ptxt4);
+	prk_handle_wipe(&prk_4e3m);
+	TRY(r);
 
 	TRY(encode_bstr(&ctxt4, &rc->msg));
 
@@ -347,14 +468,34 @@ enum err edhoc_responder_run_extended(
 	TRY(rx(c->sock, &rc.msg));
 
 	/*create and send message 2*/
-	TRY(msg2_gen(c, &rc, c_i_bytes));
-	TRY(ead_process(c->params_ead_process, &rc.ead));
-	TRY(tx(c->sock, &rc.msg));
+	enum err r = msg2_gen(c, &rc, c_i_bytes);
+	if (error_message_sent == r) {
+		/*the selected suite is not supported, send SUITES_R*/
+		TRY(tx(c->sock, &rc.msg));
+		if ((NULL != err_msg) &&
+		    (ok == _memcpy_s(err_msg->ptr, err_msg->len, rc.msg.ptr,
+				     rc.msg.len))) {
+			err_msg->len = rc.msg.len;
+		}
+	}
+	if (ok == r) {
+		r = ead_process(c->params_ead_process, &rc.ead);
+	}
+	if (ok == r) {
+		r = tx(c->sock, &rc.msg);
+	}
 
 	/*receive message 3*/
-	PRINT_MSG("waiting to receive message 3...\n");
-	rc.msg.len = sizeof(rc.msg_buf);
-	TRY(rx(c->sock, &rc.msg));
+	if (ok == r) {
+		PRINT_MSG("waiting to receive message 3...\n");
+		rc.msg.len = sizeof(rc.msg_buf);
+		r = rx(c->sock, &rc.msg);
+	}
+	if (ok != r) {
+		/*a private key taken from the pool is in rc*/
+		ephemeral_key_erase(&rc);
+		return r;
+	}
 	TRY(msg3_process(c, &rc, cred_i_array, prk_out, initiator_pub_key));
 	TRY(ead_process(c->params_ead_process, &rc.ead));
 
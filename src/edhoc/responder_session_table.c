@@ -0,0 +1,219 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stddef.h>
+
+#include "edhoc_internal.h"
+#include "edhoc/responder_session_table.h"
+
+#include "common/byte_array.h"
+#include "common/memcpy_s.h"
+#include "common/oscore_edhoc_error.h"
+
+/**
+ * @brief Writes the C_R belonging to a slot index.
+ */
+static void c_r_from_index(uint32_t index,
+			   uint8_t c_r[EDHOC_SESSION_TABLE_C_R_LEN])
+{
+#if EDHOC_SESSION_TABLE_C_R_LEN == 1
+	c_r[0] = (uint8_t)index;
+#else
+	c_r[0] = (uint8_t)(index >> 8);
+	c_r[1] = (uint8_t)index;
+#endif
+}
+
+/**
+ * @brief Returns the slot index encoded in a C_R.
+ */
+static enum err c_r_to_index(const struct byte_array *c_r, uint32_t *index)
+{
+	if ((NULL == c_r) || (NULL == c_r->ptr) ||
+	    (EDHOC_SESSION_TABLE_C_R_LEN != c_r->len)) {
+		return edhoc_session_not_found;
+	}
+#if EDHOC_SESSION_TABLE_C_R_LEN == 1
+	*index = c_r->ptr[0];
+#else
+	*index = (uint32_t)((c_r->ptr[0] << 8) | c_r->ptr[1]);
+#endif
+	if (*index >= EDHOC_SESSION_TABLE_SIZE) {
+		return edhoc_session_not_found;
+	}
+	return ok;
+}
+
+static struct edhoc_responder_session_slot *
+slot_take(struct edhoc_responder_session_table *t)
+{
+	if (0 == t->free_cnt) {
+		return NULL;
+	}
+	/*the count is read by edhoc_responder_session_table_in_progress()*/
+	__atomic_store_n(&t->free_cnt, t->free_cnt - 1, __ATOMIC_RELEASE);
+	struct edhoc_responder_session_slot *slot =
+		&t->slots[t->free_slots[t->free_cnt]];
+	slot->in_use = true;
+	return slot;
+}
+
+static void slot_give(struct edhoc_responder_session_table *t,
+		      struct edhoc_responder_session_slot *slot)
+{
+	if (!slot->in_use) {
+		return;
+	}
+	/*the session holds the keys of the handshake, e.g. PRK_out*/
+	secure_erase((uint8_t *)&slot->s, sizeof(slot->s));
+	slot->in_use = false;
+	t->free_slots[t->free_cnt] = (uint16_t)(slot - t->slots);
+	__atomic_store_n(&t->free_cnt, t->free_cnt + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Prepares a slot for a new handshake.
+ */
+static void slot_start(struct edhoc_responder_session_table *t,
+		       struct edhoc_responder_session_slot *slot, uint32_t now)
+{
+	slot->c = *t->c;
+	c_r_from_index((uint32_t)(slot - t->slots), slot->c_r_buf);
+	slot->c.c_r.ptr = slot->c_r_buf;
+	slot->c.c_r.len = sizeof(slot->c_r_buf);
+	edhoc_responder_session_init(&slot->s, &slot->c, t->cred_i_array);
+	slot->deadline = now + t->timeout;
+}
+
+void edhoc_responder_session_table_init(
+	struct edhoc_responder_session_table *t,
+	const struct edhoc_responder_context *c,
+	struct cred_array *cred_i_array, uint32_t timeout)
+{
+	t->c = c;
+	t->cred_i_array = cred_i_array;
+	t->timeout = timeout;
+	/*the free slots are taken from the end of the list, start with 0*/
+	for (uint32_t i = 0; i < EDHOC_SESSION_TABLE_SIZE; i++) {
+		t->slots[i].in_use = false;
+		t->free_slots[i] =
+			(uint16_t)(EDHOC_SESSION_TABLE_SIZE - 1 - i);
+	}
+	__atomic_store_n(&t->free_cnt, EDHOC_SESSION_TABLE_SIZE,
+			 __ATOMIC_RELEASE);
+}
+
+enum err edhoc_responder_session_table_msg1(
+	struct edhoc_responder_session_table *t, uint32_t now,
+	const struct byte_array *msg1, struct byte_array *msg2,
+	struct edhoc_responder_session **s)
+{
+	enum edhoc_step_status status;
+	uint8_t c_i_buf[C_I_SIZE];
+	uint8_t c_r_buf[EDHOC_SESSION_TABLE_C_R_LEN];
+	struct byte_array c_i = BYTE_ARRAY_INIT(c_i_buf, sizeof(c_i_buf));
+	struct byte_array c_r = BYTE_ARRAY_INIT(c_r_buf, sizeof(c_r_buf));
+
+	/*C_I is looked at before the slot is chosen, so that message 2 is
+	created only once*/
+	TRY(msg1_c_i_get(msg1, &c_i));
+
+	struct edhoc_responder_session_slot *slot = slot_take(t);
+	if (NULL == slot) {
+		return edhoc_session_table_full;
+	}
+	c_r_from_index((uint32_t)(slot - t->slots), c_r_buf);
+	if (array_equals(&c_i, &c_r)) {
+		/* C_R must be different from C_I (RFC9528 Section 3.3.2), use
+		 * the next free slot. The colliding slot is given back after
+		 * that, so that it is not taken again. */
+		struct edhoc_responder_session_slot *colliding = slot;
+		slot = slot_take(t);
+		slot_give(t, colliding);
+		if (NULL == slot) {
+			return edhoc_session_table_full;
+		}
+	}
+	slot_start(t, slot, now);
+
+	enum err r = edhoc_responder_session_step(&slot->s, msg1, msg2, &status);
+	if (ok != r) {
+		slot_give(t, slot);
+		return r;
+	}
+	*s = &slot->s;
+	return ok;
+}
+
+enum err edhoc_responder_session_table_get(
+	struct edhoc_responder_session_table *t, const struct byte_array *c_r,
+	struct edhoc_responder_session **s)
+{
+	uint32_t index;
+	TRY(c_r_to_index(c_r, &index));
+	if (!t->slots[index].in_use) {
+		return edhoc_session_not_found;
+	}
+	*s = &t->slots[index].s;
+	return ok;
+}
+
+enum err edhoc_responder_session_table_msg3(
+	struct edhoc_responder_session_table *t, const struct byte_array *c_r,
+	const struct byte_array *msg3, struct byte_array *msg4,
+	struct edhoc_responder_session **s)
+{
+	enum edhoc_step_status status;
+
+	TRY(edhoc_responder_session_table_get(t, c_r, s));
+	enum err r = edhoc_responder_session_step(*s, msg3, msg4, &status);
+	if (ok != r) {
+		edhoc_responder_session_table_release(t, *s);
+		*s = NULL;
+	}
+	return r;
+}
+
+void edhoc_responder_session_table_release(
+	struct edhoc_responder_session_table *t,
+	struct edhoc_responder_session *s)
+{
+	if (NULL == s) {
+		return;
+	}
+	/*s is the first member of the slot*/
+	slot_give(t, (struct edhoc_responder_session_slot *)s);
+}
+
+uint32_t
+edhoc_responder_session_table_expire(struct edhoc_responder_session_table *t,
+				     uint32_t now)
+{
+	uint32_t expired = 0;
+	for (uint32_t i = 0; i < EDHOC_SESSION_TABLE_SIZE; i++) {
+		struct edhoc_responder_session_slot *slot = &t->slots[i];
+		/*the difference is evaluated signed to allow wrap around of
+		the time*/
+		if (slot->in_use && (EDHOC_SESSION_DONE != slot->s.state) &&
+		    ((int32_t)(now - slot->deadline) >= 0)) {
+			slot_give(t, slot);
+			expired++;
+		}
+	}
+	return expired;
+}
+
+uint32_t edhoc_responder_session_table_in_progress(
+	const struct edhoc_responder_session_table *t)
+{
+	return EDHOC_SESSION_TABLE_SIZE -
+	       __atomic_load_n(&t->free_cnt, __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,513 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "edhoc.h"
+#include "edhoc/bstr_encode_decode.h"
+#include "edhoc/resumption_store.h"
+#include "edhoc/suites.h"
+
+#include "common/byte_array.h"
+#include "common/crypto_wrapper.h"
+#include "common/memcpy_s.h"
+#include "common/oscore_edhoc_error.h"
+
+static bool id_equals(const struct resumption_entry *e,
+		      const struct byte_array *id)
+{
+	return (e->id_len == id->len) &&
+	       ((0 == id->len) || (0 == memcmp(e->id, id->ptr, id->len)));
+}
+
+/* The key of an entry, see entry_find() */
+struct entry_key {
+	const struct byte_array *id;
+	const uint8_t *peer;
+};
+
+static bool entry_match(const void *entry, const void *key)
+{
+	const struct resumption_entry *e = entry;
+	const struct entry_key *k = key;
+	return id_equals(e, k->id) &&
+	       ((NULL == k->peer) ||
+		(0 == memcmp(e->peer, k->peer, sizeof(e->peer))));
+}
+
+/**
+ * @brief	Finds the valid entry of a connection. An expired entry is
+ *		erased. Must be called with the store locked.
+ *
+ * @param store	The store.
+ * @param[in] id The connection identifier C_R.
+ * @param[in] peer The digest of the peer identity or NULL to match any
+ *		peer.
+ * @param now	The current time.
+ */
+static struct resumption_entry *entry_find(struct resumption_store *store,
+					   const struct byte_array *id,
+					   const uint8_t *peer, uint32_t now)
+{
+	struct entry_key k = { id, peer };
+	return ttl_cache_find(&store->base, entry_match, &k, now);
+}
+
+/**
+ * @brief	Checks if a peer identity is given, i.e. neither NULL nor
+ *		empty.
+ */
+static bool peer_given(const struct byte_array *peer_id)
+{
+	return (NULL != peer_id) && (0 != peer_id->len);
+}
+
+/**
+ * @brief	Computes the digest of the peer identity under which the
+ *		initiator keeps its entries.
+ *
+ * @param store	The store.
+ * @param[in] peer_id The identity of the peer, may be NULL or empty at
+ *		the responder.
+ * @param[out] digest The digest, all zero if no identity is given.
+ * @param[out] key The digest to look entries up with or NULL if the
+ *		entries are looked up by C_R only.
+ * @return	ok, wrong_parameter if the initiator passes no identity or
+ *		an error of the hash.
+ */
+static enum err peer_key(const struct resumption_store *store,
+			 const struct byte_array *peer_id,
+			 uint8_t digest[HASH_SIZE], const uint8_t **key)
+{
+	*key = NULL;
+	if (!peer_given(peer_id)) {
+		memset(digest, 0, HASH_SIZE);
+		return (RESUMPTION_INITIATOR == store->role) ? wrong_parameter :
+							       ok;
+	}
+	struct byte_array d = BYTE_ARRAY_INIT(digest, HASH_SIZE);
+	TRY(hash(SHA_256, peer_id, &d));
+	if (RESUMPTION_INITIATOR == store->role) {
+		*key = digest;
+	}
+	return ok;
+}
+
+void resumption_store_init(struct resumption_store *store,
+			   struct resumption_entry *entries,
+			   uint32_t entries_len, uint32_t ttl,
+			   enum resumption_role role)
+{
+	ttl_cache_init(&store->base, entries, sizeof(*entries), entries_len,
+		       ttl);
+	store->role = role;
+}
+
+enum err resumption_store_put(struct resumption_store *store,
+			      const struct byte_array *id,
+			      const struct byte_array *peer_id,
+			      enum suite_label suite,
+			      const struct byte_array *prk_out)
+{
+	if ((0 == store->base.entries_len) ||
+	    (id->len > RESUMPTION_ID_MAX_SIZE) || (prk_out->len != PRK_SIZE)) {
+		return wrong_parameter;
+	}
+
+	uint8_t peer[HASH_SIZE];
+	const uint8_t *key;
+	TRY(peer_key(store, peer_id, peer, &key));
+
+	struct entry_key k = { id, key };
+	uint32_t now = ttl_cache_now(&store->base);
+	ttl_cache_lock(&store->base);
+	struct resumption_entry *e =
+		ttl_cache_put(&store->base, entry_match, &k, now);
+	memcpy(e->id, id->ptr, id->len);
+	e->id_len = id->len;
+	memcpy(e->peer, peer, sizeof(e->peer));
+	e->suite = suite;
+	memcpy(e->prk_out, prk_out->ptr, prk_out->len);
+	ttl_cache_unlock(&store->base);
+	return ok;
+}
+
+/**
+ * @brief	Derives prk_out_update(PRK_out, N_I | N_R) of an entry.
+ *
+ * @param[in] e	The entry.
+ * @param[in] suite The suite of the entry.
+ * @param[in] nonce_i The nonce N_I.
+ * @param[in] nonce_r The nonce N_R.
+ * @param[out] prk_out_new The result, PRK_SIZE bytes.
+ */
+static enum err entry_update(const struct resumption_entry *e,
+			     const struct suite *suite,
+			     const struct byte_array *nonce_i,
+			     const struct byte_array *nonce_r,
+			     struct byte_array *prk_out_new)
+{
+	BYTE_ARRAY_NEW(context, 2 * RESUMPTION_NONCE_MAX_SIZE,
+		       nonce_i->len + nonce_r->len);
+	memcpy(context.ptr, nonce_i->ptr, nonce_i->len);
+	memcpy(context.ptr + nonce_i->len, nonce_r->ptr, nonce_r->len);
+
+	uint8_t prk_out_buf[PRK_SIZE];
+	memcpy(prk_out_buf, e->prk_out, sizeof(prk_out_buf));
+	struct byte_array prk_out =
+		BYTE_ARRAY_INIT(prk_out_buf, sizeof(prk_out_buf));
+	enum err r = prk_out_update(suite->app_hash, &prk_out, &context,
+				    prk_out_new);
+	secure_erase(prk_out_buf, sizeof(prk_out_buf));
+	return r;
+}
+
+/**
+ * @brief	Exports the OSCORE master secret and salt from a PRK_out.
+ */
+static enum err export_oscore(const struct suite *suite,
+			      struct byte_array *prk_out,
+			      struct byte_array *master_secret,
+			      struct byte_array *master_salt)
+{
+	BYTE_ARRAY_NEW(prk_exporter, HASH_SIZE, HASH_SIZE);
+	TRY(prk_out2exporter(suite->app_hash, prk_out, &prk_exporter));
+	enum err r = edhoc_exporter(suite->app_hash, OSCORE_MASTER_SECRET,
+				    &prk_exporter, master_secret);
+	if (ok == r) {
+		r = edhoc_exporter(suite->app_hash, OSCORE_MASTER_SALT,
+				   &prk_exporter, master_salt);
+	}
+	secure_erase(prk_exporter.ptr, prk_exporter.len);
+	return r;
+}
+
+/**
+ * @brief	Derives the OSCORE master secret and salt of a resumption with
+ *		the given nonces. If commit is set PRK_out of the entry is
+ *		replaced. Must be called with the store locked.
+ */
+static enum err entry_resume(struct resumption_entry *e,
+			     const struct byte_array *nonce_i,
+			     const struct byte_array *nonce_r, bool commit,
+			     struct byte_array *master_secret,
+			     struct byte_array *master_salt)
+{
+	struct suite suite;
+	TRY(get_suite(e->suite, &suite));
+
+	uint8_t prk_out_new_buf[PRK_SIZE];
+	struct byte_array prk_out_new =
+		BYTE_ARRAY_INIT(prk_out_new_buf, sizeof(prk_out_new_buf));
+	enum err r = entry_update(e, &suite, nonce_i, nonce_r, &prk_out_new);
+	if ((ok == r) && (NULL != master_secret)) {
+		r = export_oscore(&suite, &prk_out_new, master_secret,
+				  master_salt);
+	}
+	if ((ok == r) && commit) {
+		/*the old PRK_out must not be used again*/
+		memcpy(e->prk_out, prk_out_new_buf, sizeof(e->prk_out));
+		e->nonce_i_len = 0;
+		e->nonce_r_len = 0;
+	}
+	secure_erase(prk_out_new_buf, sizeof(prk_out_new_buf));
+	return r;
+}
+
+enum err resumption_store_resume(struct resumption_store *store,
+				 const struct byte_array *id,
+				 const struct byte_array *peer_id,
+				 const struct byte_array *nonce_i,
+				 const struct byte_array *nonce_r,
+				 struct byte_array *master_secret,
+				 struct byte_array *master_salt)
+{
+	if ((nonce_i->len > RESUMPTION_NONCE_MAX_SIZE) ||
+	    (nonce_r->len > RESUMPTION_NONCE_MAX_SIZE)) {
+		return wrong_parameter;
+	}
+
+	uint8_t peer[HASH_SIZE];
+	const uint8_t *key;
+	TRY(peer_key(store, peer_id, peer, &key));
+
+	uint32_t now = ttl_cache_now(&store->base);
+	enum err r = resumption_not_found;
+	ttl_cache_lock(&store->base);
+	struct resumption_entry *e = entry_find(store, id, key, now);
+	if ((NULL == e) && (NULL != key) &&
+	    (NULL != entry_find(store, id, NULL, now))) {
+		/*the initiator has C_R only for another peer*/
+		r = resumption_peer_mismatch;
+	} else if (NULL != e) {
+		if (peer_given(peer_id) &&
+		    (0 != memcmp(e->peer, peer, sizeof(peer)))) {
+			r = resumption_peer_mismatch;
+		} else {
+			r = entry_resume(e, nonce_i, nonce_r, true,
+					 master_secret, master_salt);
+			if (ok != r) {
+				ttl_cache_erase(&store->base, e);
+			}
+		}
+	}
+	ttl_cache_unlock(&store->base);
+	return r;
+}
+
+/**
+ * @brief	Appends a CBOR byte string to a message.
+ *
+ * @param[in,out] msg The message, its length is the used part.
+ * @param size	Size of the message buffer.
+ * @param[in] bstr The content of the byte string.
+ */
+static enum err bstr_append(struct byte_array *msg, uint32_t size,
+			    const struct byte_array *bstr)
+{
+	TRY(cbor_head_append(msg, size, CBOR_MAJOR_TYPE_BSTR, bstr->len));
+	TRY(_memcpy_s(msg->ptr + msg->len, size - msg->len, bstr->ptr,
+		      bstr->len));
+	msg->len += bstr->len;
+	return ok;
+}
+
+/**
+ * @brief	Takes a CBOR byte string from the front of a message.
+ *
+ * @param[in,out] msg The remaining message.
+ * @param max_len Maximal length of the content.
+ * @param[out] bstr The content, it points into the message.
+ */
+static enum err bstr_take(struct byte_array *msg, uint32_t max_len,
+			  struct byte_array *bstr)
+{
+	uint8_t major_type;
+	uint32_t arg, head_len;
+	TRY(decode_cbor_head(msg, &major_type, &arg, &head_len));
+	if ((CBOR_MAJOR_TYPE_BSTR != major_type) ||
+	    (msg->len - head_len < arg) || (arg > max_len)) {
+		return cbor_decoding_error;
+	}
+	bstr->ptr = msg->ptr + head_len;
+	bstr->len = arg;
+	msg->ptr += head_len + arg;
+	msg->len -= head_len + arg;
+	return ok;
+}
+
+/**
+ * @brief	Checks if a nonce equals a nonce kept in an entry.
+ */
+static bool nonce_equals(const uint8_t *kept, uint32_t kept_len,
+			 const struct byte_array *nonce)
+{
+	return (0 != kept_len) && (kept_len == nonce->len) &&
+	       (0 == memcmp(kept, nonce->ptr, kept_len));
+}
+
+enum err resumption_request_gen(struct resumption_store *store,
+				const struct byte_array *id,
+				const struct byte_array *peer_id,
+				const struct byte_array *nonce_i,
+				struct byte_array *request)
+{
+	if ((RESUMPTION_INITIATOR != store->role) || (0 == nonce_i->len) ||
+	    (nonce_i->len > RESUMPTION_NONCE_MAX_SIZE)) {
+		return wrong_parameter;
+	}
+
+	uint8_t peer[HASH_SIZE];
+	const uint8_t *key;
+	TRY(peer_key(store, peer_id, peer, &key));
+
+	uint32_t now = ttl_cache_now(&store->base);
+	uint32_t size = request->len;
+	enum err r = resumption_not_found;
+	request->len = 0;
+	ttl_cache_lock(&store->base);
+	struct resumption_entry *e = entry_find(store, id, key, now);
+	if (NULL != e) {
+		/*a pending request is sent again with the same N_I*/
+		if (0 == e->nonce_i_len) {
+			memcpy(e->nonce_i, nonce_i->ptr, nonce_i->len);
+			e->nonce_i_len = nonce_i->len;
+		}
+		struct byte_array n = BYTE_ARRAY_INIT(e->nonce_i,
+						      e->nonce_i_len);
+		r = bstr_append(request, size, id);
+		if (ok == r) {
+			r = bstr_append(request, size, &n);
+		}
+	}
+	ttl_cache_unlock(&store->base);
+	return r;
+}
+
+enum err resumption_request_process(struct resumption_store *store,
+				    const struct byte_array *request,
+				    const struct byte_array *nonce_r,
+				    struct byte_array *response,
+				    struct byte_array *id,
+				    struct byte_array *master_secret,
+				    struct byte_array *master_salt)
+{
+	if ((RESUMPTION_RESPONDER != store->role) || (0 == nonce_r->len) ||
+	    (nonce_r->len > RESUMPTION_NONCE_MAX_SIZE)) {
+		return wrong_parameter;
+	}
+
+	struct byte_array msg = *request;
+	struct byte_array c_r, nonce_i;
+	TRY(bstr_take(&msg, RESUMPTION_ID_MAX_SIZE, &c_r));
+	TRY(bstr_take(&msg, RESUMPTION_NONCE_MAX_SIZE, &nonce_i));
+	if ((0 != msg.len) || (0 == nonce_i.len)) {
+		return cbor_decoding_error;
+	}
+	TRY(_memcpy_s(id->ptr, id->len, c_r.ptr, c_r.len));
+	id->len = c_r.len;
+
+	uint32_t now = ttl_cache_now(&store->base);
+	uint32_t size = response->len;
+	enum err r = resumption_not_found;
+	response->len = 0;
+	ttl_cache_lock(&store->base);
+	struct resumption_entry *e = entry_find(store, &c_r, NULL, now);
+	if (NULL != e) {
+		/*a retransmitted request is answered with the same N_R,
+		 *another N_I replaces the pending nonces*/
+		if (!nonce_equals(e->nonce_i, e->nonce_i_len, &nonce_i)) {
+			memcpy(e->nonce_i, nonce_i.ptr, nonce_i.len);
+			e->nonce_i_len = nonce_i.len;
+			memcpy(e->nonce_r, nonce_r->ptr, nonce_r->len);
+			e->nonce_r_len = nonce_r->len;
+		}
+		struct byte_array n_i = BYTE_ARRAY_INIT(e->nonce_i,
+							e->nonce_i_len);
+		struct byte_array n_r = BYTE_ARRAY_INIT(e->nonce_r,
+							e->nonce_r_len);
+		r = entry_resume(e, &n_i, &n_r, false, master_secret,
+				 master_salt);
+		if (ok == r) {
+			r = bstr_append(response, size, &n_r);
+		}
+	}
+	ttl_cache_unlock(&store->base);
+	return r;
+}
+
+enum err resumption_response_process(struct resumption_store *store,
+				     const struct byte_array *id,
+				     const struct byte_array *peer_id,
+				     const struct byte_array *response,
+				     struct byte_array *master_secret,
+				     struct byte_array *master_salt)
+{
+	if (RESUMPTION_INITIATOR != store->role) {
+		return wrong_parameter;
+	}
+
+	struct byte_array msg = *response;
+	struct byte_array nonce_r;
+	TRY(bstr_take(&msg, RESUMPTION_NONCE_MAX_SIZE, &nonce_r));
+	if ((0 != msg.len) || (0 == nonce_r.len)) {
+		return cbor_decoding_error;
+	}
+
+	uint8_t peer[HASH_SIZE];
+	const uint8_t *key;
+	TRY(peer_key(store, peer_id, peer, &key));
+
+	uint32_t now = ttl_cache_now(&store->base);
+	enum err r = resumption_not_found;
+	ttl_cache_lock(&store->base);
+	struct resumption_entry *e = entry_find(store, id, key, now);
+	if ((NULL != e) && (0 != e->nonce_i_len)) {
+		/*a later response to a resent request may carry another N_R*/
+		memcpy(e->nonce_r, nonce_r.ptr, nonce_r.len);
+		e->nonce_r_len = nonce_r.len;
+		struct byte_array n_i = BYTE_ARRAY_INIT(e->nonce_i,
+							e->nonce_i_len);
+		struct byte_array n_r = BYTE_ARRAY_INIT(e->nonce_r,
+							e->nonce_r_len);
+		r = entry_resume(e, &n_i, &n_r, false, master_secret,
+				 master_salt);
+	}
+	ttl_cache_unlock(&store->base);
+	return r;
+}
+
+enum err resumption_store_confirm(struct resumption_store *store,
+				  const struct byte_array *id,
+				  const struct byte_array *peer_id,
+				  const struct byte_array *request,
+				  const struct byte_array *response)
+{
+	struct byte_array msg = *request;
+	struct byte_array c_r, n_i, n_r;
+	TRY(bstr_take(&msg, RESUMPTION_ID_MAX_SIZE, &c_r));
+	TRY(bstr_take(&msg, RESUMPTION_NONCE_MAX_SIZE, &n_i));
+	if ((0 != msg.len) || (0 == n_i.len)) {
+		return cbor_decoding_error;
+	}
+	msg = *response;
+	TRY(bstr_take(&msg, RESUMPTION_NONCE_MAX_SIZE, &n_r));
+	if ((0 != msg.len) || (0 == n_r.len)) {
+		return cbor_decoding_error;
+	}
+	if (!array_equals(&c_r, id)) {
+		return wrong_parameter;
+	}
+
+	uint8_t peer[HASH_SIZE];
+	const uint8_t *key;
+	TRY(peer_key(store, peer_id, peer, &key));
+
+	uint32_t now = ttl_cache_now(&store->base);
+	enum err r = resumption_not_found;
+	ttl_cache_lock(&store->base);
+	struct resumption_entry *e = entry_find(store, id, key, now);
+	if ((NULL != e) && (0 != e->nonce_i_len)) {
+		/*the pending nonces may have been replaced by a later request,
+		 *PRK_out is updated with the nonces of the exchange whose
+		 *context was shown to work*/
+		r = entry_resume(e, &n_i, &n_r, true, NULL, NULL);
+		if (ok != r) {
+			ttl_cache_erase(&store->base, e);
+		}
+	}
+	ttl_cache_unlock(&store->base);
+	return r;
+}
+
+void resumption_store_remove(struct resumption_store *store,
+			     const struct byte_array *id,
+			     const struct byte_array *peer_id)
+{
+	uint8_t peer[HASH_SIZE];
+	const uint8_t *key;
+	if (ok != peer_key(store, peer_id, peer, &key)) {
+		return;
+	}
+	ttl_cache_lock(&store->base);
+	struct resumption_entry *e =
+		entry_find(store, id, key, ttl_cache_now(&store->base));
+	if (NULL != e) {
+		ttl_cache_erase(&store->base, e);
+	}
+	ttl_cache_unlock(&store->base);
+}
+
+void resumption_store_clear(struct resumption_store *store)
+{
+	ttl_cache_clear(&store->base);
+}
@@ -12,6 +12,8 @@
 #include <string.h>
 
 #include "edhoc/cert.h"
+#include "edhoc/cert_cache.h"
+#include "edhoc/cred_index.h"
 #include "edhoc/bstr_encode_decode.h"
 #include "edhoc/retrieve_cred.h"
 
@@ -46,6 +48,20 @@ verify_cert2cred(bool static_dh_auth, struct cred_array *cred_array,
 	PRINT_ARRAY("ID_CRED_x contains a certificate", cert->ptr, cert->len);
 	TRY(encode_bstr((struct byte_array *)cert, cred));
 
+	/*a certificate verified before is not parsed and verified again*/
+	struct cert_cache_key cache_key;
+	struct byte_array *key = static_dh_auth ? g : pk;
+	if (cert_cache_get(cert, cred_array, static_dh_auth, &cache_key,
+			   key)) {
+		PRINT_MSG("Certificate found in the cache!\n");
+		if (static_dh_auth) {
+			pk->len = 0;
+		} else {
+			g->len = 0;
+		}
+		return ok;
+	}
+
 	bool verified = false;
 	switch (label) {
 	/* for now we transfer a single certificate, therefore bag and chain are the same */
@@ -77,6 +93,15 @@ verify_cert2cred(bool static_dh_auth, struct cred_array *cred_array,
 
 	if (verified) {
 		PRINT_MSG("Certificate verification successful!\n");
+		/*a compressed P256 DH pk is decompressed once, the cache and the
+		ECDH use the uncompressed form*/
+		if (static_dh_auth && (P_256_PUB_KEY_COMPRESSED_SIZE == g->len)) {
+			struct byte_array in = *g;
+			/*the buffer of g has the size G_R_SIZE or G_I_SIZE*/
+			g->len = P_256_PUB_KEY_UNCOMPRESSED_SIZE;
+			TRY(p256_pk_uncompress(&in, g));
+		}
+		cert_cache_put(&cache_key, cred_array, static_dh_auth, key);
 		return ok;
 	} else {
 		return certificate_authentication_failed;
@@ -84,6 +109,40 @@ verify_cert2cred(bool static_dh_auth, struct cred_array *cred_array,
 	return ok;
 }
 
+/**
+ * @brief 			Copies a local credential and its public key.
+ * 
+ * @param static_dh_auth 	True if static DH is used for authentication.
+ * @param[in] local 		The local credential.
+ * @param[out] cred 		The retrievd credentials	
+ * @param[out] pk 		The retrievd signature authentication public key
+ * @param[out] g 		The retrievd static DH authentication public key
+ * @return 			Ok or error code
+ */
+static enum err local_cred_copy(bool static_dh_auth,
+				const struct other_party_cred *local,
+				struct byte_array *cred, struct byte_array *pk,
+				struct byte_array *g)
+{
+	/*retrieve CRED_x*/
+	TRY(_memcpy_s(cred->ptr, cred->len, local->cred.ptr, local->cred.len));
+	cred->len = local->cred.len;
+
+	/*retrieve PK*/
+	if (static_dh_auth) {
+		pk->len = 0;
+		/*an uncompressed P256 DH pk is kept uncompressed, so that it is
+		not decompressed again in shared_secret_derive()*/
+		TRY(_memcpy_s(g->ptr, g->len, local->g.ptr, local->g.len));
+		g->len = local->g.len;
+	} else {
+		g->len = 0;
+		TRY(_memcpy_s(pk->ptr, pk->len, local->pk.ptr, local->pk.len));
+		pk->len = local->pk.len;
+	}
+	return ok;
+}
+
 /**
  * @brief 			Get the local cred object.
  * 
@@ -101,43 +160,19 @@ static enum err get_local_cred(bool static_dh_auth,
 			       struct byte_array *cred, struct byte_array *pk,
 			       struct byte_array *g)
 {
+	if (NULL != cred_array->index) {
+		const struct other_party_cred *local;
+		TRY(cred_index_find(cred_array->index, ID_cred, &local));
+		return local_cred_copy(static_dh_auth, local, cred, pk, g);
+	}
+
 	for (uint32_t i = 0; i < cred_array->len; i++) {
 		if ((cred_array->ptr[i].id_cred.len == ID_cred->len) &&
 		    (0 == memcmp(cred_array->ptr[i].id_cred.ptr, ID_cred->ptr,
 				 ID_cred->len))) {
-			/*retrieve CRED_x*/
-			TRY(_memcpy_s(cred->ptr, cred->len,
-				      cred_array->ptr[i].cred.ptr,
-				      cred_array->ptr[i].cred.len));
-			cred->len = cred_array->ptr[i].cred.len;
-
-			/*retrieve PK*/
-			if (static_dh_auth) {
-				pk->len = 0;
-				if (cred_array->ptr[i].g.len == 65) {
-					/*decompressed P256 DH pk*/
-					g->ptr[0] = 0x2;
-					TRY(_memcpy_s(
-						&g->ptr[1], g->len - 1,
-						&cred_array->ptr[i].g.ptr[1],
-						32));
-					g->len = 33;
-
-				} else {
-					TRY(_memcpy_s(g->ptr, g->len,
-						      cred_array->ptr[i].g.ptr,
-						      cred_array->ptr[i].g.len));
-					g->len = cred_array->ptr[i].g.len;
-				}
-
-			} else {
-				g->len = 0;
-				TRY(_memcpy_s(pk->ptr, pk->len,
-					      cred_array->ptr[i].pk.ptr,
-					      cred_array->ptr[i].pk.len));
-				pk->len = cred_array->ptr[i].pk.len;
-			}
-			return ok;
+			return local_cred_copy(static_dh_auth,
+					       &cred_array->ptr[i], cred, pk,
+					       g);
 		}
 	}
 
@@ -30,11 +30,20 @@ void runtime_context_init(struct runtime_context *c)
 	c->msg1_hash.ptr = c->msg1_hash_buf;
 	c->msg1_hash.len = sizeof(c->msg1_hash_buf);
 
+	c->eph_sk.ptr = NULL;
+	c->eph_sk.len = 0;
+	c->eph_pk.ptr = NULL;
+	c->eph_pk.len = 0;
+
 	c->th3.ptr = c->th3_buf;
 	c->th3.len = sizeof(c->th3_buf);
 	c->prk_3e2m.ptr = c->prk_3e2m_buf;
 	c->prk_3e2m.len = sizeof(c->prk_3e2m_buf);
 
+	c->peer_id.ptr = NULL;
+	c->peer_id.len = 0;
+	c->suites_i_len = 0;
+
 	c->th4.ptr = c->th4_buf;
 	c->th4.len = sizeof(c->th4_buf);
 	c->prk_4e3m.ptr = c->prk_4e3m_buf;
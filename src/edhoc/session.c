@@ -0,0 +1,209 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <string.h>
+
+#include "edhoc_internal.h"
+#include "edhoc/ephemeral_key_pool.h"
+
+#include "common/memcpy_s.h"
+#include "common/oscore_edhoc_error.h"
+#include "common/print_util.h"
+
+/**
+ * @brief Copies a received message into the message buffer of the runtime
+ *        context.
+ */
+static enum err msg_receive(struct runtime_context *rc,
+			    const struct byte_array *in)
+{
+	TRY(_memcpy_s(rc->msg_buf, sizeof(rc->msg_buf), in->ptr, in->len));
+	rc->msg.ptr = rc->msg_buf;
+	rc->msg.len = in->len;
+	return ok;
+}
+
+void edhoc_initiator_session_init(struct edhoc_initiator_session *s,
+				  const struct edhoc_initiator_context *c,
+				  struct cred_array *cred_r_array)
+{
+	memset(s, 0, sizeof(*s));
+	s->c = c;
+	s->cred_r_array = cred_r_array;
+	s->state = EDHOC_SESSION_START;
+	runtime_context_init(&s->rc);
+	s->c_r.ptr = s->c_r_buf;
+	s->c_r.len = sizeof(s->c_r_buf);
+	s->prk_out.ptr = s->prk_out_buf;
+	s->prk_out.len = sizeof(s->prk_out_buf);
+}
+
+void edhoc_initiator_session_peer_set(struct edhoc_initiator_session *s,
+				      const struct byte_array *peer_id)
+{
+	s->rc.peer_id = *peer_id;
+}
+
+static enum err initiator_step(struct edhoc_initiator_session *s,
+			       const struct byte_array *in,
+			       struct byte_array *out,
+			       enum edhoc_step_status *status)
+{
+	switch (s->state) {
+	case EDHOC_SESSION_START:
+		TRY(msg1_gen(s->c, &s->rc));
+		*out = s->rc.msg;
+		*status = EDHOC_STEP_SEND;
+		s->state = EDHOC_SESSION_WAIT_MSG2;
+		break;
+	case EDHOC_SESSION_WAIT_MSG2:
+		TRY(msg_receive(&s->rc, in));
+		if (msg_is_error(&s->rc.msg)) {
+			/*the responder rejected the selected suite, message 1
+			is sent again with a suite it supports*/
+			ephemeral_key_erase(&s->rc);
+			TRY(msg1_error_process(s->c, &s->rc));
+			s->rc.msg.ptr = s->rc.msg_buf;
+			s->rc.msg.len = sizeof(s->rc.msg_buf);
+			TRY(msg1_gen(s->c, &s->rc));
+			*out = s->rc.msg;
+			*status = EDHOC_STEP_SEND;
+			break;
+		}
+		TRY(msg3_gen(s->c, &s->rc, s->cred_r_array, &s->c_r,
+			     &s->prk_out));
+		*out = s->rc.msg;
+#ifdef MESSAGE_4
+		*status = EDHOC_STEP_SEND;
+		s->state = EDHOC_SESSION_WAIT_MSG4;
+#else
+		*status = EDHOC_STEP_DONE;
+		s->state = EDHOC_SESSION_DONE;
+#endif
+		break;
+#ifdef MESSAGE_4
+	case EDHOC_SESSION_WAIT_MSG4:
+		TRY(msg_receive(&s->rc, in));
+		TRY(msg4_process(&s->rc));
+		*status = EDHOC_STEP_DONE;
+		s->state = EDHOC_SESSION_DONE;
+		break;
+#endif
+	default:
+		return edhoc_session_invalid_state;
+	}
+	return ok;
+}
+
+enum err edhoc_initiator_session_step(struct edhoc_initiator_session *s,
+				      const struct byte_array *in,
+				      struct byte_array *out,
+				      enum edhoc_step_status *status)
+{
+	if ((NULL == s) || (NULL == out) || (NULL == status)) {
+		return wrong_parameter;
+	}
+	out->ptr = NULL;
+	out->len = 0;
+
+	if ((EDHOC_SESSION_START != s->state) && (EDHOC_SESSION_DONE != s->state) &&
+	    (EDHOC_SESSION_FAILED != s->state) && (NULL == in)) {
+		*status = EDHOC_STEP_NEED_MORE;
+		return ok;
+	}
+
+	enum err r = initiator_step(s, in, out, status);
+	if (ok != r) {
+		ephemeral_key_erase(&s->rc);
+		s->state = EDHOC_SESSION_FAILED;
+	}
+	return r;
+}
+
+void edhoc_responder_session_init(struct edhoc_responder_session *s,
+				  struct edhoc_responder_context *c,
+				  struct cred_array *cred_i_array)
+{
+	memset(s, 0, sizeof(*s));
+	s->c = c;
+	s->cred_i_array = cred_i_array;
+	s->state = EDHOC_SESSION_WAIT_MSG1;
+	runtime_context_init(&s->rc);
+	s->c_i.ptr = s->c_i_buf;
+	s->c_i.len = sizeof(s->c_i_buf);
+	s->prk_out.ptr = s->prk_out_buf;
+	s->prk_out.len = sizeof(s->prk_out_buf);
+	s->initiator_pk.ptr = s->initiator_pk_buf;
+	s->initiator_pk.len = sizeof(s->initiator_pk_buf);
+}
+
+static enum err responder_step(struct edhoc_responder_session *s,
+			       const struct byte_array *in,
+			       struct byte_array *out,
+			       enum edhoc_step_status *status)
+{
+	switch (s->state) {
+	case EDHOC_SESSION_WAIT_MSG1:
+		TRY(msg_receive(&s->rc, in));
+		enum err r = msg2_gen(s->c, &s->rc, &s->c_i);
+		if (error_message_sent == r) {
+			/*the error message with SUITES_R must be sent*/
+			*out = s->rc.msg;
+			*status = EDHOC_STEP_SEND;
+		}
+		TRY(r);
+		*out = s->rc.msg;
+		*status = EDHOC_STEP_SEND;
+		s->state = EDHOC_SESSION_WAIT_MSG3;
+		break;
+	case EDHOC_SESSION_WAIT_MSG3:
+		TRY(msg_receive(&s->rc, in));
+		TRY(msg3_process(s->c, &s->rc, s->cred_i_array, &s->prk_out,
+				 &s->initiator_pk));
+#ifdef MESSAGE_4
+		s->rc.msg.ptr = s->rc.msg_buf;
+		s->rc.msg.len = sizeof(s->rc.msg_buf);
+		TRY(msg4_gen(s->c, &s->rc));
+		*out = s->rc.msg;
+#endif
+		*status = EDHOC_STEP_DONE;
+		s->state = EDHOC_SESSION_DONE;
+		break;
+	default:
+		return edhoc_session_invalid_state;
+	}
+	return ok;
+}
+
+enum err edhoc_responder_session_step(struct edhoc_responder_session *s,
+				      const struct byte_array *in,
+				      struct byte_array *out,
+				      enum edhoc_step_status *status)
+{
+	if ((NULL == s) || (NULL == out) || (NULL == status)) {
+		return wrong_parameter;
+	}
+	out->ptr = NULL;
+	out->len = 0;
+
+	if ((EDHOC_SESSION_DONE != s->state) &&
+	    (EDHOC_SESSION_FAILED != s->state) && (NULL == in)) {
+		*status = EDHOC_STEP_NEED_MORE;
+		return ok;
+	}
+
+	enum err r = responder_step(s, in, out, status);
+	if (ok != r) {
+		ephemeral_key_erase(&s->rc);
+		s->state = EDHOC_SESSION_FAILED;
+	}
+	return r;
+}
@@ -32,7 +32,8 @@
  * @brief 			Forms a serialized data structure from a set of 
  * 				data items and computes a MAC over it.
  * 
- * @param[in] prk 		The key to be used for the mac.
+ * @param[in] prk 		The key to be used for the mac, prepared for
+ * 				EDHOC-KDF.
  * @param[in] c_r 		Connection identifier of the requester
  * @param[in] th 		Transcript hash.
  * @param[in] id_cred 		ID of the credential.
@@ -44,7 +45,7 @@
  * @param[out] mac 		The computed mac.
  * @return 			Ok or error code.
  */
-static enum err mac(const struct byte_array *prk, const struct byte_array *c_r,
+static enum err mac(const struct prk_handle *prk, const struct byte_array *c_r,
 		    const struct byte_array *th,
 		    const struct byte_array *id_cred,
 		    const struct byte_array *cred, const struct byte_array *ead,
@@ -55,32 +56,27 @@ static enum err mac(const struct byte_array *prk, const struct byte_array *c_r,
 	BYTE_ARRAY_NEW(th_enc, AS_BSTR_SIZE(HASH_SIZE), AS_BSTR_SIZE(th->len));
 	TRY(encode_bstr(th, &th_enc));
 
-	/**/
-	BYTE_ARRAY_NEW(context_mac, CONTEXT_MAC_SIZE,
-		       AS_BSTR_SIZE(c_r->len) + id_cred->len + cred->len +
-			       ead->len + th_enc.len);
-	uint32_t capacity = context_mac.len;
-	context_mac.len = 0;
+	BYTE_ARRAY_NEW(c_r_enc, AS_BSTR_SIZE(C_R_SIZE), AS_BSTR_SIZE(c_r->len));
 	if (c_r->len != 0) {
-		BYTE_ARRAY_NEW(c_r_enc, AS_BSTR_SIZE(C_R_SIZE),
-			       AS_BSTR_SIZE(c_r->len));
 		if (c_r_is_raw_int(c_r)) {
 			TRY(encode_int((const int32_t *)c_r->ptr, c_r->len,
 				       &c_r_enc));
 		} else {
 			TRY(encode_bstr(c_r, &c_r_enc));
 		}
-		TRY(byte_array_append(&context_mac, &c_r_enc, capacity));
-	}
-	TRY(byte_array_append(&context_mac, id_cred, capacity));
-	TRY(byte_array_append(&context_mac, &th_enc, capacity));
-	TRY(byte_array_append(&context_mac, cred, capacity));
-
-	if (0 < ead->len) {
-		TRY(byte_array_append(&context_mac, ead, capacity));
+	} else {
+		c_r_enc.len = 0;
 	}
 
-	PRINT_ARRAY("MAC context", context_mac.ptr, context_mac.len);
+	/*context_2/3 = << ? C_R, ID_CRED, TH, CRED, ? EAD >>. The pieces are
+	fed to the HMAC from their buffers, the credential is not copied*/
+	const struct byte_array context_mac[] = { c_r_enc, *id_cred, th_enc,
+						  *cred, *ead };
+	PRINT_ARRAY("MAC context: C_R", c_r_enc.ptr, c_r_enc.len);
+	PRINT_ARRAY("MAC context: ID_CRED", id_cred->ptr, id_cred->len);
+	PRINT_ARRAY("MAC context: TH", th_enc.ptr, th_enc.len);
+	PRINT_ARRAY("MAC context: CRED", cred->ptr, cred->len);
+	PRINT_ARRAY("MAC context: EAD", ead->ptr, ead->len);
 
 	if (static_dh) {
 		mac->len = suite->edhoc_mac_len_static_dh;
@@ -89,7 +85,9 @@ static enum err mac(const struct byte_array *prk, const struct byte_array *c_r,
 		mac->len = get_hash_len(suite->edhoc_hash);
 	}
 
-	TRY(edhoc_kdf(suite->edhoc_hash, prk, mac_label, &context_mac, mac));
+	TRY(edhoc_kdf_handle(prk, mac_label, context_mac,
+			     sizeof(context_mac) / sizeof(context_mac[0]),
+			     mac));
 
 	PRINT_ARRAY("MAC 2/3", mac->ptr, mac->len);
 	return ok;
@@ -137,10 +135,216 @@ static enum err signature_struct_gen(const struct byte_array *th,
 	return ok;
 }
 
+#ifndef EDHOC_MOCK_CRYPTO_WRAPPER
+/**
+ * @brief			Hashes the COSE Sig_structure 
+ *				[ "Signature1", << ID_CRED >>, 
+ *				<< TH, CRED, ? EAD >>, MAC ] 
+ *				for ES256. The structure is encoded piece by 
+ *				piece into the hash, so it is never built in a 
+ *				buffer and the credential is not copied.
+ * 
+ * @param[in] th 		Transcript hash.
+ * @param[in] id_cred 		Id of the credential.
+ * @param[in] cred 		The credential.
+ * @param[in] ead 		External Authorization Data. 
+ * @param[in] mac 		Message Authentication Code. 
+ * @param[out] out 		The SHA-256 hash of the Sig_structure.
+ * @return 			Ok or error code.
+ */
+static enum err signature_struct_hash(const struct byte_array *th,
+				      const struct byte_array *id_cred,
+				      const struct byte_array *cred,
+				      const struct byte_array *ead,
+				      const struct byte_array *mac,
+				      struct byte_array *out)
+{
+	/*the heads and the context string up to the content of ID_CRED*/
+	uint8_t prefix_buf[3 * CBOR_HEAD_MAX_SIZE + COSE_SIGN1_STR_LEN];
+	struct byte_array prefix = BYTE_ARRAY_INIT(prefix_buf, 0);
+	TRY(cbor_head_append(&prefix, sizeof(prefix_buf),
+			     CBOR_MAJOR_TYPE_ARRAY, 4));
+	TRY(cbor_head_append(&prefix, sizeof(prefix_buf),
+			     CBOR_MAJOR_TYPE_TSTR, COSE_SIGN1_STR_LEN));
+	memcpy(prefix.ptr + prefix.len, "Signature1", COSE_SIGN1_STR_LEN);
+	prefix.len += COSE_SIGN1_STR_LEN;
+	TRY(cbor_head_append(&prefix, sizeof(prefix_buf),
+			     CBOR_MAJOR_TYPE_BSTR, id_cred->len));
+
+	/*the heads of TH and of the external_aad << TH, CRED, ? EAD >>*/
+	uint8_t th_head_buf[CBOR_HEAD_MAX_SIZE];
+	struct byte_array th_head = BYTE_ARRAY_INIT(th_head_buf, 0);
+	TRY(cbor_head_append(&th_head, sizeof(th_head_buf),
+			     CBOR_MAJOR_TYPE_BSTR, th->len));
+	uint8_t aad_head_buf[CBOR_HEAD_MAX_SIZE];
+	struct byte_array aad_head = BYTE_ARRAY_INIT(aad_head_buf, 0);
+	TRY(cbor_head_append(&aad_head, sizeof(aad_head_buf),
+			     CBOR_MAJOR_TYPE_BSTR,
+			     th_head.len + th->len + cred->len + ead->len));
+
+	uint8_t mac_head_buf[CBOR_HEAD_MAX_SIZE];
+	struct byte_array mac_head = BYTE_ARRAY_INIT(mac_head_buf, 0);
+	TRY(cbor_head_append(&mac_head, sizeof(mac_head_buf),
+			     CBOR_MAJOR_TYPE_BSTR, mac->len));
+
+	struct hash_ctx ctx;
+	TRY(hash_init(SHA_256, &ctx));
+	enum err r = hash_update(&ctx, &prefix);
+	if (ok == r) {
+		r = hash_update(&ctx, id_cred);
+	}
+	if (ok == r) {
+		r = hash_update(&ctx, &aad_head);
+	}
+	if (ok == r) {
+		r = hash_update(&ctx, &th_head);
+	}
+	if (ok == r) {
+		r = hash_update(&ctx, th);
+	}
+	if (ok == r) {
+		r = hash_update(&ctx, cred);
+	}
+	if (ok == r) {
+		r = hash_update(&ctx, ead);
+	}
+	if (ok == r) {
+		r = hash_update(&ctx, &mac_head);
+	}
+	if (ok == r) {
+		r = hash_update(&ctx, mac);
+	}
+	if (ok == r) {
+		r = hash_final(&ctx, out);
+	}
+	if (ok != r) {
+		hash_abort(&ctx);
+		return r;
+	}
+	PRINT_ARRAY("Hash of the COSE_Sign1 object to be signed", out->ptr,
+		    out->len);
+	return ok;
+}
+#endif /* EDHOC_MOCK_CRYPTO_WRAPPER */
+
+/**
+ * @brief			Signs the Sig_structure of MAC_2/MAC_3. ES256 
+ *				signs the hash of the streamed structure with 
+ *				sign_hash(), EdDSA and providers that sign 
+ *				only whole messages need the whole structure 
+ *				in a buffer.
+ *				With EDHOC_MOCK_CRYPTO_WRAPPER the buffer is 
+ *				always built, since the predefined signatures 
+ *				are matched against it.
+ * 
+ * @param[in] suite 		The used crypto suite.
+ * @param[in] sk 		Secret key.
+ * @param[in] pk 		Public key.
+ * @param[in] th 		Transcript hash.
+ * @param[in] id_cred 		Id of the credential.
+ * @param[in] cred 		The credential.
+ * @param[in] ead 		External Authorization Data. 
+ * @param[in,out] signature_or_mac The MAC, replaced by the signature.
+ * @return 			Ok or error code.
+ */
+static enum err signature_gen(struct suite *suite, const struct byte_array *sk,
+			      const struct byte_array *pk,
+			      const struct byte_array *th,
+			      const struct byte_array *id_cred,
+			      const struct byte_array *cred,
+			      const struct byte_array *ead,
+			      struct byte_array *signature_or_mac)
+{
+#ifndef EDHOC_MOCK_CRYPTO_WRAPPER
+	if (ES256 == suite->edhoc_sign) {
+		BYTE_ARRAY_NEW(sign_hash_buf, HASH_SIZE, HASH_SIZE);
+		TRY(signature_struct_hash(th, id_cred, cred, ead,
+					  signature_or_mac, &sign_hash_buf));
+		enum err r = sign_hash(suite->edhoc_sign, sk, pk,
+				       &sign_hash_buf, signature_or_mac->ptr);
+		if (crypto_operation_not_implemented != r) {
+			signature_or_mac->len =
+				get_signature_len(suite->edhoc_sign);
+			return r;
+		}
+		/*the provider signs only whole messages*/
+	}
+#endif
+	PRINTF("SIG_STRUCT_SIZE: %d\n", SIG_STRUCT_SIZE);
+	uint32_t sig_struct_size = SIG_STRUCT_SIZE_CALC(
+		COSE_SIGN1_STR_LEN, id_cred->len,
+		(AS_BSTR_SIZE(th->len) + cred->len + ead->len),
+		signature_or_mac->len);
+
+	PRINTF("sig_struct_size: %d\n", sig_struct_size);
+	BYTE_ARRAY_NEW(sign_struct, SIG_STRUCT_SIZE, sig_struct_size);
+	TRY(signature_struct_gen(th, id_cred, cred, ead, signature_or_mac,
+				 &sign_struct));
+
+	signature_or_mac->len = get_signature_len(suite->edhoc_sign);
+
+	return sign(suite->edhoc_sign, sk, pk, &sign_struct,
+		    signature_or_mac->ptr);
+}
+
+/**
+ * @brief			Verifies the signature of the Sig_structure of
+ *				MAC_2/MAC_3, see signature_gen().
+ * 
+ * @param[in] suite 		The used crypto suite.
+ * @param[in] pk 		Public key.
+ * @param[in] th 		Transcript hash.
+ * @param[in] id_cred 		Id of the credential.
+ * @param[in] cred 		The credential.
+ * @param[in] ead 		External Authorization Data. 
+ * @param[in] mac 		The expected MAC.
+ * @param[in] signature 	The received signature.
+ * @param[out] result 		True if the signature is valid.
+ * @return 			Ok or error code.
+ */
+static enum err signature_verify(struct suite *suite,
+				 const struct byte_array *pk,
+				 const struct byte_array *th,
+				 const struct byte_array *id_cred,
+				 const struct byte_array *cred,
+				 const struct byte_array *ead,
+				 const struct byte_array *mac,
+				 struct byte_array *signature, bool *result)
+{
+	PRINT_ARRAY("pk", pk->ptr, pk->len);
+	PRINT_ARRAY("signature_or_mac", signature->ptr, signature->len);
+#ifndef EDHOC_MOCK_CRYPTO_WRAPPER
+	if (ES256 == suite->edhoc_sign) {
+		BYTE_ARRAY_NEW(sign_hash_buf, HASH_SIZE, HASH_SIZE);
+		TRY(signature_struct_hash(th, id_cred, cred, ead, mac,
+					  &sign_hash_buf));
+		enum err r = verify_hash(suite->edhoc_sign, pk, &sign_hash_buf,
+					 (struct const_byte_array *)signature,
+					 result);
+		if (crypto_operation_not_implemented != r) {
+			return r;
+		}
+	}
+#endif
+	PRINTF("SIG_STRUCT_SIZE: %d\n", SIG_STRUCT_SIZE);
+	uint32_t sig_struct_size = SIG_STRUCT_SIZE_CALC(
+		COSE_SIGN1_STR_LEN, id_cred->len,
+		(AS_BSTR_SIZE(th->len) + cred->len + ead->len), mac->len);
+
+	PRINTF("sig_struct_size: %d\n", sig_struct_size);
+	BYTE_ARRAY_NEW(sign_struct, SIG_STRUCT_SIZE, sig_struct_size);
+	TRY(signature_struct_gen(th, id_cred, cred, ead, mac, &sign_struct));
+	PRINT_ARRAY("signature_struct", sign_struct.ptr, sign_struct.len);
+
+	return verify(suite->edhoc_sign, pk,
+		      (struct const_byte_array *)&sign_struct,
+		      (struct const_byte_array *)signature, result);
+}
+
 enum err
 signature_or_mac(enum sgn_or_mac_op op, bool static_dh, struct suite *suite,
 		 const struct byte_array *sk, const struct byte_array *pk,
-		 const struct byte_array *prk, const struct byte_array *c_r,
+		 const struct prk_handle *prk, const struct byte_array *c_r,
 		 const struct byte_array *th, const struct byte_array *id_cred,
 		 const struct byte_array *cred, const struct byte_array *ead,
 		 enum info_label mac_label, struct byte_array *signature_or_mac)
@@ -154,24 +358,8 @@ signature_or_mac(enum sgn_or_mac_op op, bool static_dh, struct suite *suite,
 			/*signature_or_mac is mac when the caller of this function authenticates with static DH keys*/
 			return ok;
 		} else {
-			PRINTF("SIG_STRUCT_SIZE: %d\n", SIG_STRUCT_SIZE);
-			uint32_t sig_struct_size = SIG_STRUCT_SIZE_CALC(
-				COSE_SIGN1_STR_LEN, id_cred->len,
-				(AS_BSTR_SIZE(th->len) + cred->len + ead->len),
-				signature_or_mac->len);
-
-			PRINTF("sig_struct_size: %d\n", sig_struct_size);
-			BYTE_ARRAY_NEW(sign_struct, SIG_STRUCT_SIZE,
-				       sig_struct_size);
-			TRY(signature_struct_gen(th, id_cred, cred, ead,
-						 signature_or_mac,
-						 &sign_struct));
-
-			signature_or_mac->len =
-				get_signature_len(suite->edhoc_sign);
-
-			TRY(sign(suite->edhoc_sign, sk, pk, &sign_struct,
-				 signature_or_mac->ptr));
+			TRY(signature_gen(suite, sk, pk, th, id_cred, cred, ead,
+					  signature_or_mac));
 			PRINT_ARRAY("signature_or_mac (is signature)",
 				    signature_or_mac->ptr,
 				    signature_or_mac->len);
@@ -192,29 +380,9 @@ signature_or_mac(enum sgn_or_mac_op op, bool static_dh, struct suite *suite,
 			}
 
 		} else {
-			PRINTF("SIG_STRUCT_SIZE: %d\n", SIG_STRUCT_SIZE);
-			uint32_t sig_struct_size = SIG_STRUCT_SIZE_CALC(
-				COSE_SIGN1_STR_LEN, id_cred->len,
-				(AS_BSTR_SIZE(th->len) + cred->len + ead->len),
-				_mac.len);
-
-			PRINTF("sig_struct_size: %d\n", sig_struct_size);
-			BYTE_ARRAY_NEW(sign_struct, SIG_STRUCT_SIZE,
-				       sig_struct_size);
-			TRY(signature_struct_gen(th, id_cred, cred, ead, &_mac,
-						 &sign_struct));
-
 			bool result;
-			PRINT_ARRAY("pk", pk->ptr, pk->len);
-			PRINT_ARRAY("signature_struct", sign_struct.ptr,
-				    sign_struct.len);
-			PRINT_ARRAY("signature_or_mac", signature_or_mac->ptr,
-				    signature_or_mac->len);
-
-			TRY(verify(suite->edhoc_sign, pk,
-				   (struct const_byte_array *)&sign_struct,
-				   (struct const_byte_array *)signature_or_mac,
-				   &result));
+			TRY(signature_verify(suite, pk, th, id_cred, cred, ead,
+					     &_mac, signature_or_mac, &result));
 			if (!result) {
 				return signature_authentication_failed;
 			}
@@ -0,0 +1,91 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "edhoc/suite_cache.h"
+
+#include "common/byte_array.h"
+#include "common/crypto_wrapper.h"
+
+/**
+ * @brief	Computes the digest of the identifier of a responder.
+ */
+static bool peer_digest(const struct byte_array *peer_id,
+			uint8_t digest[HASH_SIZE])
+{
+	struct byte_array d = BYTE_ARRAY_INIT(digest, HASH_SIZE);
+	return ok == hash(SHA_256, peer_id, &d);
+}
+
+static bool entry_match(const void *entry, const void *key)
+{
+	const struct suite_cache_entry *e = entry;
+	return 0 == memcmp(e->peer, key, sizeof(e->peer));
+}
+
+void suite_cache_init(struct suite_cache *cache,
+		      struct suite_cache_entry *entries, uint32_t entries_len,
+		      uint32_t ttl)
+{
+	ttl_cache_init(&cache->base, entries, sizeof(*entries), entries_len,
+		       ttl);
+}
+
+void suite_cache_register(struct suite_cache *cache)
+{
+	ttl_cache_register(TTL_CACHE_SUITE,
+			   (NULL == cache) ? NULL : &cache->base);
+}
+
+void suite_cache_invalidate(struct suite_cache *cache)
+{
+	ttl_cache_clear(&cache->base);
+}
+
+bool suite_cache_get(const struct byte_array *peer_id, uint8_t *suite)
+{
+	struct ttl_cache *cache = ttl_cache_registered(TTL_CACHE_SUITE);
+	uint8_t digest[HASH_SIZE];
+	if ((NULL == cache) || !peer_digest(peer_id, digest)) {
+		return false;
+	}
+
+	uint32_t now = ttl_cache_now(cache);
+	ttl_cache_lock(cache);
+	const struct suite_cache_entry *e =
+		ttl_cache_find(cache, entry_match, digest, now);
+	if (NULL != e) {
+		*suite = e->suite;
+	}
+	ttl_cache_unlock(cache);
+	return NULL != e;
+}
+
+void suite_cache_put(const struct byte_array *peer_id, uint8_t suite)
+{
+	struct ttl_cache *cache = ttl_cache_registered(TTL_CACHE_SUITE);
+	uint8_t digest[HASH_SIZE];
+	if ((NULL == cache) || !peer_digest(peer_id, digest)) {
+		return;
+	}
+
+	uint32_t now = ttl_cache_now(cache);
+	ttl_cache_lock(cache);
+	struct suite_cache_entry *e =
+		ttl_cache_put(cache, entry_match, digest, now);
+	if (NULL != e) {
+		memcpy(e->peer, digest, sizeof(e->peer));
+		e->suite = suite;
+	}
+	ttl_cache_unlock(cache);
+}
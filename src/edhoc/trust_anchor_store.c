@@ -0,0 +1,173 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "edhoc.h"
+#include "edhoc/buffer_sizes.h"
+#include "edhoc/trust_anchor_store.h"
+
+#include "common/byte_array.h"
+#include "common/crypto_wrapper.h"
+#include "common/oscore_edhoc_error.h"
+#include "common/print_util.h"
+
+#define ED25519_PK_SIZE 32
+
+#ifdef MBEDTLS
+#define MBEDTLS_ALLOW_PRIVATE_ACCESS
+
+#include <mbedtls/oid.h>
+#include <mbedtls/x509.h>
+#include <mbedtls/x509_crt.h>
+
+/**
+ * @brief	Finds the common name of the subject of a CA certificate.
+ *
+ * @param[in] ca The DER encoded CA certificate.
+ * @param[out] a The CA whose name is set.
+ * @return	ok or error code.
+ */
+static enum err subject_cn_get(const struct byte_array *ca,
+			       struct trust_anchor *a)
+{
+	mbedtls_x509_crt m_cert;
+	mbedtls_x509_crt_init(&m_cert);
+
+	/* the name points into the certificate, therefore parse without copy */
+	if (0 != mbedtls_x509_crt_parse_der_nocopy(&m_cert, ca->ptr, ca->len)) {
+		mbedtls_x509_crt_free(&m_cert);
+		return certificate_authentication_failed;
+	}
+
+	const mbedtls_x509_name *p = &m_cert.subject;
+	while (p) {
+		if (0 == MBEDTLS_OID_CMP(MBEDTLS_OID_AT_CN, &p->oid)) {
+			a->name = p->val.p;
+			a->name_len = (uint32_t)p->val.len;
+		}
+		p = p->next;
+	}
+
+	mbedtls_x509_crt_free(&m_cert);
+	return ok;
+}
+#endif /* MBEDTLS */
+
+/**
+ * @brief	Orders names first by length and then bytewise.
+ */
+static int name_cmp(const uint8_t *a, uint32_t a_len, const uint8_t *b,
+		    uint32_t b_len)
+{
+	if (a_len != b_len) {
+		return (a_len < b_len) ? -1 : 1;
+	}
+	return (0 == a_len) ? 0 : memcmp(a, b, a_len);
+}
+
+void trust_anchor_store_free(struct trust_anchor_store *store)
+{
+	for (uint32_t i = 0; i < store->len; i++) {
+		pk_release(&store->anchors[i].pk);
+	}
+	store->len = 0;
+}
+
+enum err trust_anchor_store_build(struct trust_anchor_store *store,
+				  struct cred_array *creds,
+				  struct trust_anchor *anchors,
+				  uint32_t anchors_len)
+{
+	if ((NULL == store) || (NULL == creds) || (NULL == anchors)) {
+		return wrong_parameter;
+	}
+
+	store->anchors = anchors;
+	store->len = 0;
+
+	for (uint32_t i = 0; i < creds->len; i++) {
+		const struct other_party_cred *c = &creds->ptr[i];
+		if ((NULL == c->ca_pk.ptr) || (0 == c->ca_pk.len)) {
+			continue;
+		}
+		if (store->len == anchors_len) {
+			trust_anchor_store_free(store);
+			return trust_anchor_store_too_small;
+		}
+
+		struct trust_anchor a = { .name = NULL, .name_len = 0 };
+#ifdef MBEDTLS
+		if ((NULL != c->ca.ptr) && (0 != c->ca.len)) {
+			enum err r = subject_cn_get(&c->ca, &a);
+			if (ok != r) {
+				trust_anchor_store_free(store);
+				return r;
+			}
+		}
+#endif
+		/*the type of the key follows from its length*/
+		enum sign_alg alg = (ED25519_PK_SIZE == c->ca_pk.len) ? EdDSA :
+									ES256;
+		enum err r = pk_prepare(alg, &c->ca_pk, &a.pk);
+		if (ok != r) {
+			trust_anchor_store_free(store);
+			return r;
+		}
+
+		/*insert sorted by the name*/
+		uint32_t j = store->len;
+		while ((j > 0) && (name_cmp(anchors[j - 1].name,
+					    anchors[j - 1].name_len, a.name,
+					    a.name_len) > 0)) {
+			anchors[j] = anchors[j - 1];
+			j--;
+		}
+		anchors[j] = a;
+		store->len++;
+	}
+
+	creds->anchors = store;
+	return ok;
+}
+
+const struct trust_anchor *
+trust_anchor_find(const struct trust_anchor_store *store,
+		  const uint8_t *issuer, uint32_t issuer_len)
+{
+	if (NULL != issuer) {
+		uint32_t lo = 0;
+		uint32_t hi = store->len;
+		while (lo < hi) {
+			uint32_t mid = lo + (hi - lo) / 2;
+			const struct trust_anchor *a = &store->anchors[mid];
+			int c = name_cmp(a->name, a->name_len, issuer,
+					 issuer_len);
+			if (0 == c) {
+				PRINT_ARRAY("Root PK of the CA", a->pk.pk,
+					    a->pk.pk_len);
+				return a;
+			}
+			if (c < 0) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+	}
+
+	/*a single CA without name is used for any issuer*/
+	if ((1 == store->len) && (0 == store->anchors[0].name_len)) {
+		return &store->anchors[0];
+	}
+	return NULL;
+}
@@ -0,0 +1,134 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "edhoc/ttl_cache.h"
+
+#include "common/crypto_wrapper.h"
+
+static struct ttl_cache *registered_caches[TTL_CACHE_USERS];
+
+static struct ttl_cache_slot *slot_get(const struct ttl_cache *cache,
+				       uint32_t i)
+{
+	return (struct ttl_cache_slot *)((uint8_t *)cache->entries +
+					 (size_t)i * cache->entry_size);
+}
+
+static bool slot_expired(const struct ttl_cache *cache,
+			 const struct ttl_cache_slot *s, uint32_t now)
+{
+	/*the difference is evaluated signed to allow wrap around of the time*/
+	return (NULL != cache->now) && ((int32_t)(now - s->expiry) >= 0);
+}
+
+void ttl_cache_init(struct ttl_cache *cache, void *entries,
+		    uint32_t entry_size, uint32_t entries_len, uint32_t ttl)
+{
+	memset(cache, 0, sizeof(*cache));
+	cache->entries = entries;
+	cache->entry_size = entry_size;
+	cache->entries_len = entries_len;
+	cache->ttl = ttl;
+	ttl_cache_clear(cache);
+}
+
+void ttl_cache_register(enum ttl_cache_user user, struct ttl_cache *cache)
+{
+	registered_caches[user] = cache;
+}
+
+struct ttl_cache *ttl_cache_registered(enum ttl_cache_user user)
+{
+	return registered_caches[user];
+}
+
+void ttl_cache_lock(struct ttl_cache *cache)
+{
+	if (NULL != cache->lock) {
+		cache->lock(cache->lock_ctx);
+	}
+}
+
+void ttl_cache_unlock(struct ttl_cache *cache)
+{
+	if (NULL != cache->unlock) {
+		cache->unlock(cache->lock_ctx);
+	}
+}
+
+uint32_t ttl_cache_now(const struct ttl_cache *cache)
+{
+	return (NULL == cache->now) ? 0 : cache->now();
+}
+
+void *ttl_cache_find(struct ttl_cache *cache,
+		     bool (*match)(const void *entry, const void *key),
+		     const void *key, uint32_t now)
+{
+	for (uint32_t i = 0; i < cache->entries_len; i++) {
+		struct ttl_cache_slot *s = slot_get(cache, i);
+		if (!s->valid || !match(s, key)) {
+			continue;
+		}
+		if (slot_expired(cache, s, now)) {
+			ttl_cache_erase(cache, s);
+			return NULL;
+		}
+		return s;
+	}
+	return NULL;
+}
+
+void *ttl_cache_put(struct ttl_cache *cache,
+		    bool (*match)(const void *entry, const void *key),
+		    const void *key, uint32_t now)
+{
+	if (0 == cache->entries_len) {
+		return NULL;
+	}
+
+	struct ttl_cache_slot *s = ttl_cache_find(cache, match, key, now);
+	for (uint32_t i = 0; (NULL == s) && (i < cache->entries_len); i++) {
+		struct ttl_cache_slot *c = slot_get(cache, i);
+		if (!c->valid || slot_expired(cache, c, now)) {
+			s = c;
+		}
+	}
+	if (NULL == s) {
+		s = slot_get(cache, cache->next);
+		cache->next = (cache->next + 1) % cache->entries_len;
+	}
+
+	ttl_cache_erase(cache, s);
+	s->expiry = now + cache->ttl;
+	s->valid = true;
+	return s;
+}
+
+void ttl_cache_erase(const struct ttl_cache *cache, void *entry)
+{
+	struct ttl_cache_slot *s = entry;
+	secure_erase((uint8_t *)entry, cache->entry_size);
+	s->valid = false;
+}
+
+void ttl_cache_clear(struct ttl_cache *cache)
+{
+	ttl_cache_lock(cache);
+	for (uint32_t i = 0; i < cache->entries_len; i++) {
+		ttl_cache_erase(cache, slot_get(cache, i));
+	}
+	cache->next = 0;
+	ttl_cache_unlock(cache);
+}
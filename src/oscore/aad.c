@@ -19,6 +19,7 @@
 #include "common/memcpy_s.h"
 
 #include "cbor/oscore_aad_array.h"
+#include "cbor/oscore_group_aad_array.h"
 
 enum err create_aad(struct o_coap_option *options, uint16_t opt_num,
 		    enum AEAD_algorithm aead_alg, struct byte_array *kid,
@@ -55,3 +56,43 @@ enum err create_aad(struct o_coap_option *options, uint16_t opt_num,
 	PRINT_ARRAY("AAD", out->ptr, out->len);
 	return ok;
 }
+
+enum err create_group_aad(struct group_context *c,
+			  struct byte_array *request_kid,
+			  struct byte_array *request_piv,
+			  struct byte_array *sender_cred, struct byte_array *out)
+{
+	struct group_aad_array aad_array;
+
+	aad_array.group_aad_array_oscore_version = 1;
+	aad_array.group_aad_array_algorithms_alg_group_enc =
+		(int32_t)c->cc.aead_alg;
+	aad_array.group_aad_array_algorithms_alg_sign = (int32_t)c->sign_alg;
+	aad_array.group_aad_array_algorithms_alg_pairwise_key_agreement =
+		(int32_t)c->ecdh_alg;
+	aad_array.group_aad_array_request_kid_context.value =
+		c->cc.id_context.ptr;
+	aad_array.group_aad_array_request_kid_context.len =
+		c->cc.id_context.len;
+	aad_array.group_aad_array_request_kid.value = request_kid->ptr;
+	aad_array.group_aad_array_request_kid.len = request_kid->len;
+	aad_array.group_aad_array_request_piv.value = request_piv->ptr;
+	aad_array.group_aad_array_request_piv.len = request_piv->len;
+	aad_array.group_aad_array_sender_cred.value = sender_cred->ptr;
+	aad_array.group_aad_array_sender_cred.len = sender_cred->len;
+	aad_array.group_aad_array_gm_cred.value = c->gm_cred.ptr;
+	aad_array.group_aad_array_gm_cred.len = c->gm_cred.len;
+
+	/* no I options are defined, see create_aad() */
+	aad_array.group_aad_array_options.len = 0;
+	aad_array.group_aad_array_options.value = NULL;
+
+	size_t payload_len_out;
+	TRY_EXPECT(cbor_encode_group_aad_array(out->ptr, out->len, &aad_array,
+					       &payload_len_out),
+		   0);
+
+	out->len = (uint32_t)payload_len_out;
+	PRINT_ARRAY("Group AAD", out->ptr, out->len);
+	return ok;
+}
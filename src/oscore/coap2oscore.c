@@ -22,12 +22,12 @@
 #include "oscore/oscore_cose.h"
 #include "oscore/security_context.h"
 #include "oscore/nvm.h"
+#include "oscore/oscore_internal.h"
 
 #include "common/byte_array.h"
 #include "common/oscore_edhoc_error.h"
 #include "common/memcpy_s.h"
 #include "common/print_util.h"
-#include "common/unit_test.h"
 
 /**
  * @brief Extract input CoAP options into E(encrypted) and U(unprotected)
@@ -40,12 +40,12 @@
  * @return err
  *
  */
-STATIC enum err inner_outer_option_split(struct o_coap_packet *in_o_coap,
-					 struct o_coap_option *e_options,
-					 uint8_t *e_options_cnt,
-					 uint16_t *e_options_len,
-					 struct o_coap_option *U_options,
-					 uint8_t *U_options_cnt)
+enum err inner_outer_option_split(struct o_coap_packet *in_o_coap,
+				  struct o_coap_option *e_options,
+				  uint8_t *e_options_cnt,
+				  uint16_t *e_options_len,
+				  struct o_coap_option *U_options,
+				  uint8_t *U_options_cnt)
 {
 	enum err r = ok;
 
@@ -198,10 +198,9 @@ STATIC enum err inner_outer_option_split(struct o_coap_packet *in_o_coap,
  * @return err
  *
  */
-static inline enum err plaintext_setup(struct o_coap_packet *in_o_coap,
-				       struct o_coap_option *E_options,
-				       uint8_t E_options_cnt,
-				       struct byte_array *plaintext)
+enum err plaintext_setup(struct o_coap_packet *in_o_coap,
+			 struct o_coap_option *E_options, uint8_t E_options_cnt,
+			 struct byte_array *plaintext)
 {
 	uint8_t *temp_plaintext_ptr = plaintext->ptr;
 
@@ -276,10 +275,9 @@ static inline uint32_t get_oscore_opt_val_len(uint32_t piv_len,
  * @param   oscore_option: output pointer OSCORE option structure
  * @return  err
  */
-STATIC enum err oscore_option_generate(struct byte_array *piv,
-				       struct byte_array *kid,
-				       struct byte_array *kid_context,
-				       struct oscore_option *oscore_option)
+enum err oscore_option_generate(struct byte_array *piv, struct byte_array *kid,
+				struct byte_array *kid_context,
+				struct oscore_option *oscore_option)
 {
 	uint32_t piv_len = (NULL == piv) ? 0 : piv->len;
 	uint32_t kid_len = (NULL == kid) ? 0 : kid->len;
@@ -361,12 +359,12 @@ STATIC enum err oscore_option_generate(struct byte_array *piv,
  * @return err
  *
  */
-STATIC enum err oscore_pkg_generate(struct o_coap_packet *in_o_coap,
-				    struct o_coap_packet *out_oscore,
-				    struct o_coap_option *u_options,
-				    uint8_t u_options_cnt,
-				    struct byte_array *in_ciphertext,
-				    struct oscore_option *oscore_option)
+enum err oscore_pkg_generate(struct o_coap_packet *in_o_coap,
+			     struct o_coap_packet *out_oscore,
+			     struct o_coap_option *u_options,
+			     uint8_t u_options_cnt,
+			     struct byte_array *in_ciphertext,
+			     struct oscore_option *oscore_option)
 {
 	/* Set OSCORE header and Token*/
 	out_oscore->header.ver = in_o_coap->header.ver;
@@ -491,51 +489,64 @@ static bool needs_new_piv(enum o_coap_msg msg_type, enum echo_state echo_state)
 	return ((COAP_MSG_RESPONSE != msg_type) || (ECHO_VERIFY == echo_state));
 }
 
+/* The values of an encryption that are used after the AEAD, see 
+ * encrypt_prepare() and encrypt_finish() */
+struct encrypt_state {
+	enum o_coap_msg msg_type;
+	bool use_new_piv;
+	struct byte_array token;
+	struct byte_array nonce;
+	struct byte_array request_piv;
+	struct byte_array request_kid;
+	struct byte_array aad;
+	uint8_t new_piv_buf[MAX_PIV_LEN];
+	uint8_t new_nonce_buf[NONCE_LEN];
+	uint8_t aad_buf[MAX_AAD_LEN];
+};
+
 /**
- * @brief Wrapper function with common operations for encrypting the payload.
- *        These operations are shared in all possible scenarios.
- *        For more info, see RFC8616 8.1 and 8.3.
+ * @brief Selects the nonce, generates the OSCORE option and creates the AAD 
+ *        of an encryption. For more info, see RFC8616 8.1 and 8.3.
  *
- * @param plaintext Input plaintext to be encrypted.
- * @param ciphertext Output encrypted payload for the OSCORE packet.
  * @param c Security context.
  * @param input_coap Input coap packet.
  * @param oscore_option Output OSCORE option.
+ * @param st Output values used for the encryption and by encrypt_finish().
  * @return enum err
  */
-static enum err encrypt_wrapper(struct byte_array *plaintext,
-				struct byte_array *ciphertext,
-				struct context *c,
+static enum err encrypt_prepare(struct context *c,
 				struct o_coap_packet *input_coap,
-				struct oscore_option *oscore_option)
+				struct oscore_option *oscore_option,
+				struct encrypt_state *st)
 {
-	BYTE_ARRAY_NEW(new_piv, MAX_PIV_LEN, MAX_PIV_LEN);
-	BYTE_ARRAY_NEW(new_nonce, NONCE_LEN, NONCE_LEN);
+	struct byte_array new_piv =
+		BYTE_ARRAY_INIT(st->new_piv_buf, sizeof(st->new_piv_buf));
+	struct byte_array new_nonce =
+		BYTE_ARRAY_INIT(st->new_nonce_buf, sizeof(st->new_nonce_buf));
 	struct byte_array piv = BYTE_ARRAY_INIT(NULL, 0);
 	struct byte_array kid = BYTE_ARRAY_INIT(NULL, 0);
 	struct byte_array kid_context = BYTE_ARRAY_INIT(NULL, 0);
-	struct byte_array nonce;
 
 	/* Read necessary fields from the input packet. */
-	enum o_coap_msg msg_type;
-	TRY(coap_get_message_type(input_coap, &msg_type));
-	struct byte_array token =
-		BYTE_ARRAY_INIT(input_coap->token, input_coap->header.TKL);
+	TRY(coap_get_message_type(input_coap, &st->msg_type));
+	st->token.ptr = input_coap->token;
+	st->token.len = input_coap->header.TKL;
 
 	/* Generate new PIV/nonce if needed. */
-	bool use_new_piv = needs_new_piv(msg_type, c->rrc.echo_state_machine);
-	if (use_new_piv) {
+	st->use_new_piv =
+		needs_new_piv(st->msg_type, c->rrc.echo_state_machine);
+	if (st->use_new_piv) {
 		TRY(ssn2piv(c->sc.ssn, &new_piv));
 		TRY(generate_new_ssn(c));
 		TRY(create_nonce(&c->sc.sender_id, &new_piv, &c->cc.common_iv,
 				 &new_nonce));
 
-		nonce = new_nonce;
+		st->nonce = new_nonce;
 		piv = new_piv;
 		kid = c->sc.sender_id;
 		kid_context = c->cc.id_context;
 	} else {
-		nonce = c->rrc.nonce;
+		st->nonce = c->rrc.nonce;
 	}
 
 	/* Generate OSCORE option based on selected values. */
@@ -544,22 +555,51 @@ static enum err encrypt_wrapper(struct byte_array *plaintext,
 	/* AAD shares the same format for both requests and responses,
 	   yet request_kid and request_piv fields are only used by responses.
 	   For more details, see 5.4. */
-	BYTE_ARRAY_NEW(aad, MAX_AAD_LEN, MAX_AAD_LEN);
-	struct byte_array request_piv = piv;
-	struct byte_array request_kid = kid;
-	TRY(oscore_interactions_read_wrapper(msg_type, &token,
-					     c->rrc.interactions, &request_piv,
-					     &request_kid));
-	TRY(create_aad(NULL, 0, c->cc.aead_alg, &request_kid, &request_piv,
-		       &aad));
-
-	/* Encrypt the plaintext */
-	TRY(oscore_cose_encrypt(plaintext, ciphertext, &nonce, &aad,
-				&c->sc.sender_key));
+	st->aad.ptr = st->aad_buf;
+	st->aad.len = sizeof(st->aad_buf);
+	st->request_piv = piv;
+	st->request_kid = kid;
+	if (COAP_MSG_NOTIFICATION == st->msg_type) {
+		/* Fast path for notifications: the AAD is the same for all 
+		   notifications of an observation and, with
+		   OSCORE_OBSERVE_AAD_CACHE, is cached in its record. */
+		struct oscore_interaction_t *observation;
+		TRY(oscore_interactions_get_record(c->rrc.interactions,
+						   st->token.ptr,
+						   (uint8_t)st->token.len,
+						   &observation));
+		TRY(oscore_interactions_get_aad(observation, c->cc.aead_alg,
+						&st->aad));
+	} else {
+		TRY(oscore_interactions_read_wrapper(
+			st->msg_type, &st->token, c->rrc.interactions,
+			&st->request_piv, &st->request_kid));
+		TRY(create_aad(NULL, 0, c->cc.aead_alg, &st->request_kid,
+			       &st->request_piv, &st->aad));
+	}
+	return ok;
+}
 
+/**
+ * @brief Updates the context after a successful encryption.
+ *
+ * @param c Security context.
+ * @param input_coap Input coap packet.
+ * @param st The values of encrypt_prepare().
+ * @return enum err
+ */
+static enum err encrypt_finish(struct context *c,
+			       struct o_coap_packet *input_coap,
+			       struct encrypt_state *st)
+{
 	/* Update nonce only after successful encryption (for handling future responses). */
-	if (use_new_piv) {
-		TRY(byte_array_cpy(&c->rrc.nonce, &nonce, NONCE_LEN));
+	if (st->use_new_piv) {
+		TRY(byte_array_cpy(&c->rrc.nonce, &st->nonce, NONCE_LEN));
+	}
+
+	/* A notification leaves the interactions unchanged. */
+	if (COAP_MSG_NOTIFICATION == st->msg_type) {
+		return ok;
 	}
 
 	/* Handle OSCORE interactions after successful encryption. */
@@ -567,13 +607,67 @@ static enum err encrypt_wrapper(struct byte_array *plaintext,
 		       OSCORE_MAX_URI_PATH_LEN);
 	TRY(uri_path_create(input_coap->options, input_coap->options_cnt,
 			    uri_paths.ptr, &(uri_paths.len)));
-	TRY(oscore_interactions_update_wrapper(msg_type, &token, &uri_paths,
-					       c->rrc.interactions,
-					       &request_piv, &request_kid));
+	TRY(oscore_interactions_update_wrapper(
+		st->msg_type, &st->token, &uri_paths, c->rrc.interactions,
+		&st->request_piv, &st->request_kid));
 
 	return ok;
 }
 
+/**
+ * @brief Wrapper function with common operations for encrypting the payload.
+ *        These operations are shared in all possible scenarios.
+ *        For more info, see RFC8616 8.1 and 8.3.
+ *
+ * @param plaintext Input plaintext to be encrypted.
+ * @param ciphertext Output encrypted payload for the OSCORE packet.
+ * @param c Security context.
+ * @param input_coap Input coap packet.
+ * @param oscore_option Output OSCORE option.
+ * @return enum err
+ */
+static enum err encrypt_wrapper(struct byte_array *plaintext,
+				struct byte_array *ciphertext,
+				struct context *c,
+				struct o_coap_packet *input_coap,
+				struct oscore_option *oscore_option)
+{
+	struct encrypt_state st;
+	TRY(encrypt_prepare(c, input_coap, oscore_option, &st));
+
+	/* Encrypt the plaintext */
+	TRY(oscore_cose_encrypt(plaintext, ciphertext, &st.nonce, &st.aad,
+				&c->sc.sender_key));
+
+	return encrypt_finish(c, input_coap, &st);
+}
+
+enum err oscore_packet_protect(struct o_coap_packet *o_coap_pkt,
+			       struct o_coap_option *e_options,
+			       uint8_t e_options_cnt,
+			       struct o_coap_option *u_options,
+			       uint8_t u_options_cnt,
+			       struct byte_array *plaintext,
+			       struct byte_array *ciphertext,
+			       struct oscore_option *oscore_option,
+			       struct o_coap_packet *oscore_pkt,
+			       struct context *c)
+{
+	if (ECHO_VERIFY == c->rrc.echo_state_machine) {
+		/* A server prepares a response with ECHO challenge after the reboot. */
+		TRY(cache_echo_val(&c->rrc.echo_opt_val, e_options,
+				   e_options_cnt));
+	}
+
+	/* Encrypt data using either a freshly generated nonce (if needed), or the one cached from the corresponding request. */
+	TRY(encrypt_wrapper(plaintext, ciphertext, c, o_coap_pkt,
+			    oscore_option));
+
+	/*create an OSCORE packet*/
+	return oscore_pkg_generate(o_coap_pkt, oscore_pkt, u_options,
+				   u_options_cnt, ciphertext, oscore_option);
+}
+
 /**
  *@brief 	Converts a CoAP packet to OSCORE packet
  *@note		For messaging layer packets (simple ACK with no payload, code 0.00),
@@ -648,22 +742,222 @@ enum err coap2oscore(uint8_t *buf_o_coap, uint32_t buf_o_coap_len,
 	BYTE_ARRAY_NEW(ciphertext, MAX_CIPHERTEXT_LEN,
 		       plaintext.len + AUTH_TAG_LEN);
 
+	/*create an OSCORE packet*/
+	struct oscore_option oscore_option;
+	struct o_coap_packet oscore_pkt;
+	TRY(oscore_packet_protect(&o_coap_pkt, e_options, e_options_cnt,
+				  u_options, u_options_cnt, &plaintext,
+				  &ciphertext, &oscore_option, &oscore_pkt, c));
+
+	/*convert the oscore pkg to byte string*/
+	return coap_serialize(&oscore_pkt, buf_oscore, buf_oscore_len);
+}
+
+/* A message of coap2oscore_batch() from its preparation to the update of 
+ * its context */
+struct protect_slot {
+	struct encrypt_state enc;
+	struct byte_array plaintext;
+	/*the payload in the output buffer*/
+	struct byte_array ciphertext;
+	/*the payload still has to be encrypted*/
+	bool encrypt;
+	/*the plaintext did not fit into the staging buffer, the message is 
+	protected with the next group*/
+	bool deferred;
+	/*the plaintext followed by space for the tag, in the staging buffer*/
+	uint8_t *plaintext_buf;
+};
+
+/**
+ *@brief 	Does the steps of coap2oscore() before the encryption. The 
+ *		OSCORE packet is already serialized, with the plaintext in 
+ *		place of the ciphertext. The ciphertext is written over it 
+ *		afterwards. If the plaintext does not fit into the rest of 
+ *		the staging buffer, the message is deferred before the 
+ *		context is changed.
+ *
+ *@param	job the message
+ *@param	slot the state of the message
+ *@param	stage the unused part of the staging buffer, the plaintext 
+ *		is removed from it
+ *@return	err
+ */
+static enum err protect_prepare(struct coap2oscore_job *job,
+				struct protect_slot *slot,
+				struct byte_array *stage)
+{
+	struct context *c = job->c;
+	struct byte_array buf =
+		BYTE_ARRAY_INIT(job->buf_o_coap, job->buf_o_coap_len);
+	struct o_coap_packet o_coap_pkt;
+	slot->encrypt = false;
+	slot->deferred = false;
+	slot->plaintext.len = 0;
+
+	TRY(check_context_freshness(c));
+	memset(&o_coap_pkt, 0, sizeof(o_coap_pkt));
+	TRY(coap_deserialize(&buf, &o_coap_pkt));
+
+	/* Messaging layer packets are copied, see coap2oscore() */
+	if ((TYPE_ACK == o_coap_pkt.header.type) &&
+	    (CODE_EMPTY == o_coap_pkt.header.code)) {
+		*job->buf_oscore_len = job->buf_o_coap_len;
+		return _memcpy_s(job->buf_oscore, job->buf_o_coap_len,
+				 job->buf_o_coap, job->buf_o_coap_len);
+	}
+
+	struct o_coap_option e_options[MAX_OPTION_COUNT];
+	uint8_t e_options_cnt = 0;
+	uint16_t e_options_len = 0;
+	struct o_coap_option u_options[MAX_OPTION_COUNT];
+	uint8_t u_options_cnt = 0;
+	TRY(inner_outer_option_split(&o_coap_pkt, e_options, &e_options_cnt,
+				     &e_options_len, u_options,
+				     &u_options_cnt));
+
+	uint32_t plaintext_len = (uint32_t)(1 + e_options_len);
+	if (o_coap_pkt.payload.len) {
+		plaintext_len += 1 + o_coap_pkt.payload.len;
+	}
+	TRY(check_buffer_size(MAX_PLAINTEXT_LEN, plaintext_len));
+	if (plaintext_len + AUTH_TAG_LEN > stage->len) {
+		slot->deferred = true;
+		return ok;
+	}
+	slot->plaintext_buf = stage->ptr;
+	stage->ptr += plaintext_len + AUTH_TAG_LEN;
+	stage->len -= plaintext_len + AUTH_TAG_LEN;
+	slot->plaintext.ptr = slot->plaintext_buf;
+	slot->plaintext.len = plaintext_len;
+	TRY(plaintext_setup(&o_coap_pkt, e_options, e_options_cnt,
+			    &slot->plaintext));
+	memset(&slot->plaintext_buf[plaintext_len], 0, AUTH_TAG_LEN);
+
 	if (ECHO_VERIFY == c->rrc.echo_state_machine) {
-		/* A server prepares a response with ECHO challenge after the reboot. */
 		TRY(cache_echo_val(&c->rrc.echo_opt_val, e_options,
 				   e_options_cnt));
 	}
 
-	/* Encrypt data using either a freshly generated nonce (if needed), or the one cached from the corresponding request. */
 	struct oscore_option oscore_option;
-	TRY(encrypt_wrapper(&plaintext, &ciphertext, c, &o_coap_pkt,
-			    &oscore_option));
+	TRY(encrypt_prepare(c, &o_coap_pkt, &oscore_option, &slot->enc));
 
-	/*create an OSCORE packet*/
+	/* The payload is the last part of the packet */
+	struct byte_array placeholder = BYTE_ARRAY_INIT(
+		slot->plaintext_buf, plaintext_len + AUTH_TAG_LEN);
 	struct o_coap_packet oscore_pkt;
 	TRY(oscore_pkg_generate(&o_coap_pkt, &oscore_pkt, u_options,
-				u_options_cnt, &ciphertext, &oscore_option));
+				u_options_cnt, &placeholder, &oscore_option));
+	TRY(coap_serialize(&oscore_pkt, job->buf_oscore, job->buf_oscore_len));
+	slot->ciphertext.ptr =
+		job->buf_oscore + *job->buf_oscore_len - placeholder.len;
+	slot->ciphertext.len = placeholder.len;
+	slot->encrypt = true;
+	return ok;
+}
 
-	/*convert the oscore pkg to byte string*/
-	return coap_serialize(&oscore_pkt, buf_oscore, buf_oscore_len);
+/**
+ *@brief 	Does the steps of coap2oscore() after the encryption. The 
+ *		input packet is parsed again, since keeping it for all 
+ *		messages of a batch would take more memory than parsing.
+ *
+ *@param	job the message
+ *@param	slot the state of the message
+ *@return	err
+ */
+static enum err protect_finish(struct coap2oscore_job *job,
+			       struct protect_slot *slot)
+{
+	struct byte_array buf =
+		BYTE_ARRAY_INIT(job->buf_o_coap, job->buf_o_coap_len);
+	struct o_coap_packet o_coap_pkt;
+	memset(&o_coap_pkt, 0, sizeof(o_coap_pkt));
+	TRY(coap_deserialize(&buf, &o_coap_pkt));
+	return encrypt_finish(job->c, &o_coap_pkt, &slot->enc);
+}
+
+/**
+ *@brief 	Returns the number of messages at the start of jobs that are 
+ *		protected together: at most OSCORE_PROTECT_BATCH and only one 
+ *		per context, since a message depends on the context updates of 
+ *		the previous one. The group ends earlier if the plaintexts do 
+ *		not fit into the staging buffer.
+ */
+static uint32_t batch_len(const struct coap2oscore_job *jobs, uint32_t n)
+{
+	uint32_t m = 1;
+	for (; (m < n) && (m < OSCORE_PROTECT_BATCH); m++) {
+		for (uint32_t k = 0; k < m; k++) {
+			if (jobs[k].c == jobs[m].c) {
+				return m;
+			}
+		}
+	}
+	return m;
+}
+
+enum err coap2oscore_batch(struct coap2oscore_job *jobs, uint32_t n)
+{
+	struct protect_slot slots[OSCORE_PROTECT_BATCH];
+	struct oscore_cose_encrypt_job enc[OSCORE_PROTECT_BATCH];
+	BYTE_ARRAY_NEW(plaintexts, OSCORE_PROTECT_BATCH_BUF_LEN,
+		       OSCORE_PROTECT_BATCH_BUF_LEN);
+
+	for (uint32_t i = 0; i < n;) {
+		uint32_t m = batch_len(&jobs[i], n - i);
+		uint32_t e = 0;
+		struct byte_array stage = plaintexts;
+		for (uint32_t k = 0; k < m; k++) {
+			struct coap2oscore_job *job = &jobs[i + k];
+			struct protect_slot *slot = &slots[k];
+			job->result = protect_prepare(job, slot, &stage);
+			if ((ok == job->result) && slot->deferred) {
+				if (0 == k) {
+					/*not even one plaintext fits*/
+					job->result = buffer_to_small;
+					continue;
+				}
+				m = k;
+				break;
+			}
+			if ((ok != job->result) || !slot->encrypt) {
+				continue;
+			}
+			enc[e].in_plaintext = &slot->plaintext;
+			enc[e].out_ciphertext = &slot->ciphertext;
+			enc[e].nonce = &slot->enc.nonce;
+			enc[e].sender_aad = &slot->enc.aad;
+			enc[e].key = &job->c->sc.sender_key;
+			e++;
+		}
+
+		/*the results are collected below*/
+		(void)oscore_cose_encrypt_multi(enc, e);
+
+		e = 0;
+		for (uint32_t k = 0; k < m; k++) {
+			struct coap2oscore_job *job = &jobs[i + k];
+			struct protect_slot *slot = &slots[k];
+			if ((ok != job->result) || !slot->encrypt) {
+				continue;
+			}
+			job->result = enc[e++].result;
+			if (ok == job->result) {
+				job->result = protect_finish(job, slot);
+			} else {
+				/*the output holds the plaintext*/
+				memset(job->buf_oscore, 0, *job->buf_oscore_len);
+				*job->buf_oscore_len = 0;
+			}
+		}
+		secure_erase(plaintexts.ptr, plaintexts.len - stage.len);
+		i += m;
+	}
+
+	for (uint32_t i = 0; i < n; i++) {
+		if (ok != jobs[i].result) {
+			return jobs[i].result;
+		}
+	}
+	return ok;
 }
@@ -0,0 +1,355 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <string.h>
+
+#include "oscore.h"
+
+#include "oscore/group_context.h"
+#include "oscore/oscore_hkdf_info.h"
+#include "oscore/oscore_interactions.h"
+#include "oscore/replay_protection.h"
+#include "oscore/security_context.h"
+
+#include "common/crypto_wrapper.h"
+#include "common/memcpy_s.h"
+#include "common/oscore_edhoc_error.h"
+#include "common/print_util.h"
+
+#define PAIRWISE_IKM_MAX_LEN                                                   \
+	(2 * OSCORE_GROUP_AUTH_CRED_MAX_LEN + OSCORE_GROUP_SHARED_SECRET_LEN)
+
+bool group_pairwise_mode_supported(struct group_context *c)
+{
+	/* The pairwise keys are derived from the signature key pairs of the
+	 * members, so the ECDH algorithm must use the same curve. */
+	return (ES256 == c->sign_alg) && (P256 == c->ecdh_alg);
+}
+
+/**
+ * @brief    Orders Recipient IDs by length and then by content
+ * @return   <0, 0 or >0 if a is before, equal to or after b
+ */
+static int recipient_id_cmp(const struct byte_array *a,
+			    const struct byte_array *b)
+{
+	if (a->len != b->len) {
+		return (a->len < b->len) ? -1 : 1;
+	}
+	if (0 == a->len) {
+		return 0;
+	}
+	return memcmp(a->ptr, b->ptr, a->len);
+}
+
+/**
+ * @brief    Searches the sorted member order for a Recipient ID
+ * @param    c the group context
+ * @param    recipient_id the Recipient ID
+ * @param    pos out: the position of the member in c->member_order or the
+ *           position at which it is to be inserted
+ * @retval   true if the member is present
+ */
+static bool member_search(const struct group_context *c,
+			  const struct byte_array *recipient_id, uint32_t *pos)
+{
+	uint32_t low = 0;
+	uint32_t high = c->member_cnt;
+	while (low < high) {
+		uint32_t mid = low + (high - low) / 2;
+		int cmp = recipient_id_cmp(
+			&c->members[c->member_order[mid]].rc.recipient_id,
+			recipient_id);
+		if (0 == cmp) {
+			*pos = mid;
+			return true;
+		}
+		if (cmp < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	*pos = low;
+	return false;
+}
+
+/**
+ * @brief    Points the byte arrays of a member to its own buffers, e.g.
+ *           after it has been copied
+ */
+static void member_arrays_set(struct group_recipient_context *m)
+{
+	m->rc.recipient_id.ptr = m->rc.recipient_id_buf;
+	m->rc.recipient_key.ptr = m->rc.recipient_key_buf;
+	m->auth_cred.ptr = m->auth_cred_buf;
+	m->pairwise_sender_key.ptr = m->pairwise_sender_key_buf;
+	m->pairwise_recipient_key.ptr = m->pairwise_recipient_key_buf;
+}
+
+enum err group_member_get(struct group_context *c,
+			  const struct byte_array *recipient_id,
+			  struct group_recipient_context **member)
+{
+	uint32_t pos;
+	if (!member_search(c, recipient_id, &pos)) {
+		return oscore_group_member_not_found;
+	}
+	*member = &c->members[c->member_order[pos]];
+	return ok;
+}
+
+/**
+ * @brief    Derives a pairwise key, see draft-ietf-core-oscore-groupcomm
+ *           section 2.4.1
+ * @param    c the group context
+ * @param    id the Sender ID of the owner of the key
+ * @param    key the group key of the owner of the key, used as salt
+ * @param    first_cred the authentication credential of the owner of the key
+ * @param    second_cred the authentication credential of the other member
+ * @param    shared_secret the static-static ECDH secret of the two members
+ * @param    out the pairwise key
+ * @return   err
+ */
+static enum err pairwise_key_derive(struct group_context *c,
+				    struct byte_array *id,
+				    struct byte_array *key,
+				    const struct byte_array *first_cred,
+				    const struct byte_array *second_cred,
+				    const struct byte_array *shared_secret,
+				    struct byte_array *out)
+{
+	/* IKM = credential of the owner | credential of the other member |
+	 * shared secret */
+	BYTE_ARRAY_NEW(ikm, PAIRWISE_IKM_MAX_LEN, PAIRWISE_IKM_MAX_LEN);
+	uint32_t ikm_capacity = ikm.len;
+	ikm.len = 0;
+	TRY(byte_array_append(&ikm, first_cred, ikm_capacity));
+	TRY(byte_array_append(&ikm, second_cred, ikm_capacity));
+	TRY(byte_array_append(&ikm, shared_secret, ikm_capacity));
+
+	BYTE_ARRAY_NEW(info, MAX_INFO_LEN, MAX_INFO_LEN);
+	TRY(oscore_create_hkdf_info(id, &c->cc.id_context, c->cc.aead_alg, KEY,
+				    &info));
+	TRY(hkdf_sha_256(&ikm, key, &info, out));
+	memset(ikm.ptr, 0, ikm_capacity);
+	return ok;
+}
+
+/**
+ * @brief    Derives the pairwise sender and recipient keys shared with a
+ *           member
+ * @param    c the group context
+ * @param    member the Recipient Context of the member
+ * @return   err
+ */
+static enum err pairwise_keys_derive(struct group_context *c,
+				     struct group_recipient_context *member)
+{
+	BYTE_ARRAY_NEW(shared_secret, OSCORE_GROUP_SHARED_SECRET_LEN,
+		       OSCORE_GROUP_SHARED_SECRET_LEN);
+	TRY(shared_secret_derive(c->ecdh_alg, &c->sender_sk, &member->auth_cred,
+				 shared_secret.ptr));
+
+	member->pairwise_sender_key.len =
+		sizeof(member->pairwise_sender_key_buf);
+	member->pairwise_sender_key.ptr = member->pairwise_sender_key_buf;
+	TRY(pairwise_key_derive(c, &c->sc.sender_id, &c->sc.sender_key,
+				&c->sender_auth_cred, &member->auth_cred,
+				&shared_secret, &member->pairwise_sender_key));
+
+	member->pairwise_recipient_key.len =
+		sizeof(member->pairwise_recipient_key_buf);
+	member->pairwise_recipient_key.ptr = member->pairwise_recipient_key_buf;
+	TRY(pairwise_key_derive(c, &member->rc.recipient_id,
+				&member->rc.recipient_key, &member->auth_cred,
+				&c->sender_auth_cred, &shared_secret,
+				&member->pairwise_recipient_key));
+
+	memset(shared_secret.ptr, 0, shared_secret.len);
+	PRINT_ARRAY("Pairwise Sender Key", member->pairwise_sender_key.ptr,
+		    member->pairwise_sender_key.len);
+	PRINT_ARRAY("Pairwise Recipient Key",
+		    member->pairwise_recipient_key.ptr,
+		    member->pairwise_recipient_key.len);
+	return ok;
+}
+
+enum err oscore_group_context_init(struct oscore_group_init_params *params,
+				   struct group_context *c)
+{
+	if ((NULL == params) || (NULL == c)) {
+		return wrong_parameter;
+	}
+
+	/*derive common context************************************************/
+
+	if (params->aead_alg != OSCORE_AES_CCM_16_64_128) {
+		return oscore_invalid_algorithm_aead;
+	} else {
+		c->cc.aead_alg = OSCORE_AES_CCM_16_64_128;
+	}
+
+	if (params->hkdf != OSCORE_SHA_256) {
+		return oscore_invalid_algorithm_hkdf;
+	} else {
+		c->cc.kdf = OSCORE_SHA_256;
+	}
+
+	if ((params->sign_alg != EdDSA) && (params->sign_alg != ES256)) {
+		return unsupported_signature_algorithm;
+	}
+	c->sign_alg = params->sign_alg;
+	c->ecdh_alg = params->ecdh_alg;
+
+	if ((params->sender_auth_cred.len > OSCORE_GROUP_AUTH_CRED_MAX_LEN) ||
+	    (params->gm_cred.len > OSCORE_GROUP_AUTH_CRED_MAX_LEN) ||
+	    (params->sender_sk.len > OSCORE_GROUP_SK_MAX_LEN)) {
+		return wrong_parameter;
+	}
+	c->sender_auth_cred = params->sender_auth_cred;
+	c->sender_sk = params->sender_sk;
+	if (NULL == params->gm_cred.ptr) {
+		c->gm_cred = EMPTY_ARRAY;
+	} else {
+		c->gm_cred = params->gm_cred;
+	}
+
+	/* The keying material of a group is renewed by the Group Manager,
+	 * the context is therefore always fresh */
+	c->cc.fresh_master_secret_salt = true;
+	c->cc.master_secret = params->master_secret;
+	c->cc.master_salt = params->master_salt;
+	c->cc.id_context = params->gid;
+	c->cc.common_iv.len = sizeof(c->cc.common_iv_buf);
+	c->cc.common_iv.ptr = c->cc.common_iv_buf;
+	TRY(derive(&c->cc, &EMPTY_ARRAY, IV, &c->cc.common_iv));
+	PRINT_ARRAY("Common IV", c->cc.common_iv.ptr, c->cc.common_iv.len);
+
+	c->signature_encryption_key.len =
+		sizeof(c->signature_encryption_key_buf);
+	c->signature_encryption_key.ptr = c->signature_encryption_key_buf;
+	TRY(derive(&c->cc, &EMPTY_ARRAY, SIGNATURE_ENCRYPTION_KEY,
+		   &c->signature_encryption_key));
+	PRINT_ARRAY("Signature Encryption Key", c->signature_encryption_key.ptr,
+		    c->signature_encryption_key.len);
+
+	/*derive Sender Context************************************************/
+	c->sc.sender_id = params->sender_id;
+	c->sc.sender_key.len = sizeof(c->sc.sender_key_buf);
+	c->sc.sender_key.ptr = c->sc.sender_key_buf;
+	c->sc.ssn = 0;
+	TRY(derive(&c->cc, &c->sc.sender_id, KEY, &c->sc.sender_key));
+	PRINT_ARRAY("Sender Key", c->sc.sender_key.ptr, c->sc.sender_key.len);
+
+	/*the Recipient Contexts are added with oscore_group_member_add()*****/
+	memset(c->members, 0, sizeof(c->members));
+	c->member_cnt = 0;
+	/*the free members are taken from the end of the list, start with 0*/
+	for (uint32_t i = 0; i < OSCORE_GROUP_MAX_MEMBERS; i++) {
+		c->free_members[i] =
+			(uint16_t)(OSCORE_GROUP_MAX_MEMBERS - 1 - i);
+	}
+	c->free_cnt = OSCORE_GROUP_MAX_MEMBERS;
+
+	/*set up the request response context**********************************/
+	oscore_interactions_init(c->rrc.interactions);
+	c->rrc.nonce.len = sizeof(c->rrc.nonce_buf);
+	c->rrc.nonce.ptr = c->rrc.nonce_buf;
+	c->rrc.echo_opt_val.len = sizeof(c->rrc.echo_opt_val_buf);
+	c->rrc.echo_opt_val.ptr = c->rrc.echo_opt_val_buf;
+	c->rrc.echo_state_machine = ECHO_SYNCHRONIZED;
+
+	return ok;
+}
+
+enum err oscore_group_member_add(struct group_context *c,
+				 const struct byte_array *recipient_id,
+				 const struct byte_array *auth_cred)
+{
+	if ((NULL == c) || (NULL == recipient_id) || (NULL == auth_cred) ||
+	    (recipient_id->len > RECIPIENT_ID_BUFF_LEN) ||
+	    (auth_cred->len > OSCORE_GROUP_AUTH_CRED_MAX_LEN)) {
+		return wrong_parameter;
+	}
+
+	/* a member with the same Sender ID is replaced, e.g. after rekeying */
+	uint32_t pos;
+	bool present = member_search(c, recipient_id, &pos);
+	if (!present && (0 == c->free_cnt)) {
+		return oscore_group_member_table_full;
+	}
+
+	/* the new Recipient Context is derived aside, so that a replaced
+	 * member stays usable if the derivation fails */
+	struct group_recipient_context new_member;
+	memset(&new_member, 0, sizeof(new_member));
+	member_arrays_set(&new_member);
+	server_replay_window_init(&new_member.rc.replay_window);
+	new_member.rc.recipient_id.len = recipient_id->len;
+	memcpy(new_member.rc.recipient_id.ptr, recipient_id->ptr,
+	       recipient_id->len);
+	new_member.rc.recipient_key.len =
+		sizeof(new_member.rc.recipient_key_buf);
+	new_member.auth_cred.len = auth_cred->len;
+	memcpy(new_member.auth_cred.ptr, auth_cred->ptr, auth_cred->len);
+
+	enum err r = derive(&c->cc, &new_member.rc.recipient_id, KEY,
+			    &new_member.rc.recipient_key);
+	if ((ok == r) && group_pairwise_mode_supported(c)) {
+		r = pairwise_keys_derive(c, &new_member);
+	}
+	if (ok != r) {
+		secure_erase((uint8_t *)&new_member, sizeof(new_member));
+		return r;
+	}
+	PRINT_ARRAY("Recipient Key", new_member.rc.recipient_key.ptr,
+		    new_member.rc.recipient_key.len);
+
+	uint16_t index;
+	if (present) {
+		index = c->member_order[pos];
+	} else {
+		c->free_cnt--;
+		index = c->free_members[c->free_cnt];
+		memmove(&c->member_order[pos + 1], &c->member_order[pos],
+			(c->member_cnt - pos) * sizeof(c->member_order[0]));
+		c->member_order[pos] = index;
+		c->member_cnt++;
+	}
+	struct group_recipient_context *member = &c->members[index];
+	*member = new_member;
+	member_arrays_set(member);
+	member->is_occupied = true;
+	secure_erase((uint8_t *)&new_member, sizeof(new_member));
+	return ok;
+}
+
+enum err oscore_group_member_remove(struct group_context *c,
+				    const struct byte_array *recipient_id)
+{
+	if ((NULL == c) || (NULL == recipient_id)) {
+		return wrong_parameter;
+	}
+
+	uint32_t pos;
+	if (!member_search(c, recipient_id, &pos)) {
+		return oscore_group_member_not_found;
+	}
+	uint16_t index = c->member_order[pos];
+	secure_erase((uint8_t *)&c->members[index], sizeof(c->members[index]));
+	c->member_cnt--;
+	memmove(&c->member_order[pos], &c->member_order[pos + 1],
+		(c->member_cnt - pos) * sizeof(c->member_order[0]));
+	c->free_members[c->free_cnt] = index;
+	c->free_cnt++;
+	return ok;
+}
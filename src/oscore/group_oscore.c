@@ -0,0 +1,397 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "oscore.h"
+
+#include "oscore/aad.h"
+#include "oscore/group_context.h"
+#include "oscore/nonce.h"
+#include "oscore/option.h"
+#include "oscore/oscore_coap.h"
+#include "oscore/oscore_cose.h"
+#include "oscore/oscore_hkdf_info.h"
+#include "oscore/oscore_internal.h"
+#include "oscore/replay_protection.h"
+#include "oscore/security_context.h"
+
+#include "edhoc/edhoc_cose.h"
+
+#include "common/byte_array.h"
+#include "common/crypto_wrapper.h"
+#include "common/memcpy_s.h"
+#include "common/oscore_edhoc_error.h"
+#include "common/print_util.h"
+
+/**
+ * @brief Encodes the Countersign_structure, see
+ *        draft-ietf-core-oscore-groupcomm section 3.5
+ * @param aad the external_aad of Group OSCORE
+ * @param ciphertext the ciphertext including the authentication tag
+ * @param out the encoded structure
+ * @return err
+ */
+static enum err countersign_structure_encode(struct byte_array *aad,
+					     struct byte_array *ciphertext,
+					     struct byte_array *out)
+{
+	uint8_t context_str[] = { "CounterSignature0" };
+	struct byte_array str = BYTE_ARRAY_INIT(
+		context_str, (uint32_t)strlen((char *)context_str));
+
+	TRY(cose_sig_structure_encode(&str, &EMPTY_ARRAY, aad, ciphertext,
+				      out));
+	PRINT_ARRAY("Countersign_structure", out->ptr, out->len);
+	return ok;
+}
+
+/**
+ * @brief Encrypts or decrypts a countersignature by XOR-ing it with a
+ *        keystream derived from the Signature Encryption Key, see
+ *        draft-ietf-core-oscore-groupcomm section 4.1
+ * @param c the group context
+ * @param kid the Sender ID of the sender of the message
+ * @param piv the Partial IV of the message
+ * @param request true if the message is a request
+ * @param signature the signature to be encrypted or decrypted in place
+ * @return err
+ */
+static enum err signature_xor_keystream(struct group_context *c,
+					struct byte_array *kid,
+					struct byte_array *piv, bool request,
+					struct byte_array *signature)
+{
+	BYTE_ARRAY_NEW(info, MAX_INFO_LEN, MAX_INFO_LEN);
+	TRY(oscore_create_keystream_info(kid, &c->cc.id_context, request,
+					 OSCORE_GROUP_SIGNATURE_LEN, &info));
+
+	BYTE_ARRAY_NEW(keystream, OSCORE_GROUP_SIGNATURE_LEN,
+		       OSCORE_GROUP_SIGNATURE_LEN);
+	TRY(hkdf_sha_256(&c->signature_encryption_key, piv, &info,
+			 &keystream));
+
+	for (uint32_t i = 0; i < signature->len; i++) {
+		signature->ptr[i] ^= keystream.ptr[i];
+	}
+	return ok;
+}
+
+/**
+ * @brief Searches the options of a packet for the OSCORE option and reads
+ *        its group flag.
+ * @param packet the OSCORE packet
+ * @return true if the packet is protected in group mode
+ */
+static bool group_flag_is_set(struct o_coap_packet *packet)
+{
+	for (uint8_t i = 0; i < packet->options_cnt; i++) {
+		if ((OSCORE == packet->options[i].option_number) &&
+		    (0 != packet->options[i].len)) {
+			return (0 != (packet->options[i].value[0] &
+				      COMP_OSCORE_OPT_GROUP_FLAG_MASK));
+		}
+	}
+	return false;
+}
+
+enum err coap2oscore_group(uint8_t *buf_o_coap, uint32_t buf_o_coap_len,
+			   uint8_t *buf_oscore, uint32_t *buf_oscore_len,
+			   struct group_context *c, enum oscore_group_mode mode,
+			   const struct byte_array *recipient_id)
+{
+	struct o_coap_packet o_coap_pkt;
+	struct byte_array buf = BYTE_ARRAY_INIT(buf_o_coap, buf_o_coap_len);
+
+	PRINT_MSG("\n\n\ncoap2oscore_group*********************************\n");
+	PRINT_ARRAY("Input CoAP packet", buf_o_coap, buf_o_coap_len);
+
+	if (NULL == c) {
+		return wrong_parameter;
+	}
+	if (c->sc.ssn >= OSCORE_SSN_OVERFLOW_VALUE) {
+		return oscore_ssn_overflow;
+	}
+
+	memset(&o_coap_pkt, 0, sizeof(o_coap_pkt));
+	TRY(coap_deserialize(&buf, &o_coap_pkt));
+
+	/* Dismiss OSCORE encryption if messaging layer detected (simple ACK, code=0.00) */
+	if ((TYPE_ACK == o_coap_pkt.header.type) &&
+	    (CODE_EMPTY == o_coap_pkt.header.code)) {
+		*buf_oscore_len = buf_o_coap_len;
+		return _memcpy_s(buf_oscore, buf_o_coap_len, buf_o_coap,
+				 buf_o_coap_len);
+	}
+
+	/* Divide CoAP options into E-option and U-option and create the
+	plaintext (code + E-options + o_coap_payload) */
+	struct o_coap_option e_options[MAX_OPTION_COUNT];
+	uint8_t e_options_cnt = 0;
+	uint16_t e_options_len = 0;
+	struct o_coap_option u_options[MAX_OPTION_COUNT];
+	uint8_t u_options_cnt = 0;
+	TRY(inner_outer_option_split(&o_coap_pkt, e_options, &e_options_cnt,
+				     &e_options_len, u_options,
+				     &u_options_cnt));
+
+	uint32_t plaintext_len = (uint32_t)(1 + e_options_len);
+	if (o_coap_pkt.payload.len) {
+		plaintext_len = plaintext_len + 1 + o_coap_pkt.payload.len;
+	}
+	BYTE_ARRAY_NEW(plaintext, MAX_PLAINTEXT_LEN, plaintext_len);
+	TRY(plaintext_setup(&o_coap_pkt, e_options, e_options_cnt, &plaintext));
+
+	enum o_coap_msg msg_type;
+	TRY(coap_get_message_type(&o_coap_pkt, &msg_type));
+	struct byte_array token =
+		BYTE_ARRAY_INIT(o_coap_pkt.token, o_coap_pkt.header.TKL);
+
+	/* Every message, also a response, uses a fresh PIV. This way responses
+	of different servers to the same multicast request never share a nonce. */
+	BYTE_ARRAY_NEW(piv, MAX_PIV_LEN, MAX_PIV_LEN);
+	BYTE_ARRAY_NEW(nonce, NONCE_LEN, NONCE_LEN);
+	TRY(ssn2piv(c->sc.ssn, &piv));
+	c->sc.ssn++;
+	TRY(create_nonce(&c->sc.sender_id, &piv, &c->cc.common_iv, &nonce));
+
+	struct byte_array request_piv = piv;
+	struct byte_array request_kid = c->sc.sender_id;
+	TRY(oscore_interactions_read_wrapper(msg_type, &token,
+					     c->rrc.interactions, &request_piv,
+					     &request_kid));
+
+	/* select the key */
+	struct byte_array *key;
+	if (OSCORE_GROUP_MODE == mode) {
+		key = &c->sc.sender_key;
+	} else {
+		if (!group_pairwise_mode_supported(c)) {
+			return not_supported_feature;
+		}
+		/* a pairwise request is addressed to recipient_id, a pairwise
+		response goes to the sender of the request */
+		const struct byte_array *peer_id = &request_kid;
+		if (is_request(&o_coap_pkt)) {
+			if (NULL == recipient_id) {
+				return wrong_parameter;
+			}
+			peer_id = recipient_id;
+		}
+		struct group_recipient_context *member;
+		TRY(group_member_get(c, peer_id, &member));
+		key = &member->pairwise_sender_key;
+	}
+
+	BYTE_ARRAY_NEW(aad, OSCORE_GROUP_MAX_AAD_LEN, OSCORE_GROUP_MAX_AAD_LEN);
+	TRY(create_group_aad(c, &request_kid, &request_piv,
+			     &c->sender_auth_cred, &aad));
+
+	/* In group mode the encrypted countersignature follows the ciphertext */
+	uint32_t signature_len =
+		(OSCORE_GROUP_MODE == mode) ? OSCORE_GROUP_SIGNATURE_LEN : 0;
+	BYTE_ARRAY_NEW(ciphertext, MAX_CIPHERTEXT_LEN + OSCORE_GROUP_SIGNATURE_LEN,
+		       plaintext.len + AUTH_TAG_LEN + signature_len);
+	ciphertext.len = plaintext.len + AUTH_TAG_LEN;
+	TRY(oscore_cose_encrypt(&plaintext, &ciphertext, &nonce, &aad, key));
+
+	if (OSCORE_GROUP_MODE == mode) {
+		BYTE_ARRAY_NEW(countersign_structure,
+			       OSCORE_GROUP_COUNTERSIGN_STRUCTURE_LEN,
+			       OSCORE_GROUP_COUNTERSIGN_STRUCTURE_LEN);
+		TRY(countersign_structure_encode(&aad, &ciphertext,
+						 &countersign_structure));
+
+		struct byte_array signature = BYTE_ARRAY_INIT(
+			ciphertext.ptr + ciphertext.len, signature_len);
+		TRY(sign(c->sign_alg, &c->sender_sk, &c->sender_auth_cred,
+			 &countersign_structure, signature.ptr));
+		PRINT_ARRAY("Countersignature", signature.ptr, signature.len);
+		TRY(signature_xor_keystream(c, &c->sc.sender_id, &piv,
+					    is_request(&o_coap_pkt),
+					    &signature));
+		ciphertext.len += signature_len;
+	}
+
+	/* The KID is included in all messages since the recipient has to find
+	the Recipient Context of the sender. The Gid is sent in requests only. */
+	struct byte_array kid_context = BYTE_ARRAY_INIT(NULL, 0);
+	if (is_request(&o_coap_pkt)) {
+		kid_context = c->cc.id_context;
+	}
+	struct oscore_option oscore_option;
+	TRY(oscore_option_generate(&piv, &c->sc.sender_id, &kid_context,
+				   &oscore_option));
+	if (OSCORE_GROUP_MODE == mode) {
+		oscore_option.value[0] |= COMP_OSCORE_OPT_GROUP_FLAG_MASK;
+	}
+
+	BYTE_ARRAY_NEW(uri_paths, OSCORE_MAX_URI_PATH_LEN,
+		       OSCORE_MAX_URI_PATH_LEN);
+	TRY(uri_path_create(o_coap_pkt.options, o_coap_pkt.options_cnt,
+			    uri_paths.ptr, &(uri_paths.len)));
+	TRY(oscore_interactions_update_wrapper(msg_type, &token, &uri_paths,
+					       c->rrc.interactions,
+					       &request_piv, &request_kid));
+
+	struct o_coap_packet oscore_pkt;
+	TRY(oscore_pkg_generate(&o_coap_pkt, &oscore_pkt, u_options,
+				u_options_cnt, &ciphertext, &oscore_option));
+
+	return coap_serialize(&oscore_pkt, buf_oscore, buf_oscore_len);
+}
+
+enum err oscore2coap_group(uint8_t *buf_in, uint32_t buf_in_len,
+			   uint8_t *buf_out, uint32_t *buf_out_len,
+			   struct group_context *c)
+{
+	struct o_coap_packet oscore_packet;
+	struct compressed_oscore_option oscore_option;
+	struct byte_array buf = BYTE_ARRAY_INIT(buf_in, buf_in_len);
+
+	PRINT_MSG("\n\n\noscore2coap_group*********************************\n");
+	PRINT_ARRAY("Input OSCORE packet", buf_in, buf_in_len);
+
+	if (NULL == c) {
+		return wrong_parameter;
+	}
+
+	memset(&oscore_packet, 0, sizeof(oscore_packet));
+	TRY(coap_deserialize(&buf, &oscore_packet));
+	TRY(oscore_option_parser(oscore_packet.options,
+				 oscore_packet.options_cnt, &oscore_option));
+
+	/* the KID identifies the sender within the group */
+	if (0 == oscore_option.k) {
+		return not_valid_input_packet;
+	}
+	if (0 == oscore_option.piv.len) {
+		return not_supported_feature;
+	}
+	if (is_request(&oscore_packet) && (0 != oscore_option.h) &&
+	    !array_equals(&oscore_option.kid_context, &c->cc.id_context)) {
+		return oscore_group_gid_mismatch;
+	}
+
+	struct group_recipient_context *member;
+	TRY(group_member_get(c, &oscore_option.kid, &member));
+
+	/* All messages of a member carry a fresh PIV, so requests and responses
+	are checked against the same replay window */
+	uint64_t ssn;
+	TRY(piv2ssn(&oscore_option.piv, &ssn));
+	if (!server_is_sequence_number_valid(ssn,
+					     &member->rc.replay_window)) {
+		PRINT_MSG("Replayed message detected!\n");
+		return oscore_replay_window_protection_error;
+	}
+
+	struct byte_array token =
+		BYTE_ARRAY_INIT(oscore_packet.token, oscore_packet.header.TKL);
+	struct byte_array request_piv = oscore_option.piv;
+	struct byte_array request_kid = oscore_option.kid;
+	if (!is_request(&oscore_packet)) {
+		/* The record is kept, since a multicast request can have
+		multiple responses. It is replaced by the next request to the
+		same resource. */
+		struct oscore_interaction_t *record;
+		TRY(oscore_interactions_get_record(c->rrc.interactions,
+						   token.ptr,
+						   (uint8_t)token.len,
+						   &record));
+		request_piv.ptr = record->request_piv;
+		request_piv.len = record->request_piv_len;
+		request_kid.ptr = record->request_kid;
+		request_kid.len = record->request_kid_len;
+	}
+
+	BYTE_ARRAY_NEW(nonce, NONCE_LEN, NONCE_LEN);
+	TRY(create_nonce(&oscore_option.kid, &oscore_option.piv,
+			 &c->cc.common_iv, &nonce));
+
+	BYTE_ARRAY_NEW(aad, OSCORE_GROUP_MAX_AAD_LEN, OSCORE_GROUP_MAX_AAD_LEN);
+	TRY(create_group_aad(c, &request_kid, &request_piv, &member->auth_cred,
+			     &aad));
+
+	struct byte_array ciphertext = oscore_packet.payload;
+	struct byte_array *key;
+	if (group_flag_is_set(&oscore_packet)) {
+		if (ciphertext.len <
+		    (AUTH_TAG_LEN + OSCORE_GROUP_SIGNATURE_LEN)) {
+			return not_valid_input_packet;
+		}
+		ciphertext.len -= OSCORE_GROUP_SIGNATURE_LEN;
+
+		BYTE_ARRAY_NEW(signature, OSCORE_GROUP_SIGNATURE_LEN,
+			       OSCORE_GROUP_SIGNATURE_LEN);
+		memcpy(signature.ptr, ciphertext.ptr + ciphertext.len,
+		       signature.len);
+		TRY(signature_xor_keystream(c, &oscore_option.kid,
+					    &oscore_option.piv,
+					    is_request(&oscore_packet),
+					    &signature));
+
+		BYTE_ARRAY_NEW(countersign_structure,
+			       OSCORE_GROUP_COUNTERSIGN_STRUCTURE_LEN,
+			       OSCORE_GROUP_COUNTERSIGN_STRUCTURE_LEN);
+		TRY(countersign_structure_encode(&aad, &ciphertext,
+						 &countersign_structure));
+
+		bool result = false;
+		struct const_byte_array m = BYTE_ARRAY_INIT(
+			countersign_structure.ptr, countersign_structure.len);
+		struct const_byte_array sgn =
+			BYTE_ARRAY_INIT(signature.ptr, signature.len);
+		TRY(verify(c->sign_alg, &member->auth_cred, &m, &sgn,
+			   &result));
+		if (!result) {
+			return oscore_group_signature_invalid;
+		}
+		key = &member->rc.recipient_key;
+	} else {
+		if (!group_pairwise_mode_supported(c)) {
+			return not_supported_feature;
+		}
+		if (ciphertext.len < AUTH_TAG_LEN) {
+			return not_valid_input_packet;
+		}
+		key = &member->pairwise_recipient_key;
+	}
+
+	BYTE_ARRAY_NEW(plaintext, MAX_PLAINTEXT_LEN,
+		       ciphertext.len - AUTH_TAG_LEN);
+	TRY(oscore_cose_decrypt(&ciphertext, &plaintext, &nonce, &aad, key));
+
+	struct o_coap_packet output_coap;
+	TRY(o_coap_pkg_generate(&plaintext, &oscore_packet, &output_coap));
+
+	/* the message is authentic, update the replay window */
+	server_replay_window_update(ssn, &member->rc.replay_window);
+
+	if (is_request(&oscore_packet)) {
+		/* The decrypted packet is used for URI Paths and message type,
+		as the original values are modified while encrypting. */
+		enum o_coap_msg msg_type;
+		TRY(coap_get_message_type(&output_coap, &msg_type));
+		BYTE_ARRAY_NEW(uri_paths, OSCORE_MAX_URI_PATH_LEN,
+			       OSCORE_MAX_URI_PATH_LEN);
+		TRY(uri_path_create(output_coap.options,
+				    output_coap.options_cnt, uri_paths.ptr,
+				    &(uri_paths.len)));
+		TRY(oscore_interactions_update_wrapper(
+			msg_type, &token, &uri_paths, c->rrc.interactions,
+			&request_piv, &request_kid));
+	}
+
+	return coap_serialize(&output_coap, buf_out, buf_out_len);
+}
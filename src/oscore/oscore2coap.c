@@ -23,6 +23,7 @@
 #include "oscore/oscore_cose.h"
 #include "oscore/security_context.h"
 #include "oscore/replay_protection.h"
+#include "oscore/oscore_internal.h"
 
 #include "common/byte_array.h"
 #include "common/oscore_edhoc_error.h"
@@ -40,9 +41,8 @@
  * @param out: pointer output compressed OSCORE_option
  * @return error code
  */
-STATIC enum err oscore_option_parser(const struct o_coap_option *opt,
-				     uint8_t opt_cnt,
-				     struct compressed_oscore_option *out)
+enum err oscore_option_parser(const struct o_coap_option *opt, uint8_t opt_cnt,
+			      struct compressed_oscore_option *out)
 {
 	uint8_t *val_ptr;
 	uint16_t temp_kid_len = 0;
@@ -197,9 +197,9 @@ options_reorder(struct o_coap_option *U_options, uint8_t U_options_cnt,
  * @param out: pointer to output CoAP packet
  * @return
  */
-static inline enum err o_coap_pkg_generate(struct byte_array *decrypted_payload,
-					   struct o_coap_packet *oscore_pkt,
-					   struct o_coap_packet *out)
+enum err o_coap_pkg_generate(struct byte_array *decrypted_payload,
+			     struct o_coap_packet *oscore_pkt,
+			     struct o_coap_packet *out)
 {
 	uint8_t code = 0;
 	struct byte_array unprotected_o_coap_payload = BYTE_ARRAY_INIT(NULL, 0);
@@ -246,6 +246,9 @@ static inline enum err o_coap_pkg_generate(struct byte_array *decrypted_payload,
  * @param new_nonce_oscore_option Input OSCORE option from the packet.
  *        Use proper pointer for cases when new nonce are generated, or
  *        NULL if data from corresponding request should be used.
+ * @param observation Interaction record of the observation if the packet
+ *        is a notification, NULL otherwise. The AAD and the request nonce
+ *        are then taken from the record instead of the interactions table.
  * @param input_oscore Input OSCORE packet.
  * @param output_coap Output decrypted coap packet.
  * @return enum err 
@@ -254,11 +257,14 @@ static enum err
 decrypt_wrapper(struct byte_array *ciphertext, struct byte_array *plaintext,
 		struct context *c,
 		struct compressed_oscore_option *new_nonce_oscore_option,
+		struct oscore_interaction_t *observation,
 		struct o_coap_packet *input_oscore,
 		struct o_coap_packet *output_coap)
 {
 	BYTE_ARRAY_NEW(new_nonce, NONCE_LEN, NONCE_LEN);
 	struct byte_array nonce;
+	uint8_t aad_buf[MAX_AAD_LEN];
+	struct byte_array aad = BYTE_ARRAY_INIT(aad_buf, sizeof(aad_buf));
 
 	/* Read necessary fields from the input packet. */
 	enum o_coap_msg msg_type_oscore;
@@ -273,30 +279,44 @@ decrypt_wrapper(struct byte_array *ciphertext, struct byte_array *plaintext,
 		request_piv = new_nonce_oscore_option->piv;
 		request_kid = new_nonce_oscore_option->kid;
 	}
-	TRY(oscore_interactions_read_wrapper(msg_type_oscore, &token,
-					     c->rrc.interactions, &request_piv,
-					     &request_kid));
-	/* Message type read from encrypted packet can be invalid due to external OBSERVE option change,
-	   but it is sufficient enough for the interactions read wrapper to work properly,
-	   as it only need to know whether the packet is any kind of response. */
+	if (NULL != observation) {
+		/* Fast path for notifications: the AAD is the same for all 
+		   notifications of an observation and, with
+		   OSCORE_OBSERVE_AAD_CACHE, is cached in its record. */
+		request_piv.ptr = observation->request_piv;
+		request_piv.len = observation->request_piv_len;
+		request_kid.ptr = observation->request_kid;
+		request_kid.len = observation->request_kid_len;
+		TRY(oscore_interactions_get_aad(observation, c->cc.aead_alg,
+						&aad));
+	} else {
+		TRY(oscore_interactions_read_wrapper(
+			msg_type_oscore, &token, c->rrc.interactions,
+			&request_piv, &request_kid));
+		/* Message type read from encrypted packet can be invalid due to external OBSERVE option change,
+		   but it is sufficient enough for the interactions read wrapper to work properly,
+		   as it only need to know whether the packet is any kind of response. */
+		TRY(create_aad(NULL, 0, c->cc.aead_alg, &request_kid,
+			       &request_piv, &aad));
+	}
 
 	/* Calculate new nonce from oscore option - only if required by the usecase.
-	   If not, nonce from the corresponding request (rcc.nonce) is used. */
+	   If not, nonce from the corresponding request is used. A notification 
+	   without PIV uses the nonce of its registration, other responses the 
+	   nonce of the last request (rrc.nonce). */
 	if (NULL != new_nonce_oscore_option) {
 		TRY(create_nonce(&new_nonce_oscore_option->kid,
 				 &new_nonce_oscore_option->piv,
 				 &c->cc.common_iv, &new_nonce));
 		nonce = new_nonce;
+	} else if (NULL != observation) {
+		TRY(create_nonce(&request_kid, &request_piv, &c->cc.common_iv,
+				 &new_nonce));
+		nonce = new_nonce;
 	} else {
 		nonce = c->rrc.nonce;
 	}
 
-	/* compute AAD */
-	uint8_t aad_buf[MAX_AAD_LEN];
-	struct byte_array aad = BYTE_ARRAY_INIT(aad_buf, sizeof(aad_buf));
-	TRY(create_aad(NULL, 0, c->cc.aead_alg, &request_kid, &request_piv,
-		       &aad));
-
 	/* Decrypt the ciphertext */
 	TRY(oscore_cose_decrypt(ciphertext, plaintext, &nonce, &aad,
 				&c->rc.recipient_key));
@@ -309,6 +329,11 @@ decrypt_wrapper(struct byte_array *ciphertext, struct byte_array *plaintext,
 	/* Generate corresponding CoAP packet */
 	TRY(o_coap_pkg_generate(plaintext, input_oscore, output_coap));
 
+	/* A notification leaves the interactions unchanged. */
+	if (NULL != observation) {
+		return ok;
+	}
+
 	/* Handle OSCORE interactions after successful decryption.
 	   Decrypted packet is used for URI Paths and message type, as original values are modified while encrypting. */
 	enum o_coap_msg msg_type;
@@ -324,53 +349,25 @@ decrypt_wrapper(struct byte_array *ciphertext, struct byte_array *plaintext,
 	return ok;
 }
 
-enum err oscore2coap(uint8_t *buf_in, uint32_t buf_in_len, uint8_t *buf_out,
-		     uint32_t *buf_out_len, struct context *c)
+enum err oscore_packet_unprotect(struct o_coap_packet *oscore_packet,
+				 struct compressed_oscore_option *oscore_option,
+				 struct byte_array *plaintext,
+				 struct o_coap_packet *output_coap,
+				 struct context *c)
 {
-	struct o_coap_packet oscore_packet;
-	struct compressed_oscore_option oscore_option;
-	struct byte_array buf;
-
-	PRINT_MSG("\n\n\noscore2coap***************************************\n");
-	PRINT_ARRAY("Input OSCORE packet", buf_in, buf_in_len);
-
-	buf.ptr = buf_in;
-	buf.len = buf_in_len;
-
-	/* Make sure that given context is fresh enough to process the message. */
-	TRY(check_context_freshness(c));
-
-	/*Parse the incoming message (buf_in) into a CoAP struct*/
-	memset(&oscore_packet, 0, sizeof(oscore_packet));
-	TRY(coap_deserialize(&buf, &oscore_packet));
-
-	/* Check if the packet is OSCORE packet and if so parse the OSCORE option */
-	TRY(oscore_option_parser(oscore_packet.options,
-				 oscore_packet.options_cnt, &oscore_option));
-
 	/* Encrypted packet payload */
-	struct byte_array *ciphertext = &oscore_packet.payload;
-
-	/* Setup buffer for the plaintext. The plaintext is shorter than the 
-	ciphertext because of the authentication tag*/
-	uint32_t plaintext_bytes_len = ciphertext->len - AUTH_TAG_LEN;
-	BYTE_ARRAY_NEW(plaintext, MAX_PLAINTEXT_LEN, plaintext_bytes_len);
-	/* TODO plaintext can be moved inside decrypt_wrapper to simplify the code.
-	   To do so, refactor of echo_val_is_fresh is needed, to operate on o_coap_packet. */
-
-	/* Helper structure for decrypted coap packet */
-	struct o_coap_packet output_coap;
+	struct byte_array *ciphertext = &oscore_packet->payload;
 
 	/*In requests the OSCORE packet contains at least a KID = sender ID 
         and eventually sender sequence number*/
-	if (is_request(&oscore_packet)) {
+	if (is_request(oscore_packet)) {
 		/*Check that the recipient context c->rc has a  Recipient ID that
 		matches the received with the oscore option KID (Sender ID).
 		If this is not true return an error which indicates the caller
 		application to tray another context. This is useful when the caller
 		app doesn't know in advance to which context an incoming packet 
                 belongs.*/
-		if (!array_equals(&c->rc.recipient_id, &oscore_option.kid)) {
+		if (!array_equals(&c->rc.recipient_id, &oscore_option->kid)) {
 			return oscore_kid_recipient_id_mismatch;
 		}
 
@@ -378,7 +375,7 @@ enum err oscore2coap(uint8_t *buf_in, uint32_t buf_in_len, uint8_t *buf_out,
 		   It must be performed before decrypting the packet (see RFC 8613 p. 7.4). */
 		if (ECHO_SYNCHRONIZED == c->rrc.echo_state_machine) {
 			uint64_t ssn;
-			piv2ssn(&oscore_option.piv, &ssn);
+			piv2ssn(&oscore_option->piv, &ssn);
 			if (!server_is_sequence_number_valid(
 				    ssn, &c->rc.replay_window)) {
 				PRINT_MSG("Replayed message detected!\n");
@@ -387,8 +384,8 @@ enum err oscore2coap(uint8_t *buf_in, uint32_t buf_in_len, uint8_t *buf_out,
 		}
 
 		/* Decrypt packet using new nonce based on the packet */
-		TRY(decrypt_wrapper(ciphertext, &plaintext, c, &oscore_option,
-				    &oscore_packet, &output_coap));
+		TRY(decrypt_wrapper(ciphertext, plaintext, c, oscore_option,
+				    NULL, oscore_packet, output_coap));
 
 		if (ECHO_REBOOT == c->rrc.echo_state_machine) {
 			/* Abort the execution if this is the the first request after reboot.
@@ -402,9 +399,9 @@ enum err oscore2coap(uint8_t *buf_in, uint32_t buf_in_len, uint8_t *buf_out,
 			   If so, perform replay window reinitialization and start normal operation.
 			   If not, repeat the whole process until normal operation can be started. */
 			if (ok == echo_val_is_fresh(&c->rrc.echo_opt_val,
-						    &plaintext)) {
+						    plaintext)) {
 				uint64_t ssn;
-				piv2ssn(&oscore_option.piv, &ssn);
+				piv2ssn(&oscore_option->piv, &ssn);
 				TRY(server_replay_window_reinit(
 					ssn, &c->rc.replay_window));
 				c->rrc.echo_state_machine = ECHO_SYNCHRONIZED;
@@ -417,55 +414,119 @@ enum err oscore2coap(uint8_t *buf_in, uint32_t buf_in_len, uint8_t *buf_out,
 			/* Normal operation - update replay window. */
 			TRY_EXPECT(c->rrc.echo_state_machine,
 				   ECHO_SYNCHRONIZED);
-			server_replay_window_update(*oscore_option.piv.ptr,
+			server_replay_window_update(*oscore_option->piv.ptr,
 						    &c->rc.replay_window);
 		}
 	} else {
 		/* received any kind of response */
-		if (is_observe(oscore_packet.options,
-			       oscore_packet.options_cnt)) {
-			if (oscore_option.piv.len != 0) {
+		if (is_observe(oscore_packet->options,
+			       oscore_packet->options_cnt)) {
+			/* Notifications are replay protected per observation, 
+			   with the state kept in the record of the registration. */
+			struct oscore_interaction_t *observation;
+			TRY(oscore_interactions_get_record(
+				c->rrc.interactions, oscore_packet->token,
+				oscore_packet->header.TKL, &observation));
+
+			if (oscore_option->piv.len != 0) {
 				/*Notification with PIV received*/
 				PRINT_MSG(
 					"Observe notification with PIV received\n");
 
 				TRY(replay_protection_check_notification(
-					c->rc.notification_num,
-					c->rc.notification_num_initialized,
-					&oscore_option.piv));
+					observation->notification_num,
+					observation->notification_num_initialized,
+					&oscore_option->piv));
 
 				/* Decrypt packet using new nonce based on the packet */
-				TRY(decrypt_wrapper(ciphertext, &plaintext, c,
-						    &oscore_option,
-						    &oscore_packet,
-						    &output_coap));
+				TRY(decrypt_wrapper(ciphertext, plaintext, c,
+						    oscore_option, observation,
+						    oscore_packet,
+						    output_coap));
 
-				/*update replay protection value in context*/
+				/*update replay protection value in the observation*/
 				TRY(notification_number_update(
-					&c->rc.notification_num,
-					&c->rc.notification_num_initialized,
-					&oscore_option.piv));
+					&observation->notification_num,
+					&observation->notification_num_initialized,
+					&oscore_option->piv));
 			} else {
-				/*Notification without PIV received -- Currently not supported*/
-				return not_supported_feature; //LCOV_EXCL_LINE
+				/*Notification without PIV received. It is 
+				protected with the nonce of the registration, so it 
+				can only be accepted once and only before any 
+				notification with PIV.*/
+				PRINT_MSG(
+					"Observe notification without PIV received\n");
+				if (observation->notification_num_initialized ||
+				    observation->piv_less_notification_received) {
+					PRINT_MSG(
+						"Replayed notification detected!\n");
+					return oscore_replay_notification_protection_error;
+				}
+
+				TRY(decrypt_wrapper(ciphertext, plaintext, c,
+						    NULL, observation,
+						    oscore_packet,
+						    output_coap));
+				observation->piv_less_notification_received =
+					true;
 			}
 		} else {
 			/*regular response received*/
-			if (oscore_option.piv.len != 0) {
+			if (oscore_option->piv.len != 0) {
 				/*response with PIV*/
-				TRY(decrypt_wrapper(ciphertext, &plaintext, c,
-						    &oscore_option,
-						    &oscore_packet,
-						    &output_coap));
+				TRY(decrypt_wrapper(ciphertext, plaintext, c,
+						    oscore_option, NULL,
+						    oscore_packet,
+						    output_coap));
 			} else {
 				/*response without PIV*/
-				TRY(decrypt_wrapper(ciphertext, &plaintext, c,
-						    NULL, &oscore_packet,
-						    &output_coap));
+				TRY(decrypt_wrapper(ciphertext, plaintext, c,
+						    NULL, NULL, oscore_packet,
+						    output_coap));
 			}
 		}
 	}
 
+	return ok;
+}
+
+enum err oscore2coap(uint8_t *buf_in, uint32_t buf_in_len, uint8_t *buf_out,
+		     uint32_t *buf_out_len, struct context *c)
+{
+	struct o_coap_packet oscore_packet;
+	struct compressed_oscore_option oscore_option;
+	struct byte_array buf;
+
+	PRINT_MSG("\n\n\noscore2coap***************************************\n");
+	PRINT_ARRAY("Input OSCORE packet", buf_in, buf_in_len);
+
+	buf.ptr = buf_in;
+	buf.len = buf_in_len;
+
+	/* Make sure that given context is fresh enough to process the message. */
+	TRY(check_context_freshness(c));
+
+	/*Parse the incoming message (buf_in) into a CoAP struct*/
+	memset(&oscore_packet, 0, sizeof(oscore_packet));
+	TRY(coap_deserialize(&buf, &oscore_packet));
+
+	/* Check if the packet is OSCORE packet and if so parse the OSCORE option */
+	TRY(oscore_option_parser(oscore_packet.options,
+				 oscore_packet.options_cnt, &oscore_option));
+
+	/* Setup buffer for the plaintext. The plaintext is shorter than the 
+	ciphertext because of the authentication tag*/
+	uint32_t plaintext_bytes_len = oscore_packet.payload.len - AUTH_TAG_LEN;
+	BYTE_ARRAY_NEW(plaintext, MAX_PLAINTEXT_LEN, plaintext_bytes_len);
+	/* TODO plaintext can be moved inside decrypt_wrapper to simplify the code.
+	   To do so, refactor of echo_val_is_fresh is needed, to operate on o_coap_packet. */
+
+	/* Helper structure for decrypted coap packet */
+	struct o_coap_packet output_coap;
+
+	TRY(oscore_packet_unprotect(&oscore_packet, &oscore_option, &plaintext,
+				    &output_coap, c));
+
 	/*Convert to byte string*/
 	return coap_serialize(&output_coap, buf_out, buf_out_len);
 }
@@ -25,6 +25,13 @@
 /*the additional bytes in the enc_structure are constant*/
 #define ENCRYPT0_ENCODING_OVERHEAD 16
 
+/*the enc_structure of OSCORE*/
+#define ENC_STRUCTURE_LEN (MAX_AAD_LEN + ENCRYPT0_ENCODING_OVERHEAD)
+
+/*the external_aad of Group OSCORE is the longest one*/
+#define ENC_STRUCTURE_MAX_LEN                                                  \
+	(OSCORE_GROUP_MAX_AAD_LEN + ENCRYPT0_ENCODING_OVERHEAD)
+
 /**
  * @brief Encode the input AAD to defined COSE structure
  * @param external_aad: input aad to form COSE structure
@@ -66,7 +73,7 @@ enum err oscore_cose_decrypt(struct byte_array *in_ciphertext,
 {
 	/* get enc_structure */
 	uint32_t aad_len = recipient_aad->len + ENCRYPT0_ENCODING_OVERHEAD;
-	BYTE_ARRAY_NEW(aad, MAX_AAD_LEN, aad_len);
+	BYTE_ARRAY_NEW(aad, ENC_STRUCTURE_MAX_LEN, aad_len);
 	TRY(create_enc_structure(recipient_aad, &aad));
 	PRINT_ARRAY("AAD encoded", aad.ptr, aad.len);
 	struct byte_array tag = BYTE_ARRAY_INIT(
@@ -90,7 +97,7 @@ enum err oscore_cose_encrypt(struct byte_array *in_plaintext,
 {
 	/* get enc_structure  */
 	uint32_t aad_len = sender_aad->len + ENCRYPT0_ENCODING_OVERHEAD;
-	BYTE_ARRAY_NEW(aad, MAX_AAD_LEN, aad_len);
+	BYTE_ARRAY_NEW(aad, ENC_STRUCTURE_MAX_LEN, aad_len);
 
 	TRY(create_enc_structure(sender_aad, &aad));
 	PRINT_ARRAY("aad enc structure", aad.ptr, aad.len);
@@ -110,3 +117,82 @@ enum err oscore_cose_encrypt(struct byte_array *in_plaintext,
 
 	return ok;
 }
+
+/**
+ * @brief Sets up the AEAD computation of an encryption of 
+ * oscore_cose_encrypt_multi()
+ * @param job the encryption
+ * @param aad buffer for the enc_structure
+ * @param tag the tag
+ * @param aead the AEAD computation
+ * @return err
+ */
+static enum err encrypt_job_setup(struct oscore_cose_encrypt_job *job,
+				  struct byte_array *aad, struct byte_array *tag,
+				  struct aead_job *aead)
+{
+	uint32_t aad_len = job->sender_aad->len + ENCRYPT0_ENCODING_OVERHEAD;
+	TRY(check_buffer_size(aad->len, aad_len));
+	aad->len = aad_len;
+	TRY(create_enc_structure(job->sender_aad, aad));
+
+	TRY(check_buffer_size(job->out_ciphertext->len,
+			      job->in_plaintext->len + AUTH_TAG_LEN));
+	tag->ptr = job->out_ciphertext->ptr + job->in_plaintext->len;
+	tag->len = AUTH_TAG_LEN;
+	job->out_ciphertext->len = job->in_plaintext->len;
+
+	aead->op = ENCRYPT;
+	aead->in = job->in_plaintext;
+	aead->key = job->key;
+	aead->nonce = job->nonce;
+	aead->aad = aad;
+	aead->out = job->out_ciphertext;
+	aead->tag = tag;
+	return ok;
+}
+
+enum err oscore_cose_encrypt_multi(struct oscore_cose_encrypt_job *jobs,
+				   uint32_t n)
+{
+	BYTE_ARRAY_NEW(aad_buf, OSCORE_PROTECT_BATCH * ENC_STRUCTURE_LEN,
+		       OSCORE_PROTECT_BATCH * ENC_STRUCTURE_LEN);
+	struct byte_array aad[OSCORE_PROTECT_BATCH];
+	struct byte_array tag[OSCORE_PROTECT_BATCH];
+	struct aead_job aead[OSCORE_PROTECT_BATCH];
+	struct oscore_cose_encrypt_job *pending[OSCORE_PROTECT_BATCH];
+
+	for (uint32_t i = 0; i < n; i += OSCORE_PROTECT_BATCH) {
+		uint32_t m = 0;
+		for (uint32_t k = i; k < n && k < i + OSCORE_PROTECT_BATCH;
+		     k++) {
+			aad[m].ptr = aad_buf.ptr + m * ENC_STRUCTURE_LEN;
+			aad[m].len = ENC_STRUCTURE_LEN;
+			jobs[k].result = encrypt_job_setup(&jobs[k], &aad[m],
+							   &tag[m], &aead[m]);
+			if (ok == jobs[k].result) {
+				pending[m++] = &jobs[k];
+			}
+		}
+
+		/*the results are collected below*/
+		(void)aead_multi(aead, m);
+
+		for (uint32_t k = 0; k < m; k++) {
+			pending[k]->result = aead[k].result;
+			if (ok == aead[k].result) {
+				pending[k]->out_ciphertext->len += AUTH_TAG_LEN;
+				PRINT_ARRAY("Ciphertext + tag",
+					    pending[k]->out_ciphertext->ptr,
+					    pending[k]->out_ciphertext->len);
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < n; i++) {
+		if (ok != jobs[i].result) {
+			return jobs[i].result;
+		}
+	}
+	return ok;
+}
@@ -0,0 +1,195 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "oscore.h"
+
+#include "oscore/oscore_coap.h"
+#include "oscore/option.h"
+#include "oscore/oscore_internal.h"
+
+#include "common/byte_array.h"
+#include "common/oscore_edhoc_error.h"
+#include "common/memcpy_s.h"
+#include "common/print_util.h"
+
+#define CBOR_BSTR_TYPE 0x40
+#define CBOR_TYPE_MASK 0xe0
+#define CBOR_INFO_MASK 0x1f
+#define CBOR_INFO_UINT8 24
+#define CBOR_INFO_UINT32 26
+
+/**
+ * @brief Sets the deltas of options which are sorted by their number.
+ * @param options the options
+ * @param options_cnt number of options
+ */
+static void options_delta_set(struct o_coap_option *options,
+			      uint8_t options_cnt)
+{
+	uint16_t prev = 0;
+	for (uint8_t i = 0; i < options_cnt; i++) {
+		options[i].delta = (uint16_t)(options[i].option_number - prev);
+		prev = options[i].option_number;
+	}
+}
+
+/**
+ * @brief Gets the length of the CBOR byte string at the beginning of a
+ *        buffer, e.g. of message_3 in the payload of a combined request.
+ * @param in the buffer
+ * @param len the length of the byte string including its head
+ * @return ok or cbor_decoding_error
+ */
+static enum err bstr_len_get(const struct byte_array *in, uint32_t *len)
+{
+	if ((0 == in->len) ||
+	    (CBOR_BSTR_TYPE != (in->ptr[0] & CBOR_TYPE_MASK))) {
+		return cbor_decoding_error;
+	}
+
+	uint8_t info = in->ptr[0] & CBOR_INFO_MASK;
+	uint32_t head_len = 1;
+	uint32_t value_len = info;
+	if (info >= CBOR_INFO_UINT8) {
+		if (info > CBOR_INFO_UINT32) {
+			return cbor_decoding_error;
+		}
+		/* the length follows in 1, 2 or 4 bytes */
+		uint32_t n = (uint32_t)1 << (info - CBOR_INFO_UINT8);
+		if (in->len - head_len < n) {
+			return cbor_decoding_error;
+		}
+		value_len = 0;
+		for (uint32_t i = 0; i < n; i++) {
+			value_len = (value_len << 8) | in->ptr[head_len + i];
+		}
+		head_len += n;
+	}
+
+	if (value_len > in->len - head_len) {
+		return cbor_decoding_error;
+	}
+	*len = head_len + value_len;
+	return ok;
+}
+
+enum err oscore_edhoc_request_combine(uint8_t *buf_oscore,
+				      uint32_t buf_oscore_len,
+				      const struct byte_array *msg3,
+				      uint8_t *buf_out, uint32_t *buf_out_len)
+{
+	struct o_coap_packet packet;
+	struct compressed_oscore_option oscore_option;
+	struct byte_array buf = BYTE_ARRAY_INIT(buf_oscore, buf_oscore_len);
+
+	memset(&packet, 0, sizeof(packet));
+	TRY(coap_deserialize(&buf, &packet));
+	if (!is_request(&packet)) {
+		return wrong_parameter;
+	}
+	TRY(oscore_option_parser(packet.options, packet.options_cnt,
+				 &oscore_option));
+
+	/* The EDHOC option is empty. It is inserted in the order of the 
+	option numbers, unless the request already contains it. */
+	uint8_t pos = 0;
+	while ((pos < packet.options_cnt) &&
+	       (packet.options[pos].option_number < EDHOC)) {
+		pos++;
+	}
+	if ((pos == packet.options_cnt) ||
+	    (EDHOC != packet.options[pos].option_number)) {
+		if (MAX_OPTION_COUNT == packet.options_cnt) {
+			return too_many_options;
+		}
+		for (uint8_t i = packet.options_cnt; i > pos; i--) {
+			packet.options[i] = packet.options[i - 1];
+		}
+		packet.options[pos].len = 0;
+		packet.options[pos].value = NULL;
+		packet.options[pos].option_number = EDHOC;
+		packet.options_cnt++;
+		options_delta_set(packet.options, packet.options_cnt);
+	}
+
+	/* The payload is message_3 followed by the OSCORE payload. The 
+	packet is serialized without payload, which is appended after. */
+	struct byte_array oscore_payload = packet.payload;
+	packet.payload = NULL_ARRAY;
+	uint32_t out_capacity = *buf_out_len;
+	TRY(coap_serialize(&packet, buf_out, buf_out_len));
+
+	uint32_t len = *buf_out_len;
+	if (out_capacity - len < 1 + msg3->len + oscore_payload.len) {
+		return buffer_to_small;
+	}
+	buf_out[len++] = OPTION_PAYLOAD_MARKER;
+	TRY(_memcpy_s(buf_out + len, out_capacity - len, msg3->ptr,
+		      msg3->len));
+	len += msg3->len;
+	TRY(_memcpy_s(buf_out + len, out_capacity - len, oscore_payload.ptr,
+		      oscore_payload.len));
+	*buf_out_len = len + oscore_payload.len;
+
+	PRINT_ARRAY("EDHOC + OSCORE request", buf_out, *buf_out_len);
+	return ok;
+}
+
+enum err oscore_edhoc_request_split(uint8_t *buf_in, uint32_t buf_in_len,
+				    struct byte_array *msg3,
+				    struct byte_array *c_r, uint8_t *buf_oscore,
+				    uint32_t *buf_oscore_len)
+{
+	struct o_coap_packet packet;
+	struct compressed_oscore_option oscore_option;
+	struct byte_array buf = BYTE_ARRAY_INIT(buf_in, buf_in_len);
+
+	PRINT_ARRAY("Input EDHOC + OSCORE request", buf_in, buf_in_len);
+
+	memset(&packet, 0, sizeof(packet));
+	TRY(coap_deserialize(&buf, &packet));
+
+	uint8_t pos = 0;
+	while ((pos < packet.options_cnt) &&
+	       (EDHOC != packet.options[pos].option_number)) {
+		pos++;
+	}
+	if (!is_request(&packet) || (pos == packet.options_cnt)) {
+		return oscore_no_edhoc_option;
+	}
+
+	/* The KID is the OSCORE Sender ID of the initiator, i.e. C_R */
+	TRY(oscore_option_parser(packet.options, packet.options_cnt,
+				 &oscore_option));
+	*c_r = oscore_option.kid;
+
+	uint32_t msg3_len;
+	TRY(bstr_len_get(&packet.payload, &msg3_len));
+	if (msg3_len == packet.payload.len) {
+		return not_valid_input_packet;
+	}
+	msg3->ptr = packet.payload.ptr;
+	msg3->len = msg3_len;
+	packet.payload.ptr += msg3_len;
+	packet.payload.len -= msg3_len;
+
+	/* the OSCORE request is the request without EDHOC option */
+	for (uint8_t i = pos; i + 1 < packet.options_cnt; i++) {
+		packet.options[i] = packet.options[i + 1];
+	}
+	packet.options_cnt--;
+	options_delta_set(packet.options, packet.options_cnt);
+
+	return coap_serialize(&packet, buf_oscore, buf_oscore_len);
+}
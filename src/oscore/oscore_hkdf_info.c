@@ -14,6 +14,9 @@
 #include "oscore/aad.h"
 #include "oscore/oscore_hkdf_info.h"
 
+#include "edhoc/bstr_encode_decode.h"
+
+#include "common/memcpy_s.h"
 #include "common/oscore_edhoc_error.h"
 
 #include "cbor/oscore_info.h"
@@ -32,6 +35,7 @@ output = HKDF(salt, IKM, info, L
      + id: SenderID / RecipientID for keys; empty string for CommonIV
      + alg_aead: AEAD Algorithm
      + type: "Key" / "IV", ascii string without nul-terminator
+       (Group OSCORE additionally uses "SEKey")
      + L: size of key/iv for AEAD alg
          - in bytes
 * https://www.iana.org/assignments/cose/cose.xhtml
@@ -44,17 +48,21 @@ enum err oscore_create_hkdf_info(struct byte_array *id,
 {
 	struct oscore_info info_struct;
 
-	char type_enc[10];
+	char type_enc[12];
 	uint8_t len = 0;
 	switch (type) {
 	case KEY:
-		strncpy(type_enc, "Key", 10);
+		strncpy(type_enc, "Key", sizeof(type_enc));
 		len = 16;
 		break;
 	case IV:
-		strncpy(type_enc, "IV", 10);
+		strncpy(type_enc, "IV", sizeof(type_enc));
 		len = 13;
 		break;
+	case SIGNATURE_ENCRYPTION_KEY:
+		strncpy(type_enc, "SEKey", sizeof(type_enc));
+		len = 16;
+		break;
 	}
 
 	info_struct.oscore_info_id.value = id->ptr;
@@ -86,3 +94,46 @@ enum err oscore_create_hkdf_info(struct byte_array *id,
 	out->len = (uint32_t)payload_len_out;
 	return ok;
 }
+
+/*
+The keystream of the countersignature in Group OSCORE
+KS = HKDF(Signature Encryption Key, Partial IV, info, L)
+* info = CBOR-array [
+     id: bstr,
+     id_context: bstr,
+     type: bool,
+     L: uint,
+  ]
+     + id: Sender ID of the sender of the message
+     + id_context: ID Context (Gid) of the group
+     + type: true for a request, false for a response
+     + L: size of the countersignature in bytes
+*/
+
+/**
+ * @brief   Appends a CBOR byte string to the info.
+ */
+static enum err info_bstr_append(struct byte_array *info, uint32_t size,
+				 const struct byte_array *bstr)
+{
+	TRY(cbor_head_append(info, size, CBOR_MAJOR_TYPE_BSTR, bstr->len));
+	TRY(_memcpy_s(info->ptr + info->len, size - info->len, bstr->ptr,
+		      bstr->len));
+	info->len += bstr->len;
+	return ok;
+}
+
+enum err oscore_create_keystream_info(const struct byte_array *id,
+				      const struct byte_array *id_context,
+				      bool request, uint32_t len,
+				      struct byte_array *out)
+{
+	uint32_t size = out->len;
+	out->len = 0;
+	TRY(cbor_head_append(out, size, CBOR_MAJOR_TYPE_ARRAY, 4));
+	TRY(info_bstr_append(out, size, id));
+	TRY(info_bstr_append(out, size, id_context));
+	TRY(cbor_head_append(out, size, CBOR_MAJOR_TYPE_SIMPLE,
+			     request ? CBOR_SIMPLE_TRUE : CBOR_SIMPLE_FALSE));
+	return cbor_head_append(out, size, CBOR_MAJOR_TYPE_UINT, len);
+}
@@ -14,6 +14,7 @@
 #include <string.h>
 
 #include "oscore/oscore_interactions.h"
+#include "oscore/aad.h"
 #include "common/byte_array.h"
 #include "common/print_util.h"
 
@@ -271,6 +272,36 @@ oscore_interactions_remove_record(struct oscore_interaction_t *interactions,
 	return ok;
 }
 
+enum err oscore_interactions_get_aad(struct oscore_interaction_t *record,
+				     enum AEAD_algorithm aead_alg,
+				     struct byte_array *aad)
+{
+	if ((NULL == record) || (NULL == aad)) {
+		return wrong_parameter;
+	}
+
+	struct byte_array request_piv =
+		BYTE_ARRAY_INIT(record->request_piv, record->request_piv_len);
+	struct byte_array request_kid =
+		BYTE_ARRAY_INIT(record->request_kid, record->request_kid_len);
+
+#ifdef OSCORE_OBSERVE_AAD_CACHE
+	if (0 == record->aad_len) {
+		struct byte_array out =
+			BYTE_ARRAY_INIT(record->aad, sizeof(record->aad));
+		TRY(create_aad(NULL, 0, aead_alg, &request_kid, &request_piv,
+			       &out));
+		record->aad_len = (uint8_t)out.len;
+	}
+
+	aad->ptr = record->aad;
+	aad->len = record->aad_len;
+	return ok;
+#else
+	return create_aad(NULL, 0, aead_alg, &request_kid, &request_piv, aad);
+#endif
+}
+
 enum err oscore_interactions_read_wrapper(
 	enum o_coap_msg msg_type, struct byte_array *token,
 	struct oscore_interaction_t *interactions,
@@ -0,0 +1,229 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stddef.h>
+
+#include "oscore.h"
+
+#include "oscore/oscore_coap.h"
+#include "oscore/oscore_interactions.h"
+#include "oscore/oscore_internal.h"
+#include "oscore/option.h"
+#include "oscore/replay_protection.h"
+#include "oscore/security_context.h"
+
+#include "common/byte_array.h"
+#include "common/oscore_edhoc_error.h"
+
+/* The fields of a packet that are needed to decide if it is worth to be
+ * decrypted */
+struct prefilter_fields {
+	uint8_t code;
+	struct byte_array token;
+	struct o_coap_option oscore_opt;
+	bool oscore_opt_found;
+	bool observe_opt_found;
+	uint32_t payload_len;
+};
+
+/**
+ * @brief Reads an extended option delta or length, see RFC 7252 section 3.1.
+ * @param nibble the 4 bit value from the first byte of the option
+ * @param p the current position, moved behind the extended bytes
+ * @param end the end of the buffer
+ * @param out the value
+ * @return ok or error if the value is reserved or the packet is too short
+ */
+static enum err ext_value_read(uint8_t nibble, uint8_t **p, const uint8_t *end,
+			       uint32_t *out)
+{
+	switch (nibble) {
+	case 13:
+		if (end - *p < 1) {
+			return not_valid_input_packet;
+		}
+		*out = (uint32_t)(**p + 13);
+		*p += 1;
+		break;
+	case 14:
+		if (end - *p < 2) {
+			return not_valid_input_packet;
+		}
+		*out = (uint32_t)((((*p)[0] << 8) | (*p)[1]) + 269);
+		*p += 2;
+		break;
+	case 15:
+		return not_valid_input_packet;
+	default:
+		*out = nibble;
+		break;
+	}
+	return ok;
+}
+
+/**
+ * @brief Walks over the header and the options of a packet without copying
+ *        or storing them. Only the OSCORE and the Observe options are kept.
+ * @param buf the packet
+ * @param buf_len the length of the packet
+ * @param out the fields needed by the prefilter
+ * @return ok or error if the packet is malformed
+ */
+static enum err fields_scan(uint8_t *buf, uint32_t buf_len,
+			    struct prefilter_fields *out)
+{
+	uint8_t *p = buf;
+	const uint8_t *end = buf + buf_len;
+
+	if (buf_len < HEADER_LEN) {
+		return not_valid_input_packet;
+	}
+	uint8_t tkl = (buf[0] & HEADER_TKL_MASK) >> HEADER_TKL_OFFSET;
+	out->code = buf[1];
+	p += HEADER_LEN;
+	if ((tkl > 8) || (end - p < tkl)) {
+		return oscore_inpkt_invalid_tkl;
+	}
+	out->token.ptr = (0 == tkl) ? NULL : p;
+	out->token.len = tkl;
+	p += tkl;
+
+	out->oscore_opt_found = false;
+	out->observe_opt_found = false;
+	out->payload_len = 0;
+
+	uint32_t option_number = 0;
+	while (p < end) {
+		if (OPTION_PAYLOAD_MARKER == *p) {
+			p++;
+			if (p == end) {
+				return not_valid_input_packet;
+			}
+			out->payload_len = (uint32_t)(end - p);
+			return ok;
+		}
+
+		uint8_t delta_nibble = (uint8_t)((*p & 0xF0) >> 4);
+		uint8_t len_nibble = (uint8_t)(*p & 0x0F);
+		p++;
+
+		uint32_t delta, len;
+		TRY(ext_value_read(delta_nibble, &p, end, &delta));
+		TRY(ext_value_read(len_nibble, &p, end, &len));
+		if ((uint32_t)(end - p) < len) {
+			return not_valid_input_packet;
+		}
+
+		option_number += delta;
+		if (OSCORE == option_number) {
+			if (out->oscore_opt_found) {
+				return not_valid_input_packet;
+			}
+			out->oscore_opt.option_number = OSCORE;
+			out->oscore_opt.len = (uint16_t)len;
+			out->oscore_opt.value = (0 == len) ? NULL : p;
+			out->oscore_opt_found = true;
+		} else if (OBSERVE == option_number) {
+			out->observe_opt_found = true;
+		}
+		p += len;
+	}
+	return ok;
+}
+
+/**
+ * @brief Checks that the fields announced in the first byte of the OSCORE 
+ *        option value fit into the option, so that the option can be parsed 
+ *        safely.
+ * @param opt the OSCORE option
+ * @return ok or not_valid_input_packet
+ */
+static enum err oscore_option_bounds_check(const struct o_coap_option *opt)
+{
+	if (0 == opt->len) {
+		return ok;
+	}
+	uint32_t required = 1 + (opt->value[0] & COMP_OSCORE_OPT_PIV_N_MASK);
+	if (opt->value[0] & COMP_OSCORE_OPT_KIDC_H_MASK) {
+		if (opt->len <= required) {
+			return not_valid_input_packet;
+		}
+		required += 1 + (uint32_t)opt->value[required];
+	}
+	if (required > opt->len) {
+		return not_valid_input_packet;
+	}
+	return ok;
+}
+
+enum err oscore_prefilter(uint8_t *buf_in, uint32_t buf_in_len,
+			  struct context *c)
+{
+	if ((NULL == buf_in) || (NULL == c)) {
+		return wrong_parameter;
+	}
+
+	struct prefilter_fields f;
+	TRY(fields_scan(buf_in, buf_in_len, &f));
+	if (!f.oscore_opt_found) {
+		return not_oscore_pkt;
+	}
+	/* The ciphertext contains at least the code and the tag */
+	if (f.payload_len <= AUTH_TAG_LEN) {
+		return not_valid_input_packet;
+	}
+	if ((f.payload_len - AUTH_TAG_LEN) > MAX_PLAINTEXT_LEN) {
+		return buffer_to_small;
+	}
+
+	struct compressed_oscore_option oscore_option;
+	TRY(oscore_option_bounds_check(&f.oscore_opt));
+	TRY(oscore_option_parser(&f.oscore_opt, 1, &oscore_option));
+
+	if ((CODE_CLASS_MASK & f.code) == REQUEST_CLASS) {
+		/* a request is always protected with its own PIV */
+		if (0 == oscore_option.piv.len) {
+			return oscore_inpkt_invalid_piv;
+		}
+		if (!array_equals(&c->rc.recipient_id, &oscore_option.kid)) {
+			return oscore_kid_recipient_id_mismatch;
+		}
+		/* While the replay window is not synchronized (after a
+		 * reboot) the request is handled by the Echo procedure */
+		if (ECHO_SYNCHRONIZED == c->rrc.echo_state_machine) {
+			uint64_t ssn;
+			TRY(piv2ssn(&oscore_option.piv, &ssn));
+			if (!server_is_sequence_number_valid(
+				    ssn, &c->rc.replay_window)) {
+				return oscore_replay_window_protection_error;
+			}
+		}
+		return ok;
+	}
+
+	/* a response must belong to a request of this context */
+	struct oscore_interaction_t *record;
+	TRY(oscore_interactions_get_record(c->rrc.interactions, f.token.ptr,
+					   (uint8_t)f.token.len, &record));
+
+	if (f.observe_opt_found) {
+		if (0 != oscore_option.piv.len) {
+			TRY(replay_protection_check_notification(
+				record->notification_num,
+				record->notification_num_initialized,
+				&oscore_option.piv));
+		} else if (record->notification_num_initialized ||
+			   record->piv_less_notification_received) {
+			return oscore_replay_notification_protection_error;
+		}
+	}
+	return ok;
+}
@@ -0,0 +1,90 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "oscore.h"
+
+#include "oscore/oscore_coap.h"
+#include "oscore/option.h"
+#include "oscore/oscore_internal.h"
+#include "oscore/security_context.h"
+
+#include "common/byte_array.h"
+#include "common/oscore_edhoc_error.h"
+#include "common/memcpy_s.h"
+#include "common/print_util.h"
+
+enum err oscore_reprotect(uint8_t *buf_in, uint32_t buf_in_len,
+			  uint8_t *buf_out, uint32_t *buf_out_len,
+			  struct context *c_in, struct context *c_out)
+{
+	struct o_coap_packet oscore_packet;
+	struct compressed_oscore_option oscore_option;
+	struct byte_array buf = BYTE_ARRAY_INIT(buf_in, buf_in_len);
+
+	PRINT_MSG("\n\n\noscore_reprotect**********************************\n");
+	PRINT_ARRAY("Input OSCORE packet", buf_in, buf_in_len);
+
+	/* Both legs must be fresh enough to process the message. */
+	TRY(check_context_freshness(c_in));
+	TRY(check_context_freshness(c_out));
+
+	/* The packet is deserialized only once, all later stages operate on 
+	pointers into buf_in. */
+	memset(&oscore_packet, 0, sizeof(oscore_packet));
+	TRY(coap_deserialize(&buf, &oscore_packet));
+
+	/* Messaging layer packets (simple ACK, code=0.00) are not protected on 
+	any leg, see section 4.2 in RFC8613. Forward them as they are. */
+	if ((TYPE_ACK == oscore_packet.header.type) &&
+	    (CODE_EMPTY == oscore_packet.header.code)) {
+		PRINT_MSG("Messaging Layer CoAP packet detected, forwarded\n");
+		*buf_out_len = buf_in_len;
+		return _memcpy_s(buf_out, buf_in_len, buf_in, buf_in_len);
+	}
+
+	TRY(oscore_option_parser(oscore_packet.options,
+				 oscore_packet.options_cnt, &oscore_option));
+
+	/* Verify and decrypt with the inbound context. The resulting plaintext 
+	is exactly the plaintext of the outbound message, since the inner 
+	options, the code and the payload are forwarded unchanged. */
+	TRY(check_buffer_size(oscore_packet.payload.len, AUTH_TAG_LEN));
+	uint32_t plaintext_len = oscore_packet.payload.len - AUTH_TAG_LEN;
+	BYTE_ARRAY_NEW(plaintext, MAX_PLAINTEXT_LEN, plaintext_len);
+	struct o_coap_packet coap_packet;
+	TRY(oscore_packet_unprotect(&oscore_packet, &oscore_option, &plaintext,
+				    &coap_packet, c_in));
+
+	/* The outer (Class U) options are carried over as they are, only the 
+	OSCORE option is replaced by the one of the outbound context. */
+	struct o_coap_option u_options[MAX_OPTION_COUNT];
+	uint8_t u_options_cnt = 0;
+	for (uint8_t i = 0; i < oscore_packet.options_cnt; i++) {
+		if (OSCORE != oscore_packet.options[i].option_number) {
+			u_options[u_options_cnt++] = oscore_packet.options[i];
+		}
+	}
+
+	/* Encrypt the same plaintext with the outbound context. */
+	BYTE_ARRAY_NEW(ciphertext, MAX_CIPHERTEXT_LEN,
+		       plaintext.len + AUTH_TAG_LEN);
+	struct oscore_option out_oscore_option;
+	struct o_coap_packet out_oscore_packet;
+	TRY(oscore_packet_protect(&coap_packet, coap_packet.options,
+				  coap_packet.options_cnt, u_options,
+				  u_options_cnt, &plaintext, &ciphertext,
+				  &out_oscore_option, &out_oscore_packet, c_out));
+
+	return coap_serialize(&out_oscore_packet, buf_out, buf_out_len);
+}
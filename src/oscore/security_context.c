@@ -27,19 +27,9 @@
 #include "common/oscore_edhoc_error.h"
 #include "common/memcpy_s.h"
 #include "common/print_util.h"
-#include "common/unit_test.h"
 
-/**
- * @brief       Common derive procedure used to derive the Common IV and 
- *              Sender / Recipient Keys
- * @param cc    pointer to the common context
- * @param id    empty array for Common IV, sender / recipient ID for keys
- * @param type  IV for Common IV, KEY for Sender / Recipient Keys
- * @param out   out-array. Must be initialized
- * @return      err
- */
-STATIC enum err derive(struct common_context *cc, struct byte_array *id,
-		       enum derive_type type, struct byte_array *out)
+enum err derive(struct common_context *cc, struct byte_array *id,
+		enum derive_type type, struct byte_array *out)
 {
 	BYTE_ARRAY_NEW(info, MAX_INFO_LEN, MAX_INFO_LEN);
 	TRY(oscore_create_hkdf_info(id, &cc->id_context, cc->aead_alg, type,
@@ -101,10 +91,17 @@ static enum err derive_recipient_key(struct common_context *cc,
 	return ok;
 }
 
-enum err oscore_context_init(struct oscore_init_params *params,
-			     struct context *c)
+/**
+ * @brief    Sets up a context except the Common IV and the keys, which are
+ *           derived afterwards
+ * @param    params the initialization parameters
+ * @param    c the context
+ * @return   err
+ */
+static enum err context_setup(struct oscore_init_params *params,
+			      struct context *c)
 {
-	/*derive common context************************************************/
+	/*set up common context************************************************/
 
 	if (params->aead_alg != OSCORE_AES_CCM_16_64_128) {
 		return oscore_invalid_algorithm_aead;
@@ -125,10 +122,8 @@ enum err oscore_context_init(struct oscore_init_params *params,
 	c->cc.id_context = params->id_context;
 	c->cc.common_iv.len = sizeof(c->cc.common_iv_buf);
 	c->cc.common_iv.ptr = c->cc.common_iv_buf;
-	TRY(derive_common_iv(&c->cc));
 
-	/*derive Recipient Context*********************************************/
-	c->rc.notification_num_initialized = false;
+	/*set up Recipient Context*********************************************/
 	server_replay_window_init(&c->rc.replay_window);
 	c->rc.recipient_id.len = params->recipient_id.len;
 	c->rc.recipient_id.ptr = c->rc.recipient_id_buf;
@@ -136,10 +131,14 @@ enum err oscore_context_init(struct oscore_init_params *params,
 	       params->recipient_id.len);
 	c->rc.recipient_key.len = sizeof(c->rc.recipient_key_buf);
 	c->rc.recipient_key.ptr = c->rc.recipient_key_buf;
-	TRY(derive_recipient_key(&c->cc, &c->rc));
 
-	/*derive Sender Context************************************************/
-	c->sc.sender_id = params->sender_id;
+	/*set up Sender Context************************************************/
+	/* copied, so that the ID may be released after the initialization, 
+	e.g. the connection identifier of a finished EDHOC session */
+	TRY(_memcpy_s(c->sc.sender_id_buf, sizeof(c->sc.sender_id_buf),
+		      params->sender_id.ptr, params->sender_id.len));
+	c->sc.sender_id.len = params->sender_id.len;
+	c->sc.sender_id.ptr = c->sc.sender_id_buf;
 	c->sc.sender_key.len = sizeof(c->sc.sender_key_buf);
 	c->sc.sender_key.ptr = c->sc.sender_key_buf;
 	struct nvm_key_t nvm_key = { .sender_id = c->sc.sender_id,
@@ -147,7 +146,6 @@ enum err oscore_context_init(struct oscore_init_params *params,
 				     .id_context = c->cc.id_context };
 
 	TRY(ssn_init(&nvm_key, &c->sc.ssn, params->fresh_master_secret_salt));
-	TRY(derive_sender_key(&c->cc, &c->sc));
 
 	/*set up the request response context**********************************/
 	oscore_interactions_init(c->rrc.interactions);
@@ -164,6 +162,81 @@ enum err oscore_context_init(struct oscore_init_params *params,
 	return ok;
 }
 
+enum err oscore_context_init(struct oscore_init_params *params,
+			     struct context *c)
+{
+	TRY(context_setup(params, c));
+	TRY(derive_common_iv(&c->cc));
+	TRY(derive_recipient_key(&c->cc, &c->rc));
+	TRY(derive_sender_key(&c->cc, &c->sc));
+	return ok;
+}
+
+/**
+ * @brief    Prepares the derivation of the Common IV or a key as a job of
+ *           hkdf_sha_256_multi()
+ * @param    cc the common context
+ * @param    id the Sender or Recipient ID, empty for the Common IV
+ * @param    type KEY or IV
+ * @param    info buffer for the info structure
+ * @param    out the derived value
+ * @param    job the job
+ * @return   err
+ */
+static enum err derive_job_set(struct common_context *cc,
+			       struct byte_array *id, enum derive_type type,
+			       struct byte_array *info, struct byte_array *out,
+			       struct hkdf_sha_256_job *job)
+{
+	if (cc->kdf != OSCORE_SHA_256) {
+		return oscore_unknown_hkdf;
+	}
+	TRY(oscore_create_hkdf_info(id, &cc->id_context, cc->aead_alg, type,
+				    info));
+	job->master_secret = &cc->master_secret;
+	job->master_salt = &cc->master_salt;
+	job->info = info;
+	job->out = out;
+	return ok;
+}
+
+enum err oscore_contexts_init(struct oscore_init_params *params,
+			      struct context *c, uint32_t n)
+{
+	/*the Common IV, the Recipient Key and the Sender Key of each context*/
+	BYTE_ARRAY_NEW(info_buf, 3 * OSCORE_CONTEXT_INIT_BATCH * MAX_INFO_LEN,
+		       3 * OSCORE_CONTEXT_INIT_BATCH * MAX_INFO_LEN);
+	struct byte_array info[3 * OSCORE_CONTEXT_INIT_BATCH];
+	struct hkdf_sha_256_job jobs[3 * OSCORE_CONTEXT_INIT_BATCH];
+
+	for (uint32_t i = 0; i < n; i += OSCORE_CONTEXT_INIT_BATCH) {
+		uint32_t m = n - i;
+		if (m > OSCORE_CONTEXT_INIT_BATCH) {
+			m = OSCORE_CONTEXT_INIT_BATCH;
+		}
+		for (uint32_t k = 0; k < m; k++) {
+			struct context *x = &c[i + k];
+			for (uint32_t j = 3 * k; j < 3 * k + 3; j++) {
+				info[j].ptr = info_buf.ptr + j * MAX_INFO_LEN;
+				info[j].len = MAX_INFO_LEN;
+			}
+			TRY(context_setup(&params[i + k], x));
+			TRY(derive_job_set(&x->cc, &EMPTY_ARRAY, IV,
+					   &info[3 * k], &x->cc.common_iv,
+					   &jobs[3 * k]));
+			TRY(derive_job_set(&x->cc, &x->rc.recipient_id, KEY,
+					   &info[3 * k + 1],
+					   &x->rc.recipient_key,
+					   &jobs[3 * k + 1]));
+			TRY(derive_job_set(&x->cc, &x->sc.sender_id, KEY,
+					   &info[3 * k + 2], &x->sc.sender_key,
+					   &jobs[3 * k + 2]));
+		}
+		TRY(hkdf_sha_256_multi(jobs, 3 * m));
+	}
+	return ok;
+}
+
 enum err check_context_freshness(struct context *c)
 {
 	if (NULL == c) {
@@ -0,0 +1,73 @@
+#!/usr/bin/python3
+
+# Computes the worst case stack usage of the API functions from the call graph
+# information written by GCC (-fcallgraph-info=su), without running the code.
+# Only the frames of the compiled files are counted: calls of functions that
+# are not compiled, e.g. of the crypto engine, count as 0 bytes and recursion
+# is not followed.
+#
+# usage, from the root directory of the repository:
+# for f in src/common/*.c src/edhoc/*.c src/oscore/*.c; do
+#     gcc <flags of the configuration> -fcallgraph-info=su -c $f \
+#         -o build_ci/$(basename $f .c).o -dumpbase build_ci/$(basename $f .c)
+# done
+# ./test/ci_scripts/stack_callgraph.py build_ci
+
+import glob
+import re
+import sys
+
+FUNCTIONS = [
+    "msg1_gen", "msg2_gen", "msg3_gen", "msg3_process", "msg4_gen",
+    "msg4_process", "edhoc_initiator_session_step",
+    "edhoc_responder_session_step", "coap2oscore", "oscore2coap",
+    "coap2oscore_group", "oscore2coap_group", "coap2oscore_batch",
+    "oscore_contexts_init"
+]
+
+NODE = re.compile(r'node: \{ title: "([^"]+)" label: "[^"]*?(\d+) bytes')
+EDGE = re.compile(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+
+
+def load(directory):
+    frames = {}
+    calls = {}
+    for name in glob.glob(directory + "/*.ci"):
+        with open(name) as f:
+            for line in f:
+                m = NODE.match(line)
+                if m:
+                    frames[m.group(1)] = int(m.group(2))
+                m = EDGE.match(line)
+                if m:
+                    calls.setdefault(m.group(1), set()).add(m.group(2))
+    return frames, calls
+
+
+def worst(frames, calls, function, memo, active):
+    if function in memo:
+        return memo[function]
+    if function in active:
+        return 0
+    active.add(function)
+    deepest = 0
+    for callee in calls.get(function, ()):
+        deepest = max(deepest, worst(frames, calls, callee, memo, active))
+    active.discard(function)
+    memo[function] = frames.get(function, 0) + deepest
+    return memo[function]
+
+
+def main():
+    for directory in sys.argv[1:]:
+        frames, calls = load(directory)
+        memo = {}
+        print(directory)
+        for function in FUNCTIONS:
+            if function in frames:
+                print("  %-32s %6d bytes" %
+                      (function, worst(frames, calls, function, memo, set())))
+
+
+if __name__ == "__main__":
+    main()
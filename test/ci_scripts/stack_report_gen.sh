@@ -38,3 +38,17 @@ gdb --batch -ex 'py arg_flags="-DMESSAGE_4 -DTINYCRYPT"' -x ci_scripts/stack_wat
 rm -rf build
 west build -b native_sim/native/64 -- -DCOMMAND_LINE_FLAGS="-DMESSAGE_4 -DMBEDTLS"
 gdb --batch -ex 'py arg_flags="-DMESSAGE_4 -DMBEDTLS"' -x ci_scripts/stack_watch.py
+
+# TINYCRYPT     YES
+# MESSAGE_4:    YES
+# WORKSPACE:    YES
+rm -rf build
+west build -b native_sim/native/64 -- -DCOMMAND_LINE_FLAGS="-DWORKSPACE -DMESSAGE_4 -DTINYCRYPT"
+gdb --batch -ex 'py arg_flags="-DWORKSPACE -DMESSAGE_4 -DTINYCRYPT"' -x ci_scripts/stack_watch.py
+
+# MBEDTLS     YES
+# MESSAGE_4:    YES
+# WORKSPACE:    YES
+rm -rf build
+west build -b native_sim/native/64 -- -DCOMMAND_LINE_FLAGS="-DWORKSPACE -DMESSAGE_4 -DMBEDTLS"
+gdb --batch -ex 'py arg_flags="-DWORKSPACE -DMESSAGE_4 -DMBEDTLS"' -x ci_scripts/stack_watch.py
@@ -30,3 +30,45 @@ west build -t run
 rm -rf build
 west build -b native_sim -- -DCOMMAND_LINE_FLAGS="-DASAN " -DCONFIG_ASAN=y
 west build -t run
+
+# SANITIZER:    YES
+# MESSAGE_4:    YES
+# WORKSPACE:    YES
+rm -rf build
+west build -b native_sim -- -DCOMMAND_LINE_FLAGS="-DWORKSPACE -DASAN -DMESSAGE_4" -DCONFIG_ASAN=y
+west build -t run
+
+# SANITIZER:    YES
+# MESSAGE_4:    No
+# EPHEMERAL_KEY_POOL: YES
+rm -rf build
+west build -b native_sim -- -DCOMMAND_LINE_FLAGS="-DEPHEMERAL_KEY_POOL -DASAN " -DCONFIG_ASAN=y
+west build -t run
+
+# SANITIZER:    YES
+# MESSAGE_4:    No
+# CURVE25519_64: YES (needs a 64-bit target for unsigned __int128)
+rm -rf build
+west build -b native_sim/native/64 -- -DCOMMAND_LINE_FLAGS="-DCURVE25519_64 -DASAN " -DCONFIG_ASAN=y
+west build -t run
+
+# SANITIZER:    YES
+# MESSAGE_4:    No
+# AES_CCM_HW:   YES
+rm -rf build
+west build -b native_sim -- -DCOMMAND_LINE_FLAGS="-DAES_CCM_HW -DASAN " -DCONFIG_ASAN=y
+west build -t run
+
+# SANITIZER:    YES
+# MESSAGE_4:    No
+# SHA256_HW:    YES
+rm -rf build
+west build -b native_sim -- -DCOMMAND_LINE_FLAGS="-DSHA256_HW -DASAN " -DCONFIG_ASAN=y
+west build -t run
+
+# SANITIZER:    YES
+# MESSAGE_4:    YES
+# EDHOC_KDF_HKDF_EXPAND: YES
+rm -rf build
+west build -b native_sim -- -DCOMMAND_LINE_FLAGS="-DEDHOC_KDF_HKDF_EXPAND -DASAN -DMESSAGE_4" -DCONFIG_ASAN=y
+west build -t run
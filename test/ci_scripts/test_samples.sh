@@ -24,3 +24,6 @@ $MAKE -C "$SAMPLES_DIR/linux_edhoc_oscore/initiator_client" -j
 
 rm -rf "$SAMPLES_DIR/linux_edhoc_oscore/responder_server/build"
 $MAKE -C "$SAMPLES_DIR/linux_edhoc_oscore/responder_server" -j
+
+rm -rf "$SAMPLES_DIR/linux_edhoc_benchmark/build"
+$MAKE -C "$SAMPLES_DIR/linux_edhoc_benchmark" -j
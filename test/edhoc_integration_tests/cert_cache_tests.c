@@ -0,0 +1,105 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <zephyr/ztest.h>
+
+#include "edhoc.h"
+#include "edhoc/buffer_sizes.h"
+#include "edhoc/cert_cache.h"
+
+static uint32_t fake_time;
+
+static uint32_t fake_now(void)
+{
+	return fake_time;
+}
+
+void t_edhoc_cert_cache(void)
+{
+	struct cert_cache_entry entries[2];
+	struct cert_cache cache;
+	struct cert_cache_key k;
+	struct cred_array ca_set = { .len = 0, .ptr = NULL };
+	struct cred_array other_ca_set = { .len = 0, .ptr = NULL };
+
+	const uint8_t cert_a_buf[] = { 0x30, 0x01, 0x0a };
+	const uint8_t cert_b_buf[] = { 0x30, 0x01, 0x0b };
+	const uint8_t cert_c_buf[] = { 0x30, 0x01, 0x0c };
+	struct const_byte_array cert_a = { .len = sizeof(cert_a_buf),
+					   .ptr = cert_a_buf };
+	struct const_byte_array cert_b = { .len = sizeof(cert_b_buf),
+					   .ptr = cert_b_buf };
+	struct const_byte_array cert_c = { .len = sizeof(cert_c_buf),
+					   .ptr = cert_c_buf };
+
+	uint8_t pk_a_buf[P_256_PUB_KEY_X_CORD_SIZE];
+	memset(pk_a_buf, 0xaa, sizeof(pk_a_buf));
+	struct byte_array pk_a = BYTE_ARRAY_INIT(pk_a_buf, sizeof(pk_a_buf));
+
+	uint8_t key_buf[PK_SIZE];
+	struct byte_array key = BYTE_ARRAY_INIT(key_buf, sizeof(key_buf));
+
+	cert_cache_init(&cache, entries, 2, 100);
+	cache.base.now = fake_now;
+	fake_time = 0xfffffff0; /* the time wraps around during the test */
+
+	/* without a registered cache nothing is cached */
+	cert_cache_register(NULL);
+	zassert_false(cert_cache_get(&cert_a, &ca_set, false, &k, &key),
+		      "hit without a cache");
+	zassert_false(k.valid, "digest without a cache");
+
+	cert_cache_register(&cache);
+	zassert_false(cert_cache_get(&cert_a, &ca_set, false, &k, &key),
+		      "hit in an empty cache");
+	cert_cache_put(&k, &ca_set, false, &pk_a);
+
+	key.len = sizeof(key_buf);
+	zassert_true(cert_cache_get(&cert_a, &ca_set, false, &k, &key),
+		     "no hit");
+	zassert_equal(key.len, pk_a.len, "wrong key length");
+	zassert_mem_equal__(key.ptr, pk_a.ptr, pk_a.len, "wrong key");
+
+	/* the entry is valid only for the same CA set and key type */
+	zassert_false(cert_cache_get(&cert_a, &other_ca_set, false, &k, &key),
+		      "hit with another CA set");
+	zassert_false(cert_cache_get(&cert_a, &ca_set, true, &k, &key),
+		      "hit with another key type");
+	zassert_false(cert_cache_get(&cert_b, &ca_set, false, &k, &key),
+		      "hit with another certificate");
+
+	/* ttl */
+	fake_time += 99;
+	key.len = sizeof(key_buf);
+	zassert_true(cert_cache_get(&cert_a, &ca_set, false, &k, &key),
+		     "expired too early");
+	fake_time += 1;
+	zassert_false(cert_cache_get(&cert_a, &ca_set, false, &k, &key),
+		      "not expired");
+
+	/* a full cache replaces entries */
+	cert_cache_get(&cert_a, &ca_set, false, &k, &key);
+	cert_cache_put(&k, &ca_set, false, &pk_a);
+	cert_cache_get(&cert_b, &ca_set, false, &k, &key);
+	cert_cache_put(&k, &ca_set, false, &pk_a);
+	cert_cache_get(&cert_c, &ca_set, false, &k, &key);
+	cert_cache_put(&k, &ca_set, false, &pk_a);
+	key.len = sizeof(key_buf);
+	zassert_true(cert_cache_get(&cert_c, &ca_set, false, &k, &key),
+		     "new entry not stored");
+
+	/* invalidation after a change of the CA set */
+	cert_cache_invalidate(&cache);
+	zassert_false(cert_cache_get(&cert_c, &ca_set, false, &k, &key),
+		      "hit after invalidation");
+
+	cert_cache_register(NULL);
+}
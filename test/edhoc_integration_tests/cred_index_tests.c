@@ -0,0 +1,104 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <zephyr/ztest.h>
+
+#include "edhoc.h"
+#include "edhoc/buffer_sizes.h"
+#include "edhoc/cred_index.h"
+#include "edhoc/retrieve_cred.h"
+
+#define CRED_INDEX_TEST_CREDS 1000
+
+/* ID_CRED_x = {4: h'xxxx'} */
+#define KID_ID_CRED_LEN 5
+
+static uint8_t id_creds[CRED_INDEX_TEST_CREDS][KID_ID_CRED_LEN];
+static uint8_t pks[CRED_INDEX_TEST_CREDS][P_256_PUB_KEY_UNCOMPRESSED_SIZE];
+static struct other_party_cred creds[CRED_INDEX_TEST_CREDS];
+static uint32_t table[2 * 1024];
+
+static void kid_id_cred_set(uint8_t *id_cred, uint32_t kid)
+{
+	id_cred[0] = 0xa1; /*map(1)*/
+	id_cred[1] = 0x04; /*kid*/
+	id_cred[2] = 0x42; /*bstr(2)*/
+	id_cred[3] = (uint8_t)(kid >> 8);
+	id_cred[4] = (uint8_t)kid;
+}
+
+void t_edhoc_cred_index(void)
+{
+	enum err r;
+	struct cred_index idx;
+	struct cred_array cred_array = { .len = CRED_INDEX_TEST_CREDS,
+					 .ptr = creds };
+	const struct other_party_cred *found;
+
+	for (uint32_t i = 0; i < CRED_INDEX_TEST_CREDS; i++) {
+		kid_id_cred_set(id_creds[i], i);
+		memset(pks[i], (int)i, sizeof(pks[i]));
+		creds[i].id_cred.ptr = id_creds[i];
+		creds[i].id_cred.len = KID_ID_CRED_LEN;
+		creds[i].cred.ptr = id_creds[i];
+		creds[i].cred.len = KID_ID_CRED_LEN;
+		creds[i].pk.ptr = pks[i];
+		creds[i].pk.len = sizeof(pks[i]);
+		creds[i].g.ptr = NULL;
+		creds[i].g.len = 0;
+	}
+
+	r = cred_index_build(&idx, &cred_array, table, 1000);
+	zassert_equal(r, wrong_parameter, "table_len not a power of two");
+	r = cred_index_build(&idx, &cred_array, table, 512);
+	zassert_equal(r, cred_index_too_small, "table too small");
+
+	r = cred_index_build(&idx, &cred_array, table,
+			     sizeof(table) / sizeof(table[0]));
+	zassert_equal(r, ok, "Error in cred_index_build");
+	zassert_equal_ptr(cred_array.index, &idx, "index not assigned");
+
+	for (uint32_t i = 0; i < CRED_INDEX_TEST_CREDS; i++) {
+		r = cred_index_find(&idx, &creds[i].id_cred, &found);
+		zassert_equal(r, ok, "Error in cred_index_find");
+		zassert_equal_ptr(found, &creds[i], "wrong credential");
+	}
+
+	uint8_t unknown_buf[KID_ID_CRED_LEN];
+	kid_id_cred_set(unknown_buf, CRED_INDEX_TEST_CREDS);
+	struct byte_array unknown = BYTE_ARRAY_INIT(unknown_buf,
+						    sizeof(unknown_buf));
+	r = cred_index_find(&idx, &unknown, &found);
+	zassert_equal(r, credential_not_found, "unknown credential found");
+
+	/* retrieve_cred uses the index */
+	uint8_t cred_buf[CRED_I_SIZE];
+	uint8_t pk_buf[PK_SIZE];
+	uint8_t g_buf[G_I_SIZE];
+	struct byte_array cred = BYTE_ARRAY_INIT(cred_buf, sizeof(cred_buf));
+	struct byte_array pk = BYTE_ARRAY_INIT(pk_buf, sizeof(pk_buf));
+	struct byte_array g = BYTE_ARRAY_INIT(g_buf, sizeof(g_buf));
+	r = retrieve_cred(false, &cred_array,
+			  &creds[CRED_INDEX_TEST_CREDS - 1].id_cred, &cred, &pk,
+			  &g);
+	zassert_equal(r, ok, "Error in retrieve_cred");
+	zassert_mem_equal__(pk.ptr, pks[CRED_INDEX_TEST_CREDS - 1], pk.len,
+			    "wrong public key");
+
+	/* a duplicated ID_CRED_x results in the first credential */
+	kid_id_cred_set(id_creds[1], 0);
+	r = cred_index_build(&idx, &cred_array, table,
+			     sizeof(table) / sizeof(table[0]));
+	zassert_equal(r, ok, "Error in cred_index_build");
+	r = cred_index_find(&idx, &creds[1].id_cred, &found);
+	zassert_equal(r, ok, "Error in cred_index_find");
+	zassert_equal_ptr(found, &creds[0], "not the first credential");
+}
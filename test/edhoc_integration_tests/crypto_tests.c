@@ -0,0 +1,601 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "common/crypto_wrapper.h"
+#include "common/crypto_provider.h"
+#include "common/print_util.h"
+
+#ifdef AES_CCM_HW
+void t_crypto_aes_ccm_hw(void)
+{
+	enum err r;
+	/*payload sizes from an empty OSCORE request up to a large block, with
+	and without a partial last block*/
+	const uint32_t sizes[] = { 0, 1, 15, 16, 17, 64, 100, 256, 1023 };
+	static uint8_t pt_buf[1023];
+	static uint8_t ct1_buf[1023 + 16];
+	static uint8_t ct2_buf[1023 + 16];
+	static uint8_t dec_buf[1023];
+	uint8_t tag_buf[16];
+	uint8_t key_buf[16];
+	uint8_t nonce_buf[AEAD_IV_SIZE];
+	uint8_t aad_buf[20];
+	struct crypto_key k;
+
+	if (!aes_ccm_hw_available()) {
+		PRINT_MSG("no AES instructions, test skipped\n");
+		return;
+	}
+
+	for (uint32_t i = 0; i < sizeof(pt_buf); i++) {
+		pt_buf[i] = (uint8_t)(i * 7);
+	}
+	for (uint32_t i = 0; i < sizeof(key_buf); i++) {
+		key_buf[i] = (uint8_t)(0xc0 + i);
+	}
+	for (uint32_t i = 0; i < sizeof(nonce_buf); i++) {
+		nonce_buf[i] = (uint8_t)(0xa0 + i);
+	}
+	for (uint32_t i = 0; i < sizeof(aad_buf); i++) {
+		aad_buf[i] = (uint8_t)i;
+	}
+
+	struct byte_array key = BYTE_ARRAY_INIT(key_buf, sizeof(key_buf));
+	struct byte_array nonce = BYTE_ARRAY_INIT(nonce_buf, sizeof(nonce_buf));
+	struct byte_array aad = BYTE_ARRAY_INIT(aad_buf, sizeof(aad_buf));
+
+	r = crypto_key_import(AES_CCM_16_64_128, &key, &k);
+	zassert_equal(r, ok, "Error in crypto_key_import");
+	zassert_equal(k.provider, &crypto_provider_aes_ccm_hw,
+		      "AES instructions not used");
+
+	for (uint32_t t = 8; t <= 16; t += 8) {
+		for (uint32_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]);
+		     i++) {
+			uint32_t n = sizes[i];
+			struct byte_array pt = BYTE_ARRAY_INIT(pt_buf, n);
+			struct byte_array ct1 = BYTE_ARRAY_INIT(ct1_buf, n);
+			struct byte_array ct2 = BYTE_ARRAY_INIT(ct2_buf, n);
+			struct byte_array tag1 =
+				BYTE_ARRAY_INIT(ct1_buf + n, t);
+			struct byte_array tag2 =
+				BYTE_ARRAY_INIT(ct2_buf + n, t);
+
+			/* the kernel computes the result of the engine */
+			r = crypto_provider_builtin.aead(ENCRYPT, &pt, &key,
+							 &nonce, &aad, &ct1,
+							 &tag1);
+			zassert_equal(r, ok, "Error in aead");
+			r = crypto_provider_aes_ccm_hw.aead(ENCRYPT, &pt, &key,
+							    &nonce, &aad, &ct2,
+							    &tag2);
+			zassert_equal(r, ok, "Error in aead");
+			zassert_mem_equal__(ct1_buf, ct2_buf, n + t,
+					    "wrong ciphertext");
+
+			/* with a separate tag buffer the tag is still written
+			after the ciphertext, as callers like ciphertext_gen()
+			expect */
+			struct byte_array tag3 = BYTE_ARRAY_INIT(tag_buf, t);
+			memset(ct2_buf, 0, sizeof(ct2_buf));
+			memset(tag_buf, 0, sizeof(tag_buf));
+			r = aead(ENCRYPT, &pt, &key, &nonce, &aad, &ct2,
+				 &tag3);
+			zassert_equal(r, ok, "Error in aead");
+			zassert_mem_equal__(ct1_buf, ct2_buf, n + t,
+					    "wrong ciphertext");
+			zassert_mem_equal__(ct1_buf + n, tag_buf, t,
+					    "wrong tag");
+
+			/* the prepared key gives the same result */
+			r = aead_with_key(ENCRYPT, &k, &pt, &nonce, &aad,
+					  &ct2, &tag2);
+			zassert_equal(r, ok, "Error in aead_with_key");
+			zassert_mem_equal__(ct1_buf, ct2_buf, n + t,
+					    "wrong ciphertext");
+
+			/* decryption of ciphertext followed by the tag */
+			struct byte_array in = BYTE_ARRAY_INIT(ct2_buf, n + t);
+			struct byte_array dec = BYTE_ARRAY_INIT(dec_buf, n);
+			r = aead_with_key(DECRYPT, &k, &in, &nonce, &aad,
+					  &dec, &tag2);
+			zassert_equal(r, ok, "Error in aead_with_key");
+			zassert_mem_equal__(pt_buf, dec_buf, n,
+					    "wrong plaintext");
+
+			/* a modified tag is rejected */
+			ct2_buf[n + t - 1] ^= 1;
+			r = aead_with_key(DECRYPT, &k, &in, &nonce, &aad,
+					  &dec, &tag2);
+			zassert_equal(r, unexpected_result_from_ext_lib,
+				      "modified tag accepted");
+		}
+	}
+	crypto_key_release(&k);
+}
+#endif
+
+void t_crypto_aes_ccm_multi(void)
+{
+	enum err r;
+	/*more jobs than lanes, with different sizes in the same batch*/
+#define MULTI_JOBS 11
+	const uint32_t sizes[MULTI_JOBS] = { 0,  1,  15, 16,  17, 64,
+					     100, 256, 33, 1023, 5 };
+	static uint8_t pt_buf[1023];
+	static uint8_t ct1_buf[MULTI_JOBS][1023 + 16];
+	static uint8_t ct2_buf[MULTI_JOBS][1023 + 16];
+	static uint8_t dec_buf[MULTI_JOBS][1023];
+	uint8_t key_buf[MULTI_JOBS][16];
+	uint8_t nonce_buf[MULTI_JOBS][AEAD_IV_SIZE];
+	uint8_t aad_buf[20];
+	struct byte_array pt[MULTI_JOBS];
+	struct byte_array key[MULTI_JOBS];
+	struct byte_array nonce[MULTI_JOBS];
+	struct byte_array aad[MULTI_JOBS];
+	struct byte_array ct1[MULTI_JOBS];
+	struct byte_array ct2[MULTI_JOBS];
+	struct byte_array in[MULTI_JOBS];
+	struct byte_array dec[MULTI_JOBS];
+	struct byte_array tag1[MULTI_JOBS];
+	struct byte_array tag2[MULTI_JOBS];
+	struct aead_job jobs[MULTI_JOBS];
+
+	for (uint32_t i = 0; i < sizeof(pt_buf); i++) {
+		pt_buf[i] = (uint8_t)(i * 7);
+	}
+	for (uint32_t i = 0; i < sizeof(aad_buf); i++) {
+		aad_buf[i] = (uint8_t)i;
+	}
+
+	for (uint32_t j = 0; j < MULTI_JOBS; j++) {
+		/*every second job with the short tag of OSCORE*/
+		uint32_t t = (j % 2) ? 8 : 16;
+		uint32_t n = sizes[j];
+
+		for (uint32_t i = 0; i < sizeof(key_buf[j]); i++) {
+			key_buf[j][i] = (uint8_t)(0xc0 + i + j);
+		}
+		for (uint32_t i = 0; i < sizeof(nonce_buf[j]); i++) {
+			nonce_buf[j][i] = (uint8_t)(0xa0 + i * j);
+		}
+		pt[j] = (struct byte_array)BYTE_ARRAY_INIT(pt_buf, n);
+		key[j] = (struct byte_array)BYTE_ARRAY_INIT(key_buf[j], 16);
+		nonce[j] = (struct byte_array)BYTE_ARRAY_INIT(nonce_buf[j],
+							      AEAD_IV_SIZE);
+		aad[j] = (struct byte_array)BYTE_ARRAY_INIT(aad_buf, j);
+		ct1[j] = (struct byte_array)BYTE_ARRAY_INIT(ct1_buf[j], n);
+		ct2[j] = (struct byte_array)BYTE_ARRAY_INIT(ct2_buf[j], n);
+		tag1[j] = (struct byte_array)BYTE_ARRAY_INIT(ct1_buf[j] + n, t);
+		tag2[j] = (struct byte_array)BYTE_ARRAY_INIT(ct2_buf[j] + n, t);
+
+		r = crypto_provider_builtin.aead(ENCRYPT, &pt[j], &key[j],
+						 &nonce[j], &aad[j], &ct1[j],
+						 &tag1[j]);
+		zassert_equal(r, ok, "Error in aead");
+
+		jobs[j] = (struct aead_job){ .op = ENCRYPT,
+					     .in = &pt[j],
+					     .key = &key[j],
+					     .nonce = &nonce[j],
+					     .aad = &aad[j],
+					     .out = &ct2[j],
+					     .tag = &tag2[j] };
+	}
+
+	/* the interleaved jobs compute the results of the engine */
+	r = aead_multi(jobs, MULTI_JOBS);
+	zassert_equal(r, ok, "Error in aead_multi");
+	for (uint32_t j = 0; j < MULTI_JOBS; j++) {
+		zassert_equal(jobs[j].result, ok, "Error in job %u", j);
+		zassert_mem_equal__(ct1_buf[j], ct2_buf[j],
+				    sizes[j] + tag2[j].len,
+				    "wrong ciphertext");
+	}
+
+	/* decryption, a modified tag fails only its own job */
+	ct2_buf[3][sizes[3] + tag2[3].len - 1] ^= 1;
+	for (uint32_t j = 0; j < MULTI_JOBS; j++) {
+		in[j] = (struct byte_array)BYTE_ARRAY_INIT(
+			ct2_buf[j], sizes[j] + tag2[j].len);
+		dec[j] = (struct byte_array)BYTE_ARRAY_INIT(dec_buf[j],
+							    sizes[j]);
+		jobs[j].op = DECRYPT;
+		jobs[j].in = &in[j];
+		jobs[j].out = &dec[j];
+	}
+	r = aead_multi(jobs, MULTI_JOBS);
+	zassert_equal(r, unexpected_result_from_ext_lib,
+		      "modified tag accepted");
+	for (uint32_t j = 0; j < MULTI_JOBS; j++) {
+		if (j == 3) {
+			zassert_equal(jobs[j].result,
+				      unexpected_result_from_ext_lib,
+				      "modified tag accepted");
+			continue;
+		}
+		zassert_equal(jobs[j].result, ok, "Error in job %u", j);
+		zassert_mem_equal__(pt_buf, dec_buf[j], sizes[j],
+				    "wrong plaintext");
+	}
+#undef MULTI_JOBS
+}
+
+#ifdef SHA256_HW
+void t_crypto_sha256_hw(void)
+{
+	enum err r;
+	/*lengths around the block size and the padding boundary*/
+	const uint32_t sizes[] = { 0, 1, 55, 56, 63, 64, 65, 119, 128, 1000 };
+	static uint8_t msg_buf[1000];
+	uint8_t h1_buf[HASH_SIZE];
+	uint8_t h2_buf[HASH_SIZE];
+	uint8_t okm1_buf[80];
+	uint8_t okm2_buf[80];
+
+	if (!sha256_hw_available()) {
+		PRINT_MSG("no SHA instructions, test skipped\n");
+		return;
+	}
+
+	for (uint32_t i = 0; i < sizeof(msg_buf); i++) {
+		msg_buf[i] = (uint8_t)(i * 13);
+	}
+
+	for (uint32_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		uint32_t n = sizes[i];
+		struct byte_array msg = BYTE_ARRAY_INIT(msg_buf, n);
+		struct byte_array h1 = BYTE_ARRAY_INIT(h1_buf, sizeof(h1_buf));
+		struct byte_array h2 = BYTE_ARRAY_INIT(h2_buf, sizeof(h2_buf));
+
+		/* the instructions compute the hash of the engine */
+		r = crypto_provider_builtin.hash(SHA_256, &msg, &h1);
+		zassert_equal(r, ok, "Error in hash");
+		r = crypto_provider_sha256_hw.hash(SHA_256, &msg, &h2);
+		zassert_equal(r, ok, "Error in hash");
+		zassert_mem_equal__(h1_buf, h2_buf, HASH_SIZE, "wrong hash");
+
+		/* a hash computed in two pieces */
+		struct hash_ctx ctx;
+		struct byte_array a = BYTE_ARRAY_INIT(msg_buf, n / 3);
+		struct byte_array b =
+			BYTE_ARRAY_INIT(msg_buf + n / 3, n - n / 3);
+		r = hash_init(SHA_256, &ctx);
+		zassert_equal(r, ok, "Error in hash_init");
+		r = hash_update(&ctx, &a);
+		zassert_equal(r, ok, "Error in hash_update");
+		r = hash_update(&ctx, &b);
+		zassert_equal(r, ok, "Error in hash_update");
+		r = hash_final(&ctx, &h2);
+		zassert_equal(r, ok, "Error in hash_final");
+		zassert_mem_equal__(h1_buf, h2_buf, HASH_SIZE, "wrong hash");
+
+		/* HKDF with the message as salt and IKM, the output spans
+		several blocks of HKDF-Expand */
+		struct byte_array salt = BYTE_ARRAY_INIT(msg_buf, n % 100);
+		struct byte_array ikm = BYTE_ARRAY_INIT(msg_buf + 100, n % 77);
+		struct byte_array info = BYTE_ARRAY_INIT(msg_buf + 200, n % 50);
+		struct byte_array prk1 = BYTE_ARRAY_INIT(h1_buf, HASH_SIZE);
+		struct byte_array prk2 = BYTE_ARRAY_INIT(h2_buf, HASH_SIZE);
+		struct byte_array okm1 =
+			BYTE_ARRAY_INIT(okm1_buf, 1 + n % sizeof(okm1_buf));
+		struct byte_array okm2 =
+			BYTE_ARRAY_INIT(okm2_buf, 1 + n % sizeof(okm2_buf));
+		r = crypto_provider_builtin.hkdf_extract(SHA_256, &salt, &ikm,
+							 h1_buf);
+		zassert_equal(r, ok, "Error in hkdf_extract");
+		r = crypto_provider_sha256_hw.hkdf_extract(SHA_256, &salt,
+							   &ikm, h2_buf);
+		zassert_equal(r, ok, "Error in hkdf_extract");
+		zassert_mem_equal__(h1_buf, h2_buf, HASH_SIZE, "wrong PRK");
+		r = crypto_provider_builtin.hkdf_expand(SHA_256, &prk1, &info,
+							&okm1);
+		zassert_equal(r, ok, "Error in hkdf_expand");
+		r = crypto_provider_sha256_hw.hkdf_expand(SHA_256, &prk2,
+							  &info, &okm2);
+		zassert_equal(r, ok, "Error in hkdf_expand");
+		zassert_mem_equal__(okm1_buf, okm2_buf, okm1.len,
+				    "wrong OKM");
+	}
+}
+#endif
+
+#ifdef SHA256_HW
+void t_crypto_sha256_hkdf_multi(void)
+{
+	enum err r;
+	/*more jobs than lanes, neighbours with the same secret and salt share 
+	the PRK, outputs of one and two HKDF-Expand blocks*/
+#define HKDF_JOBS 11
+	const uint32_t secret_len[HKDF_JOBS] = { 16, 16, 16, 32, 70, 70,
+						 1,  0,  16, 64, 65 };
+	const uint32_t salt_len[HKDF_JOBS] = { 8, 8, 0, 8, 8,  8,
+					       3, 8, 100, 8, 0 };
+	const uint32_t info_len[HKDF_JOBS] = { 9, 10, 9, 9, 20, 0, 9, 9, 9, 63,
+					       9 };
+	const uint32_t out_len[HKDF_JOBS] = { 16, 13, 16, 13, 32, 16,
+					      48, 16, 33, 1,  16 };
+	static uint8_t in_buf[256];
+	uint8_t out1_buf[HKDF_JOBS][48];
+	uint8_t out2_buf[HKDF_JOBS][48];
+	struct byte_array secret[HKDF_JOBS];
+	struct byte_array salt[HKDF_JOBS];
+	struct byte_array info[HKDF_JOBS];
+	struct byte_array out1[HKDF_JOBS];
+	struct byte_array out2[HKDF_JOBS];
+	struct hkdf_sha_256_job jobs[HKDF_JOBS];
+
+	if (!sha256_hw_available()) {
+		PRINT_MSG("no SHA instructions, lanes run in software\n");
+	}
+
+	for (uint32_t i = 0; i < sizeof(in_buf); i++) {
+		in_buf[i] = (uint8_t)(i * 11);
+	}
+
+	for (uint32_t j = 0; j < HKDF_JOBS; j++) {
+		secret[j] = (struct byte_array)BYTE_ARRAY_INIT(in_buf,
+							       secret_len[j]);
+		salt[j] = (struct byte_array)BYTE_ARRAY_INIT(in_buf + 100,
+							     salt_len[j]);
+		/*the infos of OSCORE differ only in the last bytes*/
+		info[j] = (struct byte_array)BYTE_ARRAY_INIT(in_buf + 200 - j,
+							     info_len[j]);
+		out1[j] = (struct byte_array)BYTE_ARRAY_INIT(out1_buf[j],
+							     out_len[j]);
+		out2[j] = (struct byte_array)BYTE_ARRAY_INIT(out2_buf[j],
+							     out_len[j]);
+		jobs[j] = (struct hkdf_sha_256_job){ .master_secret = &secret[j],
+						     .master_salt = &salt[j],
+						     .info = &info[j],
+						     .out = &out2[j] };
+
+		/* the single derivation is the reference */
+		r = hkdf_sha_256(&secret[j], &salt[j], &info[j], &out1[j]);
+		zassert_equal(r, ok, "Error in hkdf_sha_256");
+	}
+
+	/* without an HKDF provider the jobs run in the lanes of 
+	 * sha256_hkdf_multi() */
+	zassert_is_null(crypto_provider_get(CRYPTO_OP_HKDF, SHA_256),
+			"unexpected provider");
+	r = hkdf_sha_256_multi(jobs, HKDF_JOBS);
+	zassert_equal(r, ok, "Error in hkdf_sha_256_multi");
+	for (uint32_t j = 0; j < HKDF_JOBS; j++) {
+		zassert_mem_equal__(out1_buf[j], out2_buf[j], out_len[j],
+				    "wrong OKM of job %u", j);
+	}
+#undef HKDF_JOBS
+}
+#endif
+
+#ifdef CURVE25519_64
+#include "src/common/crypto_25519.h"
+
+void t_crypto_x25519_kat(void)
+{
+	/* RFC 7748 Section 5.2, the scalars are clamped by crypto_x25519()
+	 * and the u-coordinates have the high bit set */
+	const uint8_t k1[] = {
+		0xa5, 0x46, 0xe3, 0x6b, 0xf0, 0x52, 0x7c, 0x9d,
+		0x3b, 0x16, 0x15, 0x4b, 0x82, 0x46, 0x5e, 0xdd,
+		0x62, 0x14, 0x4c, 0x0a, 0xc1, 0xfc, 0x5a, 0x18,
+		0x50, 0x6a, 0x22, 0x44, 0xba, 0x44, 0x9a, 0xc4
+	};
+	const uint8_t u1[] = {
+		0xe6, 0xdb, 0x68, 0x67, 0x58, 0x30, 0x30, 0xdb,
+		0x35, 0x94, 0xc1, 0xa4, 0x24, 0xb1, 0x5f, 0x7c,
+		0x72, 0x66, 0x24, 0xec, 0x26, 0xb3, 0x35, 0x3b,
+		0x10, 0xa9, 0x03, 0xa6, 0xd0, 0xab, 0x1c, 0x4c
+	};
+	const uint8_t out1[] = {
+		0xc3, 0xda, 0x55, 0x37, 0x9d, 0xe9, 0xc6, 0x90,
+		0x8e, 0x94, 0xea, 0x4d, 0xf2, 0x8d, 0x08, 0x4f,
+		0x32, 0xec, 0xcf, 0x03, 0x49, 0x1c, 0x71, 0xf7,
+		0x54, 0xb4, 0x07, 0x55, 0x77, 0xa2, 0x85, 0x52
+	};
+	const uint8_t k2[] = {
+		0x4b, 0x66, 0xe9, 0xd4, 0xd1, 0xb4, 0x67, 0x3c,
+		0x5a, 0xd2, 0x26, 0x91, 0x95, 0x7d, 0x6a, 0xf5,
+		0xc1, 0x1b, 0x64, 0x21, 0xe0, 0xea, 0x01, 0xd4,
+		0x2c, 0xa4, 0x16, 0x9e, 0x79, 0x18, 0xba, 0x0d
+	};
+	const uint8_t u2[] = {
+		0xe5, 0x21, 0x0f, 0x12, 0x78, 0x68, 0x11, 0xd3,
+		0xf4, 0xb7, 0x95, 0x9d, 0x05, 0x38, 0xae, 0x2c,
+		0x31, 0xdb, 0xe7, 0x10, 0x6f, 0xc0, 0x3c, 0x3e,
+		0xfc, 0x4c, 0xd5, 0x49, 0xc7, 0x15, 0xa4, 0x93
+	};
+	const uint8_t out2[] = {
+		0x95, 0xcb, 0xde, 0x94, 0x76, 0xe8, 0x90, 0x7d,
+		0x7a, 0xad, 0xe4, 0x5c, 0xb4, 0xb8, 0x73, 0xf8,
+		0x8b, 0x59, 0x5a, 0x68, 0x79, 0x9f, 0xa1, 0x52,
+		0xe6, 0xf8, 0xf7, 0x64, 0x7a, 0xac, 0x79, 0x57
+	};
+	/* the iterated test after 1 and 1000 iterations */
+	const uint8_t iter1[] = {
+		0x42, 0x2c, 0x8e, 0x7a, 0x62, 0x27, 0xd7, 0xbc,
+		0xa1, 0x35, 0x0b, 0x3e, 0x2b, 0xb7, 0x27, 0x9f,
+		0x78, 0x97, 0xb8, 0x7b, 0xb6, 0x85, 0x4b, 0x78,
+		0x3c, 0x60, 0xe8, 0x03, 0x11, 0xae, 0x30, 0x79
+	};
+	const uint8_t iter1000[] = {
+		0x68, 0x4c, 0xf5, 0x9b, 0xa8, 0x33, 0x09, 0x55,
+		0x28, 0x00, 0xef, 0x56, 0x6f, 0x2f, 0x4d, 0x3c,
+		0x1c, 0x38, 0x87, 0xc4, 0x93, 0x60, 0xe3, 0x87,
+		0x5f, 0x2e, 0xb9, 0x4d, 0x99, 0x53, 0x2c, 0x51
+	};
+	/* RFC 7748 Section 6.1 */
+	const uint8_t alice_sk[] = {
+		0x77, 0x07, 0x6d, 0x0a, 0x73, 0x18, 0xa5, 0x7d,
+		0x3c, 0x16, 0xc1, 0x72, 0x51, 0xb2, 0x66, 0x45,
+		0xdf, 0x4c, 0x2f, 0x87, 0xeb, 0xc0, 0x99, 0x2a,
+		0xb1, 0x77, 0xfb, 0xa5, 0x1d, 0xb9, 0x2c, 0x2a
+	};
+	const uint8_t alice_pk[] = {
+		0x85, 0x20, 0xf0, 0x09, 0x89, 0x30, 0xa7, 0x54,
+		0x74, 0x8b, 0x7d, 0xdc, 0xb4, 0x3e, 0xf7, 0x5a,
+		0x0d, 0xbf, 0x3a, 0x0d, 0x26, 0x38, 0x1a, 0xf4,
+		0xeb, 0xa4, 0xa9, 0x8e, 0xaa, 0x9b, 0x4e, 0x6a
+	};
+	const uint8_t bob_sk[] = {
+		0x5d, 0xab, 0x08, 0x7e, 0x62, 0x4a, 0x8a, 0x4b,
+		0x79, 0xe1, 0x7f, 0x8b, 0x83, 0x80, 0x0e, 0xe6,
+		0x6f, 0x3b, 0xb1, 0x29, 0x26, 0x18, 0xb6, 0xfd,
+		0x1c, 0x2f, 0x8b, 0x27, 0xff, 0x88, 0xe0, 0xeb
+	};
+	const uint8_t bob_pk[] = {
+		0xde, 0x9e, 0xdb, 0x7d, 0x7b, 0x7d, 0xc1, 0xb4,
+		0xd3, 0x5b, 0x61, 0xc2, 0xec, 0xe4, 0x35, 0x37,
+		0x3f, 0x83, 0x43, 0xc8, 0x5b, 0x78, 0x67, 0x4d,
+		0xad, 0xfc, 0x7e, 0x14, 0x6f, 0x88, 0x2b, 0x4f
+	};
+	const uint8_t shared[] = {
+		0x4a, 0x5d, 0x9d, 0x5b, 0xa4, 0xce, 0x2d, 0xe1,
+		0x72, 0x8e, 0x3b, 0xf4, 0x80, 0x35, 0x0f, 0x25,
+		0xe0, 0x7e, 0x21, 0xc9, 0x47, 0xd1, 0x9e, 0x33,
+		0x76, 0xf0, 0x9b, 0x3c, 0x1e, 0x16, 0x17, 0x42
+	};
+	uint8_t k[X25519_KEY_SIZE] = { 9 };
+	uint8_t u[X25519_KEY_SIZE] = { 9 };
+	uint8_t sk[X25519_KEY_SIZE];
+	uint8_t pk[X25519_KEY_SIZE];
+	uint8_t out[X25519_KEY_SIZE];
+
+	crypto_x25519(out, k1, u1);
+	zassert_mem_equal__(out, out1, sizeof(out), "wrong output 1");
+	crypto_x25519(out, k2, u2);
+	zassert_mem_equal__(out, out2, sizeof(out), "wrong output 2");
+
+	for (uint32_t i = 1; i <= 1000; i++) {
+		crypto_x25519(out, k, u);
+		memcpy(u, k, sizeof(u));
+		memcpy(k, out, sizeof(k));
+		if (1 == i) {
+			zassert_mem_equal__(k, iter1, sizeof(k),
+					    "wrong output after 1 iteration");
+		}
+	}
+	zassert_mem_equal__(k, iter1000, sizeof(k),
+			    "wrong output after 1000 iterations");
+
+	/* the key generation clamps the seed */
+	crypto_x25519_keygen(sk, pk, alice_sk);
+	zassert_mem_equal__(pk, alice_pk, sizeof(pk), "wrong public key A");
+	crypto_x25519_keygen(sk, pk, bob_sk);
+	zassert_mem_equal__(pk, bob_pk, sizeof(pk), "wrong public key B");
+	crypto_x25519(out, alice_sk, bob_pk);
+	zassert_mem_equal__(out, shared, sizeof(out), "wrong shared secret A");
+	crypto_x25519(out, bob_sk, alice_pk);
+	zassert_mem_equal__(out, shared, sizeof(out), "wrong shared secret B");
+}
+
+void t_crypto_ed25519_kat(void)
+{
+	/* RFC 8032 Section 7.1, TEST 1 to TEST 3 */
+	struct {
+		uint8_t sk[32];
+		uint8_t pk[32];
+		uint8_t msg[2];
+		uint32_t msg_len;
+		uint8_t sig[64];
+	} const v[] = {
+		{ .sk = { 0x9d, 0x61, 0xb1, 0x9d, 0xef, 0xfd, 0x5a, 0x60,
+			  0xba, 0x84, 0x4a, 0xf4, 0x92, 0xec, 0x2c, 0xc4,
+			  0x44, 0x49, 0xc5, 0x69, 0x7b, 0x32, 0x69, 0x19,
+			  0x70, 0x3b, 0xac, 0x03, 0x1c, 0xae, 0x7f, 0x60 },
+		  .pk = { 0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7,
+			  0xd5, 0x4b, 0xfe, 0xd3, 0xc9, 0x64, 0x07, 0x3a,
+			  0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6, 0x23, 0x25,
+			  0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a },
+		  .msg_len = 0,
+		  .sig = { 0xe5, 0x56, 0x43, 0x00, 0xc3, 0x60, 0xac, 0x72,
+			   0x90, 0x86, 0xe2, 0xcc, 0x80, 0x6e, 0x82, 0x8a,
+			   0x84, 0x87, 0x7f, 0x1e, 0xb8, 0xe5, 0xd9, 0x74,
+			   0xd8, 0x73, 0xe0, 0x65, 0x22, 0x49, 0x01, 0x55,
+			   0x5f, 0xb8, 0x82, 0x15, 0x90, 0xa3, 0x3b, 0xac,
+			   0xc6, 0x1e, 0x39, 0x70, 0x1c, 0xf9, 0xb4, 0x6b,
+			   0xd2, 0x5b, 0xf5, 0xf0, 0x59, 0x5b, 0xbe, 0x24,
+			   0x65, 0x51, 0x41, 0x43, 0x8e, 0x7a, 0x10, 0x0b } },
+		{ .sk = { 0x4c, 0xcd, 0x08, 0x9b, 0x28, 0xff, 0x96, 0xda,
+			  0x9d, 0xb6, 0xc3, 0x46, 0xec, 0x11, 0x4e, 0x0f,
+			  0x5b, 0x8a, 0x31, 0x9f, 0x35, 0xab, 0xa6, 0x24,
+			  0xda, 0x8c, 0xf6, 0xed, 0x4f, 0xb8, 0xa6, 0xfb },
+		  .pk = { 0x3d, 0x40, 0x17, 0xc3, 0xe8, 0x43, 0x89, 0x5a,
+			  0x92, 0xb7, 0x0a, 0xa7, 0x4d, 0x1b, 0x7e, 0xbc,
+			  0x9c, 0x98, 0x2c, 0xcf, 0x2e, 0xc4, 0x96, 0x8c,
+			  0xc0, 0xcd, 0x55, 0xf1, 0x2a, 0xf4, 0x66, 0x0c },
+		  .msg = { 0x72 },
+		  .msg_len = 1,
+		  .sig = { 0x92, 0xa0, 0x09, 0xa9, 0xf0, 0xd4, 0xca, 0xb8,
+			   0x72, 0x0e, 0x82, 0x0b, 0x5f, 0x64, 0x25, 0x40,
+			   0xa2, 0xb2, 0x7b, 0x54, 0x16, 0x50, 0x3f, 0x8f,
+			   0xb3, 0x76, 0x22, 0x23, 0xeb, 0xdb, 0x69, 0xda,
+			   0x08, 0x5a, 0xc1, 0xe4, 0x3e, 0x15, 0x99, 0x6e,
+			   0x45, 0x8f, 0x36, 0x13, 0xd0, 0xf1, 0x1d, 0x8c,
+			   0x38, 0x7b, 0x2e, 0xae, 0xb4, 0x30, 0x2a, 0xee,
+			   0xb0, 0x0d, 0x29, 0x16, 0x12, 0xbb, 0x0c, 0x00 } },
+		{ .sk = { 0xc5, 0xaa, 0x8d, 0xf4, 0x3f, 0x9f, 0x83, 0x7b,
+			  0xed, 0xb7, 0x44, 0x2f, 0x31, 0xdc, 0xb7, 0xb1,
+			  0x66, 0xd3, 0x85, 0x35, 0x07, 0x6f, 0x09, 0x4b,
+			  0x85, 0xce, 0x3a, 0x2e, 0x0b, 0x44, 0x58, 0xf7 },
+		  .pk = { 0xfc, 0x51, 0xcd, 0x8e, 0x62, 0x18, 0xa1, 0xa3,
+			  0x8d, 0xa4, 0x7e, 0xd0, 0x02, 0x30, 0xf0, 0x58,
+			  0x08, 0x16, 0xed, 0x13, 0xba, 0x33, 0x03, 0xac,
+			  0x5d, 0xeb, 0x91, 0x15, 0x48, 0x90, 0x80, 0x25 },
+		  .msg = { 0xaf, 0x82 },
+		  .msg_len = 2,
+		  .sig = { 0x62, 0x91, 0xd6, 0x57, 0xde, 0xec, 0x24, 0x02,
+			   0x48, 0x27, 0xe6, 0x9c, 0x3a, 0xbe, 0x01, 0xa3,
+			   0x0c, 0xe5, 0x48, 0xa2, 0x84, 0x74, 0x3a, 0x44,
+			   0x5e, 0x36, 0x80, 0xd7, 0xdb, 0x5a, 0xc3, 0xac,
+			   0x18, 0xff, 0x9b, 0x53, 0x8d, 0x16, 0xf2, 0x90,
+			   0xae, 0x67, 0xf7, 0x60, 0x98, 0x4d, 0xc6, 0x59,
+			   0x4a, 0x7c, 0x15, 0xe9, 0x71, 0x6e, 0xd2, 0x8d,
+			   0xc0, 0x27, 0xbe, 0xce, 0xea, 0x1e, 0xc4, 0x0a } },
+	};
+	uint8_t sig[64];
+
+	for (uint32_t i = 0; i < sizeof(v) / sizeof(v[0]); i++) {
+		crypto_ed25519_sign(sig, v[i].pk, v[i].sk, v[i].msg,
+				    v[i].msg_len);
+		zassert_mem_equal__(sig, v[i].sig, sizeof(sig),
+				    "wrong signature of TEST %u", i + 1);
+		zassert_true(crypto_ed25519_verify(v[i].sig, v[i].pk, v[i].msg,
+						   v[i].msg_len),
+			     "valid signature of TEST %u rejected", i + 1);
+
+		/* a modified R, S or message must be rejected */
+		sig[0] ^= 0x01;
+		zassert_false(crypto_ed25519_verify(sig, v[i].pk, v[i].msg,
+						    v[i].msg_len),
+			      "modified R of TEST %u accepted", i + 1);
+		sig[0] ^= 0x01;
+		sig[32] ^= 0x01;
+		zassert_false(crypto_ed25519_verify(sig, v[i].pk, v[i].msg,
+						    v[i].msg_len),
+			      "modified S of TEST %u accepted", i + 1);
+		sig[32] ^= 0x01;
+		if (0 != v[i].msg_len) {
+			uint8_t msg[2];
+			memcpy(msg, v[i].msg, sizeof(msg));
+			msg[0] ^= 0x01;
+			zassert_false(crypto_ed25519_verify(sig, v[i].pk, msg,
+							    v[i].msg_len),
+				      "modified message of TEST %u accepted",
+				      i + 1);
+		}
+	}
+}
+#endif
@@ -57,4 +57,149 @@ void test_initiator_responder_interaction(int vec_num);
 
 void t_initiator_responder_interaction1();
 void t_initiator_responder_interaction2();
+
+/**
+ * @brief 		Runs an Initiator and a Responder session step by step in
+ * 				a single thread and checks that both derive the same
+ * 				PRK_out.
+ */
+void t_edhoc_session_interaction(void);
+
+/**
+ * @brief 		Runs many interleaved handshakes against a responder 
+ * 				session table and checks the expiration of half-open 
+ * 				handshakes.
+ */
+void t_edhoc_responder_session_table(void);
+
+/**
+ * @brief 		Runs a handshake with ephemeral keys taken from a pool and
+ * 				checks that the keys are used only once.
+ */
+void t_edhoc_ephemeral_key_pool(void);
+
+/**
+ * @brief 		Tests the hash index over the credentials of a cred_array.
+ */
+void t_edhoc_cred_index(void);
+
+/**
+ * @brief 		Tests the cache of verified certificates.
+ */
+void t_edhoc_cert_cache(void);
+
+/**
+ * @brief 		Runs a handshake in which the certificates are verified
+ * 				with the CAs of a trust anchor store.
+ */
+void t_edhoc_trust_anchor_store(void);
+
+/**
+ * @brief 		Checks that static DH keys given in uncompressed form are
+ * 				used for ECDH and in a handshake.
+ */
+void t_edhoc_static_dh_uncompressed(void);
+
+/**
+ * @brief 		Checks the transcript hashes computed from pieces
+ * 				against the TH_3 and TH_4 of the test vectors.
+ */
+void t_edhoc_th_streaming(void);
+
+/**
+ * @brief 		Checks that the EDHOC-KDF computed from pieces of the
+ * 				context equals HKDF-Expand over the encoded info.
+ */
+void t_edhoc_kdf_streaming(void);
+
+/**
+ * @brief 		Checks the expansions under a prepared PRK and counts 
+ * 				the HMAC key setups of a handshake.
+ */
+void t_edhoc_prk_handle(void);
+
+/**
+ * @brief 		Resumes a connection from the stored PRK_out on both 
+ * 				sides, also with the request/response 
+ * 				exchange and a lost response, and checks the 
+ * 				lookup by peer and C_R, the size limit, the 
+ * 				expiry and the erasure of the store.
+ */
+void t_edhoc_resumption_store(void);
+
+/**
+ * @brief 		Sends message_3 and the first OSCORE request in one 
+ * 				EDHOC + OSCORE request and checks that the responder 
+ * 				completes the handshake and decrypts the request.
+ * 				A suite with an application AEAD that OSCORE 
+ * 				does not support is rejected. With MESSAGE_4 
+ * 				both sides return not_supported_feature.
+ */
+void t_edhoc_oscore_combined_request(void);
+
+/**
+ * @brief 		Checks the rate limit, the syntax check, the budget and 
+ * 				the challenge of the admission of message 1.
+ */
+void t_edhoc_admission(void);
+
+/**
+ * @brief 		Checks that another suite is selected after an 
+ * 				error message with SUITES_R and that the suite 
+ * 				cache avoids the error message in the next 
+ * 				handshake.
+ */
+void t_edhoc_suite_cache(void);
+
+/**
+ * @brief 		Checks that the crypto wrapper uses the registered 
+ * 				crypto provider, that the benchmark does not 
+ * 				select a provider with wrong results, that 
+ * 				prepared AEAD keys give the results of aead() 
+ * 				and that EDHOC signs ES256 with the provider.
+ */
+void t_crypto_provider(void);
+
+/**
+ * @brief 		Checks that the AES-CCM kernel using the AES 
+ * 				instructions of the CPU computes the results of 
+ * 				the built-in engine and rejects modified tags.
+ */
+void t_crypto_aes_ccm_hw(void);
+
+/**
+ * @brief 		Checks that aead_multi() computes the results of 
+ * 				the built-in engine for a batch of independent 
+ * 				jobs and fails only the job with a modified tag.
+ */
+void t_crypto_aes_ccm_multi(void);
+
+/**
+ * @brief 		Checks that SHA-256 and HKDF using the SHA 
+ * 				instructions of the CPU compute the results of 
+ * 				the built-in engine.
+ */
+void t_crypto_sha256_hw(void);
+
+/**
+ * @brief 		Checks that hkdf_sha_256_multi() computes the 
+ * 				results of hkdf_sha_256() for a batch of jobs 
+ * 				with the SHA-256 lanes of SHA256_HW.
+ */
+void t_crypto_sha256_hkdf_multi(void);
+
+/**
+ * @brief 		Checks crypto_x25519() and crypto_x25519_keygen() 
+ * 				of CURVE25519_64 against RFC 7748, Sections 5.2 
+ * 				and 6.1.
+ */
+void t_crypto_x25519_kat(void);
+
+/**
+ * @brief 		Checks crypto_ed25519_sign() and 
+ * 				crypto_ed25519_verify() of CURVE25519_64 against 
+ * 				RFC 8032, Section 7.1, and that modified 
+ * 				signatures and messages are rejected.
+ */
+void t_crypto_ed25519_kat(void);
 #endif
\ No newline at end of file
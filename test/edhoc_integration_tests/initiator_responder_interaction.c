@@ -9,6 +9,19 @@
 #include <zephyr/debug/thread_analyzer.h>
 
 #include <edhoc.h>
+#include <edhoc_internal.h>
+#include <edhoc/responder_session_table.h>
+#include <edhoc/ephemeral_key_pool.h>
+#include <edhoc/trust_anchor_store.h>
+#include <edhoc/th.h>
+#include <edhoc/okm.h>
+#include <edhoc/resumption_store.h>
+#include <edhoc/combined_request.h>
+#include <edhoc/admission.h>
+#include <edhoc/messages.h>
+#include <edhoc/suite_cache.h>
+
+#include <common/crypto_provider.h>
 
 #include "edhoc_test_vectors_p256_v15.h"
 #include "latency.h"
@@ -63,6 +76,16 @@ static struct k_thread thread_initiator_data;
 K_THREAD_STACK_DEFINE(thread_responder_stack_area, STACKSIZE);
 static struct k_thread thread_responder_data;
 
+#ifdef WORKSPACE
+/* each thread takes the temporary buffers of EDHOC from its own workspace.
+ * They are larger than EDHOC_WORKSPACE_SIZE, so that a too small bound is
+ * detected by the check of the peak instead of failing the handshake. */
+static uint8_t initiator_workspace_buf[2 * EDHOC_WORKSPACE_SIZE];
+static struct workspace initiator_workspace;
+static uint8_t responder_workspace_buf[2 * EDHOC_WORKSPACE_SIZE];
+static struct workspace responder_workspace;
+#endif
+
 /*semaphores*/
 K_SEM_DEFINE(tx_initiator_completed, 0, 1);
 K_SEM_DEFINE(tx_responder_completed, 0, 1);
@@ -139,6 +162,103 @@ enum err ead_process(void *params, struct byte_array *ead13)
 	return ok;
 }
 
+/**
+ * @brief			Sets the Initiator context and the credential of the
+ *				Responder according to a test vector
+ */
+static void initiator_context_set(int vec_num_i,
+				  struct edhoc_initiator_context *c_i,
+				  struct other_party_cred *cred_r)
+{
+	c_i->sock = NULL;
+	c_i->c_i.len = test_vectors[vec_num_i].c_i_len;
+	c_i->c_i.ptr = (uint8_t *)test_vectors[vec_num_i].c_i;
+	c_i->method = (enum method_type) * test_vectors[vec_num_i].method;
+	c_i->suites_i.len = test_vectors[vec_num_i].SUITES_I_len;
+	c_i->suites_i.ptr = (uint8_t *)test_vectors[vec_num_i].SUITES_I;
+	c_i->ead_1.len = test_vectors[vec_num_i].ead_1_len;
+	c_i->ead_1.ptr = (uint8_t *)test_vectors[vec_num_i].ead_1;
+	c_i->ead_3.len = test_vectors[vec_num_i].ead_3_len;
+	c_i->ead_3.ptr = (uint8_t *)test_vectors[vec_num_i].ead_3;
+	c_i->id_cred_i.len = test_vectors[vec_num_i].id_cred_i_len;
+	c_i->id_cred_i.ptr = (uint8_t *)test_vectors[vec_num_i].id_cred_i;
+	c_i->cred_i.len = test_vectors[vec_num_i].cred_i_len;
+	c_i->cred_i.ptr = (uint8_t *)test_vectors[vec_num_i].cred_i;
+	c_i->g_x.len = test_vectors[vec_num_i].g_x_raw_len;
+	c_i->g_x.ptr = (uint8_t *)test_vectors[vec_num_i].g_x_raw;
+	c_i->x.len = test_vectors[vec_num_i].x_raw_len;
+	c_i->x.ptr = (uint8_t *)test_vectors[vec_num_i].x_raw;
+	c_i->g_i.len = test_vectors[vec_num_i].g_i_raw_len;
+	c_i->g_i.ptr = (uint8_t *)test_vectors[vec_num_i].g_i_raw;
+	c_i->i.len = test_vectors[vec_num_i].i_raw_len;
+	c_i->i.ptr = (uint8_t *)test_vectors[vec_num_i].i_raw;
+	c_i->sk_i.len = test_vectors[vec_num_i].sk_i_raw_len;
+	c_i->sk_i.ptr = (uint8_t *)test_vectors[vec_num_i].sk_i_raw;
+	c_i->pk_i.len = test_vectors[vec_num_i].pk_i_raw_len;
+	c_i->pk_i.ptr = (uint8_t *)test_vectors[vec_num_i].pk_i_raw;
+
+	cred_r->id_cred.len = test_vectors[vec_num_i].id_cred_r_len;
+	cred_r->id_cred.ptr = (uint8_t *)test_vectors[vec_num_i].id_cred_r;
+	cred_r->cred.len = test_vectors[vec_num_i].cred_r_len;
+	cred_r->cred.ptr = (uint8_t *)test_vectors[vec_num_i].cred_r;
+	cred_r->g.len = test_vectors[vec_num_i].g_r_raw_len;
+	cred_r->g.ptr = (uint8_t *)test_vectors[vec_num_i].g_r_raw;
+	cred_r->pk.len = test_vectors[vec_num_i].pk_r_raw_len;
+	cred_r->pk.ptr = (uint8_t *)test_vectors[vec_num_i].pk_r_raw;
+	cred_r->ca.len = test_vectors[vec_num_i].ca_r_len;
+	cred_r->ca.ptr = (uint8_t *)test_vectors[vec_num_i].ca_r;
+	cred_r->ca_pk.len = test_vectors[vec_num_i].ca_r_pk_len;
+	cred_r->ca_pk.ptr = (uint8_t *)test_vectors[vec_num_i].ca_r_pk;
+}
+
+/**
+ * @brief			Sets the Responder context and the credential of the
+ *				Initiator according to a test vector
+ */
+static void responder_context_set(int vec_num_i,
+				  struct edhoc_responder_context *c_r,
+				  struct other_party_cred *cred_i)
+{
+	c_r->sock = NULL;
+	c_r->c_r.ptr = (uint8_t *)test_vectors[vec_num_i].c_r;
+	c_r->c_r.len = test_vectors[vec_num_i].c_r_len;
+	c_r->suites_r.len = test_vectors[vec_num_i].SUITES_R_len;
+	c_r->suites_r.ptr = (uint8_t *)test_vectors[vec_num_i].SUITES_R;
+	c_r->ead_2.len = test_vectors[vec_num_i].ead_2_len;
+	c_r->ead_2.ptr = (uint8_t *)test_vectors[vec_num_i].ead_2;
+	c_r->ead_4.len = test_vectors[vec_num_i].ead_4_len;
+	c_r->ead_4.ptr = (uint8_t *)test_vectors[vec_num_i].ead_4;
+	c_r->id_cred_r.len = test_vectors[vec_num_i].id_cred_r_len;
+	c_r->id_cred_r.ptr = (uint8_t *)test_vectors[vec_num_i].id_cred_r;
+	c_r->cred_r.len = test_vectors[vec_num_i].cred_r_len;
+	c_r->cred_r.ptr = (uint8_t *)test_vectors[vec_num_i].cred_r;
+	c_r->g_y.len = test_vectors[vec_num_i].g_y_raw_len;
+	c_r->g_y.ptr = (uint8_t *)test_vectors[vec_num_i].g_y_raw;
+	c_r->y.len = test_vectors[vec_num_i].y_raw_len;
+	c_r->y.ptr = (uint8_t *)test_vectors[vec_num_i].y_raw;
+	c_r->g_r.len = test_vectors[vec_num_i].g_r_raw_len;
+	c_r->g_r.ptr = (uint8_t *)test_vectors[vec_num_i].g_r_raw;
+	c_r->r.len = test_vectors[vec_num_i].r_raw_len;
+	c_r->r.ptr = (uint8_t *)test_vectors[vec_num_i].r_raw;
+	c_r->sk_r.len = test_vectors[vec_num_i].sk_r_raw_len;
+	c_r->sk_r.ptr = (uint8_t *)test_vectors[vec_num_i].sk_r_raw;
+	c_r->pk_r.len = test_vectors[vec_num_i].pk_r_raw_len;
+	c_r->pk_r.ptr = (uint8_t *)test_vectors[vec_num_i].pk_r_raw;
+
+	cred_i->id_cred.len = test_vectors[vec_num_i].id_cred_i_len;
+	cred_i->id_cred.ptr = (uint8_t *)test_vectors[vec_num_i].id_cred_i;
+	cred_i->cred.len = test_vectors[vec_num_i].cred_i_len;
+	cred_i->cred.ptr = (uint8_t *)test_vectors[vec_num_i].cred_i;
+	cred_i->g.len = test_vectors[vec_num_i].g_i_raw_len;
+	cred_i->g.ptr = (uint8_t *)test_vectors[vec_num_i].g_i_raw;
+	cred_i->pk.len = test_vectors[vec_num_i].pk_i_raw_len;
+	cred_i->pk.ptr = (uint8_t *)test_vectors[vec_num_i].pk_i_raw;
+	cred_i->ca.len = test_vectors[vec_num_i].ca_i_len;
+	cred_i->ca.ptr = (uint8_t *)test_vectors[vec_num_i].ca_i;
+	cred_i->ca_pk.len = test_vectors[vec_num_i].ca_i_pk_len;
+	cred_i->ca_pk.ptr = (uint8_t *)test_vectors[vec_num_i].ca_i_pk;
+}
+
 /**
  * @brief			A thread in which an Initiator instance is executed
  * 
@@ -152,6 +272,11 @@ void thread_initiator(void *vec_num, void *dummy2, void *dummy3)
 	ARG_UNUSED(dummy3);
 
 	PRINT_MSG("Initiator thread started!\n");
+#ifdef WORKSPACE
+	workspace_init(&initiator_workspace, initiator_workspace_buf,
+		       sizeof(initiator_workspace_buf));
+	workspace_select(&initiator_workspace);
+#endif
 	int vec_num_i = *((int *)vec_num) - 1;
 
 	enum err r;
@@ -159,46 +284,7 @@ void thread_initiator(void *vec_num, void *dummy2, void *dummy3)
 	struct other_party_cred cred_r;
 	struct edhoc_initiator_context c_i;
 
-	c_i.sock = NULL;
-	c_i.c_i.len = test_vectors[vec_num_i].c_i_len;
-	c_i.c_i.ptr = (uint8_t *)test_vectors[vec_num_i].c_i;
-	c_i.method = (enum method_type) * test_vectors[vec_num_i].method;
-	c_i.suites_i.len = test_vectors[vec_num_i].SUITES_I_len;
-	c_i.suites_i.ptr = (uint8_t *)test_vectors[vec_num_i].SUITES_I;
-	c_i.ead_1.len = test_vectors[vec_num_i].ead_1_len;
-	c_i.ead_1.ptr = (uint8_t *)test_vectors[vec_num_i].ead_1;
-	c_i.ead_3.len = test_vectors[vec_num_i].ead_3_len;
-	c_i.ead_3.ptr = (uint8_t *)test_vectors[vec_num_i].ead_3;
-	c_i.id_cred_i.len = test_vectors[vec_num_i].id_cred_i_len;
-	c_i.id_cred_i.ptr = (uint8_t *)test_vectors[vec_num_i].id_cred_i;
-	c_i.cred_i.len = test_vectors[vec_num_i].cred_i_len;
-	c_i.cred_i.ptr = (uint8_t *)test_vectors[vec_num_i].cred_i;
-	c_i.g_x.len = test_vectors[vec_num_i].g_x_raw_len;
-	c_i.g_x.ptr = (uint8_t *)test_vectors[vec_num_i].g_x_raw;
-	c_i.x.len = test_vectors[vec_num_i].x_raw_len;
-	c_i.x.ptr = (uint8_t *)test_vectors[vec_num_i].x_raw;
-	c_i.g_i.len = test_vectors[vec_num_i].g_i_raw_len;
-	c_i.g_i.ptr = (uint8_t *)test_vectors[vec_num_i].g_i_raw;
-	c_i.i.len = test_vectors[vec_num_i].i_raw_len;
-	c_i.i.ptr = (uint8_t *)test_vectors[vec_num_i].i_raw;
-	c_i.sk_i.len = test_vectors[vec_num_i].sk_i_raw_len;
-	c_i.sk_i.ptr = (uint8_t *)test_vectors[vec_num_i].sk_i_raw;
-	c_i.pk_i.len = test_vectors[vec_num_i].pk_i_raw_len;
-	c_i.pk_i.ptr = (uint8_t *)test_vectors[vec_num_i].pk_i_raw;
-
-	cred_r.id_cred.len = test_vectors[vec_num_i].id_cred_r_len;
-	cred_r.id_cred.ptr = (uint8_t *)test_vectors[vec_num_i].id_cred_r;
-	cred_r.cred.len = test_vectors[vec_num_i].cred_r_len;
-	cred_r.cred.ptr = (uint8_t *)test_vectors[vec_num_i].cred_r;
-	cred_r.g.len = test_vectors[vec_num_i].g_r_raw_len;
-	cred_r.g.ptr = (uint8_t *)test_vectors[vec_num_i].g_r_raw;
-	cred_r.pk.len = test_vectors[vec_num_i].pk_r_raw_len;
-	cred_r.pk.ptr = (uint8_t *)test_vectors[vec_num_i].pk_r_raw;
-	cred_r.ca.len = test_vectors[vec_num_i].ca_r_len;
-	cred_r.ca.ptr = (uint8_t *)test_vectors[vec_num_i].ca_r;
-	cred_r.ca_pk.len = test_vectors[vec_num_i].ca_r_pk_len;
-	cred_r.ca_pk.ptr = (uint8_t *)test_vectors[vec_num_i].ca_r_pk;
-
+	initiator_context_set(vec_num_i, &c_i, &cred_r);
 	struct cred_array cred_r_array = { .len = 1, .ptr = &cred_r };
 
 	r = edhoc_initiator_run(&c_i, &cred_r_array, &I_err_msg, &I_PRK_out,
@@ -232,6 +318,10 @@ void thread_initiator(void *vec_num, void *dummy2, void *dummy3)
 
 #ifdef REPORT_STACK_USAGE
 	thread_analyzer_print();
+#ifdef WORKSPACE
+	PRINTF("initiator workspace peak: %d of %d bytes\n",
+	       initiator_workspace.peak, initiator_workspace.size);
+#endif
 #endif
 
 	return;
@@ -252,6 +342,11 @@ void thread_responder(void *vec_num, void *dummy2, void *dummy3)
 	ARG_UNUSED(dummy3);
 
 	PRINT_MSG("Responder thread started!\n");
+#ifdef WORKSPACE
+	workspace_init(&responder_workspace, responder_workspace_buf,
+		       sizeof(responder_workspace_buf));
+	workspace_select(&responder_workspace);
+#endif
 	enum err r;
 	int vec_num_i = *((int *)vec_num) - 1;
 
@@ -259,45 +354,7 @@ void thread_responder(void *vec_num, void *dummy2, void *dummy3)
 	struct other_party_cred cred_i;
 	struct edhoc_responder_context c_r;
 
-	c_r.sock = NULL;
-	c_r.c_r.ptr = (uint8_t *)test_vectors[vec_num_i].c_r;
-	c_r.c_r.len = test_vectors[vec_num_i].c_r_len;
-	c_r.suites_r.len = test_vectors[vec_num_i].SUITES_R_len;
-	c_r.suites_r.ptr = (uint8_t *)test_vectors[vec_num_i].SUITES_R;
-	c_r.ead_2.len = test_vectors[vec_num_i].ead_2_len;
-	c_r.ead_2.ptr = (uint8_t *)test_vectors[vec_num_i].ead_2;
-	c_r.ead_4.len = test_vectors[vec_num_i].ead_4_len;
-	c_r.ead_4.ptr = (uint8_t *)test_vectors[vec_num_i].ead_4;
-	c_r.id_cred_r.len = test_vectors[vec_num_i].id_cred_r_len;
-	c_r.id_cred_r.ptr = (uint8_t *)test_vectors[vec_num_i].id_cred_r;
-	c_r.cred_r.len = test_vectors[vec_num_i].cred_r_len;
-	c_r.cred_r.ptr = (uint8_t *)test_vectors[vec_num_i].cred_r;
-	c_r.g_y.len = test_vectors[vec_num_i].g_y_raw_len;
-	c_r.g_y.ptr = (uint8_t *)test_vectors[vec_num_i].g_y_raw;
-	c_r.y.len = test_vectors[vec_num_i].y_raw_len;
-	c_r.y.ptr = (uint8_t *)test_vectors[vec_num_i].y_raw;
-	c_r.g_r.len = test_vectors[vec_num_i].g_r_raw_len;
-	c_r.g_r.ptr = (uint8_t *)test_vectors[vec_num_i].g_r_raw;
-	c_r.r.len = test_vectors[vec_num_i].r_raw_len;
-	c_r.r.ptr = (uint8_t *)test_vectors[vec_num_i].r_raw;
-	c_r.sk_r.len = test_vectors[vec_num_i].sk_r_raw_len;
-	c_r.sk_r.ptr = (uint8_t *)test_vectors[vec_num_i].sk_r_raw;
-	c_r.pk_r.len = test_vectors[vec_num_i].pk_r_raw_len;
-	c_r.pk_r.ptr = (uint8_t *)test_vectors[vec_num_i].pk_r_raw;
-
-	cred_i.id_cred.len = test_vectors[vec_num_i].id_cred_i_len;
-	cred_i.id_cred.ptr = (uint8_t *)test_vectors[vec_num_i].id_cred_i;
-	cred_i.cred.len = test_vectors[vec_num_i].cred_i_len;
-	cred_i.cred.ptr = (uint8_t *)test_vectors[vec_num_i].cred_i;
-	cred_i.g.len = test_vectors[vec_num_i].g_i_raw_len;
-	cred_i.g.ptr = (uint8_t *)test_vectors[vec_num_i].g_i_raw;
-	cred_i.pk.len = test_vectors[vec_num_i].pk_i_raw_len;
-	cred_i.pk.ptr = (uint8_t *)test_vectors[vec_num_i].pk_i_raw;
-	cred_i.ca.len = test_vectors[vec_num_i].ca_i_len;
-	cred_i.ca.ptr = (uint8_t *)test_vectors[vec_num_i].ca_i;
-	cred_i.ca_pk.len = test_vectors[vec_num_i].ca_i_pk_len;
-	cred_i.ca_pk.ptr = (uint8_t *)test_vectors[vec_num_i].ca_i_pk;
-
+	responder_context_set(vec_num_i, &c_r, &cred_i);
 	struct cred_array cred_i_array = { .len = 1, .ptr = &cred_i };
 	r = edhoc_responder_run(&c_r, &cred_i_array, &R_err_msg, &R_PRK_out,
 				tx_responder, rx_responder, ead_process);
@@ -330,6 +387,10 @@ void thread_responder(void *vec_num, void *dummy2, void *dummy3)
 
 #ifdef REPORT_STACK_USAGE
 	thread_analyzer_print();
+#ifdef WORKSPACE
+	PRINTF("responder workspace peak: %d of %d bytes\n",
+	       responder_workspace.peak, responder_workspace.size);
+#endif
 #endif
 
 	return;
@@ -382,6 +443,13 @@ int test_initiator_responder_interaction(int vec_num)
 
 	zassert_mem_equal__(I_master_salt.ptr, R_master_salt.ptr,
 			    R_master_salt.len, "wrong master_salt");
+
+#ifdef WORKSPACE
+	zassert_true(initiator_workspace.peak <= EDHOC_WORKSPACE_SIZE,
+		     "EDHOC_WORKSPACE_SIZE too small");
+	zassert_true(responder_workspace.peak <= EDHOC_WORKSPACE_SIZE,
+		     "EDHOC_WORKSPACE_SIZE too small");
+#endif
 	return 0;
 }
 
@@ -393,4 +461,1478 @@ void t_initiator_responder_interaction1()
 void t_initiator_responder_interaction2()
 {
 	MEASURE_LATENCY(test_initiator_responder_interaction(2));
-}
\ No newline at end of file
+}
+
+/* the sessions are static since they contain the message buffers */
+static struct edhoc_initiator_session initiator_session;
+static struct edhoc_responder_session responder_session;
+
+void t_edhoc_session_interaction(void)
+{
+	int vec_num_i = 0;
+	enum err r;
+	enum edhoc_step_status i_status, r_status;
+	struct byte_array i_out, r_out;
+
+	struct edhoc_initiator_context c_i;
+	struct other_party_cred cred_r;
+	struct edhoc_responder_context c_r;
+	struct other_party_cred cred_i;
+
+	initiator_context_set(vec_num_i, &c_i, &cred_r);
+	responder_context_set(vec_num_i, &c_r, &cred_i);
+	struct cred_array cred_r_array = { .len = 1, .ptr = &cred_r };
+	struct cred_array cred_i_array = { .len = 1, .ptr = &cred_i };
+
+	edhoc_initiator_session_init(&initiator_session, &c_i, &cred_r_array);
+	edhoc_responder_session_init(&responder_session, &c_r, &cred_i_array);
+
+	/* nothing received yet */
+	r = edhoc_responder_session_step(&responder_session, NULL, &r_out,
+					 &r_status);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_step");
+	zassert_equal(r_status, EDHOC_STEP_NEED_MORE, "wrong status");
+
+	/* message_1 */
+	r = edhoc_initiator_session_step(&initiator_session, NULL, &i_out,
+					 &i_status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+	zassert_equal(i_status, EDHOC_STEP_SEND, "wrong status");
+
+	/* message_2 */
+	r = edhoc_responder_session_step(&responder_session, &i_out, &r_out,
+					 &r_status);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_step");
+	zassert_equal(r_status, EDHOC_STEP_SEND, "wrong status");
+
+	/* message_3 */
+	r = edhoc_initiator_session_step(&initiator_session, &r_out, &i_out,
+					 &i_status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+
+	r = edhoc_responder_session_step(&responder_session, &i_out, &r_out,
+					 &r_status);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_step");
+	zassert_equal(r_status, EDHOC_STEP_DONE, "wrong status");
+
+#ifdef MESSAGE_4
+	zassert_equal(i_status, EDHOC_STEP_SEND, "wrong status");
+	r = edhoc_initiator_session_step(&initiator_session, &r_out, &i_out,
+					 &i_status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+#endif
+	zassert_equal(i_status, EDHOC_STEP_DONE, "wrong status");
+
+	zassert_mem_equal__(initiator_session.prk_out.ptr,
+			    responder_session.prk_out.ptr,
+			    responder_session.prk_out.len, "wrong prk_out");
+
+	/* a finished session does not accept further messages */
+	r = edhoc_responder_session_step(&responder_session, &i_out, &r_out,
+					 &r_status);
+	zassert_equal(r, edhoc_session_invalid_state,
+		      "Error in edhoc_responder_session_step");
+}
+
+/* number of handshakes in t_edhoc_responder_session_table */
+#define SESSION_TABLE_HANDSHAKES 10000
+
+static struct edhoc_initiator_session
+	table_initiator_sessions[EDHOC_SESSION_TABLE_SIZE];
+static struct edhoc_responder_session_table session_table;
+
+void t_edhoc_responder_session_table(void)
+{
+	int vec_num_i = 0;
+	enum err r;
+	enum edhoc_step_status status;
+	struct byte_array msg1, msg2, msg3, msg4;
+	struct edhoc_responder_session *s;
+	uint32_t now = 0;
+	uint32_t completed = 0;
+
+	struct edhoc_initiator_context c_i;
+	struct other_party_cred cred_r;
+	struct edhoc_responder_context c_r;
+	struct other_party_cred cred_i;
+
+	initiator_context_set(vec_num_i, &c_i, &cred_r);
+	responder_context_set(vec_num_i, &c_r, &cred_i);
+	struct cred_array cred_r_array = { .len = 1, .ptr = &cred_r };
+	struct cred_array cred_i_array = { .len = 1, .ptr = &cred_i };
+
+	edhoc_responder_session_table_init(&session_table, &c_r, &cred_i_array,
+					   10);
+
+	/* a half-open handshake is expired */
+	edhoc_initiator_session_init(&table_initiator_sessions[0], &c_i,
+				     &cred_r_array);
+	r = edhoc_initiator_session_step(&table_initiator_sessions[0], NULL,
+					 &msg1, &status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+	r = edhoc_responder_session_table_msg1(&session_table, now, &msg1,
+					       &msg2, &s);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_table_msg1");
+	uint8_t expired_c_r_buf[EDHOC_SESSION_TABLE_C_R_LEN];
+	memcpy(expired_c_r_buf, s->c->c_r.ptr, sizeof(expired_c_r_buf));
+	struct byte_array expired_c_r =
+		BYTE_ARRAY_INIT(expired_c_r_buf, sizeof(expired_c_r_buf));
+	zassert_equal(edhoc_responder_session_table_expire(&session_table, 9),
+		      0, "expired too early");
+	zassert_equal(edhoc_responder_session_table_expire(&session_table, 10),
+		      1, "not expired");
+	zassert_equal(s->rc.msg.len, 0, "expired session not erased");
+	r = edhoc_responder_session_table_get(&session_table, &expired_c_r,
+					      &s);
+	zassert_equal(r, edhoc_session_not_found, "expired session found");
+
+	/* a C_I equal to the next C_R gets another C_R */
+	c_i.c_i = expired_c_r;
+	edhoc_initiator_session_init(&table_initiator_sessions[0], &c_i,
+				     &cred_r_array);
+	r = edhoc_initiator_session_step(&table_initiator_sessions[0], NULL,
+					 &msg1, &status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+	r = edhoc_responder_session_table_msg1(&session_table, now, &msg1,
+					       &msg2, &s);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_table_msg1");
+	zassert_false(array_equals(&s->c_i, &s->c->c_r), "C_R equals C_I");
+	edhoc_responder_session_table_release(&session_table, s);
+	initiator_context_set(vec_num_i, &c_i, &cred_r);
+
+	/* all slots are used by interleaved handshakes: all message 1 are
+	 * received before the message 3 are received in reverse order */
+	while (completed < SESSION_TABLE_HANDSHAKES) {
+		now++;
+		for (uint32_t i = 0; i < EDHOC_SESSION_TABLE_SIZE; i++) {
+			struct edhoc_initiator_session *is =
+				&table_initiator_sessions[i];
+			edhoc_initiator_session_init(is, &c_i, &cred_r_array);
+			r = edhoc_initiator_session_step(is, NULL, &msg1,
+							 &status);
+			zassert_equal(r, ok,
+				      "Error in edhoc_initiator_session_step");
+			r = edhoc_responder_session_table_msg1(
+				&session_table, now, &msg1, &msg2, &s);
+			zassert_equal(
+				r, ok,
+				"Error in edhoc_responder_session_table_msg1");
+			r = edhoc_initiator_session_step(is, &msg2, &msg3,
+							 &status);
+			zassert_equal(r, ok,
+				      "Error in edhoc_initiator_session_step");
+		}
+
+		r = edhoc_responder_session_table_msg1(&session_table, now,
+						       &msg1, &msg2, &s);
+		zassert_equal(r, edhoc_session_table_full, "table not full");
+		zassert_equal(
+			edhoc_responder_session_table_in_progress(
+				&session_table),
+			EDHOC_SESSION_TABLE_SIZE, "wrong number in progress");
+
+		for (uint32_t i = EDHOC_SESSION_TABLE_SIZE; i > 0; i--) {
+			struct edhoc_initiator_session *is =
+				&table_initiator_sessions[i - 1];
+			r = edhoc_responder_session_table_msg3(
+				&session_table, &is->c_r, &is->rc.msg, &msg4,
+				&s);
+			zassert_equal(
+				r, ok,
+				"Error in edhoc_responder_session_table_msg3");
+			zassert_mem_equal__(is->prk_out.ptr, s->prk_out.ptr,
+					    s->prk_out.len, "wrong prk_out");
+			edhoc_responder_session_table_release(&session_table,
+							      s);
+			zassert_equal(s->prk_out.len, 0, "PRK_out not erased");
+			completed++;
+		}
+		zassert_equal(edhoc_responder_session_table_in_progress(
+				      &session_table),
+			      0, "wrong number in progress");
+	}
+}
+
+#ifdef EPHEMERAL_KEY_POOL
+static struct ephemeral_key_pool key_pool;
+
+void t_edhoc_ephemeral_key_pool(void)
+{
+	int vec_num_i = 0;
+	enum err r;
+	bool full = false;
+	enum edhoc_step_status i_status, r_status;
+	struct byte_array i_out, r_out;
+	struct suite suite;
+
+	struct edhoc_initiator_context c_i;
+	struct other_party_cred cred_r;
+	struct edhoc_responder_context c_r;
+	struct other_party_cred cred_i;
+
+	initiator_context_set(vec_num_i, &c_i, &cred_r);
+	responder_context_set(vec_num_i, &c_r, &cred_i);
+	struct cred_array cred_r_array = { .len = 1, .ptr = &cred_r };
+	struct cred_array cred_i_array = { .len = 1, .ptr = &cred_i };
+
+	r = get_suite((enum suite_label)c_i.suites_i.ptr[c_i.suites_i.len - 1],
+		      &suite);
+	zassert_equal(r, ok, "Error in get_suite");
+
+	ephemeral_key_pool_init(&key_pool, suite.edhoc_ecdh);
+	r = ephemeral_key_pool_register(&key_pool);
+	zassert_equal(r, ok, "Error in ephemeral_key_pool_register");
+	for (uint32_t seed = 1; !full; seed++) {
+		r = ephemeral_key_pool_fill(&key_pool, seed, &full);
+		zassert_equal(r, ok, "Error in ephemeral_key_pool_fill");
+	}
+	zassert_equal(ephemeral_key_pool_count(&key_pool),
+		      EPHEMERAL_KEY_POOL_SIZE, "pool not full");
+
+	edhoc_initiator_session_init(&initiator_session, &c_i, &cred_r_array);
+	edhoc_responder_session_init(&responder_session, &c_r, &cred_i_array);
+
+	r = edhoc_initiator_session_step(&initiator_session, NULL, &i_out,
+					 &i_status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+	/* the key of the pool is used, not the one of the context */
+	zassert_true(initiator_session.rc.eph_pk.ptr ==
+			     initiator_session.rc.eph_pk_buf,
+		     "key not taken from the pool");
+
+	r = edhoc_responder_session_step(&responder_session, &i_out, &r_out,
+					 &r_status);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_step");
+	r = edhoc_initiator_session_step(&initiator_session, &r_out, &i_out,
+					 &i_status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+	r = edhoc_responder_session_step(&responder_session, &i_out, &r_out,
+					 &r_status);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_step");
+
+	zassert_mem_equal__(initiator_session.prk_out.ptr,
+			    responder_session.prk_out.ptr,
+			    responder_session.prk_out.len, "wrong prk_out");
+
+	/* every pair is used only once and erased after the handshake */
+	zassert_equal(ephemeral_key_pool_count(&key_pool),
+		      EPHEMERAL_KEY_POOL_SIZE - 2, "wrong number of keys");
+	zassert_is_null(initiator_session.rc.eph_sk.ptr, "key not erased");
+	zassert_is_null(responder_session.rc.eph_sk.ptr, "key not erased");
+
+	ephemeral_key_pool_unregister(&key_pool);
+
+	/* without a pool the empty keys of a context are not selected */
+	static struct runtime_context rc;
+	runtime_context_init(&rc);
+	zassert_false(ephemeral_key_select(&rc, suite.edhoc_ecdh, &NULL_ARRAY,
+					   &NULL_ARRAY),
+		      "empty key selected");
+}
+#endif
+
+/**
+ * @brief			Builds a trust anchor store over a credential and
+ *				a second CA that did not issue the certificates.
+ */
+static void trust_anchor_store_set(struct other_party_cred *creds,
+				   struct cred_array *cred_array,
+				   struct trust_anchor_store *store,
+				   struct trust_anchor *anchors)
+{
+	/* the public key of the initiator serves as a foreign CA key */
+	creds[1] = creds[0];
+	creds[1].ca.len = 0;
+	creds[1].ca.ptr = NULL;
+	creds[1].ca_pk.len = test_vectors[0].pk_i_raw_len;
+	creds[1].ca_pk.ptr = (uint8_t *)test_vectors[0].pk_i_raw;
+	cred_array->len = 2;
+	cred_array->ptr = creds;
+
+	enum err r = trust_anchor_store_build(store, cred_array, anchors, 1);
+	zassert_equal(r, trust_anchor_store_too_small,
+		      "Error in trust_anchor_store_build");
+
+	r = trust_anchor_store_build(store, cred_array, anchors, 2);
+	zassert_equal(r, ok, "Error in trust_anchor_store_build");
+	zassert_equal(store->len, 2, "wrong number of CAs");
+	zassert_equal_ptr(cred_array->anchors, store, "store not assigned");
+}
+
+void t_edhoc_trust_anchor_store(void)
+{
+	int vec_num_i = 0;
+	enum err r;
+	enum edhoc_step_status i_status, r_status;
+	struct byte_array i_out, r_out;
+
+	struct edhoc_initiator_context c_i;
+	struct other_party_cred creds_r[2];
+	struct edhoc_responder_context c_r;
+	struct other_party_cred creds_i[2];
+	struct trust_anchor anchors_r[2];
+	struct trust_anchor anchors_i[2];
+	struct trust_anchor_store store_r;
+	struct trust_anchor_store store_i;
+	struct cred_array cred_r_array = { 0 };
+	struct cred_array cred_i_array = { 0 };
+
+	initiator_context_set(vec_num_i, &c_i, &creds_r[0]);
+	responder_context_set(vec_num_i, &c_r, &creds_i[0]);
+	trust_anchor_store_set(creds_r, &cred_r_array, &store_r, anchors_r);
+	trust_anchor_store_set(creds_i, &cred_i_array, &store_i, anchors_i);
+
+	/* an unknown issuer is not found if the store has more than one CA */
+	const uint8_t unknown[] = "unknown CA";
+	zassert_is_null(trust_anchor_find(&store_r, unknown, sizeof(unknown)),
+			"unknown CA found");
+
+	/* the certificates are verified with the keys of the store */
+	edhoc_initiator_session_init(&initiator_session, &c_i, &cred_r_array);
+	edhoc_responder_session_init(&responder_session, &c_r, &cred_i_array);
+
+	r = edhoc_initiator_session_step(&initiator_session, NULL, &i_out,
+					 &i_status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+	r = edhoc_responder_session_step(&responder_session, &i_out, &r_out,
+					 &r_status);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_step");
+	r = edhoc_initiator_session_step(&initiator_session, &r_out, &i_out,
+					 &i_status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+	r = edhoc_responder_session_step(&responder_session, &i_out, &r_out,
+					 &r_status);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_step");
+	zassert_equal(r_status, EDHOC_STEP_DONE, "wrong status");
+
+	zassert_mem_equal__(initiator_session.prk_out.ptr,
+			    responder_session.prk_out.ptr,
+			    responder_session.prk_out.len, "wrong prk_out");
+
+	trust_anchor_store_free(&store_r);
+	trust_anchor_store_free(&store_i);
+}
+
+void t_edhoc_static_dh_uncompressed(void)
+{
+	/* test vector 5 uses static DH keys on both sides */
+	int vec_num_i = 4;
+	enum err r;
+	uint8_t secret[ECDH_SECRET_SIZE];
+	uint8_t g_r_buf[P_256_PUB_KEY_UNCOMPRESSED_SIZE];
+	uint8_t g_i_buf[P_256_PUB_KEY_UNCOMPRESSED_SIZE];
+	uint8_t out_buf[P_256_PUB_KEY_UNCOMPRESSED_SIZE];
+	struct byte_array out = BYTE_ARRAY_INIT(out_buf, sizeof(out_buf));
+	struct byte_array x = BYTE_ARRAY_INIT(
+		(uint8_t *)test_vectors[vec_num_i].x_raw,
+		test_vectors[vec_num_i].x_raw_len);
+
+	g_r_buf[0] = 0x04;
+	memcpy(&g_r_buf[1], test_vector_5_g_r_raw, P_256_PUB_KEY_X_CORD_SIZE);
+	memcpy(&g_r_buf[1 + P_256_PUB_KEY_X_CORD_SIZE],
+	       test_vector_5_g_r_raw_y_coordinate, P_256_PUB_KEY_X_CORD_SIZE);
+	g_i_buf[0] = 0x04;
+	memcpy(&g_i_buf[1], test_vector_5_g_i_raw, P_256_PUB_KEY_X_CORD_SIZE);
+	memcpy(&g_i_buf[1 + P_256_PUB_KEY_X_CORD_SIZE],
+	       test_vector_5_g_i_raw_y_coordinate, P_256_PUB_KEY_X_CORD_SIZE);
+	struct byte_array g_r = BYTE_ARRAY_INIT(g_r_buf, sizeof(g_r_buf));
+
+	/* an uncompressed key is returned unchanged */
+	r = p256_pk_uncompress(&g_r, &out);
+	zassert_equal(r, ok, "Error in p256_pk_uncompress");
+	zassert_mem_equal__(out.ptr, g_r_buf, sizeof(g_r_buf), "wrong key");
+
+	/* G_RX with the uncompressed key and with the x-coordinate only */
+	r = shared_secret_derive(P256, &x, &g_r, secret);
+	zassert_equal(r, ok, "Error in shared_secret_derive");
+	zassert_mem_equal__(secret, test_vector_5_g_rx_raw, sizeof(secret),
+			    "wrong G_RX");
+
+	struct byte_array g_r_x = BYTE_ARRAY_INIT(
+		(uint8_t *)test_vector_5_g_r_raw, P_256_PUB_KEY_X_CORD_SIZE);
+	out.len = sizeof(out_buf);
+	r = p256_pk_uncompress(&g_r_x, &out);
+	zassert_equal(r, ok, "Error in p256_pk_uncompress");
+	zassert_equal(out.len, P_256_PUB_KEY_UNCOMPRESSED_SIZE, "wrong length");
+	r = shared_secret_derive(P256, &x, &out, secret);
+	zassert_equal(r, ok, "Error in shared_secret_derive");
+	zassert_mem_equal__(secret, test_vector_5_g_rx_raw, sizeof(secret),
+			    "wrong G_RX");
+
+	/* a handshake with uncompressed static DH keys in the credentials */
+	enum edhoc_step_status i_status, r_status;
+	struct byte_array i_out, r_out;
+	struct edhoc_initiator_context c_i;
+	struct other_party_cred cred_r;
+	struct edhoc_responder_context c_r;
+	struct other_party_cred cred_i;
+
+	initiator_context_set(vec_num_i, &c_i, &cred_r);
+	responder_context_set(vec_num_i, &c_r, &cred_i);
+	cred_r.g.ptr = g_r_buf;
+	cred_r.g.len = sizeof(g_r_buf);
+	cred_i.g.ptr = g_i_buf;
+	cred_i.g.len = sizeof(g_i_buf);
+	struct cred_array cred_r_array = { .len = 1, .ptr = &cred_r };
+	struct cred_array cred_i_array = { .len = 1, .ptr = &cred_i };
+
+	edhoc_initiator_session_init(&initiator_session, &c_i, &cred_r_array);
+	edhoc_responder_session_init(&responder_session, &c_r, &cred_i_array);
+
+	r = edhoc_initiator_session_step(&initiator_session, NULL, &i_out,
+					 &i_status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+	r = edhoc_responder_session_step(&responder_session, &i_out, &r_out,
+					 &r_status);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_step");
+	r = edhoc_initiator_session_step(&initiator_session, &r_out, &i_out,
+					 &i_status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+	r = edhoc_responder_session_step(&responder_session, &i_out, &r_out,
+					 &r_status);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_step");
+	zassert_equal(r_status, EDHOC_STEP_DONE, "wrong status");
+
+	zassert_mem_equal__(initiator_session.prk_out.ptr,
+			    responder_session.prk_out.ptr,
+			    responder_session.prk_out.len, "wrong prk_out");
+}
+
+void t_edhoc_kdf_streaming(void)
+{
+	int vec_num_i = 0;
+	enum err r;
+	uint8_t context_buf[1024];
+	uint8_t info_buf[1024 + 16];
+	uint8_t okm_buf[64];
+	uint8_t expected_buf[64];
+	struct byte_array context = BYTE_ARRAY_INIT(context_buf, 0);
+	struct byte_array info = BYTE_ARRAY_INIT(info_buf, sizeof(info_buf));
+
+	struct byte_array prk = BYTE_ARRAY_INIT(
+		(uint8_t *)test_vectors[vec_num_i].prk_3e2m_raw,
+		test_vectors[vec_num_i].prk_3e2m_raw_len);
+	struct byte_array pieces[] = {
+		BYTE_ARRAY_INIT((uint8_t *)test_vectors[vec_num_i].id_cred_r,
+				test_vectors[vec_num_i].id_cred_r_len),
+		BYTE_ARRAY_INIT((uint8_t *)test_vectors[vec_num_i].th_2_raw,
+				test_vectors[vec_num_i].th_2_raw_len),
+		BYTE_ARRAY_INIT(NULL, 0),
+		BYTE_ARRAY_INIT((uint8_t *)test_vectors[vec_num_i].cred_r,
+				test_vectors[vec_num_i].cred_r_len),
+	};
+	for (uint32_t i = 0; i < sizeof(pieces) / sizeof(pieces[0]); i++) {
+		zassert_true(context.len + pieces[i].len <= sizeof(context_buf),
+			     "context buffer too small");
+		if (0 != pieces[i].len) {
+			memcpy(&context_buf[context.len], pieces[i].ptr,
+			       pieces[i].len);
+		}
+		context.len += pieces[i].len;
+	}
+
+	/* one and more than one HKDF block, the info built in a buffer is 
+	 * the reference */
+	uint32_t okm_lens[] = { 8, 32, 33, 64 };
+	for (uint32_t i = 0; i < sizeof(okm_lens) / sizeof(okm_lens[0]); i++) {
+		struct byte_array okm = BYTE_ARRAY_INIT(okm_buf, okm_lens[i]);
+		struct byte_array expected =
+			BYTE_ARRAY_INIT(expected_buf, okm_lens[i]);
+
+		info.len = sizeof(info_buf);
+		r = create_hkdf_info(MAC_2, &context, okm_lens[i], &info);
+		zassert_equal(r, ok, "Error in create_hkdf_info");
+		r = hkdf_expand(SHA_256, &prk, &info, &expected);
+		zassert_equal(r, ok, "Error in hkdf_expand");
+
+		r = edhoc_kdf_pieces(SHA_256, &prk, MAC_2, pieces,
+				     sizeof(pieces) / sizeof(pieces[0]), &okm);
+		zassert_equal(r, ok, "Error in edhoc_kdf_pieces");
+		zassert_mem_equal__(okm.ptr, expected.ptr, okm_lens[i],
+				    "wrong okm");
+
+		r = edhoc_kdf(SHA_256, &prk, MAC_2, &context, &okm);
+		zassert_equal(r, ok, "Error in edhoc_kdf");
+		zassert_mem_equal__(okm.ptr, expected.ptr, okm_lens[i],
+				    "wrong okm");
+	}
+
+	/* the streaming HMAC gives the first block of HKDF-Expand */
+	struct hmac_ctx h;
+	uint8_t counter = 1;
+	struct byte_array c = BYTE_ARRAY_INIT(&counter, 1);
+	struct byte_array okm = BYTE_ARRAY_INIT(okm_buf, HASH_SIZE);
+	struct byte_array expected = BYTE_ARRAY_INIT(expected_buf, HASH_SIZE);
+	r = hkdf_expand(SHA_256, &prk, &context, &expected);
+	zassert_equal(r, ok, "Error in hkdf_expand");
+	r = hmac_init(SHA_256, &prk, &h);
+	zassert_equal(r, ok, "Error in hmac_init");
+	for (uint32_t i = 0; i < sizeof(pieces) / sizeof(pieces[0]); i++) {
+		r = hmac_update(&h, &pieces[i]);
+		zassert_equal(r, ok, "Error in hmac_update");
+	}
+	r = hmac_update(&h, &c);
+	zassert_equal(r, ok, "Error in hmac_update");
+	r = hmac_final(&h, &okm);
+	zassert_equal(r, ok, "Error in hmac_final");
+	zassert_mem_equal__(okm.ptr, expected.ptr, HASH_SIZE, "wrong HMAC");
+}
+
+/**
+ * @brief	Runs a handshake with the sessions and returns the number of 
+ *		HMAC key setups done by the initiator and the responder.
+ */
+static uint32_t session_handshake_key_setups(int vec_num_i)
+{
+	enum err r;
+	enum edhoc_step_status i_status, r_status;
+	struct byte_array i_out, r_out;
+	struct edhoc_initiator_context c_i;
+	struct other_party_cred cred_r;
+	struct edhoc_responder_context c_r;
+	struct other_party_cred cred_i;
+
+	initiator_context_set(vec_num_i, &c_i, &cred_r);
+	responder_context_set(vec_num_i, &c_r, &cred_i);
+	struct cred_array cred_r_array = { .len = 1, .ptr = &cred_r };
+	struct cred_array cred_i_array = { .len = 1, .ptr = &cred_i };
+
+	edhoc_initiator_session_init(&initiator_session, &c_i, &cred_r_array);
+	edhoc_responder_session_init(&responder_session, &c_r, &cred_i_array);
+
+	uint32_t setups = hmac_key_setup_count();
+	r = edhoc_initiator_session_step(&initiator_session, NULL, &i_out,
+					 &i_status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+	r = edhoc_responder_session_step(&responder_session, &i_out, &r_out,
+					 &r_status);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_step");
+	r = edhoc_initiator_session_step(&initiator_session, &r_out, &i_out,
+					 &i_status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+	r = edhoc_responder_session_step(&responder_session, &i_out, &r_out,
+					 &r_status);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_step");
+#ifdef MESSAGE_4
+	r = edhoc_initiator_session_step(&initiator_session, &r_out, &i_out,
+					 &i_status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+#endif
+	zassert_equal(i_status, EDHOC_STEP_DONE, "wrong status");
+	zassert_mem_equal__(initiator_session.prk_out.ptr,
+			    responder_session.prk_out.ptr,
+			    responder_session.prk_out.len, "wrong prk_out");
+	return hmac_key_setup_count() - setups;
+}
+
+/**
+ * @brief	Returns the number of HMAC key setups of n prepared PRKs. With
+ *		EDHOC_KDF_HKDF_EXPAND the PRKs are passed to hkdf_expand()
+ *		and no HMAC is prepared.
+ */
+static uint32_t prepared_setups(uint32_t n)
+{
+#ifdef EDHOC_KDF_HKDF_EXPAND
+	(void)n;
+	return 0;
+#else
+	return n;
+#endif
+}
+
+void t_edhoc_prk_handle(void)
+{
+	enum err r;
+	uint8_t okm_buf[48];
+	uint8_t expected_buf[48];
+	struct byte_array okm = BYTE_ARRAY_INIT(okm_buf, sizeof(okm_buf));
+	struct byte_array expected =
+		BYTE_ARRAY_INIT(expected_buf, sizeof(expected_buf));
+	struct byte_array prk =
+		BYTE_ARRAY_INIT((uint8_t *)test_vectors[0].prk_3e2m_raw,
+				test_vectors[0].prk_3e2m_raw_len);
+	struct byte_array th =
+		BYTE_ARRAY_INIT((uint8_t *)test_vectors[0].th_3_raw,
+				test_vectors[0].th_3_raw_len);
+
+	/* all expansions under a handle and a copy of it need one setup */
+	struct prk_handle h, h_copy;
+	uint32_t setups = hmac_key_setup_count();
+	r = prk_handle_init(SHA_256, &prk, &h);
+	zassert_equal(r, ok, "Error in prk_handle_init");
+	r = prk_handle_copy(&h, &h_copy);
+	zassert_equal(r, ok, "Error in prk_handle_copy");
+	r = edhoc_kdf_handle(&h, K_3, &th, 1, &okm);
+	zassert_equal(r, ok, "Error in edhoc_kdf_handle");
+	okm.len = AEAD_IV_SIZE;
+	r = edhoc_kdf_handle(&h_copy, IV_3, &th, 1, &okm);
+	zassert_equal(r, ok, "Error in edhoc_kdf_handle");
+	zassert_equal(hmac_key_setup_count() - setups, prepared_setups(1),
+		      "wrong number of key setups");
+
+	/* the results equal EDHOC-KDF with the raw PRK */
+	r = edhoc_kdf(SHA_256, &prk, IV_3, &th, &expected);
+	zassert_equal(r, ok, "Error in edhoc_kdf");
+	expected.len = AEAD_IV_SIZE;
+	zassert_mem_equal__(okm.ptr, expected.ptr, okm.len, "wrong IV_3");
+	okm.len = sizeof(okm_buf);
+	expected.len = sizeof(expected_buf);
+	r = edhoc_kdf_handle(&h, K_3, &th, 1, &okm);
+	zassert_equal(r, ok, "Error in edhoc_kdf_handle");
+	r = edhoc_kdf(SHA_256, &prk, K_3, &th, &expected);
+	zassert_equal(r, ok, "Error in edhoc_kdf");
+	zassert_mem_equal__(okm.ptr, expected.ptr, okm.len, "wrong K_3");
+	prk_handle_wipe(&h);
+	prk_handle_wipe(&h_copy);
+
+	/* key setups per handshake: PRK_2e on both sides and PRK_3e2m again 
+	 * on the responder when message 3 arrives, with static DH keys 
+	 * additionally PRK_3e2m and PRK_4e3m on both sides. With message_4 
+	 * PRK_4e3m is prepared once more on both sides. */
+	uint32_t msg4_setups = 0;
+#ifdef MESSAGE_4
+	msg4_setups = 2;
+#endif
+	uint32_t sig_setups = session_handshake_key_setups(0);
+	PRINTF("HMAC key setups per handshake (signatures): %d\n",
+	       sig_setups);
+	zassert_equal(sig_setups, prepared_setups(3 + msg4_setups),
+		      "wrong number of key setups");
+
+	uint32_t dh_setups = session_handshake_key_setups(4);
+	PRINTF("HMAC key setups per handshake (static DH): %d\n", dh_setups);
+	zassert_equal(dh_setups, prepared_setups(7 + msg4_setups),
+		      "wrong number of key setups");
+}
+
+static uint32_t resumption_time;
+
+static uint32_t resumption_now(void)
+{
+	return resumption_time;
+}
+
+void t_edhoc_resumption_store(void)
+{
+	enum err r;
+	struct resumption_entry i_entries[2], r_entries[2];
+	struct resumption_store i_store, r_store;
+	uint8_t i_secret_buf[16], i_salt_buf[8], r_secret_buf[16],
+		r_salt_buf[8], prk_buf[PRK_SIZE], prk_new_buf[PRK_SIZE];
+	uint8_t exporter_buf[HASH_SIZE], expected_buf[16];
+	uint8_t nonce_i_buf[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	uint8_t nonce_r_buf[8] = { 8, 7, 6, 5, 4, 3, 2, 1 };
+	uint8_t context_buf[16];
+	uint8_t other_id_buf[1] = { 0x2a };
+	struct byte_array i_secret =
+		BYTE_ARRAY_INIT(i_secret_buf, sizeof(i_secret_buf));
+	struct byte_array i_salt =
+		BYTE_ARRAY_INIT(i_salt_buf, sizeof(i_salt_buf));
+	struct byte_array r_secret =
+		BYTE_ARRAY_INIT(r_secret_buf, sizeof(r_secret_buf));
+	struct byte_array r_salt =
+		BYTE_ARRAY_INIT(r_salt_buf, sizeof(r_salt_buf));
+	struct byte_array nonce_i =
+		BYTE_ARRAY_INIT(nonce_i_buf, sizeof(nonce_i_buf));
+	struct byte_array nonce_r =
+		BYTE_ARRAY_INIT(nonce_r_buf, sizeof(nonce_r_buf));
+	struct byte_array other_id =
+		BYTE_ARRAY_INIT(other_id_buf, sizeof(other_id_buf));
+	struct byte_array id_cred_i =
+		BYTE_ARRAY_INIT((uint8_t *)test_vectors[0].id_cred_i,
+				test_vectors[0].id_cred_i_len);
+	struct byte_array id_cred_r =
+		BYTE_ARRAY_INIT((uint8_t *)test_vectors[0].id_cred_r,
+				test_vectors[0].id_cred_r_len);
+
+	/* both roles keep PRK_out of a handshake under C_R */
+	session_handshake_key_setups(0);
+	struct byte_array c_r = initiator_session.c_r;
+	memcpy(prk_buf, initiator_session.prk_out.ptr, sizeof(prk_buf));
+	struct byte_array prk_out = BYTE_ARRAY_INIT(prk_buf, sizeof(prk_buf));
+
+	resumption_store_init(&i_store, i_entries, 2, 100,
+			      RESUMPTION_INITIATOR);
+	resumption_store_init(&r_store, r_entries, 2, 100,
+			      RESUMPTION_RESPONDER);
+	i_store.base.now = resumption_now;
+	r_store.base.now = resumption_now;
+	resumption_time = 0;
+	r = resumption_store_put(&i_store, &c_r, &id_cred_r, SUITE_2,
+				 &initiator_session.prk_out);
+	zassert_equal(r, ok, "Error in resumption_store_put");
+	r = resumption_store_put(&r_store, &c_r, &id_cred_i, SUITE_2,
+				 &responder_session.prk_out);
+	zassert_equal(r, ok, "Error in resumption_store_put");
+
+	/* the peer identity is checked */
+	r = resumption_store_resume(&i_store, &c_r, &id_cred_i, &nonce_i,
+				    &nonce_r, &i_secret, &i_salt);
+	zassert_equal(r, resumption_peer_mismatch, "peer not checked");
+
+	/* both roles derive the same material */
+	r = resumption_store_resume(&i_store, &c_r, &id_cred_r, &nonce_i,
+				    &nonce_r, &i_secret, &i_salt);
+	zassert_equal(r, ok, "Error in resumption_store_resume");
+	r = resumption_store_resume(&r_store, &c_r, NULL, &nonce_i, &nonce_r,
+				    &r_secret, &r_salt);
+	zassert_equal(r, ok, "Error in resumption_store_resume");
+	zassert_mem_equal__(i_secret.ptr, r_secret.ptr, i_secret.len,
+			    "wrong master secret");
+	zassert_mem_equal__(i_salt.ptr, r_salt.ptr, i_salt.len,
+			    "wrong master salt");
+
+	/* the material is exported from prk_out_update(PRK_out, N_I | N_R) */
+	memcpy(context_buf, nonce_i_buf, sizeof(nonce_i_buf));
+	memcpy(context_buf + sizeof(nonce_i_buf), nonce_r_buf,
+	       sizeof(nonce_r_buf));
+	struct byte_array context =
+		BYTE_ARRAY_INIT(context_buf, sizeof(context_buf));
+	struct byte_array prk_out_new =
+		BYTE_ARRAY_INIT(prk_new_buf, sizeof(prk_new_buf));
+	struct byte_array exporter =
+		BYTE_ARRAY_INIT(exporter_buf, sizeof(exporter_buf));
+	struct byte_array expected =
+		BYTE_ARRAY_INIT(expected_buf, sizeof(expected_buf));
+	r = prk_out_update(SHA_256, &prk_out, &context, &prk_out_new);
+	zassert_equal(r, ok, "Error in prk_out_update");
+	r = prk_out2exporter(SHA_256, &prk_out_new, &exporter);
+	zassert_equal(r, ok, "Error in prk_out2exporter");
+	r = edhoc_exporter(SHA_256, OSCORE_MASTER_SECRET, &exporter,
+			   &expected);
+	zassert_equal(r, ok, "Error in edhoc_exporter");
+	zassert_mem_equal__(i_secret.ptr, expected.ptr, i_secret.len,
+			    "wrong master secret");
+
+	/* a second resumption gives new material */
+	r = resumption_store_resume(&i_store, &c_r, &id_cred_r, &nonce_i,
+				    &nonce_r, &i_secret, &i_salt);
+	zassert_equal(r, ok, "Error in resumption_store_resume");
+	zassert_true(0 != memcmp(i_secret.ptr, r_secret.ptr, i_secret.len),
+		     "PRK_out not updated");
+
+	/* the initiator keeps the same C_R of different responders apart */
+	r = resumption_store_put(&i_store, &c_r, &id_cred_i, SUITE_2,
+				 &prk_out);
+	zassert_equal(r, ok, "Error in resumption_store_put");
+	r = resumption_store_resume(&i_store, &c_r, &id_cred_r, &nonce_i,
+				    &nonce_r, &i_secret, &i_salt);
+	zassert_equal(r, ok, "entry of the other responder replaced");
+	r = resumption_store_resume(&i_store, &c_r, &id_cred_i, &nonce_i,
+				    &nonce_r, &i_secret, &i_salt);
+	zassert_equal(r, ok, "Error in resumption_store_resume");
+	zassert_mem_equal__(i_secret.ptr, expected.ptr, i_secret.len,
+			    "wrong master secret");
+
+	/* the store is bounded, the oldest entry is replaced */
+	c_r.ptr[0] ^= 0x01;
+	r = resumption_store_put(&r_store, &c_r, &id_cred_i, SUITE_2,
+				 &prk_out);
+	zassert_equal(r, ok, "Error in resumption_store_put");
+	r = resumption_store_put(&r_store, &other_id, &id_cred_i, SUITE_2,
+				 &prk_out);
+	zassert_equal(r, ok, "Error in resumption_store_put");
+	c_r.ptr[0] ^= 0x01;
+	r = resumption_store_resume(&r_store, &c_r, NULL, &nonce_i, &nonce_r,
+				    &r_secret, &r_salt);
+	zassert_equal(r, resumption_not_found, "entry not replaced");
+
+	/* entries expire */
+	resumption_time = 100;
+	r = resumption_store_resume(&r_store, &other_id, NULL, &nonce_i,
+				    &nonce_r, &r_secret, &r_salt);
+	zassert_equal(r, resumption_not_found, "entry not expired");
+
+	/* clearing erases the keys */
+	resumption_store_clear(&i_store);
+	for (uint32_t i = 0; i < sizeof(i_entries[0].prk_out); i++) {
+		zassert_equal(i_entries[0].prk_out[i], 0, "key not erased");
+	}
+	resumption_time = 0;
+
+	/* one round trip, a lost response is recovered by sending the
+	 * request again, which gets the same N_R */
+	uint8_t request_buf[RESUMPTION_REQUEST_SIZE];
+	uint8_t response_buf[RESUMPTION_RESPONSE_SIZE];
+	uint8_t id_buf[RESUMPTION_ID_MAX_SIZE];
+	uint8_t fresh_buf[8] = { 9, 9, 9, 9, 9, 9, 9, 9 };
+	struct byte_array request =
+		BYTE_ARRAY_INIT(request_buf, sizeof(request_buf));
+	struct byte_array response =
+		BYTE_ARRAY_INIT(response_buf, sizeof(response_buf));
+	struct byte_array id = BYTE_ARRAY_INIT(id_buf, sizeof(id_buf));
+	struct byte_array fresh = BYTE_ARRAY_INIT(fresh_buf, sizeof(fresh_buf));
+	r = resumption_store_put(&i_store, &c_r, &id_cred_r, SUITE_2,
+				 &prk_out);
+	zassert_equal(r, ok, "Error in resumption_store_put");
+	r = resumption_store_put(&r_store, &c_r, &id_cred_i, SUITE_2,
+				 &prk_out);
+	zassert_equal(r, ok, "Error in resumption_store_put");
+	r = resumption_request_gen(&i_store, &c_r, &id_cred_r, &nonce_i,
+				   &request);
+	zassert_equal(r, ok, "Error in resumption_request_gen");
+	r = resumption_request_process(&r_store, &request, &nonce_r,
+				       &response, &id, &r_secret, &r_salt);
+	zassert_equal(r, ok, "Error in resumption_request_process");
+
+	request.len = sizeof(request_buf);
+	response.len = sizeof(response_buf);
+	id.len = sizeof(id_buf);
+	r = resumption_request_gen(&i_store, &c_r, &id_cred_r, &fresh,
+				   &request);
+	zassert_equal(r, ok, "Error in resumption_request_gen");
+	r = resumption_request_process(&r_store, &request, &fresh, &response,
+				       &id, &r_secret, &r_salt);
+	zassert_equal(r, ok, "Error in resumption_request_process");
+	zassert_equal(id.len, c_r.len, "wrong C_R");
+	zassert_mem_equal__(id.ptr, c_r.ptr, c_r.len, "wrong C_R");
+	r = resumption_response_process(&i_store, &c_r, &id_cred_r, &response,
+					&i_secret, &i_salt);
+	zassert_equal(r, ok, "Error in resumption_response_process");
+	zassert_mem_equal__(i_secret.ptr, expected.ptr, i_secret.len,
+			    "wrong master secret");
+	zassert_mem_equal__(r_secret.ptr, expected.ptr, r_secret.len,
+			    "wrong master secret");
+	zassert_mem_equal__(i_salt.ptr, r_salt.ptr, i_salt.len,
+			    "wrong master salt");
+
+	/* a forged request after the response replaces the pending nonces of
+	 * the responder */
+	uint8_t forged_buf[RESUMPTION_REQUEST_SIZE];
+	uint8_t forged_response_buf[RESUMPTION_RESPONSE_SIZE];
+	memcpy(forged_buf, request_buf, request.len);
+	forged_buf[request.len - 1] ^= 0x01;
+	struct byte_array forged = BYTE_ARRAY_INIT(forged_buf, request.len);
+	struct byte_array forged_response = BYTE_ARRAY_INIT(
+		forged_response_buf, sizeof(forged_response_buf));
+	id.len = sizeof(id_buf);
+	r = resumption_request_process(&r_store, &forged, &fresh,
+				       &forged_response, &id, &r_secret,
+				       &r_salt);
+	zassert_equal(r, ok, "Error in resumption_request_process");
+	zassert_true(0 != memcmp(r_secret.ptr, expected.ptr, r_secret.len),
+		     "same master secret for another N_I");
+
+	/* the confirmation replaces PRK_out on both sides with the nonces of
+	 * the exchange that worked */
+	r = resumption_store_confirm(&r_store, &other_id, NULL, &request,
+				     &response);
+	zassert_equal(r, wrong_parameter, "request of another C_R accepted");
+	r = resumption_store_confirm(&i_store, &c_r, &id_cred_r, &request,
+				     &response);
+	zassert_equal(r, ok, "Error in resumption_store_confirm");
+	r = resumption_store_confirm(&r_store, &c_r, NULL, &request,
+				     &response);
+	zassert_equal(r, ok, "Error in resumption_store_confirm");
+	r = resumption_store_confirm(&r_store, &c_r, NULL, &request,
+				     &response);
+	zassert_equal(r, resumption_not_found, "nothing pending");
+	r = resumption_store_resume(&i_store, &c_r, &id_cred_r, &nonce_i,
+				    &nonce_r, &i_secret, &i_salt);
+	zassert_equal(r, ok, "Error in resumption_store_resume");
+	r = resumption_store_resume(&r_store, &c_r, NULL, &nonce_i, &nonce_r,
+				    &r_secret, &r_salt);
+	zassert_equal(r, ok, "Error in resumption_store_resume");
+	zassert_mem_equal__(i_secret.ptr, r_secret.ptr, i_secret.len,
+			    "wrong master secret");
+	zassert_true(0 != memcmp(i_secret.ptr, expected.ptr, i_secret.len),
+		     "PRK_out not updated");
+
+	/* the initiator keeps its entries under the identity of the peer */
+	r = resumption_store_put(&i_store, &c_r, NULL, SUITE_2, &prk_out);
+	zassert_equal(r, wrong_parameter, "entry without peer identity");
+
+	/* removed entries are gone */
+	resumption_store_remove(&i_store, &c_r, &id_cred_r);
+	request.len = sizeof(request_buf);
+	r = resumption_request_gen(&i_store, &c_r, &id_cred_r, &nonce_i,
+				   &request);
+	zassert_equal(r, resumption_not_found, "entry not removed");
+}
+
+static struct context combined_i_oscore_c;
+static struct context combined_r_oscore_c;
+
+void t_edhoc_oscore_combined_request(void)
+{
+	int vec_num_i = 0;
+	enum err r;
+	enum edhoc_step_status status;
+	struct byte_array msg1, msg2;
+	struct edhoc_responder_session *s;
+	uint8_t combined[512];
+	uint32_t combined_len = sizeof(combined);
+	uint8_t oscore_req[512];
+	uint32_t oscore_req_len = sizeof(oscore_req);
+	uint8_t coap_out[256];
+	uint32_t coap_out_len = sizeof(coap_out);
+	struct byte_array msg3, kid;
+	/* CON GET with token 0x4a and Uri-Path "tv1" */
+	uint8_t coap_req[] = { 0x41, 0x01, 0x00, 0x01, 0x4a,
+			       0xb3, 0x74, 0x76, 0x31 };
+
+	struct edhoc_initiator_context c_i;
+	struct other_party_cred cred_r;
+	struct edhoc_responder_context c_r;
+	struct other_party_cred cred_i;
+
+	initiator_context_set(vec_num_i, &c_i, &cred_r);
+	responder_context_set(vec_num_i, &c_r, &cred_i);
+	struct cred_array cred_r_array = { .len = 1, .ptr = &cred_r };
+	struct cred_array cred_i_array = { .len = 1, .ptr = &cred_i };
+
+	edhoc_responder_session_table_init(&session_table, &c_r, &cred_i_array,
+					   10);
+	edhoc_initiator_session_init(&initiator_session, &c_i, &cred_r_array);
+	r = edhoc_initiator_session_step(&initiator_session, NULL, &msg1,
+					 &status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+	r = edhoc_responder_session_table_msg1(&session_table, 0, &msg1, &msg2,
+					       &s);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_table_msg1");
+
+	/* message_3 and the first request are sent in one message */
+	r = edhoc_initiator_combined_request(&initiator_session, &msg2,
+					     coap_req, sizeof(coap_req),
+					     &combined_i_oscore_c, combined,
+					     &combined_len);
+#ifdef MESSAGE_4
+	/* message_4 cannot be sent with the combined request */
+	zassert_equal(r, not_supported_feature,
+		      "combined request sent with MESSAGE_4");
+	r = edhoc_responder_combined_request(&session_table, combined,
+					     combined_len, &combined_r_oscore_c,
+					     coap_out, &coap_out_len, &s);
+	zassert_equal(r, not_supported_feature,
+		      "combined request accepted with MESSAGE_4");
+	return;
+#endif
+	zassert_equal(r, ok, "Error in edhoc_initiator_combined_request");
+
+	/* the request carries the EDHOC option, C_R and message_3 */
+	r = oscore_edhoc_request_split(combined, combined_len, &msg3, &kid,
+				       oscore_req, &oscore_req_len);
+	zassert_equal(r, ok, "Error in oscore_edhoc_request_split");
+	zassert_equal(msg3.len, initiator_session.rc.msg.len,
+		      "wrong message_3");
+	zassert_mem_equal__(msg3.ptr, initiator_session.rc.msg.ptr, msg3.len,
+			    "wrong message_3");
+	zassert_equal(kid.len, initiator_session.c_r.len, "wrong KID");
+	zassert_mem_equal__(kid.ptr, initiator_session.c_r.ptr, kid.len,
+			    "wrong KID");
+	r = oscore_edhoc_request_split(oscore_req, oscore_req_len, &msg3, &kid,
+				       coap_out, &coap_out_len);
+	zassert_equal(r, oscore_no_edhoc_option, "EDHOC option not removed");
+
+	/* the responder completes the handshake and gets the request */
+	coap_out_len = sizeof(coap_out);
+	r = edhoc_responder_combined_request(&session_table, combined,
+					     combined_len, &combined_r_oscore_c,
+					     coap_out, &coap_out_len, &s);
+	zassert_equal(r, ok, "Error in edhoc_responder_combined_request");
+	zassert_mem_equal__(initiator_session.prk_out.ptr, s->prk_out.ptr,
+			    s->prk_out.len, "wrong prk_out");
+	zassert_equal(coap_out_len, sizeof(coap_req), "wrong request");
+	zassert_mem_equal__(coap_out, coap_req, sizeof(coap_req),
+			    "wrong request");
+	edhoc_responder_session_table_release(&session_table, s);
+
+	/* a second combined request of the same handshake is rejected */
+	coap_out_len = sizeof(coap_out);
+	r = edhoc_responder_combined_request(&session_table, combined,
+					     combined_len, &combined_r_oscore_c,
+					     coap_out, &coap_out_len, &s);
+	zassert_equal(r, edhoc_session_not_found, "request accepted twice");
+
+	/* the context takes the application algorithms of the suite, OSCORE
+	 * has no AES-CCM-16-128-128 */
+	struct suite suite = initiator_session.rc.suite;
+	suite.app_aead = AES_CCM_16_128_128;
+	r = edhoc_oscore_context_derive(&suite, &initiator_session.prk_out,
+					&initiator_session.c_r,
+					&initiator_session.c->c_i,
+					&combined_i_oscore_c);
+	zassert_equal(r, oscore_invalid_algorithm_aead,
+		      "unsupported AEAD algorithm accepted");
+}
+
+void t_edhoc_admission(void)
+{
+	int vec_num_i = 0;
+	enum err r;
+	enum edhoc_step_status status;
+	struct byte_array msg1, msg2;
+	struct edhoc_responder_session *s;
+	struct edhoc_admission_bucket buckets[2];
+	struct edhoc_admission a;
+	uint8_t err_msg_buf[EDHOC_ADMISSION_CHALLENGE_SIZE];
+	struct byte_array err_msg =
+		BYTE_ARRAY_INIT(err_msg_buf, sizeof(err_msg_buf));
+	uint8_t source_a_buf[] = { 192, 168, 0, 1, 0x16, 0x33 };
+	uint8_t source_b_buf[] = { 192, 168, 0, 2, 0x16, 0x33 };
+	struct byte_array source_a =
+		BYTE_ARRAY_INIT(source_a_buf, sizeof(source_a_buf));
+	struct byte_array source_b =
+		BYTE_ARRAY_INIT(source_b_buf, sizeof(source_b_buf));
+	uint8_t key_buf[EDHOC_ADMISSION_KEY_SIZE] = { 0x01, 0x02, 0x03 };
+	struct byte_array key = BYTE_ARRAY_INIT(key_buf, sizeof(key_buf));
+
+	struct edhoc_initiator_context c_i;
+	struct other_party_cred cred_r;
+	struct edhoc_responder_context c_r;
+	struct other_party_cred cred_i;
+
+	initiator_context_set(vec_num_i, &c_i, &cred_r);
+	responder_context_set(vec_num_i, &c_r, &cred_i);
+	struct cred_array cred_r_array = { .len = 1, .ptr = &cred_r };
+	struct cred_array cred_i_array = { .len = 1, .ptr = &cred_i };
+
+	edhoc_responder_session_table_init(&session_table, &c_r, &cred_i_array,
+					   10);
+	edhoc_admission_init(&a, &c_r, &session_table, buckets, 2, 10, 2);
+	edhoc_initiator_session_init(&initiator_session, &c_i, &cred_r_array);
+	r = edhoc_initiator_session_step(&initiator_session, NULL, &msg1,
+					 &status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+
+	/* a source may send burst messages at once, then one per period */
+	r = edhoc_admission_msg1(&a, &source_a, 0, &msg1, &err_msg);
+	zassert_equal(r, ok, "message not admitted");
+	r = edhoc_admission_msg1(&a, &source_a, 0, &msg1, &err_msg);
+	zassert_equal(r, ok, "message not admitted");
+	r = edhoc_admission_msg1(&a, &source_a, 9, &msg1, &err_msg);
+	zassert_equal(r, admission_rate_limited, "message not rate limited");
+	r = edhoc_admission_msg1(&a, &source_b, 9, &msg1, &err_msg);
+	zassert_equal(r, ok, "other source rate limited");
+	r = edhoc_admission_msg1(&a, &source_a, 10, &msg1, &err_msg);
+	zassert_equal(r, ok, "token not added");
+
+	/* a truncated message is rejected before any crypto */
+	struct byte_array truncated = BYTE_ARRAY_INIT(msg1.ptr, msg1.len - 1);
+	r = edhoc_admission_msg1(&a, &source_b, 10, &truncated, &err_msg);
+	zassert_equal(r, admission_malformed_message, "message not rejected");
+
+	/* an unsupported selected suite is admitted to be answered with
+	 * SUITES_R */
+	uint8_t other_suite =
+		(uint8_t)(c_i.suites_i.ptr[c_i.suites_i.len - 1] ^ 0x01);
+	struct byte_array suites_r = c_r.suites_r;
+	c_r.suites_r.ptr = &other_suite;
+	c_r.suites_r.len = 1;
+	r = edhoc_admission_msg1(&a, &source_a, 20, &msg1, &err_msg);
+	zassert_equal(r, ok, "unsupported selected suite not admitted");
+	c_r.suites_r = suites_r;
+
+	/* the budget counts the handshakes in the table */
+	a.max_in_progress = 1;
+	r = edhoc_responder_session_table_msg1(&session_table, 20, &msg1, &msg2,
+					       &s);
+	zassert_equal(r, ok, "Error in edhoc_responder_session_table_msg1");
+	r = edhoc_admission_msg1(&a, &source_b, 20, &msg1, &err_msg);
+	zassert_equal(r, admission_busy, "budget not applied");
+	edhoc_responder_session_table_release(&session_table, s);
+
+	/* with a challenge only initiators with a valid cookie are admitted */
+	r = edhoc_admission_challenge_enable(&a, &key, 0, 100);
+	zassert_equal(r, ok, "Error in edhoc_admission_challenge_enable");
+	r = edhoc_admission_msg1(&a, &source_b, 40, &msg1, &err_msg);
+	zassert_equal(r, admission_challenge_sent, "no challenge sent");
+#if EAD_SIZE >= EDHOC_ADMISSION_CHALLENGE_SIZE
+	uint8_t ead_1_buf[EDHOC_ADMISSION_CHALLENGE_SIZE];
+	c_i.ead_1.ptr = ead_1_buf;
+	c_i.ead_1.len = sizeof(ead_1_buf);
+	r = edhoc_admission_challenge_answer(&err_msg, &c_i.ead_1);
+	zassert_equal(r, ok, "Error in edhoc_admission_challenge_answer");
+	edhoc_initiator_session_init(&initiator_session, &c_i, &cred_r_array);
+	r = edhoc_initiator_session_step(&initiator_session, NULL, &msg1,
+					 &status);
+	zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+	r = edhoc_admission_msg1(&a, &source_b, 50, &msg1, &err_msg);
+	zassert_equal(r, ok, "valid cookie not accepted");
+	err_msg.len = sizeof(err_msg_buf);
+	r = edhoc_admission_msg1(&a, &source_a, 50, &msg1, &err_msg);
+	zassert_equal(r, admission_challenge_sent, "cookie of other source");
+	zassert_equal(a.metrics.admitted, 6, "wrong metrics");
+	zassert_equal(a.metrics.challenged, 2, "wrong metrics");
+#else
+	zassert_equal(a.metrics.admitted, 5, "wrong metrics");
+	zassert_equal(a.metrics.challenged, 1, "wrong metrics");
+#endif
+	zassert_equal(a.metrics.rate_limited, 1, "wrong metrics");
+	zassert_equal(a.metrics.malformed, 1, "wrong metrics");
+	zassert_equal(a.metrics.busy, 1, "wrong metrics");
+}
+
+static struct suite_cache_entry suite_cache_entries[2];
+static struct suite_cache suite_cache;
+
+void t_edhoc_suite_cache(void)
+{
+	int vec_num_i = 0;
+	enum err r;
+	enum edhoc_step_status i_status, r_status;
+	struct byte_array i_out, r_out;
+	uint8_t peer_buf[] = { 192, 168, 0, 1, 0x16, 0x33 };
+	struct byte_array peer = BYTE_ARRAY_INIT(peer_buf, sizeof(peer_buf));
+	uint8_t cached = 0;
+
+	struct edhoc_initiator_context c_i;
+	struct other_party_cred cred_r;
+	struct edhoc_responder_context c_r;
+	struct other_party_cred cred_i;
+
+	initiator_context_set(vec_num_i, &c_i, &cred_r);
+	responder_context_set(vec_num_i, &c_r, &cred_i);
+	struct cred_array cred_r_array = { .len = 1, .ptr = &cred_r };
+	struct cred_array cred_i_array = { .len = 1, .ptr = &cred_i };
+
+	/* the responder supports only the suite of the test vector. The 
+	 * initiator prefers it but selects the other suite with the same 
+	 * curve, so the ephemeral key of the context can be used for both */
+	uint8_t suite = c_i.suites_i.ptr[c_i.suites_i.len - 1];
+	uint8_t suites_i[] = { suite, (uint8_t)(suite ^ 1) };
+	uint8_t suites_r[] = { suite };
+	c_i.suites_i.ptr = suites_i;
+	c_i.suites_i.len = sizeof(suites_i);
+	c_r.suites_r.ptr = suites_r;
+	c_r.suites_r.len = sizeof(suites_r);
+
+	suite_cache_init(&suite_cache, suite_cache_entries, 2, 100);
+	suite_cache_register(&suite_cache);
+
+	for (uint32_t n = 0; n < 2; n++) {
+		edhoc_initiator_session_init(&initiator_session, &c_i,
+					     &cred_r_array);
+		edhoc_initiator_session_peer_set(&initiator_session, &peer);
+		edhoc_responder_session_init(&responder_session, &c_r,
+					     &cred_i_array);
+
+		r = edhoc_initiator_session_step(&initiator_session, NULL,
+						 &i_out, &i_status);
+		zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+
+		if (0 == n) {
+			/* the responder answers with SUITES_R */
+			r = edhoc_responder_session_step(&responder_session,
+							 &i_out, &r_out,
+							 &r_status);
+			zassert_equal(r, error_message_sent,
+				      "no error message sent");
+			zassert_equal(r_status, EDHOC_STEP_SEND,
+				      "wrong status");
+			zassert_equal(r_out.len, 2, "wrong error message");
+			zassert_equal(r_out.ptr[0],
+				      ERR_CODE_WRONG_SELECTED_CIPHER_SUITE,
+				      "wrong ERR_CODE");
+			zassert_equal(r_out.ptr[1], suite, "wrong SUITES_R");
+
+			/* the initiator sends message 1 again */
+			r = edhoc_initiator_session_step(&initiator_session,
+							 &r_out, &i_out,
+							 &i_status);
+			zassert_equal(r, ok,
+				      "Error in edhoc_initiator_session_step");
+			zassert_equal(i_status, EDHOC_STEP_SEND,
+				      "wrong status");
+			edhoc_responder_session_init(&responder_session, &c_r,
+						     &cred_i_array);
+
+			/* the unauthenticated error message is not cached */
+			zassert_false(suite_cache_get(&peer, &cached),
+				      "suite cached before message 2");
+		}
+
+		/* SUITES_I is the supported suite only, in the second 
+		 * handshake taken from the cache */
+		zassert_equal(i_out.ptr[1], suite, "wrong SUITES_I");
+
+		r = edhoc_responder_session_step(&responder_session, &i_out,
+						 &r_out, &r_status);
+		zassert_equal(r, ok, "Error in edhoc_responder_session_step");
+		r = edhoc_initiator_session_step(&initiator_session, &r_out,
+						 &i_out, &i_status);
+		zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+		r = edhoc_responder_session_step(&responder_session, &i_out,
+						 &r_out, &r_status);
+		zassert_equal(r, ok, "Error in edhoc_responder_session_step");
+#ifdef MESSAGE_4
+		r = edhoc_initiator_session_step(&initiator_session, &r_out,
+						 &i_out, &i_status);
+		zassert_equal(r, ok, "Error in edhoc_initiator_session_step");
+#endif
+		zassert_equal(i_status, EDHOC_STEP_DONE, "wrong status");
+		zassert_mem_equal__(initiator_session.prk_out.ptr,
+				    responder_session.prk_out.ptr,
+				    responder_session.prk_out.len,
+				    "wrong prk_out");
+		zassert_true(suite_cache_get(&peer, &cached),
+			     "suite not cached");
+		zassert_equal(cached, suite, "wrong suite cached");
+	}
+
+	suite_cache_register(NULL);
+}
+
+static uint32_t provider_calls;
+static uint32_t provider_keys;
+
+static enum err counting_hash(enum hash_alg alg, const struct byte_array *in,
+			      struct byte_array *out)
+{
+	provider_calls++;
+	return crypto_provider_builtin.hash(alg, in, out);
+}
+
+static enum err counting_aead(enum aes_operation op,
+			      const struct byte_array *in,
+			      const struct byte_array *key,
+			      struct byte_array *nonce,
+			      const struct byte_array *aad,
+			      struct byte_array *out, struct byte_array *tag)
+{
+	provider_calls++;
+	return crypto_provider_builtin.aead(op, in, key, nonce, aad, out, tag);
+}
+
+static enum err counting_hkdf_extract(enum hash_alg alg,
+				      const struct byte_array *salt,
+				      struct byte_array *ikm, uint8_t *out)
+{
+	provider_calls++;
+	return crypto_provider_builtin.hkdf_extract(alg, salt, ikm, out);
+}
+
+static enum err counting_hkdf_expand(enum hash_alg alg,
+				     const struct byte_array *prk,
+				     const struct byte_array *info,
+				     struct byte_array *out)
+{
+	provider_calls++;
+	return crypto_provider_builtin.hkdf_expand(alg, prk, info, out);
+}
+
+static uint32_t sign_calls;
+static uint32_t verify_calls;
+
+static enum err counting_sign(enum sign_alg alg, const struct byte_array *sk,
+			      const struct byte_array *pk,
+			      const struct byte_array *msg, uint8_t *out)
+{
+	sign_calls++;
+	return crypto_provider_builtin.sign(alg, sk, pk, msg, out);
+}
+
+static enum err counting_verify(enum sign_alg alg, const struct byte_array *pk,
+				struct const_byte_array *msg,
+				struct const_byte_array *sgn, bool *result)
+{
+	verify_calls++;
+	return crypto_provider_builtin.verify(alg, pk, msg, sgn, result);
+}
+
+static enum err counting_sign_hash(enum sign_alg alg,
+				   const struct byte_array *sk,
+				   const struct byte_array *pk,
+				   const struct byte_array *msg_hash,
+				   uint8_t *out)
+{
+	provider_calls++;
+	return crypto_provider_builtin.sign_hash(alg, sk, pk, msg_hash, out);
+}
+
+static enum err counting_verify_hash(enum sign_alg alg,
+				     const struct byte_array *pk,
+				     const struct byte_array *msg_hash,
+				     struct const_byte_array *sgn, bool *result)
+{
+	provider_calls++;
+	return crypto_provider_builtin.verify_hash(alg, pk, msg_hash, sgn,
+						   result);
+}
+
+static enum err counting_key_import(struct crypto_key *key)
+{
+	provider_keys++;
+	return ok;
+}
+
+static void counting_key_release(struct crypto_key *key)
+{
+	provider_keys--;
+}
+
+static enum err wrong_hash(enum hash_alg alg, const struct byte_array *in,
+			   struct byte_array *out)
+{
+	memset(out->ptr, 0, HASH_SIZE);
+	out->len = HASH_SIZE;
+	return ok;
+}
+
+static const struct crypto_provider counting_provider = {
+	.name = "counting",
+	.hash = counting_hash,
+	.aead = counting_aead,
+	.hkdf_extract = counting_hkdf_extract,
+	.hkdf_expand = counting_hkdf_expand,
+	.key_import = counting_key_import,
+	.key_release = counting_key_release,
+};
+
+static const struct crypto_provider counting_sign_provider = {
+	.name = "counting sign",
+	.sign = counting_sign,
+	.verify = counting_verify,
+};
+
+static const struct crypto_provider counting_sign_hash_provider = {
+	.name = "counting sign hash",
+	.sign = counting_sign,
+	.verify = counting_verify,
+	.sign_hash = counting_sign_hash,
+	.verify_hash = counting_verify_hash,
+};
+
+static const struct crypto_provider wrong_provider = {
+	.name = "wrong",
+	.hash = wrong_hash,
+};
+
+void t_crypto_provider(void)
+{
+	enum err r;
+	const struct crypto_provider *selected = NULL;
+	uint8_t msg_buf[] = { 'a', 'b', 'c' };
+	struct byte_array msg = BYTE_ARRAY_INIT(msg_buf, sizeof(msg_buf));
+	uint8_t h1_buf[HASH_SIZE];
+	uint8_t h2_buf[HASH_SIZE];
+	struct byte_array h1 = BYTE_ARRAY_INIT(h1_buf, sizeof(h1_buf));
+	struct byte_array h2 = BYTE_ARRAY_INIT(h2_buf, sizeof(h2_buf));
+
+	/* without registrations the built-in engine is used */
+	zassert_is_null(crypto_provider_get(CRYPTO_OP_HASH, SHA_256),
+			"unexpected provider");
+	r = hash(SHA_256, &msg, &h1);
+	zassert_equal(r, ok, "Error in hash");
+
+	/* the last registered provider is used */
+	r = crypto_provider_register(CRYPTO_OP_HASH, SHA_256,
+				     &crypto_provider_builtin);
+	zassert_equal(r, ok, "Error in crypto_provider_register");
+	r = crypto_provider_register(CRYPTO_OP_HASH, SHA_256,
+				     &counting_provider);
+	zassert_equal(r, ok, "Error in crypto_provider_register");
+	provider_calls = 0;
+	r = hash(SHA_256, &msg, &h2);
+	zassert_equal(r, ok, "Error in hash");
+	zassert_equal(provider_calls, 1, "provider not used");
+	zassert_mem_equal__(h1_buf, h2_buf, HASH_SIZE, "wrong hash");
+
+	/* a provider can only be registered for what it implements */
+	r = crypto_provider_register(CRYPTO_OP_SIGN, EdDSA, &wrong_provider);
+	zassert_equal(r, wrong_parameter, "wrong result");
+
+	/* the benchmark never selects a provider with a wrong result */
+	r = crypto_provider_register(CRYPTO_OP_HASH, SHA_256, &wrong_provider);
+	zassert_equal(r, ok, "Error in crypto_provider_register");
+	r = crypto_provider_benchmark(CRYPTO_OP_HASH, SHA_256, 10,
+				      k_cycle_get_32, &selected);
+	zassert_equal(r, ok, "Error in crypto_provider_benchmark");
+	zassert_not_equal(selected, &wrong_provider, "wrong provider");
+	zassert_equal(crypto_provider_get(CRYPTO_OP_HASH, SHA_256), selected,
+		      "benchmark result not used");
+	r = hash(SHA_256, &msg, &h2);
+	zassert_equal(r, ok, "Error in hash");
+	zassert_mem_equal__(h1_buf, h2_buf, HASH_SIZE, "wrong hash");
+
+	/* a prepared key gives the same result as aead() */
+	r = crypto_provider_register(CRYPTO_OP_AEAD, AES_CCM_16_64_128,
+				     &counting_provider);
+	zassert_equal(r, ok, "Error in crypto_provider_register");
+	uint8_t key_buf[16] = { 1, 2, 3 };
+	uint8_t nonce_buf[AEAD_IV_SIZE] = { 4, 5, 6 };
+	/*aead() writes the tag after the ciphertext too*/
+	uint8_t ct1_buf[sizeof(msg_buf) + 8];
+	uint8_t ct2_buf[sizeof(msg_buf) + 8];
+	uint8_t tag1_buf[8];
+	uint8_t tag2_buf[8];
+	struct byte_array key = BYTE_ARRAY_INIT(key_buf, sizeof(key_buf));
+	struct byte_array nonce = BYTE_ARRAY_INIT(nonce_buf, sizeof(nonce_buf));
+	struct byte_array ct1 = BYTE_ARRAY_INIT(ct1_buf, sizeof(msg_buf));
+	struct byte_array ct2 = BYTE_ARRAY_INIT(ct2_buf, sizeof(msg_buf));
+	struct byte_array tag1 = BYTE_ARRAY_INIT(tag1_buf, sizeof(tag1_buf));
+	struct byte_array tag2 = BYTE_ARRAY_INIT(tag2_buf, sizeof(tag2_buf));
+	struct crypto_key k;
+
+	r = aead(ENCRYPT, &msg, &key, &nonce, &NULL_ARRAY, &ct1, &tag1);
+	zassert_equal(r, ok, "Error in aead");
+	r = crypto_key_import(AES_CCM_16_64_128, &key, &k);
+	zassert_equal(r, ok, "Error in crypto_key_import");
+	zassert_equal(provider_keys, 1, "key not imported");
+	r = aead_with_key(ENCRYPT, &k, &msg, &nonce, &NULL_ARRAY, &ct2,
+			  &tag2);
+	zassert_equal(r, ok, "Error in aead_with_key");
+	zassert_mem_equal__(ct1_buf, ct2_buf, sizeof(ct1_buf),
+			    "wrong ciphertext");
+	zassert_mem_equal__(tag1_buf, tag2_buf, sizeof(tag1_buf),
+			    "wrong tag");
+	crypto_key_release(&k);
+	zassert_equal(provider_keys, 0, "key not released");
+
+	/* EDHOC-KDF under a PRK prepared after the registration of an HKDF 
+	 * provider uses the provider */
+	uint8_t prk_buf[HASH_SIZE] = { 7, 8, 9 };
+	uint8_t okm1_buf[AEAD_IV_SIZE];
+	uint8_t okm2_buf[AEAD_IV_SIZE];
+	struct byte_array prk = BYTE_ARRAY_INIT(prk_buf, sizeof(prk_buf));
+	struct byte_array okm1 = BYTE_ARRAY_INIT(okm1_buf, sizeof(okm1_buf));
+	struct byte_array okm2 = BYTE_ARRAY_INIT(okm2_buf, sizeof(okm2_buf));
+	struct prk_handle h;
+
+	r = edhoc_kdf(SHA_256, &prk, IV_3, &msg, &okm1);
+	zassert_equal(r, ok, "Error in edhoc_kdf");
+	r = crypto_provider_register(CRYPTO_OP_HKDF, SHA_256,
+				     &counting_provider);
+	zassert_equal(r, ok, "Error in crypto_provider_register");
+	r = prk_handle_init(SHA_256, &prk, &h);
+	zassert_equal(r, ok, "Error in prk_handle_init");
+	provider_calls = 0;
+	r = edhoc_kdf_handle(&h, IV_3, &msg, 1, &okm2);
+	zassert_equal(r, ok, "Error in edhoc_kdf_handle");
+	zassert_equal(provider_calls, 1, "provider not used");
+	zassert_mem_equal__(okm1_buf, okm2_buf, sizeof(okm1_buf),
+			    "wrong okm");
+	prk_handle_wipe(&h);
+
+	/* ES256 signatures of a provider without sign_hash are made by sign() 
+	 * of the whole Sig_structure, test vector 1 is an ES256 handshake */
+	crypto_provider_unregister_all();
+	r = crypto_provider_register(CRYPTO_OP_SIGN, ES256,
+				     &counting_sign_provider);
+	zassert_equal(r, ok, "Error in crypto_provider_register");
+	r = crypto_provider_register(CRYPTO_OP_VERIFY, ES256,
+				     &counting_sign_provider);
+	zassert_equal(r, ok, "Error in crypto_provider_register");
+	sign_calls = 0;
+	verify_calls = 0;
+	(void)session_handshake_key_setups(0);
+	zassert_equal(sign_calls, 2, "sign() of the provider not used");
+	zassert_true(verify_calls >= 2, "verify() of the provider not used");
+
+	/* with sign_hash the provider signs the streamed hash */
+	r = crypto_provider_register(CRYPTO_OP_SIGN, ES256,
+				     &counting_sign_hash_provider);
+	zassert_equal(r, ok, "Error in crypto_provider_register");
+	r = crypto_provider_register(CRYPTO_OP_VERIFY, ES256,
+				     &counting_sign_hash_provider);
+	zassert_equal(r, ok, "Error in crypto_provider_register");
+	sign_calls = 0;
+	provider_calls = 0;
+	(void)session_handshake_key_setups(0);
+	zassert_equal(sign_calls, 0, "sign() used instead of sign_hash()");
+	zassert_equal(provider_calls, 4, "sign_hash() of the provider not used");
+
+	crypto_provider_unregister_all();
+	zassert_is_null(crypto_provider_get(CRYPTO_OP_AEAD, AES_CCM_16_64_128),
+			"registration not removed");
+}
@@ -0,0 +1,122 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "edhoc.h"
+#include "edhoc/th.h"
+#include "common/crypto_wrapper.h"
+
+/* The draft 16 vectors compute TH_3 and TH_4 as RFC 9528 does.
+ * initiator_responder_interaction.c uses the draft 15 vectors that have
+ * the same names. */
+#define test_vectors th_test_vectors
+#include "edhoc_test_vectors_p256_v16.h"
+#undef test_vectors
+
+#define TH_TEST_VECTORS_CNT                                                    \
+	(sizeof(th_test_vectors) / sizeof(th_test_vectors[0]))
+
+/* Head of a CBOR byte string of HASH_SIZE bytes */
+static const uint8_t bstr_32_head[] = { 0x58, 0x20 };
+
+void t_edhoc_th_streaming(void)
+{
+	enum err r;
+	uint8_t th_buf[HASH_SIZE];
+	uint8_t expected_buf[HASH_SIZE];
+	uint8_t input_buf[2 * (sizeof(bstr_32_head) + HASH_SIZE)];
+	struct byte_array th = BYTE_ARRAY_INIT(th_buf, sizeof(th_buf));
+	struct byte_array expected =
+		BYTE_ARRAY_INIT(expected_buf, sizeof(expected_buf));
+	struct byte_array input = BYTE_ARRAY_INIT(input_buf, 0);
+
+	for (uint32_t v = 0; v < TH_TEST_VECTORS_CNT; v++) {
+		const struct test_vector *t = &th_test_vectors[v];
+		struct byte_array g_y =
+			BYTE_ARRAY_INIT((uint8_t *)t->g_y_raw, t->g_y_raw_len);
+		struct byte_array h_message_1 = BYTE_ARRAY_INIT(
+			(uint8_t *)t->h_message_1_raw, t->h_message_1_raw_len);
+		struct byte_array th_2 = BYTE_ARRAY_INIT((uint8_t *)t->th_2_raw,
+							 t->th_2_raw_len);
+		struct byte_array th_3 = BYTE_ARRAY_INIT((uint8_t *)t->th_3_raw,
+							 t->th_3_raw_len);
+		struct byte_array plaintext_2 = BYTE_ARRAY_INIT(
+			(uint8_t *)t->plaintext_2, t->plaintext_2_len);
+		struct byte_array cred_r =
+			BYTE_ARRAY_INIT((uint8_t *)t->cred_r, t->cred_r_len);
+		struct byte_array cred_i =
+			BYTE_ARRAY_INIT((uint8_t *)t->cred_i, t->cred_i_len);
+
+		/* The TH_2 of the vectors still covers C_R.
+		 * TH_2 = H(bstr(G_Y), bstr(H(message_1))) is checked against
+		 * the one-shot hash of the concatenation. */
+		input.len = 0;
+		memcpy(&input_buf[input.len], bstr_32_head,
+		       sizeof(bstr_32_head));
+		input.len += (uint32_t)sizeof(bstr_32_head);
+		memcpy(&input_buf[input.len], g_y.ptr, g_y.len);
+		input.len += g_y.len;
+		memcpy(&input_buf[input.len], bstr_32_head,
+		       sizeof(bstr_32_head));
+		input.len += (uint32_t)sizeof(bstr_32_head);
+		memcpy(&input_buf[input.len], h_message_1.ptr,
+		       h_message_1.len);
+		input.len += h_message_1.len;
+		expected.len = sizeof(expected_buf);
+		r = hash(SHA_256, &input, &expected);
+		zassert_equal(r, ok, "Error in hash");
+
+		th.len = sizeof(th_buf);
+		r = th2_calculate(SHA_256, &h_message_1, &g_y, &th);
+		zassert_equal(r, ok, "Error in th2_calculate");
+		zassert_mem_equal__(th.ptr, expected.ptr, HASH_SIZE,
+				    "wrong TH_2");
+
+		/* TH_3 = H(bstr(TH_2), PLAINTEXT_2, CRED_R) */
+		th.len = sizeof(th_buf);
+		r = th34_calculate(SHA_256, &th_2, &plaintext_2, &cred_r, &th);
+		zassert_equal(r, ok, "Error in th34_calculate");
+		zassert_mem_equal__(th.ptr, t->th_3_raw, HASH_SIZE,
+				    "wrong TH_3");
+
+		/* TH_4 = H(bstr(TH_3), PLAINTEXT_3, CRED_I). The vectors
+		 * contain PLAINTEXT_3 only in the input of TH_4. */
+		uint32_t head_len = (uint32_t)sizeof(bstr_32_head) + th_3.len;
+		zassert_true(t->input_th_4_len >= head_len + cred_i.len,
+			     "wrong input of TH_4");
+		struct byte_array plaintext_3 = BYTE_ARRAY_INIT(
+			(uint8_t *)t->input_th_4 + head_len,
+			t->input_th_4_len - head_len - cred_i.len);
+		th.len = sizeof(th_buf);
+		r = th34_calculate(SHA_256, &th_3, &plaintext_3, &cred_i, &th);
+		zassert_equal(r, ok, "Error in th34_calculate");
+		zassert_mem_equal__(th.ptr, t->th_4_raw, HASH_SIZE,
+				    "wrong TH_4");
+
+		/* hashing the input of TH_3 byte by byte gives TH_3 too */
+		struct hash_ctx ctx;
+		r = hash_init(SHA_256, &ctx);
+		zassert_equal(r, ok, "Error in hash_init");
+		for (uint32_t i = 0; i < t->input_TH_3_len; i++) {
+			struct byte_array piece = BYTE_ARRAY_INIT(
+				(uint8_t *)&t->input_TH_3[i], 1);
+			r = hash_update(&ctx, &piece);
+			zassert_equal(r, ok, "Error in hash_update");
+		}
+		th.len = sizeof(th_buf);
+		r = hash_final(&ctx, &th);
+		zassert_equal(r, ok, "Error in hash_final");
+		zassert_mem_equal__(th.ptr, t->th_3_raw, HASH_SIZE,
+				    "wrong hash");
+	}
+}
@@ -10,9 +10,11 @@
 #include "oscore.h"
 
 #include "oscore_test_vectors.h"
+#include "edhoc_test_vectors_rfc9529.h"
 
 #include "oscore/oscore_coap.h"
 #include "oscore/option.h"
+#include "oscore/oscore_internal.h"
 
 #include "common/print_util.h"
 
@@ -1185,3 +1187,1003 @@ void t11_oscore_ssn_overflow_protection(void)
 	zassert_equal(result, oscore_ssn_overflow,
 		      "SSN overflow not detected in oscore2coap");
 }
+
+/**
+ * Test 12:
+ * A proxy forwards a request and the corresponding response between a client 
+ * and a server, terminating the OSCORE context of each leg with 
+ * oscore_reprotect().
+ */
+void t12_oscore_proxy_reprotect(void)
+{
+	enum err r;
+
+	/* client <-> proxy leg */
+	struct context c_client;
+	struct oscore_init_params params_client =
+		get_default_params(NORMAL, FRESH);
+	r = oscore_context_init(&params_client, &c_client);
+	zassert_equal(r, ok, "Error in oscore_context_init for client");
+
+	struct context c_proxy_in;
+	struct oscore_init_params params_proxy_in =
+		get_default_params(REVERSED, FRESH);
+	r = oscore_context_init(&params_proxy_in, &c_proxy_in);
+	zassert_equal(r, ok, "Error in oscore_context_init for proxy");
+
+	/* proxy <-> server leg */
+	struct oscore_init_params params_proxy_out = {
+		.master_secret.ptr = (uint8_t *)T3__MASTER_SECRET,
+		.master_secret.len = T3__MASTER_SECRET_LEN,
+		.sender_id.ptr = (uint8_t *)T3__SENDER_ID,
+		.sender_id.len = T3__SENDER_ID_LEN,
+		.recipient_id.ptr = (uint8_t *)T3__RECIPIENT_ID,
+		.recipient_id.len = T3__RECIPIENT_ID_LEN,
+		.master_salt.ptr = (uint8_t *)T3__MASTER_SALT,
+		.master_salt.len = T3__MASTER_SALT_LEN,
+		.id_context.ptr = (uint8_t *)T3__ID_CONTEXT,
+		.id_context.len = T3__ID_CONTEXT_LEN,
+		.aead_alg = OSCORE_AES_CCM_16_64_128,
+		.hkdf = OSCORE_SHA_256,
+		.fresh_master_secret_salt = true,
+	};
+	struct context c_proxy_out;
+	r = oscore_context_init(&params_proxy_out, &c_proxy_out);
+	zassert_equal(r, ok, "Error in oscore_context_init for proxy");
+
+	struct oscore_init_params params_server = {
+		.master_secret.ptr = (uint8_t *)T3__MASTER_SECRET,
+		.master_secret.len = T3__MASTER_SECRET_LEN,
+		.sender_id.ptr = (uint8_t *)T3__RECIPIENT_ID,
+		.sender_id.len = T3__RECIPIENT_ID_LEN,
+		.recipient_id.ptr = (uint8_t *)T3__SENDER_ID,
+		.recipient_id.len = T3__SENDER_ID_LEN,
+		.master_salt.ptr = (uint8_t *)T3__MASTER_SALT,
+		.master_salt.len = T3__MASTER_SALT_LEN,
+		.id_context.ptr = (uint8_t *)T3__ID_CONTEXT,
+		.id_context.len = T3__ID_CONTEXT_LEN,
+		.aead_alg = OSCORE_AES_CCM_16_64_128,
+		.hkdf = OSCORE_SHA_256,
+		.fresh_master_secret_salt = true,
+	};
+	struct context c_server;
+	r = oscore_context_init(&params_server, &c_server);
+	zassert_equal(r, ok, "Error in oscore_context_init for server");
+
+	/*
+	 *
+	 * request: client -> proxy -> server
+	 *
+	 */
+	uint8_t uri_path_val[] = { 't', 'e', 'm', 'p', 'e', 'r',
+				   'a', 't', 'u', 'r', 'e' };
+	uint8_t token[] = { 0x4a };
+	struct o_coap_packet coap_req = {
+		.header = { .ver = 1,
+			    .type = TYPE_CON,
+			    .TKL = 1,
+			    .code = CODE_REQ_GET,
+			    .MID = 0x1 },
+		.token = token,
+		.options_cnt = 1,
+		.options = { { .delta = 11,
+			       .len = sizeof(uri_path_val),
+			       .value = uri_path_val,
+			       .option_number = URI_PATH } },
+		.payload.len = 0,
+		.payload.ptr = NULL,
+	};
+
+	uint8_t ser_coap_req[64];
+	uint32_t ser_coap_req_len = sizeof(ser_coap_req);
+	r = coap_serialize(&coap_req, ser_coap_req, &ser_coap_req_len);
+	zassert_equal(r, ok, "Error in coap_serialize!");
+
+	uint8_t client_leg[64];
+	uint32_t client_leg_len = sizeof(client_leg);
+	r = coap2oscore(ser_coap_req, ser_coap_req_len, client_leg,
+			&client_leg_len, &c_client);
+	zassert_equal(r, ok, "Error in coap2oscore!");
+
+	uint8_t server_leg[64];
+	uint32_t server_leg_len = sizeof(server_leg);
+	r = oscore_reprotect(client_leg, client_leg_len, server_leg,
+			     &server_leg_len, &c_proxy_in, &c_proxy_out);
+	zassert_equal(r, ok, "Error in oscore_reprotect!");
+
+	uint8_t ser_conv_coap[64];
+	uint32_t ser_conv_coap_len = sizeof(ser_conv_coap);
+	r = oscore2coap(server_leg, server_leg_len, ser_conv_coap,
+			&ser_conv_coap_len, &c_server);
+	zassert_equal(r, ok, "Error in oscore2coap!");
+	zassert_equal(ser_conv_coap_len, ser_coap_req_len,
+		      "wrong request length");
+	zassert_mem_equal__(ser_conv_coap, ser_coap_req, ser_coap_req_len,
+			    "oscore_reprotect changed the request");
+
+	/* a replayed request must be rejected by the proxy */
+	server_leg_len = sizeof(server_leg);
+	r = oscore_reprotect(client_leg, client_leg_len, server_leg,
+			     &server_leg_len, &c_proxy_in, &c_proxy_out);
+	zassert_equal(r, oscore_replay_window_protection_error,
+		      "Replayed request not detected by oscore_reprotect!");
+
+	/*
+	 *
+	 * response: server -> proxy -> client
+	 *
+	 */
+	uint8_t payload[] = { '2', '1', ' ', 'C' };
+	struct o_coap_packet coap_resp = {
+		.header = { .ver = 1,
+			    .type = TYPE_ACK,
+			    .TKL = 1,
+			    .code = CODE_RESP_CONTENT,
+			    .MID = 0x1 },
+		.token = token,
+		.options_cnt = 0,
+		.payload.len = sizeof(payload),
+		.payload.ptr = payload,
+	};
+
+	uint8_t ser_coap_resp[64];
+	uint32_t ser_coap_resp_len = sizeof(ser_coap_resp);
+	r = coap_serialize(&coap_resp, ser_coap_resp, &ser_coap_resp_len);
+	zassert_equal(r, ok, "Error in coap_serialize!");
+
+	server_leg_len = sizeof(server_leg);
+	r = coap2oscore(ser_coap_resp, ser_coap_resp_len, server_leg,
+			&server_leg_len, &c_server);
+	zassert_equal(r, ok, "Error in coap2oscore!");
+
+	client_leg_len = sizeof(client_leg);
+	r = oscore_reprotect(server_leg, server_leg_len, client_leg,
+			     &client_leg_len, &c_proxy_out, &c_proxy_in);
+	zassert_equal(r, ok, "Error in oscore_reprotect!");
+
+	ser_conv_coap_len = sizeof(ser_conv_coap);
+	r = oscore2coap(client_leg, client_leg_len, ser_conv_coap,
+			&ser_conv_coap_len, &c_client);
+	zassert_equal(r, ok, "Error in oscore2coap!");
+	zassert_equal(ser_conv_coap_len, ser_coap_resp_len,
+		      "wrong response length");
+	zassert_mem_equal__(ser_conv_coap, ser_coap_resp, ser_coap_resp_len,
+			    "oscore_reprotect changed the response");
+}
+
+/**
+ * Test 13:
+ * - Group OSCORE request and response in group mode between two members
+ * - Tampered countersignatures and messages from unknown members are rejected
+ * - The member table is bounded by OSCORE_GROUP_MAX_MEMBERS and finds the
+ *   members after replacements and removals
+ */
+void t13_oscore_group_mode(void)
+{
+	enum err r;
+	uint8_t gid[] = { 0x37, 0xcb, 0xf3, 0x21, 0x00, 0x17, 0xa2, 0xd3 };
+	uint8_t client_id[] = { 0x25 };
+	uint8_t server_id[] = { 0x52 };
+	struct byte_array client_id_arr =
+		BYTE_ARRAY_INIT(client_id, sizeof(client_id));
+	struct byte_array server_id_arr =
+		BYTE_ARRAY_INIT(server_id, sizeof(server_id));
+	struct byte_array client_cred = BYTE_ARRAY_INIT(
+		(uint8_t *)T1_RFC9529__PK_I, T1_RFC9529__PK_I_LEN);
+	struct byte_array server_cred = BYTE_ARRAY_INIT(
+		(uint8_t *)T1_RFC9529__PK_R, T1_RFC9529__PK_R_LEN);
+
+	struct oscore_group_init_params params_client = {
+		.master_secret.ptr = (uint8_t *)T1__MASTER_SECRET,
+		.master_secret.len = T1__MASTER_SECRET_LEN,
+		.master_salt.ptr = (uint8_t *)T1__MASTER_SALT,
+		.master_salt.len = T1__MASTER_SALT_LEN,
+		.gid = BYTE_ARRAY_INIT(gid, sizeof(gid)),
+		.sender_id = BYTE_ARRAY_INIT(client_id, sizeof(client_id)),
+		.aead_alg = OSCORE_AES_CCM_16_64_128,
+		.hkdf = OSCORE_SHA_256,
+		.sign_alg = EdDSA,
+		.ecdh_alg = X25519,
+		.sender_auth_cred = BYTE_ARRAY_INIT((uint8_t *)T1_RFC9529__PK_I,
+						    T1_RFC9529__PK_I_LEN),
+		.sender_sk = BYTE_ARRAY_INIT((uint8_t *)T1_RFC9529__SK_I,
+					     T1_RFC9529__SK_I_LEN),
+	};
+	struct oscore_group_init_params params_server = {
+		.master_secret.ptr = (uint8_t *)T1__MASTER_SECRET,
+		.master_secret.len = T1__MASTER_SECRET_LEN,
+		.master_salt.ptr = (uint8_t *)T1__MASTER_SALT,
+		.master_salt.len = T1__MASTER_SALT_LEN,
+		.gid = BYTE_ARRAY_INIT(gid, sizeof(gid)),
+		.sender_id = BYTE_ARRAY_INIT(server_id, sizeof(server_id)),
+		.aead_alg = OSCORE_AES_CCM_16_64_128,
+		.hkdf = OSCORE_SHA_256,
+		.sign_alg = EdDSA,
+		.ecdh_alg = X25519,
+		.sender_auth_cred = BYTE_ARRAY_INIT((uint8_t *)T1_RFC9529__PK_R,
+						    T1_RFC9529__PK_R_LEN),
+		.sender_sk = BYTE_ARRAY_INIT((uint8_t *)T1_RFC9529__SK_R,
+					     T1_RFC9529__SK_R_LEN),
+	};
+
+	struct group_context c_client;
+	struct group_context c_server;
+	r = oscore_group_context_init(&params_client, &c_client);
+	zassert_equal(r, ok, "Error in oscore_group_context_init for client");
+	r = oscore_group_context_init(&params_server, &c_server);
+	zassert_equal(r, ok, "Error in oscore_group_context_init for server");
+
+	/* the server does not know the client yet */
+	r = oscore_group_member_add(&c_client, &server_id_arr, &server_cred);
+	zassert_equal(r, ok, "Error in oscore_group_member_add");
+
+	uint8_t uri_path_val[] = { 't', 'e', 'm', 'p', 'e', 'r',
+				   'a', 't', 'u', 'r', 'e' };
+	uint8_t token[] = { 0x4a };
+	struct o_coap_packet coap_req = {
+		.header = { .ver = 1,
+			    .type = TYPE_NON,
+			    .TKL = 1,
+			    .code = CODE_REQ_GET,
+			    .MID = 0x1 },
+		.token = token,
+		.options_cnt = 1,
+		.options = { { .delta = 11,
+			       .len = sizeof(uri_path_val),
+			       .value = uri_path_val,
+			       .option_number = URI_PATH } },
+		.payload.len = 0,
+		.payload.ptr = NULL,
+	};
+
+	uint8_t ser_coap_req[64];
+	uint32_t ser_coap_req_len = sizeof(ser_coap_req);
+	r = coap_serialize(&coap_req, ser_coap_req, &ser_coap_req_len);
+	zassert_equal(r, ok, "Error in coap_serialize!");
+
+	uint8_t group_req[128];
+	uint32_t group_req_len = sizeof(group_req);
+	r = coap2oscore_group(ser_coap_req, ser_coap_req_len, group_req,
+			      &group_req_len, &c_client, OSCORE_GROUP_MODE,
+			      NULL);
+	zassert_equal(r, ok, "Error in coap2oscore_group!");
+
+	uint8_t ser_conv_coap[128];
+	uint32_t ser_conv_coap_len = sizeof(ser_conv_coap);
+	r = oscore2coap_group(group_req, group_req_len, ser_conv_coap,
+			      &ser_conv_coap_len, &c_server);
+	zassert_equal(r, oscore_group_member_not_found,
+		      "Message of an unknown member accepted");
+
+	r = oscore_group_member_add(&c_server, &client_id_arr, &client_cred);
+	zassert_equal(r, ok, "Error in oscore_group_member_add");
+
+	/* a flipped bit in the encrypted countersignature */
+	group_req[group_req_len - 1] ^= 0x01;
+	ser_conv_coap_len = sizeof(ser_conv_coap);
+	r = oscore2coap_group(group_req, group_req_len, ser_conv_coap,
+			      &ser_conv_coap_len, &c_server);
+	zassert_equal(r, oscore_group_signature_invalid,
+		      "Tampered countersignature accepted");
+	group_req[group_req_len - 1] ^= 0x01;
+
+	ser_conv_coap_len = sizeof(ser_conv_coap);
+	r = oscore2coap_group(group_req, group_req_len, ser_conv_coap,
+			      &ser_conv_coap_len, &c_server);
+	zassert_equal(r, ok, "Error in oscore2coap_group!");
+	zassert_equal(ser_conv_coap_len, ser_coap_req_len,
+		      "wrong request length");
+	zassert_mem_equal__(ser_conv_coap, ser_coap_req, ser_coap_req_len,
+			    "wrong request");
+
+	/* replayed request */
+	ser_conv_coap_len = sizeof(ser_conv_coap);
+	r = oscore2coap_group(group_req, group_req_len, ser_conv_coap,
+			      &ser_conv_coap_len, &c_server);
+	zassert_equal(r, oscore_replay_window_protection_error,
+		      "Replayed request accepted");
+
+	/* the pairwise mode requires ES256 and P-256 */
+	uint8_t pairwise_req[128];
+	uint32_t pairwise_req_len = sizeof(pairwise_req);
+	r = coap2oscore_group(ser_coap_req, ser_coap_req_len, pairwise_req,
+			      &pairwise_req_len, &c_client,
+			      OSCORE_PAIRWISE_MODE, &server_id_arr);
+	zassert_equal(r, not_supported_feature,
+		      "Pairwise mode used with EdDSA");
+
+	uint8_t payload[] = { '2', '1', ' ', 'C' };
+	struct o_coap_packet coap_resp = {
+		.header = { .ver = 1,
+			    .type = TYPE_NON,
+			    .TKL = 1,
+			    .code = CODE_RESP_CONTENT,
+			    .MID = 0x2 },
+		.token = token,
+		.options_cnt = 0,
+		.payload.len = sizeof(payload),
+		.payload.ptr = payload,
+	};
+
+	uint8_t ser_coap_resp[64];
+	uint32_t ser_coap_resp_len = sizeof(ser_coap_resp);
+	r = coap_serialize(&coap_resp, ser_coap_resp, &ser_coap_resp_len);
+	zassert_equal(r, ok, "Error in coap_serialize!");
+
+	uint8_t group_resp[128];
+	uint32_t group_resp_len = sizeof(group_resp);
+	r = coap2oscore_group(ser_coap_resp, ser_coap_resp_len, group_resp,
+			      &group_resp_len, &c_server, OSCORE_GROUP_MODE,
+			      NULL);
+	zassert_equal(r, ok, "Error in coap2oscore_group!");
+
+	ser_conv_coap_len = sizeof(ser_conv_coap);
+	r = oscore2coap_group(group_resp, group_resp_len, ser_conv_coap,
+			      &ser_conv_coap_len, &c_client);
+	zassert_equal(r, ok, "Error in oscore2coap_group!");
+	zassert_equal(ser_conv_coap_len, ser_coap_resp_len,
+		      "wrong response length");
+	zassert_mem_equal__(ser_conv_coap, ser_coap_resp, ser_coap_resp_len,
+			    "wrong response");
+
+	/* member table */
+	r = oscore_group_member_remove(&c_server, &client_id_arr);
+	zassert_equal(r, ok, "Error in oscore_group_member_remove");
+	r = oscore_group_member_remove(&c_server, &client_id_arr);
+	zassert_equal(r, oscore_group_member_not_found,
+		      "Removed member still present");
+
+	uint8_t id[1];
+	struct byte_array id_arr = BYTE_ARRAY_INIT(id, sizeof(id));
+	struct group_recipient_context *member;
+	for (uint32_t i = OSCORE_GROUP_MAX_MEMBERS; i > 0; i--) {
+		id[0] = (uint8_t)(i - 1);
+		r = oscore_group_member_add(&c_server, &id_arr, &client_cred);
+		zassert_equal(r, ok, "Error in oscore_group_member_add");
+	}
+	id[0] = OSCORE_GROUP_MAX_MEMBERS;
+	r = oscore_group_member_add(&c_server, &id_arr, &client_cred);
+	zassert_equal(r, oscore_group_member_table_full,
+		      "Member table overflow");
+
+	/* a member is replaced in place, the others are still found after a
+	 * removal */
+	id[0] = 1;
+	r = oscore_group_member_add(&c_server, &id_arr, &server_cred);
+	zassert_equal(r, ok, "Error in oscore_group_member_add");
+	r = oscore_group_member_remove(&c_server, &id_arr);
+	zassert_equal(r, ok, "Error in oscore_group_member_remove");
+	for (uint32_t i = 0; i < OSCORE_GROUP_MAX_MEMBERS; i++) {
+		id[0] = (uint8_t)i;
+		r = group_member_get(&c_server, &id_arr, &member);
+		zassert_equal(r, (1 == i) ? oscore_group_member_not_found : ok,
+			      "Error in group_member_get");
+		if (ok == r) {
+			zassert_mem_equal__(member->rc.recipient_id.ptr, id,
+					    sizeof(id), "wrong member");
+		}
+	}
+	id[0] = OSCORE_GROUP_MAX_MEMBERS;
+	r = oscore_group_member_add(&c_server, &id_arr, &client_cred);
+	zassert_equal(r, ok, "Error in oscore_group_member_add");
+
+#ifdef WORKSPACE
+	/* group mode has the largest buffers of OSCORE */
+	zassert_true(workspace_selected()->peak <= OSCORE_WORKSPACE_SIZE,
+		     "OSCORE_WORKSPACE_SIZE too small");
+#endif
+}
+
+/**
+ * @brief Sends an observe registration for given resource from the client
+ *        to the server.
+ */
+static void observe_register(struct context *c_client, struct context *c_server,
+			     uint8_t *token, uint8_t *uri_path,
+			     uint8_t uri_path_len)
+{
+	enum err r;
+	uint8_t observe_val[] = { 0x00 };
+	struct o_coap_packet coap_pkt = {
+		.header = { .ver = 1,
+			    .type = TYPE_CON,
+			    .TKL = 1,
+			    .code = CODE_REQ_GET,
+			    .MID = token[0] },
+		.token = token,
+		.options_cnt = 2,
+		.options = { { .delta = 6,
+			       .len = sizeof(observe_val),
+			       .value = observe_val,
+			       .option_number = OBSERVE },
+			     { .delta = 5,
+			       .len = uri_path_len,
+			       .value = uri_path,
+			       .option_number = URI_PATH } },
+		.payload.len = 0,
+		.payload.ptr = NULL,
+	};
+
+	uint8_t ser_coap_pkt[40];
+	uint32_t ser_coap_pkt_len = sizeof(ser_coap_pkt);
+	r = coap_serialize(&coap_pkt, ser_coap_pkt, &ser_coap_pkt_len);
+	zassert_equal(r, ok, "Error in coap_serialize!");
+
+	uint8_t ser_oscore_pkt[40];
+	uint32_t ser_oscore_pkt_len = sizeof(ser_oscore_pkt);
+	r = coap2oscore(ser_coap_pkt, ser_coap_pkt_len, ser_oscore_pkt,
+			&ser_oscore_pkt_len, c_client);
+	zassert_equal(r, ok, "Error in coap2oscore!");
+
+	uint8_t ser_conv_coap_pkt[40];
+	uint32_t ser_conv_coap_pkt_len = sizeof(ser_conv_coap_pkt);
+	r = oscore2coap(ser_oscore_pkt, ser_oscore_pkt_len, ser_conv_coap_pkt,
+			&ser_conv_coap_pkt_len, c_server);
+	zassert_equal(r, ok, "Error in oscore2coap!");
+}
+
+/**
+ * @brief Protects a notification with given Observe value on the server.
+ */
+static void observe_notify(struct context *c_server, uint8_t *token,
+			   uint8_t observe_val, uint8_t *out, uint32_t *out_len)
+{
+	enum err r;
+	uint8_t payload[] = { '2', '1', ' ', 'C' };
+	struct o_coap_packet coap_pkt = {
+		.header = { .ver = 1,
+			    .type = TYPE_NON,
+			    .TKL = 1,
+			    .code = CODE_RESP_CONTENT,
+			    .MID = observe_val },
+		.token = token,
+		.options_cnt = 1,
+		.options = { { .delta = 6,
+			       .len = 1,
+			       .value = &observe_val,
+			       .option_number = OBSERVE } },
+		.payload.len = sizeof(payload),
+		.payload.ptr = payload,
+	};
+
+	uint8_t ser_coap_pkt[40];
+	uint32_t ser_coap_pkt_len = sizeof(ser_coap_pkt);
+	r = coap_serialize(&coap_pkt, ser_coap_pkt, &ser_coap_pkt_len);
+	zassert_equal(r, ok, "Error in coap_serialize!");
+
+	r = coap2oscore(ser_coap_pkt, ser_coap_pkt_len, out, out_len,
+			c_server);
+	zassert_equal(r, ok, "Error in coap2oscore!");
+}
+
+/**
+ * Test 14:
+ * - Three observations in one context, each with its own notification
+ *   counter: notifications of different observations may be reordered
+ * - A notification without PIV is accepted once
+ * - Replayed notifications are rejected per observation
+ */
+void t14_oscore_multiple_observations(void)
+{
+	enum err r;
+	struct context c_client;
+	struct oscore_init_params params_client =
+		get_default_params(NORMAL, FRESH);
+	r = oscore_context_init(&params_client, &c_client);
+	zassert_equal(r, ok, "Error in oscore_context_init for client");
+
+	struct context c_server;
+	struct oscore_init_params params_server =
+		get_default_params(REVERSED, FRESH);
+	r = oscore_context_init(&params_server, &c_server);
+	zassert_equal(r, ok, "Error in oscore_context_init for server");
+
+	uint8_t token_a[] = { 0x0a };
+	uint8_t token_b[] = { 0x0b };
+	uint8_t token_c[] = { 0x0c };
+	uint8_t uri_a[] = { 't', 'e', 'm', 'p' };
+	uint8_t uri_b[] = { 'h', 'u', 'm' };
+	uint8_t uri_c[] = { 'l', 'u', 'x' };
+	observe_register(&c_client, &c_server, token_a, uri_a, sizeof(uri_a));
+	observe_register(&c_client, &c_server, token_b, uri_b, sizeof(uri_b));
+	observe_register(&c_client, &c_server, token_c, uri_c, sizeof(uri_c));
+
+	uint8_t ser_conv_coap_pkt[40];
+	uint32_t ser_conv_coap_pkt_len;
+
+	/*
+	 * A response to the last registration without PIV, i.e. protected with
+	 * the nonce of the registration. The outer Observe option is inserted
+	 * before the (empty) OSCORE option to make it a notification.
+	 */
+	uint8_t payload[] = { '2', '1', ' ', 'C' };
+	struct o_coap_packet coap_resp = {
+		.header = { .ver = 1,
+			    .type = TYPE_NON,
+			    .TKL = 1,
+			    .code = CODE_RESP_CONTENT,
+			    .MID = 0x10 },
+		.token = token_c,
+		.options_cnt = 0,
+		.payload.len = sizeof(payload),
+		.payload.ptr = payload,
+	};
+	uint8_t ser_coap_resp[40];
+	uint32_t ser_coap_resp_len = sizeof(ser_coap_resp);
+	r = coap_serialize(&coap_resp, ser_coap_resp, &ser_coap_resp_len);
+	zassert_equal(r, ok, "Error in coap_serialize!");
+
+	uint8_t oscore_resp[40];
+	uint32_t oscore_resp_len = sizeof(oscore_resp);
+	r = coap2oscore(ser_coap_resp, ser_coap_resp_len, oscore_resp,
+			&oscore_resp_len, &c_server);
+	zassert_equal(r, ok, "Error in coap2oscore!");
+
+	struct o_coap_packet resp_pkt;
+	struct byte_array oscore_resp_ba =
+		BYTE_ARRAY_INIT(oscore_resp, oscore_resp_len);
+	r = coap_deserialize(&oscore_resp_ba, &resp_pkt);
+	zassert_equal(r, ok, "Error in coap_deserialize!");
+	zassert_equal(resp_pkt.options_cnt, 1, "wrong number of options");
+	zassert_equal(resp_pkt.options[0].option_number, OSCORE,
+		      "no OSCORE option");
+	struct compressed_oscore_option resp_option;
+	r = oscore_option_parser(resp_pkt.options, resp_pkt.options_cnt,
+				 &resp_option);
+	zassert_equal(r, ok, "Error in oscore_option_parser!");
+	zassert_equal(resp_option.piv.len, 0, "response carries a PIV");
+
+	/* same ciphertext, with an Observe option before the OSCORE option */
+	uint8_t observe_val = 1;
+	resp_pkt.options_cnt = 2;
+	resp_pkt.options[0] = (struct o_coap_option){ .delta = 6,
+						      .len = 1,
+						      .value = &observe_val,
+						      .option_number = OBSERVE };
+	resp_pkt.options[1] = (struct o_coap_option){ .delta = 3,
+						      .len = 0,
+						      .value = NULL,
+						      .option_number = OSCORE };
+	uint8_t piv_less_notification[48];
+	uint32_t piv_less_notification_len = sizeof(piv_less_notification);
+	r = coap_serialize(&resp_pkt, piv_less_notification,
+			   &piv_less_notification_len);
+	zassert_equal(r, ok, "Error in coap_serialize!");
+
+	ser_conv_coap_pkt_len = sizeof(ser_conv_coap_pkt);
+	r = oscore2coap(piv_less_notification, piv_less_notification_len,
+			ser_conv_coap_pkt, &ser_conv_coap_pkt_len, &c_client);
+	zassert_equal(r, ok, "notification without PIV rejected");
+
+	ser_conv_coap_pkt_len = sizeof(ser_conv_coap_pkt);
+	r = oscore2coap(piv_less_notification, piv_less_notification_len,
+			ser_conv_coap_pkt, &ser_conv_coap_pkt_len, &c_client);
+	zassert_equal(r, oscore_replay_notification_protection_error,
+		      "replayed notification without PIV accepted");
+
+	/* notifications of different observations received out of order */
+	uint8_t notification_a[40];
+	uint32_t notification_a_len = sizeof(notification_a);
+	observe_notify(&c_server, token_a, 1, notification_a,
+		       &notification_a_len);
+
+	uint8_t notification_b[40];
+	uint32_t notification_b_len = sizeof(notification_b);
+	observe_notify(&c_server, token_b, 1, notification_b,
+		       &notification_b_len);
+
+	ser_conv_coap_pkt_len = sizeof(ser_conv_coap_pkt);
+	r = oscore2coap(notification_b, notification_b_len, ser_conv_coap_pkt,
+			&ser_conv_coap_pkt_len, &c_client);
+	zassert_equal(r, ok, "Error in oscore2coap!");
+
+	ser_conv_coap_pkt_len = sizeof(ser_conv_coap_pkt);
+	r = oscore2coap(notification_a, notification_a_len, ser_conv_coap_pkt,
+			&ser_conv_coap_pkt_len, &c_client);
+	zassert_equal(r, ok, "older notification of another observation rejected");
+
+	ser_conv_coap_pkt_len = sizeof(ser_conv_coap_pkt);
+	r = oscore2coap(notification_a, notification_a_len, ser_conv_coap_pkt,
+			&ser_conv_coap_pkt_len, &c_client);
+	zassert_equal(r, oscore_replay_notification_protection_error,
+		      "replayed notification accepted");
+
+	/* further notifications reuse the state of the observation */
+	notification_a_len = sizeof(notification_a);
+	observe_notify(&c_server, token_a, 2, notification_a,
+		       &notification_a_len);
+	ser_conv_coap_pkt_len = sizeof(ser_conv_coap_pkt);
+	r = oscore2coap(notification_a, notification_a_len, ser_conv_coap_pkt,
+			&ser_conv_coap_pkt_len, &c_client);
+	zassert_equal(r, ok, "Error in oscore2coap!");
+}
+
+/**
+ * Test 15:
+ * - oscore_prefilter accepts fresh requests, responses and notifications
+ * - it rejects malformed, plain CoAP, foreign, replayed and unsolicited 
+ *   packets without decrypting them
+ */
+void t15_oscore_prefilter(void)
+{
+	enum err r;
+	struct context c_client;
+	struct oscore_init_params params_client =
+		get_default_params(NORMAL, FRESH);
+	r = oscore_context_init(&params_client, &c_client);
+	zassert_equal(r, ok, "Error in oscore_context_init for client");
+
+	struct context c_server;
+	struct oscore_init_params params_server =
+		get_default_params(REVERSED, FRESH);
+	r = oscore_context_init(&params_server, &c_server);
+	zassert_equal(r, ok, "Error in oscore_context_init for server");
+
+	/* a server with another Recipient ID */
+	struct oscore_init_params params_other = {
+		.master_secret.ptr = (uint8_t *)T3__MASTER_SECRET,
+		.master_secret.len = T3__MASTER_SECRET_LEN,
+		.sender_id.ptr = (uint8_t *)T3__RECIPIENT_ID,
+		.sender_id.len = T3__RECIPIENT_ID_LEN,
+		.recipient_id.ptr = (uint8_t *)T3__SENDER_ID,
+		.recipient_id.len = T3__SENDER_ID_LEN,
+		.master_salt.ptr = (uint8_t *)T3__MASTER_SALT,
+		.master_salt.len = T3__MASTER_SALT_LEN,
+		.id_context.ptr = (uint8_t *)T3__ID_CONTEXT,
+		.id_context.len = T3__ID_CONTEXT_LEN,
+		.aead_alg = OSCORE_AES_CCM_16_64_128,
+		.hkdf = OSCORE_SHA_256,
+		.fresh_master_secret_salt = true,
+	};
+	struct context c_other;
+	r = oscore_context_init(&params_other, &c_other);
+	zassert_equal(r, ok, "Error in oscore_context_init");
+
+	/* malformed packets */
+	uint8_t too_short[] = { 0x40, 0x01 };
+	r = oscore_prefilter(too_short, sizeof(too_short), &c_server);
+	zassert_equal(r, not_valid_input_packet, "too short packet accepted");
+
+	uint8_t invalid_tkl[] = { 0x49, 0x01, 0x00, 0x01, 0x00 };
+	r = oscore_prefilter(invalid_tkl, sizeof(invalid_tkl), &c_server);
+	zassert_equal(r, oscore_inpkt_invalid_tkl, "invalid TKL accepted");
+
+	/* OSCORE option announcing a KID context longer than the option */
+	uint8_t invalid_kidc[] = { 0x40, 0x02, 0x00, 0x01, 0x92,
+				   0x19, 0x05, 0xff, 0x00 };
+	r = oscore_prefilter(invalid_kidc, sizeof(invalid_kidc), &c_server);
+	zassert_equal(r, not_valid_input_packet,
+		      "invalid OSCORE option accepted");
+
+	/* request */
+	uint8_t uri_path_val[] = { 't', 'e', 'm', 'p', 'e', 'r',
+				   'a', 't', 'u', 'r', 'e' };
+	uint8_t token[] = { 0x4a };
+	struct o_coap_packet coap_req = {
+		.header = { .ver = 1,
+			    .type = TYPE_CON,
+			    .TKL = 1,
+			    .code = CODE_REQ_GET,
+			    .MID = 0x1 },
+		.token = token,
+		.options_cnt = 1,
+		.options = { { .delta = 11,
+			       .len = sizeof(uri_path_val),
+			       .value = uri_path_val,
+			       .option_number = URI_PATH } },
+		.payload.len = 0,
+		.payload.ptr = NULL,
+	};
+
+	uint8_t ser_coap_req[64];
+	uint32_t ser_coap_req_len = sizeof(ser_coap_req);
+	r = coap_serialize(&coap_req, ser_coap_req, &ser_coap_req_len);
+	zassert_equal(r, ok, "Error in coap_serialize!");
+
+	r = oscore_prefilter(ser_coap_req, ser_coap_req_len, &c_server);
+	zassert_equal(r, not_oscore_pkt, "CoAP packet accepted");
+
+	uint8_t oscore_req[64];
+	uint32_t oscore_req_len = sizeof(oscore_req);
+	r = coap2oscore(ser_coap_req, ser_coap_req_len, oscore_req,
+			&oscore_req_len, &c_client);
+	zassert_equal(r, ok, "Error in coap2oscore!");
+
+	r = oscore_prefilter(oscore_req, oscore_req_len, &c_other);
+	zassert_equal(r, oscore_kid_recipient_id_mismatch,
+		      "request of another context accepted");
+
+	r = oscore_prefilter(oscore_req, oscore_req_len, &c_server);
+	zassert_equal(r, ok, "Error in oscore_prefilter!");
+
+	uint8_t ser_conv_coap[64];
+	uint32_t ser_conv_coap_len = sizeof(ser_conv_coap);
+	r = oscore2coap(oscore_req, oscore_req_len, ser_conv_coap,
+			&ser_conv_coap_len, &c_server);
+	zassert_equal(r, ok, "Error in oscore2coap!");
+
+	r = oscore_prefilter(oscore_req, oscore_req_len, &c_server);
+	zassert_equal(r, oscore_replay_window_protection_error,
+		      "replayed request accepted");
+
+	/* response */
+	uint8_t payload[] = { '2', '1', ' ', 'C' };
+	struct o_coap_packet coap_resp = {
+		.header = { .ver = 1,
+			    .type = TYPE_ACK,
+			    .TKL = 1,
+			    .code = CODE_RESP_CONTENT,
+			    .MID = 0x1 },
+		.token = token,
+		.options_cnt = 0,
+		.payload.len = sizeof(payload),
+		.payload.ptr = payload,
+	};
+
+	uint8_t ser_coap_resp[64];
+	uint32_t ser_coap_resp_len = sizeof(ser_coap_resp);
+	r = coap_serialize(&coap_resp, ser_coap_resp, &ser_coap_resp_len);
+	zassert_equal(r, ok, "Error in coap_serialize!");
+
+	uint8_t oscore_resp[64];
+	uint32_t oscore_resp_len = sizeof(oscore_resp);
+	r = coap2oscore(ser_coap_resp, ser_coap_resp_len, oscore_resp,
+			&oscore_resp_len, &c_server);
+	zassert_equal(r, ok, "Error in coap2oscore!");
+
+	r = oscore_prefilter(oscore_resp, oscore_resp_len, &c_client);
+	zassert_equal(r, ok, "Error in oscore_prefilter!");
+
+	/* a response with an unknown token */
+	oscore_resp[4] = 0x4b;
+	r = oscore_prefilter(oscore_resp, oscore_resp_len, &c_client);
+	zassert_equal(r, oscore_interaction_not_found,
+		      "unsolicited response accepted");
+
+	/* notification */
+	uint8_t token_obs[] = { 0x0a };
+	uint8_t uri_obs[] = { 't', 'e', 'm', 'p' };
+	observe_register(&c_client, &c_server, token_obs, uri_obs,
+			 sizeof(uri_obs));
+
+	uint8_t notification[40];
+	uint32_t notification_len = sizeof(notification);
+	observe_notify(&c_server, token_obs, 1, notification,
+		       &notification_len);
+
+	r = oscore_prefilter(notification, notification_len, &c_client);
+	zassert_equal(r, ok, "Error in oscore_prefilter!");
+
+	ser_conv_coap_len = sizeof(ser_conv_coap);
+	r = oscore2coap(notification, notification_len, ser_conv_coap,
+			&ser_conv_coap_len, &c_client);
+	zassert_equal(r, ok, "Error in oscore2coap!");
+
+	r = oscore_prefilter(notification, notification_len, &c_client);
+	zassert_equal(r, oscore_replay_notification_protection_error,
+		      "replayed notification accepted");
+}
+
+/**
+ * Test 16:
+ * - coap2oscore_batch() protects the messages as coap2oscore() would, 
+ *   including several messages of the same context, an empty ACK and a 
+ *   message that fails
+ */
+void t16_oscore_protect_batch(void)
+{
+	enum err r;
+	enum { CTX = 5, MSGS = 12 };
+	/*the context of each message, the last one is exhausted*/
+	const uint32_t ctx_of[MSGS] = { 0, 1, 2, 0, 3, 1, 1, 2, 0, 3, 4, 2 };
+	static struct context c_batch[CTX];
+	static struct context c_seq[CTX];
+
+	for (uint32_t i = 0; i < CTX; i++) {
+		struct oscore_init_params params =
+			get_default_params(NORMAL, FRESH);
+		r = oscore_context_init(&params, &c_batch[i]);
+		zassert_equal(r, ok, "Error in oscore_context_init");
+		r = oscore_context_init(&params, &c_seq[i]);
+		zassert_equal(r, ok, "Error in oscore_context_init");
+	}
+	c_batch[CTX - 1].sc.ssn = OSCORE_SSN_OVERFLOW_VALUE;
+	c_seq[CTX - 1].sc.ssn = OSCORE_SSN_OVERFLOW_VALUE;
+
+	/* requests with payloads of different lengths */
+	uint8_t uri_path_val[] = { 't', 'e', 'm', 'p' };
+	static uint8_t payload[MSGS * 20];
+	for (uint32_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = (uint8_t)i;
+	}
+	static uint8_t coap[MSGS][300];
+	uint32_t coap_len[MSGS];
+	for (uint32_t i = 0; i < MSGS; i++) {
+		uint8_t token[] = { (uint8_t)(0x10 + i) };
+		struct o_coap_packet coap_req = {
+			.header = { .ver = 1,
+				    .type = TYPE_CON,
+				    .TKL = 1,
+				    .code = CODE_REQ_POST,
+				    .MID = (uint16_t)i },
+			.token = token,
+			.options_cnt = 1,
+			.options = { { .delta = 11,
+				       .len = sizeof(uri_path_val),
+				       .value = uri_path_val,
+				       .option_number = URI_PATH } },
+			.payload.len = i * 20,
+			.payload.ptr = payload,
+		};
+		coap_len[i] = sizeof(coap[i]);
+		r = coap_serialize(&coap_req, coap[i], &coap_len[i]);
+		zassert_equal(r, ok, "Error in coap_serialize!");
+	}
+	/* an empty ACK is copied */
+	memcpy(coap[5], T8__COAP_ACK, T8__COAP_ACK_LEN);
+	coap_len[5] = T8__COAP_ACK_LEN;
+
+	static uint8_t out_batch[MSGS][320];
+	uint32_t out_batch_len[MSGS];
+	struct coap2oscore_job jobs[MSGS];
+	for (uint32_t i = 0; i < MSGS; i++) {
+		out_batch_len[i] = sizeof(out_batch[i]);
+		jobs[i].buf_o_coap = coap[i];
+		jobs[i].buf_o_coap_len = coap_len[i];
+		jobs[i].buf_oscore = out_batch[i];
+		jobs[i].buf_oscore_len = &out_batch_len[i];
+		jobs[i].c = &c_batch[ctx_of[i]];
+	}
+	r = coap2oscore_batch(jobs, MSGS);
+	zassert_equal(r, oscore_ssn_overflow, "Error in coap2oscore_batch");
+
+	for (uint32_t i = 0; i < MSGS; i++) {
+		uint8_t out_seq[320];
+		uint32_t out_seq_len = sizeof(out_seq);
+		r = coap2oscore(coap[i], coap_len[i], out_seq, &out_seq_len,
+				&c_seq[ctx_of[i]]);
+		zassert_equal(jobs[i].result, r, "wrong result of message %u",
+			      i);
+		if (ok != r) {
+			continue;
+		}
+		zassert_equal(out_batch_len[i], out_seq_len,
+			      "wrong length of message %u", i);
+		zassert_mem_equal__(out_batch[i], out_seq, out_seq_len,
+				    "wrong message %u", i);
+	}
+	for (uint32_t i = 0; i < CTX; i++) {
+		zassert_equal(c_batch[i].sc.ssn, c_seq[i].sc.ssn,
+			      "wrong SSN of context %u", i);
+	}
+
+	/* a message of the batch is accepted by the server */
+	struct context c_server;
+	struct oscore_init_params params_server =
+		get_default_params(REVERSED, FRESH);
+	r = oscore_context_init(&params_server, &c_server);
+	zassert_equal(r, ok, "Error in oscore_context_init");
+	uint8_t coap_conv[300];
+	uint32_t coap_conv_len = sizeof(coap_conv);
+	r = oscore2coap(out_batch[4], out_batch_len[4], coap_conv,
+			&coap_conv_len, &c_server);
+	zassert_equal(r, ok, "Error in oscore2coap!");
+	zassert_equal(coap_conv_len, coap_len[4], "wrong length");
+	zassert_mem_equal__(coap_conv, coap[4], coap_len[4],
+			    "oscore2coap failed");
+
+	/* the test vector of RFC 8613 Appendix C.4 */
+	struct context c_client;
+	struct oscore_init_params params = get_default_params(NORMAL, RESTORED);
+	r = oscore_context_init(&params, &c_client);
+	zassert_equal(r, ok, "Error in oscore_context_init");
+	uint8_t buf_oscore[256];
+	uint32_t buf_oscore_len = sizeof(buf_oscore);
+	struct coap2oscore_job job = {
+		.buf_o_coap = (uint8_t *)T1__COAP_REQ,
+		.buf_o_coap_len = T1__COAP_REQ_LEN,
+		.buf_oscore = buf_oscore,
+		.buf_oscore_len = &buf_oscore_len,
+		.c = &c_client,
+	};
+	r = coap2oscore_batch(&job, 1);
+	zassert_equal(r, ok, "Error in coap2oscore_batch");
+	zassert_equal(buf_oscore_len, T1__OSCORE_REQ_LEN, "wrong length");
+	zassert_mem_equal__(buf_oscore, T1__OSCORE_REQ, T1__OSCORE_REQ_LEN,
+			    "coap2oscore_batch failed");
+}
+
+/**
+ * Test 17:
+ * - coap2oscore_batch() protects messages whose plaintexts do not fit 
+ *   into the staging buffer together as coap2oscore() would, with more 
+ *   contexts than OSCORE_PROTECT_BATCH
+ */
+void t17_oscore_protect_batch_large(void)
+{
+	enum err r;
+	enum { MSGS = 2 * OSCORE_PROTECT_BATCH + 1, PAYLOAD_LEN = 900 };
+	static struct context c_batch[MSGS];
+	static struct context c_seq[MSGS];
+	static uint8_t payload[PAYLOAD_LEN];
+	static uint8_t coap[MSGS][PAYLOAD_LEN + 20];
+	static uint8_t out_batch[MSGS][PAYLOAD_LEN + 40];
+	static uint8_t out_seq[PAYLOAD_LEN + 40];
+	uint32_t coap_len[MSGS];
+	uint32_t out_batch_len[MSGS];
+	struct coap2oscore_job jobs[MSGS];
+	uint8_t uri_path_val[] = { 't', 'e', 'm', 'p' };
+
+	for (uint32_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = (uint8_t)(i * 3);
+	}
+
+	/* each message to its own context, large and small payloads */
+	for (uint32_t i = 0; i < MSGS; i++) {
+		struct oscore_init_params params =
+			get_default_params(NORMAL, FRESH);
+		r = oscore_context_init(&params, &c_batch[i]);
+		zassert_equal(r, ok, "Error in oscore_context_init");
+		r = oscore_context_init(&params, &c_seq[i]);
+		zassert_equal(r, ok, "Error in oscore_context_init");
+
+		uint8_t token[] = { (uint8_t)(0x20 + i) };
+		struct o_coap_packet coap_req = {
+			.header = { .ver = 1,
+				    .type = TYPE_CON,
+				    .TKL = 1,
+				    .code = CODE_REQ_POST,
+				    .MID = (uint16_t)i },
+			.token = token,
+			.options_cnt = 1,
+			.options = { { .delta = 11,
+				       .len = sizeof(uri_path_val),
+				       .value = uri_path_val,
+				       .option_number = URI_PATH } },
+			.payload.len = (i % 3) ? PAYLOAD_LEN - i : i,
+			.payload.ptr = payload,
+		};
+		coap_len[i] = sizeof(coap[i]);
+		r = coap_serialize(&coap_req, coap[i], &coap_len[i]);
+		zassert_equal(r, ok, "Error in coap_serialize!");
+
+		out_batch_len[i] = sizeof(out_batch[i]);
+		jobs[i].buf_o_coap = coap[i];
+		jobs[i].buf_o_coap_len = coap_len[i];
+		jobs[i].buf_oscore = out_batch[i];
+		jobs[i].buf_oscore_len = &out_batch_len[i];
+		jobs[i].c = &c_batch[i];
+	}
+
+	r = coap2oscore_batch(jobs, MSGS);
+	zassert_equal(r, ok, "Error in coap2oscore_batch");
+
+	for (uint32_t i = 0; i < MSGS; i++) {
+		uint32_t out_seq_len = sizeof(out_seq);
+		r = coap2oscore(coap[i], coap_len[i], out_seq, &out_seq_len,
+				&c_seq[i]);
+		zassert_equal(r, ok, "Error in coap2oscore");
+		zassert_equal(jobs[i].result, ok, "wrong result of message %u",
+			      i);
+		zassert_equal(out_batch_len[i], out_seq_len,
+			      "wrong length of message %u", i);
+		zassert_mem_equal__(out_batch[i], out_seq, out_seq_len,
+				    "wrong message %u", i);
+		zassert_equal(c_batch[i].sc.ssn, c_seq[i].sc.ssn,
+			      "wrong SSN of context %u", i);
+	}
+
+	/* a large message of the batch is accepted by the server */
+	struct context c_server;
+	struct oscore_init_params params_server =
+		get_default_params(REVERSED, FRESH);
+	r = oscore_context_init(&params_server, &c_server);
+	zassert_equal(r, ok, "Error in oscore_context_init");
+	uint32_t coap_conv_len = sizeof(out_seq);
+	r = oscore2coap(out_batch[MSGS - 1], out_batch_len[MSGS - 1], out_seq,
+			&coap_conv_len, &c_server);
+	zassert_equal(r, ok, "Error in oscore2coap!");
+	zassert_equal(coap_conv_len, coap_len[MSGS - 1], "wrong length");
+	zassert_mem_equal__(out_seq, coap[MSGS - 1], coap_len[MSGS - 1],
+			    "oscore2coap failed");
+}
@@ -22,6 +22,12 @@ void t8_oscore_server_response_simple_ack(void);
 void t9_oscore_client_server_observe(void);
 void t10_oscore_client_server_after_reboot(void);
 void t11_oscore_ssn_overflow_protection(void);
+void t12_oscore_proxy_reprotect(void);
+void t13_oscore_group_mode(void);
+void t14_oscore_multiple_observations(void);
+void t15_oscore_prefilter(void);
+void t16_oscore_protect_batch(void);
+void t17_oscore_protect_batch_large(void);
 
 /*unit tests*/
 void t100_inner_outer_option_split__no_special_options(void);
@@ -53,6 +59,8 @@ void t501_piv2ssn(void);
 void t502_ssn2piv(void);
 void t503_derive_corner_case(void);
 void t504_context_freshness(void);
+void t505_oscore_contexts_init(void);
+void t506_keystream_info(void);
 
 void t600_server_replay_init_test(void);
 void t601_server_replay_reinit_test(void);
@@ -69,4 +77,6 @@ void t703_interactions_remove_record_test(void);
 void t704_interactions_usecases_test(void);
 
 void t800_oscore_latency_test(void);
+
+void t900_workspace_alloc_release(void);
 #endif
\ No newline at end of file
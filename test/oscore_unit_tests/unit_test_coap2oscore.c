@@ -18,6 +18,7 @@
 
 #include "oscore/oscore_coap.h"
 #include "oscore/option.h"
+#include "oscore/oscore_internal.h"
 
 /* Use this function for debugging to print an array of options*/
 static void print_options(struct o_coap_option *opt, uint8_t opt_cnt)
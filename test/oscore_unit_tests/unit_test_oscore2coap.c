@@ -18,6 +18,7 @@
 #include "common/unit_test.h"
 
 #include "oscore/option.h"
+#include "oscore/oscore_internal.h"
 
 void t300_oscore_option_parser_no_piv(void)
 {
@@ -15,6 +15,7 @@
 #include "common/unit_test.h"
 
 #include "oscore.h"
+#include "oscore/oscore_hkdf_info.h"
 #include "oscore/security_context.h"
 
 static void test_single_piv2ssn(uint8_t *piv_ptr, uint32_t piv_size, uint64_t expected_ssn)
@@ -168,3 +169,109 @@ void t504_context_freshness(void)
 	result = check_context_freshness(&security_context);
 	zassert_equal(result, oscore_ssn_overflow, "");
 }
+
+static uint8_t t505_secret[3][16] = { { 1 }, { 2 }, { 3 } };
+static uint8_t t505_salt[] = { 0x9e, 0x7c, 0xa9, 0x22, 0x23, 0x78, 0x63, 0x40 };
+static uint8_t t505_id[11] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+static struct oscore_init_params t505_params(uint32_t i)
+{
+	struct oscore_init_params params = {
+		/*some consecutive contexts share the master secret*/
+		.master_secret = BYTE_ARRAY_INIT(t505_secret[i / 4], 16),
+		.sender_id = BYTE_ARRAY_INIT(&t505_id[i], 1),
+		.recipient_id = BYTE_ARRAY_INIT(&t505_id[i + 1], 1),
+		.master_salt = BYTE_ARRAY_INIT(t505_salt, sizeof(t505_salt)),
+		.id_context = BYTE_ARRAY_INIT(NULL, 0),
+		.aead_alg = OSCORE_AES_CCM_16_64_128,
+		.hkdf = OSCORE_SHA_256,
+		.fresh_master_secret_salt = true,
+	};
+	return params;
+}
+
+/**
+ * @brief Test that oscore_contexts_init() derives the values of 
+ * oscore_context_init() for more contexts than one batch.
+ */
+void t505_oscore_contexts_init(void)
+{
+	enum err r;
+	static struct context c1[10];
+	static struct context c2[10];
+	struct oscore_init_params params[10] = {
+		t505_params(0), t505_params(1), t505_params(2), t505_params(3),
+		t505_params(4), t505_params(5), t505_params(6), t505_params(7),
+		t505_params(8), t505_params(9),
+	};
+
+	r = oscore_contexts_init(params, c1, 10);
+	zassert_equal(r, ok, "Error in oscore_contexts_init. r: %d", r);
+
+	for (uint32_t i = 0; i < 10; i++) {
+		r = oscore_context_init(&params[i], &c2[i]);
+		zassert_equal(r, ok, "Error in oscore_context_init. r: %d", r);
+		zassert_mem_equal(c1[i].cc.common_iv.ptr,
+				  c2[i].cc.common_iv.ptr,
+				  c2[i].cc.common_iv.len, "wrong Common IV");
+		zassert_mem_equal(c1[i].sc.sender_key.ptr,
+				  c2[i].sc.sender_key.ptr,
+				  c2[i].sc.sender_key.len, "wrong Sender Key");
+		zassert_mem_equal(c1[i].rc.recipient_key.ptr,
+				  c2[i].rc.recipient_key.ptr,
+				  c2[i].rc.recipient_key.len,
+				  "wrong Recipient Key");
+		zassert_equal(c1[i].sc.ssn, c2[i].sc.ssn, "wrong SSN");
+	}
+
+	/*an unsupported algorithm is reported as by oscore_context_init()*/
+	struct oscore_init_params wrong[1] = { {
+		.aead_alg = 15,
+	} };
+	r = oscore_contexts_init(wrong, c1, 1);
+	zassert_equal(r, oscore_invalid_algorithm_aead,
+		      "Error in oscore_contexts_init. r: %d", r);
+}
+
+/**
+ * @brief Test the HKDF Info of the keystream that encrypts the 
+ * countersignature in Group OSCORE, 
+ * [id: bstr, id_context: bstr, type: bool, L: uint].
+ */
+void t506_keystream_info(void)
+{
+	enum err r;
+	uint8_t id_buf[] = { 0x25 };
+	uint8_t gid_buf[] = { 0xdd, 0x11 };
+	uint8_t out_buf[MAX_INFO_LEN];
+	struct byte_array id = BYTE_ARRAY_INIT(id_buf, sizeof(id_buf));
+	struct byte_array gid = BYTE_ARRAY_INIT(gid_buf, sizeof(gid_buf));
+	struct byte_array out = BYTE_ARRAY_INIT(out_buf, sizeof(out_buf));
+
+	/*request: [h'25', h'DD11', true, 64]*/
+	uint8_t request_info[] = { 0x84, 0x41, 0x25, 0x42, 0xdd,
+				   0x11, 0xf5, 0x18, 0x40 };
+	r = oscore_create_keystream_info(&id, &gid, true, 64, &out);
+	zassert_equal(r, ok, "Error in oscore_create_keystream_info. r: %d",
+		      r);
+	zassert_equal(out.len, sizeof(request_info), "wrong info length");
+	zassert_mem_equal(out.ptr, request_info, sizeof(request_info),
+			  "wrong request info");
+
+	/*response with an empty Sender ID: [h'', h'DD11', false, 64]*/
+	uint8_t response_info[] = { 0x84, 0x40, 0x42, 0xdd,
+				    0x11, 0xf4, 0x18, 0x40 };
+	out.len = sizeof(out_buf);
+	r = oscore_create_keystream_info(&EMPTY_ARRAY, &gid, false, 64, &out);
+	zassert_equal(r, ok, "Error in oscore_create_keystream_info. r: %d",
+		      r);
+	zassert_equal(out.len, sizeof(response_info), "wrong info length");
+	zassert_mem_equal(out.ptr, response_info, sizeof(response_info),
+			  "wrong response info");
+
+	/*the info does not fit into the buffer*/
+	out.len = sizeof(request_info) - 1;
+	r = oscore_create_keystream_info(&id, &gid, true, 64, &out);
+	zassert_equal(r, buffer_to_small,
+		      "Error in oscore_create_keystream_info. r: %d", r);
+}
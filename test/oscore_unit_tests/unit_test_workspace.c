@@ -0,0 +1,62 @@
+/*
+   Copyright (c) 2021 Fraunhofer AISEC. See the COPYRIGHT
+   file at the top-level directory of this distribution.
+
+   Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+   http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+   <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+   option. This file may not be copied, modified, or distributed
+   except according to those terms.
+*/
+#include <zephyr/ztest.h>
+
+#include "common/byte_array.h"
+#include "common/oscore_edhoc_error.h"
+#include "common/workspace.h"
+
+/**
+ * @brief Test that buffers are taken in order, released to a mark and that
+ *        a too small workspace is detected.
+ */
+void t900_workspace_alloc_release(void)
+{
+	struct workspace *previous = workspace_selected();
+	uint8_t buf[64];
+	struct workspace ws;
+	struct byte_array a, b, c;
+	enum err r;
+
+	workspace_select(NULL);
+	r = workspace_alloc(1, &a);
+	zassert_equal(r, workspace_not_selected, "Error in workspace_alloc");
+
+	workspace_init(&ws, buf, sizeof(buf));
+	workspace_select(&ws);
+
+	r = workspace_alloc(0, &a);
+	zassert_equal(r, ok, "Error in workspace_alloc");
+	zassert_is_null(a.ptr, "size 0 must result in a NULL_ARRAY");
+	zassert_equal(ws.used, 0, "size 0 must not use the workspace");
+
+	r = workspace_alloc(3, &a);
+	zassert_equal(r, ok, "Error in workspace_alloc");
+	zassert_equal(a.len, 3, "wrong length");
+
+	uint32_t mark = workspace_mark();
+	r = workspace_alloc(16, &b);
+	zassert_equal(r, ok, "Error in workspace_alloc");
+	zassert_true(b.ptr >= a.ptr + a.len, "buffers overlap");
+	zassert_equal((uintptr_t)b.ptr % WORKSPACE_ALIGN, 0, "not aligned");
+
+	/* after the release the memory of b is reused */
+	workspace_release(&mark);
+	r = workspace_alloc(16, &c);
+	zassert_equal(r, ok, "Error in workspace_alloc");
+	zassert_equal_ptr(b.ptr, c.ptr, "memory not reused");
+
+	r = workspace_alloc(sizeof(buf), &c);
+	zassert_equal(r, workspace_exhausted, "Error in workspace_alloc");
+	zassert_true(ws.peak <= sizeof(buf), "wrong peak");
+
+	workspace_select(previous);
+}